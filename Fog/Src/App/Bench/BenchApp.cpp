@@ -5,7 +5,11 @@
 
 // [Dependencies]
 #include "BenchApp.h"
+#include "BenchConvert.h"
+#include "BenchDtoa.h"
+#include "BenchEventLoop.h"
 #include "BenchFog.h"
+#include "BenchGradient.h"
 
 #if defined(FOG_BENCH_CAIRO)
 #include "BenchCairo.h"
@@ -581,6 +585,18 @@ int main(int argc, char* argv[])
   // Run the tests.
   app.runAll();
 
+  // Run the pixel format conversion tests.
+  BenchConvert(app).runAll();
+
+  // Run the event loop tests.
+  BenchEventLoop(app).runAll();
+
+  // Run the number formatting and parsing tests.
+  BenchDtoa(app).runAll();
+
+  // Run the gradient fetchers tests.
+  BenchGradient(app).runAll();
+
 #if defined(FOG_OS_WINDOWS)
   system("pause");
 #endif // FOG_OS_WINDOWS
@@ -0,0 +1,256 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Dependencies]
+#include "BenchConvert.h"
+
+// [Dependencies - C]
+#include <stdlib.h>
+
+// ============================================================================
+// [BenchConvert - Construction / Destruction]
+// ============================================================================
+
+BenchConvert::BenchConvert(BenchApp& app) :
+  app(app),
+  width(1024),
+  height(64),
+  quantity(32),
+  stride(1024 * 8),
+  srcBuffer(NULL),
+  dstBuffer(NULL),
+  palette(Fog::ImagePalette::fromGreyscale(256))
+{
+  srcBuffer = reinterpret_cast<uint8_t*>(malloc(stride * (size_t)height));
+  dstBuffer = reinterpret_cast<uint8_t*>(malloc(stride * (size_t)height));
+
+  if (srcBuffer != NULL)
+  {
+    // Random pixels, so the premultiply/demultiply kernels can't take their
+    // fully-opaque fast paths.
+    size_t i, length = stride * (size_t)height;
+    uint32_t seed = 0x12345678;
+
+    for (i = 0; i < length; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      srcBuffer[i] = (uint8_t)(seed >> 16);
+    }
+  }
+}
+
+BenchConvert::~BenchConvert()
+{
+  if (srcBuffer != NULL) free(srcBuffer);
+  if (dstBuffer != NULL) free(dstBuffer);
+}
+
+// ============================================================================
+// [BenchConvert - Run]
+// ============================================================================
+
+void BenchConvert::runAll()
+{
+  if (srcBuffer == NULL || dstBuffer == NULL)
+  {
+    app.logf("BenchConvert - Out of memory.\n");
+    return;
+  }
+
+  app.logf("ImageConverter - %dx%d pixels, %u times [MPix/s]\n", width, height, quantity);
+  app.logf("\n");
+
+  runFormats();
+  runCustom();
+}
+
+void BenchConvert::runFormats()
+{
+  uint32_t dstFormat;
+  uint32_t srcFormat;
+
+  // Only the formats the raster paint engine is able to render to are valid
+  // destinations of the built-in conversion (COMPOSITE_SRC).
+  const uint32_t dstCount = Fog::IMAGE_FORMAT_A8 + 1;
+
+  Fog::StringW s;
+  Fog::StringW l;
+
+  s.append(Fog::Ascii8("Src \\ Dst"));
+  s.justify(10, Fog::CharW(' '), Fog::TEXT_JUSTIFY_LEFT);
+  l.justify(10, Fog::CharW('-'), Fog::TEXT_JUSTIFY_LEFT);
+
+  s.append(Fog::CharW('|'));
+  l.append(Fog::CharW('+'));
+
+  for (dstFormat = 0; dstFormat < dstCount; dstFormat++)
+  {
+    Fog::StringW cell = Fog::StringW::fromAscii8(getFormatName(dstFormat));
+    cell.justify(8, Fog::CharW(' '), Fog::TEXT_JUSTIFY_RIGHT);
+
+    s.append(cell);
+    l.append(Fog::CharW('-'), 8);
+
+    s.append(Fog::CharW('|'));
+    l.append(Fog::CharW('+'));
+  }
+
+  s.append(Fog::CharW('\n'));
+  l.append(Fog::CharW('\n'));
+
+  app.logs(s);
+  app.logs(l);
+
+  for (srcFormat = 0; srcFormat < Fog::IMAGE_FORMAT_COUNT; srcFormat++)
+  {
+    s = Fog::StringW::fromAscii8(getFormatName(srcFormat));
+    s.justify(10, Fog::CharW(' '), Fog::TEXT_JUSTIFY_LEFT);
+    s.append(Fog::CharW('|'));
+
+    for (dstFormat = 0; dstFormat < dstCount; dstFormat++)
+    {
+      double mpps = runPair(
+        Fog::ImageFormatDescription::getByFormat(dstFormat),
+        Fog::ImageFormatDescription::getByFormat(srcFormat));
+
+      Fog::StringW cell;
+      if (mpps >= 0.0)
+        cell.appendFormat("%u", (uint32_t)(mpps + 0.5));
+      else
+        cell.append(Fog::CharW('-'));
+
+      cell.justify(8, Fog::CharW(' '), Fog::TEXT_JUSTIFY_RIGHT);
+      s.append(cell);
+      s.append(Fog::CharW('|'));
+    }
+
+    s.append(Fog::CharW('\n'));
+    app.logs(s);
+  }
+
+  app.logf("\n");
+}
+
+void BenchConvert::runCustom()
+{
+  struct CustomFormat
+  {
+    const char* name;
+    uint32_t depth;
+    uint32_t flags;
+    uint64_t aMask;
+    uint64_t rMask;
+    uint64_t gMask;
+    uint64_t bMask;
+  };
+
+  static const CustomFormat customList[] =
+  {
+    { "RGB16_555"   , 16, 0                           , 0x0000    , 0x7C00    , 0x03E0    , 0x001F     },
+    { "RGB16_555_BS", 16, Fog::IMAGE_FD_IS_BYTESWAPPED, 0x0000    , 0x7C00    , 0x03E0    , 0x001F     },
+    { "RGB16_565"   , 16, 0                           , 0x0000    , 0xF800    , 0x07E0    , 0x001F     },
+    { "RGB16_565_BS", 16, Fog::IMAGE_FD_IS_BYTESWAPPED, 0x0000    , 0xF800    , 0x07E0    , 0x001F     },
+    { "RGB24_BS"    , 24, Fog::IMAGE_FD_IS_BYTESWAPPED, 0x000000  , 0xFF0000  , 0x00FF00  , 0x0000FF   },
+    { "XRGB32_BS"   , 32, Fog::IMAGE_FD_IS_BYTESWAPPED, 0x00000000, 0x00FF0000, 0x0000FF00, 0x000000FF },
+    { "ARGB32"      , 32, 0                           , 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF },
+    { "ARGB32_BS"   , 32, Fog::IMAGE_FD_IS_BYTESWAPPED, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF }
+  };
+
+  const Fog::ImageFormatDescription& prgb32Desc =
+    Fog::ImageFormatDescription::getByFormat(Fog::IMAGE_FORMAT_PRGB32);
+
+  Fog::StringW s;
+  Fog::StringW l;
+
+  s.append(Fog::Ascii8("Custom"));
+  s.justify(14, Fog::CharW(' '), Fog::TEXT_JUSTIFY_LEFT);
+  l.justify(14, Fog::CharW('-'), Fog::TEXT_JUSTIFY_LEFT);
+  s.append(Fog::Ascii8("|  To PRGB32|From PRGB32|\n"));
+  l.append(Fog::Ascii8("+-----------+-----------+\n"));
+
+  app.logs(s);
+  app.logs(l);
+
+  for (size_t i = 0; i < FOG_ARRAY_SIZE(customList); i++)
+  {
+    const CustomFormat& f = customList[i];
+    Fog::ImageFormatDescription desc = Fog::ImageFormatDescription::fromArgb(
+      f.depth, f.flags, f.aMask, f.rMask, f.gMask, f.bMask);
+
+    double mpps[2];
+    mpps[0] = runPair(prgb32Desc, desc);
+    mpps[1] = runPair(desc, prgb32Desc);
+
+    s = Fog::StringW::fromAscii8(f.name);
+    s.justify(14, Fog::CharW(' '), Fog::TEXT_JUSTIFY_LEFT);
+    s.append(Fog::CharW('|'));
+
+    for (size_t j = 0; j < 2; j++)
+    {
+      Fog::StringW cell;
+      if (mpps[j] >= 0.0)
+        cell.appendFormat("%u", (uint32_t)(mpps[j] + 0.5));
+      else
+        cell.append(Fog::CharW('-'));
+
+      cell.justify(11, Fog::CharW(' '), Fog::TEXT_JUSTIFY_RIGHT);
+      s.append(cell);
+      s.append(Fog::CharW('|'));
+    }
+
+    s.append(Fog::CharW('\n'));
+    app.logs(s);
+  }
+
+  app.logf("\n");
+}
+
+double BenchConvert::runPair(
+  const Fog::ImageFormatDescription& dstDesc,
+  const Fog::ImageFormatDescription& srcDesc)
+{
+  Fog::ImageConverter converter;
+
+  if (converter.create(dstDesc, srcDesc, false, &palette, &palette) != Fog::ERR_OK)
+    return -1.0;
+
+  // Warm-up, the first blit can be affected by page faults.
+  converter.blitRect(dstBuffer, stride, srcBuffer, stride, width, height);
+
+  Fog::Time start(Fog::Time::now());
+
+  for (uint32_t i = 0; i < quantity; i++)
+    converter.blitRect(dstBuffer, stride, srcBuffer, stride, width, height);
+
+  Fog::TimeDelta delta = Fog::Time::now() - start;
+  double us = double(delta.getMicroseconds());
+
+  if (us <= 0.0)
+    us = 1.0;
+
+  // Pixels per microsecond is equal to megapixels per second.
+  return (double(width) * double(height) * double(quantity)) / us;
+}
+
+// ============================================================================
+// [BenchConvert - Helpers]
+// ============================================================================
+
+const char* BenchConvert::getFormatName(uint32_t format)
+{
+  switch (format)
+  {
+    case Fog::IMAGE_FORMAT_PRGB32: return "PRGB32";
+    case Fog::IMAGE_FORMAT_XRGB32: return "XRGB32";
+    case Fog::IMAGE_FORMAT_RGB24 : return "RGB24";
+    case Fog::IMAGE_FORMAT_A8    : return "A8";
+    case Fog::IMAGE_FORMAT_I8    : return "I8";
+    case Fog::IMAGE_FORMAT_PRGB64: return "PRGB64";
+    case Fog::IMAGE_FORMAT_RGB48 : return "RGB48";
+    case Fog::IMAGE_FORMAT_A16   : return "A16";
+    default:
+      return "?";
+  }
+}
@@ -0,0 +1,76 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_BENCHCONVERT_H
+#define _FOG_BENCHCONVERT_H
+
+// [Dependencies]
+#include "BenchApp.h"
+
+// ============================================================================
+// [BenchConvert]
+// ============================================================================
+
+//! @brief Pixel format conversion benchmark.
+//!
+//! Measures @c Fog::ImageConverter throughput (in megapixels per second) for
+//! each built-in source format and each destination format supported by the
+//! raster paint engine, and for the most common custom formats (16-bit,
+//! byte-swapped, non-premultiplied), which are converted from/to PRGB32.
+struct BenchConvert
+{
+  BenchConvert(BenchApp& app);
+  ~BenchConvert();
+
+  // --------------------------------------------------------------------------
+  // [Run]
+  // --------------------------------------------------------------------------
+
+  void runAll();
+  void runFormats();
+  void runCustom();
+
+  //! @brief Convert the source buffer to the destination buffer @c quantity
+  //! times and return the throughput in megapixels per second, or a negative
+  //! value if the converter can't be created.
+  double runPair(
+    const Fog::ImageFormatDescription& dstDesc,
+    const Fog::ImageFormatDescription& srcDesc);
+
+  // --------------------------------------------------------------------------
+  // [Helpers]
+  // --------------------------------------------------------------------------
+
+  static const char* getFormatName(uint32_t format);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  BenchApp& app;
+
+  //! @brief Width of the converted buffer (in pixels).
+  int width;
+  //! @brief Height of the converted buffer (in pixels).
+  int height;
+  //! @brief How many times the buffer is converted.
+  uint32_t quantity;
+
+  //! @brief Stride of both buffers (enough to hold 64-bit pixels).
+  size_t stride;
+
+  uint8_t* srcBuffer;
+  uint8_t* dstBuffer;
+
+  //! @brief Palette used by I8 formats.
+  Fog::ImagePalette palette;
+
+private:
+  FOG_NO_COPY(BenchConvert)
+};
+
+// [Guard]
+#endif // _FOG_BENCHCONVERT_H
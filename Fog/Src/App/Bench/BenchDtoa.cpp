@@ -0,0 +1,617 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Dependencies]
+#include "BenchDtoa.h"
+
+#include <Fog/G2d/Svg/SvgUtil.h>
+
+// [Dependencies - C]
+#include <stdarg.h>
+#include <string.h>
+
+// ============================================================================
+// [BenchDtoa - Helpers]
+// ============================================================================
+
+static FOG_INLINE uint64_t BenchDtoa_bits(double d)
+{
+  Fog::DoubleBits bits;
+  bits.d = d;
+  return bits.u64;
+}
+
+static FOG_INLINE double BenchDtoa_fromBits(uint64_t u)
+{
+  Fog::DoubleBits bits;
+  bits.u64 = u;
+  return bits.d;
+}
+
+// Format the digits returned by dtoa as "[-]0.DIGITSeDECPT", which can be
+// parsed back.
+static size_t BenchDtoa_toString(char* dst, const Fog::NTOAContext& ctx)
+{
+  char* p = dst;
+
+  if (ctx.negative)
+    *p++ = '-';
+
+  *p++ = '0';
+  *p++ = '.';
+
+  memcpy(p, ctx.result, ctx.length);
+  p += ctx.length;
+
+  return (size_t)(p - dst) + (size_t)sprintf(p, "e%d", (int)ctx.decpt);
+}
+
+// Modes and counts of digits formatted by checkFormat(). Mode 3 is used only
+// for numbers not too large, because the count of digits is not limited.
+struct BenchDtoaMode
+{
+  uint32_t mode;
+  int nDigits;
+};
+
+static const BenchDtoaMode BenchDtoa_modes[] =
+{
+  { 0,  0 },
+  { 2,  1 }, { 2,  2 }, { 2,  3 }, { 2,  6 }, { 2,  9 },
+  { 2, 10 }, { 2, 15 }, { 2, 16 }, { 2, 17 }, { 2, 20 },
+  { 3, -2 }, { 3,  0 }, { 3,  1 }, { 3,  2 }, { 3,  5 }, { 3, 10 }, { 3, 17 }
+};
+
+// Numbers as written in SVG documents (coordinates, path data, transforms,
+// opacities and offsets).
+static const char BenchDtoa_svgNumbers[][32] =
+{
+  "0", "-0", "1", "-1", ".5", "-.5", "5.", "0.5", "1.5", "10.25", "-3.75",
+  "0.1", "0.2", "0.3", "0.7", "0.9", "0.01", "0.001", "0.0001", "0.000001",
+  "1e3", "1E-3", "-1e+2", "2.5e-7", "1.5e10", "3.14159265358979",
+  "3.1415927", "2.7182817", "1.4142135", "0.70710677", "123456.7",
+  "16777216", "16777217", "33554433", "8388607.5", "0.30000000000000004",
+  "1e-45", "1.4e-45", "7.006492321624085e-46", "1.17549435e-38",
+  "1.1754942e-38", "3.4028235e38", "3.4028236e38", "-3.40282347e+38",
+  "340282356779733661637539395458142568448", "1e39", "1e-50",
+  "123.456", "-0.000123456", "999999.9", "1000000.1", "65535.996",
+  "0.33333334", "0.6666667", "57.29578", "0.017453292"
+};
+
+// Path data used to check the serialized output of SvgUtil.
+static const char BenchDtoa_svgPath[] =
+  "M10.5,20.25 L123456.7,-0.1 C0.3,0.7 1e-5,-1.5e10 .5.5 "
+  "Q16777217,3.1415927 2.7182817,0.70710677 "
+  "L0.1-0.2 0.30000000000000004,1.17549435e-38 Z";
+
+// ============================================================================
+// [BenchDtoa - Construction / Destruction]
+// ============================================================================
+
+BenchDtoa::BenchDtoa(BenchApp& app) :
+  app(app),
+  quantity(200000),
+  mismatches(0),
+  seed(FOG_UINT64_C(0x9E3779B97F4A7C15))
+{
+}
+
+BenchDtoa::~BenchDtoa()
+{
+}
+
+// ============================================================================
+// [BenchDtoa - Run]
+// ============================================================================
+
+void BenchDtoa::runAll()
+{
+  app.logf("Dtoa - fast paths compared with the reference dtoa / strtod\n");
+  app.logf("\n");
+
+  runFormat();
+  runParse();
+  runHalfway();
+  runSvg();
+
+  app.logf("Mismatches        | %u\n", mismatches);
+  app.logf("\n");
+
+  runSpeed();
+  app.logf("\n");
+}
+
+void BenchDtoa::runFormat()
+{
+  uint32_t count = 0;
+  uint32_t failed = 0;
+  uint32_t i;
+  int e;
+
+  // Zero, subnormals and normal boundaries, including their neighbours.
+  static const uint64_t boundaries[] =
+  {
+    FOG_UINT64_C(0x0000000000000000), FOG_UINT64_C(0x0000000000000001),
+    FOG_UINT64_C(0x0000000000000002), FOG_UINT64_C(0x0000000000000003),
+    FOG_UINT64_C(0x00000000FFFFFFFF), FOG_UINT64_C(0x0008000000000000),
+    FOG_UINT64_C(0x000FFFFFFFFFFFFE), FOG_UINT64_C(0x000FFFFFFFFFFFFF),
+    FOG_UINT64_C(0x0010000000000000), FOG_UINT64_C(0x0010000000000001),
+    FOG_UINT64_C(0x001FFFFFFFFFFFFF), FOG_UINT64_C(0x0020000000000000),
+    FOG_UINT64_C(0x3FEFFFFFFFFFFFFF), FOG_UINT64_C(0x3FF0000000000000),
+    FOG_UINT64_C(0x3FF0000000000001), FOG_UINT64_C(0x4340000000000000),
+    FOG_UINT64_C(0x433FFFFFFFFFFFFF), FOG_UINT64_C(0x7FEFFFFFFFFFFFFE),
+    FOG_UINT64_C(0x7FEFFFFFFFFFFFFF)
+  };
+
+  for (i = 0; i < FOG_ARRAY_SIZE(boundaries); i++)
+  {
+    failed += checkFormat(BenchDtoa_fromBits(boundaries[i]));
+    failed += checkFormat(-BenchDtoa_fromBits(boundaries[i]));
+    count += 2;
+  }
+
+  // Powers of two and their neighbours.
+  for (e = 1; e < 2046; e++)
+  {
+    uint64_t u = (uint64_t)e << 52;
+
+    failed += checkFormat(BenchDtoa_fromBits(u - 1));
+    failed += checkFormat(BenchDtoa_fromBits(u));
+    failed += checkFormat(BenchDtoa_fromBits(u + 1));
+    count += 3;
+  }
+
+  // Powers of ten and their neighbours.
+  for (e = -323; e <= 308; e++)
+  {
+    char buf[32];
+    double d;
+
+    fog_api.stringutil_parseDoubleRefA(&d, buf, (size_t)sprintf(buf, "1e%d", e), '.', NULL, NULL);
+    uint64_t u = BenchDtoa_bits(d);
+
+    failed += checkFormat(BenchDtoa_fromBits(u - 1));
+    failed += checkFormat(d);
+    failed += checkFormat(BenchDtoa_fromBits(u + 1));
+    count += 3;
+  }
+
+  // Random doubles.
+  for (i = 0; i < quantity; i++)
+  {
+    failed += checkFormat(nextDouble());
+    count++;
+  }
+
+  app.logf("Format            | %6u values | %u modes | %u mismatches\n",
+    count, (uint32_t)FOG_ARRAY_SIZE(BenchDtoa_modes), failed);
+}
+
+void BenchDtoa::runParse()
+{
+  uint32_t count = 0;
+  uint32_t failed = 0;
+  uint32_t i;
+  int e;
+
+  // Subnormals, the smallest and the largest normal numbers, and numbers
+  // which overflow or underflow.
+  static const char* const strings[] =
+  {
+    "0", "-0", "0e400", "1e-400", "1e400", "-1e400",
+    "4.9406564584124654e-324", "2.4703282292062327e-324",
+    "2.4703282292062328e-324", "2.2250738585072009e-308",
+    "2.2250738585072014e-308", "2.2250738585072011e-308",
+    "1.7976931348623157e308", "1.7976931348623158e308",
+    "1.7976931348623159e308", "179769313486231580793728971405301e276",
+    "9007199254740993", "9007199254740992.5", "18446744073709551615",
+    "18446744073709551616", "0.1", "0.2", "0.3", "1.5", "123.456e-2"
+  };
+
+  for (i = 0; i < FOG_ARRAY_SIZE(strings); i++)
+  {
+    failed += checkParse(strings[i], strlen(strings[i]));
+    count++;
+  }
+
+  // Powers of ten, written as a single digit and as all the digits of the
+  // nearest double.
+  for (e = -330; e <= 310; e++)
+  {
+    char buf[32];
+    double d;
+
+    size_t length = (size_t)sprintf(buf, "1e%d", e);
+    failed += checkParse(buf, length);
+
+    fog_api.stringutil_parseDoubleRefA(&d, buf, length, '.', NULL, NULL);
+    failed += checkParseForms(d);
+    count += 5;
+  }
+
+  // Random decimal numbers and random doubles.
+  for (i = 0; i < quantity; i++)
+  {
+    char buf[64];
+    failed += checkParse(buf, nextDecimal(buf));
+
+    failed += checkParseForms(nextDouble());
+    count += 5;
+  }
+
+  app.logf("Parse             | %6u values | %u mismatches\n", count, failed);
+}
+
+void BenchDtoa::runHalfway()
+{
+  uint32_t count = 0;
+  uint32_t failed = 0;
+
+  // Integers exactly halfway between two adjacent doubles, the halfway value
+  // of mantissa m and exponent k is (2 * m + 1) * 2^(k - 1), which has 16 to
+  // 20 digits. Ties are rounded to even, so a single digit less or more has
+  // to be rounded differently.
+  for (uint32_t i = 0; i < quantity / 8; i++)
+  {
+    uint64_t m = FOG_UINT64_C(0x0010000000000000) | (nextRandom() & FOG_UINT64_C(0x000FFFFFFFFFFFFF));
+    uint32_t k = 1 + (uint32_t)(i % 11);
+
+    uint64_t halfway = ((m << 1) + 1) << (k - 1);
+    char buf[64];
+
+    failed += checkParse(buf, (size_t)sprintf(buf, "%llu", (unsigned long long)halfway));
+    failed += checkParse(buf, (size_t)sprintf(buf, "%llu", (unsigned long long)(halfway - 1)));
+    failed += checkParse(buf, (size_t)sprintf(buf, "%llu", (unsigned long long)(halfway + 1)));
+
+    // The halfway value followed by more digits, which decide the rounding.
+    failed += checkParse(buf, (size_t)sprintf(buf, "%llu.0000000000000000000001", (unsigned long long)halfway));
+    failed += checkParse(buf, (size_t)sprintf(buf, "%llu.0000000000000000000000", (unsigned long long)halfway));
+
+    // The same digits scaled by a power of ten, so the value is not halfway
+    // anymore, but it's still very close to it.
+    int e = (int)(nextRandom() % 600) - 300;
+    failed += checkParse(buf, (size_t)sprintf(buf, "%llue%d", (unsigned long long)halfway, e));
+
+    count += 6;
+  }
+
+  app.logf("Halfway           | %6u values | %u mismatches\n", count, failed);
+}
+
+void BenchDtoa::runSvg()
+{
+  uint32_t count = 0;
+  uint32_t failed = 0;
+  uint32_t i;
+
+  // SVG numbers are parsed from UTF-16 strings and stored as floats.
+  for (i = 0; i < FOG_ARRAY_SIZE(BenchDtoa_svgNumbers); i++)
+  {
+    const char* s = BenchDtoa_svgNumbers[i];
+    size_t length = strlen(s);
+
+    Fog::StringW w = Fog::StringW::fromAscii8(s, length);
+
+    double d0, d1;
+    size_t end0, end1;
+
+    err_t err0 = fog_api.stringutil_parseDoubleW(&d0, w.getData(), length, '.', &end0, NULL);
+    err_t err1 = fog_api.stringutil_parseDoubleRefW(&d1, w.getData(), length, '.', &end1, NULL);
+
+    if (BenchDtoa_bits(d0) != BenchDtoa_bits(d1) || err0 != err1 || end0 != end1)
+    {
+      reportMismatch("SVG parse \"%s\": %.17g (err %u) != %.17g (err %u)",
+        s, d0, (uint32_t)err0, d1, (uint32_t)err1);
+      failed++;
+    }
+
+    count++;
+  }
+
+  // Random floats, the shortest form written by SvgUtil has to be parsed
+  // back to the same float, and it can't be longer than the shortest of the
+  // correctly rounded 1 to 9 digits of the reference dtoa which does it too.
+  for (i = 0; i < quantity; i++)
+  {
+    uint32_t u = (uint32_t)nextRandom();
+    if ((u & 0x7F800000) == 0x7F800000)
+      continue;
+
+    float f;
+    memcpy(&f, &u, 4);
+
+    Fog::NTOAContext ctx;
+    Fog::StringUtil::ftoa(&ctx, f, 0, 0);
+
+    char buf[64];
+    size_t length = BenchDtoa_toString(buf, ctx);
+
+    float back;
+    Fog::StringUtil::parseReal(&back, buf, length);
+
+    uint32_t shortest = 9;
+    for (int n = 1; n < 9; n++)
+    {
+      Fog::NTOAContext ref;
+      fog_api.stringutil_dtoaRef(&ref, double(f), 2, n);
+
+      float refBack;
+      char refBuf[64];
+      Fog::StringUtil::parseReal(&refBack, refBuf, BenchDtoa_toString(refBuf, ref));
+
+      if (refBack == f)
+      {
+        shortest = ref.length;
+        break;
+      }
+    }
+
+    if (memcmp(&back, &f, 4) != 0)
+    {
+      reportMismatch("SVG float %.9g: \"%s\" is parsed back as %.9g", double(f), buf, double(back));
+      failed++;
+    }
+    else if (ctx.length > shortest)
+    {
+      reportMismatch("SVG float %.9g: \"%s\" is longer than %u digits", double(f), buf, shortest);
+      failed++;
+    }
+
+    count++;
+  }
+
+  // Path data parsed, serialized and parsed again.
+  {
+    Fog::PathF path0, path1;
+    Fog::StringW serialized;
+
+    Fog::SvgUtil::parsePath(path0, Fog::StringW::fromAscii8(BenchDtoa_svgPath));
+    Fog::SvgUtil::serializePath(serialized, path0);
+    Fog::SvgUtil::parsePath(path1, serialized);
+
+    if (path0.getLength() != path1.getLength() ||
+        memcmp(path0.getCommands(), path1.getCommands(), path0.getLength()) != 0 ||
+        memcmp(path0.getVertices(), path1.getVertices(), path0.getLength() * sizeof(Fog::PointF)) != 0)
+    {
+      reportMismatch("SVG path is not serialized losslessly");
+      failed++;
+    }
+
+    count++;
+  }
+
+  app.logf("SVG               | %6u values | %u mismatches\n", count, failed);
+}
+
+void BenchDtoa::runSpeed()
+{
+  uint32_t count = quantity;
+  uint32_t i;
+
+  double* values = static_cast<double*>(malloc(count * sizeof(double)));
+  char* strings = static_cast<char*>(malloc(count * 32));
+
+  if (values == NULL || strings == NULL)
+  {
+    free(values);
+    free(strings);
+    return;
+  }
+
+  for (i = 0; i < count; i++)
+  {
+    Fog::NTOAContext ctx;
+
+    values[i] = nextDouble();
+    fog_api.stringutil_dtoaRef(&ctx, values[i], 2, 17);
+    BenchDtoa_toString(strings + i * 32, ctx);
+  }
+
+  app.logf("Dtoa - %u values [ms]\n", count);
+  app.logf("\n");
+
+  // Formatting, the shortest and the 17-digit form.
+  for (int mode = 0; mode <= 2; mode += 2)
+  {
+    int nDigits = mode == 0 ? 0 : 17;
+    Fog::NTOAContext ctx;
+
+    Fog::TimeTicks start = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH);
+    for (i = 0; i < count; i++)
+      fog_api.stringutil_dtoa(&ctx, values[i], mode, nDigits);
+    Fog::TimeDelta fast = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH) - start;
+
+    start = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH);
+    for (i = 0; i < count; i++)
+      fog_api.stringutil_dtoaRef(&ctx, values[i], mode, nDigits);
+    Fog::TimeDelta ref = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH) - start;
+
+    app.logf("Format mode %d     | Fast %8.2f | Ref %8.2f\n",
+      mode, fast.getMillisecondsD(), ref.getMillisecondsD());
+  }
+
+  // Parsing of 17-digit numbers.
+  {
+    double d;
+
+    Fog::TimeTicks start = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH);
+    for (i = 0; i < count; i++)
+      fog_api.stringutil_parseDoubleA(&d, strings + i * 32, strlen(strings + i * 32), '.', NULL, NULL);
+    Fog::TimeDelta fast = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH) - start;
+
+    start = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH);
+    for (i = 0; i < count; i++)
+      fog_api.stringutil_parseDoubleRefA(&d, strings + i * 32, strlen(strings + i * 32), '.', NULL, NULL);
+    Fog::TimeDelta ref = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH) - start;
+
+    app.logf("Parse 17 digits   | Fast %8.2f | Ref %8.2f\n",
+      fast.getMillisecondsD(), ref.getMillisecondsD());
+  }
+
+  free(values);
+  free(strings);
+}
+
+// ============================================================================
+// [BenchDtoa - Check]
+// ============================================================================
+
+uint32_t BenchDtoa::checkFormat(double d)
+{
+  uint32_t failed = 0;
+  int decpt = 0;
+
+  for (uint32_t i = 0; i < FOG_ARRAY_SIZE(BenchDtoa_modes); i++)
+  {
+    uint32_t mode = BenchDtoa_modes[i].mode;
+    int nDigits = BenchDtoa_modes[i].nDigits;
+
+    // The count of digits of mode 3 depends on the decimal point, which is
+    // known from the shortest form (mode 0 is always the first).
+    if (mode == 3 && decpt + nDigits > 200)
+      continue;
+
+    Fog::NTOAContext fast;
+    Fog::NTOAContext ref;
+
+    fog_api.stringutil_dtoa(&fast, d, mode, nDigits);
+    fog_api.stringutil_dtoaRef(&ref, d, mode, nDigits);
+
+    if (mode == 0)
+      decpt = ref.decpt;
+
+    if (fast.negative != ref.negative ||
+        fast.decpt != ref.decpt ||
+        fast.length != ref.length ||
+        memcmp(fast.result, ref.result, ref.length) != 0)
+    {
+      reportMismatch("Format %.17g (mode %u, %d digits): \"%s\" e%d != \"%s\" e%d",
+        d, mode, nDigits, fast.result, fast.decpt, ref.result, ref.decpt);
+      failed++;
+    }
+  }
+
+  return failed;
+}
+
+uint32_t BenchDtoa::checkParse(const char* str, size_t length)
+{
+  double d0, d1;
+  size_t end0, end1;
+
+  err_t err0 = fog_api.stringutil_parseDoubleA(&d0, str, length, '.', &end0, NULL);
+  err_t err1 = fog_api.stringutil_parseDoubleRefA(&d1, str, length, '.', &end1, NULL);
+
+  if (BenchDtoa_bits(d0) == BenchDtoa_bits(d1) && err0 == err1 && end0 == end1)
+    return 0;
+
+  reportMismatch("Parse \"%s\": %.17g (err %u, end %u) != %.17g (err %u, end %u)",
+    str, d0, (uint32_t)err0, (uint32_t)end0, d1, (uint32_t)err1, (uint32_t)end1);
+  return 1;
+}
+
+uint32_t BenchDtoa::checkParseForms(double d)
+{
+  static const BenchDtoaMode forms[] = { { 0, 0 }, { 2, 17 }, { 2, 19 }, { 2, 25 } };
+
+  uint32_t failed = 0;
+
+  for (uint32_t i = 0; i < FOG_ARRAY_SIZE(forms); i++)
+  {
+    Fog::NTOAContext ctx;
+    char buf[64];
+
+    fog_api.stringutil_dtoaRef(&ctx, d, forms[i].mode, forms[i].nDigits);
+    failed += checkParse(buf, BenchDtoa_toString(buf, ctx));
+  }
+
+  return failed;
+}
+
+void BenchDtoa::reportMismatch(const char* fmt, ...)
+{
+  if (++mismatches > 20)
+    return;
+
+  char buf[512];
+
+  va_list ap;
+  va_start(ap, fmt);
+  vsnprintf(buf, FOG_ARRAY_SIZE(buf), fmt, ap);
+  va_end(ap);
+
+  app.logf("  MISMATCH: %s\n", buf);
+}
+
+// ============================================================================
+// [BenchDtoa - Helpers]
+// ============================================================================
+
+double BenchDtoa::nextDouble()
+{
+  uint64_t r = nextRandom();
+
+  // Random bit pattern, exponent 0x7FF (Infinity and NaN) is skipped.
+  if (r & 1)
+  {
+    uint64_t u = nextRandom();
+    if ((u & FOG_UINT64_C(0x7FF0000000000000)) == FOG_UINT64_C(0x7FF0000000000000))
+      u ^= FOG_UINT64_C(0x4000000000000000);
+    return BenchDtoa_fromBits(u);
+  }
+
+  // Random decimal number.
+  char buf[64];
+  size_t length = nextDecimal(buf);
+
+  double d;
+  fog_api.stringutil_parseDoubleRefA(&d, buf, length, '.', NULL, NULL);
+
+  if ((BenchDtoa_bits(d) & FOG_UINT64_C(0x7FF0000000000000)) == FOG_UINT64_C(0x7FF0000000000000))
+    d = 0.0;
+  return d;
+}
+
+size_t BenchDtoa::nextDecimal(char* dst)
+{
+  // Up to 19 significant digits, which is the range of the Eisel-Lemire path.
+  static const uint64_t pow10[] =
+  {
+    FOG_UINT64_C(10),
+    FOG_UINT64_C(100),
+    FOG_UINT64_C(1000),
+    FOG_UINT64_C(10000),
+    FOG_UINT64_C(100000),
+    FOG_UINT64_C(1000000),
+    FOG_UINT64_C(10000000),
+    FOG_UINT64_C(100000000),
+    FOG_UINT64_C(1000000000),
+    FOG_UINT64_C(10000000000),
+    FOG_UINT64_C(100000000000),
+    FOG_UINT64_C(1000000000000),
+    FOG_UINT64_C(10000000000000),
+    FOG_UINT64_C(100000000000000),
+    FOG_UINT64_C(1000000000000000),
+    FOG_UINT64_C(10000000000000000),
+    FOG_UINT64_C(100000000000000000),
+    FOG_UINT64_C(1000000000000000000),
+    FOG_UINT64_C(10000000000000000000)
+  };
+
+  uint64_t r = nextRandom();
+  uint64_t w = nextRandom() % pow10[r % FOG_ARRAY_SIZE(pow10)];
+  int e = (int)((r >> 8) % 640) - 330;
+
+  return (size_t)sprintf(dst, "%llue%d", (unsigned long long)w, e);
+}
+
+uint64_t BenchDtoa::nextRandom()
+{
+  // Xorshift64*.
+  seed ^= seed >> 12;
+  seed ^= seed << 25;
+  seed ^= seed >> 27;
+  return seed * FOG_UINT64_C(0x2545F4914F6CDD1D);
+}
@@ -0,0 +1,103 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_BENCHDTOA_H
+#define _FOG_BENCHDTOA_H
+
+// [Dependencies]
+#include "BenchApp.h"
+
+// ============================================================================
+// [BenchDtoa]
+// ============================================================================
+
+//! @brief Number formatting and parsing benchmark.
+//!
+//! Compares the fast paths of @c Fog::StringUtil::dtoa() (Grisu3) and
+//! @c Fog::StringUtil::parseReal() (Eisel-Lemire) with the reference
+//! implementation (David M. Gay's dtoa / strtod), which is available through
+//! @c fog_api.stringutil_dtoaRef and @c fog_api.stringutil_parseDoubleRefA.
+//! Any mismatch is reported, the test-set is generated by a fixed seed, so
+//! the results are reproducible:
+//!
+//! - Random doubles - random bit patterns (all exponents) and random decimal
+//!   numbers having up to 19 significant digits.
+//! - Boundaries - zero, subnormals, the smallest and the largest normal
+//!   numbers, powers of ten and powers of two, and their neighbours.
+//! - Halfway cases - decimal strings of values exactly halfway between two
+//!   adjacent doubles, and the same strings rounded down/up in the last
+//!   significant digit.
+//! - SVG - numbers in the form used by SVG documents, which are parsed and
+//!   serialized by @c Fog::SvgUtil through the float variants.
+struct BenchDtoa
+{
+  BenchDtoa(BenchApp& app);
+  ~BenchDtoa();
+
+  // --------------------------------------------------------------------------
+  // [Run]
+  // --------------------------------------------------------------------------
+
+  void runAll();
+  void runFormat();
+  void runParse();
+  void runHalfway();
+  void runSvg();
+  void runSpeed();
+
+  // --------------------------------------------------------------------------
+  // [Check]
+  // --------------------------------------------------------------------------
+
+  //! @brief Format @a d by the fast and the reference dtoa in all modes,
+  //! returns the count of mismatches.
+  uint32_t checkFormat(double d);
+
+  //! @brief Parse @a str by the fast and the reference strtod, returns the
+  //! count of mismatches (zero or one).
+  uint32_t checkParse(const char* str, size_t length);
+
+  //! @brief Parse @a d formatted in the shortest, 17-digit, 19-digit and
+  //! 25-digit form, returns the count of mismatches.
+  uint32_t checkParseForms(double d);
+
+  //! @brief Report a mismatch (only the first few are printed).
+  void reportMismatch(const char* fmt, ...);
+
+  // --------------------------------------------------------------------------
+  // [Helpers]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the next double of the test-set (random bit pattern or random
+  //! decimal number, never NaN or Infinity).
+  double nextDouble();
+
+  //! @brief Get the next random decimal number (up to 19 significant digits
+  //! and a random exponent) as a string, returns its length.
+  size_t nextDecimal(char* dst);
+
+  //! @brief Get the next pseudo-random 64-bit number.
+  uint64_t nextRandom();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  BenchApp& app;
+
+  //! @brief Count of random doubles formatted and parsed.
+  uint32_t quantity;
+  //! @brief Count of mismatches found so far.
+  uint32_t mismatches;
+  //! @brief Random generator state.
+  uint64_t seed;
+
+private:
+  FOG_NO_COPY(BenchDtoa)
+};
+
+// [Guard]
+#endif // _FOG_BENCHDTOA_H
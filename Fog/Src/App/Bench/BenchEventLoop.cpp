@@ -0,0 +1,257 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Dependencies]
+#include "BenchEventLoop.h"
+
+// ============================================================================
+// [BenchEventLoopContext]
+// ============================================================================
+
+//! @brief Data shared by producers and the consumer event loop.
+struct BenchEventLoopContext
+{
+  BenchEventLoopContext(Fog::EventLoop* consumer, uint32_t total) :
+    consumer(consumer),
+    total(total),
+    count(0),
+    latencySum(0),
+    latencyMax(0),
+    done(false, false)
+  {
+  }
+
+  //! @brief Called by the consumer thread only.
+  void addLatency(const Fog::TimeTicks& posted)
+  {
+    int64_t latency = (Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH) - posted).getMicroseconds();
+
+    latencySum += latency;
+    if (latency > latencyMax)
+      latencyMax = latency;
+
+    if (++count == total)
+      done.signal();
+  }
+
+  Fog::EventLoop* consumer;
+
+  uint32_t total;
+  uint32_t count;
+
+  int64_t latencySum;
+  int64_t latencyMax;
+
+  Fog::ThreadEvent done;
+};
+
+// ============================================================================
+// [BenchEventLoopTask]
+// ============================================================================
+
+//! @brief Task which records its post -> run latency.
+struct BenchEventLoopTask : public Fog::Task
+{
+  BenchEventLoopTask(BenchEventLoopContext* ctx) :
+    ctx(ctx),
+    posted(Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH))
+  {
+  }
+
+  virtual void run()
+  {
+    ctx->addLatency(posted);
+  }
+
+  BenchEventLoopContext* ctx;
+  Fog::TimeTicks posted;
+};
+
+//! @brief Task which posts @c quantity of @c BenchEventLoopTask tasks.
+struct BenchEventLoopProducerTask : public Fog::Task
+{
+  BenchEventLoopProducerTask(BenchEventLoopContext* ctx, uint32_t quantity) :
+    ctx(ctx),
+    quantity(quantity)
+  {
+  }
+
+  virtual void run()
+  {
+    for (uint32_t i = 0; i < quantity; i++)
+      ctx->consumer->postTask(fog_new BenchEventLoopTask(ctx));
+  }
+
+  BenchEventLoopContext* ctx;
+  uint32_t quantity;
+};
+
+//! @brief Task which records the difference between the time it should be
+//! run at and the time it was run.
+struct BenchEventLoopDelayedTask : public Fog::Task
+{
+  BenchEventLoopDelayedTask(BenchEventLoopContext* ctx, uint32_t delay) :
+    ctx(ctx),
+    due(Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH) + Fog::TimeDelta::fromMilliseconds(delay))
+  {
+  }
+
+  virtual void run()
+  {
+    ctx->addLatency(due);
+  }
+
+  BenchEventLoopContext* ctx;
+  Fog::TimeTicks due;
+};
+
+//! @brief Task which posts @c quantity of @c BenchEventLoopDelayedTask tasks
+//! with pseudo-random delays (up to 500ms).
+struct BenchEventLoopDelayedProducerTask : public Fog::Task
+{
+  BenchEventLoopDelayedProducerTask(BenchEventLoopContext* ctx, uint32_t quantity) :
+    ctx(ctx),
+    quantity(quantity)
+  {
+  }
+
+  virtual void run()
+  {
+    for (uint32_t i = 0; i < quantity; i++)
+    {
+      uint32_t delay = 1 + (i * 7919) % 500;
+      ctx->consumer->postTask(fog_new BenchEventLoopDelayedTask(ctx, delay), true, delay);
+    }
+  }
+
+  BenchEventLoopContext* ctx;
+  uint32_t quantity;
+};
+
+// ============================================================================
+// [BenchEventLoop - Construction / Destruction]
+// ============================================================================
+
+BenchEventLoop::BenchEventLoop(BenchApp& app) :
+  app(app),
+  quantity(100000)
+{
+}
+
+BenchEventLoop::~BenchEventLoop()
+{
+}
+
+// ============================================================================
+// [BenchEventLoop - Run]
+// ============================================================================
+
+void BenchEventLoop::runAll()
+{
+  app.logf("EventLoop - post -> run latency [us]\n");
+  app.logf("\n");
+
+  runPingPong();
+
+  runFlood(1);
+  runFlood(2);
+  runFlood(4);
+  runFlood(8);
+
+  runDelayed();
+
+  app.logf("\n");
+}
+
+void BenchEventLoop::runPingPong()
+{
+  Fog::Thread consumer;
+  if (!consumer.start(FOG_S(APPLICATION_Core_Default)))
+    return;
+
+  uint32_t count = quantity / 10;
+  BenchEventLoopContext ctx(&consumer.getEventLoop(), count);
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    uint32_t last = ctx.count;
+
+    ctx.total = last + 1;
+    consumer.getEventLoop().postTask(fog_new BenchEventLoopTask(&ctx));
+    ctx.done.wait();
+  }
+
+  consumer.stop();
+
+  app.logf("Ping-pong         | %6u tasks | Avg %8.2f | Max %8u\n",
+    count,
+    double(ctx.latencySum) / double(count),
+    (uint32_t)ctx.latencyMax);
+}
+
+void BenchEventLoop::runFlood(int producerCount)
+{
+  Fog::Thread consumer;
+  Fog::Thread producers[8];
+
+  if (producerCount > (int)FOG_ARRAY_SIZE(producers) || !consumer.start(FOG_S(APPLICATION_Core_Default)))
+    return;
+
+  int i;
+  for (i = 0; i < producerCount; i++)
+  {
+    if (!producers[i].start(FOG_S(APPLICATION_Core_Default)))
+      break;
+  }
+
+  if (i == producerCount)
+  {
+    BenchEventLoopContext ctx(&consumer.getEventLoop(), quantity * (uint32_t)producerCount);
+    Fog::TimeTicks start = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH);
+
+    for (i = 0; i < producerCount; i++)
+      producers[i].getEventLoop().postTask(fog_new BenchEventLoopProducerTask(&ctx, quantity));
+
+    ctx.done.wait();
+    Fog::TimeDelta elapsed = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH) - start;
+
+    app.logf("Flood %d producers | %6u tasks | Avg %8.2f | Max %8u | %.0f tasks/s\n",
+      producerCount,
+      ctx.total,
+      double(ctx.latencySum) / double(ctx.total),
+      (uint32_t)ctx.latencyMax,
+      double(ctx.total) * 1000.0 / elapsed.getMillisecondsD());
+  }
+
+  while (--i >= 0)
+    producers[i].stop();
+  consumer.stop();
+}
+
+void BenchEventLoop::runDelayed()
+{
+  Fog::Thread consumer;
+
+  if (!consumer.start(FOG_S(APPLICATION_Core_Default)))
+    return;
+
+  BenchEventLoopContext ctx(&consumer.getEventLoop(), quantity);
+  Fog::TimeTicks start = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH);
+
+  // Post the delayed tasks from the consumer thread, they are sorted into the
+  // delayed work queue as soon as the producer task returns.
+  ctx.consumer->postTask(fog_new BenchEventLoopDelayedProducerTask(&ctx, quantity));
+
+  ctx.done.wait();
+  Fog::TimeDelta elapsed = Fog::TimeTicks::now(Fog::CPU_TICKS_PRECISION_HIGH) - start;
+
+  app.logf("Delayed           | %6u tasks | Avg %8.2f | Max %8u | %.0f ms\n",
+    ctx.total,
+    double(ctx.latencySum) / double(ctx.total),
+    (uint32_t)ctx.latencyMax,
+    elapsed.getMillisecondsD());
+
+  consumer.stop();
+}
@@ -0,0 +1,59 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_BENCHEVENTLOOP_H
+#define _FOG_BENCHEVENTLOOP_H
+
+// [Dependencies]
+#include "BenchApp.h"
+
+// ============================================================================
+// [BenchEventLoop]
+// ============================================================================
+
+//! @brief Event loop benchmark.
+//!
+//! Measures the latency between @c Fog::EventLoop::postTask() and the moment
+//! the task is run by the event loop thread:
+//!
+//! - Ping-pong - one task is posted at a time and the next one is posted
+//!   after it was run, so the latency includes the wakeup of a sleeping
+//!   event loop.
+//! - Flood - more producer threads post tasks as fast as they can, so the
+//!   latency includes the time spent in the queue and the throughput shows
+//!   the contention between producers.
+//! - Delayed - tasks with pseudo-random delays are posted by the event loop
+//!   thread, the latency is the time the task was late and the elapsed time
+//!   includes sorting of the tasks into the delayed work queue.
+struct BenchEventLoop
+{
+  BenchEventLoop(BenchApp& app);
+  ~BenchEventLoop();
+
+  // --------------------------------------------------------------------------
+  // [Run]
+  // --------------------------------------------------------------------------
+
+  void runAll();
+  void runPingPong();
+  void runFlood(int producerCount);
+  void runDelayed();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  BenchApp& app;
+
+  //! @brief Count of tasks posted by each producer.
+  uint32_t quantity;
+
+private:
+  FOG_NO_COPY(BenchEventLoop)
+};
+
+// [Guard]
+#endif // _FOG_BENCHEVENTLOOP_H
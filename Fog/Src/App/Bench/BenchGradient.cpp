@@ -0,0 +1,289 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Dependencies]
+#include "BenchGradient.h"
+
+#include <Fog/G2d/Painting/RasterApi_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/GradientConical_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/GradientRadial_p.h>
+
+// ============================================================================
+// [BenchGradient - Fetchers]
+// ============================================================================
+
+// Copy of the radial and conical fetchers initialized by the raster engine
+// (used by default) and the same tables with the PRGB32/XRGB32 fetchers
+// replaced by the C versions.
+static Fog::RasterGradientFuncs::_Radial BenchGradient_radialDefault;
+static Fog::RasterGradientFuncs::_Conical BenchGradient_conicalDefault;
+
+static Fog::RasterGradientFuncs::_Radial BenchGradient_radialC;
+static Fog::RasterGradientFuncs::_Conical BenchGradient_conicalC;
+
+static void BenchGradient_initFetchers()
+{
+  using namespace Fog;
+
+  BenchGradient_radialDefault = _api_raster.gradient.radial;
+  BenchGradient_conicalDefault = _api_raster.gradient.conical;
+
+  BenchGradient_radialC = BenchGradient_radialDefault;
+  BenchGradient_conicalC = BenchGradient_conicalDefault;
+
+  static const uint32_t formats[] = { IMAGE_FORMAT_PRGB32, IMAGE_FORMAT_XRGB32 };
+  for (size_t i = 0; i < FOG_ARRAY_SIZE(formats); i++)
+  {
+    uint32_t f = formats[i];
+
+    BenchGradient_radialC.fetch_simple_nearest[f][GRADIENT_SPREAD_PAD    ] = RasterOps_C::PGradientRadial::fetch_simple_nearest<RasterOps_C::PGradientAccessor_PRGB32_Pad>;
+    BenchGradient_radialC.fetch_simple_nearest[f][GRADIENT_SPREAD_REPEAT ] = RasterOps_C::PGradientRadial::fetch_simple_nearest<RasterOps_C::PGradientAccessor_PRGB32_Repeat>;
+    BenchGradient_radialC.fetch_simple_nearest[f][GRADIENT_SPREAD_REFLECT] = RasterOps_C::PGradientRadial::fetch_simple_nearest<RasterOps_C::PGradientAccessor_PRGB32_Reflect>;
+
+    BenchGradient_conicalC.fetch_simple_nearest[f] = RasterOps_C::PGradientConical::fetch_simple_nearest<RasterOps_C::PGradientAccessor_PRGB32_Base>;
+  }
+}
+
+// The fetcher is copied from the table when the pattern context is created,
+// so the table has to be switched before the source is set.
+static void BenchGradient_useFetchers(bool useC)
+{
+  Fog::_api_raster.gradient.radial = useC ? BenchGradient_radialC : BenchGradient_radialDefault;
+  Fog::_api_raster.gradient.conical = useC ? BenchGradient_conicalC : BenchGradient_conicalDefault;
+}
+
+// ============================================================================
+// [BenchGradient - Construction / Destruction]
+// ============================================================================
+
+BenchGradient::BenchGradient(BenchApp& app) :
+  app(app),
+  size(256),
+  tolerance(3),
+  maxDifferent(256 * 256 / 100),
+  failures(0),
+  count(0)
+{
+  BenchGradient_initFetchers();
+
+  // Opaque and semi-transparent parts, the stops are continuous at the both
+  // ends, so the repeat spread has no edge where a one-entry difference in
+  // the table index would cause a large difference. No premultiplied channel
+  // changes by more than 0x80 between two stops, which is at most 2 per entry
+  // of a table having 256 or more entries.
+  stops.add(0.00f, Fog::Argb32(0xFF404040));
+  stops.add(0.25f, Fog::Argb32(0xFFC08040));
+  stops.add(0.50f, Fog::Argb32(0x80FFFFFF));
+  stops.add(0.75f, Fog::Argb32(0xFF4080C0));
+  stops.add(1.00f, Fog::Argb32(0xFF404040));
+}
+
+BenchGradient::~BenchGradient()
+{
+  BenchGradient_useFetchers(false);
+}
+
+// ============================================================================
+// [BenchGradient - Run]
+// ============================================================================
+
+void BenchGradient::runAll()
+{
+  app.logf("Gradients (SSE2 vs C fetchers, tolerance %d, max. %d pixels)\n", tolerance, maxDifferent);
+
+  runRadial();
+  runConical();
+
+  app.logf("Gradients: %u of %u comparisons failed\n", failures, count);
+  app.logf("\n");
+}
+
+void BenchGradient::runRadial()
+{
+  static const char* spreadNames[] = { "Pad", "Repeat", "Reflect" };
+
+  struct Focal
+  {
+    const char* name;
+    float fx, fy;
+  };
+
+  // The circle has center [128, 128] and radius 96. The focal points on the
+  // circle and outside of it are degenerate and handled specially by the
+  // context creation.
+  static const Focal focals[] =
+  {
+    { "Center"  , 128.0f, 128.0f },
+    { "Inside"  , 160.0f,  96.0f },
+    { "Near"    , 128.0f,  32.5f },
+    { "Border"  , 224.0f, 128.0f },
+    { "BorderXY", 128.0f + 96.0f * 0.6f, 128.0f + 96.0f * 0.8f },
+    { "Outside" , 240.0f, 200.0f }
+  };
+
+  Fog::TransformF identity;
+  Fog::TransformF rotated;
+  Fog::TransformF skewed;
+
+  rotated.rotate(0.5f, 128.0f, 128.0f);
+  skewed.translate(Fog::PointF(128.0f, 128.0f));
+  skewed.skew(Fog::PointF(0.3f, -0.2f));
+  skewed.scale(Fog::PointF(1.5f, 0.75f));
+  skewed.translate(Fog::PointF(-128.0f, -128.0f));
+
+  for (uint32_t spread = 0; spread < Fog::GRADIENT_SPREAD_COUNT; spread++)
+  {
+    for (size_t i = 0; i < FOG_ARRAY_SIZE(focals); i++)
+    {
+      Fog::RadialGradientF g;
+      g.setStops(stops);
+      g.setGradientSpread(spread);
+      g.setCenter(128.0f, 128.0f);
+      g.setFocal(focals[i].fx, focals[i].fy);
+      g.setRadius(96.0f);
+
+      char name[128];
+
+      sprintf(name, "Radial %s %s", spreadNames[spread], focals[i].name);
+      compare(name, g, identity, Fog::IMAGE_FORMAT_PRGB32);
+      compare(name, g, identity, Fog::IMAGE_FORMAT_XRGB32);
+
+      sprintf(name, "Radial %s %s Rotated", spreadNames[spread], focals[i].name);
+      compare(name, g, rotated, Fog::IMAGE_FORMAT_PRGB32);
+
+      sprintf(name, "Radial %s %s Skewed", spreadNames[spread], focals[i].name);
+      compare(name, g, skewed, Fog::IMAGE_FORMAT_PRGB32);
+
+      // Elliptic radius (the focal point is moved to the same place relative
+      // to the ellipse).
+      g.setRadius(96.0f, 48.0f);
+      g.setFocal(focals[i].fx, 128.0f + (focals[i].fy - 128.0f) * 0.5f);
+
+      sprintf(name, "Radial %s %s Elliptic", spreadNames[spread], focals[i].name);
+      compare(name, g, identity, Fog::IMAGE_FORMAT_PRGB32);
+    }
+  }
+}
+
+void BenchGradient::runConical()
+{
+  // Angles including zero and the multiples of PI/2, where the atan2()
+  // approximation switches the octant.
+  static const float angles[] = { 0.0f, 0.3f, 1.5707964f, 3.1415927f, 4.0f, 6.2831855f };
+
+  // The center at the pixel center [127.5, 127.5] is degenerate (atan2(0, 0)),
+  // the others are between the pixels and outside of the image.
+  static const float centers[][2] =
+  {
+    { 127.5f, 127.5f },
+    { 128.0f, 128.0f },
+    {  40.3f, 200.7f },
+    { -64.0f, 300.0f }
+  };
+
+  Fog::TransformF identity;
+  Fog::TransformF skewed;
+
+  skewed.translate(Fog::PointF(128.0f, 128.0f));
+  skewed.rotate(-0.7f);
+  skewed.skew(Fog::PointF(0.4f, 0.1f));
+  skewed.scale(Fog::PointF(0.5f, 2.0f));
+  skewed.translate(Fog::PointF(-128.0f, -128.0f));
+
+  for (size_t i = 0; i < FOG_ARRAY_SIZE(centers); i++)
+  {
+    for (size_t j = 0; j < FOG_ARRAY_SIZE(angles); j++)
+    {
+      Fog::ConicalGradientF g;
+      g.setStops(stops);
+      g.setCenter(centers[i][0], centers[i][1]);
+      g.setAngle(angles[j]);
+
+      char name[128];
+
+      sprintf(name, "Conical [%g %g] Angle %g", centers[i][0], centers[i][1], angles[j]);
+      compare(name, g, identity, Fog::IMAGE_FORMAT_PRGB32);
+      compare(name, g, identity, Fog::IMAGE_FORMAT_XRGB32);
+
+      sprintf(name, "Conical [%g %g] Angle %g Skewed", centers[i][0], centers[i][1], angles[j]);
+      compare(name, g, skewed, Fog::IMAGE_FORMAT_PRGB32);
+    }
+  }
+}
+
+// ============================================================================
+// [BenchGradient - Compare]
+// ============================================================================
+
+void BenchGradient::compare(const char* name, const Fog::GradientF& gradient, const Fog::TransformF& tr, uint32_t format)
+{
+  Fog::Image imgC;
+  Fog::Image imgDefault;
+
+  if (imgC.create(Fog::SizeI(size, size), format) != Fog::ERR_OK ||
+      imgDefault.create(Fog::SizeI(size, size), format) != Fog::ERR_OK)
+  {
+    app.logf("  %-48s - Out of memory\n", name);
+    failures++;
+    count++;
+    return;
+  }
+
+  render(imgC, gradient, tr, true);
+  render(imgDefault, gradient, tr, false);
+
+  // XRGB32 has the alpha byte undefined.
+  uint32_t mask = (format == Fog::IMAGE_FORMAT_XRGB32) ? 0x00FFFFFF : 0xFFFFFFFF;
+
+  int maxDiff = 0;
+  int different = 0;
+
+  for (int y = 0; y < size; y++)
+  {
+    const uint32_t* pC = reinterpret_cast<const uint32_t*>(imgC.getFirst() + y * imgC.getStride());
+    const uint32_t* pDefault = reinterpret_cast<const uint32_t*>(imgDefault.getFirst() + y * imgDefault.getStride());
+
+    for (int x = 0; x < size; x++)
+    {
+      uint32_t c0 = pC[x] & mask;
+      uint32_t c1 = pDefault[x] & mask;
+
+      if (c0 == c1)
+        continue;
+
+      different++;
+      for (int shift = 0; shift < 32; shift += 8)
+      {
+        int d = Fog::Math::abs((int)((c0 >> shift) & 0xFF) - (int)((c1 >> shift) & 0xFF));
+        maxDiff = Fog::Math::max(maxDiff, d);
+      }
+    }
+  }
+
+  bool ok = maxDiff <= tolerance && different <= maxDifferent;
+  if (!ok)
+    failures++;
+  count++;
+
+  app.logf("  %-48s %s - %s (max. difference %d, %d pixels)\n",
+    name,
+    format == Fog::IMAGE_FORMAT_PRGB32 ? "PRGB32" : "XRGB32",
+    ok ? "OK" : "FAILED",
+    maxDiff, different);
+}
+
+void BenchGradient::render(Fog::Image& dst, const Fog::GradientF& gradient, const Fog::TransformF& tr, bool useC)
+{
+  BenchGradient_useFetchers(useC);
+
+  Fog::Painter p;
+  p.begin(dst);
+  p.setCompositingOperator(Fog::COMPOSITE_SRC);
+  p.setSource(gradient, tr);
+  p.fillAll();
+  p.end();
+
+  BenchGradient_useFetchers(false);
+}
@@ -0,0 +1,81 @@
+// [Fog-Bench]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_BENCHGRADIENT_H
+#define _FOG_BENCHGRADIENT_H
+
+// [Dependencies]
+#include "BenchApp.h"
+
+// ============================================================================
+// [BenchGradient]
+// ============================================================================
+
+//! @brief Gradient fetchers test.
+//!
+//! Renders radial and conical gradients through the fetchers used by the
+//! raster paint engine (SSE2 if available) and through the C fetchers, and
+//! compares the images. All spreads, transforms and degenerate focal points
+//! (focal point equal to the center, on the circle and outside of it, center
+//! of a conical gradient at a pixel center) are covered.
+//!
+//! The SSE2 fetchers compute the color-table index in a different order of
+//! operations (and the conical one uses a polynomial instead of atan2()), so
+//! the index may differ by one. The color-stops change each channel by at
+//! most 2 per table entry, so the images must not differ by more than
+//! @c tolerance in any channel and by more than @c maxDifferent pixels.
+struct BenchGradient
+{
+  BenchGradient(BenchApp& app);
+  ~BenchGradient();
+
+  // --------------------------------------------------------------------------
+  // [Run]
+  // --------------------------------------------------------------------------
+
+  void runAll();
+  void runRadial();
+  void runConical();
+
+  // --------------------------------------------------------------------------
+  // [Compare]
+  // --------------------------------------------------------------------------
+
+  //! @brief Render @a gradient by both fetchers into the image of @a format
+  //! and compare the results.
+  void compare(const char* name, const Fog::GradientF& gradient, const Fog::TransformF& tr, uint32_t format);
+
+  //! @brief Render @a gradient into @a dst by the C fetchers if @a useC is
+  //! true, by the default fetchers otherwise.
+  void render(Fog::Image& dst, const Fog::GradientF& gradient, const Fog::TransformF& tr, bool useC);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  BenchApp& app;
+
+  //! @brief Size of the rendered image.
+  int size;
+  //! @brief Maximum difference of a single channel.
+  int tolerance;
+  //! @brief Maximum count of pixels which differ (in any channel).
+  int maxDifferent;
+
+  //! @brief Count of failed comparisons.
+  uint32_t failures;
+  //! @brief Count of all comparisons.
+  uint32_t count;
+
+  //! @brief Color-stops used by all gradients.
+  Fog::ColorStopList stops;
+
+private:
+  FOG_NO_COPY(BenchGradient)
+};
+
+// [Guard]
+#endif // _FOG_BENCHGRADIENT_H
@@ -444,6 +444,7 @@
 #include <Fog/Core/Threading/Atomic.h>
 #include <Fog/Core/Threading/AtomicPadding.h>
 #include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Threading/TaskScheduler.h>
 #include <Fog/Core/Threading/Thread.h>
 #include <Fog/Core/Threading/ThreadCondition.h>
 #include <Fog/Core/Threading/ThreadEvent.h>
@@ -467,6 +468,7 @@
 #include <Fog/Core/Tools/ContainerUtil.h>
 #include <Fog/Core/Tools/Cpu.h>
 #include <Fog/Core/Tools/Date.h>
+#include <Fog/Core/Tools/FlatHash.h>
 #include <Fog/Core/Tools/Hash.h>
 #include <Fog/Core/Tools/HashString.h>
 #include <Fog/Core/Tools/HashUntyped.h>
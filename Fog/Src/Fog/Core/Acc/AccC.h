@@ -442,6 +442,9 @@ static FOG_INLINE void p32Load2uBSwap(uint32_t& dst0, const void* srcp)
 #endif // FOG_ARCH_UNALIGNED_ACCESS_16
 }
 
+//! @brief Load 3 bytes in native byte-order (the byte at the lowest address
+//! is the least significant byte on little-endian and the most significant
+//! byte on big-endian), the upper 8 bits of @a dst0 are zero.
 static FOG_INLINE void p32Load3b(uint32_t& dst0, const void* srcp)
 {
   const uint8_t* src8 = reinterpret_cast<const uint8_t*>(srcp);
@@ -451,11 +454,11 @@ static FOG_INLINE void p32Load3b(uint32_t& dst0, const void* srcp)
   dst0 = _FOG_ACC_COMBINE_2( static_cast<uint32_t>(((const uint16_t*)(src8 + 0))[0]),
                               static_cast<uint32_t>(((const uint8_t *)(src8 + 2))[0]) << 16);
 # else
-  dst0 = _FOG_ACC_COMBINE_2( static_cast<uint32_t>(((const uint8_t *)(src8 + 0))[0]) << 16),
-                              static_cast<uint32_t>(((const uint16_t*)(src8 + 1))[0]));
+  dst0 = _FOG_ACC_COMBINE_2( static_cast<uint32_t>(((const uint8_t *)(src8 + 0))[0]) << 16,
+                              static_cast<uint32_t>(((const uint16_t*)(src8 + 1))[0])      );
 # endif // FOG_BYTE_ORDER
 #else
-# if FOG_BYTE_ORDER == FOG_LITTLE_ENDIAN
+# if FOG_BYTE_ORDER == FOG_BIG_ENDIAN
   dst0 = _FOG_ACC_COMBINE_3( static_cast<uint32_t>(((const uint8_t *)(src8 + 0))[0]) << 16,
                               static_cast<uint32_t>(((const uint8_t *)(src8 + 1))[0]) <<  8,
                               static_cast<uint32_t>(((const uint8_t *)(src8 + 2))[0])      );
@@ -467,11 +470,12 @@ static FOG_INLINE void p32Load3b(uint32_t& dst0, const void* srcp)
 #endif
 }
 
+//! @brief Load 3 bytes in swapped byte-order (opposite to @c p32Load3b()).
 static FOG_INLINE void p32Load3bBSwap(uint32_t& dst0, const void* srcp)
 {
   const uint8_t* src8 = reinterpret_cast<const uint8_t*>(srcp);
 
-#if FOG_BYTE_ORDER == FOG_LITTLE_ENDIAN
+#if FOG_BYTE_ORDER == FOG_BIG_ENDIAN
   dst0 = _FOG_ACC_COMBINE_3( static_cast<uint32_t>(((const uint8_t *)(src8 + 0))[0])      ,
                               static_cast<uint32_t>(((const uint8_t *)(src8 + 1))[0]) <<  8,
                               static_cast<uint32_t>(((const uint8_t *)(src8 + 2))[0]) << 16);
@@ -608,6 +612,8 @@ static FOG_INLINE void p32Store2uBSwap(void* dstp, const uint32_t& src0)
   ((uint16_t*)dstp)[0] = MemOps::bswap16( (uint16_t)(src0) );
 }
 
+//! @brief Store the lower 3 bytes of @a src0 in native byte-order (inverse
+//! of @c p32Load3b()).
 static FOG_INLINE void p32Store3b(void* dstp, const uint32_t& src0)
 {
   uint8_t* dst8 = reinterpret_cast<uint8_t*>(dstp);
@@ -621,11 +627,13 @@ static FOG_INLINE void p32Store3b(void* dstp, const uint32_t& src0)
 #endif // FOG_BYTE_ORDER
 }
 
+//! @brief Store the lower 3 bytes of @a src0 in swapped byte-order (inverse
+//! of @c p32Load3bBSwap()).
 static FOG_INLINE void p32Store3bBSwap(void* dstp, const uint32_t& src0)
 {
   uint8_t* dst8 = reinterpret_cast<uint8_t*>(dstp);
 
-#if FOG_BYTE_ORDER == FOG_LITTLE_ENDIAN
+#if FOG_BYTE_ORDER == FOG_BIG_ENDIAN
   ((uint8_t *)(dst8 + 0))[0] = (uint8_t)(src0      );
   ((uint8_t *)(dst8 + 1))[0] = (uint8_t)(src0 >>  8);
   ((uint8_t *)(dst8 + 2))[0] = (uint8_t)(src0 >> 16);
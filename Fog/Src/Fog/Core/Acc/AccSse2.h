@@ -377,7 +377,7 @@ static FOG_INLINE void m128iCvt256From255PI16(
   __m128i& dst0, const __m128i& x0)
 {
   dst0 = _mm_mullo_epi16(x0, FOG_XMM_GET_CONST_PI(0081008100810081_0081008100810081));
-  dst0 = _mm_slli_epi16(dst0, 7);
+  dst0 = _mm_srli_epi16(dst0, 7);
 }
 
 static FOG_INLINE void m128iCvt256From255PI16_2x(
@@ -387,8 +387,8 @@ static FOG_INLINE void m128iCvt256From255PI16_2x(
   dst0 = _mm_mullo_epi16(x0, FOG_XMM_GET_CONST_PI(0081008100810081_0081008100810081));
   dst1 = _mm_mullo_epi16(x1, FOG_XMM_GET_CONST_PI(0081008100810081_0081008100810081));
 
-  dst0 = _mm_slli_epi16(dst0, 7);
-  dst1 = _mm_slli_epi16(dst1, 7);
+  dst0 = _mm_srli_epi16(dst0, 7);
+  dst1 = _mm_srli_epi16(dst1, 7);
 }
 
 // ============================================================================
@@ -1596,6 +1596,21 @@ static FOG_INLINE void m128iRShiftPI32(__m128i& dst0, const __m128i& x0)
   dst0 = _mm_srai_epi32(x0, COUNT_BITS);
 }
 
+static FOG_INLINE void m128iRShiftPI32(__m128i& dst0, const __m128i& x0, const __m128i& count)
+{
+  dst0 = _mm_sra_epi32(x0, count);
+}
+
+static FOG_INLINE void m128iLShiftPU32(__m128i& dst0, const __m128i& x0, const __m128i& count)
+{
+  dst0 = _mm_sll_epi32(x0, count);
+}
+
+static FOG_INLINE void m128iRShiftPU32(__m128i& dst0, const __m128i& x0, const __m128i& count)
+{
+  dst0 = _mm_srl_epi32(x0, count);
+}
+
 // ============================================================================
 // [Fog::Acc - SSE2 - Negate255/256]
 // ============================================================================
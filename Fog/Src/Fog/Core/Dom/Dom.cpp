@@ -14,6 +14,7 @@
 #include <Fog/Core/Memory/MemOps.h>
 #include <Fog/Core/Tools/Logger.h>
 #include <Fog/Core/Tools/InternedString.h>
+#include <Fog/Core/Tools/StringTmp_p.h>
 #include <Fog/Core/Tools/StringUtil.h>
 #include <Fog/Core/Tools/XmlIO.h>
 
@@ -1787,7 +1788,15 @@ err_t DomElement::setId(const StringW& id)
     // Ensure that the hash code stored in _id is valid, because it's accessed
     // directly without calling getHashCode() again.
     _id.getHashCode();
-    getOwnerDocument()->_idHash.add(this);
+
+    // The element has no ID if it can't be added to the hash (out of memory),
+    // it wouldn't be found by getElementById() otherwise.
+    err = getOwnerDocument()->_idHash.add(this);
+    if (FOG_IS_ERROR(err))
+    {
+      _id.reset();
+      return err;
+    }
   }
 
   return ERR_OK;
@@ -2173,49 +2182,36 @@ DomDocumentType::~DomDocumentType()
 // [Fog::DomDocumentIdHash - Construction / Destruction]
 // ============================================================================
 
-DomDocumentIdHash::DomDocumentIdHash() :
-  _capacity(13),
-  _length(0),
-  _expandCapacity(47),
-  _expandLength(13),
-  _shrinkCapacity(0),
-  _shrinkLength(0),
-  _buckets(_bucketsBuffer)
+DomDocumentIdHash::DomDocumentIdHash()
 {
-  MemOps::zero(_bucketsBuffer, sizeof(_bucketsBuffer));
 }
 
 DomDocumentIdHash::~DomDocumentIdHash()
 {
-  if (_buckets != _bucketsBuffer)
-    MemMgr::free(_buckets);
 }
 
-void DomDocumentIdHash::add(DomElement* element)
+err_t DomDocumentIdHash::add(DomElement* element)
 {
-  uint32_t hashCode = element->_id._d->hashCode;
-  uint32_t hashMod = hashCode % _capacity;
-
-  DomElement** pPrev = &_buckets[hashMod];
-  DomElement* cur = *pPrev;
+  DomElement** pPrev = _hash.usePtr(element->_id);
+  element->_nextId = NULL;
 
-  while (cur)
-  {
-    pPrev = &cur->_nextId;
-    cur = *pPrev;
-  }
+  if (pPrev == NULL)
+    return _hash.put(element->_id, element);
 
+  while (*pPrev)
+    pPrev = &(*pPrev)->_nextId;
   *pPrev = element;
-  if (++_length >= _expandLength)
-    _rehash(_expandCapacity);
+
+  return ERR_OK;
 }
 
 void DomDocumentIdHash::remove(DomElement* element)
 {
-  uint32_t hashCode = element->_id._d->hashCode;
-  uint32_t hashMod = hashCode % _capacity;
+  DomElement** pFirst = _hash.usePtr(element->_id);
+  if (pFirst == NULL)
+    return;
 
-  DomElement** pPrev = &_buckets[hashMod];
+  DomElement** pPrev = pFirst;
   DomElement* cur = *pPrev;
 
   while (cur)
@@ -2225,8 +2221,8 @@ void DomDocumentIdHash::remove(DomElement* element)
       *pPrev = cur->_nextId;
       cur->_nextId = NULL;
 
-      if (--_length <= _shrinkLength)
-        _rehash(_shrinkCapacity);
+      if (*pFirst == NULL)
+        _hash.remove(element->_id);
       return;
     }
 
@@ -2237,83 +2233,12 @@ void DomDocumentIdHash::remove(DomElement* element)
 
 DomElement* DomDocumentIdHash::get(const StringW& id) const
 {
-  uint32_t hashCode = id.getHashCode();
-  uint32_t hashMod = hashCode % _capacity;
-
-  DomElement* cur = _buckets[hashMod];
-  while (cur)
-  {
-    if (cur->_id == id)
-      return cur;
-    cur = cur->_nextId;
-  }
-  return NULL;
+  return _hash.get(id, NULL);
 }
 
 DomElement* DomDocumentIdHash::get(const StubW& id) const
 {
-  size_t idLength = id.getComputedLength();
-  const CharW* idData = id.getData();
-
-  uint32_t hashCode = HashUtil::hash(StubW(idData, idLength));
-  uint32_t hashMod = hashCode % _capacity;
-
-  DomElement* cur = _buckets[hashMod];
-  while (cur)
-  {
-    const StringDataW* curId = cur->_id._d;
-    if (curId->length == idLength && StringUtil::eq(curId->data, idData, idLength))
-      return cur;
-    cur = cur->_nextId;
-  }
-  return NULL;
-}
-
-void DomDocumentIdHash::_rehash(size_t capacity)
-{
-  DomElement** oldBuckets = _buckets;
-  DomElement** newBuckets = (DomElement**)MemMgr::calloc(capacity * sizeof(DomElement*));
-
-  if (newBuckets == NULL)
-    return;
-
-  size_t i, len = _capacity;
-  for (i = 0; i < len; i++)
-  {
-    DomElement* cur = oldBuckets[i];
-    while (cur)
-    {
-      uint32_t hashMod = cur->_id._d->hashCode % capacity;
-      DomElement* next = cur->_nextId;
-
-      DomElement** newPPrev = &newBuckets[hashMod];
-      DomElement* newCur = *newPPrev;
-
-      while (newCur)
-      {
-        newPPrev = &newCur->_nextId;
-        newCur = *newPPrev;
-      }
-
-      *newPPrev = cur;
-      cur->_nextId = NULL;
-
-      cur = next;
-    }
-  }
-
-  _capacity = capacity;
-
-  _expandCapacity = fog_api.hashhelper_calcExpandCapacity(capacity);
-  _expandLength = (size_t)((ssize_t)_capacity * 0.92);
-
-  _shrinkCapacity = fog_api.hashhelper_calcShrinkCapacity(capacity);
-  _shrinkLength = (size_t)((ssize_t)_shrinkCapacity * 0.70);
-
-  atomicPtrXchg(&_buckets, newBuckets);
-
-  if (oldBuckets != _bucketsBuffer)
-    MemMgr::free(oldBuckets);
+  return _hash.get(id, NULL);
 }
 
 // ============================================================================
@@ -2743,33 +2668,13 @@ err_t DomSaxHandler::onEndDocument()
 
 err_t DomSaxHandler::onStartElement(const StubW& tagName)
 {
-  if (FOG_IS_NULL(_currentContainer))
-    return ERR_RT_INVALID_STATE;
-
-  if (_currentContainer == _document && _document->getDocumentElement() != NULL)
-    return ERR_XML_SAX_INTERNAL;
-
   InternedStringW tagNameInterned(tagName);
-  DomElement* obj = _document->createElement(tagNameInterned);
-
-  if (FOG_IS_NULL(obj))
-    return ERR_RT_OUT_OF_MEMORY;
-
-  err_t err = _currentContainer->appendChild(obj);
-  if (FOG_IS_ERROR(err))
-    return err;
-
-  _currentContainer = obj;
-  return ERR_OK;
+  return _startElement(tagNameInterned);
 }
 
 err_t DomSaxHandler::onEndElement(const StubW& tagName)
 {
-  if (FOG_IS_NULL(_currentContainer) || _currentContainer == _document)
-    return ERR_RT_INVALID_STATE;
-
-  _currentContainer = _currentContainer->_parentNode;
-  return ERR_OK;
+  return _endElement();
 }
 
 err_t DomSaxHandler::onAttribute(const StubW& name, const StubW& value)
@@ -2780,29 +2685,7 @@ err_t DomSaxHandler::onAttribute(const StubW& name, const StubW& value)
   InternedStringW nameInterned(name);
   StringW valueString(value);
 
-  // In called on DomDocument then the attribute is related to <?xml ... ?> content.
-  if (_currentContainer == _document)
-  {
-    if (nameInterned == FOG_S(version))
-      return _document->setXmlVersion(valueString);
-    
-    if (nameInterned == FOG_S(encoding))
-      return _document->setXmlEncoding(valueString);
-
-    if (nameInterned == FOG_S(standalone))
-    {
-      bool standalone = false;
-      if (valueString.parseBool(&standalone) == ERR_OK)
-        return _document->setXmlStandalone(standalone);
-    }
-
-    return ERR_OK;
-  }
-  else
-  {
-    return static_cast<DomElement*>(_currentContainer)->setAttribute(
-      nameInterned, valueString);
-  }
+  return _addAttribute(nameInterned, valueString);
 }
 
 err_t DomSaxHandler::onCharacterData(const StubW& data)
@@ -2811,12 +2694,7 @@ err_t DomSaxHandler::onCharacterData(const StubW& data)
     return ERR_RT_INVALID_STATE;
 
   StringW dataString(data);
-  DomText* obj = _document->createTextNode(dataString);
-
-  if (FOG_IS_NULL(obj))
-    return ERR_RT_OUT_OF_MEMORY;
-
-  return _currentContainer->appendChild(obj);
+  return _addCharacterData(dataString);
 }
 
 err_t DomSaxHandler::onIgnorableWhitespace(const StubW& data)
@@ -2837,12 +2715,7 @@ err_t DomSaxHandler::onCDATASection(const StubW& data)
     return ERR_RT_INVALID_STATE;
 
   StringW dataString(data);
-  DomCDATASection* obj = _document->createCDATASection(dataString);
-
-  if (FOG_IS_NULL(obj))
-    return ERR_RT_OUT_OF_MEMORY;
-
-  return _currentContainer->appendChild(obj);
+  return _addCDATASection(dataString);
 }
 
 err_t DomSaxHandler::onComment(const StubW& data)
@@ -2851,12 +2724,7 @@ err_t DomSaxHandler::onComment(const StubW& data)
     return ERR_RT_INVALID_STATE;
 
   StringW dataString(data);
-  DomComment* obj = _document->createComment(dataString);
-
-  if (FOG_IS_NULL(obj))
-    return ERR_RT_OUT_OF_MEMORY;
-
-  return _currentContainer->appendChild(obj);
+  return _addComment(dataString);
 }
 
 err_t DomSaxHandler::onProcessingInstruction(const StubW& target, const StubW& data)
@@ -2890,4 +2758,211 @@ err_t DomSaxHandler::onFatal(const XmlSaxLocation& location, err_t errorCode)
   return errorCode;
 }
 
+// ============================================================================
+// [Fog::DomSaxHandler - SAX Interface (UTF-8)]
+// ============================================================================
+
+// ASCII element and attribute names are interned without converting them to
+// UTF-16 first. Values which are kept by the DOM are decoded directly into
+// their final strings.
+
+static FOG_INLINE bool DomSaxHandler_isAscii(const StubA& stub)
+{
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(stub.getData());
+  size_t length = stub.getLength();
+
+  for (size_t i = 0; i < length; i++)
+  {
+    if (p[i] >= 0x80)
+      return false;
+  }
+
+  return true;
+}
+
+static err_t DomSaxHandler_setUtf8(StringW& dst, const StubA& src)
+{
+  const char* sData = src.getData();
+  size_t sLength = src.getLength();
+
+  CharW* dData = dst._prepare(CONTAINER_OP_REPLACE, sLength);
+  if (FOG_IS_NULL(dData))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  // Widen ASCII in place (the string is allocated with the exact length), use
+  // the UTF-8 codec only if there is a non-ASCII character.
+  if (StringUtil::unicodeFromAscii(dData, sData, sLength) == sLength)
+    return ERR_OK;
+
+  return dst.set(Utf8(sData, sLength));
+}
+
+err_t DomSaxHandler::onStartElementUtf8(const StubA& tagName)
+{
+  // Only ASCII names are looked-up directly, others are converted to UTF-16.
+  if (!DomSaxHandler_isAscii(tagName))
+    return XmlSaxHandler::onStartElementUtf8(tagName);
+
+  InternedStringW tagNameInterned(Ascii8(tagName.getData(), tagName.getLength()));
+  return _startElement(tagNameInterned);
+}
+
+err_t DomSaxHandler::onEndElementUtf8(const StubA& tagName)
+{
+  return _endElement();
+}
+
+err_t DomSaxHandler::onAttributeUtf8(const StubA& name, const StubA& value)
+{
+  if (FOG_IS_NULL(_currentContainer))
+    return ERR_RT_INVALID_STATE;
+
+  InternedStringW nameInterned;
+  if (DomSaxHandler_isAscii(name))
+  {
+    FOG_RETURN_ON_ERROR(nameInterned.set(Ascii8(name.getData(), name.getLength())));
+  }
+  else
+  {
+    StringTmpW<TEMPORARY_LENGTH> nameW;
+    FOG_RETURN_ON_ERROR(nameW.set(Utf8(name.getData(), name.getLength())));
+    FOG_RETURN_ON_ERROR(nameInterned.set(StubW(nameW.getData(), nameW.getLength())));
+  }
+
+  StringW valueString;
+  FOG_RETURN_ON_ERROR(DomSaxHandler_setUtf8(valueString, value));
+
+  return _addAttribute(nameInterned, valueString);
+}
+
+err_t DomSaxHandler::onCharacterDataUtf8(const StubA& data)
+{
+  if (FOG_IS_NULL(_currentContainer))
+    return ERR_RT_INVALID_STATE;
+
+  StringW dataString;
+  FOG_RETURN_ON_ERROR(DomSaxHandler_setUtf8(dataString, data));
+
+  return _addCharacterData(dataString);
+}
+
+err_t DomSaxHandler::onIgnorableWhitespaceUtf8(const StubA& data)
+{
+  // TODO:
+  return ERR_OK;
+}
+
+err_t DomSaxHandler::onCDATASectionUtf8(const StubA& data)
+{
+  if (FOG_IS_NULL(_currentContainer) || _currentContainer == _document)
+    return ERR_RT_INVALID_STATE;
+
+  StringW dataString;
+  FOG_RETURN_ON_ERROR(DomSaxHandler_setUtf8(dataString, data));
+
+  return _addCDATASection(dataString);
+}
+
+err_t DomSaxHandler::onCommentUtf8(const StubA& data)
+{
+  if (FOG_IS_NULL(_currentContainer))
+    return ERR_RT_INVALID_STATE;
+
+  StringW dataString;
+  FOG_RETURN_ON_ERROR(DomSaxHandler_setUtf8(dataString, data));
+
+  return _addComment(dataString);
+}
+
+// ============================================================================
+// [Fog::DomSaxHandler - SAX Helpers]
+// ============================================================================
+
+err_t DomSaxHandler::_startElement(const InternedStringW& tagName)
+{
+  if (FOG_IS_NULL(_currentContainer))
+    return ERR_RT_INVALID_STATE;
+
+  if (_currentContainer == _document && _document->getDocumentElement() != NULL)
+    return ERR_XML_SAX_INTERNAL;
+
+  DomElement* obj = _document->createElement(tagName);
+
+  if (FOG_IS_NULL(obj))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  err_t err = _currentContainer->appendChild(obj);
+  if (FOG_IS_ERROR(err))
+    return err;
+
+  _currentContainer = obj;
+  return ERR_OK;
+}
+
+err_t DomSaxHandler::_endElement()
+{
+  if (FOG_IS_NULL(_currentContainer) || _currentContainer == _document)
+    return ERR_RT_INVALID_STATE;
+
+  _currentContainer = _currentContainer->_parentNode;
+  return ERR_OK;
+}
+
+err_t DomSaxHandler::_addAttribute(const InternedStringW& nameInterned, const StringW& valueString)
+{
+  // In called on DomDocument then the attribute is related to <?xml ... ?> content.
+  if (_currentContainer == _document)
+  {
+    if (nameInterned == FOG_S(version))
+      return _document->setXmlVersion(valueString);
+    
+    if (nameInterned == FOG_S(encoding))
+      return _document->setXmlEncoding(valueString);
+
+    if (nameInterned == FOG_S(standalone))
+    {
+      bool standalone = false;
+      if (valueString.parseBool(&standalone) == ERR_OK)
+        return _document->setXmlStandalone(standalone);
+    }
+
+    return ERR_OK;
+  }
+  else
+  {
+    return static_cast<DomElement*>(_currentContainer)->setAttribute(
+      nameInterned, valueString);
+  }
+}
+
+err_t DomSaxHandler::_addCharacterData(const StringW& data)
+{
+  DomText* obj = _document->createTextNode(data);
+
+  if (FOG_IS_NULL(obj))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  return _currentContainer->appendChild(obj);
+}
+
+err_t DomSaxHandler::_addCDATASection(const StringW& data)
+{
+  DomCDATASection* obj = _document->createCDATASection(data);
+
+  if (FOG_IS_NULL(obj))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  return _currentContainer->appendChild(obj);
+}
+
+err_t DomSaxHandler::_addComment(const StringW& data)
+{
+  DomComment* obj = _document->createComment(data);
+
+  if (FOG_IS_NULL(obj))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  return _currentContainer->appendChild(obj);
+}
+
 } // Fog namespace
@@ -13,6 +13,7 @@
 #include <Fog/Core/Kernel/CoreObj.h>
 #include <Fog/Core/Memory/MemGCAllocator.h>
 #include <Fog/Core/Threading/Atomic.h>
+#include <Fog/Core/Tools/FlatHash.h>
 #include <Fog/Core/Tools/Hash.h>
 #include <Fog/Core/Tools/InternedString.h>
 #include <Fog/Core/Tools/List.h>
@@ -479,6 +480,9 @@ struct FOG_API DomElement : public DomContainer
   FOG_INLINE const StringW& getId() const { return _id; }
 
   //! @brief Set element id.
+  //!
+  //! If the element can't be registered by the owner document (out of
+  //! memory), the element has no id and the error is returned.
   err_t setId(const StringW& id);
   //! @brief Reset element id.
   FOG_INLINE err_t resetId() { return setId(StringW::getEmptyInstance()); }
@@ -775,42 +779,20 @@ struct FOG_API DomDocumentIdHash
   // [Methods]
   // --------------------------------------------------------------------------
 
-  void add(DomElement* element);
+  err_t add(DomElement* element);
   void remove(DomElement* element);
 
   DomElement* get(const StringW& id) const;
   DomElement* get(const StubW& id) const;
 
-  // --------------------------------------------------------------------------
-  // [Internal]
-  // --------------------------------------------------------------------------
-
-  void _rehash(size_t capacity);
-
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
 
-  //! @brief Count of buckets.
-  size_t _capacity;
-  //! @brief Count of elements.
-  size_t _length;
+  //! @brief The first element of each ID, other elements with the same ID are
+  //! linked by @c DomElement::_nextId.
+  FlatHash<StringW, DomElement*> _hash;
 
-  //! @brief Count of buckets we will expand to if length exceeds _expandLength.
-  size_t _expandCapacity;
-  //! @brief Count of elements to grow.
-  size_t _expandLength;
-
-  //! @brief Count of buckets we will shrink to if length gets _shinkLength.
-  size_t _shrinkCapacity;
-  //! @brief Count of elements to shrink.
-  size_t _shrinkLength;
-
-  //! @brief Buckets.
-  DomElement** _buckets;
-  //! @brief Initial buckets.
-  DomElement* _bucketsBuffer[13];
-  
 private:
   FOG_NO_COPY(DomDocumentIdHash)
 };
@@ -1051,6 +1033,39 @@ struct FOG_API DomSaxHandler : public XmlSaxHandler
   virtual err_t onError(const XmlSaxLocation& location, err_t errorCode) override;
   virtual err_t onFatal(const XmlSaxLocation& location, err_t errorCode) override;
 
+  // --------------------------------------------------------------------------
+  // [SAX - Interface (UTF-8)]
+  // --------------------------------------------------------------------------
+
+  // NOTE: These don't call the UTF-16 events, override both when subclassing.
+
+  virtual err_t onStartElementUtf8(const StubA& tagName) override;
+  virtual err_t onEndElementUtf8(const StubA& tagName) override;
+  virtual err_t onAttributeUtf8(const StubA& name, const StubA& value) override;
+
+  virtual err_t onCharacterDataUtf8(const StubA& data) override;
+  virtual err_t onIgnorableWhitespaceUtf8(const StubA& data) override;
+
+  virtual err_t onCDATASectionUtf8(const StubA& data) override;
+  virtual err_t onCommentUtf8(const StubA& data) override;
+
+  // --------------------------------------------------------------------------
+  // [SAX - Helpers]
+  // --------------------------------------------------------------------------
+
+  //! @brief Shared part of @c onStartElement() and @c onStartElementUtf8().
+  err_t _startElement(const InternedStringW& tagName);
+  //! @brief Shared part of @c onEndElement() and @c onEndElementUtf8().
+  err_t _endElement();
+  //! @brief Shared part of @c onAttribute() and @c onAttributeUtf8().
+  err_t _addAttribute(const InternedStringW& name, const StringW& value);
+  //! @brief Shared part of @c onCharacterData() and @c onCharacterDataUtf8().
+  err_t _addCharacterData(const StringW& data);
+  //! @brief Shared part of @c onCDATASection() and @c onCDATASectionUtf8().
+  err_t _addCDATASection(const StringW& data);
+  //! @brief Shared part of @c onComment() and @c onCommentUtf8().
+  err_t _addComment(const StringW& data);
+
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
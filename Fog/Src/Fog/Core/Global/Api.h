@@ -135,6 +135,7 @@ struct FOG_NO_EXPORT Api
 
   FOG_CAPI_STATIC(uint64_t, memmgr_getAmountOfPhysicalMemory)(void);
   FOG_CAPI_STATIC(uint32_t, memmgr_getAmountOfPhysicalMemoryMB)(void);
+  FOG_CAPI_STATIC(uint64_t, memmgr_getAmountOfCachedMemory)(void);
 
   // --------------------------------------------------------------------------
   // [Core/Memory - MemOps]
@@ -470,6 +471,24 @@ struct FOG_NO_EXPORT Api
 
   ThreadPool* threadpool_oInstance;
 
+  // --------------------------------------------------------------------------
+  // [Core/Threading - TaskScheduler]
+  // --------------------------------------------------------------------------
+
+  FOG_CAPI_CTOR(taskscheduler_ctor)(TaskScheduler* self);
+  FOG_CAPI_DTOR(taskscheduler_dtor)(TaskScheduler* self);
+
+  FOG_CAPI_METHOD(err_t, taskscheduler_spawn)(TaskScheduler* self, TaskGroup* group, TaskSchedulerFunc func, void* closure, int affinity);
+  FOG_CAPI_METHOD(void, taskscheduler_wait)(TaskScheduler* self, TaskGroup* group);
+  FOG_CAPI_METHOD(void, taskscheduler_parallelFor)(TaskScheduler* self, size_t start, size_t end, size_t grain, TaskSchedulerRangeFunc func, void* closure);
+
+  FOG_CAPI_METHOD(int, taskscheduler_getNumWorkers)(const TaskScheduler* self);
+  FOG_CAPI_METHOD(int, taskscheduler_getMaxWorkers)(const TaskScheduler* self);
+  FOG_CAPI_METHOD(err_t, taskscheduler_setMaxWorkers)(TaskScheduler* self, int maxWorkers);
+  FOG_CAPI_METHOD(int, taskscheduler_getCurrentWorker)(const TaskScheduler* self);
+
+  TaskScheduler* taskscheduler_oInstance;
+
   // --------------------------------------------------------------------------
   // [Core/Tools - CharUtil]
   // --------------------------------------------------------------------------
@@ -1368,6 +1387,9 @@ struct FOG_NO_EXPORT Api
   FOG_CAPI_STATIC(err_t, stringutil_latinFromUnicode)(char* dst, const CharW* src, size_t length);
   FOG_CAPI_STATIC(void, stringutil_unicodeFromLatin)(CharW* dst, const char* src, size_t length);
 
+  FOG_CAPI_STATIC(size_t, stringutil_asciiFromUnicode)(char* dst, const CharW* src, size_t length);
+  FOG_CAPI_STATIC(size_t, stringutil_unicodeFromAscii)(CharW* dst, const char* src, size_t length);
+
   FOG_CAPI_STATIC(void, stringutil_moveA)(char* dst, const char* src, size_t length);
   FOG_CAPI_STATIC(void, stringutil_moveW)(CharW* dst, const CharW* src, size_t length);
 
@@ -1449,6 +1471,8 @@ struct FOG_NO_EXPORT Api
   FOG_CAPI_STATIC(void, stringutil_itoa)(NTOAContext* ctx, int64_t n, uint32_t base, uint32_t textCase);
   FOG_CAPI_STATIC(void, stringutil_utoa)(NTOAContext* ctx, uint64_t n, uint32_t base, uint32_t textCase);
   FOG_CAPI_STATIC(void, stringutil_dtoa)(NTOAContext* ctx, double d, uint32_t mode, int nDigits);
+  FOG_CAPI_STATIC(void, stringutil_ftoa)(NTOAContext* ctx, float d, uint32_t mode, int nDigits);
+  FOG_CAPI_STATIC(void, stringutil_dtoaRef)(NTOAContext* ctx, double d, uint32_t mode, int nDigits);
 
   FOG_CAPI_STATIC(err_t, stringutil_parseBoolA)(bool* dst, const char* src, size_t length, size_t* pEnd, uint32_t* pFlags);
   FOG_CAPI_STATIC(err_t, stringutil_parseBoolW)(bool* dst, const CharW* src, size_t length, size_t* pEnd, uint32_t* pFlags);
@@ -1482,6 +1506,8 @@ struct FOG_NO_EXPORT Api
 
   FOG_CAPI_STATIC(err_t, stringutil_parseDoubleA)(double* dst, const char* src, size_t length, char decimalPoint, size_t* pEnd, uint32_t* pFlags);
   FOG_CAPI_STATIC(err_t, stringutil_parseDoubleW)(double* dst, const CharW* src, size_t length, uint16_t decimalPoint, size_t* pEnd, uint32_t* pFlags);
+  FOG_CAPI_STATIC(err_t, stringutil_parseDoubleRefA)(double* dst, const char* src, size_t length, char decimalPoint, size_t* pEnd, uint32_t* pFlags);
+  FOG_CAPI_STATIC(err_t, stringutil_parseDoubleRefW)(double* dst, const CharW* src, size_t length, uint16_t decimalPoint, size_t* pEnd, uint32_t* pFlags);
 
   // --------------------------------------------------------------------------
   // [Core/Tools - TextCodec]
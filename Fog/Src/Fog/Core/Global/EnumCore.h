@@ -1364,7 +1364,15 @@ enum DF_FORM
   DF_EXPONENT = 1,
 
   //! @brief Significant digits (compatible with "%g").
-  DF_SIGNIFICANT_DIGITS = 2
+  DF_SIGNIFICANT_DIGITS = 2,
+
+  //! @brief Shortest form which parses back to the same double (precision
+  //! is ignored).
+  DF_SHORTEST = 3,
+
+  //! @brief Shortest form which parses back to the same float (precision
+  //! is ignored).
+  DF_SHORTEST_FLOAT = 4
 };
 
 // ============================================================================
@@ -2114,6 +2122,7 @@ enum STR
   STR_cy,
   STR_d,
   STR_defs,
+  STR_delay,
   STR_depth,
   STR_direction,
   STR_display,
@@ -2158,6 +2167,7 @@ enum STR
   STR_lighting_color,
   STR_line,
   STR_linearGradient,
+  STR_loopCount,
   STR_marker,
   STR_marker_end,
   STR_marker_mid,
@@ -2215,6 +2225,7 @@ enum STR
   STR_textLength,
   STR_textPath,
   STR_tga,
+  STR_threads,
   STR_tif,
   STR_tiff,
   STR_transform,
@@ -1871,6 +1871,30 @@ enum IMAGE_MIRROR_MODE
   IMAGE_MIRROR_COUNT = 4
 };
 
+// ============================================================================
+// [Fog::IMAGE_PNG_FILTER]
+// ============================================================================
+
+//! @brief Row filter used by the PNG encoder (the "filter" property).
+enum IMAGE_PNG_FILTER
+{
+  //! @brief Rows are not filtered.
+  IMAGE_PNG_FILTER_NONE = 0,
+  //! @brief Difference to the left pixel.
+  IMAGE_PNG_FILTER_SUB = 1,
+  //! @brief Difference to the pixel above.
+  IMAGE_PNG_FILTER_UP = 2,
+  //! @brief Difference to the average of the left and above pixels.
+  IMAGE_PNG_FILTER_AVERAGE = 3,
+  //! @brief Difference to the Paeth predictor.
+  IMAGE_PNG_FILTER_PAETH = 4,
+  //! @brief Filter is selected per row, using the minimum sum of absolute
+  //! differences heuristic (default, indexed images are not filtered).
+  IMAGE_PNG_FILTER_ADAPTIVE = 5,
+
+  IMAGE_PNG_FILTER_COUNT = 6
+};
+
 // ============================================================================
 // [Fog::IMAGE_PRECISION]
 // ============================================================================
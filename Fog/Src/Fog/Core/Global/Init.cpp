@@ -103,6 +103,7 @@ FOG_CAPI_DECLARE void _fog_init(void)
   EventLoop_init();
   Thread_init();                 // Depends on EventLoop.
   ThreadPool_init();
+  TaskScheduler_init();          // Depends on ThreadPool.
 
   // [Core/Kernel]
   MemGCAllocator_init();
@@ -180,6 +181,8 @@ FOG_CAPI_DECLARE void _fog_init(void)
   FeTurbulence_init();
 
   // [G2d/Painting]
+  RasterFilterCache_init();
+  RasterGradientCache_init();
   RasterOps_init();
   Rasterizer_init();
   PaintDeviceInfo_init();
@@ -200,6 +203,10 @@ FOG_CAPI_DECLARE void _fog_fini(void)
   // [G2d/Text]
   Font_fini();
 
+  // [G2d/Painting]
+  RasterGradientCache_fini();
+  RasterFilterCache_fini();
+
   // [G2d/OS]
 #if defined(FOG_OS_WINDOWS)
   WinUtil_G2d_fini();
@@ -215,6 +222,7 @@ FOG_CAPI_DECLARE void _fog_fini(void)
   Object_fini();
 
   // [Core/Threading]
+  TaskScheduler_fini();
   ThreadPool_fini();
   Thread_fini();
 
@@ -79,6 +79,9 @@ FOG_NO_EXPORT void Thread_fini(void);
 FOG_NO_EXPORT void ThreadPool_init(void);
 FOG_NO_EXPORT void ThreadPool_fini(void);
 
+FOG_NO_EXPORT void TaskScheduler_init(void);
+FOG_NO_EXPORT void TaskScheduler_fini(void);
+
 // [Fog/Core/Tools]
 FOG_NO_EXPORT void CharUtil_init(void);
 
@@ -178,6 +181,10 @@ FOG_NO_EXPORT void WinUtil_G2d_fini(void);
 // [Fog/G2d/Painting]
 FOG_NO_EXPORT void Painter_init(void);
 FOG_NO_EXPORT void PaintDeviceInfo_init(void);
+FOG_NO_EXPORT void RasterFilterCache_init(void);
+FOG_NO_EXPORT void RasterFilterCache_fini(void);
+FOG_NO_EXPORT void RasterGradientCache_init(void);
+FOG_NO_EXPORT void RasterGradientCache_fini(void);
 FOG_NO_EXPORT void RasterOps_init(void);
 FOG_NO_EXPORT void Rasterizer_init(void);
 
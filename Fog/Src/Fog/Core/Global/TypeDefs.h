@@ -89,6 +89,10 @@ struct WinVersion;
 // Fog/Core/Threading.
 template<typename T> struct Atomic;
 struct Lock;
+struct TaskGroup;
+struct TaskScheduler;
+struct TaskSchedulerJob;
+struct TaskSchedulerWorker;
 struct Thread;
 struct ThreadCondition;
 struct ThreadEvent;
@@ -227,6 +231,7 @@ struct ImageConverterClosure;
 struct ImageConverterData;
 struct ImageData;
 struct ImageDecoder;
+struct ImageDecoderHandler;
 struct ImageDither8Params;
 struct ImageEncoder;
 struct ImageFilter;
@@ -236,6 +241,7 @@ struct ImageFilterScaleD;
 struct ImageFormatDescription;
 struct ImagePalette;
 struct ImagePaletteData;
+struct ImagePipeline;
 struct ImageVTable;
 
 // Fog/G2d/Imaging/Filters.
@@ -436,6 +442,9 @@ typedef bool (FOG_CDECL *EqFunc)(const void* a, const void* b);
 typedef int (FOG_CDECL *CompareFunc)(const void* a, const void* b);
 typedef int (FOG_CDECL *CompareExFunc)(const void* a, const void* b, const void* data);
 
+typedef void (FOG_CDECL *TaskSchedulerFunc)(void* closure);
+typedef void (FOG_CDECL *TaskSchedulerRangeFunc)(void* closure, size_t start, size_t end);
+
 typedef EventLoopImpl* (*EventLoopConstructor)(void);
 
 // ============================================================================
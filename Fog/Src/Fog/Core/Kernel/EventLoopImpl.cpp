@@ -18,13 +18,13 @@
 #include <Fog/Core/Kernel/EventLoopImpl.h>
 #include <Fog/Core/Kernel/Task.h>
 #include <Fog/Core/OS/OSUtil.h>
+#include <Fog/Core/Threading/Atomic.h>
 #include <Fog/Core/Threading/Lock.h>
 #include <Fog/Core/Threading/ThreadEvent.h>
 #include <Fog/Core/Tools/InternedString.h>
 #include <Fog/Core/Tools/List.h>
 #include <Fog/Core/Tools/Logger.h>
 #include <Fog/Core/Tools/String.h>
-#include <Fog/Core/Tools/Swap.h>
 #include <Fog/Core/Tools/Time.h>
 
 namespace Fog {
@@ -72,9 +72,14 @@ EventLoopImpl::EventLoopImpl(const StringW& type) :
   _isObservable(0),
   _isDestroyed(0),
   _quitting(0),
-  _flag_0(0)
+  _flag_0(0),
+  _delayedWorkSequence(0)
 {
   _reference.init(1);
+
+  _incomingHead = &_incomingStub;
+  _incomingTail = &_incomingStub;
+  _workScheduled.init(0);
 }
 
 EventLoopImpl::~EventLoopImpl()
@@ -186,28 +191,25 @@ err_t EventLoopImpl::quit()
 
 err_t EventLoopImpl::postTask(Task* task, bool nestable, uint32_t delay)
 {
-  EventLoopPendingTask pendingTask(task, nestable);
-  bool wasEmpty;
-
   // Warning: Don't try to short-circuit, and handle this thread's tasks more
   // directly, as it could starve handling of foreign threads. Put every task
   // into this queue.
+  task->_postNestable = nestable;
+  task->_postTime = Time();
+
   if (delay > 0)
-    pendingTask.setTime(Time::now() + TimeDelta::fromMilliseconds(delay));
-
-  { // Synchronized.
-    AutoLock locked(lock);
-    wasEmpty = _incomingQueue.isEmpty();
-    
-    // If this fails then nothing happen, except that the task won't be
-    // posted. This means that the called must do something. In many
-    // situations this can be end of the application, because posting task
-    // into another thread is very important.
-    FOG_RETURN_ON_ERROR(_incomingQueue.append(pendingTask));
-  }
+    task->_postTime = Time::now() + TimeDelta::fromMilliseconds(delay);
 
+  pushIncomingTask(task);
+
+  // Wake up the event loop only once per reload of the incoming queue, the
+  // flag is cleared by reloadWorkQueue() before it takes the tasks, so a task
+  // pushed after that always gets its own scheduleWork() call. The flag is
+  // read after the full barrier in pushIncomingTask(), when the task is
+  // already visible to the consumer.
+  //
   // Event loop can be over at this time.
-  if (wasEmpty)
+  if (_workScheduled.get() == 0 && _workScheduled.cmpXchg(0, 1))
     scheduleWork();
 
   return ERR_OK;
@@ -239,40 +241,145 @@ bool EventLoopImpl::deferOrRunPendingTask(const EventLoopPendingTask& pendingTas
 
 bool EventLoopImpl::addToDelayedWorkQueue(const EventLoopPendingTask& pendingTask)
 {
-  size_t i = 0, length = _delayedWorkQueue.getLength();
-  const EventLoopPendingTask* tasks = _delayedWorkQueue.getData();
+  EventLoopPendingTask item(pendingTask);
+  item.setSequence(_delayedWorkSequence++);
+
+  size_t i = _delayedWorkQueue.getLength();
+  if (FOG_IS_ERROR(_delayedWorkQueue.append(item)))
+    return false;
 
-  // TODO: Use binary search.
-  while (i < length)
+  // Sift up.
+  EventLoopPendingTask* heap = _delayedWorkQueue.getDataX();
+  while (i > 0)
   {
-    if (tasks[i].getTime() > pendingTask.getTime())
+    size_t parent = (i - 1) / 2;
+    if (!item.isBefore(heap[parent]))
       break;
-    i++;
-  }
 
-  // Move to the delayed work queue.
-  _delayedWorkQueue.insert(i, pendingTask);
+    heap[i] = heap[parent];
+    i = parent;
+  }
+  heap[i] = item;
 
   return i == 0;
 }
 
+void EventLoopImpl::removeFirstDelayedTask()
+{
+  size_t length = _delayedWorkQueue.getLength();
+  FOG_ASSERT(length > 0);
+
+  // Move the last task to the top and sift it down, the last slot is removed
+  // afterwards.
+  EventLoopPendingTask* heap = _delayedWorkQueue.getDataX();
+  EventLoopPendingTask item = heap[--length];
+
+  size_t i = 0;
+  for (;;)
+  {
+    size_t child = i * 2 + 1;
+    if (child >= length)
+      break;
+
+    if (child + 1 < length && heap[child + 1].isBefore(heap[child]))
+      child++;
+
+    if (!heap[child].isBefore(item))
+      break;
+
+    heap[i] = heap[child];
+    i = child;
+  }
+  heap[i] = item;
+
+  _delayedWorkQueue.removeLast();
+}
+
 void EventLoopImpl::reloadWorkQueue()
 {
-  // We can improve performance of our loading tasks from _incomingQueue to
+  // We can improve performance of our loading tasks from incomingQueue to
   // workQueue by waiting until the last minute (workQueue is empty) to
-  // load. That reduces the number of locks-per-task significantly when our
-  // queues get large.
+  // load.
 
-  // Wait till we really need to lock and load.
+  // Wait till we really need to load.
   if (!_workQueue.isEmpty()) return;
 
-  // Acquire all we can from the inter-thread queue with one lock acquisition.
+  // Full barrier, producers which see the cleared flag after this point will
+  // call scheduleWork(), the others pushed the task before we take it.
+  _workScheduled.setXchg(0);
+
+  Task* task;
+  while ((task = takeIncomingTask()) != NULL)
   {
-    AutoLock locked(lock);
+    EventLoopPendingTask pendingTask(task, task->_postNestable);
+    pendingTask.setTime(task->_postTime);
 
-    if (_incomingQueue.isEmpty()) return;
-    swap(_incomingQueue, _workQueue);
+    if (FOG_IS_ERROR(_workQueue.append(pendingTask)))
+    {
+      // Out of memory, leave the task at the consumer end (takeIncomingTask()
+      // doesn't modify its link, so moving the tail back is enough) and wake
+      // up the event loop to try it again, the flag was already cleared.
+      _incomingTail = task;
+
+      _workScheduled.setXchg(1);
+      scheduleWork();
+      break;
+    }
+  }
+}
+
+void EventLoopImpl::pushIncomingTask(Task* task)
+{
+  AtomicCore<Task*>::set(&task->_postNext, NULL);
+
+  // Full barrier, the task is visible to the consumer once linked.
+  Task* prev = atomicPtrXchg(&_incomingHead, task);
+
+  // Full barrier too, postTask() reads _workScheduled after the task was
+  // linked. A plain store could be reordered after that load, the producer
+  // would see the flag still set while reloadWorkQueue() clears it and can't
+  // see the task yet, and the wakeup would be lost.
+  atomicPtrXchg(&prev->_postNext, task);
+}
+
+Task* EventLoopImpl::takeIncomingTask()
+{
+  Task* stub = &_incomingStub;
+  Task* tail = _incomingTail;
+  Task* next = AtomicCore<Task*>::get(&tail->_postNext);
+
+  if (tail == stub)
+  {
+    if (next == NULL)
+      return NULL;
+
+    _incomingTail = next;
+    tail = next;
+    next = AtomicCore<Task*>::get(&next->_postNext);
+  }
+
+  if (next != NULL)
+  {
+    _incomingTail = next;
+    return tail;
   }
+
+  // The tail is the last task, unless a producer already exchanged the head
+  // and didn't link it yet.
+  if (tail != AtomicCore<Task*>::get(&_incomingHead))
+    return NULL;
+
+  // Push the stub behind the last task, so the task can be taken.
+  pushIncomingTask(stub);
+
+  next = AtomicCore<Task*>::get(&tail->_postNext);
+  if (next != NULL)
+  {
+    _incomingTail = next;
+    return tail;
+  }
+
+  return NULL;
 }
 
 bool EventLoopImpl::deletePendingTasks()
@@ -313,7 +420,7 @@ bool EventLoopImpl::deletePendingTasks()
   while (!_delayedWorkQueue.isEmpty())
   {
     Task* task = _delayedWorkQueue.getFirst().getTask();
-    _delayedWorkQueue.removeFirst();
+    removeFirstDelayedTask();
 
     if (task->getDestroyOnFinish())
       task->destroy();
@@ -367,7 +474,7 @@ bool EventLoopImpl::doDelayedWork(Time* nextDelayedWorkTime)
   }
 
   EventLoopPendingTask pendingTask = _delayedWorkQueue.getFirst();
-  _delayedWorkQueue.removeFirst();
+  removeFirstDelayedTask();
 
   if (!_delayedWorkQueue.isEmpty())
     *nextDelayedWorkTime = _delayedWorkQueue.getAt(0).getTime();
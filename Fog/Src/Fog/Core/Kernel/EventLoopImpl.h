@@ -16,6 +16,8 @@
 #include <Fog/Core/Kernel/EventLoop.h>
 #include <Fog/Core/Kernel/EventLoopObserverList.h>
 #include <Fog/Core/Kernel/Task.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/Core/Threading/AtomicPadding.h>
 #include <Fog/Core/Threading/Lock.h>
 #include <Fog/Core/Tools/List.h>
 #include <Fog/Core/Tools/String.h>
@@ -33,7 +35,8 @@ namespace Fog {
 //! @brief Pending task used inside @c EventLoop.
 struct FOG_NO_EXPORT EventLoopPendingTask
 {
-  FOG_INLINE EventLoopPendingTask(Task* task, bool nestable)
+  FOG_INLINE EventLoopPendingTask(Task* task, bool nestable) :
+    _sequence(0)
   {
     setTask(task, nestable);
   }
@@ -85,11 +88,36 @@ struct FOG_NO_EXPORT EventLoopPendingTask
     _time = time;
   }
 
+  //! @brief Get sequence number (order of delayed tasks with the same time).
+  FOG_INLINE uint32_t getSequence() const
+  {
+    return _sequence;
+  }
+
+  //! @brief Set sequence number.
+  FOG_INLINE void setSequence(uint32_t sequence)
+  {
+    _sequence = sequence;
+  }
+
+  //! @brief Get whether the task should be run before @a other delayed task.
+  //!
+  //! Tasks with the same time are ordered by their sequence number, so they
+  //! are run in the same order in which they were posted. The sequence number
+  //! can wrap around.
+  FOG_INLINE bool isBefore(const EventLoopPendingTask& other) const
+  {
+    if (_time != other._time)
+      return _time < other._time;
+    else
+      return (int32_t)(_sequence - other._sequence) < 0;
+  }
+
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
 
-  // Make the structure 16-bytes long. If compiled for 64-bit CPU then nestable
+  // Make the structure 24-bytes long. If compiled for 64-bit CPU then nestable
   // flag is stored together with the pointer, because last three bits are 
   // always zero (alignment). If compiled for 32-bit then we have two 32-bit
   // values to use (pointer, and nestable value).
@@ -104,10 +132,25 @@ struct FOG_NO_EXPORT EventLoopPendingTask
   uint32_t _isNestable;
 #endif // FOG_ARCH_BITS
 
+  //! @brief Sequence number (used by delayed work queue).
+  uint32_t _sequence;
+
   //! @brief Delayed time.
   Time _time;
 };
 
+// ============================================================================
+// [Fog::EventLoopIncomingStub]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Stub node of the @c EventLoopImpl incoming queue, never run.
+struct FOG_NO_EXPORT EventLoopIncomingStub : public Task
+{
+  virtual void run() {}
+};
+
 // ============================================================================
 // [Fog::EventLoopImpl]
 // ============================================================================
@@ -279,11 +322,24 @@ struct FOG_API EventLoopImpl
   //! timer.
   bool addToDelayedWorkQueue(const EventLoopPendingTask& pendingTask);
 
+  //! @brief Removes the first task (the task which should be run first) from
+  //! delayedWorkQueue.
+  void removeFirstDelayedTask();
+
   //! @brief Load tasks from the incomingQueue into workQueue if the latter is
-  //! empty. The former requires a lock to access, while the latter is directly
+  //! empty. The former is shared by all threads, while the latter is directly
   //! accessible on this thread.
   void reloadWorkQueue();
 
+  //! @brief Append @a task to the incoming queue (can be called by any thread).
+  void pushIncomingTask(Task* task);
+  //! @brief Take the oldest task from the incoming queue (can be called only by
+  //! the event loop thread).
+  //!
+  //! Returns @c NULL if the queue is empty or if a producer is in the middle of
+  //! appending the task (such producer calls @c scheduleWork() afterwards).
+  Task* takeIncomingTask();
+
   //! @brief Delete tasks that haven't run yet without running them. Used in the
   //! destructor to make sure all the task's destructors get called. Returns
   //! true if some work was done.
@@ -363,19 +419,37 @@ struct FOG_API EventLoopImpl
   //! @brief Current work queue (may also contain delayed tasks).
   List<EventLoopPendingTask> _workQueue;
   //! @brief Current delayed work queue (parsed originally from @c workQueue).
+  //!
+  //! The queue is a binary min-heap ordered by @c EventLoopPendingTask::isBefore(),
+  //! the first task is always the one which should be run first.
   List<EventLoopPendingTask> _delayedWorkQueue;
+  //! @brief Sequence number of the next task added to delayed work queue.
+  uint32_t _delayedWorkSequence;
   //! @brief Current deferred work queue (tasks that will be called by
   //! non-nested event loop).
   List<EventLoopPendingTask> _deferredWorkQueue;
 
-  //! @brief Protect access to incomingQueue and observerList.
+  //! @brief Protect access to observerList.
   Lock lock;
 
-  //! @brief List which creates an incomingQueue of tasks that are aquired under
-  //! incomingLock for processing on this instance's thread. These tasks have not
-  //! yet been sorted out into items for our workQueue vs items that will be
-  //! handled by the timer manager.
-  List<EventLoopPendingTask> _incomingQueue;
+  // The incomingQueue is an intrusive lock-free multiple-producer single-
+  // consumer queue (Dmitry Vyukov's algorithm), linked by Task::_postNext.
+  // Tasks posted from any thread are appended to the head by a single atomic
+  // exchange and taken from the tail by this instance's thread. These tasks
+  // have not yet been sorted out into items for our workQueue vs items that
+  // will be handled by the timer manager.
+
+  //! @brief The most recently posted task (modified by producers).
+  Task* _incomingHead;
+  AtomicPadding1<Task*> _incomingPadding;
+  //! @brief The oldest task in the incoming queue (the stub if it's empty).
+  Task* _incomingTail;
+  //! @brief Stub node, keeps the queue non-empty.
+  EventLoopIncomingStub _incomingStub;
+
+  //! @brief Whether @c scheduleWork() was called since the event loop thread
+  //! reloaded the incoming queue last time (coalesces the wakeups).
+  Atomic<int> _workScheduled;
 
   //! @brief List of event observers.
   EventLoopObserverList<EventLoopObserver> _observerList;
@@ -13,7 +13,7 @@
 #include <Fog/Core/Kernel/Event.h>
 #include <Fog/Core/Kernel/EventLoop.h>
 #include <Fog/Core/Kernel/Object.h>
-#include <Fog/Core/Memory/MemPool.h>
+#include <Fog/Core/Memory/MemMgr.h>
 #include <Fog/Core/Threading/Thread.h>
 #include <Fog/Core/Threading/Lock.h>
 #include <Fog/Core/Tools/Hash.h>
@@ -35,9 +35,13 @@ const MetaClass* Object::_staticMetaClass;
 Static<Lock> Object::_internalLock;
 
 static Static<ObjectExtra> Object_extraNull;
-static Static<Lock> Object_memPoolLock;
-static Static<MemPool> Object_memPoolExtra;
-static Static<MemPool> Object_memPoolConn;
+
+// ============================================================================
+// [Fog::ObjectExtra - Construction / Destruction]
+// ============================================================================
+
+ObjectExtra::ObjectExtra() {}
+ObjectExtra::~ObjectExtra() {}
 
 // ============================================================================
 // [Fog::Object - Helpers]
@@ -45,15 +49,10 @@ static Static<MemPool> Object_memPoolConn;
 
 static ObjectExtra* ObjectExtra_create()
 {
-  ObjectExtra* extra;
+  ObjectExtra* extra = reinterpret_cast<ObjectExtra*>(MemMgr::alloc(sizeof(ObjectExtra)));
 
-  { // Synchronized.
-    AutoLock locked(Object_memPoolLock);
-
-    extra = reinterpret_cast<ObjectExtra*>(Object_memPoolExtra->alloc(sizeof(ObjectExtra)));
-    if (FOG_IS_NULL(extra))
-      return NULL;
-  }
+  if (FOG_IS_NULL(extra))
+    return NULL;
 
   return fog_new_p(extra) ObjectExtra();
 }
@@ -61,11 +60,7 @@ static ObjectExtra* ObjectExtra_create()
 static void ObjectExtra_destroy(ObjectExtra* extra)
 {
   extra->~ObjectExtra();
-
-  { // Synchronized.
-    AutoLock locked(Object_memPoolLock);
-    Object_memPoolExtra->free(extra);
-  }
+  MemMgr::free(extra);
 }
 
 // ============================================================================
@@ -590,7 +585,7 @@ uint Object::removeListener(Object* listener)
 
 _Begin:
   {
-    HashIterator<uint32_t, ObjectConnection*> it(extra->_forwardConnection);
+    FlatHashIterator<uint32_t, ObjectConnection*> it(extra->_forwardConnection);
 
     while (it.isValid())
     {
@@ -652,7 +647,7 @@ uint Object::removeAllListeners()
   ObjectConnection* conn;
   ObjectConnection* next;
 
-  HashIterator<uint32_t, ObjectConnection*> it(extra->_forwardConnection);
+  FlatHashIterator<uint32_t, ObjectConnection*> it(extra->_forwardConnection);
 
 
   while (it.isValid())
@@ -908,13 +903,8 @@ FOG_NO_EXPORT void Object_init(void)
 
   Object::_staticMetaClass = &_privateObjectMetaClass;
 
-  // Initialize the locks.
+  // Initialize the lock.
   Object::_internalLock.init();
-  Object_memPoolLock.init();
-
-  // Initialize the memory pools.
-  Object_memPoolExtra.init();
-  Object_memPoolConn.init();
 
   // Initialize the ObjectExtra null (initial) instance.
   Object_extraNull.init();
@@ -925,12 +915,7 @@ FOG_NO_EXPORT void Object_fini(void)
   // Destroy the shared ObjectExtra instance.
   Object_extraNull.destroy();
 
-  // Destroy the memory pools.
-  Object_memPoolConn.destroy();
-  Object_memPoolExtra.destroy();
-
-  // Destroy the locks.
-  Object_memPoolLock.destroy();
+  // Destroy the lock.
   Object::_internalLock.destroy();
 }
 
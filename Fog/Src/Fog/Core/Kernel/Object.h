@@ -14,6 +14,7 @@
 #include <Fog/Core/Threading/Atomic.h>
 #include <Fog/Core/Threading/Thread.h>
 #include <Fog/Core/Tools/Char.h>
+#include <Fog/Core/Tools/FlatHash.h>
 #include <Fog/Core/Tools/Hash.h>
 #include <Fog/Core/Tools/HashUtil.h>
 #include <Fog/Core/Tools/List.h>
@@ -288,8 +289,8 @@ struct FOG_NO_EXPORT ObjectExtra
   // [Construction / Destruction]
   // --------------------------------------------------------------------------
 
-  FOG_INLINE ObjectExtra() {}
-  FOG_INLINE ~ObjectExtra() {}
+  ObjectExtra();
+  ~ObjectExtra();
 
   // --------------------------------------------------------------------------
   // [Members]
@@ -302,7 +303,7 @@ struct FOG_NO_EXPORT ObjectExtra
   List<Object*> _children;
 
   //! @brief Dynamic properties.
-  Hash<StringW, Var> _properties;
+  FlatHash<StringW, Var> _properties;
 
   //! @brief The forward connection between us and other objects.
   //!
@@ -310,7 +311,7 @@ struct FOG_NO_EXPORT ObjectExtra
   //! listening us.
   //!
   //! @note Access to this structure must be always locked by @c Object::_internalLock.
-  Hash<uint32_t, ObjectConnection*> _forwardConnection;
+  FlatHash<uint32_t, ObjectConnection*> _forwardConnection;
 
   //! @brief The backward connection between us and other objects.
   //!
@@ -19,7 +19,10 @@ namespace Fog {
 // [Fog::Task]
 // ============================================================================
 
-Task::Task() : _destroyOnFinish(true)
+Task::Task() :
+  _destroyOnFinish(true),
+  _postNestable(true),
+  _postNext(NULL)
 {
 }
 
@@ -9,6 +9,7 @@
 
 // [Dependencies]
 #include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Tools/Time.h>
 
 namespace Fog {
 
@@ -49,6 +50,16 @@ struct FOG_API Task
 
   bool _destroyOnFinish;
 
+  //! @brief Whether the task was posted as nestable (used by @c EventLoopImpl).
+  bool _postNestable;
+  //! @brief Next task in the incoming queue of @c EventLoopImpl.
+  //!
+  //! The incoming queue is intrusive, so a task can be posted again only after
+  //! it was taken from the queue (for example when it's being run).
+  Task* _postNext;
+  //! @brief Time when the posted task should run (null if it's not delayed).
+  Time _postTime;
+
 private:
   FOG_NO_COPY(Task)
 };
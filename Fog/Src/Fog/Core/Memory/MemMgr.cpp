@@ -10,8 +10,11 @@
 
 // [Dependencies]
 #include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Math/Math.h>
 #include <Fog/Core/Memory/MemDebug_p.h>
 #include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Threading/Atomic.h>
 #include <Fog/Core/Threading/Lock.h>
 
 // [Dependencies - C]
@@ -20,6 +23,7 @@
 
 // [Dependencies - POSIX]
 #if defined(FOG_OS_POSIX)
+# include <pthread.h>
 # include <stdlib.h>
 # include <unistd.h>
 #endif // FOG_OS_POSIX
@@ -38,10 +42,18 @@ namespace Fog {
 
 #define FOG_DEBUG_MEMORY 0
 
+// The thread cache needs a compiler supported thread-local variable, because
+// it's accessed by each allocation (ThreadLocal is too slow and it allocates
+// itself by MemMgr).
+#if defined(FOG_OS_POSIX) && (defined(FOG_CC_GNU) || defined(FOG_CC_CLANG))
+# define FOG_MEMMGR_THREAD_CACHE
+#endif
+
 // ===========================================================================
 // [Fog::MemMgr - Alloc / Realloc / Free]
 // ===========================================================================
 
+#if !defined(FOG_MEMMGR_THREAD_CACHE)
 static void* FOG_CDECL Memory_alloc(size_t size)
 {
   void* p = ::malloc(size);
@@ -98,6 +110,647 @@ static void FOG_CDECL Memory_free(void* p)
   ::free(p);
 }
 
+static uint64_t FOG_CDECL MemMgr_getAmountOfCachedMemory(void)
+{
+  return 0;
+}
+#endif // !FOG_MEMMGR_THREAD_CACHE
+
+// ===========================================================================
+// [Fog::MemMgr - Thread Cache]
+// ===========================================================================
+
+#if defined(FOG_MEMMGR_THREAD_CACHE)
+
+// Small blocks are sorted into size classes and each thread keeps a list of
+// free blocks of each class, so the most of allocations and deallocations
+// don't need to synchronize with other threads. If the thread has too many
+// free blocks of one class, a batch of them is moved to the central cache,
+// where the other threads take it from.
+//
+// Each block (small or large) is prefixed by MemMgrHeader which contains its
+// size class, so MemMgr::free() doesn't need the size. Memory returned by
+// MemMgr can't be freed by ::free() (this was never allowed, see MemDebug).
+
+enum
+{
+  //! @brief Size of @c MemMgrHeader (keeps the alignment of ::malloc()).
+  MEMMGR_HEADER_SIZE = 16,
+
+  //! @brief Largest block size which is cached.
+  MEMMGR_CACHE_LIMIT = 1024,
+
+  //! @brief Count of size classes (the class zero is used by large blocks).
+  MEMMGR_CLASS_COUNT = 33,
+
+  //! @brief Maximum count of batches of one class in the central cache.
+  MEMMGR_CENTRAL_BATCHES = 64
+};
+
+//! @internal
+//!
+//! @brief Header which precedes each block allocated by MemMgr.
+struct FOG_NO_EXPORT MemMgrHeader
+{
+  //! @brief Size class of the block, zero if it's not cached.
+  uint32_t sizeClass;
+  //! @brief Count of blocks in the batch (only valid in the first block of a
+  //! batch stored in the central cache).
+  uint32_t batchLength;
+  //! @brief Reserved (padding to @c MEMMGR_HEADER_SIZE).
+  uint32_t reserved[2];
+};
+
+//! @internal
+//!
+//! @brief Free block (stored in the block payload).
+struct FOG_NO_EXPORT MemMgrLink
+{
+  //! @brief Next free block.
+  MemMgrLink* next;
+  //! @brief Next batch (central cache only).
+  MemMgrLink* nextBatch;
+};
+
+//! @internal
+//!
+//! @brief Free blocks of one size class owned by a thread.
+struct FOG_NO_EXPORT MemMgrBin
+{
+  MemMgrLink* first;
+  uint32_t length;
+};
+
+//! @internal
+//!
+//! @brief Thread cache.
+struct FOG_NO_EXPORT MemMgrThreadCache
+{
+  MemMgrBin bins[MEMMGR_CLASS_COUNT];
+
+  //! @brief Size of all free blocks in the cache (in bytes).
+  size_t cachedSize;
+
+  //! @brief Previous thread cache (linked for statistics).
+  MemMgrThreadCache* prev;
+  //! @brief Next thread cache (linked for statistics).
+  MemMgrThreadCache* next;
+};
+
+//! @internal
+//!
+//! @brief Batches of free blocks of one size class shared by all threads.
+struct FOG_NO_EXPORT MemMgrCentralBin
+{
+  Lock lock;
+
+  //! @brief First batch, batches are linked by @c MemMgrLink::nextBatch.
+  MemMgrLink* batches;
+  //! @brief Count of batches.
+  size_t length;
+  //! @brief Size of all free blocks in the bin (in bytes).
+  size_t cachedSize;
+};
+
+//! @internal
+//!
+//! @brief Thread cache of a thread which is being destroyed, the blocks are
+//! freed directly by ::free().
+#define MEMMGR_THREAD_CACHE_DISABLED ((MemMgrThreadCache*)(size_t)1)
+
+static __thread MemMgrThreadCache* MemMgr_threadCache;
+static pthread_key_t MemMgr_threadKey;
+
+static Static<Lock> MemMgr_threadLock;
+static MemMgrThreadCache* MemMgr_threadFirst;
+
+static MemMgrCentralBin* MemMgr_central;
+
+//! @brief Whether the central cache can be used, it's zero if the central
+//! cache couldn't be allocated and after @c MemMgr_fini() started. Threads
+//! not created by Fog can still have a thread cache at that time, their
+//! blocks are then freed directly by ::free().
+//!
+//! The flag is checked without a lock, so the central cache, its locks and
+//! @c MemMgr_threadLock are never destroyed, another thread can still use
+//! them after it read the flag.
+static uint32_t MemMgr_cacheEnabled;
+
+//! @brief Size class indexed by (size + 15) / 16.
+static uint8_t MemMgr_sizeToClass[MEMMGR_CACHE_LIMIT / 16 + 1];
+//! @brief Block size of each class.
+static uint32_t MemMgr_classSize[MEMMGR_CLASS_COUNT];
+//! @brief Count of blocks moved between the thread and central cache at once.
+static uint32_t MemMgr_classBatch[MEMMGR_CLASS_COUNT];
+
+static FOG_INLINE MemMgrHeader* MemMgr_getHeader(void* p)
+{
+  return reinterpret_cast<MemMgrHeader*>(reinterpret_cast<uint8_t*>(p) - MEMMGR_HEADER_SIZE);
+}
+
+static FOG_INLINE void* MemMgr_getBlock(MemMgrHeader* header)
+{
+  return reinterpret_cast<uint8_t*>(header) + MEMMGR_HEADER_SIZE;
+}
+
+// Free a list of blocks linked by MemMgrLink::next.
+static void MemMgr_freeList(MemMgrLink* link)
+{
+  while (link)
+  {
+    MemMgrLink* next = link->next;
+    ::free(MemMgr_getHeader(link));
+    link = next;
+  }
+}
+
+// Move a list of blocks to the central cache as a single batch.
+static void MemMgr_pushBatch(uint32_t sizeClass, MemMgrLink* first, uint32_t length)
+{
+  if (FOG_UNLIKELY(!AtomicCore<uint32_t>::get(&MemMgr_cacheEnabled)))
+  {
+    MemMgr_freeList(first);
+    return;
+  }
+
+  MemMgrCentralBin& central = MemMgr_central[sizeClass];
+  size_t size = (size_t)length * MemMgr_classSize[sizeClass];
+
+  {
+    AutoLock locked(central.lock);
+
+    if (central.length < MEMMGR_CENTRAL_BATCHES)
+    {
+      MemMgr_getHeader(first)->batchLength = length;
+      first->nextBatch = central.batches;
+
+      central.batches = first;
+      central.length++;
+      central.cachedSize += size;
+      return;
+    }
+  }
+
+  MemMgr_freeList(first);
+}
+
+static FOG_NO_INLINE void MemMgr_fillBin(MemMgrThreadCache* cache, uint32_t sizeClass)
+{
+  if (FOG_UNLIKELY(!AtomicCore<uint32_t>::get(&MemMgr_cacheEnabled)))
+    return;
+
+  MemMgrCentralBin& central = MemMgr_central[sizeClass];
+  MemMgrLink* first;
+  uint32_t length;
+
+  {
+    AutoLock locked(central.lock);
+
+    first = central.batches;
+    if (first == NULL)
+      return;
+
+    length = MemMgr_getHeader(first)->batchLength;
+
+    central.batches = first->nextBatch;
+    central.length--;
+    central.cachedSize -= (size_t)length * MemMgr_classSize[sizeClass];
+  }
+
+  MemMgrBin& bin = cache->bins[sizeClass];
+  bin.first = first;
+  bin.length = length;
+
+  cache->cachedSize += (size_t)length * MemMgr_classSize[sizeClass];
+}
+
+static FOG_NO_INLINE void MemMgr_flushBin(MemMgrThreadCache* cache, uint32_t sizeClass)
+{
+  MemMgrBin& bin = cache->bins[sizeClass];
+  uint32_t length = MemMgr_classBatch[sizeClass];
+
+  // Detach the first batch from the bin.
+  MemMgrLink* first = bin.first;
+  MemMgrLink* last = first;
+
+  for (uint32_t i = 1; i < length; i++)
+    last = last->next;
+
+  bin.first = last->next;
+  bin.length -= length;
+  cache->cachedSize -= (size_t)length * MemMgr_classSize[sizeClass];
+
+  last->next = NULL;
+  MemMgr_pushBatch(sizeClass, first, length);
+}
+
+// Move all blocks from the thread cache to the central cache.
+static void MemMgr_flushThreadCache(MemMgrThreadCache* cache)
+{
+  for (uint32_t sizeClass = 1; sizeClass < MEMMGR_CLASS_COUNT; sizeClass++)
+  {
+    MemMgrBin& bin = cache->bins[sizeClass];
+
+    if (bin.first != NULL)
+      MemMgr_pushBatch(sizeClass, bin.first, bin.length);
+
+    bin.first = NULL;
+    bin.length = 0;
+  }
+
+  cache->cachedSize = 0;
+}
+
+static void MemMgr_destroyThreadCache(void* p)
+{
+  MemMgrThreadCache* cache = reinterpret_cast<MemMgrThreadCache*>(p);
+
+  // Memory freed by the other thread-local destructors is not cached anymore.
+  MemMgr_threadCache = MEMMGR_THREAD_CACHE_DISABLED;
+  MemMgr_flushThreadCache(cache);
+
+  {
+    AutoLock locked(MemMgr_threadLock);
+
+    if (cache->prev)
+      cache->prev->next = cache->next;
+    else
+      MemMgr_threadFirst = cache->next;
+
+    if (cache->next)
+      cache->next->prev = cache->prev;
+  }
+
+  ::free(cache);
+}
+
+static FOG_NO_INLINE MemMgrThreadCache* MemMgr_createThreadCache()
+{
+  if (!AtomicCore<uint32_t>::get(&MemMgr_cacheEnabled))
+  {
+    MemMgr_threadCache = MEMMGR_THREAD_CACHE_DISABLED;
+    return NULL;
+  }
+
+  MemMgrThreadCache* cache = reinterpret_cast<MemMgrThreadCache*>(
+    ::calloc(1, sizeof(MemMgrThreadCache)));
+
+  // Try it again next time.
+  if (FOG_IS_NULL(cache))
+    return NULL;
+
+  // The destructor is called when the thread exits.
+  if (::pthread_setspecific(MemMgr_threadKey, cache) != 0)
+  {
+    ::free(cache);
+    return NULL;
+  }
+
+  {
+    AutoLock locked(MemMgr_threadLock);
+
+    cache->next = MemMgr_threadFirst;
+    if (MemMgr_threadFirst)
+      MemMgr_threadFirst->prev = cache;
+    MemMgr_threadFirst = cache;
+  }
+
+  MemMgr_threadCache = cache;
+  return cache;
+}
+
+static FOG_INLINE MemMgrThreadCache* MemMgr_getThreadCache()
+{
+  MemMgrThreadCache* cache = MemMgr_threadCache;
+
+  if (FOG_UNLIKELY(cache == NULL))
+    return MemMgr_createThreadCache();
+
+  if (FOG_UNLIKELY(cache == MEMMGR_THREAD_CACHE_DISABLED))
+    return NULL;
+
+  return cache;
+}
+
+static FOG_INLINE uint32_t MemMgr_getSizeClass(size_t size)
+{
+  return MemMgr_sizeToClass[(size + 15) / 16];
+}
+
+// ===========================================================================
+// [Fog::MemMgr - Alloc / Realloc / Free]
+// ===========================================================================
+
+static void* MemMgr_allocLarge(size_t size, bool zero)
+{
+  if (FOG_UNLIKELY(size > SIZE_MAX - MEMMGR_HEADER_SIZE))
+    return NULL;
+
+  size_t allocSize = MEMMGR_HEADER_SIZE + size;
+  void* p = zero ? ::calloc(allocSize, 1) : ::malloc(allocSize);
+
+  if (FOG_IS_NULL(p))
+  {
+    MemMgr::cleanup(MEMORY_CLEANUP_REASON_NO_MEMORY);
+    p = zero ? ::calloc(allocSize, 1) : ::malloc(allocSize);
+
+    if (FOG_IS_NULL(p))
+      return NULL;
+  }
+
+  MemMgrHeader* header = reinterpret_cast<MemMgrHeader*>(p);
+  header->sizeClass = 0;
+
+  return MemMgr_getBlock(header);
+}
+
+static void* FOG_CDECL Memory_alloc(size_t size)
+{
+  if (size > MEMMGR_CACHE_LIMIT)
+    return MemMgr_allocLarge(size, false);
+
+  uint32_t sizeClass = MemMgr_getSizeClass(size);
+  MemMgrThreadCache* cache = MemMgr_getThreadCache();
+
+  if (FOG_LIKELY(cache != NULL))
+  {
+    MemMgrBin& bin = cache->bins[sizeClass];
+
+    if (bin.first == NULL)
+      MemMgr_fillBin(cache, sizeClass);
+
+    MemMgrLink* link = bin.first;
+    if (link != NULL)
+    {
+      bin.first = link->next;
+      bin.length--;
+      cache->cachedSize -= MemMgr_classSize[sizeClass];
+
+      return link;
+    }
+  }
+
+  size_t allocSize = MEMMGR_HEADER_SIZE + MemMgr_classSize[sizeClass];
+  void* p = ::malloc(allocSize);
+
+  if (FOG_IS_NULL(p))
+  {
+    MemMgr::cleanup(MEMORY_CLEANUP_REASON_NO_MEMORY);
+    p = ::malloc(allocSize);
+
+    if (FOG_IS_NULL(p))
+      return NULL;
+  }
+
+  MemMgrHeader* header = reinterpret_cast<MemMgrHeader*>(p);
+  header->sizeClass = sizeClass;
+
+  return MemMgr_getBlock(header);
+}
+
+static void* FOG_CDECL Memory_calloc(size_t size)
+{
+  if (size > MEMMGR_CACHE_LIMIT)
+    return MemMgr_allocLarge(size, true);
+
+  void* p = Memory_alloc(size);
+
+  if (FOG_IS_NULL(p))
+    return NULL;
+
+  MemOps::zero(p, size);
+  return p;
+}
+
+static void FOG_CDECL Memory_free(void* p)
+{
+  if (FOG_IS_NULL(p))
+    return;
+
+  MemMgrHeader* header = MemMgr_getHeader(p);
+  uint32_t sizeClass = header->sizeClass;
+
+  if (sizeClass == 0)
+  {
+    ::free(header);
+    return;
+  }
+
+  MemMgrThreadCache* cache = MemMgr_getThreadCache();
+  if (FOG_UNLIKELY(cache == NULL))
+  {
+    ::free(header);
+    return;
+  }
+
+  MemMgrBin& bin = cache->bins[sizeClass];
+  MemMgrLink* link = reinterpret_cast<MemMgrLink*>(p);
+
+  link->next = bin.first;
+  bin.first = link;
+  bin.length++;
+  cache->cachedSize += MemMgr_classSize[sizeClass];
+
+  if (bin.length > MemMgr_classBatch[sizeClass] * 2)
+    MemMgr_flushBin(cache, sizeClass);
+}
+
+static void* FOG_CDECL Memory_realloc(void* p, size_t size)
+{
+  if (FOG_IS_NULL(p))
+  {
+    return fog_api.memmgr_alloc(size);
+  }
+
+  if (FOG_UNLIKELY(size == 0))
+  {
+    fog_api.memmgr_free(p);
+    return NULL;
+  }
+
+  MemMgrHeader* header = MemMgr_getHeader(p);
+  uint32_t sizeClass = header->sizeClass;
+
+  if (sizeClass == 0)
+  {
+    if (FOG_UNLIKELY(size > SIZE_MAX - MEMMGR_HEADER_SIZE))
+      return NULL;
+
+    void* newp = ::realloc(header, MEMMGR_HEADER_SIZE + size);
+    if (FOG_IS_NULL(newp))
+    {
+      MemMgr::cleanup(MEMORY_CLEANUP_REASON_NO_MEMORY);
+      newp = ::realloc(header, MEMMGR_HEADER_SIZE + size);
+
+      if (FOG_IS_NULL(newp))
+        return NULL;
+    }
+
+    return MemMgr_getBlock(reinterpret_cast<MemMgrHeader*>(newp));
+  }
+
+  // Keep the block if it's large enough and it doesn't waste more than half
+  // of its size.
+  size_t oldSize = MemMgr_classSize[sizeClass];
+  if (size <= oldSize && size > oldSize / 2)
+    return p;
+
+  void* newp = Memory_alloc(size);
+  if (FOG_IS_NULL(newp))
+    return NULL;
+
+  MemOps::copy(newp, p, Math::min(oldSize, size));
+  Memory_free(p);
+
+  return newp;
+}
+
+// ===========================================================================
+// [Fog::MemMgr - Thread Cache - Statistics / Cleanup]
+// ===========================================================================
+
+static uint64_t FOG_CDECL MemMgr_getAmountOfCachedMemory(void)
+{
+  uint64_t result = 0;
+  uint32_t sizeClass;
+
+  if (MemMgr_central == NULL)
+    return result;
+
+  for (sizeClass = 1; sizeClass < MEMMGR_CLASS_COUNT; sizeClass++)
+  {
+    MemMgrCentralBin& central = MemMgr_central[sizeClass];
+
+    AutoLock locked(central.lock);
+    result += central.cachedSize;
+  }
+
+  // The size of a thread cache changes without synchronization, the result
+  // is only approximate.
+  {
+    AutoLock locked(MemMgr_threadLock);
+
+    for (MemMgrThreadCache* cache = MemMgr_threadFirst; cache != NULL; cache = cache->next)
+      result += cache->cachedSize;
+  }
+
+  return result;
+}
+
+// Free all blocks in the central cache and in the cache of the current thread.
+static void MemMgr_releaseCachedMemory()
+{
+  if (MemMgr_central == NULL)
+    return;
+
+  MemMgrThreadCache* cache = MemMgr_threadCache;
+  if (cache != NULL && cache != MEMMGR_THREAD_CACHE_DISABLED)
+    MemMgr_flushThreadCache(cache);
+
+  for (uint32_t sizeClass = 1; sizeClass < MEMMGR_CLASS_COUNT; sizeClass++)
+  {
+    MemMgrCentralBin& central = MemMgr_central[sizeClass];
+    MemMgrLink* batch;
+
+    {
+      AutoLock locked(central.lock);
+
+      batch = central.batches;
+      central.batches = NULL;
+      central.length = 0;
+      central.cachedSize = 0;
+    }
+
+    while (batch)
+    {
+      MemMgrLink* nextBatch = batch->nextBatch;
+      MemMgr_freeList(batch);
+      batch = nextBatch;
+    }
+  }
+}
+
+static void MemMgr_initThreadCache()
+{
+  uint32_t sizeClass = 0;
+
+  MemMgr_classSize[0] = 0;
+  MemMgr_classBatch[0] = 0;
+
+  // Classes are 16 bytes apart up to 256 bytes, 32 bytes apart up to 512
+  // bytes, and 64 bytes apart up to MEMMGR_CACHE_LIMIT.
+  for (size_t i = 0; i < FOG_ARRAY_SIZE(MemMgr_sizeToClass); i++)
+  {
+    size_t size = Math::max<size_t>(i * 16, 16);
+    size_t granularity = (size <= 256) ? 16 : (size <= 512) ? 32 : 64;
+
+    size = (size + granularity - 1) & ~(granularity - 1);
+
+    if (size != MemMgr_classSize[sizeClass])
+    {
+      sizeClass++;
+      FOG_ASSERT(sizeClass < MEMMGR_CLASS_COUNT);
+
+      MemMgr_classSize[sizeClass] = (uint32_t)size;
+      MemMgr_classBatch[sizeClass] = Math::bound<uint32_t>((uint32_t)(4096 / size), 4, 32);
+    }
+
+    MemMgr_sizeToClass[i] = (uint8_t)sizeClass;
+  }
+
+  MemMgr_threadLock.init();
+  MemMgr_threadFirst = NULL;
+
+  MemMgr_central = reinterpret_cast<MemMgrCentralBin*>(
+    ::calloc(MEMMGR_CLASS_COUNT, sizeof(MemMgrCentralBin)));
+
+  // Without the central cache (or the thread-specific key, which destroys
+  // the thread caches) all blocks are allocated and freed by the C runtime.
+  if (FOG_IS_NULL(MemMgr_central))
+    return;
+
+  if (::pthread_key_create(&MemMgr_threadKey, MemMgr_destroyThreadCache) != 0)
+  {
+    ::free(MemMgr_central);
+    MemMgr_central = NULL;
+    return;
+  }
+
+  for (sizeClass = 0; sizeClass < MEMMGR_CLASS_COUNT; sizeClass++)
+    fog_new_p(&MemMgr_central[sizeClass].lock) Lock();
+
+  AtomicCore<uint32_t>::set(&MemMgr_cacheEnabled, 1);
+}
+
+static void MemMgr_finiThreadCache()
+{
+  MemMgrThreadCache* cache = MemMgr_threadCache;
+
+  // Blocks freed after the library was shut down go directly to ::free().
+  MemMgr_threadCache = MEMMGR_THREAD_CACHE_DISABLED;
+
+  if (MemMgr_central == NULL)
+    return;
+
+  // Thread caches of the other threads are not destroyed, but they stop
+  // using the central cache. The central cache, the locks and the key stay
+  // valid for the life of the process, only the cached blocks are freed. A
+  // batch pushed by a thread which read the flag before it was cleared stays
+  // in the central cache.
+  AtomicCore<uint32_t>::set(&MemMgr_cacheEnabled, 0);
+
+  if (cache != NULL && cache != MEMMGR_THREAD_CACHE_DISABLED)
+  {
+    // Don't call the destructor again when this thread exits.
+    ::pthread_setspecific(MemMgr_threadKey, NULL);
+    MemMgr_destroyThreadCache(cache);
+  }
+
+  MemMgr_releaseCachedMemory();
+}
+
+#endif // FOG_MEMMGR_THREAD_CACHE
+
 // ============================================================================
 // [Fog::MemMgr - Cleanup]
 // ============================================================================
@@ -159,6 +812,10 @@ static Static<MemMgrGlobal> MemMgr_global;
 
 static void FOG_CDECL MemMgr_cleanup(uint32_t reason)
 {
+#if defined(FOG_MEMMGR_THREAD_CACHE)
+  MemMgr_releaseCachedMemory();
+#endif // FOG_MEMMGR_THREAD_CACHE
+
   // Synchronized section.
   { AutoLock locked(MemMgr_global->lock);
 
@@ -392,6 +1049,11 @@ FOG_NO_EXPORT void MemMgr_init(void)
 
   fog_api.memmgr_getAmountOfPhysicalMemory = MemMgr_getAmountOfPhysicalMemory;
   fog_api.memmgr_getAmountOfPhysicalMemoryMB = MemMgr_getAmountOfPhysicalMemoryMB;
+  fog_api.memmgr_getAmountOfCachedMemory = MemMgr_getAmountOfCachedMemory;
+
+#if defined(FOG_MEMMGR_THREAD_CACHE)
+  MemMgr_initThreadCache();
+#endif // FOG_MEMMGR_THREAD_CACHE
 
   if (FOG_DEBUG_MEMORY)
     MemDebug_init();
@@ -405,6 +1067,10 @@ FOG_NO_EXPORT void MemMgr_fini(void)
 
   if (FOG_DEBUG_MEMORY)
     MemDebug_fini();
+
+#if defined(FOG_MEMMGR_THREAD_CACHE)
+  MemMgr_finiThreadCache();
+#endif // FOG_MEMMGR_THREAD_CACHE
 }
 
 } // Fog namespace
@@ -73,6 +73,19 @@ struct FOG_NO_EXPORT MemMgr
   {
     return fog_api.memmgr_getAmountOfPhysicalMemoryMB();
   }
+
+  // ============================================================================
+  // [Fog::MemMgr - Cached Memory]
+  // ============================================================================
+
+  //! @brief Get amount of free memory kept by the thread and central caches
+  //! (approximate, in bytes).
+  //!
+  //! The cached memory is released by @c cleanup().
+  static FOG_INLINE uint64_t getAmountOfCachedMemory()
+  {
+    return fog_api.memmgr_getAmountOfCachedMemory();
+  }
 };
 
 //! @}
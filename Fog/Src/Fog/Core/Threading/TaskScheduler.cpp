@@ -0,0 +1,879 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Kernel/EventLoop.h>
+#include <Fog/Core/Kernel/Task.h>
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Threading/AtomicPadding.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Threading/TaskScheduler.h>
+#include <Fog/Core/Threading/Thread.h>
+#include <Fog/Core/Threading/ThreadEvent.h>
+#include <Fog/Core/Threading/ThreadPool.h>
+#include <Fog/Core/Tools/Cpu.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::TaskScheduler - Global]
+// ============================================================================
+
+static Static<TaskScheduler> TaskScheduler_oInstance;
+
+enum
+{
+  //! @brief Initial capacity of the worker's deque (must be power of 2).
+  TASK_SCHEDULER_DEQUE_CAPACITY = 64,
+
+  //! @brief How many times an idle worker looks for a job (yielding between
+  //! the attempts) before it goes to sleep.
+  TASK_SCHEDULER_SPIN_COUNT = 16
+};
+
+// ============================================================================
+// [Fog::TaskSchedulerJob]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Job queued by @c TaskScheduler.
+struct FOG_NO_EXPORT TaskSchedulerJob
+{
+  //! @brief Next job in the injection queue or in the worker's inbox.
+  TaskSchedulerJob* next;
+  //! @brief Group of the job.
+  TaskGroup* group;
+
+  //! @brief Function of a spawned job, @c NULL if this is a range job.
+  TaskSchedulerFunc func;
+  //! @brief Function of a range job (@c parallelFor()).
+  TaskSchedulerRangeFunc rangeFunc;
+  //! @brief Closure passed to @c func or @c rangeFunc.
+  void* closure;
+
+  //! @brief Range [start, end) and grain of the range job.
+  size_t start;
+  size_t end;
+  size_t grain;
+};
+
+// ============================================================================
+// [Fog::TaskSchedulerWorker]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Circular array of the Chase-Lev deque.
+//!
+//! When the array is grown, the old one is kept (linked by @c prev) until the
+//! worker is destroyed, because a thief can still read from it.
+struct FOG_NO_EXPORT TaskSchedulerDequeArray
+{
+  TaskSchedulerDequeArray* prev;
+  ssize_t mask;
+  TaskSchedulerJob* data[1];
+};
+
+//! @internal
+//!
+//! @brief Worker of @c TaskScheduler.
+struct FOG_NO_EXPORT TaskSchedulerWorker
+{
+  FOG_INLINE TaskSchedulerWorker() :
+    exited(true, false)
+  {
+  }
+
+  //! @brief Top of the deque, modified by thieves.
+  Atomic<ssize_t> top;
+  AtomicPadding1<ssize_t> _padding0;
+
+  //! @brief Bottom of the deque, modified only by the owner.
+  Atomic<ssize_t> bottom;
+  //! @brief Current deque array.
+  Atomic<TaskSchedulerDequeArray*> array;
+  AtomicPadding2<ssize_t, void*> _padding1;
+
+  //! @brief Lock which protects the inbox.
+  Lock inboxLock;
+  //! @brief Jobs spawned with affinity to this worker (FIFO).
+  TaskSchedulerJob* inboxFirst;
+  TaskSchedulerJob* inboxLast;
+  //! @brief Count of jobs in the inbox.
+  Atomic<size_t> inboxCount;
+
+  //! @brief Thread (from @c ThreadPool) which runs the worker.
+  Thread* thread;
+  //! @brief Signaled when the worker leaves its main loop.
+  ThreadEvent exited;
+
+  //! @brief Index of the worker.
+  int id;
+  //! @brief Seed used to choose the first victim to steal from.
+  uint32_t seed;
+};
+
+// ============================================================================
+// [Fog::TaskScheduler - Queue]
+// ============================================================================
+
+static FOG_INLINE void TaskScheduler_queueAppend(
+  TaskSchedulerJob** first, TaskSchedulerJob** last, TaskSchedulerJob* job)
+{
+  job->next = NULL;
+
+  if (*last)
+    (*last)->next = job;
+  else
+    *first = job;
+
+  *last = job;
+}
+
+static FOG_INLINE TaskSchedulerJob* TaskScheduler_queueTake(
+  TaskSchedulerJob** first, TaskSchedulerJob** last)
+{
+  TaskSchedulerJob* job = *first;
+
+  if (job != NULL)
+  {
+    *first = job->next;
+    if (*first == NULL)
+      *last = NULL;
+  }
+
+  return job;
+}
+
+static void TaskScheduler_queueFree(TaskSchedulerJob* job)
+{
+  while (job)
+  {
+    TaskSchedulerJob* next = job->next;
+    MemMgr::free(job);
+    job = next;
+  }
+}
+
+// ============================================================================
+// [Fog::TaskScheduler - Deque]
+// ============================================================================
+
+static TaskSchedulerDequeArray* TaskScheduler_dequeAlloc(ssize_t capacity)
+{
+  TaskSchedulerDequeArray* a = reinterpret_cast<TaskSchedulerDequeArray*>(
+    MemMgr::alloc(sizeof(TaskSchedulerDequeArray) + (size_t)(capacity - 1) * sizeof(TaskSchedulerJob*)));
+
+  if (FOG_IS_NULL(a))
+    return NULL;
+
+  a->prev = NULL;
+  a->mask = capacity - 1;
+  return a;
+}
+
+// Called only by the owner of the deque.
+static bool TaskScheduler_dequePush(TaskSchedulerWorker* w, TaskSchedulerJob* job)
+{
+  ssize_t b = w->bottom.get();
+  ssize_t t = w->top.get();
+  TaskSchedulerDequeArray* a = w->array.get();
+
+  if (b - t > a->mask)
+  {
+    TaskSchedulerDequeArray* grown = TaskScheduler_dequeAlloc((a->mask + 1) * 2);
+    if (FOG_IS_NULL(grown))
+      return false;
+
+    for (ssize_t i = t; i < b; i++)
+      grown->data[i & grown->mask] = a->data[i & a->mask];
+
+    grown->prev = a;
+    w->array.setXchg(grown);
+    a = grown;
+  }
+
+  a->data[b & a->mask] = job;
+
+  // Full barrier, the job must be visible before the bottom is incremented.
+  w->bottom.setXchg(b + 1);
+  return true;
+}
+
+// Called only by the owner of the deque.
+static TaskSchedulerJob* TaskScheduler_dequePop(TaskSchedulerWorker* w)
+{
+  ssize_t b = w->bottom.get() - 1;
+  TaskSchedulerDequeArray* a = w->array.get();
+
+  // Full barrier, the bottom must be stored before the top is loaded.
+  w->bottom.setXchg(b);
+  ssize_t t = w->top.get();
+
+  if (t > b)
+  {
+    // Empty.
+    w->bottom.setXchg(b + 1);
+    return NULL;
+  }
+
+  TaskSchedulerJob* job = a->data[b & a->mask];
+
+  if (t == b)
+  {
+    // The last job, race with thieves.
+    if (!w->top.cmpXchg(t, t + 1))
+      job = NULL;
+    w->bottom.setXchg(b + 1);
+  }
+
+  return job;
+}
+
+// Called by any thread except the owner of the deque.
+static TaskSchedulerJob* TaskScheduler_dequeSteal(TaskSchedulerWorker* w)
+{
+  ssize_t t = w->top.get();
+  ssize_t b = w->bottom.get();
+
+  if (t >= b)
+    return NULL;
+
+  TaskSchedulerDequeArray* a = w->array.get();
+  TaskSchedulerJob* job = a->data[t & a->mask];
+
+  // Lost the race with the owner or with other thief.
+  if (!w->top.cmpXchg(t, t + 1))
+    return NULL;
+
+  return job;
+}
+
+static FOG_INLINE bool TaskScheduler_dequeIsEmpty(const TaskSchedulerWorker* w)
+{
+  return w->bottom.get() - w->top.get() <= 0;
+}
+
+// ============================================================================
+// [Fog::TaskScheduler - Worker]
+// ============================================================================
+
+static TaskSchedulerWorker* TaskScheduler_createWorker(int id)
+{
+  TaskSchedulerWorker* w = fog_new TaskSchedulerWorker();
+  if (FOG_IS_NULL(w))
+    return NULL;
+
+  TaskSchedulerDequeArray* a = TaskScheduler_dequeAlloc(TASK_SCHEDULER_DEQUE_CAPACITY);
+  if (FOG_IS_NULL(a))
+  {
+    fog_delete(w);
+    return NULL;
+  }
+
+  w->top.init(0);
+  w->bottom.init(0);
+  w->array.init(a);
+
+  w->inboxFirst = NULL;
+  w->inboxLast = NULL;
+  w->inboxCount.init(0);
+
+  w->thread = NULL;
+  w->id = id;
+  w->seed = (uint32_t)id * 0x9E3779B9U + 1;
+
+  return w;
+}
+
+static void TaskScheduler_destroyWorker(TaskSchedulerWorker* w)
+{
+  TaskSchedulerDequeArray* a = w->array.get();
+
+  // Jobs which were never run (the scheduler is being destroyed).
+  for (ssize_t i = w->top.get(); i < w->bottom.get(); i++)
+    MemMgr::free(a->data[i & a->mask]);
+  TaskScheduler_queueFree(w->inboxFirst);
+
+  while (a)
+  {
+    TaskSchedulerDequeArray* prev = a->prev;
+    MemMgr::free(a);
+    a = prev;
+  }
+
+  fog_delete(w);
+}
+
+static FOG_INLINE TaskSchedulerWorker* TaskScheduler_getCurrent(const TaskScheduler* self)
+{
+  return reinterpret_cast<TaskSchedulerWorker*>(self->_current.get());
+}
+
+// ============================================================================
+// [Fog::TaskScheduler - Wake / Sleep]
+// ============================================================================
+
+static bool TaskScheduler_hasWork(const TaskScheduler* self)
+{
+  if (self->_injectCount.get() != 0)
+    return true;
+
+  int n = self->_numWorkers.get();
+  for (int i = 0; i < n; i++)
+  {
+    const TaskSchedulerWorker* w = self->_workers[i];
+    if (!TaskScheduler_dequeIsEmpty(w) || w->inboxCount.get() != 0)
+      return true;
+  }
+
+  return false;
+}
+
+// The job (or the group completion) must be published by a locked (full
+// barrier) operation before calling wake, the sleeper increments _sleeping
+// before it checks the work under the lock, so the wakeup can't be lost.
+static void TaskScheduler_wake(TaskScheduler* self, bool all)
+{
+  if (self->_sleeping.get() == 0)
+    return;
+
+  AutoLock locked(self->_lock);
+  if (all)
+    self->_condition->broadcast();
+  else
+    self->_condition->signal();
+}
+
+static void TaskScheduler_sleep(TaskScheduler* self, TaskGroup* group)
+{
+  self->_sleeping.inc();
+
+  { AutoLock locked(self->_lock);
+
+    for (;;)
+    {
+      if (self->_stopping.get() || TaskScheduler_hasWork(self))
+        break;
+
+      if (group != NULL && group->isDone())
+      {
+        // We could consume a signal which was meant to wake a thread which
+        // would run a new job, pass it to another sleeper.
+        if (TaskScheduler_hasWork(self))
+          self->_condition->signal();
+        break;
+      }
+
+      self->_condition->wait();
+    }
+  }
+
+  self->_sleeping.dec();
+}
+
+// ============================================================================
+// [Fog::TaskScheduler - Push / Find]
+// ============================================================================
+
+static void TaskScheduler_push(TaskScheduler* self, TaskSchedulerWorker* current, TaskSchedulerJob* job, int affinity)
+{
+  int n = self->_numWorkers.get();
+
+  if (affinity >= 0 && n > 0)
+  {
+    TaskSchedulerWorker* w = self->_workers[affinity % n];
+
+    { AutoLock locked(w->inboxLock);
+      TaskScheduler_queueAppend(&w->inboxFirst, &w->inboxLast, job);
+      w->inboxCount.inc();
+    }
+
+    // We don't know which sleeper is the preferred worker.
+    TaskScheduler_wake(self, true);
+    return;
+  }
+
+  if (current != NULL && TaskScheduler_dequePush(current, job))
+  {
+    TaskScheduler_wake(self, false);
+    return;
+  }
+
+  { AutoLock locked(self->_lock);
+    TaskScheduler_queueAppend(&self->_injectFirst, &self->_injectLast, job);
+    self->_injectCount.inc();
+  }
+
+  TaskScheduler_wake(self, false);
+}
+
+static TaskSchedulerJob* TaskScheduler_takeInbox(TaskSchedulerWorker* w)
+{
+  if (w->inboxCount.get() == 0)
+    return NULL;
+
+  AutoLock locked(w->inboxLock);
+  TaskSchedulerJob* job = TaskScheduler_queueTake(&w->inboxFirst, &w->inboxLast);
+
+  if (job != NULL)
+    w->inboxCount.dec();
+  return job;
+}
+
+static TaskSchedulerJob* TaskScheduler_findJob(TaskScheduler* self, TaskSchedulerWorker* current)
+{
+  TaskSchedulerJob* job;
+
+  // Own deque (LIFO, the most recently split range is likely in cache), then
+  // the jobs spawned with affinity to this worker.
+  if (current != NULL)
+  {
+    if ((job = TaskScheduler_dequePop(current)) != NULL)
+      return job;
+
+    if ((job = TaskScheduler_takeInbox(current)) != NULL)
+      return job;
+  }
+
+  // Jobs spawned by non-worker threads.
+  if (self->_injectCount.get() != 0)
+  {
+    AutoLock locked(self->_lock);
+    job = TaskScheduler_queueTake(&self->_injectFirst, &self->_injectLast);
+
+    if (job != NULL)
+    {
+      self->_injectCount.dec();
+      return job;
+    }
+  }
+
+  // Steal from other workers, starting with a random victim.
+  int n = self->_numWorkers.get();
+  if (n == 0)
+    return NULL;
+
+  uint32_t start = 0;
+  if (current != NULL)
+  {
+    uint32_t seed = current->seed;
+
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    current->seed = seed;
+    start = seed % (uint32_t)n;
+  }
+
+  int i;
+  for (i = 0; i < n; i++)
+  {
+    TaskSchedulerWorker* w = self->_workers[(start + (uint32_t)i) % (uint32_t)n];
+    if (w == current)
+      continue;
+
+    if ((job = TaskScheduler_dequeSteal(w)) != NULL)
+      return job;
+  }
+
+  // Affinity is only a hint, take the job if the preferred worker is busy.
+  for (i = 0; i < n; i++)
+  {
+    TaskSchedulerWorker* w = self->_workers[i];
+    if (w == current)
+      continue;
+
+    if ((job = TaskScheduler_takeInbox(w)) != NULL)
+      return job;
+  }
+
+  return NULL;
+}
+
+// ============================================================================
+// [Fog::TaskScheduler - Run]
+// ============================================================================
+
+static void TaskScheduler_runChunks(TaskSchedulerRangeFunc func, void* closure, size_t start, size_t end, size_t grain)
+{
+  while (end - start > grain)
+  {
+    func(closure, start, start + grain);
+    start += grain;
+  }
+
+  func(closure, start, end);
+}
+
+static void TaskScheduler_runRange(TaskScheduler* self, TaskSchedulerWorker* current, TaskGroup* group,
+  TaskSchedulerRangeFunc func, void* closure, size_t start, size_t end, size_t grain)
+{
+  // Split the range into halves, the right halves are pushed so they can be
+  // stolen by other workers and the left half is processed by this thread.
+  while (end - start > grain)
+  {
+    size_t mid = start + (end - start) / 2;
+    TaskSchedulerJob* job = reinterpret_cast<TaskSchedulerJob*>(MemMgr::alloc(sizeof(TaskSchedulerJob)));
+
+    if (FOG_IS_NULL(job))
+    {
+      TaskScheduler_runChunks(func, closure, mid, end, grain);
+    }
+    else
+    {
+      job->group = group;
+      job->func = NULL;
+      job->rangeFunc = func;
+      job->closure = closure;
+      job->start = mid;
+      job->end = end;
+      job->grain = grain;
+
+      group->_pending.inc();
+      TaskScheduler_push(self, current, job, -1);
+    }
+
+    end = mid;
+  }
+
+  func(closure, start, end);
+}
+
+static void TaskScheduler_runJob(TaskScheduler* self, TaskSchedulerWorker* current, TaskSchedulerJob* job)
+{
+  TaskGroup* group = job->group;
+
+  if (job->func != NULL)
+  {
+    TaskSchedulerFunc func = job->func;
+    void* closure = job->closure;
+
+    MemMgr::free(job);
+    func(closure);
+  }
+  else
+  {
+    TaskSchedulerRangeFunc func = job->rangeFunc;
+    void* closure = job->closure;
+
+    size_t start = job->start;
+    size_t end = job->end;
+    size_t grain = job->grain;
+
+    MemMgr::free(job);
+    TaskScheduler_runRange(self, current, group, func, closure, start, end, grain);
+  }
+
+  // The group can be destroyed by its waiter once the count reaches zero.
+  if (group->_pending.deref())
+    TaskScheduler_wake(self, true);
+}
+
+// ============================================================================
+// [Fog::TaskScheduler - Workers]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Task which runs the worker's main loop on a @c ThreadPool thread.
+struct FOG_NO_EXPORT TaskSchedulerWorkerTask : public Task
+{
+  FOG_INLINE TaskSchedulerWorkerTask(TaskScheduler* scheduler, TaskSchedulerWorker* worker) :
+    _scheduler(scheduler),
+    _worker(worker)
+  {
+  }
+
+  virtual void run()
+  {
+    TaskScheduler* self = _scheduler;
+    TaskSchedulerWorker* w = _worker;
+
+    self->_current.set(w);
+    uint spin = 0;
+
+    for (;;)
+    {
+      TaskSchedulerJob* job = TaskScheduler_findJob(self, w);
+
+      if (job != NULL)
+      {
+        TaskScheduler_runJob(self, w, job);
+        spin = 0;
+        continue;
+      }
+
+      if (self->_stopping.get())
+        break;
+
+      if (++spin < TASK_SCHEDULER_SPIN_COUNT)
+      {
+        Thread::yield();
+        continue;
+      }
+
+      spin = 0;
+      TaskScheduler_sleep(self, NULL);
+    }
+
+    self->_current.set(NULL);
+    w->exited.signal();
+  }
+
+  TaskScheduler* _scheduler;
+  TaskSchedulerWorker* _worker;
+};
+
+static void TaskScheduler_startWorkers(TaskScheduler* self)
+{
+  if (FOG_LIKELY(self->_numWorkers.get() >= self->_maxWorkers.get()))
+    return;
+
+  AutoLock locked(self->_lock);
+  if (self->_stopping.get())
+    return;
+
+  int n;
+  while ((n = self->_numWorkers.get()) < self->_maxWorkers.get())
+  {
+    TaskSchedulerWorker* w = TaskScheduler_createWorker(n);
+    TaskSchedulerWorkerTask* task = NULL;
+
+    if (w != NULL)
+    {
+      if (ThreadPool::get()->getThread(&w->thread, n) == ERR_OK)
+      {
+        task = fog_new TaskSchedulerWorkerTask(self, w);
+
+        if (task != NULL && w->thread->getEventLoop().postTask(task) != ERR_OK)
+        {
+          fog_delete(task);
+          task = NULL;
+        }
+
+        if (task == NULL)
+          ThreadPool::get()->releaseThread(w->thread, n);
+      }
+
+      if (task == NULL)
+        TaskScheduler_destroyWorker(w);
+    }
+
+    // Out of memory or out of threads, don't try it again on each spawn.
+    if (task == NULL)
+    {
+      self->_maxWorkers.set(n);
+      break;
+    }
+
+    self->_workers[n] = w;
+    self->_numWorkers.setXchg(n + 1);
+  }
+}
+
+// ============================================================================
+// [Fog::TaskScheduler - Construction / Destruction]
+// ============================================================================
+
+static void FOG_CDECL TaskScheduler_ctor(TaskScheduler* self)
+{
+  self->_lock.init();
+  self->_condition.initCustom1(&self->_lock);
+  self->_current.create();
+
+  MemOps::zero(self->_workers, sizeof(self->_workers));
+  self->_numWorkers.init(0);
+
+  // The thread which waits for a task group works too.
+  int maxWorkers = (int)Cpu::get()->getNumberOfProcessors() - 1;
+  self->_maxWorkers.init(Math::bound<int>(maxWorkers, 0, TASK_SCHEDULER_MAX_WORKERS));
+
+  self->_sleeping.init(0);
+  self->_stopping.init(0);
+
+  self->_injectFirst = NULL;
+  self->_injectLast = NULL;
+  self->_injectCount.init(0);
+}
+
+static void FOG_CDECL TaskScheduler_dtor(TaskScheduler* self)
+{
+  { AutoLock locked(self->_lock);
+    self->_stopping.setXchg(1);
+    self->_condition->broadcast();
+  }
+
+  int i, n = self->_numWorkers.get();
+  for (i = 0; i < n; i++)
+  {
+    TaskSchedulerWorker* w = self->_workers[i];
+
+    w->exited.wait();
+    ThreadPool::get()->releaseThread(w->thread, i);
+  }
+
+  for (i = 0; i < n; i++)
+    TaskScheduler_destroyWorker(self->_workers[i]);
+
+  TaskScheduler_queueFree(self->_injectFirst);
+
+  self->_condition.destroy();
+  self->_lock.destroy();
+}
+
+// ============================================================================
+// [Fog::TaskScheduler - Spawn / Wait]
+// ============================================================================
+
+static err_t FOG_CDECL TaskScheduler_spawn(TaskScheduler* self, TaskGroup* group, TaskSchedulerFunc func, void* closure, int affinity)
+{
+  TaskScheduler_startWorkers(self);
+
+  TaskSchedulerJob* job = reinterpret_cast<TaskSchedulerJob*>(MemMgr::alloc(sizeof(TaskSchedulerJob)));
+  if (FOG_IS_NULL(job))
+  {
+    func(closure);
+    return ERR_OK;
+  }
+
+  job->group = group;
+  job->func = func;
+  job->rangeFunc = NULL;
+  job->closure = closure;
+  job->start = 0;
+  job->end = 0;
+  job->grain = 0;
+
+  group->_pending.inc();
+  TaskScheduler_push(self, TaskScheduler_getCurrent(self), job, affinity);
+
+  return ERR_OK;
+}
+
+static void FOG_CDECL TaskScheduler_wait(TaskScheduler* self, TaskGroup* group)
+{
+  TaskSchedulerWorker* current = TaskScheduler_getCurrent(self);
+
+  while (!group->isDone())
+  {
+    TaskSchedulerJob* job = TaskScheduler_findJob(self, current);
+
+    if (job != NULL)
+      TaskScheduler_runJob(self, current, job);
+    else
+      TaskScheduler_sleep(self, group);
+  }
+}
+
+// ============================================================================
+// [Fog::TaskScheduler - ParallelFor]
+// ============================================================================
+
+static void FOG_CDECL TaskScheduler_parallelFor(TaskScheduler* self,
+  size_t start, size_t end, size_t grain, TaskSchedulerRangeFunc func, void* closure)
+{
+  if (start >= end)
+    return;
+
+  if (grain == 0)
+    grain = 1;
+
+  if (end - start <= grain)
+  {
+    func(closure, start, end);
+    return;
+  }
+
+  TaskScheduler_startWorkers(self);
+
+  if (self->_numWorkers.get() == 0)
+  {
+    TaskScheduler_runChunks(func, closure, start, end, grain);
+    return;
+  }
+
+  TaskSchedulerWorker* current = TaskScheduler_getCurrent(self);
+  TaskGroup group;
+
+  TaskScheduler_runRange(self, current, &group, func, closure, start, end, grain);
+  TaskScheduler_wait(self, &group);
+}
+
+// ============================================================================
+// [Fog::TaskScheduler - Workers]
+// ============================================================================
+
+static int FOG_CDECL TaskScheduler_getNumWorkers(const TaskScheduler* self)
+{
+  return self->_numWorkers.get();
+}
+
+static int FOG_CDECL TaskScheduler_getMaxWorkers(const TaskScheduler* self)
+{
+  return self->_maxWorkers.get();
+}
+
+static err_t FOG_CDECL TaskScheduler_setMaxWorkers(TaskScheduler* self, int maxWorkers)
+{
+  if ((uint)maxWorkers > TASK_SCHEDULER_MAX_WORKERS)
+    return ERR_RT_INVALID_ARGUMENT;
+
+  AutoLock locked(self->_lock);
+  self->_maxWorkers.set(maxWorkers);
+  return ERR_OK;
+}
+
+static int FOG_CDECL TaskScheduler_getCurrentWorker(const TaskScheduler* self)
+{
+  TaskSchedulerWorker* current = TaskScheduler_getCurrent(self);
+  return current != NULL ? current->id : -1;
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void TaskScheduler_init(void)
+{
+  // --------------------------------------------------------------------------
+  // [Funcs]
+  // --------------------------------------------------------------------------
+
+  fog_api.taskscheduler_ctor = TaskScheduler_ctor;
+  fog_api.taskscheduler_dtor = TaskScheduler_dtor;
+
+  fog_api.taskscheduler_spawn = TaskScheduler_spawn;
+  fog_api.taskscheduler_wait = TaskScheduler_wait;
+  fog_api.taskscheduler_parallelFor = TaskScheduler_parallelFor;
+
+  fog_api.taskscheduler_getNumWorkers = TaskScheduler_getNumWorkers;
+  fog_api.taskscheduler_getMaxWorkers = TaskScheduler_getMaxWorkers;
+  fog_api.taskscheduler_setMaxWorkers = TaskScheduler_setMaxWorkers;
+  fog_api.taskscheduler_getCurrentWorker = TaskScheduler_getCurrentWorker;
+
+  // --------------------------------------------------------------------------
+  // [Data]
+  // --------------------------------------------------------------------------
+
+  fog_api.taskscheduler_oInstance = TaskScheduler_oInstance.init();
+}
+
+FOG_NO_EXPORT void TaskScheduler_fini(void)
+{
+  TaskScheduler_oInstance.destroy();
+}
+
+} // Fog namespace
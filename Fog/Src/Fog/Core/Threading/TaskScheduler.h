@@ -0,0 +1,267 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_CORE_THREADING_TASKSCHEDULER_H
+#define _FOG_CORE_THREADING_TASKSCHEDULER_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Threading/ThreadCondition.h>
+#include <Fog/Core/Threading/ThreadLocal.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_Core_Threading
+//! @{
+
+// ============================================================================
+// [Fog::TASK_SCHEDULER]
+// ============================================================================
+
+enum TASK_SCHEDULER
+{
+  //! @brief Maximum count of worker threads.
+  TASK_SCHEDULER_MAX_WORKERS = 32
+};
+
+// ============================================================================
+// [Fog::TaskGroup]
+// ============================================================================
+
+//! @brief Group of tasks spawned by @c TaskScheduler.
+//!
+//! The group counts the tasks which weren't finished yet, use @c wait() to
+//! wait for all of them. The group must not be destroyed while it contains
+//! pending tasks.
+struct FOG_NO_EXPORT TaskGroup
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE TaskGroup()
+  {
+    _pending.init(0);
+  }
+
+  FOG_INLINE ~TaskGroup()
+  {
+    FOG_ASSERT(_pending.get() == 0);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get count of tasks which weren't finished yet.
+  FOG_INLINE size_t getPending() const { return _pending.get(); }
+  //! @brief Get whether all tasks in the group were finished.
+  FOG_INLINE bool isDone() const { return _pending.get() == 0; }
+
+  // --------------------------------------------------------------------------
+  // [Wait]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void wait();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Count of pending tasks.
+  Atomic<size_t> _pending;
+
+private:
+  FOG_NO_COPY(TaskGroup)
+};
+
+// ============================================================================
+// [Fog::TaskScheduler]
+// ============================================================================
+
+//! @brief Work-stealing task scheduler.
+//!
+//! Unlike @c ThreadPool, which hands out whole threads, the task scheduler
+//! keeps a fixed set of worker threads (taken from the @c ThreadPool when the
+//! first task is spawned) and distributes small tasks between them. Each
+//! worker owns a Chase-Lev deque - it pushes and pops tasks at the bottom
+//! while idle workers steal from the top of other deques. Tasks spawned by
+//! non-worker threads are placed into the shared injection queue.
+//!
+//! A thread waiting for a @c TaskGroup doesn't block, it runs other tasks
+//! until the group is finished, so the tasks can be nested and the caller
+//! contributes to the work. The default count of workers is the count of
+//! processors minus one (the waiting thread is the last one), the engines
+//! sharing the scheduler (raster, filters, image codecs) don't oversubscribe
+//! the processors this way.
+//!
+//! All methods in @c TaskScheduler are thread safe.
+struct FOG_NO_EXPORT TaskScheduler
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  //! @brief Create task scheduler.
+  FOG_INLINE TaskScheduler()
+  {
+    fog_api.taskscheduler_ctor(this);
+  }
+
+  //! @brief Destroy task scheduler, stopping all workers.
+  FOG_INLINE ~TaskScheduler()
+  {
+    fog_api.taskscheduler_dtor(this);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Spawn / Wait]
+  // --------------------------------------------------------------------------
+
+  //! @brief Spawn a task which calls @a func(@a closure) and add it to
+  //! @a group.
+  //!
+  //! The @a affinity is a hint, the index of the worker which should run the
+  //! task (use it to keep the data of successive tasks in the same cache).
+  //! If the task can't be created (out of memory), it's run by the current
+  //! thread before @c spawn() returns.
+  FOG_INLINE err_t spawn(TaskGroup* group, TaskSchedulerFunc func, void* closure, int affinity = -1)
+  {
+    return fog_api.taskscheduler_spawn(this, group, func, closure, affinity);
+  }
+
+  //! @brief Wait until all tasks in @a group are finished, running other
+  //! tasks meanwhile.
+  FOG_INLINE void wait(TaskGroup* group)
+  {
+    fog_api.taskscheduler_wait(this, group);
+  }
+
+  // --------------------------------------------------------------------------
+  // [ParallelFor]
+  // --------------------------------------------------------------------------
+
+  //! @brief Call @a func for sub-ranges of [@a start, @a end) in parallel
+  //! and wait until the whole range is processed.
+  //!
+  //! The range is recursively split into halves until it's not larger than
+  //! @a grain, so each call gets at most @a grain items (and at least one).
+  FOG_INLINE void parallelFor(size_t start, size_t end, size_t grain, TaskSchedulerRangeFunc func, void* closure)
+  {
+    fog_api.taskscheduler_parallelFor(this, start, end, grain, func, closure);
+  }
+
+  //! @overload
+  //!
+  //! The @a functor is called as @c functor(start, end).
+  template<typename FunctorT>
+  FOG_INLINE void parallelFor(size_t start, size_t end, size_t grain, FunctorT& functor)
+  {
+    fog_api.taskscheduler_parallelFor(this, start, end, grain, _parallelForFunctor<FunctorT>, &functor);
+  }
+
+  template<typename FunctorT>
+  static void FOG_CDECL _parallelForFunctor(void* closure, size_t start, size_t end)
+  {
+    (*static_cast<FunctorT*>(closure))(start, end);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Workers]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get count of running workers.
+  FOG_INLINE int getNumWorkers() const
+  {
+    return fog_api.taskscheduler_getNumWorkers(this);
+  }
+
+  //! @brief Get maximum count of workers.
+  FOG_INLINE int getMaxWorkers() const
+  {
+    return fog_api.taskscheduler_getMaxWorkers(this);
+  }
+
+  //! @brief Set maximum count of workers.
+  //!
+  //! Workers are started when the next task is spawned, already running
+  //! workers are not stopped if @a maxWorkers is lower than their count.
+  FOG_INLINE err_t setMaxWorkers(int maxWorkers)
+  {
+    return fog_api.taskscheduler_setMaxWorkers(this, maxWorkers);
+  }
+
+  //! @brief Get index of the worker running the current thread, or @c -1 if
+  //! the current thread is not a worker of this scheduler.
+  FOG_INLINE int getCurrentWorker() const
+  {
+    return fog_api.taskscheduler_getCurrentWorker(this);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Statics]
+  // --------------------------------------------------------------------------
+
+  static FOG_INLINE TaskScheduler* get()
+  {
+    return fog_api.taskscheduler_oInstance;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Lock to protect the injection queue and starting of workers, it's
+  //! also the lock used by @c _condition.
+  mutable Static<Lock> _lock;
+  //! @brief Condition used by sleeping workers and waiters.
+  Static<ThreadCondition> _condition;
+
+  //! @brief Thread-local pointer to the current worker.
+  ThreadLocal _current;
+
+  //! @brief Workers (the first @c _numWorkers are valid).
+  TaskSchedulerWorker* _workers[TASK_SCHEDULER_MAX_WORKERS];
+  //! @brief Count of running workers.
+  Atomic<int> _numWorkers;
+  //! @brief Maximum count of workers.
+  Atomic<int> _maxWorkers;
+
+  //! @brief Count of threads sleeping on @c _condition.
+  Atomic<int> _sleeping;
+  //! @brief Whether the workers should stop.
+  Atomic<int> _stopping;
+
+  //! @brief First task in the injection queue.
+  TaskSchedulerJob* _injectFirst;
+  //! @brief Last task in the injection queue.
+  TaskSchedulerJob* _injectLast;
+  //! @brief Count of tasks in the injection queue.
+  Atomic<size_t> _injectCount;
+
+private:
+  FOG_NO_COPY(TaskScheduler)
+};
+
+// ============================================================================
+// [Fog::TaskGroup - Wait]
+// ============================================================================
+
+//! @brief Wait until all tasks in the group are finished (uses the default
+//! @c TaskScheduler).
+FOG_INLINE void TaskGroup::wait()
+{
+  TaskScheduler::get()->wait(this);
+}
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_CORE_THREADING_TASKSCHEDULER_H
@@ -0,0 +1,833 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_CORE_TOOLS_FLATHASH_H
+#define _FOG_CORE_TOOLS_FLATHASH_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Memory/BSwap.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Tools/HashUtil.h>
+#include <Fog/Core/Tools/String.h>
+#include <Fog/Core/Tools/Swap.h>
+
+// [Dependencies - C]
+#include <string.h>
+
+#if defined(FOG_HARDCODE_SSE2)
+# include <Fog/Core/C++/IntrinSse2.h>
+#endif // FOG_HARDCODE_SSE2
+
+#if defined(FOG_CC_MSC)
+# include <intrin.h>
+#endif // FOG_CC_MSC
+
+namespace Fog {
+
+//! @addtogroup Fog_Core_Tools
+//! @{
+
+// ============================================================================
+// [Fog::FLAT_HASH_CTRL]
+// ============================================================================
+
+//! @brief Control byte of @c FlatHash slot.
+//!
+//! A full slot contains the lower 7 bits of the (mixed) hash code, so the most
+//! significant bit is only set for empty and deleted slots.
+enum FLAT_HASH_CTRL
+{
+  //! @brief Slot was never used (terminates probing).
+  FLAT_HASH_CTRL_EMPTY = 0x80,
+  //! @brief Slot was used, but the item was removed (doesn't terminate probing).
+  FLAT_HASH_CTRL_DELETED = 0xFE
+};
+
+// ============================================================================
+// [Fog::FlatHashGroup]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Group of 16 control bytes which are matched at once.
+//!
+//! The group width (and so the layout of the table) doesn't depend on the
+//! instruction set the code was compiled for, @c FlatHash is embedded in
+//! exported classes and all translation units must agree on it. The SSE2
+//! implementation matches the group by a single compare, the portable one
+//! matches two 8-byte halves packed into 64-bit integers. The result is a
+//! mask having bit N set if the slot N of the group matches.
+struct FOG_NO_EXPORT FlatHashGroup
+{
+  enum { WIDTH = 16 };
+  typedef uint32_t Mask;
+
+#if defined(FOG_HARDCODE_SSE2)
+  FOG_INLINE explicit FlatHashGroup(const uint8_t* ctrl)
+  {
+    _ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+  }
+
+  //! @brief Get mask of slots which have control byte equal to @a h2.
+  FOG_INLINE Mask match(uint32_t h2) const
+  {
+    return (Mask)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char)h2), _ctrl));
+  }
+
+  //! @brief Get mask of empty slots.
+  FOG_INLINE Mask matchEmpty() const
+  {
+    return match(FLAT_HASH_CTRL_EMPTY);
+  }
+
+  //! @brief Get mask of empty or deleted slots.
+  FOG_INLINE Mask matchEmptyOrDeleted() const
+  {
+    // Signed compare, -1 is greater than EMPTY (-128) and DELETED (-2) only.
+    return (Mask)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8((char)-1), _ctrl));
+  }
+
+  __m128i _ctrl;
+#else
+  FOG_INLINE explicit FlatHashGroup(const uint8_t* ctrl)
+  {
+    MemOps::copy(_ctrl, ctrl, 16);
+    _ctrl[0] = MemOps::bswap64le(_ctrl[0]);
+    _ctrl[1] = MemOps::bswap64le(_ctrl[1]);
+  }
+
+  // The match can return a false positive if the byte above the matching one
+  // differs only in the lowest bit, it's not a problem, because the key is
+  // always compared.
+  FOG_INLINE Mask match(uint32_t h2) const
+  {
+    uint64_t k = FOG_UINT64_C(0x0101010101010101) * h2;
+    uint64_t x0 = _ctrl[0] ^ k;
+    uint64_t x1 = _ctrl[1] ^ k;
+
+    return _pack((x0 - FOG_UINT64_C(0x0101010101010101)) & ~x0 & FOG_UINT64_C(0x8080808080808080),
+                 (x1 - FOG_UINT64_C(0x0101010101010101)) & ~x1 & FOG_UINT64_C(0x8080808080808080));
+  }
+
+  FOG_INLINE Mask matchEmpty() const
+  {
+    return _pack(_ctrl[0] & ~(_ctrl[0] << 6) & FOG_UINT64_C(0x8080808080808080),
+                 _ctrl[1] & ~(_ctrl[1] << 6) & FOG_UINT64_C(0x8080808080808080));
+  }
+
+  FOG_INLINE Mask matchEmptyOrDeleted() const
+  {
+    return _pack(_ctrl[0] & ~(_ctrl[0] << 7) & FOG_UINT64_C(0x8080808080808080),
+                 _ctrl[1] & ~(_ctrl[1] << 7) & FOG_UINT64_C(0x8080808080808080));
+  }
+
+  //! @brief Pack the most significant bits of bytes of @a lo and @a hi into
+  //! a 16-bit mask (the same as @c _mm_movemask_epi8() does).
+  static FOG_INLINE Mask _pack(uint64_t lo, uint64_t hi)
+  {
+    lo = ((lo >> 7) * FOG_UINT64_C(0x0102040810204080)) >> 56;
+    hi = ((hi >> 7) * FOG_UINT64_C(0x0102040810204080)) >> 56;
+    return (Mask)lo | ((Mask)hi << 8);
+  }
+
+  uint64_t _ctrl[2];
+#endif // FOG_HARDCODE_SSE2
+
+  //! @brief Get index of the lowest slot in @a mask (must be non-zero).
+  static FOG_INLINE uint32_t getLowest(Mask mask)
+  {
+    FOG_ASSERT(mask != 0);
+
+#if defined(FOG_CC_GNU) || defined(FOG_CC_CLANG)
+    return (uint32_t)__builtin_ctz((unsigned int)mask);
+#elif defined(FOG_CC_MSC)
+    unsigned long index;
+    _BitScanForward(&index, (unsigned long)mask);
+    return (uint32_t)index;
+#else
+    uint32_t index = 0;
+    while ((mask & 1) == 0)
+    {
+      mask >>= 1;
+      index++;
+    }
+    return index;
+#endif
+  }
+
+  //! @brief Clear the lowest slot in @a mask.
+  static FOG_INLINE Mask clearLowest(Mask mask)
+  {
+    return mask & (mask - 1);
+  }
+};
+
+// ============================================================================
+// [Fog::FlatHashSlot<KeyT, ItemT>]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Slot of @c FlatHash, stored inline in the table.
+template<typename KeyT, typename ItemT>
+struct FlatHashSlot
+{
+  FOG_INLINE FlatHashSlot(uint32_t hashCode, const KeyT& key, const ItemT& item) :
+    key(key),
+    item(item)
+  {
+  }
+
+  static FOG_INLINE uint32_t hashKey(const KeyT& key)
+  {
+    return HashUtil::hash<KeyT>(key);
+  }
+
+  FOG_INLINE uint32_t getHashCode() const
+  {
+    return HashUtil::hash<KeyT>(key);
+  }
+
+  FOG_INLINE bool eqKey(uint32_t hashCode, const KeyT& other) const
+  {
+    return key == other;
+  }
+
+  KeyT key;
+  ItemT item;
+};
+
+//! @internal
+//!
+//! @brief Slot of @c FlatHash with @c StringW key, the hash code of the key is
+//! stored in the slot, so most of mismatches and rehashing don't touch the
+//! string data.
+template<typename ItemT>
+struct FlatHashSlot<StringW, ItemT>
+{
+  FOG_INLINE FlatHashSlot(uint32_t hashCode, const StringW& key, const ItemT& item) :
+    key(key),
+    item(item),
+    hashCode(hashCode)
+  {
+  }
+
+  static FOG_INLINE uint32_t hashKey(const StringW& key)
+  {
+    uint32_t hashCode = key._d->hashCode;
+
+    if (hashCode == 0)
+      hashCode = key.getHashCode();
+    return hashCode;
+  }
+
+  static FOG_INLINE uint32_t hashKey(const StubW& key)
+  {
+    return HashUtil::hash(key);
+  }
+
+  FOG_INLINE uint32_t getHashCode() const
+  {
+    return hashCode;
+  }
+
+  FOG_INLINE bool eqKey(uint32_t otherHashCode, const StringW& other) const
+  {
+    if (hashCode != otherHashCode)
+      return false;
+
+    const StringDataW* a = key._d;
+    const StringDataW* b = other._d;
+
+    // Interned strings share the data, the hash codes are equal so the data
+    // is compared only if the strings are not the same.
+    return a == b || (a->length == b->length && ::memcmp(a->data, b->data, a->length * sizeof(CharW)) == 0);
+  }
+
+  FOG_INLINE bool eqKey(uint32_t otherHashCode, const StubW& other) const
+  {
+    if (hashCode != otherHashCode)
+      return false;
+
+    const StringDataW* a = key._d;
+    return a->length == other.getLength() && ::memcmp(a->data, other.getData(), a->length * sizeof(CharW)) == 0;
+  }
+
+  StringW key;
+  ItemT item;
+  uint32_t hashCode;
+};
+
+// ============================================================================
+// [Fog::FlatHashBase<KeyT, ItemT>]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Implementation of @c FlatHash.
+template<typename KeyT, typename ItemT>
+struct FlatHashBase
+{
+  typedef FlatHashSlot<KeyT, ItemT> Slot;
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE FlatHashBase() :
+    _ctrl(NULL),
+    _slots(NULL),
+    _capacity(0),
+    _length(0),
+    _growthLeft(0)
+  {
+  }
+
+  FOG_INLINE ~FlatHashBase()
+  {
+    reset();
+  }
+
+  // --------------------------------------------------------------------------
+  // [Container]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get count of slots.
+  FOG_INLINE size_t getCapacity() const { return _capacity; }
+  //! @brief Get count of items.
+  FOG_INLINE size_t getLength() const { return _length; }
+  //! @brief Get whether the hash is empty.
+  FOG_INLINE bool isEmpty() const { return _length == 0; }
+
+  //! @brief Reserve the table to hold at least @a length items without
+  //! rehashing.
+  err_t reserve(size_t length)
+  {
+    size_t capacity = _getCapacityFor(length);
+
+    if (capacity <= _capacity)
+      return ERR_OK;
+
+    return _rehash(capacity);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Clear / Reset]
+  // --------------------------------------------------------------------------
+
+  //! @brief Remove all items, but keep the table.
+  void clear()
+  {
+    if (_length != 0)
+    {
+      _destroySlots();
+      _resetCtrl();
+    }
+  }
+
+  //! @brief Remove all items and free the table.
+  void reset()
+  {
+    if (_ctrl == NULL)
+      return;
+
+    _destroySlots();
+    MemMgr::free(_ctrl);
+
+    _ctrl = NULL;
+    _slots = NULL;
+    _capacity = 0;
+    _length = 0;
+    _growthLeft = 0;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE bool contains(const KeyT& key) const
+  {
+    return _find(Slot::hashKey(key), key) != NULL;
+  }
+
+  FOG_INLINE const ItemT& get(const KeyT& key, const ItemT& notFound) const
+  {
+    const Slot* slot = _find(Slot::hashKey(key), key);
+    return slot != NULL ? slot->item : notFound;
+  }
+
+  FOG_INLINE const ItemT* getPtr(const KeyT& key) const
+  {
+    const Slot* slot = _find(Slot::hashKey(key), key);
+    return slot != NULL ? &slot->item : NULL;
+  }
+
+  FOG_INLINE const ItemT* getPtr(const KeyT& key, const ItemT* notFound) const
+  {
+    const Slot* slot = _find(Slot::hashKey(key), key);
+    return slot != NULL ? &slot->item : notFound;
+  }
+
+  FOG_INLINE ItemT* usePtr(const KeyT& key)
+  {
+    Slot* slot = _find(Slot::hashKey(key), key);
+    return slot != NULL ? &slot->item : NULL;
+  }
+
+  FOG_INLINE ItemT* usePtr(const KeyT& key, ItemT* notFound)
+  {
+    Slot* slot = _find(Slot::hashKey(key), key);
+    return slot != NULL ? &slot->item : notFound;
+  }
+
+  //! @brief Put @a item into the hash, replacing the existing item if
+  //! @a replace is true.
+  //!
+  //! Returns @c ERR_RT_OBJECT_ALREADY_EXISTS if the key exists and @a replace
+  //! is false.
+  err_t put(const KeyT& key, const ItemT& item, bool replace = true)
+  {
+    uint32_t hashCode = Slot::hashKey(key);
+    Slot* slot = _find(hashCode, key);
+
+    if (slot != NULL)
+    {
+      if (!replace)
+        return ERR_RT_OBJECT_ALREADY_EXISTS;
+
+      slot->item = item;
+      return ERR_OK;
+    }
+
+    if (_growthLeft == 0)
+    {
+      // The key or item can refer to a slot of this hash (for example an item
+      // returned by get()), which is freed by _rehash(), so copy them first.
+      KeyT keyCopy(key);
+      ItemT itemCopy(item);
+
+      FOG_RETURN_ON_ERROR(_grow());
+      _insert(hashCode, keyCopy, itemCopy);
+    }
+    else
+    {
+      _insert(hashCode, key, item);
+    }
+
+    return ERR_OK;
+  }
+
+  //! @brief Remove @a key from the hash.
+  //!
+  //! Other items are not moved, so it's safe to remove the current item of
+  //! @c FlatHashIterator and continue iterating.
+  err_t remove(const KeyT& key)
+  {
+    Slot* slot = _find(Slot::hashKey(key), key);
+    if (slot == NULL)
+      return ERR_RT_OBJECT_NOT_FOUND;
+
+    slot->~Slot();
+
+    if (--_length == 0)
+      _resetCtrl();
+    else
+      _setCtrl((size_t)(slot - _slots), FLAT_HASH_CTRL_DELETED);
+
+    return ERR_OK;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Swap]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void swap(FlatHashBase& other)
+  {
+    Fog::swap(_ctrl, other._ctrl);
+    Fog::swap(_slots, other._slots);
+    Fog::swap(_capacity, other._capacity);
+    Fog::swap(_length, other._length);
+    Fog::swap(_growthLeft, other._growthLeft);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Internal]
+  // --------------------------------------------------------------------------
+
+  //! @brief Mix the hash code, the lower 7 bits are stored in control bytes
+  //! and the rest selects the first group to probe.
+  static FOG_INLINE uint32_t _mix(uint32_t hashCode)
+  {
+    hashCode ^= hashCode >> 16;
+    hashCode *= 0x85EBCA6BU;
+    hashCode ^= hashCode >> 13;
+    hashCode *= 0xC2B2AE35U;
+    hashCode ^= hashCode >> 16;
+    return hashCode;
+  }
+
+  static FOG_INLINE size_t _getCapacityFor(size_t length)
+  {
+    // Maximum load factor is 7/8.
+    size_t capacity = FlatHashGroup::WIDTH;
+    while (capacity - capacity / 8 < length)
+      capacity <<= 1;
+    return capacity;
+  }
+
+  template<typename LookupT>
+  FOG_INLINE Slot* _find(uint32_t hashCode, const LookupT& key) const
+  {
+    if (_ctrl == NULL)
+      return NULL;
+
+    uint32_t mixed = _mix(hashCode);
+    uint32_t h2 = mixed & 0x7F;
+
+    size_t mask = _capacity - 1;
+    size_t pos = (size_t)(mixed >> 7) & mask;
+    size_t step = 0;
+
+    for (;;)
+    {
+      FlatHashGroup group(_ctrl + pos);
+      typename FlatHashGroup::Mask m = group.match(h2);
+
+      while (m != 0)
+      {
+        size_t index = (pos + FlatHashGroup::getLowest(m)) & mask;
+        Slot* slot = &_slots[index];
+
+        if (slot->eqKey(hashCode, key))
+          return slot;
+
+        m = FlatHashGroup::clearLowest(m);
+      }
+
+      if (group.matchEmpty() != 0)
+        return NULL;
+
+      // Triangular probing visits all groups of a power-of-two table.
+      step += FlatHashGroup::WIDTH;
+      pos = (pos + step) & mask;
+    }
+  }
+
+  FOG_INLINE size_t _findInsertIndex(uint32_t mixed) const
+  {
+    size_t mask = _capacity - 1;
+    size_t pos = (size_t)(mixed >> 7) & mask;
+    size_t step = 0;
+
+    for (;;)
+    {
+      typename FlatHashGroup::Mask m = FlatHashGroup(_ctrl + pos).matchEmptyOrDeleted();
+      if (m != 0)
+        return (pos + FlatHashGroup::getLowest(m)) & mask;
+
+      step += FlatHashGroup::WIDTH;
+      pos = (pos + step) & mask;
+    }
+  }
+
+  FOG_INLINE void _setCtrl(size_t index, uint32_t value)
+  {
+    _ctrl[index] = (uint8_t)value;
+
+    // The first group is cloned after the last slot, so a group can be loaded
+    // from any position without wrapping.
+    if (index < (size_t)FlatHashGroup::WIDTH)
+      _ctrl[_capacity + index] = (uint8_t)value;
+  }
+
+  FOG_INLINE void _resetCtrl()
+  {
+    MemOps::set(_ctrl, FLAT_HASH_CTRL_EMPTY, _capacity + FlatHashGroup::WIDTH);
+
+    _length = 0;
+    _growthLeft = _capacity - _capacity / 8;
+  }
+
+  err_t _grow()
+  {
+    // Drop deleted slots if the table is not full enough, grow otherwise.
+    size_t capacity = _capacity;
+    if (capacity == 0)
+      capacity = FlatHashGroup::WIDTH;
+    else if (_length >= (capacity - capacity / 8) / 2)
+      capacity *= 2;
+
+    return _rehash(capacity);
+  }
+
+  FOG_INLINE void _insert(uint32_t hashCode, const KeyT& key, const ItemT& item)
+  {
+    FOG_ASSERT(_growthLeft != 0);
+
+    uint32_t mixed = _mix(hashCode);
+    size_t index = _findInsertIndex(mixed);
+
+    if (_ctrl[index] == FLAT_HASH_CTRL_EMPTY)
+      _growthLeft--;
+
+    _setCtrl(index, mixed & 0x7F);
+    fog_new_p(&_slots[index]) Slot(hashCode, key, item);
+
+    _length++;
+  }
+
+  void _destroySlots()
+  {
+    for (size_t i = 0; i < _capacity; i++)
+    {
+      if ((_ctrl[i] & 0x80) == 0)
+        _slots[i].~Slot();
+    }
+  }
+
+  err_t _rehash(size_t capacity)
+  {
+    FOG_ASSERT(capacity >= (size_t)FlatHashGroup::WIDTH && (capacity & (capacity - 1)) == 0);
+
+    size_t ctrlSize = capacity + FlatHashGroup::WIDTH;
+    uint8_t* newCtrl = reinterpret_cast<uint8_t*>(MemMgr::alloc(ctrlSize + capacity * sizeof(Slot)));
+
+    if (FOG_IS_NULL(newCtrl))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    uint8_t* oldCtrl = _ctrl;
+    Slot* oldSlots = _slots;
+    size_t oldCapacity = _capacity;
+
+    _ctrl = newCtrl;
+    _slots = reinterpret_cast<Slot*>(newCtrl + ctrlSize);
+    _capacity = capacity;
+
+    size_t length = _length;
+    _resetCtrl();
+
+    for (size_t i = 0; i < oldCapacity; i++)
+    {
+      if ((oldCtrl[i] & 0x80) != 0)
+        continue;
+
+      Slot* src = &oldSlots[i];
+      uint32_t mixed = _mix(src->getHashCode());
+
+      size_t index = _findInsertIndex(mixed);
+      _setCtrl(index, mixed & 0x7F);
+
+      if (TypeInfo<KeyT>::IS_MOVABLE && TypeInfo<ItemT>::IS_MOVABLE)
+      {
+        MemOps::copy(&_slots[index], src, sizeof(Slot));
+      }
+      else
+      {
+        fog_new_p(&_slots[index]) Slot(*src);
+        src->~Slot();
+      }
+    }
+
+    _length = length;
+    _growthLeft -= length;
+
+    if (oldCtrl != NULL)
+      MemMgr::free(oldCtrl);
+
+    return ERR_OK;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Control bytes (@c _capacity + @c FlatHashGroup::WIDTH), also the
+  //! pointer to the allocated table.
+  uint8_t* _ctrl;
+  //! @brief Slots (follow the control bytes).
+  Slot* _slots;
+
+  //! @brief Count of slots (power of two).
+  size_t _capacity;
+  //! @brief Count of items.
+  size_t _length;
+  //! @brief Count of items which can be added before the table is rehashed
+  //! (deleted slots are not reused until the next rehash).
+  size_t _growthLeft;
+
+private:
+  FOG_NO_COPY(FlatHashBase)
+};
+
+// ============================================================================
+// [Fog::FlatHash<KeyT, ItemT>]
+// ============================================================================
+
+//! @brief Open-addressing hash table with inline slots.
+//!
+//! Unlike @c Hash<KeyT, ItemT>, which is implicitly shared and allocates each
+//! node separately, @c FlatHash stores keys and items directly in the table
+//! and matches control bytes of whole groups of slots at once (SSE2 is used
+//! if available). Use it for private lookup-heavy tables, the container can't
+//! be copied or shared and it's not thread-safe.
+//!
+//! The key must be hashable by @c HashUtil::hash() and comparable by
+//! @c operator==(), the best candidates are integers, pointers and other
+//! trivially-copyable types. @c StringW keys use a specialized slot which
+//! stores the hash code.
+template<typename KeyT, typename ItemT>
+struct FlatHash : public FlatHashBase<KeyT, ItemT>
+{
+  FOG_INLINE FlatHash() {}
+  FOG_INLINE ~FlatHash() {}
+
+  FOG_INLINE void swap(FlatHash& other) { FlatHashBase<KeyT, ItemT>::swap(other); }
+};
+
+//! @brief Open-addressing hash table with @c StringW keys.
+//!
+//! The items can be also looked up by @c StubW, without creating a string.
+template<typename ItemT>
+struct FlatHash<StringW, ItemT> : public FlatHashBase<StringW, ItemT>
+{
+  typedef FlatHashBase<StringW, ItemT> Base;
+  typedef typename Base::Slot Slot;
+
+  FOG_INLINE FlatHash() {}
+  FOG_INLINE ~FlatHash() {}
+
+  using Base::contains;
+  using Base::get;
+  using Base::getPtr;
+  using Base::usePtr;
+
+  FOG_INLINE bool contains(const StubW& key) const
+  {
+    return getPtr(key) != NULL;
+  }
+
+  FOG_INLINE const ItemT& get(const StubW& key, const ItemT& notFound) const
+  {
+    const ItemT* item = getPtr(key);
+    return item != NULL ? *item : notFound;
+  }
+
+  FOG_INLINE const ItemT* getPtr(const StubW& key) const
+  {
+    StubW stub(key.getData(), key.getComputedLength());
+    const Slot* slot = Base::_find(Slot::hashKey(stub), stub);
+    return slot != NULL ? &slot->item : NULL;
+  }
+
+  FOG_INLINE ItemT* usePtr(const StubW& key)
+  {
+    return const_cast<ItemT*>(getPtr(key));
+  }
+
+  FOG_INLINE void swap(FlatHash& other) { Base::swap(other); }
+};
+
+// ============================================================================
+// [Fog::FlatHashIterator]
+// ============================================================================
+
+template<typename KeyT, typename ItemT>
+struct FlatHashIterator
+{
+  typedef FlatHashSlot<KeyT, ItemT> Slot;
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  //! @brief Create a new FlatHash<KeyT, ItemT> iterator.
+  FOG_INLINE FlatHashIterator(const FlatHashBase<KeyT, ItemT>& container)
+  {
+    start(&container);
+  }
+
+  //! @brief Destroy the FlatHash<KeyT, ItemT> iterator.
+  FOG_INLINE ~FlatHashIterator()
+  {
+  }
+
+  // --------------------------------------------------------------------------
+  // [Methods]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE const KeyT& getKey() const
+  {
+    FOG_ASSERT_X(isValid(),
+      "Fog::FlatHashIterator<?, ?>::getKey() - Iterator is not valid.");
+
+    return _container->_slots[_index].key;
+  }
+
+  FOG_INLINE const ItemT& getItem() const
+  {
+    FOG_ASSERT_X(isValid(),
+      "Fog::FlatHashIterator<?, ?>::getItem() - Iterator is not valid.");
+
+    return _container->_slots[_index].item;
+  }
+
+  FOG_INLINE bool isValid() const
+  {
+    return _index != INVALID_INDEX;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Start / Next]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE bool start(const FlatHashBase<KeyT, ItemT>* container)
+  {
+    _container = container;
+    return start();
+  }
+
+  FOG_INLINE bool start()
+  {
+    _index = INVALID_INDEX;
+    return next();
+  }
+
+  FOG_INLINE bool next()
+  {
+    size_t i = _index + 1;
+    size_t capacity = _container->_capacity;
+    const uint8_t* ctrl = _container->_ctrl;
+
+    while (i < capacity)
+    {
+      if ((ctrl[i] & 0x80) == 0)
+      {
+        _index = i;
+        return true;
+      }
+      i++;
+    }
+
+    _index = INVALID_INDEX;
+    return false;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  const FlatHashBase<KeyT, ItemT>* _container;
+  size_t _index;
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_CORE_TOOLS_FLATHASH_H
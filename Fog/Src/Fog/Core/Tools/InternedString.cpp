@@ -11,6 +11,8 @@
 // [Dependencies]
 #include <Fog/Core/Global/Init_p.h>
 #include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/Core/Threading/AtomicPadding.h>
 #include <Fog/Core/Threading/Lock.h>
 #include <Fog/Core/Tools/Hash.h>
 #include <Fog/Core/Tools/HashUtil.h>
@@ -25,355 +27,544 @@ namespace Fog {
 
 struct FOG_NO_EXPORT InternedStringNodeW
 {
+  //! @brief Next node in the list of removed nodes.
   InternedStringNodeW* next;
   Static<StringW> string;
 };
 
 // ============================================================================
-// [Fog::InternedStringHashW]
+// [Fog::InternedStringTableW]
 // ============================================================================
 
-struct FOG_NO_EXPORT InternedStringHashW
+//! @internal
+//!
+//! @brief Open-addressing table of interned strings (linear probing), the
+//! slots follow the table.
+struct FOG_NO_EXPORT InternedStringTableW
+{
+  FOG_INLINE StringDataW** getData() { return reinterpret_cast<StringDataW**>(this + 1); }
+
+  //! @brief Next table in the list of retired tables.
+  InternedStringTableW* next;
+  //! @brief Count of slots (prime).
+  size_t capacity;
+};
+
+// ============================================================================
+// [Fog::InternedStringShardW]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Count of shards, the shard is selected by the highest bits of the
+//! mixed hash-code.
+enum { INTERNED_STRING_SHARD_BITS = 4 };
+enum { INTERNED_STRING_SHARD_COUNT = 1 << INTERNED_STRING_SHARD_BITS };
+
+//! @internal
+//!
+//! @brief Part of the interned string hash.
+//!
+//! Lookup of an existing string doesn't take the lock, it only announces the
+//! reader in @c _readers. The lock is taken to add or remove strings and to
+//! replace the table. These changes are visible to readers immediately, so
+//! a reader can miss a string which is being moved (this is why the lookup
+//! is repeated under the lock if it fails), but it never reads freed memory:
+//! the replaced tables and removed strings are freed only when there is no
+//! reader.
+struct FOG_NO_EXPORT InternedStringShardW
 {
   // --------------------------------------------------------------------------
   // [Construction / Destruction]
   // --------------------------------------------------------------------------
 
-  InternedStringHashW();
-  ~InternedStringHashW();
+  InternedStringShardW();
+  ~InternedStringShardW();
 
   // --------------------------------------------------------------------------
-  // [Add]
+  // [Lookup / Add]
   // --------------------------------------------------------------------------
 
-  StringDataW* addStubA(const char* sData, size_t sLength, uint32_t hashCode);
-  StringDataW* addStubW(const CharW* sData, size_t sLength, uint32_t hashCode);
+  template<typename CharT>
+  StringDataW* lookup(const CharT* sData, size_t sLength, uint32_t hashCode);
 
-  void addList(InternedStringW* listData, size_t listLength);
+  template<typename CharT>
+  StringDataW* _lookup(const CharT* sData, size_t sLength, uint32_t hashCode) const;
 
-  // --------------------------------------------------------------------------
-  // [Lookup]
-  // --------------------------------------------------------------------------
+  template<typename CharT>
+  StringDataW* _add(const CharT* sData, size_t sLength, uint32_t hashCode);
 
-  StringDataW* lookupStubA(const char* sData, size_t sLength, uint32_t hashCode) const;
-  StringDataW* lookupStubW(const CharW* sData, size_t sLength, uint32_t hashCode) const;
+  void _addData(StringDataW* d);
 
   // --------------------------------------------------------------------------
   // [Management]
   // --------------------------------------------------------------------------
 
   void _rehash(size_t capacity);
-  InternedStringNodeW* _cleanup();
+  void _cleanup();
+  void _reclaim();
 
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
 
-  //! @brief Count of buckets.
-  size_t _capacity;
-  //! @brief Count of nodes.
-  size_t _length;
+  //! @brief Count of threads in @c lookup().
+  Atomic<size_t> _readers;
+  //! @brief Current table.
+  InternedStringTableW* _table;
+
+  AtomicPadding2<Atomic<size_t>, InternedStringTableW*> _padding;
+
+  //! @brief Lock, taken by writers only.
+  Lock _lock;
 
-  //! @brief Count of buckets we will expand to if length exceeds _expandLength.
-  size_t _expandCapacity;
-  //! @brief Count of nodes to grow.
+  //! @brief Count of strings in the table.
+  size_t _length;
+  //! @brief Count of strings to grow.
   size_t _expandLength;
 
-  //! @brief Nodes.
-  InternedStringNodeW** _data;
-  InternedStringNodeW* _staticData[1];
+  //! @brief Tables replaced by @c _rehash(), not freed yet.
+  InternedStringTableW* _retiredTables;
+  //! @brief Nodes removed by @c _cleanup(), not freed yet.
+  InternedStringNodeW* _retiredNodes;
+
+private:
+  FOG_NO_COPY(InternedStringShardW)
 };
 
 // ============================================================================
-// [Fog::InternedStringHashW - Construction / Destruction]
+// [Fog::InternedStringShardW - Helpers]
 // ============================================================================
 
-InternedStringHashW::InternedStringHashW()
+static FOG_INLINE InternedStringTableW* InternedStringTableW_create(size_t capacity)
 {
-  _capacity = 1;
-  _length = 0;
+  InternedStringTableW* table = reinterpret_cast<InternedStringTableW*>(
+    MemMgr::calloc(sizeof(InternedStringTableW) + sizeof(StringDataW*) * capacity));
 
-  _expandCapacity = 1;
-  _expandLength = HashUtil::getClosestPrime(0);
+  if (FOG_IS_NULL(table))
+    return NULL;
 
-  _data = _staticData;
-  _staticData[0] = NULL;
+  table->capacity = capacity;
+  return table;
 }
 
-InternedStringHashW::~InternedStringHashW()
+// Add a reference unless the string was already removed by the cleanup, which
+// sets the reference count of strings it removes to zero.
+static FOG_INLINE bool InternedStringW_tryAddRef(StringDataW* d)
 {
-  if (_data != _staticData)
-    MemMgr::free(_data);
+  for (;;)
+  {
+    size_t reference = d->reference.get();
+
+    if (reference == 0)
+      return false;
+
+    if (d->reference.cmpXchg(reference, reference + 1))
+      return true;
+  }
 }
 
 // ============================================================================
-// [Fog::InternedStringHashW - Add]
+// [Fog::InternedStringShardW - Construction / Destruction]
 // ============================================================================
 
-StringDataW* InternedStringHashW::addStubA(const char* sData, size_t sLength, uint32_t hashCode)
+InternedStringShardW::InternedStringShardW()
 {
-  uint32_t hashMod = hashCode % _capacity;
+  _readers.init(0);
+  _table = NULL;
 
-  InternedStringNodeW** pPrev = &_data[hashMod];
-  InternedStringNodeW* node = *pPrev;
+  _length = 0;
+  _expandLength = 0;
 
-  while (node)
-  {
-    StringDataW* d = node->string->_d;
+  _retiredTables = NULL;
+  _retiredNodes = NULL;
+}
 
-    if (d->length == sLength && StringUtil::eq(d->data, sData, sLength))
-      return d->addRef();
+InternedStringShardW::~InternedStringShardW()
+{
+  FOG_ASSERT(_readers.get() == 0);
+  _reclaim();
 
-    pPrev = &node->next;
-    node = *pPrev;
-  }
+  // Interned strings are not freed, they can be still referenced.
+  if (_table)
+    MemMgr::free(_table);
+}
 
-  node = reinterpret_cast<InternedStringNodeW*>(
-    MemMgr::alloc(sizeof(InternedStringNodeW) + StringDataW::getSizeOf(sLength)));
+// ============================================================================
+// [Fog::InternedStringShardW - Lookup / Add]
+// ============================================================================
 
-  if (FOG_IS_NULL(node))
-    return NULL;
+template<typename CharT>
+StringDataW* InternedStringShardW::lookup(const CharT* sData, size_t sLength, uint32_t hashCode)
+{
+  StringDataW* result = NULL;
+  _readers.inc();
 
-  StringDataW* d = reinterpret_cast<StringDataW*>(node + 1);
-  d->reference.init(2);
-  d->vType = VAR_TYPE_STRING_W | VAR_FLAG_STRING_INTERNED;
-  d->hashCode = hashCode;
-  d->capacity = sLength;
-  d->length = sLength;
-  StringUtil::copy(d->data, sData, sLength);
+  InternedStringTableW* table = AtomicCore<InternedStringTableW*>::get(&_table);
+  if (table)
+  {
+    StringDataW** data = table->getData();
 
-  node->next = NULL;
-  node->string->_d = d;
-  *pPrev = node;
+    size_t capacity = table->capacity;
+    size_t i = hashCode % capacity;
 
-  if (++_length >= _expandLength)
-    _rehash(_expandCapacity);
+    for (;;)
+    {
+      StringDataW* d = AtomicCore<StringDataW*>::get(&data[i]);
 
-  return d;
+      if (d == NULL)
+        break;
+
+      if (d->hashCode == hashCode && d->length == sLength && StringUtil::eq(d->data, sData, sLength))
+      {
+        if (InternedStringW_tryAddRef(d))
+          result = d;
+        break;
+      }
+
+      if (++i == capacity)
+        i = 0;
+    }
+  }
+
+  _readers.dec();
+  return result;
 }
 
-StringDataW* InternedStringHashW::addStubW(const CharW* sData, size_t sLength, uint32_t hashCode)
+template<typename CharT>
+StringDataW* InternedStringShardW::_lookup(const CharT* sData, size_t sLength, uint32_t hashCode) const
 {
-  uint32_t hashMod = hashCode % _capacity;
+  if (_table == NULL)
+    return NULL;
 
-  InternedStringNodeW** pPrev = &_data[hashMod];
-  InternedStringNodeW* node = *pPrev;
+  StringDataW** data = _table->getData();
 
-  while (node)
+  size_t capacity = _table->capacity;
+  size_t i = hashCode % capacity;
+
+  for (;;)
   {
-    StringDataW* d = node->string->_d;
+    StringDataW* d = data[i];
 
-    if (d->length == sLength && StringUtil::eq(d->data, sData, sLength))
+    if (d == NULL)
+      return NULL;
+
+    if (d->hashCode == hashCode && d->length == sLength && StringUtil::eq(d->data, sData, sLength))
       return d->addRef();
 
-    pPrev = &node->next;
-    node = *pPrev;
+    if (++i == capacity)
+      i = 0;
+  }
+}
+
+template<typename CharT>
+StringDataW* InternedStringShardW::_add(const CharT* sData, size_t sLength, uint32_t hashCode)
+{
+  StringDataW* d = _lookup(sData, sLength, hashCode);
+  if (d != NULL)
+    return d;
+
+  if (_length >= _expandLength)
+  {
+    _rehash(HashUtil::getClosestPrime(_length * 4 + 16));
+    if (_length >= _expandLength)
+      return NULL;
   }
 
-  node = reinterpret_cast<InternedStringNodeW*>(
+  InternedStringNodeW* node = reinterpret_cast<InternedStringNodeW*>(
     MemMgr::alloc(sizeof(InternedStringNodeW) + StringDataW::getSizeOf(sLength)));
 
   if (FOG_IS_NULL(node))
     return NULL;
 
-  StringDataW* d = reinterpret_cast<StringDataW*>(node + 1);
+  d = reinterpret_cast<StringDataW*>(node + 1);
   d->reference.init(2);
   d->vType = VAR_TYPE_STRING_W | VAR_FLAG_STRING_INTERNED;
   d->hashCode = hashCode;
   d->capacity = sLength;
   d->length = sLength;
   StringUtil::copy(d->data, sData, sLength);
+  d->data[sLength] = 0;
 
   node->next = NULL;
   node->string->_d = d;
-  *pPrev = node;
-
-  if (++_length >= _expandLength)
-    _rehash(_expandCapacity);
 
+  _addData(d);
   return d;
 }
 
-void InternedStringHashW::addList(InternedStringW* listData, size_t listLength)
+void InternedStringShardW::_addData(StringDataW* d)
 {
-  if (_length + listLength >= _expandLength)
+  StringDataW** data = _table->getData();
+
+  size_t capacity = _table->capacity;
+  size_t i = d->hashCode % capacity;
+
+  while (data[i] != NULL)
   {
-    size_t expandCapacity = HashUtil::getClosestPrime((_length + listLength) / 10 * 11);
-    _rehash(expandCapacity);
+    if (++i == capacity)
+      i = 0;
   }
 
-  for (size_t i = 0; i < listLength; i++)
-  {
-    StringDataW* d = listData[i]._string->_d;
-    const CharW* sData = d->data;
+  // Full barrier, the string data are visible to readers once linked.
+  atomicPtrXchg(&data[i], d);
+  _length++;
+}
+
+// ============================================================================
+// [Fog::InternedStringShardW - Management]
+// ============================================================================
 
-    size_t sLength = d->length;
-    FOG_ASSERT(sLength > 0);
+void InternedStringShardW::_rehash(size_t capacity)
+{
+  InternedStringTableW* oldTable = _table;
+  InternedStringTableW* newTable = InternedStringTableW_create(capacity);
 
-    uint32_t hashMod = d->hashCode % _capacity;
+  if (FOG_IS_NULL(newTable))
+    return;
 
-    InternedStringNodeW** pPrev = &_data[hashMod];
-    InternedStringNodeW* node = *pPrev;
+  StringDataW** newData = newTable->getData();
 
-    while (node)
+  if (oldTable)
+  {
+    StringDataW** oldData = oldTable->getData();
+
+    for (size_t i = 0; i < oldTable->capacity; i++)
     {
-      StringDataW* node_d = node->string->_d;
+      StringDataW* d = oldData[i];
+      if (d == NULL)
+        continue;
 
-      if (node_d->length == sLength && StringUtil::eq(node_d->data, sData, sLength))
+      size_t j = d->hashCode % capacity;
+      while (newData[j] != NULL)
       {
-        listData[i]._string->_d = node_d->addRef();
-
-        d->reference.init(0);
-        d = NULL;
-        break;
+        if (++j == capacity)
+          j = 0;
       }
-
-      pPrev = &node->next;
-      node = *pPrev;
+      newData[j] = d;
     }
 
-    if (d)
-    {
-      node = reinterpret_cast<InternedStringNodeW*>(reinterpret_cast<uint8_t*>(d) - sizeof(InternedStringNodeW));
-      node->next = NULL;
-      *pPrev = node;
-    }
+    oldTable->next = _retiredTables;
+    _retiredTables = oldTable;
   }
-}
 
-// ============================================================================
-// [Fog::InternedStringHashW - Lookup]
-// ============================================================================
+  // Keep the load factor under 1/2, so the probe sequences are short.
+  _expandLength = capacity / 2;
+
+  // Full barrier, the table is visible to readers once exchanged.
+  atomicPtrXchg(&_table, newTable);
+  _reclaim();
+}
 
-StringDataW* InternedStringHashW::lookupStubA(const char* sData, size_t sLength, uint32_t hashCode) const
+void InternedStringShardW::_cleanup()
 {
-  uint32_t hashMod = hashCode % _capacity;
-  InternedStringNodeW* node = _data[hashMod];
+  if (_table == NULL)
+    return;
 
-  while (node)
+  StringDataW** data = _table->getData();
+  size_t capacity = _table->capacity;
+
+  // Remove strings which are referenced only by the hash table. Readers can't
+  // add a reference to these strings anymore, see InternedStringW_tryAddRef().
+  size_t i = 0;
+  while (i < capacity)
   {
-    StringDataW* d = node->string->_d;
+    StringDataW* d = data[i];
 
-    if (d->length == sLength && StringUtil::eq(d->data, sData, sLength))
-      return d->addRef();
+    if (d == NULL || (d->vType & VAR_FLAG_STRING_CACHED) != 0 || !d->reference.cmpXchg(1, 0))
+    {
+      i++;
+      continue;
+    }
+
+    InternedStringNodeW* node = reinterpret_cast<InternedStringNodeW*>(
+      reinterpret_cast<uint8_t*>(d) - sizeof(InternedStringNodeW));
+
+    node->next = _retiredNodes;
+    _retiredNodes = node;
+    _length--;
+
+    // Backward shift deletion - move the strings which follow in the probe
+    // sequence to the empty slot, then check the moved string again.
+    size_t hole = i;
+    size_t j = i;
+
+    for (;;)
+    {
+      if (++j == capacity)
+        j = 0;
+
+      StringDataW* moved = data[j];
+      if (moved == NULL)
+        break;
+
+      size_t home = moved->hashCode % capacity;
+      bool canMove = (hole <= j) ? (home <= hole || home > j)
+                                 : (home <= hole && home > j);
+      if (canMove)
+      {
+        AtomicCore<StringDataW*>::set(&data[hole], moved);
+        hole = j;
+      }
+    }
 
-    node = node->next;
+    AtomicCore<StringDataW*>::set(&data[hole], NULL);
   }
 
-  return NULL;
+  // Shrink the table if it's mostly empty.
+  size_t newCapacity = HashUtil::getClosestPrime(_length * 4 + 16);
+
+  if (newCapacity < capacity / 2)
+    _rehash(newCapacity);
+  else
+    _reclaim();
 }
 
-StringDataW* InternedStringHashW::lookupStubW(const CharW* sData, size_t sLength, uint32_t hashCode) const
+void InternedStringShardW::_reclaim()
 {
-  uint32_t hashMod = hashCode % _capacity;
-  InternedStringNodeW* node = _data[hashMod];
+  if (_retiredTables == NULL && _retiredNodes == NULL)
+    return;
 
-  while (node)
-  {
-    StringDataW* d = node->string->_d;
+  // Full barrier, readers which enter after this point can't see the retired
+  // tables and nodes.
+  if (_readers.addXchg(0) != 0)
+    return;
 
-    if (d->length == sLength && StringUtil::eq(d->data, sData, sLength))
-      return d->addRef();
+  InternedStringTableW* table = _retiredTables;
+  while (table)
+  {
+    InternedStringTableW* next = table->next;
+    MemMgr::free(table);
+    table = next;
+  }
 
-    node = node->next;
+  InternedStringNodeW* node = _retiredNodes;
+  while (node)
+  {
+    InternedStringNodeW* next = node->next;
+    MemMgr::free(node);
+    node = next;
   }
 
-  return NULL;
+  _retiredTables = NULL;
+  _retiredNodes = NULL;
 }
 
 // ============================================================================
-// [Fog::InternedStringHashW - Management]
+// [Fog::InternedStringHashW]
 // ============================================================================
 
-void InternedStringHashW::_rehash(size_t capacity)
+//! @internal
+//!
+//! @brief Interned string hash, divided into shards so the threads adding
+//! strings which belong to different shards don't wait for each other.
+struct FOG_NO_EXPORT InternedStringHashW
 {
-  InternedStringNodeW** oldData = _data;
-  InternedStringNodeW** newData = (InternedStringNodeW**)MemMgr::calloc(sizeof(InternedStringNodeW*) * capacity);
-
-  if (FOG_IS_NULL(newData))
-    return;
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
 
-  size_t i, len = _capacity;
-  for (i = 0; i < len; i++)
+  FOG_INLINE InternedStringShardW& getShard(uint32_t hashCode)
   {
-    InternedStringNodeW* node = oldData[i];
+    // The hash-code of short strings has only few significant bits, mix them
+    // into the highest bits used as a shard index.
+    return _shards[(hashCode * 0x9E3779B1U) >> (32 - INTERNED_STRING_SHARD_BITS)];
+  }
 
-    while (node)
-    {
-      uint32_t hashMod = node->string->_d->hashCode % capacity;
-      InternedStringNodeW* next = node->next;
+  // --------------------------------------------------------------------------
+  // [Get]
+  // --------------------------------------------------------------------------
 
-      node->next = newData[hashMod];
-      newData[hashMod] = node;
+  template<typename CharT>
+  FOG_INLINE StringDataW* get(const CharT* sData, size_t sLength, uint32_t hashCode, uint32_t options)
+  {
+    InternedStringShardW& shard = getShard(hashCode);
 
-      node = next;
-    }
+    StringDataW* d = shard.lookup(sData, sLength, hashCode);
+    if (d != NULL)
+      return d;
+
+    AutoLock locked(shard._lock);
+    if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
+      return shard._lookup(sData, sLength, hashCode);
+    else
+      return shard._add(sData, sLength, hashCode);
   }
 
-  _capacity = capacity;
-  if (_capacity <= SIZE_MAX / 19)
-    _expandLength = (_capacity * 19) / 20;
-  else
-    _expandLength = size_t(double(_capacity) * 0.95);
+  // --------------------------------------------------------------------------
+  // [Add]
+  // --------------------------------------------------------------------------
 
-  if (oldData != _staticData)
-    MemMgr::free(oldData);
+  void addList(InternedStringW* listData, size_t listLength);
 
-  _data = newData;
-}
+  // --------------------------------------------------------------------------
+  // [Cleanup]
+  // --------------------------------------------------------------------------
 
-InternedStringNodeW* InternedStringHashW::_cleanup()
-{
-  InternedStringNodeW* unusedNodes = NULL;
-  InternedStringNodeW** data = _data;
+  void cleanup();
 
-  size_t i, len = _capacity;
-  size_t removedCount = 0;
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  InternedStringShardW _shards[INTERNED_STRING_SHARD_COUNT];
+};
 
-  for (i = 0; i < len; i++)
+void InternedStringHashW::addList(InternedStringW* listData, size_t listLength)
+{
+  for (size_t i = 0; i < listLength; i++)
   {
-    InternedStringNodeW** pPrev = &data[i];
-    InternedStringNodeW* node = *pPrev;
+    StringDataW* d = listData[i]._string->_d;
+    FOG_ASSERT(d->length > 0);
+
+    InternedStringShardW& shard = getShard(d->hashCode);
+    AutoLock locked(shard._lock);
 
-    while (node)
+    StringDataW* old = shard._lookup(d->data, d->length, d->hashCode);
+    if (old != NULL)
     {
-      InternedStringNodeW* next = node->next;
-      if ((node->string->_d->vType & VAR_FLAG_STRING_CACHED) == 0 && node->string->_d->reference.cmpXchg(1, 0))
-      {
-        *pPrev = next;
+      listData[i]._string->_d = old;
+      d->reference.init(0);
+      continue;
+    }
 
-        node->next = unusedNodes;
-        unusedNodes = node;
+    if (shard._length >= shard._expandLength)
+    {
+      shard._rehash(HashUtil::getClosestPrime(shard._length * 4 + 16));
 
-        node = next;
-        removedCount++;
-      }
-      else
-      {
-        pPrev = &node->next;
-        node = next;
-      }
+      // Out of memory, the string stays in the list, but it's not interned.
+      if (shard._length >= shard._expandLength)
+        continue;
     }
-  }
 
-  _length -= removedCount;
+    shard._addData(d);
+  }
+}
 
-  if (_length < _capacity / 4)
+void InternedStringHashW::cleanup()
+{
+  for (size_t i = 0; i < INTERNED_STRING_SHARD_COUNT; i++)
   {
-    _rehash(HashUtil::getClosestPrime((_length / 10) * 11));
+    AutoLock locked(_shards[i]._lock);
+    _shards[i]._cleanup();
   }
-
-  return unusedNodes;
 }
 
 // ============================================================================
 // [Fog::InternedStringW - Global]
 // ============================================================================
 
-static Static<Lock> InternedStringW_lock;
 static Static<InternedStringHashW> InternedStringW_hash;
 static Static<InternedStringW> InternedStringW_oEmpty;
 
+static FOG_INLINE err_t InternedStringW_getError(uint32_t options)
+{
+  if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
+    return ERR_RT_OBJECT_NOT_FOUND;
+  else
+    return ERR_RT_OUT_OF_MEMORY;
+}
+
 // ============================================================================
 // [Fog::InternedStringW - Construction / Destruction]
 // ============================================================================
@@ -400,27 +591,12 @@ static err_t FOG_CDECL InternedStringW_ctorStubA(InternedStringW* self, const St
   }
 
   uint32_t hashCode = HashUtil::hash(StubA(sData, sLength));
+  StringDataW* d = InternedStringW_hash->get(sData, sLength, hashCode, options);
 
-  AutoLock locked(InternedStringW_lock);
-  StringDataW* d;
-
-  if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
-  {
-    d = InternedStringW_hash->lookupStubA(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-    {
-      self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
-      return ERR_RT_OBJECT_NOT_FOUND;
-    }
-  }
-  else
+  if (FOG_IS_NULL(d))
   {
-    d = InternedStringW_hash->addStubA(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-    {
-      self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
-      return ERR_RT_OUT_OF_MEMORY;
-    }
+    self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
+    return InternedStringW_getError(options);
   }
 
   self->_string->_d = d;
@@ -438,27 +614,12 @@ static err_t FOG_CDECL InternedStringW_ctorStubW(InternedStringW* self, const St
   }
 
   uint32_t hashCode = HashUtil::hash(StubW(sData, sLength));
+  StringDataW* d = InternedStringW_hash->get(sData, sLength, hashCode, options);
 
-  AutoLock locked(InternedStringW_lock);
-  StringDataW* d;
-
-  if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
-  {
-    d = InternedStringW_hash->lookupStubW(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-    {
-      self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
-      return ERR_RT_OBJECT_NOT_FOUND;
-    }
-  }
-  else
+  if (FOG_IS_NULL(d))
   {
-    d = InternedStringW_hash->addStubW(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-    {
-      self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
-      return ERR_RT_OUT_OF_MEMORY;
-    }
+    self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
+    return InternedStringW_getError(options);
   }
 
   self->_string->_d = d;
@@ -482,25 +643,12 @@ static err_t FOG_CDECL InternedStringW_ctorStringW(InternedStringW* self, const
   }
 
   uint32_t hashCode = str->getHashCode();
-  AutoLock locked(InternedStringW_lock);
+  d = InternedStringW_hash->get(d->data, d->length, hashCode, options);
 
-  if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
+  if (FOG_IS_NULL(d))
   {
-    d = InternedStringW_hash->lookupStubW(d->data, d->length, hashCode);
-    if (FOG_IS_NULL(d))
-    {
-      self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
-      return ERR_RT_OBJECT_NOT_FOUND;
-    }
-  }
-  else
-  {
-    d = InternedStringW_hash->addStubW(d->data, d->length, hashCode);
-    if (FOG_IS_NULL(d))
-    {
-      self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
-      return ERR_RT_OUT_OF_MEMORY;
-    }
+    self->_string->_d = fog_api.stringw_oEmpty->_d->addRef();
+    return InternedStringW_getError(options);
   }
 
   self->_string->_d = d;
@@ -531,22 +679,10 @@ static err_t FOG_CDECL InternedStringW_setStubA(InternedStringW* self, const Stu
   }
 
   uint32_t hashCode = HashUtil::hash(StubA(sData, sLength));
+  StringDataW* d = InternedStringW_hash->get(sData, sLength, hashCode, options);
 
-  AutoLock locked(InternedStringW_lock);
-  StringDataW* d;
-
-  if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
-  {
-    d = InternedStringW_hash->lookupStubA(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-      return ERR_RT_OBJECT_NOT_FOUND;
-  }
-  else
-  {
-    d = InternedStringW_hash->addStubA(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-      return ERR_RT_OUT_OF_MEMORY;
-  }
+  if (FOG_IS_NULL(d))
+    return InternedStringW_getError(options);
 
   atomicPtrXchg(&self->_string->_d, d)->reference.dec();
   return ERR_OK;
@@ -564,22 +700,10 @@ static err_t FOG_CDECL InternedStringW_setStubW(InternedStringW* self, const Stu
   }
 
   uint32_t hashCode = HashUtil::hash(StubW(sData, sLength));
+  StringDataW* d = InternedStringW_hash->get(sData, sLength, hashCode, options);
 
-  AutoLock locked(InternedStringW_lock);
-  StringDataW* d;
-
-  if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
-  {
-    d = InternedStringW_hash->lookupStubW(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-      return ERR_RT_OBJECT_NOT_FOUND;
-  }
-  else
-  {
-    d = InternedStringW_hash->addStubW(sData, sLength, hashCode);
-    if (FOG_IS_NULL(d))
-      return ERR_RT_OUT_OF_MEMORY;
-  }
+  if (FOG_IS_NULL(d))
+    return InternedStringW_getError(options);
 
   atomicPtrXchg(&self->_string->_d, d)->reference.dec();
   return ERR_OK;
@@ -596,20 +720,10 @@ static err_t FOG_CDECL InternedStringW_setStringW(InternedStringW* self, const S
   }
 
   uint32_t hashCode = str->getHashCode();
-  AutoLock locked(InternedStringW_lock);
+  d = InternedStringW_hash->get(d->data, d->length, hashCode, options);
 
-  if ((options & INTERNED_STRING_OPTION_LOOKUP) != 0)
-  {
-    d = InternedStringW_hash->lookupStubW(d->data, d->length, hashCode);
-    if (FOG_IS_NULL(d))
-      return ERR_RT_OBJECT_NOT_FOUND;
-  }
-  else
-  {
-    d = InternedStringW_hash->addStubW(d->data, d->length, hashCode);
-    if (FOG_IS_NULL(d))
-      return ERR_RT_OUT_OF_MEMORY;
-  }
+  if (FOG_IS_NULL(d))
+    return InternedStringW_getError(options);
 
   atomicPtrXchg(&self->_string->_d, d)->reference.dec();
   return ERR_OK;
@@ -645,19 +759,7 @@ static bool FOG_CDECL InternedStringW_eq(const InternedStringW* a, const Interne
 
 static void FOG_CDECL InternedStringW_cleanup(void)
 {
-  InternedStringNodeW* node;
-
-  {
-    AutoLock locked(InternedStringW_lock);
-    node = InternedStringW_hash->_cleanup();
-  }
-
-  while (node)
-  {
-    InternedStringNodeW* next = node->next;
-    MemMgr::free(node);
-    node = next;
-  }
+  InternedStringW_hash->cleanup();
 }
 
 static void FOG_CDECL InternedStringW_cleanupFunc(void* closure, uint32_t reason)
@@ -753,7 +855,6 @@ static InternedStringCacheW* FOG_CDECL InternedStringCacheW_create(const char* s
   FOG_ASSERT(listLength == counter);
   FOG_ASSERT(pData <= pEnd);
 
-  AutoLock locked(InternedStringW_lock);
   InternedStringW_hash->addList(pListBase, listLength);
 
   return self;
@@ -811,6 +912,7 @@ static const char InternedStringCacheW_data[] =
   "cy\0"
   "d\0"
   "defs\0"
+  "delay\0"
   "depth\0"
   "direction\0"
   "display\0"
@@ -855,6 +957,7 @@ static const char InternedStringCacheW_data[] =
   "lighting-color\0"
   "line\0"
   "linearGradient\0"
+  "loopCount\0"
   "marker\0"
   "marker_end\0"
   "marker_mid\0"
@@ -912,6 +1015,7 @@ static const char InternedStringCacheW_data[] =
   "textLength\0"
   "textPath\0"
   "tga\0"
+  "threads\0"
   "tif\0"
   "tiff\0"
   "transform\0"
@@ -948,6 +1052,83 @@ static const char InternedStringCacheW_data[] =
   "UI.X11\0"
 };
 
+// ============================================================================
+// [Fog::InternedStringW - Seed]
+// ============================================================================
+
+// Names which are interned by the DOM and SVG parsers, but don't need their
+// own STR_ ID. They are added to the hash at init time, so parsing of common
+// documents finds them without taking the lock.
+static const char InternedStringW_seedData[] =
+{
+  "alignment-baseline\0"
+  "baseProfile\0"
+  "baseline-shift\0"
+  "class\0"
+  "clipPathUnits\0"
+  "color-interpolation\0"
+  "color-interpolation-filters\0"
+  "color-rendering\0"
+  "desc\0"
+  "dominant-baseline\0"
+  "dur\0"
+  "feBlend\0"
+  "feColorMatrix\0"
+  "feComposite\0"
+  "feFlood\0"
+  "feGaussianBlur\0"
+  "feMerge\0"
+  "feMergeNode\0"
+  "feOffset\0"
+  "filterUnits\0"
+  "fr\0"
+  "glyph-orientation-horizontal\0"
+  "glyph-orientation-vertical\0"
+  "href\0"
+  "in\0"
+  "in2\0"
+  "isolation\0"
+  "kerning\0"
+  "lang\0"
+  "markerHeight\0"
+  "markerUnits\0"
+  "markerWidth\0"
+  "maskContentUnits\0"
+  "maskUnits\0"
+  "metadata\0"
+  "method\0"
+  "mix-blend-mode\0"
+  "mode\0"
+  "operator\0"
+  "orient\0"
+  "paint-order\0"
+  "patternContentUnits\0"
+  "pointer-events\0"
+  "primitiveUnits\0"
+  "refX\0"
+  "refY\0"
+  "requiredFeatures\0"
+  "result\0"
+  "spacing\0"
+  "startOffset\0"
+  "stdDeviation\0"
+  "switch\0"
+  "systemLanguage\0"
+  "text-anchor\0"
+  "title\0"
+  "type\0"
+  "unicode-bidi\0"
+  "values\0"
+  "vector-effect\0"
+  "writing-mode\0"
+  "xml:lang\0"
+  "xml:space\0"
+  "xmlns\0"
+  "xmlns:xlink\0"
+};
+
+static InternedStringCacheW* InternedStringW_seed;
+
 // ============================================================================
 // [Init / Fini]
 // ============================================================================
@@ -983,7 +1164,6 @@ FOG_NO_EXPORT void InternedString_init(void)
   InternedStringW_oEmpty->_string->_d = fog_api.stringw_oEmpty->_d;
   fog_api.internedstringw_oEmpty = &InternedStringW_oEmpty;
 
-  InternedStringW_lock.init();
   InternedStringW_hash.init();
 
   MemMgr::registerCleanupFunc(InternedStringW_cleanupFunc, NULL);
@@ -992,6 +1172,11 @@ FOG_NO_EXPORT void InternedString_init(void)
     InternedStringCacheW_data,
     FOG_ARRAY_SIZE(InternedStringCacheW_data),
     STR_COUNT);
+
+  InternedStringW_seed = InternedStringCacheW::create(
+    InternedStringW_seedData,
+    FOG_ARRAY_SIZE(InternedStringW_seedData),
+    DETECT_LENGTH);
 }
 
 FOG_NO_EXPORT void InternedString_fini(void)
@@ -999,9 +1184,9 @@ FOG_NO_EXPORT void InternedString_fini(void)
   MemMgr::unregisterCleanupFunc(InternedStringW_cleanupFunc, NULL);
 
   InternedStringW_hash.destroy();
-  InternedStringW_lock.destroy();
 
   fog_api.internedstringcachew_oInstance = NULL;
+  InternedStringW_seed = NULL;
 }
 
 } // Fog namespace
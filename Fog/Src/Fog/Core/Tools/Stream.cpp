@@ -518,7 +518,7 @@ int64_t FdStreamDevice::seek(int64_t offset, int whence)
 
 int64_t FdStreamDevice::tell() const
 {
-  int64_t result = ::lseek64(fd, 0, SEEK_SET);
+  int64_t result = ::lseek64(fd, 0, SEEK_CUR);
 
   if (result < FOG_INT64_C(0))
     return -1;
@@ -1570,6 +1570,14 @@ static err_t FOG_CDECL StringW_opDoubleEx(StringW* self, uint32_t cntOp, double
     sign = locale->getChar(LOCALE_CHAR_SPACE);
   }
 
+  if (!sign.isNull())
+  {
+    CharW* p = self->_add(1);
+    if (FOG_IS_NULL(p))
+      return ERR_RT_OUT_OF_MEMORY;
+    *p = sign;
+  }
+
   // --------------------------------------------------------------------------
   // [Form - Decimal]
   // --------------------------------------------------------------------------
@@ -1701,6 +1709,92 @@ _ExponentialForm:
     self->_modified(p);
   }
 
+  // --------------------------------------------------------------------------
+  // [Form - Shortest]
+  // --------------------------------------------------------------------------
+
+  else if (form == DF_SHORTEST || form == DF_SHORTEST_FLOAT)
+  {
+    if (form == DF_SHORTEST_FLOAT)
+      StringUtil::ftoa(&ctx, float(d), 0, 0);
+    else
+      StringUtil::dtoa(&ctx, d, 0, 0);
+
+    int32_t decpt = ctx.decpt;
+    if (decpt == 9999)
+      goto _InfOrNaN;
+
+    // Reserve some space for the number, we need up to 20 zeros when the
+    // decimal notation is used (decimal point in (-6, 21] like JavaScript's
+    // Number.toString()), otherwise we need X.{DIGITS}e+123.
+    CharW* p = self->_add(ctx.length + 24);
+    if (FOG_IS_NULL(p))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    uint8_t* bufCur = reinterpret_cast<uint8_t*>(ctx.result);
+    uint8_t* bufEnd = bufCur + ctx.length;
+
+    if (decpt > -6 && decpt <= 21)
+    {
+      if (decpt <= 0)
+        *p++ = zero + CharW('0');
+
+      while (bufCur != bufEnd && decpt > 0)
+      {
+        *p++ = zero + CharW(*bufCur++);
+        decpt--;
+      }
+
+      // Even if not in buffer.
+      while (decpt > 0)
+      {
+        *p++ = zero + CharW('0');
+        decpt--;
+      }
+
+      if (bufCur != bufEnd)
+      {
+        *p++ = locale->getChar(LOCALE_CHAR_DECIMAL_POINT);
+
+        while (decpt < 0)
+        {
+          *p++ = zero + CharW('0');
+          decpt++;
+        }
+
+        while (bufCur != bufEnd)
+          *p++ = zero + CharW(*bufCur++);
+      }
+    }
+    else
+    {
+      *p++ = zero + CharW(*bufCur++);
+
+      if (bufCur != bufEnd)
+      {
+        *p++ = locale->getChar(LOCALE_CHAR_DECIMAL_POINT);
+        while (bufCur != bufEnd)
+          *p++ = zero + CharW(*bufCur++);
+      }
+
+      *p++ = locale->getChar(LOCALE_CHAR_EXPONENTIAL);
+
+      if (--decpt < 0)
+      {
+        *p++ = locale->getChar(LOCALE_CHAR_MINUS);
+        decpt = -decpt;
+      }
+      else
+      {
+        *p++ = locale->getChar(LOCALE_CHAR_PLUS);
+      }
+
+      p = StringT_appendExponent(p, (uint)decpt, zero + CharW('0'));
+    }
+
+    self->_modified(p);
+  }
+
   // --------------------------------------------------------------------------
   // [Form - Significant Digits]
   // --------------------------------------------------------------------------
@@ -1791,12 +1885,10 @@ _ExponentialForm:
 
 _InfOrNaN:
   {
-    CharW* p = self->_add(ctx.length + (!sign.isNull()));
+    CharW* p = self->_add(ctx.length);
     if (FOG_IS_NULL(p))
       return ERR_RT_OUT_OF_MEMORY;
 
-    if (!sign.isNull())
-      *p++ = sign;
     StringT_chcopy(p, (const char*)ctx.result, ctx.length);
   }
 
@@ -1958,6 +2050,13 @@ static err_t FOG_CDECL StringT_opVFormatPrivate(CharT_(String)* self, uint32_t c
 
       if (c == CharT('.'))
       {
+        if (++fmt == fmtEnd)
+          goto _End;
+        c = *fmt;
+
+        // "%.f" means zero precision.
+        precision = 0;
+
         if (CharT_Func::isAsciiDigit(c))
         {
           _FOG_VFORMAT_PARSE_NUMBER(precision);
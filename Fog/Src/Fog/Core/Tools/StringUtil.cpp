@@ -9,6 +9,7 @@
 #include <Fog/Core/Global/Private.h>
 #include <Fog/Core/Tools/Char.h>
 #include <Fog/Core/Tools/CharData.h>
+#include <Fog/Core/Tools/Cpu.h>
 #include <Fog/Core/Tools/String.h>
 #include <Fog/Core/Tools/StringUtil.h>
 
@@ -55,6 +56,40 @@ static void FOG_CDECL StringUtil_unicodeFromLatin(CharW* dst, const char* src, s
     dst[i] = src[i];
 }
 
+// ============================================================================
+// [Fog::StringUtil - AsciiFromUnicode / UnicodeFromAscii]
+// ============================================================================
+
+static size_t FOG_CDECL StringUtil_asciiFromUnicode(char* dst, const CharW* src, size_t length)
+{
+  size_t i;
+
+  for (i = 0; i < length; i++)
+  {
+    uint16_t uc = src[i];
+    if (uc >= 0x80)
+      break;
+    dst[i] = (char)(uint8_t)uc;
+  }
+
+  return i;
+}
+
+static size_t FOG_CDECL StringUtil_unicodeFromAscii(CharW* dst, const char* src, size_t length)
+{
+  size_t i;
+
+  for (i = 0; i < length; i++)
+  {
+    uint8_t c = (uint8_t)src[i];
+    if (c >= 0x80)
+      break;
+    dst[i] = c;
+  }
+
+  return i;
+}
+
 // ============================================================================
 // [Fog::StringUtil - Move]
 // ============================================================================
@@ -167,7 +202,7 @@ static bool FOG_CDECL StringUtil_eqMixed_cs(const CharW* a, const char* b, size_
 {
   for (size_t i = 0; i < length; i++)
   {
-    if (a[i] != b[i])
+    if (a[i].getValue() != (uint8_t)b[i])
       return false;
   }
   return true;
@@ -2288,6 +2323,8 @@ static err_t FOG_CDECL StringUtil_parseU64(uint64_t* dst, const CharT* src, size
 // [Init / Fini]
 // ============================================================================
 
+FOG_CPU_DECLARE_INITIALIZER_SSE2( StringUtil_init_SSE2(void) )
+
 FOG_NO_EXPORT void StringUtil_init(void)
 {
   fog_api.stringutil_copyA = StringUtil_copy<char>;
@@ -2296,6 +2333,9 @@ FOG_NO_EXPORT void StringUtil_init(void)
   fog_api.stringutil_latinFromUnicode = StringUtil_latinFromUnicode;
   fog_api.stringutil_unicodeFromLatin = StringUtil_unicodeFromLatin;
 
+  fog_api.stringutil_asciiFromUnicode = StringUtil_asciiFromUnicode;
+  fog_api.stringutil_unicodeFromAscii = StringUtil_unicodeFromAscii;
+
   fog_api.stringutil_moveA = StringUtil_move<char>;
   fog_api.stringutil_moveW = StringUtil_move<CharW>;
 
@@ -2406,6 +2446,12 @@ FOG_NO_EXPORT void StringUtil_init(void)
 
   fog_api.stringutil_parseU64A = StringUtil_parseU64<char>;
   fog_api.stringutil_parseU64W = StringUtil_parseU64<CharW>;
+
+  // --------------------------------------------------------------------------
+  // [CPU Based Optimizations]
+  // --------------------------------------------------------------------------
+
+  FOG_CPU_USE_INITIALIZER_SSE2( StringUtil_init_SSE2() )
 }
 
 } // Fog namespace
@@ -22,7 +22,7 @@ namespace Fog {
 
 struct NTOAContext
 {
-  //! @brief Output (pointer to non-null terminated string in @c buffer).
+  //! @brief Output (pointer to null terminated string in @c buffer).
   char* result;
   //! @brief Output length.
   uint32_t length;
@@ -103,6 +103,28 @@ static FOG_INLINE err_t latinFromUnicode(uchar* dst, const uint16_t* src, size_t
   return fog_api.stringutil_latinFromUnicode(reinterpret_cast<char*>(dst), reinterpret_cast<const CharW*>(src), length);
 }
 
+// ============================================================================
+// [Fog::StringUtil - UnicodeFromAscii / AsciiFromUnicode]
+// ============================================================================
+
+//! @brief Convert the leading ASCII characters of @a src to UTF-16.
+//!
+//! The conversion stops at the first character which is not ASCII, the
+//! count of converted characters is returned.
+static FOG_INLINE size_t unicodeFromAscii(CharW* dst, const char* src, size_t length)
+{
+  return fog_api.stringutil_unicodeFromAscii(dst, src, length);
+}
+
+//! @brief Convert the leading ASCII characters of @a src to 8-bit string.
+//!
+//! The conversion stops at the first character which is not ASCII, the
+//! count of converted characters is returned.
+static FOG_INLINE size_t asciiFromUnicode(char* dst, const CharW* src, size_t length)
+{
+  return fog_api.stringutil_asciiFromUnicode(dst, src, length);
+}
+
 // ============================================================================
 // [Fog::StringUtil - Move]
 // ============================================================================
@@ -580,7 +602,7 @@ static FOG_INLINE void utoa(NTOAContext* ctx, uint64_t n, uint32_t base, uint32_
 
 static FOG_INLINE void ftoa(NTOAContext* ctx, float d, uint32_t form, int nDigits)
 {
-  return fog_api.stringutil_dtoa(ctx, double(d), form, nDigits);
+  return fog_api.stringutil_ftoa(ctx, d, form, nDigits);
 }
 
 static FOG_INLINE void dtoa(NTOAContext* ctx, double d, uint32_t form, int nDigits)
@@ -0,0 +1,1128 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Acc/AccSse2.h>
+#include <Fog/Core/Global/Private.h>
+#include <Fog/Core/Tools/Char.h>
+#include <Fog/Core/Tools/CharData.h>
+#include <Fog/Core/Tools/Cpu.h>
+#include <Fog/Core/Tools/StringUtil.h>
+
+#if defined(FOG_CC_MSC)
+# include <intrin.h>
+#endif // FOG_CC_MSC
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::StringUtil - Helpers]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Get index of the lowest bit set in @a mask (must be non-zero).
+static FOG_INLINE uint32_t StringUtil_bitScanForward(uint32_t mask)
+{
+  FOG_ASSERT(mask != 0);
+
+#if defined(FOG_CC_GNU) || defined(FOG_CC_CLANG)
+  return (uint32_t)__builtin_ctz(mask);
+#elif defined(FOG_CC_MSC)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return (uint32_t)index;
+#else
+  uint32_t index = 0;
+  while ((mask & 0x1) == 0)
+  {
+    mask >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
+
+//! @internal
+//!
+//! @brief Get index of the highest bit set in @a mask (must be non-zero).
+static FOG_INLINE uint32_t StringUtil_bitScanReverse(uint32_t mask)
+{
+  FOG_ASSERT(mask != 0);
+
+#if defined(FOG_CC_GNU) || defined(FOG_CC_CLANG)
+  return 31 - (uint32_t)__builtin_clz(mask);
+#elif defined(FOG_CC_MSC)
+  unsigned long index;
+  _BitScanReverse(&index, mask);
+  return (uint32_t)index;
+#else
+  uint32_t index = 31;
+  while ((mask & 0x80000000U) == 0)
+  {
+    mask <<= 1;
+    index--;
+  }
+  return index;
+#endif
+}
+
+//! @internal
+//!
+//! @brief Fill all bytes of @a dst0 by @a c.
+static FOG_INLINE void StringUtil_expandPI8(__m128i& dst0, uint8_t c)
+{
+  Acc::m128iCvtSI128FromSI(dst0, (int)c);
+  Acc::m128iExpandPI8FromSI8(dst0, dst0);
+}
+
+//! @internal
+//!
+//! @brief Fill all words of @a dst0 by @a c.
+static FOG_INLINE void StringUtil_expandPI16(__m128i& dst0, uint16_t c)
+{
+  Acc::m128iCvtSI128FromSI(dst0, (int)c);
+  Acc::m128iExpandPI16FromSI16(dst0, dst0);
+}
+
+//! @internal
+//!
+//! @brief Convert ASCII upper-case letters in @a x0 to lower-case.
+//!
+//! The 'A'...'Z' range is moved to the bottom of the signed byte range, so a
+//! single signed compare is enough to get the mask of letters to convert.
+static FOG_INLINE void StringUtil_toLowerPI8(__m128i& dst0, const __m128i& x0)
+{
+  __m128i t0;
+  __m128i c0;
+
+  StringUtil_expandPI8(c0, (uint8_t)(0x80 - 'A'));
+  Acc::m128iAddPI8(t0, x0, c0);
+
+  StringUtil_expandPI8(c0, (uint8_t)(0x80 + 26));
+  Acc::m128iCmpLtPI8(t0, t0, c0);
+
+  StringUtil_expandPI8(c0, 0x20);
+  Acc::m128iAnd(t0, t0, c0);
+  Acc::m128iOr(dst0, x0, t0);
+}
+
+// ============================================================================
+// [Fog::StringUtil - LatinFromUnicode / UnicodeFromLatin]
+// ============================================================================
+
+static err_t FOG_CDECL StringUtil_latinFromUnicode_SSE2(char* dst, const CharW* src, size_t length)
+{
+  err_t err = ERR_OK;
+  size_t i = length;
+
+  while (i >= 16)
+  {
+    __m128i xmm0, xmm1;
+    __m128i xmmHi;
+    __m128i xmmZero;
+    int msk;
+
+    Acc::m128iLoad16u(xmm0, src + 0);
+    Acc::m128iLoad16u(xmm1, src + 8);
+
+    // Characters above 255 have non-zero high byte.
+    Acc::m128iOr(xmmHi, xmm0, xmm1);
+    Acc::m128iRShiftPU16<8>(xmmHi, xmmHi);
+    Acc::m128iZero(xmmZero);
+    Acc::m128iCmpEqPI16(xmmHi, xmmHi, xmmZero);
+    Acc::m128iMoveMaskPI8(msk, xmmHi);
+
+    if (FOG_UNLIKELY(msk != 0xFFFF))
+    {
+      for (size_t j = 0; j < 16; j++)
+      {
+        uint16_t uc = src[j];
+
+        if (uc > 255)
+        {
+          uc = '?';
+          err = ERR_STRING_LOST;
+        }
+
+        dst[j] = (uint8_t)uc;
+      }
+    }
+    else
+    {
+      Acc::m128iPackPU8FromPU16(xmm0, xmm0, xmm1);
+      Acc::m128iStore16u(dst, xmm0);
+    }
+
+    dst += 16;
+    src += 16;
+    i -= 16;
+  }
+
+  while (i)
+  {
+    uint16_t uc = src[0];
+
+    if (uc > 255)
+    {
+      uc = '?';
+      err = ERR_STRING_LOST;
+    }
+
+    dst[0] = (uint8_t)uc;
+
+    dst++;
+    src++;
+    i--;
+  }
+
+  return err;
+}
+
+static void FOG_CDECL StringUtil_unicodeFromLatin_SSE2(CharW* dst, const char* src, size_t length)
+{
+  size_t i = length;
+
+  while (i >= 16)
+  {
+    __m128i xmm0, xmm1;
+
+    Acc::m128iLoad16u(xmm0, src);
+    Acc::m128iUnpackPI16FromPI8Hi(xmm1, xmm0);
+    Acc::m128iUnpackPI16FromPI8Lo(xmm0, xmm0);
+
+    Acc::m128iStore16u(dst + 0, xmm0);
+    Acc::m128iStore16u(dst + 8, xmm1);
+
+    dst += 16;
+    src += 16;
+    i -= 16;
+  }
+
+  while (i)
+  {
+    dst[0] = (uint8_t)src[0];
+
+    dst++;
+    src++;
+    i--;
+  }
+}
+
+// ============================================================================
+// [Fog::StringUtil - AsciiFromUnicode / UnicodeFromAscii]
+// ============================================================================
+
+static size_t FOG_CDECL StringUtil_asciiFromUnicode_SSE2(char* dst, const CharW* src, size_t length)
+{
+  size_t i = length;
+
+  while (i >= 16)
+  {
+    __m128i xmm0, xmm1;
+    __m128i xmmHi;
+    __m128i xmmMask;
+    int msk;
+
+    Acc::m128iLoad16u(xmm0, src + 0);
+    Acc::m128iLoad16u(xmm1, src + 8);
+
+    Acc::m128iOr(xmmHi, xmm0, xmm1);
+    StringUtil_expandPI16(xmmMask, 0xFF80);
+    Acc::m128iAnd(xmmHi, xmmHi, xmmMask);
+    Acc::m128iZero(xmmMask);
+    Acc::m128iCmpEqPI16(xmmHi, xmmHi, xmmMask);
+    Acc::m128iMoveMaskPI8(msk, xmmHi);
+
+    // The rest is converted by the scalar loop which stops at the first
+    // non-ASCII character.
+    if (msk != 0xFFFF)
+      break;
+
+    Acc::m128iPackPU8FromPU16(xmm0, xmm0, xmm1);
+    Acc::m128iStore16u(dst, xmm0);
+
+    dst += 16;
+    src += 16;
+    i -= 16;
+  }
+
+  while (i)
+  {
+    uint16_t uc = src[0];
+    if (uc >= 0x80)
+      break;
+    dst[0] = (char)(uint8_t)uc;
+
+    dst++;
+    src++;
+    i--;
+  }
+
+  return length - i;
+}
+
+static size_t FOG_CDECL StringUtil_unicodeFromAscii_SSE2(CharW* dst, const char* src, size_t length)
+{
+  size_t i = length;
+
+  while (i >= 16)
+  {
+    __m128i xmm0, xmm1;
+    int msk;
+
+    Acc::m128iLoad16u(xmm0, src);
+    Acc::m128iMoveMaskPI8(msk, xmm0);
+
+    if (msk != 0)
+    {
+      size_t n = StringUtil_bitScanForward((uint32_t)msk);
+
+      for (size_t j = 0; j < n; j++)
+        dst[j] = (uint8_t)src[j];
+
+      return length - i + n;
+    }
+
+    Acc::m128iUnpackPI16FromPI8Hi(xmm1, xmm0);
+    Acc::m128iUnpackPI16FromPI8Lo(xmm0, xmm0);
+
+    Acc::m128iStore16u(dst + 0, xmm0);
+    Acc::m128iStore16u(dst + 8, xmm1);
+
+    dst += 16;
+    src += 16;
+    i -= 16;
+  }
+
+  while (i)
+  {
+    uint8_t c = (uint8_t)src[0];
+    if (c >= 0x80)
+      break;
+    dst[0] = c;
+
+    dst++;
+    src++;
+    i--;
+  }
+
+  return length - i;
+}
+
+// ============================================================================
+// [Fog::StringUtil - Equality]
+// ============================================================================
+
+static bool FOG_CDECL StringUtil_eqA_cs_SSE2(const char* a, const char* b, size_t length)
+{
+  size_t i = length;
+
+  while (i >= 16)
+  {
+    __m128i xmm0, xmm1;
+    int msk;
+
+    Acc::m128iLoad16u(xmm0, a);
+    Acc::m128iLoad16u(xmm1, b);
+    Acc::m128iCmpEqPI8(xmm0, xmm0, xmm1);
+    Acc::m128iMoveMaskPI8(msk, xmm0);
+
+    if (msk != 0xFFFF)
+      return false;
+
+    a += 16;
+    b += 16;
+    i -= 16;
+  }
+
+  while (i)
+  {
+    if (a[0] != b[0])
+      return false;
+
+    a++;
+    b++;
+    i--;
+  }
+
+  return true;
+}
+
+static bool FOG_CDECL StringUtil_eqA_ci_SSE2(const char* a, const char* b, size_t length)
+{
+  size_t i = length;
+
+  while (i >= 16)
+  {
+    __m128i xmm0, xmm1;
+    int msk;
+
+    Acc::m128iLoad16u(xmm0, a);
+    Acc::m128iLoad16u(xmm1, b);
+
+    StringUtil_toLowerPI8(xmm0, xmm0);
+    StringUtil_toLowerPI8(xmm1, xmm1);
+
+    Acc::m128iCmpEqPI8(xmm0, xmm0, xmm1);
+    Acc::m128iMoveMaskPI8(msk, xmm0);
+
+    if (msk != 0xFFFF)
+      return false;
+
+    a += 16;
+    b += 16;
+    i -= 16;
+  }
+
+  while (i)
+  {
+    if (CharA::toLower(a[0]) != CharA::toLower(b[0]))
+      return false;
+
+    a++;
+    b++;
+    i--;
+  }
+
+  return true;
+}
+
+static bool FOG_CDECL StringUtil_eqW_cs_SSE2(const CharW* a, const CharW* b, size_t length)
+{
+  size_t i = length;
+
+  while (i >= 8)
+  {
+    __m128i xmm0, xmm1;
+    int msk;
+
+    Acc::m128iLoad16u(xmm0, a);
+    Acc::m128iLoad16u(xmm1, b);
+    Acc::m128iCmpEqPI16(xmm0, xmm0, xmm1);
+    Acc::m128iMoveMaskPI8(msk, xmm0);
+
+    if (msk != 0xFFFF)
+      return false;
+
+    a += 8;
+    b += 8;
+    i -= 8;
+  }
+
+  while (i)
+  {
+    if (a[0] != b[0])
+      return false;
+
+    a++;
+    b++;
+    i--;
+  }
+
+  return true;
+}
+
+// Case-insensitive comparison of UTF-16 strings can't be vectorized easily,
+// but most of the compared characters are usually equal. Blocks of equal
+// characters are skipped, only the blocks which differ are compared by the
+// Unicode case-folding.
+static bool FOG_CDECL StringUtil_eqW_ci_SSE2(const CharW* a, const CharW* b, size_t length)
+{
+  size_t i = length;
+
+  while (i >= 8)
+  {
+    __m128i xmm0, xmm1;
+    int msk;
+
+    Acc::m128iLoad16u(xmm0, a);
+    Acc::m128iLoad16u(xmm1, b);
+    Acc::m128iCmpEqPI16(xmm0, xmm0, xmm1);
+    Acc::m128iMoveMaskPI8(msk, xmm0);
+
+    if (msk != 0xFFFF)
+    {
+      for (size_t j = 0; j < 8; j++)
+      {
+        if (CharW::toLower(a[j]) != CharW::toLower(b[j]))
+          return false;
+      }
+    }
+
+    a += 8;
+    b += 8;
+    i -= 8;
+  }
+
+  while (i)
+  {
+    if (CharW::toLower(a[0]) != CharW::toLower(b[0]))
+      return false;
+
+    a++;
+    b++;
+    i--;
+  }
+
+  return true;
+}
+
+static bool FOG_CDECL StringUtil_eqMixed_cs_SSE2(const CharW* a, const char* b, size_t length)
+{
+  size_t i = length;
+
+  while (i >= 16)
+  {
+    __m128i xmm0, xmm1;
+    __m128i xmm2, xmm3;
+    int msk;
+
+    Acc::m128iLoad16u(xmm0, a + 0);
+    Acc::m128iLoad16u(xmm1, a + 8);
+    Acc::m128iLoad16u(xmm2, b);
+
+    Acc::m128iUnpackPI16FromPI8Hi(xmm3, xmm2);
+    Acc::m128iUnpackPI16FromPI8Lo(xmm2, xmm2);
+
+    Acc::m128iCmpEqPI16(xmm0, xmm0, xmm2);
+    Acc::m128iCmpEqPI16(xmm1, xmm1, xmm3);
+    Acc::m128iAnd(xmm0, xmm0, xmm1);
+    Acc::m128iMoveMaskPI8(msk, xmm0);
+
+    if (msk != 0xFFFF)
+      return false;
+
+    a += 16;
+    b += 16;
+    i -= 16;
+  }
+
+  while (i)
+  {
+    if (a[0].getValue() != (uint8_t)b[0])
+      return false;
+
+    a++;
+    b++;
+    i--;
+  }
+
+  return true;
+}
+
+// ============================================================================
+// [Fog::StringUtil - CountOf]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Sum the byte counters in @a xmmAcc and clear them.
+static FOG_INLINE size_t StringUtil_sumPU8(__m128i& xmmAcc)
+{
+  __m128i xmmZero;
+  int lo, hi;
+
+  Acc::m128iZero(xmmZero);
+  xmmAcc = _mm_sad_epu8(xmmAcc, xmmZero);
+
+  Acc::m128iCvtSIFromSI128(lo, xmmAcc);
+  Acc::m128iShufflePI32<2, 2, 2, 2>(xmmAcc, xmmAcc);
+  Acc::m128iCvtSIFromSI128(hi, xmmAcc);
+
+  Acc::m128iZero(xmmAcc);
+  return (size_t)(uint32_t)lo + (size_t)(uint32_t)hi;
+}
+
+static size_t FOG_CDECL StringUtil_countOfA_cs_SSE2(const char* str, size_t length, char ch)
+{
+  size_t n = 0;
+  size_t i = length;
+
+  if (i >= 16)
+  {
+    __m128i xmmCh;
+    __m128i xmmAcc;
+
+    StringUtil_expandPI8(xmmCh, (uint8_t)ch);
+    Acc::m128iZero(xmmAcc);
+
+    // Each byte of the accumulator counts matches at the same position, it
+    // must be flushed before it overflows.
+    uint32_t blocks = 0;
+
+    do {
+      __m128i xmm0;
+
+      Acc::m128iLoad16u(xmm0, str);
+      Acc::m128iCmpEqPI8(xmm0, xmm0, xmmCh);
+      Acc::m128iSubPI8(xmmAcc, xmmAcc, xmm0);
+
+      if (++blocks == 255)
+      {
+        n += StringUtil_sumPU8(xmmAcc);
+        blocks = 0;
+      }
+
+      str += 16;
+      i -= 16;
+    } while (i >= 16);
+
+    n += StringUtil_sumPU8(xmmAcc);
+  }
+
+  while (i)
+  {
+    n += (str[0] == ch);
+
+    str++;
+    i--;
+  }
+
+  return n;
+}
+
+static size_t FOG_CDECL StringUtil_countOfA_ci_SSE2(const char* str, size_t length, char ch)
+{
+  char cLower = CharA::toLower(ch);
+  char cUpper = CharA::toUpper(ch);
+
+  if (cLower == cUpper)
+    return StringUtil_countOfA_cs_SSE2(str, length, ch);
+
+  size_t n = 0;
+  size_t i = length;
+
+  if (i >= 16)
+  {
+    __m128i xmmLower;
+    __m128i xmmUpper;
+    __m128i xmmAcc;
+
+    StringUtil_expandPI8(xmmLower, (uint8_t)cLower);
+    StringUtil_expandPI8(xmmUpper, (uint8_t)cUpper);
+    Acc::m128iZero(xmmAcc);
+
+    uint32_t blocks = 0;
+
+    do {
+      __m128i xmm0, xmm1;
+
+      Acc::m128iLoad16u(xmm0, str);
+      Acc::m128iCmpEqPI8(xmm1, xmm0, xmmUpper);
+      Acc::m128iCmpEqPI8(xmm0, xmm0, xmmLower);
+      Acc::m128iOr(xmm0, xmm0, xmm1);
+      Acc::m128iSubPI8(xmmAcc, xmmAcc, xmm0);
+
+      if (++blocks == 255)
+      {
+        n += StringUtil_sumPU8(xmmAcc);
+        blocks = 0;
+      }
+
+      str += 16;
+      i -= 16;
+    } while (i >= 16);
+
+    n += StringUtil_sumPU8(xmmAcc);
+  }
+
+  while (i)
+  {
+    n += (str[0] == cLower);
+    n += (str[0] == cUpper);
+
+    str++;
+    i--;
+  }
+
+  return n;
+}
+
+static size_t FOG_CDECL StringUtil_countOfW_cs_SSE2(const CharW* str, size_t length, uint16_t ch)
+{
+  size_t n = 0;
+  size_t i = length;
+
+  if (i >= 16)
+  {
+    __m128i xmmCh;
+    __m128i xmmAcc;
+
+    StringUtil_expandPI16(xmmCh, ch);
+    Acc::m128iZero(xmmAcc);
+
+    uint32_t blocks = 0;
+
+    do {
+      __m128i xmm0, xmm1;
+
+      Acc::m128iLoad16u(xmm0, str + 0);
+      Acc::m128iLoad16u(xmm1, str + 8);
+
+      Acc::m128iCmpEqPI16(xmm0, xmm0, xmmCh);
+      Acc::m128iCmpEqPI16(xmm1, xmm1, xmmCh);
+
+      // Pack the 16-bit masks into bytes (signed saturation keeps -1 and 0).
+      Acc::m128iPackPI8FromPI16(xmm0, xmm0, xmm1);
+      Acc::m128iSubPI8(xmmAcc, xmmAcc, xmm0);
+
+      if (++blocks == 255)
+      {
+        n += StringUtil_sumPU8(xmmAcc);
+        blocks = 0;
+      }
+
+      str += 16;
+      i -= 16;
+    } while (i >= 16);
+
+    n += StringUtil_sumPU8(xmmAcc);
+  }
+
+  while (i)
+  {
+    n += (str[0] == ch);
+
+    str++;
+    i--;
+  }
+
+  return n;
+}
+
+// ============================================================================
+// [Fog::StringUtil - IndexOf]
+// ============================================================================
+
+static size_t FOG_CDECL StringUtil_indexOfCharA_cs_SSE2(const char* str, size_t length, char ch)
+{
+  const char* p = str;
+  size_t i = length;
+
+  if (i >= 16)
+  {
+    __m128i xmmCh;
+    StringUtil_expandPI8(xmmCh, (uint8_t)ch);
+
+    do {
+      __m128i xmm0;
+      int msk;
+
+      Acc::m128iLoad16u(xmm0, p);
+      Acc::m128iCmpEqPI8(xmm0, xmm0, xmmCh);
+      Acc::m128iMoveMaskPI8(msk, xmm0);
+
+      if (msk != 0)
+        return (size_t)(p - str) + StringUtil_bitScanForward((uint32_t)msk);
+
+      p += 16;
+      i -= 16;
+    } while (i >= 16);
+  }
+
+  while (i)
+  {
+    if (p[0] == ch)
+      return (size_t)(p - str);
+
+    p++;
+    i--;
+  }
+
+  return INVALID_INDEX;
+}
+
+static size_t FOG_CDECL StringUtil_indexOfCharA_ci_SSE2(const char* str, size_t length, char ch)
+{
+  char cLower = CharA::toLower(ch);
+  char cUpper = CharA::toUpper(ch);
+
+  if (cLower == cUpper)
+    return StringUtil_indexOfCharA_cs_SSE2(str, length, ch);
+
+  const char* p = str;
+  size_t i = length;
+
+  if (i >= 16)
+  {
+    __m128i xmmLower;
+    __m128i xmmUpper;
+
+    StringUtil_expandPI8(xmmLower, (uint8_t)cLower);
+    StringUtil_expandPI8(xmmUpper, (uint8_t)cUpper);
+
+    do {
+      __m128i xmm0, xmm1;
+      int msk;
+
+      Acc::m128iLoad16u(xmm0, p);
+      Acc::m128iCmpEqPI8(xmm1, xmm0, xmmUpper);
+      Acc::m128iCmpEqPI8(xmm0, xmm0, xmmLower);
+      Acc::m128iOr(xmm0, xmm0, xmm1);
+      Acc::m128iMoveMaskPI8(msk, xmm0);
+
+      if (msk != 0)
+        return (size_t)(p - str) + StringUtil_bitScanForward((uint32_t)msk);
+
+      p += 16;
+      i -= 16;
+    } while (i >= 16);
+  }
+
+  while (i)
+  {
+    if (p[0] == cLower || p[0] == cUpper)
+      return (size_t)(p - str);
+
+    p++;
+    i--;
+  }
+
+  return INVALID_INDEX;
+}
+
+static size_t FOG_CDECL StringUtil_indexOfCharW_cs_SSE2(const CharW* str, size_t length, uint16_t ch)
+{
+  const CharW* p = str;
+  size_t i = length;
+
+  if (i >= 8)
+  {
+    __m128i xmmCh;
+    StringUtil_expandPI16(xmmCh, ch);
+
+    do {
+      __m128i xmm0;
+      int msk;
+
+      Acc::m128iLoad16u(xmm0, p);
+      Acc::m128iCmpEqPI16(xmm0, xmm0, xmmCh);
+      Acc::m128iMoveMaskPI8(msk, xmm0);
+
+      if (msk != 0)
+        return (size_t)(p - str) + (StringUtil_bitScanForward((uint32_t)msk) >> 1);
+
+      p += 8;
+      i -= 8;
+    } while (i >= 8);
+  }
+
+  while (i)
+  {
+    if (p[0] == ch)
+      return (size_t)(p - str);
+
+    p++;
+    i--;
+  }
+
+  return INVALID_INDEX;
+}
+
+static size_t FOG_CDECL StringUtil_indexOfCharW_ci_SSE2(const CharW* str, size_t length, uint16_t ch)
+{
+  uint16_t cLower = CharW::toLower(ch);
+  uint16_t cUpper = CharW::toUpper(ch);
+
+  if (cLower == cUpper)
+    return StringUtil_indexOfCharW_cs_SSE2(str, length, ch);
+
+  // If there is no title-case form, the upper-case form is used instead, it
+  // doesn't change the result.
+  uint16_t cTitle = CharW::toTitle(cUpper);
+
+  const CharW* p = str;
+  size_t i = length;
+
+  if (i >= 8)
+  {
+    __m128i xmmLower;
+    __m128i xmmUpper;
+    __m128i xmmTitle;
+
+    StringUtil_expandPI16(xmmLower, cLower);
+    StringUtil_expandPI16(xmmUpper, cUpper);
+    StringUtil_expandPI16(xmmTitle, cTitle);
+
+    do {
+      __m128i xmm0, xmm1, xmm2;
+      int msk;
+
+      Acc::m128iLoad16u(xmm0, p);
+      Acc::m128iCmpEqPI16(xmm1, xmm0, xmmUpper);
+      Acc::m128iCmpEqPI16(xmm2, xmm0, xmmTitle);
+      Acc::m128iCmpEqPI16(xmm0, xmm0, xmmLower);
+      Acc::m128iOr(xmm1, xmm1, xmm2);
+      Acc::m128iOr(xmm0, xmm0, xmm1);
+      Acc::m128iMoveMaskPI8(msk, xmm0);
+
+      if (msk != 0)
+        return (size_t)(p - str) + (StringUtil_bitScanForward((uint32_t)msk) >> 1);
+
+      p += 8;
+      i -= 8;
+    } while (i >= 8);
+  }
+
+  while (i)
+  {
+    if (p[0] == cLower || p[0] == cUpper || p[0] == cTitle)
+      return (size_t)(p - str);
+
+    p++;
+    i--;
+  }
+
+  return INVALID_INDEX;
+}
+
+// ============================================================================
+// [Fog::StringUtil - LastIndexOf]
+// ============================================================================
+
+static size_t FOG_CDECL StringUtil_lastIndexOfCharA_cs_SSE2(const char* str, size_t length, char ch)
+{
+  const char* p = str + length;
+  size_t i = length;
+
+  if (i >= 16)
+  {
+    __m128i xmmCh;
+    StringUtil_expandPI8(xmmCh, (uint8_t)ch);
+
+    do {
+      __m128i xmm0;
+      int msk;
+
+      p -= 16;
+      i -= 16;
+
+      Acc::m128iLoad16u(xmm0, p);
+      Acc::m128iCmpEqPI8(xmm0, xmm0, xmmCh);
+      Acc::m128iMoveMaskPI8(msk, xmm0);
+
+      if (msk != 0)
+        return (size_t)(p - str) + StringUtil_bitScanReverse((uint32_t)msk);
+    } while (i >= 16);
+  }
+
+  while (i)
+  {
+    p--;
+    i--;
+
+    if (p[0] == ch)
+      return i;
+  }
+
+  return INVALID_INDEX;
+}
+
+static size_t FOG_CDECL StringUtil_lastIndexOfCharW_cs_SSE2(const CharW* str, size_t length, uint16_t ch)
+{
+  const CharW* p = str + length;
+  size_t i = length;
+
+  if (i >= 8)
+  {
+    __m128i xmmCh;
+    StringUtil_expandPI16(xmmCh, ch);
+
+    do {
+      __m128i xmm0;
+      int msk;
+
+      p -= 8;
+      i -= 8;
+
+      Acc::m128iLoad16u(xmm0, p);
+      Acc::m128iCmpEqPI16(xmm0, xmm0, xmmCh);
+      Acc::m128iMoveMaskPI8(msk, xmm0);
+
+      if (msk != 0)
+        return (size_t)(p - str) + (StringUtil_bitScanReverse((uint32_t)msk) >> 1);
+    } while (i >= 8);
+  }
+
+  while (i)
+  {
+    p--;
+    i--;
+
+    if (p[0] == ch)
+      return i;
+  }
+
+  return INVALID_INDEX;
+}
+
+// ============================================================================
+// [Fog::StringUtil - ValidateUtf8]
+// ============================================================================
+
+// UTF-8 validation and length calculation skip blocks of ASCII characters,
+// everything else is handled exactly as in the generic C implementation.
+static err_t FOG_CDECL StringUtil_validateUtf8_SSE2(const char* data, size_t length, size_t* invalid)
+{
+  err_t err = ERR_OK;
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+  size_t remain = length;
+
+  while (remain)
+  {
+    if (remain >= 16)
+    {
+      __m128i xmm0;
+      int msk;
+
+      Acc::m128iLoad16u(xmm0, p);
+      Acc::m128iMoveMaskPI8(msk, xmm0);
+
+      if (msk == 0)
+      {
+        p += 16;
+        remain -= 16;
+        continue;
+      }
+
+      size_t n = StringUtil_bitScanForward((uint32_t)msk);
+      p += n;
+      remain -= n;
+    }
+
+    uint8_t c = p[0];
+    size_t cLength = Unicode::utf8GetSize(c);
+
+    if (!cLength)
+    {
+      err = ERR_STRING_INVALID_UTF8;
+      break;
+    }
+
+    if (remain < cLength)
+    {
+      err = ERR_STRING_TRUNCATED;
+      break;
+    }
+
+    p += cLength;
+    remain -= cLength;
+  }
+
+  if (invalid)
+    *invalid = (size_t)(p - reinterpret_cast<const uint8_t*>(data));
+  return err;
+}
+
+// ============================================================================
+// [Fog::StringUtil - UcsFromUtf8Length]
+// ============================================================================
+
+static err_t FOG_CDECL StringUtil_ucsFromUtf8Length_SSE2(const char* data, size_t length, size_t* ucsLength)
+{
+  err_t err = ERR_OK;
+  size_t num = 0;
+
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+  size_t remain = length;
+
+  while (remain)
+  {
+    if (remain >= 16)
+    {
+      __m128i xmm0;
+      int msk;
+
+      Acc::m128iLoad16u(xmm0, p);
+      Acc::m128iMoveMaskPI8(msk, xmm0);
+
+      if (msk == 0)
+      {
+        p += 16;
+        remain -= 16;
+        num += 16;
+        continue;
+      }
+
+      size_t n = StringUtil_bitScanForward((uint32_t)msk);
+      p += n;
+      remain -= n;
+      num += n;
+    }
+
+    uint8_t c = p[0];
+    size_t cLength = Unicode::utf8GetSize(c);
+
+    if (!cLength)
+    {
+      err = ERR_STRING_INVALID_UTF8;
+      break;
+    }
+
+    if (remain < cLength)
+    {
+      err = ERR_STRING_TRUNCATED;
+      break;
+    }
+
+    p += cLength;
+    remain -= cLength;
+    num++;
+  }
+
+  if (ucsLength)
+    *ucsLength = num;
+  return err;
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void StringUtil_init_SSE2(void)
+{
+  // --------------------------------------------------------------------------
+  // [Funcs]
+  // --------------------------------------------------------------------------
+
+  fog_api.stringutil_latinFromUnicode = StringUtil_latinFromUnicode_SSE2;
+  fog_api.stringutil_unicodeFromLatin = StringUtil_unicodeFromLatin_SSE2;
+
+  fog_api.stringutil_asciiFromUnicode = StringUtil_asciiFromUnicode_SSE2;
+  fog_api.stringutil_unicodeFromAscii = StringUtil_unicodeFromAscii_SSE2;
+
+  fog_api.stringutil_eqA[CASE_SENSITIVE  ] = StringUtil_eqA_cs_SSE2;
+  fog_api.stringutil_eqA[CASE_INSENSITIVE] = StringUtil_eqA_ci_SSE2;
+
+  fog_api.stringutil_eqW[CASE_SENSITIVE  ] = StringUtil_eqW_cs_SSE2;
+  fog_api.stringutil_eqW[CASE_INSENSITIVE] = StringUtil_eqW_ci_SSE2;
+
+  fog_api.stringutil_eqMixed[CASE_SENSITIVE  ] = StringUtil_eqMixed_cs_SSE2;
+
+  fog_api.stringutil_countOfA[CASE_SENSITIVE  ] = StringUtil_countOfA_cs_SSE2;
+  fog_api.stringutil_countOfA[CASE_INSENSITIVE] = StringUtil_countOfA_ci_SSE2;
+
+  fog_api.stringutil_countOfW[CASE_SENSITIVE  ] = StringUtil_countOfW_cs_SSE2;
+
+  fog_api.stringutil_indexOfCharA[CASE_SENSITIVE  ] = StringUtil_indexOfCharA_cs_SSE2;
+  fog_api.stringutil_indexOfCharA[CASE_INSENSITIVE] = StringUtil_indexOfCharA_ci_SSE2;
+
+  fog_api.stringutil_indexOfCharW[CASE_SENSITIVE  ] = StringUtil_indexOfCharW_cs_SSE2;
+  fog_api.stringutil_indexOfCharW[CASE_INSENSITIVE] = StringUtil_indexOfCharW_ci_SSE2;
+
+  fog_api.stringutil_lastIndexOfCharA[CASE_SENSITIVE  ] = StringUtil_lastIndexOfCharA_cs_SSE2;
+  fog_api.stringutil_lastIndexOfCharW[CASE_SENSITIVE  ] = StringUtil_lastIndexOfCharW_cs_SSE2;
+
+  fog_api.stringutil_validateUtf8 = StringUtil_validateUtf8_SSE2;
+  fog_api.stringutil_ucsFromUtf8Length = StringUtil_ucsFromUtf8Length_SSE2;
+}
+
+} // Fog namespace
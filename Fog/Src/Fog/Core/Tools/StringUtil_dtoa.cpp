@@ -14,6 +14,7 @@
 #include <Fog/Core/Tools/CharData.h>
 #include <Fog/Core/Tools/String.h>
 #include <Fog/Core/Tools/StringUtil.h>
+#include <Fog/Core/Tools/StringUtil_dtoaTables_p.h>
 
 // [Dependencies - C]
 #include <errno.h>
@@ -1405,7 +1406,7 @@ static void FOG_CDECL StringUtil_dtoa(NTOAContext* ctx, double _d, uint32_t mode
 
     i = bbits + be + (Bias + (P-1) - 1);
     x = (i > 32)
-      ? (d.u32Hi << (64 - i)) | (d.u32Hi >> (i - 32))
+      ? (d.u32Hi << (64 - i)) | (d.u32Lo >> (i - 32))
       : (d.u32Lo << (32 - i));
     d2.d = x;
     d2.u32Hi -= 31 * Exp_msk1; // adjust exponent
@@ -1998,10 +1999,544 @@ _Ret:
   FOG_CONTROL87_END();
 }
 
+// ============================================================================
+// [Fog::StringUtil - dtoa (Grisu)]
+// ============================================================================
+
+// Grisu3 algorithm by Florian Loitsch, "Printing Floating-Point Numbers
+// Quickly and Accurately with Integers" (PLDI 2010), ported from the
+// double-conversion library (BSD license, Copyright 2010 the V8 project
+// authors).
+//
+// Grisu generates the shortest (mode 0) or the requested count of digits
+// (modes 2 and 3) using only 64-bit integer arithmetic and a table of cached
+// powers of ten. It can't always decide whether the generated digits are
+// correct (about 0.5% of doubles), in such case it reports failure and the
+// caller falls back to the StringUtil_dtoa() above, which is always exact.
+
+//! @internal
+//!
+//! @brief "Do it yourself floating point" - 64-bit significand and binary
+//! exponent, value is @c f * 2^e.
+struct StringUtil_DiyFp
+{
+  uint64_t f;
+  int e;
+};
+
+//! @internal
+//!
+//! @brief Count leading zeros of @a x (must be non-zero).
+static FOG_INLINE int StringUtil_clz64(uint64_t x)
+{
+  FOG_ASSERT(x != 0);
+
+#if defined(FOG_CC_GNU) || defined(FOG_CC_CLANG)
+  return __builtin_clzll(x);
+#else
+  int n = 0;
+  while ((x & FOG_UINT64_C(0xFF00000000000000)) == 0) { x <<= 8; n += 8; }
+  while ((x & FOG_UINT64_C(0x8000000000000000)) == 0) { x <<= 1; n += 1; }
+  return n;
+#endif
+}
+
+//! @internal
+//!
+//! @brief Full 64x64 -> 128-bit multiplication, returns the low 64 bits and
+//! stores the high 64 bits to @a hi.
+static FOG_INLINE uint64_t StringUtil_umul128(uint64_t a, uint64_t b, uint64_t* hi)
+{
+#if (defined(FOG_CC_GNU) || defined(FOG_CC_CLANG)) && defined(__SIZEOF_INT128__)
+  unsigned __int128 r = (unsigned __int128)a * b;
+  *hi = (uint64_t)(r >> 64);
+  return (uint64_t)r;
+#else
+  uint64_t aLo = a & 0xFFFFFFFFU, aHi = a >> 32;
+  uint64_t bLo = b & 0xFFFFFFFFU, bHi = b >> 32;
+
+  uint64_t p0 = aLo * bLo;
+  uint64_t p1 = aLo * bHi;
+  uint64_t p2 = aHi * bLo;
+  uint64_t p3 = aHi * bHi;
+
+  uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFFU) + (p2 & 0xFFFFFFFFU);
+  *hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+  return (mid << 32) | (p0 & 0xFFFFFFFFU);
+#endif
+}
+
+static FOG_INLINE StringUtil_DiyFp StringUtil_DiyFp_make(uint64_t f, int e)
+{
+  StringUtil_DiyFp r;
+  r.f = f;
+  r.e = e;
+  return r;
+}
+
+static FOG_INLINE StringUtil_DiyFp StringUtil_DiyFp_normalize(uint64_t f, int e)
+{
+  int shift = StringUtil_clz64(f);
+  return StringUtil_DiyFp_make(f << shift, e - shift);
+}
+
+//! @internal
+//!
+//! @brief Multiply two DiyFp values, the result is rounded (half-up) to 64
+//! bits.
+static FOG_INLINE StringUtil_DiyFp StringUtil_DiyFp_mul(const StringUtil_DiyFp& a, const StringUtil_DiyFp& b)
+{
+  uint64_t hi;
+  uint64_t lo = StringUtil_umul128(a.f, b.f, &hi);
+  return StringUtil_DiyFp_make(hi + (lo >> 63), a.e + b.e + 64);
+}
+
+static const uint32_t StringUtil_smallPowersOfTen[] =
+{
+  0, 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+// The exponent range Grisu works with, the scaled value has always integral
+// part of at most 32 bits and fractional part of at least 32 bits.
+enum
+{
+  GRISU_MIN_TARGET_EXPONENT = -60,
+  GRISU_MAX_TARGET_EXPONENT = -32
+};
+
+//! @internal
+//!
+//! @brief Get the cached power of ten c_k = 10^k (returned in @a k) so that
+//! the binary exponent of w * c_k is in [GRISU_MIN_TARGET_EXPONENT,
+//! GRISU_MAX_TARGET_EXPONENT], where @a e is the binary exponent of w.
+static FOG_INLINE StringUtil_DiyFp StringUtil_grisuCachedPower(int e, int* k)
+{
+  int minExponent = GRISU_MIN_TARGET_EXPONENT - (e + 64);
+  // 1 / log2(10) = 0.30102999566398114.
+  int kGuess = (int)::ceil(double(minExponent + 63) * 0.30102999566398114);
+  int index = (348 + kGuess - 1) / 8 + 1;
+
+  const StringUtil_CachedPower& p = StringUtil_cachedPowers[index];
+  FOG_ASSERT(GRISU_MIN_TARGET_EXPONENT <= e + p.e + 64);
+  FOG_ASSERT(GRISU_MAX_TARGET_EXPONENT >= e + p.e + 64);
+
+  *k = p.k;
+  return StringUtil_DiyFp_make(p.f, p.e);
+}
+
+//! @internal
+//!
+//! @brief Get the biggest power of ten that is less or equal to @a number,
+//! @a bits is the count of significant bits of @a number (upper bound).
+static FOG_INLINE void StringUtil_grisuBiggestPowerTen(uint32_t number, int bits, uint32_t* power, int* exponentPlusOne)
+{
+  // 1233 / 4096 is approximately 1 / log2(10).
+  int guess = (((bits + 1) * 1233) >> 12) + 1;
+
+  if (number < StringUtil_smallPowersOfTen[guess])
+    guess--;
+
+  *power = StringUtil_smallPowersOfTen[guess];
+  *exponentPlusOne = guess;
+}
+
+//! @internal
+//!
+//! @brief Round the last generated digit towards w (shortest mode).
+//!
+//! Returns false if it's impossible to decide whether the generated digits
+//! are the closest shortest representation.
+static bool StringUtil_grisuRoundWeed(char* buffer, int length,
+  uint64_t distanceTooHighW, uint64_t unsafeInterval,
+  uint64_t rest, uint64_t tenKappa, uint64_t unit)
+{
+  uint64_t smallDistance = distanceTooHighW - unit;
+  uint64_t bigDistance = distanceTooHighW + unit;
+
+  while (rest < smallDistance && unsafeInterval - rest >= tenKappa &&
+         (rest + tenKappa < smallDistance || smallDistance - rest >= rest + tenKappa - smallDistance))
+  {
+    buffer[length - 1]--;
+    rest += tenKappa;
+  }
+
+  if (rest < bigDistance && unsafeInterval - rest >= tenKappa &&
+      (rest + tenKappa < bigDistance || bigDistance - rest > rest + tenKappa - bigDistance))
+  {
+    return false;
+  }
+
+  return (2 * unit <= rest) && (rest <= unsafeInterval - 4 * unit);
+}
+
+//! @internal
+//!
+//! @brief Round the last generated digit (counted mode).
+static bool StringUtil_grisuRoundWeedCounted(char* buffer, int length,
+  uint64_t rest, uint64_t tenKappa, uint64_t unit, int* kappa)
+{
+  FOG_ASSERT(rest < tenKappa);
+
+  if (unit >= tenKappa || tenKappa - unit <= unit)
+    return false;
+
+  // Round down.
+  if ((tenKappa - rest > rest) && (tenKappa - 2 * rest >= 2 * unit))
+    return true;
+
+  // Round up.
+  if ((rest > unit) && (tenKappa - (rest - unit) <= (rest - unit)))
+  {
+    buffer[length - 1]++;
+
+    for (int i = length - 1; i > 0; i--)
+    {
+      if (buffer[i] != '0' + 10)
+        break;
+
+      buffer[i] = '0';
+      buffer[i - 1]++;
+    }
+
+    if (buffer[0] == '0' + 10)
+    {
+      buffer[0] = '1';
+      (*kappa)++;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+//! @internal
+//!
+//! @brief Generate the shortest digits of w, which lies in (mMinus, mPlus).
+//!
+//! All three values must be normalized and share the same exponent. On
+//! success @a decpt is set to the decimal point position (dtoa convention).
+static bool StringUtil_grisuShortest(char* buffer, int* length, int* decpt,
+  const StringUtil_DiyFp& v, const StringUtil_DiyFp& vMinus, const StringUtil_DiyFp& vPlus)
+{
+  int mk;
+  StringUtil_DiyFp cp = StringUtil_grisuCachedPower(vPlus.e, &mk);
+
+  StringUtil_DiyFp w = StringUtil_DiyFp_mul(v, cp);
+  StringUtil_DiyFp low = StringUtil_DiyFp_mul(vMinus, cp);
+  StringUtil_DiyFp high = StringUtil_DiyFp_mul(vPlus, cp);
+
+  // The multiplication introduces an error of at most one unit, so the
+  // generated digits are only guaranteed to be in the "safe" interval.
+  uint64_t unit = 1;
+  uint64_t tooLow = low.f - unit;
+  uint64_t tooHigh = high.f + unit;
+  uint64_t unsafeInterval = tooHigh - tooLow;
+
+  int shift = -w.e;
+  uint64_t one = FOG_UINT64_C(1) << shift;
+
+  uint32_t integrals = (uint32_t)(tooHigh >> shift);
+  uint64_t fractionals = tooHigh & (one - 1);
+
+  uint32_t divisor;
+  int kappa;
+  StringUtil_grisuBiggestPowerTen(integrals, 64 - shift, &divisor, &kappa);
+
+  int n = 0;
+  bool result;
+
+  for (;;)
+  {
+    if (kappa > 0)
+    {
+      buffer[n++] = (char)('0' + integrals / divisor);
+      integrals %= divisor;
+      kappa--;
+
+      uint64_t rest = ((uint64_t)integrals << shift) + fractionals;
+      if (rest < unsafeInterval)
+      {
+        result = StringUtil_grisuRoundWeed(buffer, n, tooHigh - w.f, unsafeInterval, rest, (uint64_t)divisor << shift, unit);
+        break;
+      }
+
+      divisor /= 10;
+    }
+    else
+    {
+      fractionals *= 10;
+      unit *= 10;
+      unsafeInterval *= 10;
+
+      buffer[n++] = (char)('0' + (int)(fractionals >> shift));
+      fractionals &= one - 1;
+      kappa--;
+
+      if (fractionals < unsafeInterval)
+      {
+        result = StringUtil_grisuRoundWeed(buffer, n, (tooHigh - w.f) * unit, unsafeInterval, fractionals, one, unit);
+        break;
+      }
+    }
+  }
+
+  *length = n;
+  *decpt = n - mk + kappa;
+  return result;
+}
+
+//! @internal
+//!
+//! @brief Generate @a ndigits correctly rounded digits of w (mode 2) or all
+//! digits up to @a ndigits past the decimal point (mode 3).
+static bool StringUtil_grisuCounted(char* buffer, int* length, int* decpt,
+  const StringUtil_DiyFp& v, uint32_t mode, int ndigits)
+{
+  int mk;
+  StringUtil_DiyFp cp = StringUtil_grisuCachedPower(v.e, &mk);
+  StringUtil_DiyFp w = StringUtil_DiyFp_mul(v, cp);
+
+  uint64_t wError = 1;
+
+  int shift = -w.e;
+  uint64_t one = FOG_UINT64_C(1) << shift;
+
+  uint32_t integrals = (uint32_t)(w.f >> shift);
+  uint64_t fractionals = w.f & (one - 1);
+
+  uint32_t divisor;
+  int kappa;
+  StringUtil_grisuBiggestPowerTen(integrals, 64 - shift, &divisor, &kappa);
+
+  // The count of digits to generate, leave cases where no digit or more
+  // digits than the double precision can hold are requested to dtoa().
+  int requested = ndigits;
+  if (mode == 3)
+    requested += kappa - mk;
+  else if (requested < 1)
+    requested = 1;
+
+  if (requested <= 0 || requested > 17)
+    return false;
+
+  int n = 0;
+
+  while (kappa > 0)
+  {
+    buffer[n++] = (char)('0' + integrals / divisor);
+    integrals %= divisor;
+    kappa--;
+
+    if (--requested == 0)
+      break;
+
+    divisor /= 10;
+  }
+
+  bool result;
+
+  if (requested == 0)
+  {
+    uint64_t rest = ((uint64_t)integrals << shift) + fractionals;
+    result = StringUtil_grisuRoundWeedCounted(buffer, n, rest, (uint64_t)divisor << shift, wError, &kappa);
+  }
+  else
+  {
+    while (requested > 0 && fractionals > wError)
+    {
+      fractionals *= 10;
+      wError *= 10;
+
+      buffer[n++] = (char)('0' + (int)(fractionals >> shift));
+      fractionals &= one - 1;
+      kappa--;
+      requested--;
+    }
+
+    if (requested != 0)
+      return false;
+
+    result = StringUtil_grisuRoundWeedCounted(buffer, n, fractionals, one, wError, &kappa);
+  }
+
+  *decpt = n - mk + kappa;
+
+  // Trailing zeros are suppressed (the same as dtoa() does).
+  while (n > 1 && buffer[n - 1] == '0')
+    n--;
+
+  *length = n;
+  return result;
+}
+
+//! @internal
+//!
+//! @brief Compute the normalized significand and the boundaries of a positive
+//! finite IEEE value given by its significand @a f (including the hidden bit)
+//! and binary exponent @a e (value is @a f * 2^e).
+//!
+//! @a closer is true if the lower boundary is closer, that is when @a f is a
+//! power of two and the value isn't the smallest normalized one.
+static FOG_INLINE void StringUtil_grisuBoundaries(uint64_t f, int e, bool closer,
+  StringUtil_DiyFp* v, StringUtil_DiyFp* vMinus, StringUtil_DiyFp* vPlus)
+{
+  *v = StringUtil_DiyFp_normalize(f, e);
+  *vPlus = StringUtil_DiyFp_normalize((f << 1) + 1, e - 1);
+
+  if (closer)
+    *vMinus = StringUtil_DiyFp_make((f << 2) - 1, e - 2);
+  else
+    *vMinus = StringUtil_DiyFp_make((f << 1) - 1, e - 1);
+
+  vMinus->f <<= vMinus->e - vPlus->e;
+  vMinus->e = vPlus->e;
+}
+
+//! @internal
+//!
+//! @brief Double to ascii conversion, Grisu is used where possible, the rest
+//! is handled by StringUtil_dtoa(). The output in @a ctx is null terminated.
+static void FOG_CDECL StringUtil_dtoaFast(NTOAContext* ctx, double d, uint32_t mode, int ndigits)
+{
+  DoubleBits bits;
+  bits.d = d;
+
+  uint64_t f = bits.u64 & FOG_UINT64_C(0x000FFFFFFFFFFFFF);
+  int be = (int)(bits.u64 >> 52) & 0x7FF;
+
+  // Zero, Infinity, NaN and modes not handled by Grisu go directly to dtoa().
+  if (be != 0x7FF && (be | f) != 0 && (mode == 0 || mode == 2 || mode == 3))
+  {
+    bool closer = (f == 0 && be > 1);
+    int e;
+
+    if (be == 0)
+    {
+      e = -1074;
+    }
+    else
+    {
+      f |= FOG_UINT64_C(0x0010000000000000);
+      e = be - 1075;
+    }
+
+    int length;
+    int decpt;
+    bool ok;
+
+    if (mode == 0)
+    {
+      StringUtil_DiyFp v, vMinus, vPlus;
+      StringUtil_grisuBoundaries(f, e, closer, &v, &vMinus, &vPlus);
+      ok = StringUtil_grisuShortest(ctx->buffer, &length, &decpt, v, vMinus, vPlus);
+    }
+    else
+    {
+      ok = StringUtil_grisuCounted(ctx->buffer, &length, &decpt, StringUtil_DiyFp_normalize(f, e), mode, ndigits);
+    }
+
+    if (ok)
+    {
+      ctx->result = ctx->buffer;
+      ctx->buffer[length] = '\0';
+      ctx->length = (uint32_t)length;
+      ctx->negative = (uint32_t)(bits.u64 >> 63);
+      ctx->decpt = decpt;
+      return;
+    }
+  }
+
+  StringUtil_dtoa(ctx, d, mode, ndigits);
+  if (ctx->length < FOG_ARRAY_SIZE(ctx->buffer))
+    ctx->result[ctx->length] = '\0';
+}
+
+//! @internal
+//!
+//! @brief Double to ascii conversion without the Grisu fast path, used to
+//! verify it (see @c Api::stringutil_dtoaRef).
+static void FOG_CDECL StringUtil_dtoaRef(NTOAContext* ctx, double d, uint32_t mode, int ndigits)
+{
+  StringUtil_dtoa(ctx, d, mode, ndigits);
+  if (ctx->length < FOG_ARRAY_SIZE(ctx->buffer))
+    ctx->result[ctx->length] = '\0';
+}
+
 // ============================================================================
 // [Fog::StringUtil - ParseFloat / ParseDouble]
 // ============================================================================
 
+//! @internal
+//!
+//! @brief Compute w * 10^q correctly rounded to the nearest double using the
+//! Eisel-Lemire algorithm (Daniel Lemire, "Number Parsing at a Gigabyte per
+//! Second", 2021, ported from the fast_float library, MIT license).
+//!
+//! @a w must be non-zero and less than 10^19 (the 128-bit product is then
+//! always precise enough). Returns false if the result is not a normalized
+//! double (subnormal, overflow) or @a q is out of the table range, in such
+//! case the bigint path of StringUtil_parseDouble() must be used.
+static bool StringUtil_eiselLemire(uint64_t w, int q, double* dst)
+{
+  FOG_ASSERT(w != 0);
+
+  if (q < -342 || q > 308)
+    return false;
+
+  int lz = StringUtil_clz64(w);
+  w <<= lz;
+
+  // 55 bits are needed (53 + rounding bit + possible shift), the second part
+  // of 5^q has to be considered only if the lower 9 bits are all ones.
+  const uint64_t* p5 = &StringUtil_pow5Table[(q + 342) * 2];
+
+  uint64_t hi;
+  uint64_t lo = StringUtil_umul128(w, p5[0], &hi);
+
+  if ((hi & 0x1FF) == 0x1FF)
+  {
+    uint64_t hi2;
+    StringUtil_umul128(w, p5[1], &hi2);
+
+    lo += hi2;
+    if (lo < hi2)
+      hi++;
+  }
+
+  int upperBit = (int)(hi >> 63);
+  int shift = upperBit + 9;
+
+  uint64_t mantissa = hi >> shift;
+  // floor(log2(10^q)) + 63 + 1023, (152170 + 65536) / 65536 ~= log2(10).
+  int power2 = (((152170 + 65536) * q) >> 16) + 63 + upperBit - lz + 1023;
+
+  if (power2 <= 0)
+    return false;
+
+  // The product is exact and lies exactly in the middle of two doubles
+  // (possible only for small q), round to even.
+  if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == hi)
+    mantissa &= ~FOG_UINT64_C(1);
+
+  mantissa += mantissa & 1;
+  mantissa >>= 1;
+
+  if (mantissa >= (FOG_UINT64_C(2) << 52))
+  {
+    mantissa = FOG_UINT64_C(1) << 52;
+    power2++;
+  }
+
+  if (power2 >= 0x7FF)
+    return false;
+
+  DoubleBits bits;
+  bits.u64 = (mantissa & ~(FOG_UINT64_C(1) << 52)) | ((uint64_t)power2 << 52);
+
+  *dst = bits.d;
+  return true;
+}
+
 template<typename CharT>
 static err_t FOG_CDECL StringUtil_parseFloat(float* dst, const CharT* str, size_t length, CharT_Type decimalPoint, size_t* pEnd, uint32_t* pFlags)
 {
@@ -2059,7 +2594,9 @@ static BInt* BContext_s2b(BContext* context, const CharT* s, int nd0, int nd, ui
   return b;
 }
 
-template<typename CharT>
+// UseEiselLemire is false only for the reference implementation, which is
+// used to verify the Eisel-Lemire fast path (see Api::stringutil_parseDoubleRefA).
+template<typename CharT, bool UseEiselLemire>
 static err_t FOG_CDECL StringUtil_parseDouble(double* dst, const CharT* str, size_t length, CharT_Type decimalPoint, size_t* pEnd, uint32_t* pFlags)
 {
   BContext context;
@@ -2425,6 +2962,27 @@ _VaxOverflowCheck:
     }
 #endif
   }
+
+  // Eisel-Lemire fast path, exact for up to 19 significant digits.
+  if (UseEiselLemire && nd <= 19 && Flt_Rounds == 1)
+  {
+    uint64_t w = 0;
+    s1 = s0;
+
+    for (i = 0; i < nd; i++, s1++)
+    {
+      // Skip the decimal point.
+      if (i == nd0)
+        s1++;
+
+      c = *s1;
+      w = w * 10 + (uint32_t)(c - '0');
+    }
+
+    if (StringUtil_eiselLemire(w, e, &rv.d))
+      goto _Ret;
+  }
+
   e1 += nd - k;
 
 #if defined(DTOA_IEEE)
@@ -3107,19 +3665,185 @@ _Ret:
   return err;
 }
 
+// ============================================================================
+// [Fog::StringUtil - ftoa]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Get whether @a digits * 10^x is exactly equal to @a m * 2^y.
+//!
+//! Used to check the float rounding boundary, @a m is odd and less than 2^26
+//! and @a digits is less than 10^9.
+static bool StringUtil_isExactBoundary(uint64_t digits, int x, uint64_t m, int y)
+{
+  int i;
+
+  if (x >= 0)
+  {
+    // The odd m would have to be divisible by 5^x, but m < 2^26 < 5^12.
+    if (x > 11)
+      return false;
+
+    for (i = 0; i < x; i++)
+      digits *= 5;
+
+    while ((digits & 1) == 0)
+    {
+      digits >>= 1;
+      x++;
+    }
+
+    return digits == m && x == y;
+  }
+  else
+  {
+    // digits == m * 5^z * 2^(y + z), where z = -x.
+    int z = -x;
+    int shift = y + z;
+
+    if (shift < 0 || shift > 30 || z > 13)
+      return false;
+
+    for (i = 0; i < z; i++)
+      m *= 5;
+
+    return m <= digits && (m << shift) == digits;
+  }
+}
+
+//! @internal
+//!
+//! @brief Float to ascii conversion.
+//!
+//! Mode 0 generates the shortest digits that round-trip through the single
+//! precision (the double precision would give up to 17 digits, for example
+//! "0.100000001490116" instead of "0.1"). Other modes are the same as dtoa().
+static void FOG_CDECL StringUtil_ftoa(NTOAContext* ctx, float d, uint32_t mode, int ndigits)
+{
+  FloatBits bits;
+  bits.f = d;
+
+  uint32_t f = bits.u32 & 0x007FFFFF;
+  int be = (int)(bits.u32 >> 23) & 0xFF;
+
+  if (mode != 0 || be == 0xFF || (be | f) == 0)
+  {
+    StringUtil_dtoaFast(ctx, double(d), mode, ndigits);
+    return;
+  }
+
+  bool closer = (f == 0 && be > 1);
+  int e;
+
+  if (be == 0)
+  {
+    e = -149;
+  }
+  else
+  {
+    f |= 0x00800000;
+    e = be - 150;
+  }
+
+  ctx->result = ctx->buffer;
+  ctx->negative = bits.u32 >> 31;
+
+  int length;
+  int decpt;
+
+  StringUtil_DiyFp v, vMinus, vPlus;
+  StringUtil_grisuBoundaries(f, e, closer, &v, &vMinus, &vPlus);
+
+  if (!StringUtil_grisuShortest(ctx->buffer, &length, &decpt, v, vMinus, vPlus))
+  {
+    // Grisu failed, try the correctly rounded 1..9 significant digits and
+    // stop at the first which rounds to the float (9 digits are always
+    // enough). The boundaries are exactly representable as doubles, a value
+    // parsed exactly to the boundary is accepted only if it's really equal
+    // to it and the significand is even (round-half-even).
+    uint64_t lowM = closer ? (uint64_t)f * 4 - 1 : (uint64_t)f * 2 - 1;
+    int lowE = closer ? e - 2 : e - 1;
+
+    uint64_t highM = (uint64_t)f * 2 + 1;
+    int highE = e - 1;
+
+    double lowBound = ::ldexp(double(lowM), lowE);
+    double highBound = ::ldexp(double(highM), highE);
+
+    for (int n = 1; n <= 9; n++)
+    {
+      NTOAContext tmp;
+      StringUtil_dtoa(&tmp, Math::abs(double(d)), 2, n);
+
+      uint64_t digits = 0;
+      for (uint32_t i = 0; i < tmp.length; i++)
+        digits = digits * 10 + (uint32_t)(tmp.result[i] - '0');
+
+      // Build "DIGITSeEXP" and parse it back, EXP has at most two digits.
+      char num[32];
+      memcpy(num, tmp.result, tmp.length);
+
+      size_t numLength = tmp.length;
+      int exp10 = tmp.decpt - (int)tmp.length;
+      int exp = exp10;
+
+      num[numLength++] = 'e';
+      if (exp < 0)
+      {
+        num[numLength++] = '-';
+        exp = -exp;
+      }
+
+      if (exp >= 10)
+        num[numLength++] = (char)('0' + exp / 10);
+      num[numLength++] = (char)('0' + exp % 10);
+
+      double back;
+      StringUtil_parseDouble<char, true>(&back, num, numLength, '.', NULL, NULL);
+
+      bool accept = (back > lowBound && back < highBound);
+      if (!accept && (f & 1) == 0)
+      {
+        if (back == lowBound)
+          accept = StringUtil_isExactBoundary(digits, exp10, lowM, lowE);
+        else if (back == highBound)
+          accept = StringUtil_isExactBoundary(digits, exp10, highM, highE);
+      }
+
+      if (accept || n == 9)
+      {
+        memcpy(ctx->buffer, tmp.result, tmp.length);
+        length = (int)tmp.length;
+        decpt = tmp.decpt;
+        break;
+      }
+    }
+  }
+
+  ctx->buffer[length] = '\0';
+  ctx->length = (uint32_t)length;
+  ctx->decpt = decpt;
+}
+
 // ============================================================================
 // [Init / Fini]
 // ============================================================================
 
 FOG_NO_EXPORT void StringUtil_init_dtoa(void)
 {
-  fog_api.stringutil_dtoa = StringUtil_dtoa;
+  fog_api.stringutil_dtoa = StringUtil_dtoaFast;
+  fog_api.stringutil_dtoaRef = StringUtil_dtoaRef;
+  fog_api.stringutil_ftoa = StringUtil_ftoa;
 
   fog_api.stringutil_parseFloatA = StringUtil_parseFloat<char>;
   fog_api.stringutil_parseFloatW = StringUtil_parseFloat<CharW>;
 
-  fog_api.stringutil_parseDoubleA = StringUtil_parseDouble<char>;
-  fog_api.stringutil_parseDoubleW = StringUtil_parseDouble<CharW>;
+  fog_api.stringutil_parseDoubleA = StringUtil_parseDouble<char, true>;
+  fog_api.stringutil_parseDoubleW = StringUtil_parseDouble<CharW, true>;
+
+  fog_api.stringutil_parseDoubleRefA = StringUtil_parseDouble<char, false>;
+  fog_api.stringutil_parseDoubleRefW = StringUtil_parseDouble<CharW, false>;
 }
 
 } // Fog namespace
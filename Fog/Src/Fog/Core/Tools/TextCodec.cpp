@@ -561,6 +561,20 @@ static err_t FOG_CDECL TextCodec_UTF8_encode(const TextCodecData* d,
 
   while (srcCur != srcEnd)
   {
+    // Convert the run of ASCII characters at once.
+    if (srcCur[0] < 0x80)
+    {
+      size_t n = StringUtil::asciiFromUnicode(reinterpret_cast<char*>(dstCur), srcCur,
+        Math::min<size_t>((size_t)(srcEnd - srcCur), remain));
+
+      srcCur += n;
+      dstCur += n;
+      remain -= n;
+
+      if (srcCur == srcEnd)
+        break;
+    }
+
     uc = *srcCur++;
     if (FOG_UNLIKELY(CharW::isHiSurrogate(uc)))
     {
@@ -708,6 +722,22 @@ static err_t FOG_CDECL TextCodec_UTF8_decode(const TextCodecData* d,
   for (;;)
   {
     uc = *srcCur;
+
+    // Convert the run of ASCII characters at once.
+    if (uc < 0x80)
+    {
+      size_t n = StringUtil::unicodeFromAscii(dstCur,
+        reinterpret_cast<const char*>(srcCur), (size_t)(srcEnd - srcCur));
+
+      srcCur += n;
+      dstCur += n;
+
+      if (srcCur == srcEnd)
+        break;
+
+      uc = *srcCur;
+    }
+
     utf8Size = Unicode::utf8GetSize(uc);
 
     // Incomplete Input
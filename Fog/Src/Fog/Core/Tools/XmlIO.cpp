@@ -9,6 +9,7 @@
 #endif // FOG_PRECOMP
 
 // [Dependencies]
+#include <Fog/Core/OS/FileMapping.h>
 #include <Fog/Core/Tools/Char.h>
 #include <Fog/Core/Tools/Hash.h>
 #include <Fog/Core/Tools/List.h>
@@ -28,6 +29,123 @@ namespace Fog {
 XmlSaxHandler::XmlSaxHandler() {}
 XmlSaxHandler::~XmlSaxHandler() {}
 
+// ============================================================================
+// [Fog::XmlSaxHandler - SAX Interface (UTF-8)]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Temporary UTF-16 copy of an UTF-8 slice.
+//!
+//! Names and most of values are short ASCII strings, these are widened into
+//! a stack buffer without going through the UTF-8 codec.
+struct FOG_NO_EXPORT XmlSaxTmpW
+{
+  FOG_INLINE XmlSaxTmpW() :
+    _stub(UNINITIALIZED)
+  {
+  }
+
+  FOG_INLINE err_t set(const StubA& src)
+  {
+    const char* sData = src.getData();
+    size_t sLength = src.getLength();
+
+    if (sLength <= TEMPORARY_LENGTH &&
+        StringUtil::unicodeFromAscii(_buffer, sData, sLength) == sLength)
+    {
+      _stub.setData(_buffer);
+      _stub.setLength(sLength);
+      return ERR_OK;
+    }
+
+    FOG_RETURN_ON_ERROR(_string.set(Utf8(sData, sLength)));
+
+    _stub.setData(_string.getData());
+    _stub.setLength(_string.getLength());
+    return ERR_OK;
+  }
+
+  FOG_INLINE const StubW& getStub() const { return _stub; }
+
+  StubW _stub;
+  StringW _string;
+  CharW _buffer[TEMPORARY_LENGTH];
+};
+
+// The default implementation converts the UTF-8 data to UTF-16 and calls the
+// UTF-16 interface.
+
+err_t XmlSaxHandler::onStartElementUtf8(const StubA& tagName)
+{
+  XmlSaxTmpW tagNameW;
+  FOG_RETURN_ON_ERROR(tagNameW.set(tagName));
+
+  return onStartElement(tagNameW.getStub());
+}
+
+err_t XmlSaxHandler::onEndElementUtf8(const StubA& tagName)
+{
+  XmlSaxTmpW tagNameW;
+  FOG_RETURN_ON_ERROR(tagNameW.set(tagName));
+
+  return onEndElement(tagNameW.getStub());
+}
+
+err_t XmlSaxHandler::onAttributeUtf8(const StubA& name, const StubA& value)
+{
+  XmlSaxTmpW nameW;
+  XmlSaxTmpW valueW;
+
+  FOG_RETURN_ON_ERROR(nameW.set(name));
+  FOG_RETURN_ON_ERROR(valueW.set(value));
+
+  return onAttribute(nameW.getStub(), valueW.getStub());
+}
+
+err_t XmlSaxHandler::onCharacterDataUtf8(const StubA& data)
+{
+  XmlSaxTmpW dataW;
+  FOG_RETURN_ON_ERROR(dataW.set(data));
+
+  return onCharacterData(dataW.getStub());
+}
+
+err_t XmlSaxHandler::onIgnorableWhitespaceUtf8(const StubA& data)
+{
+  XmlSaxTmpW dataW;
+  FOG_RETURN_ON_ERROR(dataW.set(data));
+
+  return onIgnorableWhitespace(dataW.getStub());
+}
+
+err_t XmlSaxHandler::onCDATASectionUtf8(const StubA& data)
+{
+  XmlSaxTmpW dataW;
+  FOG_RETURN_ON_ERROR(dataW.set(data));
+
+  return onCDATASection(dataW.getStub());
+}
+
+err_t XmlSaxHandler::onCommentUtf8(const StubA& data)
+{
+  XmlSaxTmpW dataW;
+  FOG_RETURN_ON_ERROR(dataW.set(data));
+
+  return onComment(dataW.getStub());
+}
+
+err_t XmlSaxHandler::onProcessingInstructionUtf8(const StubA& target, const StubA& data)
+{
+  XmlSaxTmpW targetW;
+  XmlSaxTmpW dataW;
+
+  FOG_RETURN_ON_ERROR(targetW.set(target));
+  FOG_RETURN_ON_ERROR(dataW.set(data));
+
+  return onProcessingInstruction(targetW.getStub(), dataW.getStub());
+}
+
 // ============================================================================
 // [Fog::XmlSaxParser - Constants]
 // ============================================================================
@@ -92,6 +210,32 @@ enum XML_SAX_ELEMENT
   XML_SAX_ELEMENT_DOCTYPE
 };
 
+//! @internal.
+//!
+//! @brief @ref XmlSaxParser input flags.
+enum XML_SAX_INPUT
+{
+  //! @brief Input is the start of the document (call onStartDocument()).
+  XML_SAX_INPUT_START = 0x1,
+  //! @brief Input is the end of the document (call onEndDocument()).
+  XML_SAX_INPUT_END = 0x2,
+  //! @brief Input is the whole document.
+  XML_SAX_INPUT_DOCUMENT = XML_SAX_INPUT_START | XML_SAX_INPUT_END
+};
+
+//! @internal.
+//!
+//! @brief @ref XmlSaxParser incremental parser flags.
+enum XML_SAX_FEED
+{
+  //! @brief The document was started (onStartDocument() called).
+  XML_SAX_FEED_STARTED = 0x1,
+  //! @brief The document encoding was detected.
+  XML_SAX_FEED_DETECTED = 0x2,
+  //! @brief The document is converted to UTF-16 by @c _feedCodec.
+  XML_SAX_FEED_UTF16 = 0x4
+};
+
 // ============================================================================
 // [Fog::XmlSaxParser - Helpers]
 // ============================================================================
@@ -122,11 +266,21 @@ static FOG_INLINE uint8_t XmlUtil_lo8(uint8_t c)
 //   [U+00F900-U+00FDCF] |
 //   [U+00FDF0-U+00FFFD] |
 //   [U+010000-U+0EFFFF] ;
-static FOG_INLINE bool XmlUtil_isNameStartChar(const CharW& c)
+static FOG_INLINE bool XmlUtil_isNameStartChar(uint16_t c)
 {
-  return c.isLetter() ||
-         c == CharW(':') ||
-         c == CharW('_') ;
+  return CharW::isLetter(c) ||
+         c == ':' ||
+         c == '_' ;
+}
+
+// UTF-8 version, all non-ASCII bytes (lead and trail bytes of a multi-byte
+// sequence) are accepted as name characters.
+static FOG_INLINE bool XmlUtil_isNameStartChar(uint8_t c)
+{
+  return CharA::isLetter(c) ||
+         c == ':' ||
+         c == '_' ||
+         c >= 0x80;
 }
 
 // NameChar ::=
@@ -137,32 +291,112 @@ static FOG_INLINE bool XmlUtil_isNameStartChar(const CharW& c)
 //   [U+0000B7]          |
 //   [U+000300-U+00036F] |
 //   [U+00203F-U+002040] ;
-static FOG_INLINE bool XmlUtil_isNameChar(const CharW& c)
+static FOG_INLINE bool XmlUtil_isNameChar(uint16_t c)
 {
-  return c.isNumlet() ||
-         c == CharW(':') ||
-         c == CharW('_') ||
-         c == CharW('-') ||
-         c == CharW('.') ;
+  return CharW::isNumlet(c) ||
+         c == ':' ||
+         c == '_' ||
+         c == '-' ||
+         c == '.' ;
+}
+
+static FOG_INLINE bool XmlUtil_isNameChar(uint8_t c)
+{
+  return CharA::isNumlet(c) ||
+         c == ':' ||
+         c == '_' ||
+         c == '-' ||
+         c == '.' ||
+         c >= 0x80;
 }
 
 // TODO: Not correct.
-static FOG_INLINE bool XmlUtil_isWhitespace(const CharW& c)
+static FOG_INLINE bool XmlUtil_isWhitespace(uint16_t c)
 {
-  return c.isSpace();
+  return CharW::isSpace(c);
+}
+
+// S ::= (#x20 | #x9 | #xD | #xA)+
+static FOG_INLINE bool XmlUtil_isWhitespace(uint8_t c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
 }
 
 // TODO: Probably wrong according to the XML specification.
-static bool XmlSaxParser_isWhiteSpace(const CharW* buffer, const CharW* end)
+template<typename CharT>
+static bool XmlSaxParser_isWhiteSpace(const CharT* buffer, const CharT* end)
 {
   while (buffer < end)
   {
-    if (!buffer->isSpace()) return false;
+    if (!XmlUtil_isWhitespace(buffer[0])) return false;
     buffer++;
   }
   return true;
 }
 
+//! @internal
+//!
+//! @brief Find @a c in [@a p, @a end), returns @a end if not found.
+static FOG_INLINE const uint8_t* XmlUtil_find(const uint8_t* p, const uint8_t* end, uint8_t c)
+{
+  const void* r = ::memchr(p, c, (size_t)(end - p));
+  return r != NULL ? static_cast<const uint8_t*>(r) : end;
+}
+
+static FOG_INLINE const uint16_t* XmlUtil_find(const uint16_t* p, const uint16_t* end, uint16_t c)
+{
+  size_t i = StringUtil::indexOf(reinterpret_cast<const CharW*>(p), (size_t)(end - p), CharW(c));
+  return i != INVALID_INDEX ? p + i : end;
+}
+
+//! @internal
+//!
+//! @brief Find two characters sequence in [@a p, @a end), returns @a end if
+//! not found.
+template<typename CharT>
+static FOG_INLINE const CharT* XmlUtil_find2(const CharT* p, const CharT* end, CharT c0, CharT c1)
+{
+  for (;;)
+  {
+    p = XmlUtil_find(p, end, c0);
+    if ((size_t)(end - p) < 2)
+      return end;
+
+    if (p[1] == c1)
+      return p;
+    p++;
+  }
+}
+
+//! @internal
+//!
+//! @brief Find three characters sequence in [@a p, @a end), returns @a end if
+//! not found.
+template<typename CharT>
+static FOG_INLINE const CharT* XmlUtil_find3(const CharT* p, const CharT* end, CharT c0, CharT c1, CharT c2)
+{
+  for (;;)
+  {
+    p = XmlUtil_find(p, end, c0);
+    if ((size_t)(end - p) < 3)
+      return end;
+
+    if (p[1] == c1 && p[2] == c2)
+      return p;
+    p++;
+  }
+}
+
+static FOG_INLINE bool XmlUtil_eq(const uint8_t* p, const char* s, size_t length, uint cs)
+{
+  return StringUtil::eq(reinterpret_cast<const char*>(p), s, length, cs);
+}
+
+static FOG_INLINE bool XmlUtil_eq(const uint16_t* p, const char* s, size_t length, uint cs)
+{
+  return StringUtil::eq(reinterpret_cast<const CharW*>(p), s, length, cs);
+}
+
 static void XmlSaxParser_detectEncoding(TextCodec& tc, const void* mem, size_t size)
 {
   // first check for BOM
@@ -327,100 +561,294 @@ static void XmlSaxParser_detectEncoding(TextCodec& tc, const void* mem, size_t s
 }
 
 // ============================================================================
-// [Fog::XmlSaxParser - Construction / Destruction]
+// [Fog::XmlSaxParser - Events]
 // ============================================================================
 
-XmlSaxParser::XmlSaxParser(XmlSaxHandler* handler) :
-  _handler(handler)
+// The parser works on uint8_t (UTF-8) or uint16_t (UTF-16) code-units, these
+// overloads wrap the parsed slices into StubA or StubW and call the matching
+// handler event.
+
+static FOG_INLINE err_t XmlSaxParser_onStartElement(XmlSaxHandler* handler, const uint8_t* tag, size_t tagLength)
 {
+  return handler->onStartElementUtf8(StubA(reinterpret_cast<const char*>(tag), tagLength));
 }
 
-XmlSaxParser::~XmlSaxParser()
+static FOG_INLINE err_t XmlSaxParser_onStartElement(XmlSaxHandler* handler, const uint16_t* tag, size_t tagLength)
 {
+  return handler->onStartElement(StubW(reinterpret_cast<const CharW*>(tag), tagLength));
 }
 
-// ============================================================================
-// [Fog::XmlSaxParser - Parse]
-// ============================================================================
+static FOG_INLINE err_t XmlSaxParser_onEndElement(XmlSaxHandler* handler, const uint8_t* tag, size_t tagLength)
+{
+  return handler->onEndElementUtf8(StubA(reinterpret_cast<const char*>(tag), tagLength));
+}
 
-err_t XmlSaxParser::parseFile(const StringW& fileName)
+static FOG_INLINE err_t XmlSaxParser_onEndElement(XmlSaxHandler* handler, const uint16_t* tag, size_t tagLength)
 {
-  Stream stream;
-  err_t err = stream.openFile(fileName, STREAM_OPEN_READ);
+  return handler->onEndElement(StubW(reinterpret_cast<const CharW*>(tag), tagLength));
+}
 
-  if (FOG_IS_ERROR(err)) 
-    return err;
+static FOG_INLINE err_t XmlSaxParser_onAttribute(XmlSaxHandler* handler,
+  const uint8_t* name, size_t nameLength,
+  const uint8_t* value, size_t valueLength)
+{
+  return handler->onAttributeUtf8(
+    StubA(reinterpret_cast<const char*>(name), nameLength),
+    StubA(reinterpret_cast<const char*>(value), valueLength));
+}
 
-  return parseStream(stream);
+static FOG_INLINE err_t XmlSaxParser_onAttribute(XmlSaxHandler* handler,
+  const uint16_t* name, size_t nameLength,
+  const uint16_t* value, size_t valueLength)
+{
+  return handler->onAttribute(
+    StubW(reinterpret_cast<const CharW*>(name), nameLength),
+    StubW(reinterpret_cast<const CharW*>(value), valueLength));
 }
 
-err_t XmlSaxParser::parseStream(Stream& stream)
+static FOG_INLINE err_t XmlSaxParser_onCharacterData(XmlSaxHandler* handler, const uint8_t* data, size_t dataLength)
 {
-  StringA buffer;
-  stream.readAll(buffer);
-  return parseMemory(reinterpret_cast<const void*>(buffer.getData()), buffer.getLength());
+  return handler->onCharacterDataUtf8(StubA(reinterpret_cast<const char*>(data), dataLength));
 }
 
-err_t XmlSaxParser::parseMemory(const void* mem, size_t size)
+static FOG_INLINE err_t XmlSaxParser_onCharacterData(XmlSaxHandler* handler, const uint16_t* data, size_t dataLength)
 {
-  TextCodec textCodec = TextCodec::utf8();
-  XmlSaxParser_detectEncoding(textCodec, mem, size);
+  return handler->onCharacterData(StubW(reinterpret_cast<const CharW*>(data), dataLength));
+}
 
-  StringW buffer;
-  err_t err = textCodec.decode(buffer, StubA(reinterpret_cast<const char*>(mem), size));
+static FOG_INLINE err_t XmlSaxParser_onIgnorableWhitespace(XmlSaxHandler* handler, const uint8_t* data, size_t dataLength)
+{
+  return handler->onIgnorableWhitespaceUtf8(StubA(reinterpret_cast<const char*>(data), dataLength));
+}
 
-  if (FOG_IS_ERROR(err))
-    return err;
+static FOG_INLINE err_t XmlSaxParser_onIgnorableWhitespace(XmlSaxHandler* handler, const uint16_t* data, size_t dataLength)
+{
+  return handler->onIgnorableWhitespace(StubW(reinterpret_cast<const CharW*>(data), dataLength));
+}
 
-  return parseString(StubW(buffer.getData(), buffer.getLength()));
+static FOG_INLINE err_t XmlSaxParser_onCDATASection(XmlSaxHandler* handler, const uint8_t* data, size_t dataLength)
+{
+  return handler->onCDATASectionUtf8(StubA(reinterpret_cast<const char*>(data), dataLength));
 }
 
-err_t XmlSaxParser::parseString(const StringW& str)
+static FOG_INLINE err_t XmlSaxParser_onCDATASection(XmlSaxHandler* handler, const uint16_t* data, size_t dataLength)
 {
-  StringW copy(str);
-  return parseString(StubW(copy.getData(), copy.getLength()));
+  return handler->onCDATASection(StubW(reinterpret_cast<const CharW*>(data), dataLength));
 }
 
-err_t XmlSaxParser::parseString(const StubW& str)
+static FOG_INLINE err_t XmlSaxParser_onComment(XmlSaxHandler* handler, const uint8_t* data, size_t dataLength)
 {
-  const CharW* sData = str.getData();
-  size_t sLength = str.getComputedLength();
+  return handler->onCommentUtf8(StubA(reinterpret_cast<const char*>(data), dataLength));
+}
 
-  // Check if encoded length is zero (no document).
-  if (sLength == DETECT_LENGTH)
-    sLength = StringUtil::len(sData);
+static FOG_INLINE err_t XmlSaxParser_onComment(XmlSaxHandler* handler, const uint16_t* data, size_t dataLength)
+{
+  return handler->onComment(StubW(reinterpret_cast<const CharW*>(data), dataLength));
+}
+
+static FOG_INLINE err_t XmlSaxParser_onProcessingInstruction(XmlSaxHandler* handler,
+  const uint8_t* target, size_t targetLength,
+  const uint8_t* data, size_t dataLength)
+{
+  return handler->onProcessingInstructionUtf8(
+    StubA(reinterpret_cast<const char*>(target), targetLength),
+    StubA(reinterpret_cast<const char*>(data), dataLength));
+}
+
+static FOG_INLINE err_t XmlSaxParser_onProcessingInstruction(XmlSaxHandler* handler,
+  const uint16_t* target, size_t targetLength,
+  const uint16_t* data, size_t dataLength)
+{
+  return handler->onProcessingInstruction(
+    StubW(reinterpret_cast<const CharW*>(target), targetLength),
+    StubW(reinterpret_cast<const CharW*>(data), dataLength));
+}
+
+static FOG_INLINE err_t XmlSaxParser_addDOCTYPE(List<StringW>& doctype, const uint8_t* data, size_t dataLength)
+{
+  StringW s;
+  FOG_RETURN_ON_ERROR(s.set(Utf8(reinterpret_cast<const char*>(data), dataLength)));
+
+  return doctype.append(s);
+}
+
+static FOG_INLINE err_t XmlSaxParser_addDOCTYPE(List<StringW>& doctype, const uint16_t* data, size_t dataLength)
+{
+  return doctype.append(StringW(reinterpret_cast<const CharW*>(data), dataLength));
+}
+
+// ============================================================================
+// [Fog::XmlSaxParser - State Machine]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Get whether the token (text, tag, comment, ...) starting at @a start
+//! ends before @a end.
+//!
+//! Used by the incremental parser, the token is not parsed until it's complete
+//! so the state machine can always restart after the last complete token. If
+//! the token is incomplete, @a scanned and @a quote are updated so the next
+//! call (with more input) doesn't need to scan the same characters again.
+template<typename CharT>
+static bool XmlSaxParser_isTokenComplete(const CharT* start, const CharT* end, size_t* scanned, uint32_t* quote)
+{
+  size_t length = (size_t)(end - start);
+  size_t pos = *scanned;
+  const CharT* p;
 
-  if (sLength == 0)
+  // Text, ends by '<'.
+  if (start[0] != '<')
+  {
+    p = XmlUtil_find(start + (pos < 1 ? 1 : pos), end, (CharT)'<');
+    if (p == end)
+      goto _Incomplete;
+    goto _Complete;
+  }
+
+  if (length < 2)
+    return false;
+
+  // <? ... ?>
+  if (start[1] == '?')
+  {
+    p = XmlUtil_find2<CharT>(start + (pos < 2 ? 2 : pos), end, '?', '>');
+    if (p == end)
+    {
+      length -= 1;
+      goto _Incomplete;
+    }
+    goto _Complete;
+  }
+
+  if (start[1] == '!')
+  {
+    if (length < 4)
+      return false;
+
+    // <!-- ... -->
+    if (start[2] == '-' && start[3] == '-')
+    {
+      p = XmlUtil_find3<CharT>(start + (pos < 4 ? 4 : pos), end, '-', '-', '>');
+      if (p == end)
+      {
+        length -= 2;
+        goto _Incomplete;
+      }
+      goto _Complete;
+    }
+
+    // <![CDATA[ ... ]]>
+    if (start[2] == '[')
+    {
+      if (length < 9)
+        return false;
+
+      p = XmlUtil_find3<CharT>(start + (pos < 9 ? 9 : pos), end, ']', ']', '>');
+      if (p == end)
+      {
+        length -= 2;
+        goto _Incomplete;
+      }
+      goto _Complete;
+    }
+  }
+
+  // Start tag, end tag or DOCTYPE, ends by '>' which is not quoted.
+  p = start + (pos < 1 ? 1 : pos);
+
+  if (*quote != 0)
+  {
+    p = XmlUtil_find(p, end, (CharT)*quote);
+    if (p == end)
+      goto _Incomplete;
+
+    *quote = 0;
+    p++;
+  }
+
+  for (;;)
+  {
+    while (p != end && p[0] != '>' && p[0] != '\'' && p[0] != '\"')
+      p++;
+
+    if (p == end)
+      goto _Incomplete;
+
+    if (p[0] == '>')
+      goto _Complete;
+
+    CharT q = p[0];
+    p = XmlUtil_find(p + 1, end, q);
+
+    if (p == end)
+    {
+      *quote = q;
+      goto _Incomplete;
+    }
+    p++;
+  }
+
+_Complete:
+  *scanned = 0;
+  *quote = 0;
+  return true;
+
+_Incomplete:
+  *scanned = length;
+  return false;
+}
+
+//! @internal
+//!
+//! @brief Parse XML document stored in UTF-8 (@a CharT is @c uint8_t) or
+//! UTF-16 (@a CharT is @c uint16_t) buffer.
+//!
+//! The UTF-8 buffer must be already validated. All characters which have a
+//! special meaning in XML are ASCII so the same state machine can be used for
+//! both encodings; non-ASCII UTF-8 bytes are always a part of a name or text.
+//!
+//! If @a input doesn't contain @c XML_SAX_INPUT_END the parsing stops before
+//! the first incomplete token and its offset is stored to @a consumed. The
+//! element depth is kept in @a depthPtr between the calls.
+template<typename CharT>
+static err_t XmlSaxParser_parse(XmlSaxHandler* handler, const CharT* sData, size_t sLength,
+  uint32_t input, uint32_t* depthPtr, size_t* consumed)
+{
+  // Check if encoded length is zero (no document).
+  if (sLength == 0 && input == XML_SAX_INPUT_DOCUMENT)
     return ERR_XML_SAX_NO_DOCUMENT;
 
-  const CharW* sPtr = sData;           // Current pointer.
-  const CharW* sEnd = sData + sLength; // End of buffer.
+  const CharT* sPtr = sData;           // Current pointer.
+  const CharT* sEnd = sData + sLength; // End of buffer.
 
-  const CharW* mark = sData;           // Mark to start position of currently parsed item.
+  const CharT* mark = sData;           // Mark to start position of currently parsed item.
 
-  const CharW* markTagStart  = NULL;   // Mark to start position of currently parsed tag name.
-  const CharW* markTagEnd    = NULL;   // Mark to end position of currently parsed tag name.
+  const CharT* markTagStart  = NULL;   // Mark to start position of currently parsed tag name.
+  const CharT* markTagEnd    = NULL;   // Mark to end position of currently parsed tag name.
 
-  const CharW* markAttrStart = NULL;   // Mark to start of attribute.
-  const CharW* markAttrEnd   = NULL;   // Mark to end of attribute.
+  const CharT* markAttrStart = NULL;   // Mark to start of attribute.
+  const CharT* markAttrEnd   = NULL;   // Mark to end of attribute.
 
-  const CharW* markDataStart = NULL;   // Mark to start of data (CDATA, Comment, attribute text, ...).
-  const CharW* markDataEnd   = NULL;   // Mark to end of data (CDATA, Comment, attribute text, ...).
+  const CharT* markDataStart = NULL;   // Mark to start of data (CDATA, Comment, attribute text, ...).
+  const CharT* markDataEnd   = NULL;   // Mark to end of data (CDATA, Comment, attribute text, ...).
 
-  CharW ch;                            // Current character.
-  CharW attr;                          // Attribute marker (' or ").
+  CharT ch;                            // Current character.
+  CharT attr = 0;                      // Attribute marker (' or ").
 
   err_t err = ERR_OK;                  // Current error code.
   uint state = XML_SAX_STATE_READY;    // Current state.
   uint element = XML_SAX_ELEMENT_TAG;  // Element type.
-  uint depth = 0;                      // Current depth.
+  uint depth = *depthPtr;              // Current depth.
 
   List<StringW> doctype;
 
   // TODO: Not used at this time.
   XmlSaxLocation location(0, 0);
 
-  _handler->onStartDocument();
+  if (input & XML_SAX_INPUT_START)
+    handler->onStartDocument();
+
   for (;;)
   {
 _Begin:
@@ -432,26 +860,41 @@ _Continue:
     {
       case XML_SAX_STATE_READY:
       {
-        // If xml char has special meaning, we will process it, otherwise go away.
-        if (ch == CharW('<'))
+        // Skip text to the next '<', the text is reported at once.
+        if (ch != '<')
         {
-          // If there is text, we will call addText().
-          if (mark != sPtr)
-          {
-            bool isWhiteSpace = XmlSaxParser_isWhiteSpace(mark, sPtr);
+          sPtr = XmlUtil_find(sPtr + 1, sEnd, (CharT)'<');
+          if (sPtr == sEnd)
+            goto _EndOfInput;
+        }
 
-            if (isWhiteSpace)
-              err = _handler->onIgnorableWhitespace(StubW(mark, (size_t)(sPtr - mark)));
-            else
-              err = _handler->onCharacterData(StubW(mark, (size_t)(sPtr - mark)));
+        // If there is text, we will call addText().
+        if (mark != sPtr)
+        {
+          bool isWhiteSpace = XmlSaxParser_isWhiteSpace(mark, sPtr);
 
-            if (FOG_IS_ERROR(err))
-              goto _End;
-          }
+          if (isWhiteSpace)
+            err = XmlSaxParser_onIgnorableWhitespace(handler, mark, (size_t)(sPtr - mark));
+          else
+            err = XmlSaxParser_onCharacterData(handler, mark, (size_t)(sPtr - mark));
 
-          state = XML_SAX_STATE_TAG_BEGIN;
-          mark = sPtr;
+          if (FOG_IS_ERROR(err))
+            goto _End;
         }
+
+        mark = sPtr;
+
+        // Incremental parsing, wait for the rest of the token.
+        if (!(input & XML_SAX_INPUT_END))
+        {
+          size_t scanned = 0;
+          uint32_t quote = 0;
+
+          if (!XmlSaxParser_isTokenComplete(sPtr, sEnd, &scanned, &quote))
+            goto _EndOfInput;
+        }
+
+        state = XML_SAX_STATE_TAG_BEGIN;
         break;
       }
 
@@ -466,19 +909,19 @@ _Continue:
         }
 
         // Match closing tag slash.
-        if (ch == CharW('/'))
+        if (ch == '/')
         {
           state = XML_SAX_STATE_TAG_CLOSE;
           break;
         }
 
-        if (ch == CharW('?'))
+        if (ch == '?')
         {
           state = XML_SAX_STATE_TAG_QUESTION_MARK;
           break;
         }
 
-        if (ch == CharW('!'))
+        if (ch == '!')
         {
           state = XML_SAX_STATE_TAG_EXCLAMATION_MARK;
           break;
@@ -503,7 +946,7 @@ _Continue:
         depth++;
         element = XML_SAX_ELEMENT_TAG;
 
-        err = _handler->onStartElement(StubW(markTagStart, (size_t)(markTagEnd - markTagStart)));
+        err = XmlSaxParser_onStartElement(handler, markTagStart, (size_t)(markTagEnd - markTagStart));
         if (FOG_IS_ERROR(err))
           goto _End;
 
@@ -527,18 +970,18 @@ _Continue:
         switch (element)
         {
           case XML_SAX_ELEMENT_TAG:
-            if (ch == CharW('/'))
+            if (ch == '/')
             {
               element = XML_SAX_ELEMENT_TAG_SELF_CLOSING;
               state = XML_SAX_STATE_TAG_END;
               sPtr++;
               goto _Begin;
             }
-            if (ch == CharW('>'))
+            if (ch == '>')
               goto _TagEnd;
             break;
           case XML_SAX_ELEMENT_XML:
-            if (ch == CharW('?'))
+            if (ch == '?')
             {
               state = XML_SAX_STATE_TAG_END;
               sPtr++;
@@ -566,7 +1009,7 @@ _Continue:
           ch = *sPtr;
         }
 
-        if (ch != CharW('='))
+        if (ch != '=')
         {
           err = ERR_XML_SAX_SYNTAX;
           goto _End;
@@ -584,7 +1027,7 @@ _Continue:
           ch = *sPtr;
         }
 
-        if (ch == CharW('\'') || ch == CharW('\"'))
+        if (ch == '\'' || ch == '\"')
         {
           attr = ch;
           state = XML_SAX_STATE_TAG_INSIDE_ATTRIBUTE_VALUE;
@@ -601,19 +1044,23 @@ _Continue:
       case XML_SAX_STATE_TAG_INSIDE_ATTRIBUTE_VALUE:
       {
         if (ch != attr)
-          break;
+        {
+          sPtr = XmlUtil_find(sPtr + 1, sEnd, attr);
+          if (sPtr == sEnd)
+            goto _EndOfInput;
+        }
 
         markDataEnd = sPtr;
         sPtr++;
         state = XML_SAX_STATE_TAG_INSIDE;
 
-        err = _handler->onAttribute(
-          StubW(markAttrStart, (size_t)(markAttrEnd - markAttrStart)),
-          StubW(markDataStart, (size_t)(markDataEnd - markDataStart)));
+        err = XmlSaxParser_onAttribute(handler,
+          markAttrStart, (size_t)(markAttrEnd - markAttrStart),
+          markDataStart, (size_t)(markDataEnd - markDataStart));
 
         if (FOG_IS_ERROR(err))
         {
-          err = _handler->onError(location, err);
+          err = handler->onError(location, err);
           if (FOG_IS_ERROR(err))
             goto _End;
         }
@@ -626,7 +1073,7 @@ _Continue:
         if (XmlUtil_isWhitespace(ch))
           break;
 
-        if (ch == CharW('>'))
+        if (ch == '>')
         {
 _TagEnd:
           state = XML_SAX_STATE_READY;
@@ -636,7 +1083,7 @@ _TagEnd:
           if (element == XML_SAX_ELEMENT_TAG_SELF_CLOSING)
           {
             depth--;
-            err = _handler->onEndElement(StubW(markTagStart, (size_t)(markTagEnd - markTagStart)));
+            err = XmlSaxParser_onEndElement(handler, markTagStart, (size_t)(markTagEnd - markTagStart));
             if (FOG_IS_ERROR(err))
               goto _End;
           }
@@ -649,7 +1096,7 @@ _TagEnd:
       case XML_SAX_STATE_TAG_CLOSE:
       {
         // Only possible sequence here is [StartTagSequence].
-        if (ch.isLetter() || ch == CharW('_') || ch == CharW(':'))
+        if (XmlUtil_isNameStartChar(ch))
         {
           state = XML_SAX_STATE_TAG_CLOSE_NAME;
           markTagStart = sPtr;
@@ -662,7 +1109,7 @@ _TagEnd:
 
       case XML_SAX_STATE_TAG_CLOSE_NAME:
       {
-        if (ch.isNumlet() || ch == CharW('_') || ch == CharW(':') || ch == CharW('-') || ch == CharW('.'))
+        if (XmlUtil_isNameChar(ch))
           break;
 
         state = XML_SAX_STATE_TAG_CLOSE_END;
@@ -674,13 +1121,13 @@ _TagEnd:
       case XML_SAX_STATE_TAG_CLOSE_END:
       {
         // This is we are waiting for.
-        if (ch == CharW('>'))
+        if (ch == '>')
         {
           state = XML_SAX_STATE_READY;
           mark = ++sPtr;
           depth--;
 
-          err = _handler->onEndElement(StubW(markTagStart, (size_t)(markTagEnd - markTagStart)));
+          err = XmlSaxParser_onEndElement(handler, markTagStart, (size_t)(markTagEnd - markTagStart));
           if (FOG_IS_ERROR(err))
             goto _End;
 
@@ -697,8 +1144,8 @@ _TagEnd:
 
       case XML_SAX_STATE_TAG_QUESTION_MARK:
       {
-        const CharW* targetStart = sPtr;
-        const CharW* targetEnd = sPtr;
+        const CharT* targetStart = sPtr;
+        const CharT* targetEnd = sPtr;
 
         // Parse 'Target'.
         if (XmlUtil_isNameStartChar(sPtr[0]))
@@ -738,7 +1185,7 @@ _TagEnd:
 
         // Special case '<?xml...'.
         if ((size_t)(targetEnd - targetStart) == 3 &&
-            StringUtil::eq(targetStart, "xml", 3, CASE_INSENSITIVE))
+            XmlUtil_eq(targetStart, "xml", 3, CASE_INSENSITIVE))
         {
           element = XML_SAX_ELEMENT_XML;
           state = XML_SAX_STATE_TAG_INSIDE;
@@ -746,44 +1193,39 @@ _TagEnd:
         }
 
         // Parse 'Data'.
-        const CharW* q = sEnd - 1;
-
-        while (sPtr < q && (sPtr[0] != CharW('?') || sPtr[1] != CharW('>')))
-          sPtr++;
-
-        if (sPtr == q)
+        sPtr = XmlUtil_find2<CharT>(sPtr, sEnd, '?', '>');
+        if (sPtr == sEnd)
         {
           err = ERR_XML_SAX_SYNTAX;
           goto _End;
         }
-        else
-        {
-          markDataEnd = sPtr;
-          sPtr += 2;
 
-          state = XML_SAX_STATE_READY;
-          mark = sPtr;
+        markDataEnd = sPtr;
+        sPtr += 2;
 
-          err = _handler->onProcessingInstruction(
-            StubW(targetStart, (size_t)(targetEnd - targetStart)),
-            StubW(markDataStart, (size_t)(markDataEnd - markDataStart)));
+        state = XML_SAX_STATE_READY;
+        mark = sPtr;
 
-          if (FOG_IS_ERROR(err))
-            goto _End;
+        err = XmlSaxParser_onProcessingInstruction(handler,
+          targetStart, (size_t)(targetEnd - targetStart),
+          markDataStart, (size_t)(markDataEnd - markDataStart));
 
-          goto _Begin;
-        }
+        if (FOG_IS_ERROR(err))
+          goto _End;
+
+        goto _Begin;
       }
 
       case XML_SAX_STATE_TAG_EXCLAMATION_MARK:
       {
-        if ((size_t)(sEnd - sPtr) > 1 && StringUtil::eq(sPtr, "--", 2, CASE_SENSITIVE))
+        if ((size_t)(sEnd - sPtr) > 1 && XmlUtil_eq(sPtr, "--", 2, CASE_SENSITIVE))
         {
           state = XML_SAX_STATE_COMMENT;
-          sPtr += 3;
+          sPtr += 2;
+          markDataStart = sPtr;
           goto _Begin;
         }
-        else if ((size_t)(sEnd - sPtr) > 7 && StringUtil::eq(sPtr, "DOCTYPE", 7, CASE_SENSITIVE) && XmlUtil_isWhitespace(sPtr[7]))
+        else if ((size_t)(sEnd - sPtr) > 7 && XmlUtil_eq(sPtr, "DOCTYPE", 7, CASE_SENSITIVE) && XmlUtil_isWhitespace(sPtr[7]))
         {
           element = XML_SAX_ELEMENT_DOCTYPE;
           state = XML_SAX_STATE_DOCTYPE;
@@ -791,11 +1233,12 @@ _TagEnd:
           doctype.clear();
           goto _Begin;
         }
-        else if ((size_t)(sEnd - sPtr) > 6 && StringUtil::eq(sPtr, "[CDATA[", 7, CASE_SENSITIVE))
+        else if ((size_t)(sEnd - sPtr) > 6 && XmlUtil_eq(sPtr, "[CDATA[", 7, CASE_SENSITIVE))
         {
           element = XML_SAX_ELEMENT_CDATA;
           state = XML_SAX_STATE_CDATA;
           sPtr += 7;
+          markDataStart = sPtr;
           goto _Begin;
         }
         else
@@ -807,24 +1250,24 @@ _TagEnd:
 
       case XML_SAX_STATE_DOCTYPE:
       {
-        if (ch.isSpace()) break;
+        if (XmlUtil_isWhitespace(ch)) break;
 
         if (doctype.getLength() < 2)
         {
-          if (ch.isLetter() || ch == CharW('_'))
+          if (XmlUtil_isNameStartChar(ch))
           {
             state = XML_SAX_STATE_DOCTYPE_TEXT;
-            markDataStart = ++sPtr;
-            goto _Begin;
+            markDataStart = sPtr;
+            break;
           }
 
           // End of DOCTYPE
-          if (ch == CharW('>'))
+          if (ch == '>')
             goto _DOCTYPEEnd;
         }
         else
         {
-          if (ch == CharW('\"'))
+          if (ch == '\"')
           {
             if (doctype.getLength() < 4)
             {
@@ -838,13 +1281,13 @@ _TagEnd:
               goto _End;
             }
           }
-          if (ch == CharW('>'))
+          if (ch == '>')
           {
 _DOCTYPEEnd:
-            err = _handler->onDOCTYPE(doctype);
+            err = handler->onDOCTYPE(doctype);
 
             if (FOG_IS_ERROR(err))
-              return err;
+              goto _End;
 
             state = XML_SAX_STATE_READY;
             mark = ++sPtr;
@@ -853,14 +1296,17 @@ _DOCTYPEEnd:
         }
 
         err = ERR_XML_SAX_SYNTAX;
-        break;
+        goto _End;
       }
 
       case XML_SAX_STATE_DOCTYPE_TEXT:
       {
-        if (ch.isNumlet() || ch == CharW('_') || ch == CharW(':') || ch == CharW('-') || ch == CharW('.')) break;
+        if (XmlUtil_isNameChar(ch)) break;
         markDataEnd = sPtr;
-        doctype.append(StubW(markDataStart, (size_t)(markDataEnd - markDataStart)));
+
+        err = XmlSaxParser_addDOCTYPE(doctype, markDataStart, (size_t)(markDataEnd - markDataStart));
+        if (FOG_IS_ERROR(err))
+          goto _End;
 
         state = XML_SAX_STATE_DOCTYPE;
         goto _Continue;
@@ -868,10 +1314,12 @@ _DOCTYPEEnd:
 
       case XML_SAX_STATE_DOCTYPE_ATTRIBUTE:
       {
-        if (ch != CharW('\"')) break;
-
+        if (ch != '\"') break;
         markDataEnd = sPtr;
-        doctype.append(StringW(markDataStart, (size_t)(markDataEnd - markDataStart)));
+
+        err = XmlSaxParser_addDOCTYPE(doctype, markDataStart, (size_t)(markDataEnd - markDataStart));
+        if (FOG_IS_ERROR(err))
+          goto _End;
 
         state = XML_SAX_STATE_DOCTYPE;
         break;
@@ -879,58 +1327,46 @@ _DOCTYPEEnd:
 
       case XML_SAX_STATE_COMMENT:
       {
-        const CharW* q = sEnd - 2;
-
-        while (sPtr < q && (sPtr[0] != CharW('-') || sPtr[1] != CharW('-') || sPtr[2] != CharW('>')))
-          sPtr++;
-
-        if (sPtr == q)
+        sPtr = XmlUtil_find3<CharT>(sPtr, sEnd, '-', '-', '>');
+        if (sPtr == sEnd)
         {
           err = ERR_XML_SAX_SYNTAX;
           goto _End;
         }
-        else
-        {
-          markDataEnd = sPtr;
-          sPtr += 3;
 
-          state = XML_SAX_STATE_READY;
-          mark = sPtr;
+        markDataEnd = sPtr;
+        sPtr += 3;
 
-          err = _handler->onComment(StubW(markDataStart, (size_t)(markDataEnd - markDataStart)));
-          if (FOG_IS_ERROR(err))
-            goto _End;
+        state = XML_SAX_STATE_READY;
+        mark = sPtr;
 
-          goto _Begin;
-        }
+        err = XmlSaxParser_onComment(handler, markDataStart, (size_t)(markDataEnd - markDataStart));
+        if (FOG_IS_ERROR(err))
+          goto _End;
+
+        goto _Begin;
       }
 
       case XML_SAX_STATE_CDATA:
       {
-        const CharW* q = sEnd - 2;
-
-        while (sPtr < q && sPtr[0] != CharW(']') && sPtr[1] != CharW(']') && sPtr[2] != CharW('>'))
-          sPtr++;
-
-        if (sPtr == q)
+        sPtr = XmlUtil_find3<CharT>(sPtr, sEnd, ']', ']', '>');
+        if (sPtr == sEnd)
         {
           err = ERR_XML_SAX_SYNTAX;
           goto _End;
         }
-        else
-        {
-          markDataEnd = sPtr;
-          sPtr += 3;
 
-          state = XML_SAX_STATE_READY;
-          mark = sPtr;
+        markDataEnd = sPtr;
+        sPtr += 3;
 
-          err = _handler->onCDATASection(StubW(markDataStart, (size_t)(markDataEnd - markDataStart)));
-          if (FOG_IS_ERROR(err))
-            goto _End;
+        state = XML_SAX_STATE_READY;
+        mark = sPtr;
 
-          goto _Begin;
-        }
+        err = XmlSaxParser_onCDATASection(handler, markDataStart, (size_t)(markDataEnd - markDataStart));
+        if (FOG_IS_ERROR(err))
+          goto _End;
+
+        goto _Begin;
       }
 
       default:
@@ -944,14 +1380,322 @@ _DOCTYPEEnd:
   }
 
 _EndOfInput:
+  if (!(input & XML_SAX_INPUT_END))
+  {
+    // Only complete tokens are parsed, so the state machine must be ready.
+    if (state == XML_SAX_STATE_READY)
+    {
+      *depthPtr = depth;
+      *consumed = (size_t)(mark - sData);
+      return ERR_OK;
+    }
+
+    err = ERR_XML_SAX_SYNTAX;
+    goto _End;
+  }
+
   if (depth > 0 || state != XML_SAX_STATE_READY)
   {
     err = ERR_XML_SAX_SYNTAX;
   }
 
 _End:
-  _handler->onEndDocument();
+  handler->onEndDocument();
+  return err;
+}
+
+// ============================================================================
+// [Fog::XmlSaxParser - Construction / Destruction]
+// ============================================================================
+
+XmlSaxParser::XmlSaxParser(XmlSaxHandler* handler) :
+  _handler(handler),
+  _feedFlags(0),
+  _feedDepth(0),
+  _feedValid(0),
+  _feedScanned(0),
+  _feedQuote(0),
+  _feedError(ERR_OK),
+  _feedCodec(TextCodec::utf8())
+{
+}
+
+XmlSaxParser::~XmlSaxParser()
+{
+}
+
+// ============================================================================
+// [Fog::XmlSaxParser - Parse]
+// ============================================================================
+
+err_t XmlSaxParser::parseFile(const StringW& fileName)
+{
+  // Map the file instead of reading it, UTF-8 document is then parsed in-place.
+  FileMapping mapping;
+  err_t err = mapping.open(fileName, FILE_MAPPING_FLAG_LOAD_FALLBACK);
+
+  if (FOG_IS_ERROR(err)) 
+    return err;
+
+  return parseMemory(mapping.getData(), mapping.getLength());
+}
+
+err_t XmlSaxParser::parseStream(Stream& stream)
+{
+  StringA buffer;
+  stream.readAll(buffer);
+  return parseMemory(reinterpret_cast<const void*>(buffer.getData()), buffer.getLength());
+}
+
+err_t XmlSaxParser::parseMemory(const void* mem, size_t size)
+{
+  TextCodec textCodec = TextCodec::utf8();
+  XmlSaxParser_detectEncoding(textCodec, mem, size);
+
+  // UTF-8 document is validated and parsed without conversion, the handler
+  // gets slices of the source buffer and converts only what it needs.
+  if (textCodec.getCode() == TEXT_ENCODING_UTF8)
+  {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(mem);
+
+    if (size >= 3 && p[0] == 0xEF && p[1] == 0xBB && p[2] == 0xBF)
+    {
+      p += 3;
+      size -= 3;
+    }
+
+    FOG_RETURN_ON_ERROR(StringUtil::validateUtf8(reinterpret_cast<const char*>(p), size, NULL));
+
+    uint32_t depth = 0;
+    return XmlSaxParser_parse<uint8_t>(_handler, p, size, XML_SAX_INPUT_DOCUMENT, &depth, NULL);
+  }
+
+  StringW buffer;
+  err_t err = textCodec.decode(buffer, StubA(reinterpret_cast<const char*>(mem), size));
+
+  if (FOG_IS_ERROR(err))
+    return err;
+
+  return parseString(StubW(buffer.getData(), buffer.getLength()));
+}
+
+err_t XmlSaxParser::parseString(const StringW& str)
+{
+  return parseString(StubW(str.getData(), str.getLength()));
+}
+
+err_t XmlSaxParser::parseString(const StubW& str)
+{
+  const CharW* sData = str.getData();
+  size_t sLength = str.getComputedLength();
+
+  if (sLength == DETECT_LENGTH)
+    sLength = StringUtil::len(sData);
+
+  uint32_t depth = 0;
+  return XmlSaxParser_parse<uint16_t>(_handler, reinterpret_cast<const uint16_t*>(sData), sLength,
+    XML_SAX_INPUT_DOCUMENT, &depth, NULL);
+}
+
+// ============================================================================
+// [Fog::XmlSaxParser - Parse - Incremental]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief End the document started by the incremental parser after an error
+//! which didn't come from the state machine (which ends the document itself).
+static err_t XmlSaxParser_feedAbort(XmlSaxParser* self, err_t err)
+{
+  if (self->_feedFlags & XML_SAX_FEED_STARTED)
+    self->_handler->onEndDocument();
   return err;
 }
 
+template<typename CharT>
+static err_t XmlSaxParser_feedParse(XmlSaxParser* self, const CharT* data, size_t length, bool isFinal, size_t* consumed)
+{
+  uint32_t input = 0;
+  *consumed = 0;
+
+  // Don't parse until the first token is complete. The buffered input grows
+  // by each chunk, but the scan continues where it previously stopped.
+  if (!isFinal && length != 0 &&
+      !XmlSaxParser_isTokenComplete(data, data + length, &self->_feedScanned, &self->_feedQuote))
+  {
+    return ERR_OK;
+  }
+
+  if (!(self->_feedFlags & XML_SAX_FEED_STARTED))
+  {
+    if (length == 0 && !isFinal)
+      return ERR_OK;
+
+    input |= XML_SAX_INPUT_START;
+    self->_feedFlags |= XML_SAX_FEED_STARTED;
+  }
+
+  if (isFinal)
+    input |= XML_SAX_INPUT_END;
+
+  return XmlSaxParser_parse<CharT>(self->_handler, data, length, input, &self->_feedDepth, consumed);
+}
+
+static err_t XmlSaxParser_feedUtf8(XmlSaxParser* self, const uint8_t* data, size_t length, bool isFinal, size_t* consumed)
+{
+  // Validate the input which was not validated yet. An incomplete sequence at
+  // the end is not parsed, it's validated again when more input is available.
+  size_t valid = self->_feedValid;
+  size_t validated;
+
+  err_t err = StringUtil::validateUtf8(
+    reinterpret_cast<const char*>(data) + valid, length - valid, &validated);
+  valid += validated;
+
+  if (FOG_IS_ERROR(err) && (err != ERR_STRING_TRUNCATED || isFinal))
+    return XmlSaxParser_feedAbort(self, err);
+
+  FOG_RETURN_ON_ERROR(XmlSaxParser_feedParse<uint8_t>(self, data, valid, isFinal, consumed));
+
+  self->_feedValid = valid - *consumed;
+  return ERR_OK;
+}
+
+static err_t XmlSaxParser_feed(XmlSaxParser* self, const uint8_t* data, size_t size, bool isFinal)
+{
+  err_t err;
+  size_t consumed;
+
+  // --------------------------------------------------------------------------
+  // [Detect Encoding]
+  // --------------------------------------------------------------------------
+
+  if (!(self->_feedFlags & XML_SAX_FEED_DETECTED))
+  {
+    err = self->_feedBuffer.append(StubA(reinterpret_cast<const char*>(data), size));
+    if (FOG_IS_ERROR(err))
+      return err;
+
+    const uint8_t* bData = reinterpret_cast<const uint8_t*>(self->_feedBuffer.getData());
+    size_t bLength = self->_feedBuffer.getLength();
+
+    // Wait for the XML declaration (or the first tag) to be complete.
+    if (!isFinal && ::memchr(bData, '>', bLength) == NULL)
+      return ERR_OK;
+
+    XmlSaxParser_detectEncoding(self->_feedCodec, bData, bLength);
+    self->_feedFlags |= XML_SAX_FEED_DETECTED;
+
+    if (self->_feedCodec.getCode() == TEXT_ENCODING_UTF8)
+    {
+      if (bLength >= 3 && bData[0] == 0xEF && bData[1] == 0xBB && bData[2] == 0xBF)
+        self->_feedBuffer.remove(Range(0, 3));
+    }
+    else
+    {
+      self->_feedFlags |= XML_SAX_FEED_UTF16;
+
+      err = self->_feedCodec.decode(self->_feedBufferW,
+        StubA(reinterpret_cast<const char*>(bData), bLength), &self->_feedCodecState);
+      self->_feedBuffer.reset();
+
+      if (FOG_IS_ERROR(err))
+        return err;
+    }
+
+    // The input is already buffered.
+    size = 0;
+  }
+
+  // --------------------------------------------------------------------------
+  // [UTF-16]
+  // --------------------------------------------------------------------------
+
+  if (self->_feedFlags & XML_SAX_FEED_UTF16)
+  {
+    if (size != 0)
+    {
+      err = self->_feedCodec.decode(self->_feedBufferW,
+        StubA(reinterpret_cast<const char*>(data), size), &self->_feedCodecState, CONTAINER_OP_APPEND);
+
+      if (FOG_IS_ERROR(err))
+        return XmlSaxParser_feedAbort(self, err);
+    }
+
+    if (isFinal && self->_feedCodecState.isIncomplete())
+      return XmlSaxParser_feedAbort(self, ERR_STRING_TRUNCATED);
+
+    FOG_RETURN_ON_ERROR(XmlSaxParser_feedParse<uint16_t>(self,
+      reinterpret_cast<const uint16_t*>(self->_feedBufferW.getData()), self->_feedBufferW.getLength(),
+      isFinal, &consumed));
+
+    return self->_feedBufferW.remove(Range(0, consumed));
+  }
+
+  // --------------------------------------------------------------------------
+  // [UTF-8]
+  // --------------------------------------------------------------------------
+
+  // Nothing is buffered, parse the input in place and keep only its tail.
+  if (self->_feedBuffer.isEmpty())
+  {
+    FOG_RETURN_ON_ERROR(XmlSaxParser_feedUtf8(self, data, size, isFinal, &consumed));
+
+    if (isFinal)
+      return ERR_OK;
+
+    return self->_feedBuffer.set(
+      StubA(reinterpret_cast<const char*>(data) + consumed, size - consumed));
+  }
+
+  err = self->_feedBuffer.append(StubA(reinterpret_cast<const char*>(data), size));
+  if (FOG_IS_ERROR(err))
+    return XmlSaxParser_feedAbort(self, err);
+
+  FOG_RETURN_ON_ERROR(XmlSaxParser_feedUtf8(self,
+    reinterpret_cast<const uint8_t*>(self->_feedBuffer.getData()), self->_feedBuffer.getLength(),
+    isFinal, &consumed));
+
+  return self->_feedBuffer.remove(Range(0, consumed));
+}
+
+err_t XmlSaxParser::feed(const void* data, size_t size)
+{
+  if (FOG_IS_ERROR(_feedError))
+    return _feedError;
+
+  err_t err = XmlSaxParser_feed(this, reinterpret_cast<const uint8_t*>(data), size, false);
+  if (FOG_IS_ERROR(err))
+    _feedError = err;
+
+  return err;
+}
+
+err_t XmlSaxParser::finish()
+{
+  err_t err = _feedError;
+
+  if (!FOG_IS_ERROR(err))
+    err = XmlSaxParser_feed(this, NULL, 0, true);
+
+  reset();
+  return err;
+}
+
+void XmlSaxParser::reset()
+{
+  _feedFlags = 0;
+  _feedDepth = 0;
+  _feedValid = 0;
+  _feedScanned = 0;
+  _feedQuote = 0;
+  _feedError = ERR_OK;
+
+  _feedBuffer.reset();
+  _feedBufferW.reset();
+
+  _feedCodec = TextCodec::utf8();
+  _feedCodecState.reset();
+}
+
 } // Fog namespace
@@ -105,6 +105,28 @@ struct FOG_API XmlSaxHandler
   virtual err_t onError(const XmlSaxLocation& location, err_t errorCode) = 0;
   virtual err_t onFatal(const XmlSaxLocation& location, err_t errorCode) = 0;
 
+  // --------------------------------------------------------------------------
+  // [SAX - Interface (UTF-8)]
+  // --------------------------------------------------------------------------
+
+  //! @brief Events emitted when parsing UTF-8 encoded document.
+  //!
+  //! The data are slices of the source buffer (no copy is made). The default
+  //! implementation converts them to UTF-16 using a temporary string and calls
+  //! the UTF-16 event, reimplement them to convert only what is kept.
+
+  virtual err_t onStartElementUtf8(const StubA& tagName);
+  virtual err_t onEndElementUtf8(const StubA& tagName);
+
+  virtual err_t onAttributeUtf8(const StubA& name, const StubA& value);
+
+  virtual err_t onCharacterDataUtf8(const StubA& data);
+  virtual err_t onIgnorableWhitespaceUtf8(const StubA& data);
+
+  virtual err_t onCDATASectionUtf8(const StubA& data);
+  virtual err_t onCommentUtf8(const StubA& data);
+  virtual err_t onProcessingInstructionUtf8(const StubA& target, const StubA& data);
+
 private:
   FOG_NO_COPY(XmlSaxHandler)
 };
@@ -142,6 +164,25 @@ struct FOG_API XmlSaxParser
   err_t parseString(const StringW& str);
   err_t parseString(const StubW& str);
 
+  // --------------------------------------------------------------------------
+  // [Parse - Incremental]
+  // --------------------------------------------------------------------------
+
+  //! @brief Parse the next chunk of a document.
+  //!
+  //! SAX events are emitted as soon as they are complete, the unfinished part
+  //! of the input (the last token - text, tag, comment, ...) is kept and parsed
+  //! with the next chunk.
+  err_t feed(const void* data, size_t size);
+
+  //! @brief Parse the rest of the document passed to @c feed() and end it.
+  //!
+  //! The incremental parser is reset so a new document can be fed.
+  err_t finish();
+
+  //! @brief Discard the document passed to @c feed().
+  void reset();
+
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
@@ -149,6 +190,31 @@ struct FOG_API XmlSaxParser
   //! @brief SAX handler.
   XmlSaxHandler* _handler;
 
+  //! @brief Incremental parser flags.
+  uint32_t _feedFlags;
+  //! @brief Incremental parser depth.
+  uint32_t _feedDepth;
+  //! @brief Length of validated UTF-8 at the start of @c _feedBuffer.
+  size_t _feedValid;
+  //! @brief Length of the incomplete token already scanned for its end.
+  size_t _feedScanned;
+  //! @brief Quote character of the incomplete token (if scanned to its
+  //! attribute value).
+  uint32_t _feedQuote;
+  //! @brief Incremental parser error (returned until the parser is reset).
+  err_t _feedError;
+
+  //! @brief Unparsed input (UTF-8 document or input before the encoding is
+  //! detected).
+  StringA _feedBuffer;
+  //! @brief Unparsed input converted to UTF-16 (document not in UTF-8).
+  StringW _feedBufferW;
+
+  //! @brief Text codec used to convert the document not in UTF-8.
+  TextCodec _feedCodec;
+  //! @brief Text codec state.
+  TextCodecState _feedCodecState;
+
 private:
   FOG_NO_COPY(XmlSaxParser)
 };
@@ -90,6 +90,7 @@
 #include <Fog/G2d/Imaging/ImageFilterScale.h>
 #include <Fog/G2d/Imaging/ImageFormatDescription.h>
 #include <Fog/G2d/Imaging/ImagePalette.h>
+#include <Fog/G2d/Imaging/ImagePipeline.h>
 #include <Fog/G2d/Imaging/Filters/FeBase.h>
 #include <Fog/G2d/Imaging/Filters/FeBlur.h>
 #include <Fog/G2d/Imaging/Filters/FeBorder.h>
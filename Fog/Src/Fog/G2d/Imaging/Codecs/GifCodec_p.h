@@ -0,0 +1,299 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_IMAGING_CODECS_GIFCODEC_P_H
+#define _FOG_G2D_IMAGING_CODECS_GIFCODEC_P_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Memory/MemBuffer.h>
+#include <Fog/Core/Tools/List.h>
+#include <Fog/Core/Tools/String.h>
+#include <Fog/G2d/Imaging/Image.h>
+#include <Fog/G2d/Imaging/ImageCodec.h>
+#include <Fog/G2d/Imaging/ImageCodecProvider.h>
+#include <Fog/G2d/Imaging/ImageDecoder.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Imaging
+//! @{
+
+// ============================================================================
+// [Fog::GIF_BLOCK]
+// ============================================================================
+
+//! @internal
+enum GIF_BLOCK
+{
+  GIF_BLOCK_EXTENSION = 0x21,
+  GIF_BLOCK_IMAGE = 0x2C,
+  GIF_BLOCK_TRAILER = 0x3B
+};
+
+// ============================================================================
+// [Fog::GIF_EXTENSION]
+// ============================================================================
+
+//! @internal
+enum GIF_EXTENSION
+{
+  GIF_EXTENSION_TEXT = 0x01,
+  GIF_EXTENSION_CONTROL = 0xF9,
+  GIF_EXTENSION_COMMENT = 0xFE,
+  GIF_EXTENSION_APPLICATION = 0xFF
+};
+
+// ============================================================================
+// [Fog::GIF_DISPOSAL]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief What to do with the frame area before the next frame is drawn.
+enum GIF_DISPOSAL
+{
+  //! @brief Not specified, handled as @c GIF_DISPOSAL_KEEP.
+  GIF_DISPOSAL_NONE = 0,
+  //! @brief Keep the frame.
+  GIF_DISPOSAL_KEEP = 1,
+  //! @brief Clear the frame area (to transparent).
+  GIF_DISPOSAL_BACKGROUND = 2,
+  //! @brief Restore the frame area to the state before the frame was drawn.
+  GIF_DISPOSAL_PREVIOUS = 3
+};
+
+// ============================================================================
+// [Fog::GIF_FRAME_FLAGS]
+// ============================================================================
+
+//! @internal
+enum GIF_FRAME_FLAGS
+{
+  //! @brief Frame has a transparent color index.
+  GIF_FRAME_TRANSPARENT = 0x01,
+  //! @brief Frame is interlaced.
+  GIF_FRAME_INTERLACED = 0x02,
+  //! @brief Frame has a local palette.
+  GIF_FRAME_LOCAL_PALETTE = 0x04,
+  //! @brief Frame covers the whole logical screen.
+  GIF_FRAME_FULL = 0x08,
+  //! @brief Frame doesn't depend on the previous frames, decoding can start
+  //! from it.
+  GIF_FRAME_KEY = 0x10,
+  //! @brief Canvas can contain transparent pixels after the frame is drawn.
+  GIF_FRAME_ALPHA = 0x20,
+  //! @brief Image data of the frame are truncated.
+  GIF_FRAME_TRUNCATED = 0x40
+};
+
+// ============================================================================
+// [Fog::GIF_LZW]
+// ============================================================================
+
+//! @internal
+enum GIF_LZW
+{
+  //! @brief Maximum bits per LZW code.
+  GIF_LZW_MAX_BITS = 12,
+  //! @brief Maximum count of LZW codes.
+  GIF_LZW_MAX_CODES = 4096
+};
+
+// ============================================================================
+// [Fog::GifFrame]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Information about a GIF frame, collected when the frame is read
+//! or skipped.
+struct GifFrame
+{
+  //! @brief Stream position of the first block of the frame.
+  int64_t offset;
+
+  //! @brief Frame left position.
+  uint16_t x;
+  //! @brief Frame top position.
+  uint16_t y;
+  //! @brief Frame width.
+  uint16_t w;
+  //! @brief Frame height.
+  uint16_t h;
+
+  //! @brief Frame delay in 1/100 of second.
+  uint16_t delay;
+  //! @brief Disposal method, see @c GIF_DISPOSAL.
+  uint8_t disposal;
+  //! @brief Transparent color index (valid if @c GIF_FRAME_TRANSPARENT is set).
+  uint8_t transparent;
+
+  //! @brief LZW minimum code size.
+  uint8_t lzwBits;
+  //! @brief Reserved.
+  uint8_t reserved[3];
+  //! @brief Frame flags, see @c GIF_FRAME_FLAGS.
+  uint32_t flags;
+};
+
+//! @}
+
+} // Fog namespace
+
+// ============================================================================
+// [Fog::TypeInfo<>]
+// ============================================================================
+
+_FOG_TYPE_DECLARE(Fog::GifFrame, Fog::TYPE_CATEGORY_SIMPLE)
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Imaging
+//! @{
+
+// ============================================================================
+// [Fog::GifCodecProvider]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT GifCodecProvider : public ImageCodecProvider
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  GifCodecProvider();
+  virtual ~GifCodecProvider();
+
+  // --------------------------------------------------------------------------
+  // [Implementation]
+  // --------------------------------------------------------------------------
+
+  virtual uint32_t checkSignature(const void* mem, size_t length) const;
+  virtual err_t createCodec(uint32_t codecType, ImageCodec** codec) const;
+};
+
+// ============================================================================
+// [Fog::GifDecoder]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief GIF decoder.
+//!
+//! Each call to @c readImage() returns the next frame of the animation
+//! composited to the logical screen (disposal methods and transparency are
+//! handled). The frame returned by the next @c readImage() call can be
+//! changed by setting the "actualFrame" property, which decodes only the
+//! frames since the nearest key frame. Only the canvas, the indexes of the
+//! rows of one frame which intersect the canvas and the compressed data of
+//! one frame are held in memory.
+//!
+//! Decoder properties:
+//!
+//!   - "actualFrame" - Index of the frame returned by the next @c readImage()
+//!     call (can be set).
+//!   - "framesCount" - Count of frames, 0xFFFFFFFF until the end of the
+//!     stream was found.
+//!   - "delay" - Delay of the last returned frame in milliseconds.
+//!   - "loopCount" - Count of animation loops (0 means forever).
+struct FOG_NO_EXPORT GifDecoder : public ImageDecoder
+{
+  FOG_DECLARE_OBJECT(GifDecoder, ImageDecoder)
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  GifDecoder(ImageCodecProvider* provider);
+  virtual ~GifDecoder();
+
+  // --------------------------------------------------------------------------
+  // [Properties]
+  // --------------------------------------------------------------------------
+
+  virtual err_t _getProperty(const InternedStringW& name, Var& dst) const;
+  virtual err_t _setProperty(const InternedStringW& name, const Var& src);
+
+  // --------------------------------------------------------------------------
+  // [Implementation]
+  // --------------------------------------------------------------------------
+
+  virtual void reset();
+  virtual err_t readHeader();
+  virtual err_t readImage(Image& image);
+
+  // --------------------------------------------------------------------------
+  // [Frames]
+  // --------------------------------------------------------------------------
+
+  //! @brief Make @a index the frame returned by the next @c readImage() call.
+  err_t seekFrame(uint32_t index);
+
+  // --------------------------------------------------------------------------
+  // [Helpers]
+  // --------------------------------------------------------------------------
+
+  //! @brief Read the blocks of the frame at the current stream position.
+  //!
+  //! If @a readData is true the local palette and the compressed data are
+  //! stored into @c _localPalette and @c _data, otherwise they are skipped.
+  err_t _parseFrame(GifFrame& frame, bool readData);
+
+  //! @brief Read the frame @a index (which must be indexed or be the next
+  //! frame in the stream) including its data.
+  err_t _readFrame(uint32_t index, GifFrame& frame);
+
+  //! @brief Decode the frame read by @c _readFrame() and draw it to the
+  //! canvas.
+  err_t _drawFrame(const GifFrame& frame, bool notify);
+
+  //! @brief Apply the disposal method of the last drawn frame.
+  void _disposeFrame();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Global palette (PRGB32, always 256 entries).
+  uint32_t _globalPalette[256];
+  //! @brief Local palette of the last read frame (PRGB32, always 256 entries).
+  uint32_t _localPalette[256];
+  //! @brief Whether the global palette is present.
+  uint32_t _hasGlobalPalette;
+
+  //! @brief Frames found so far.
+  List<GifFrame> _frames;
+  //! @brief Stream position after the last frame in @c _frames.
+  int64_t _scanOffset;
+
+  //! @brief Animation loop count.
+  int _loopCount;
+  //! @brief Delay of the last returned frame (in milliseconds).
+  int _delay;
+
+  //! @brief Canvas (logical screen), PRGB32 or XRGB32.
+  Image _canvas;
+  //! @brief The last drawn frame, its disposal method wasn't applied yet.
+  GifFrame _lastFrame;
+  //! @brief Whether @c _lastFrame is valid.
+  uint32_t _hasLastFrame;
+
+  //! @brief Compressed data of the last read frame.
+  StringA _data;
+  //! @brief Decoded color indexes of the frame.
+  MemBuffer _indexBuffer;
+  //! @brief Canvas area saved by @c GIF_DISPOSAL_PREVIOUS frame.
+  MemBuffer _savedBuffer;
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_IMAGING_CODECS_GIFCODEC_P_H
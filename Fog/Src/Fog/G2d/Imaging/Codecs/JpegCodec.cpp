@@ -14,7 +14,9 @@
 
 // [Dependencies]
 #include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Memory/MemBuffer.h>
 #include <Fog/Core/Memory/MemBufferTmp_p.h>
+#include <Fog/Core/Memory/MemOps.h>
 #include <Fog/Core/OS/Library.h>
 #include <Fog/Core/Tools/InternedString.h>
 #include <Fog/Core/Tools/Logger.h>
@@ -87,7 +89,12 @@ err_t JpegLibrary::init()
     "jpeg_finish_decompress\0"
     "jpeg_resync_to_restart\0"
     "jpeg_destroy_compress\0"
-    "jpeg_destroy_decompress\0";
+    "jpeg_destroy_decompress\0"
+    "jpeg_has_multiple_scans\0"
+    "jpeg_start_output\0"
+    "jpeg_finish_output\0"
+    "jpeg_input_complete\0"
+    "jpeg_consume_input\0";
 
   if (dll.openLibrary(StringW::fromAscii8("jpeg")) != ERR_OK)
   {
@@ -185,12 +192,14 @@ err_t JpegCodecProvider::createCodec(uint32_t codecType, ImageCodec** codec) con
 // ===========================================================================
 
 JpegDecoder::JpegDecoder(ImageCodecProvider* provider) :
-  ImageDecoder(provider)
+  ImageDecoder(provider),
+  _rowsState(NULL)
 {
 }
 
 JpegDecoder::~JpegDecoder()
 {
+  _destroyRowsState();
 }
 
 // ===========================================================================
@@ -295,6 +304,7 @@ static void FOG_CDECL MyJpegMessage(j_common_ptr cinfo)
 
 void JpegDecoder::reset()
 {
+  _destroyRowsState();
   ImageDecoder::reset();
 }
 
@@ -353,9 +363,12 @@ err_t JpegDecoder::readHeader()
   {
     case JCS_GRAYSCALE:
       _depth = 8;
+      _format = IMAGE_FORMAT_I8;
+      _palette = ImagePalette::fromGreyscale(256);
       break;
     default:
       _depth = 24;
+      _format = IMAGE_FORMAT_RGB24;
       break;
   }
 
@@ -390,6 +403,10 @@ err_t JpegDecoder::readImage(Image& image)
   uint32_t format = IMAGE_FORMAT_RGB24;
   int bpp = 3;
 
+  bool buffered = false;
+  ImageConverter converter;
+  ImageConverterClosure closure;
+
   // Create a decompression structure and load the header.
   cinfo.err = jpeg.std_error(&jerr.errmgr);
   jerr.errmgr.error_exit = MyJpegErrorExit;
@@ -404,6 +421,10 @@ err_t JpegDecoder::readImage(Image& image)
 
   jpeg.create_decompress(&cinfo, JPEG_LIB_VERSION, sizeof(struct jpeg_decompress_struct));
 
+  // The header was already read by readHeader(), start from the beginning.
+  if (isHeaderDone())
+    _stream.seek((int64_t)_attachedOffset, STREAM_SEEK_SET);
+
   cinfo.src = (struct jpeg_source_mgr *)&srcmgr;
   srcmgr.pub.init_source = MyJpegInitSource;
   srcmgr.pub.fill_input_buffer = MyJpegFillInputBuffer;
@@ -430,6 +451,11 @@ err_t JpegDecoder::readImage(Image& image)
     goto _End;
   }
 
+  // Progressive JPEG is decoded in buffered-image mode if there is a handler
+  // which wants to display the image after each scan.
+  buffered = _handler != NULL && jpeg.has_multiple_scans(&cinfo);
+  cinfo.buffered_image = buffered;
+
   jpeg.start_decompress(&cinfo);
 
   // Set 8 or 24-bit output.
@@ -458,28 +484,18 @@ err_t JpegDecoder::readImage(Image& image)
     cinfo.quantize_colors = false;
   }
 
+  _format = format;
+  if (FOG_IS_ERROR(err = _notifyHeader())) goto _End;
+
   // Create the image.
   if (FOG_IS_ERROR(err = image.create(_size, format))) goto _End;
 
   if (format == IMAGE_FORMAT_I8)
   {
     image.setPalette(ImagePalette::fromGreyscale(256));
-
-    uint8_t* pixels = image.getFirstX();
-    ssize_t stride = image.getStride();
-
-    while (cinfo.output_scanline < cinfo.output_height)
-    {
-      rowptr[0] = (JSAMPROW)(pixels + (ssize_t)cinfo.output_scanline * stride);
-      jpeg.read_scanlines(&cinfo, rowptr, (JDIMENSION)1);
-
-      if ((cinfo.output_scanline & 15) == 0)
-        updateProgress(cinfo.output_scanline, cinfo.output_height);
-    }
   }
   else
   {
-    ImageConverter converter;
     err = converter.create(
       ImageFormatDescription::getByFormat(format),
       ImageFormatDescription::fromArgb(24, IMAGE_FD_NONE, 0,
@@ -488,29 +504,83 @@ err_t JpegDecoder::readImage(Image& image)
         FOG_JPEG_RGB24_BMASK));
     if (FOG_IS_ERROR(err)) goto _End;
 
-    ImageConverterClosure closure;
     converter.setupClosure(&closure, PointI(0, 0));
+  }
 
+  {
     uint8_t* pixels = image.getFirstX();
     ssize_t stride = image.getStride();
 
-    while (cinfo.output_scanline < cinfo.output_height)
+    // Rows which were not decoded yet can be displayed by the handler.
+    if (_handler != NULL)
+    {
+      for (int y = 0; y < _size.h; y++)
+        MemOps::zero(pixels + (ssize_t)y * stride, (size_t)_size.w * bpp);
+    }
+
+    uint32_t pass = 0;
+
+    for (;;)
     {
-      rowptr[0] = (JSAMPROW)(pixels + (ssize_t)cinfo.output_scanline * stride);
-      jpeg.read_scanlines(&cinfo, rowptr, (JDIMENSION)1);
+      if (buffered)
+        jpeg.start_output(&cinfo, cinfo.input_scan_number);
+
+      int rowsFirst = 0;
+      closure.ditherOrigin.y = 0;
+
+      while (cinfo.output_scanline < cinfo.output_height)
+      {
+        rowptr[0] = (JSAMPROW)(pixels + (ssize_t)cinfo.output_scanline * stride);
+        jpeg.read_scanlines(&cinfo, rowptr, (JDIMENSION)1);
+
+        if (converter.isValid() && !converter.isCopy())
+          converter.getBlitFn()((uint8_t*)rowptr[0], (uint8_t*)rowptr[0], _size.w, &closure);
+
+        if ((cinfo.output_scanline & 15) == 0)
+        {
+          if (!buffered)
+            updateProgress(cinfo.output_scanline, cinfo.output_height);
+
+          err = _notifyRows(image, rowsFirst, (int)cinfo.output_scanline - rowsFirst, pass);
+          if (FOG_IS_ERROR(err)) goto _End;
 
-      if (!converter.isCopy())
-        converter.getBlitFn()((uint8_t*)rowptr[0], (uint8_t*)rowptr[0], _size.w, &closure);
+          rowsFirst = (int)cinfo.output_scanline;
+        }
 
-      if ((cinfo.output_scanline & 15) == 0)
-        updateProgress(cinfo.output_scanline, cinfo.output_height);
+        closure.ditherOrigin.y++;
+      }
 
-      closure.ditherOrigin.y++;
+      if (rowsFirst < (int)cinfo.output_height)
+      {
+        err = _notifyRows(image, rowsFirst, (int)cinfo.output_height - rowsFirst, pass);
+        if (FOG_IS_ERROR(err)) goto _End;
+      }
+
+      if (!buffered)
+      {
+        err = _notifyPass(image, pass, 1);
+        if (FOG_IS_ERROR(err)) goto _End;
+        break;
+      }
+
+      jpeg.finish_output(&cinfo);
+
+      // The count of scans is not known in advance.
+      err = _notifyPass(image, pass, 0);
+      if (FOG_IS_ERROR(err)) goto _End;
+
+      if (jpeg.input_complete(&cinfo))
+        break;
+
+      pass++;
     }
   }
 
   jpeg.finish_decompress(&cinfo);
 
+  image._modified();
+  err = _notifyFrame(image);
+
 _End:
   jpeg.destroy_decompress(&cinfo);
   image._modified();
@@ -518,18 +588,182 @@ _End:
   return err;
 }
 
+// ===========================================================================
+// [Fog::JpegDecoder - Rows]
+// ===========================================================================
+
+//! @internal
+//!
+//! @brief State of the JPEG decompressor used by @c JpegDecoder::readRows().
+struct FOG_NO_EXPORT JpegDecoderRows
+{
+  struct jpeg_decompress_struct cinfo;
+  MyJpegSourceMgr srcmgr;
+  MyJpegErrorMgr jerr;
+
+  ImageConverter converter;
+  ImageConverterClosure closure;
+};
+
+err_t JpegDecoder::readRows(uint8_t* dst, ssize_t dstStride, int count)
+{
+  JpegLibrary& jpeg = reinterpret_cast<JpegCodecProvider*>(_provider)->_jpegLibrary;
+  FOG_ASSERT(jpeg.err == ERR_OK);
+
+  if (readHeader() != ERR_OK) return _headerResult;
+
+  if (count < 0 || count > _size.h - _rowsPosition)
+    return ERR_RT_INVALID_ARGUMENT;
+
+  if (count == 0)
+    return ERR_OK;
+
+  // Failed or completed.
+  if (isReaderDone())
+    return _readerResult != ERR_OK ? (err_t)_readerResult : (err_t)ERR_RT_INVALID_STATE;
+
+  err_t err = ERR_OK;
+  JpegDecoderRows* state = _rowsState;
+
+  if (state == NULL)
+  {
+    state = fog_new JpegDecoderRows;
+    if (FOG_IS_NULL(state))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    _rowsState = state;
+    MemOps::zero(&state->cinfo, sizeof(state->cinfo));
+  }
+
+  if (setjmp(state->jerr.escape))
+  {
+    err = ERR_IMAGE_LIBJPEG_ERROR;
+    goto _Fail;
+  }
+
+  if (_rowsPosition == 0 && state->cinfo.err == NULL)
+  {
+    struct jpeg_decompress_struct& cinfo = state->cinfo;
+    MyJpegSourceMgr& srcmgr = state->srcmgr;
+
+    cinfo.err = jpeg.std_error(&state->jerr.errmgr);
+    state->jerr.errmgr.error_exit = MyJpegErrorExit;
+    state->jerr.errmgr.output_message = MyJpegMessage;
+
+    jpeg.create_decompress(&cinfo, JPEG_LIB_VERSION, sizeof(struct jpeg_decompress_struct));
+
+    // The header was already read by readHeader(), start from the beginning.
+    _stream.seek((int64_t)_attachedOffset, STREAM_SEEK_SET);
+
+    cinfo.src = (struct jpeg_source_mgr *)&srcmgr;
+    srcmgr.pub.init_source = MyJpegInitSource;
+    srcmgr.pub.fill_input_buffer = MyJpegFillInputBuffer;
+    srcmgr.pub.skip_input_data = MyJpegSkipInputData;
+    srcmgr.pub.resync_to_restart = jpeg.resync_to_restart;
+    srcmgr.pub.term_source = MyJpegTermSource;
+    srcmgr.pub.next_input_byte = srcmgr.buffer;
+    srcmgr.pub.bytes_in_buffer = 0;
+    srcmgr.stream = &_stream;
+
+    jpeg.read_header(&cinfo, true);
+
+    // The output color space must be set before the decompressor is started.
+    if (_format == IMAGE_FORMAT_RGB24)
+    {
+      cinfo.out_color_space = JCS_RGB;
+      cinfo.quantize_colors = false;
+    }
+
+    jpeg.start_decompress(&cinfo);
+
+    if ((int)cinfo.output_width != _size.w ||
+        (int)cinfo.output_height != _size.h ||
+        cinfo.output_components != (_format == IMAGE_FORMAT_I8 ? 1 : 3))
+    {
+      err = ERR_IMAGEIO_UNSUPPORTED_FORMAT;
+      goto _Fail;
+    }
+
+    if (_format == IMAGE_FORMAT_RGB24)
+    {
+      err = state->converter.create(
+        ImageFormatDescription::getByFormat(_format),
+        ImageFormatDescription::fromArgb(24, IMAGE_FD_NONE, 0,
+          FOG_JPEG_RGB24_RMASK,
+          FOG_JPEG_RGB24_GMASK,
+          FOG_JPEG_RGB24_BMASK));
+      if (FOG_IS_ERROR(err)) goto _Fail;
+
+      state->converter.setupClosure(&state->closure, PointI(0, 0));
+    }
+  }
+
+  {
+    ImageConverterBlitLineFunc blit = NULL;
+    if (state->converter.isValid() && !state->converter.isCopy())
+      blit = state->converter.getBlitFn();
+
+    for (int i = 0; i < count; i++, dst += dstStride)
+    {
+      JSAMPROW rowptr[1];
+      rowptr[0] = (JSAMPROW)dst;
+      jpeg.read_scanlines(&state->cinfo, rowptr, (JDIMENSION)1);
+
+      if (blit != NULL)
+        blit(dst, dst, _size.w, &state->closure);
+      state->closure.ditherOrigin.y++;
+    }
+  }
+
+  _rowsPosition += count;
+  updateProgress((uint32_t)_rowsPosition, (uint32_t)_size.h);
+
+  if (_rowsPosition == _size.h)
+  {
+    jpeg.finish_decompress(&state->cinfo);
+    _destroyRowsState();
+
+    _readerDone = true;
+    _readerResult = ERR_OK;
+  }
+  return ERR_OK;
+
+_Fail:
+  _destroyRowsState();
+
+  _readerDone = true;
+  _readerResult = err;
+  return err;
+}
+
+void JpegDecoder::_destroyRowsState()
+{
+  JpegLibrary& jpeg = reinterpret_cast<JpegCodecProvider*>(_provider)->_jpegLibrary;
+  JpegDecoderRows* state = _rowsState;
+
+  if (state == NULL)
+    return;
+
+  jpeg.destroy_decompress(&state->cinfo);
+  fog_delete(state);
+
+  _rowsState = NULL;
+}
+
 // ===========================================================================
 // [Fog::JpegEncoder - Construction / Destruction]
 // ===========================================================================
 
 JpegEncoder::JpegEncoder(ImageCodecProvider* provider) :
   ImageEncoder(provider),
-  _quality(90)
+  _quality(90),
+  _rowsState(NULL)
 {
 }
 
 JpegEncoder::~JpegEncoder()
 {
+  _destroyRowsState();
 }
 
 // ===========================================================================
@@ -588,6 +822,7 @@ static void FOG_CDECL MyJpegTermDestination(j_compress_ptr cinfo)
 
 void JpegEncoder::reset()
 {
+  _destroyRowsState();
   ImageEncoder::reset();
 
   // Reset also quality settings.
@@ -600,78 +835,97 @@ void JpegEncoder::reset()
 
 err_t JpegEncoder::writeImage(const Image& image)
 {
-  JpegLibrary& jpeg = reinterpret_cast<JpegCodecProvider*>(_provider)->_jpegLibrary;
-  FOG_ASSERT(jpeg.err == ERR_OK);
+  err_t err = beginImage(image.getSize(), image.getFormat(), image.getPalette());
+  if (FOG_IS_ERROR(err)) return err;
 
-  err_t err = ERR_OK;
+  err = writeRows(image.getFirst(), image.getStride(), image.getHeight());
 
-  const uint8_t* pixels = image.getFirst();
-  ssize_t stride = image.getStride();
-  uint32_t format = image.getFormat();
-  int w = image.getWidth();
-  int h = image.getHeight();
+  err_t endErr = endImage();
+  return FOG_IS_ERROR(err) ? err : endErr;
+}
 
-  ImageConverter converter;
-  MemBufferTmp<2048> buffer;
+// ===========================================================================
+// [Fog::JpegEncoder - Rows]
+// ===========================================================================
 
+//! @internal
+//!
+//! @brief State of the JPEG compressor between @c JpegEncoder::beginImage()
+//! and @c JpegEncoder::endImage().
+struct FOG_NO_EXPORT JpegEncoderRows
+{
   // This struct contains the JPEG compression parameters and pointers to
   // working space (which is allocated as needed by the JPEG library).
-  // It is possible to have several such structures, representing multiple
-  // compression/decompression processes, in existence at once.  We refer
-  // to any one struct (and its associated working data) as a "JPEG object".
   struct jpeg_compress_struct cinfo;
 
-  // This struct represents a JPEG error handler.  It is declared separately
-  // because applications often want to supply a specialized error handler
-  // (see the second half of this file for an example).  But here we just
-  // take the easy way out and use the standard error handler, which will
-  // print a message on stderr and call exit() if compression fails.
-  // Note that this struct must live as long as the main JPEG parameter
-  // struct, to avoid dangling-pointer problems.
+  // Error handler, must live as long as the main JPEG parameter struct.
   MyJpegErrorMgr jerr;
-  jerr.errmgr.error_exit = MyJpegErrorExit;
-  jerr.errmgr.output_message = MyJpegMessage;
 
   // Destination manager.
   MyJpegDestMgr destmgr;
 
-  // Pointer to JSAMPLE row[s].
-  JSAMPROW row[1];
+  // Converter to RGB24 (if needed) and the converted row.
+  ImageConverter converter;
+  MemBuffer buffer;
+};
 
-  if (setjmp(jerr.escape))
+err_t JpegEncoder::beginImage(const SizeI& size, uint32_t format, const ImagePalette& palette)
+{
+  JpegLibrary& jpeg = reinterpret_cast<JpegCodecProvider*>(_provider)->_jpegLibrary;
+  FOG_ASSERT(jpeg.err == ERR_OK);
+
+  if (_rowsState != NULL)
+    return ERR_RT_INVALID_STATE;
+
+  // Step 0: Simple reject.
+  if (!size.isValid())
+    return ERR_IMAGE_INVALID_SIZE;
+
+  if (format >= IMAGE_FORMAT_COUNT)
+    return ERR_IMAGE_INVALID_FORMAT;
+
+  JpegEncoderRows* state = fog_new JpegEncoderRows;
+  if (FOG_IS_NULL(state))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  _rowsState = state;
+  MemOps::zero(&state->cinfo, sizeof(state->cinfo));
+
+  err_t err = ERR_OK;
+  struct jpeg_compress_struct& cinfo = state->cinfo;
+
+  if (setjmp(state->jerr.escape))
   {
     err = ERR_IMAGE_LIBJPEG_ERROR;
-    goto _End;
+    goto _Fail;
   }
 
-  // Step 0: Simple reject.
-  if (!w || !h) return ERR_IMAGE_INVALID_SIZE;
-
   // Step 1: Allocate and initialize JPEG compression object.
 
   // We have to set up the error handler first, in case the initialization
   // step fails.  (Unlikely, but it could happen if you are out of memory.)
-  // This routine fills in the contents of struct jerr, and returns jerr's
-  // address which we place into the link field in cinfo.
-  cinfo.err = jpeg.std_error((jpeg_error_mgr *)&jerr);
+  cinfo.err = jpeg.std_error(&state->jerr.errmgr);
+  state->jerr.errmgr.error_exit = MyJpegErrorExit;
+  state->jerr.errmgr.output_message = MyJpegMessage;
+
   // Now we can initialize the JPEG compression object.
   jpeg.create_compress(&cinfo, 62, sizeof(cinfo));
 
   // Step 2: Specify data destination (eg, a file).
-  cinfo.dest = (jpeg_destination_mgr*)&destmgr;
-  destmgr.pub.next_output_byte = (JOCTET*)destmgr.buffer;
-  destmgr.pub.free_in_buffer = OUTPUT_BUF_SIZE;
-  destmgr.pub.init_destination = MyJpegInitDestination;
-  destmgr.pub.empty_output_buffer = MyJpegEmptyOutputBuffer;
-  destmgr.pub.term_destination = MyJpegTermDestination;
-  destmgr.stream = &_stream;
+  cinfo.dest = (jpeg_destination_mgr*)&state->destmgr;
+  state->destmgr.pub.next_output_byte = (JOCTET*)state->destmgr.buffer;
+  state->destmgr.pub.free_in_buffer = OUTPUT_BUF_SIZE;
+  state->destmgr.pub.init_destination = MyJpegInitDestination;
+  state->destmgr.pub.empty_output_buffer = MyJpegEmptyOutputBuffer;
+  state->destmgr.pub.term_destination = MyJpegTermDestination;
+  state->destmgr.stream = &_stream;
 
   // Step 3: Set parameters for compression.
 
   // First we supply a description of the input image.
   // Four fields of the cinfo struct must be filled in:
-  cinfo.image_width = w;                 // Image width in pixels.
-  cinfo.image_height = h;                // Image height in pixels.
+  cinfo.image_width = size.w;            // Image width in pixels.
+  cinfo.image_height = size.h;           // Image height in pixels.
 
   // JSAMPLEs per row in image_buffer.
   if (format == IMAGE_FORMAT_A8)
@@ -684,21 +938,21 @@ err_t JpegEncoder::writeImage(const Image& image)
     cinfo.input_components = 3;          // Count of color components per pixel.
     cinfo.in_color_space = JCS_RGB;      // Colorspace of input image.
 
-    if (FOG_IS_NULL(buffer.alloc(w * 3)))
+    if (FOG_IS_NULL(state->buffer.alloc((size_t)size.w * 3)))
     {
       err = ERR_RT_OUT_OF_MEMORY;
-      goto _End;
+      goto _Fail;
     }
 
-    err = converter.create(
+    err = state->converter.create(
       ImageFormatDescription::fromArgb(24, IMAGE_FD_NONE,
         0,
         FOG_JPEG_RGB24_RMASK,
         FOG_JPEG_RGB24_GMASK,
         FOG_JPEG_RGB24_BMASK),
       ImageFormatDescription::getByFormat(format),
-      0, NULL, &image._d->palette);
-    if (FOG_IS_ERROR(err)) goto _End;
+      0, NULL, &palette);
+    if (FOG_IS_ERROR(err)) goto _Fail;
   }
 
   // Now use the library's routine to set default compression parameters (You
@@ -712,7 +966,7 @@ err_t JpegEncoder::writeImage(const Image& image)
 
   // This idea is from enlightenment. Make pixel UV sampling 1x1 if quality
   // is high (90 and higher).
-  if (_quality >= 90)
+  if (_quality >= 90 && cinfo.num_components == 3)
   {
     cinfo.comp_info[0].h_samp_factor = 1;
     cinfo.comp_info[0].v_samp_factor = 1;
@@ -728,58 +982,120 @@ err_t JpegEncoder::writeImage(const Image& image)
   // Pass true unless you are very sure of what you're doing.
   jpeg.start_compress(&cinfo, true);
 
-  // Step 5: While (scan lines remain to be written).
+  _rowsPosition = 0;
+  _rowsSize = size;
+  _rowsFormat = format;
+  return ERR_OK;
+
+_Fail:
+  _destroyRowsState();
+  return err;
+}
+
+err_t JpegEncoder::writeRows(const uint8_t* data, ssize_t stride, int count)
+{
+  JpegLibrary& jpeg = reinterpret_cast<JpegCodecProvider*>(_provider)->_jpegLibrary;
+  FOG_ASSERT(jpeg.err == ERR_OK);
+
+  JpegEncoderRows* state = _rowsState;
+  if (state == NULL)
+    return ERR_RT_INVALID_STATE;
+
+  if (count < 0 || count > _rowsSize.h - _rowsPosition)
+    return ERR_RT_INVALID_ARGUMENT;
+
+  if (setjmp(state->jerr.escape))
+  {
+    _destroyRowsState();
+    return ERR_IMAGE_LIBJPEG_ERROR;
+  }
 
-  // Here we use the library's state variable cinfo.next_scanline as the
-  // loop counter, so that we don't have to keep track ourselves.
-  // To keep things simple, we pass one scanline per call; you can pass
-  // more if you wish, though.
+  // Step 5: While (scan lines remain to be written).
 
   // jpeg_write_scanlines expects an array of pointers to scanlines.
   // Here the array is only one element long, but you could pass
   // more than one scanline at a time if that's more convenient.
-  row[0] = (JSAMPLE*)buffer.getMem();
+  JSAMPROW row[1];
+  int w = _rowsSize.w;
 
-  if (converter.isValid())
+  if (state->converter.isValid())
   {
     ImageConverterClosure closure;
     ImageConverterBlitLineFunc blit;
 
-    converter.setupClosure(&closure);
-    blit = converter.getBlitFn();
+    state->converter.setupClosure(&closure);
+    blit = state->converter.getBlitFn();
 
-    while (cinfo.next_scanline < cinfo.image_height)
-    {
-      blit((uint8_t*)buffer.getMem(),
-        pixels + (ssize_t)cinfo.next_scanline * stride, w, &closure);
-      jpeg.write_scanlines(&cinfo, row, 1);
+    row[0] = (JSAMPLE*)state->buffer.getMem();
 
-      if (cinfo.next_scanline & 15)
-        updateProgress(cinfo.next_scanline, cinfo.image_height);
+    for (int i = 0; i < count; i++, data += stride)
+    {
+      blit((uint8_t*)row[0], data, w, &closure);
+      jpeg.write_scanlines(&state->cinfo, row, 1);
     }
   }
   else
   {
-    while (cinfo.next_scanline < cinfo.image_height)
+    for (int i = 0; i < count; i++, data += stride)
     {
-      row[0] = (JSAMPLE*)(pixels + (ssize_t)cinfo.next_scanline * stride);
-      jpeg.write_scanlines(&cinfo, row, 1);
-
-      if (cinfo.next_scanline & 15)
-        updateProgress(cinfo.next_scanline, cinfo.image_height);
+      row[0] = (JSAMPLE*)data;
+      jpeg.write_scanlines(&state->cinfo, row, 1);
     }
   }
 
-  // Step 6: Finish compression.
-  jpeg.finish_compress(&cinfo);
+  _rowsPosition += count;
+  updateProgress((uint32_t)_rowsPosition, (uint32_t)_rowsSize.h);
+
+  return ERR_OK;
+}
+
+err_t JpegEncoder::endImage()
+{
+  JpegLibrary& jpeg = reinterpret_cast<JpegCodecProvider*>(_provider)->_jpegLibrary;
+  FOG_ASSERT(jpeg.err == ERR_OK);
+
+  JpegEncoderRows* state = _rowsState;
+  if (state == NULL)
+    return ERR_RT_INVALID_STATE;
+
+  err_t err;
+
+  if (setjmp(state->jerr.escape))
+  {
+    err = ERR_IMAGE_LIBJPEG_ERROR;
+  }
+  else if (_rowsPosition != _rowsSize.h)
+  {
+    err = ERR_IMAGE_TRUNCATED;
+  }
+  else
+  {
+    // Step 6: Finish compression.
+    jpeg.finish_compress(&state->cinfo);
+    err = ERR_OK;
+  }
 
-_End:
   // Step 7: Release JPEG compression object.
+  _destroyRowsState();
+
+  updateProgress(1.0f);
+  return err;
+}
+
+void JpegEncoder::_destroyRowsState()
+{
+  JpegLibrary& jpeg = reinterpret_cast<JpegCodecProvider*>(_provider)->_jpegLibrary;
+  JpegEncoderRows* state = _rowsState;
+
+  if (state == NULL)
+    return;
 
   // This is an important step since it will release a good deal of memory.
-  jpeg.destroy_compress(&cinfo);
+  jpeg.destroy_compress(&state->cinfo);
+  fog_delete(state);
 
-  return err;
+  _rowsState = NULL;
+  _rowsPosition = -1;
 }
 
 // ===========================================================================
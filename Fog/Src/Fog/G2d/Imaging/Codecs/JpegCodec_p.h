@@ -28,6 +28,13 @@ namespace Fog {
 //! @addtogroup Fog_G2d_Imaging
 //! @{
 
+// ===========================================================================
+// [Forward Declarations]
+// ===========================================================================
+
+struct JpegDecoderRows;
+struct JpegEncoderRows;
+
 // ===========================================================================
 // [Fog::JpegLibrary]
 // ===========================================================================
@@ -42,7 +49,7 @@ struct FOG_NO_EXPORT JpegLibrary
   err_t init();
   void close();
 
-  enum { NUM_SYMBOLS = 16 };
+  enum { NUM_SYMBOLS = 21 };
   union
   {
     struct
@@ -63,6 +70,11 @@ struct FOG_NO_EXPORT JpegLibrary
       boolean (FOG_CDECL *resync_to_restart)(jpeg_decompress_struct*, int);
       void (FOG_CDECL *destroy_compress)(jpeg_compress_struct*);
       void (FOG_CDECL *destroy_decompress)(jpeg_decompress_struct*);
+      boolean (FOG_CDECL *has_multiple_scans)(jpeg_decompress_struct*);
+      boolean (FOG_CDECL *start_output)(jpeg_decompress_struct*, int /* scan_number */);
+      boolean (FOG_CDECL *finish_output)(jpeg_decompress_struct*);
+      boolean (FOG_CDECL *input_complete)(jpeg_decompress_struct*);
+      int (FOG_CDECL *consume_input)(jpeg_decompress_struct*);
     };
     void* addr[NUM_SYMBOLS];
   };
@@ -125,6 +137,22 @@ struct FOG_NO_EXPORT JpegDecoder : public ImageDecoder
   virtual void reset();
   virtual err_t readHeader();
   virtual err_t readImage(Image& image);
+
+  // --------------------------------------------------------------------------
+  // [Rows]
+  // --------------------------------------------------------------------------
+
+  virtual err_t readRows(uint8_t* dst, ssize_t dstStride, int count);
+
+  void _destroyRowsState();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+protected:
+  //! @brief Decompressor used by @c readRows().
+  JpegDecoderRows* _rowsState;
 };
 
 // ============================================================================
@@ -150,6 +178,17 @@ struct FOG_NO_EXPORT JpegEncoder : public ImageEncoder
   virtual void reset();
   virtual err_t writeImage(const Image& image);
 
+  // --------------------------------------------------------------------------
+  // [Rows]
+  // --------------------------------------------------------------------------
+
+  virtual err_t beginImage(const SizeI& size, uint32_t format,
+    const ImagePalette& palette = ImagePalette::getEmptyInstance());
+  virtual err_t writeRows(const uint8_t* data, ssize_t stride, int count);
+  virtual err_t endImage();
+
+  void _destroyRowsState();
+
   // --------------------------------------------------------------------------
   // [Properties]
   // --------------------------------------------------------------------------
@@ -163,6 +202,9 @@ struct FOG_NO_EXPORT JpegEncoder : public ImageEncoder
 
 protected:
   int _quality;
+
+  //! @brief Compressor used between @c beginImage() and @c endImage().
+  JpegEncoderRows* _rowsState;
 };
 
 //! @}
@@ -16,7 +16,15 @@
 #include <Fog/Core/Global/Init_p.h>
 #include <Fog/Core/Math/Math.h>
 #include <Fog/Core/Memory/MemBufferTmp_p.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
 #include <Fog/Core/OS/Library.h>
+#include <Fog/Core/Kernel/Task.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/Core/Threading/Thread.h>
+#include <Fog/Core/Threading/ThreadEvent.h>
+#include <Fog/Core/Threading/ThreadPool.h>
+#include <Fog/Core/Tools/Cpu.h>
 #include <Fog/Core/Tools/InternedString.h>
 #include <Fog/Core/Tools/Logger.h>
 #include <Fog/Core/Tools/Stream.h>
@@ -79,11 +87,16 @@ err_t PngLibrary::init()
     "png_read_rows\0"
     "png_read_image\0"
     "png_read_end\0"
+    "png_start_read_image\0"
+    "png_process_data\0"
+    "png_process_data_pause\0"
+    "png_progressive_combine_row\0"
     "png_create_write_struct\0"
     "png_destroy_write_struct\0"
     "png_write_info\0"
     "png_write_rows\0"
     "png_write_end\0"
+    "png_write_chunk\0"
     "png_set_expand_gray_1_2_4_to_8\0"
     "png_set_gray_to_rgb\0"
     "png_set_strip_16\0"
@@ -94,11 +107,13 @@ err_t PngLibrary::init()
     "png_set_shift\0"
     "png_set_error_fn\0"
     "png_set_read_fn\0"
+    "png_set_progressive_read_fn\0"
     "png_set_write_fn\0"
     "png_set_bgr\0"
     "png_set_expand\0"
     "png_set_interlace_handling\0"
     "png_set_compression_level\0"
+    "png_set_filter\0"
     "png_set_longjmp_fn\0"
     "png_set_IHDR\0"
     "png_set_PLTE\0"
@@ -135,6 +150,66 @@ void PngLibrary::close()
   err = 0xFFFFFFFF;
 }
 
+// ============================================================================
+// [Fog::PngZLibrary]
+// ============================================================================
+
+PngZLibrary::PngZLibrary() : err(0xFFFFFFFF)
+{
+}
+
+PngZLibrary::~PngZLibrary()
+{
+  close();
+}
+
+err_t PngZLibrary::prepare()
+{
+  if (err == 0xFFFFFFFF)
+  {
+    FOG_ONCE_LOCK();
+    if (err == 0xFFFFFFFF) err = init();
+    FOG_ONCE_UNLOCK();
+  }
+
+  return err;
+}
+
+err_t PngZLibrary::init()
+{
+  static const char symbols[] =
+    "deflateInit2_\0"
+    "deflate\0"
+    "deflateEnd\0"
+    "deflateSetDictionary\0"
+    "adler32\0";
+
+  if (dll.openLibrary(StringW::fromAscii8("z")) != ERR_OK)
+  {
+    // No zlib library found.
+    return ERR_IMAGE_LIBPNG_NOT_LOADED;
+  }
+
+  const char* badSymbol;
+  if (dll.getSymbols(addr, symbols, FOG_ARRAY_SIZE(symbols), NUM_SYMBOLS, (char**)&badSymbol) != NUM_SYMBOLS)
+  {
+    // Some symbol failed to load? Inform about it.
+    Logger::error("Fog::PngZLibrary", "init",
+      "Can't load symbol '%s'.", badSymbol);
+
+    dll.close();
+    return ERR_IMAGE_LIBPNG_NOT_LOADED;
+  }
+
+  return ERR_OK;
+}
+
+void PngZLibrary::close()
+{
+  dll.close();
+  err = 0xFFFFFFFF;
+}
+
 // ============================================================================
 // [Fog::PngCodecProvider]
 // ============================================================================
@@ -206,16 +281,30 @@ err_t PngCodecProvider::createCodec(uint32_t codecType, ImageCodec** codec) cons
 // [Fog::PngCodecProvider - Helpers]
 // ============================================================================
 
-static void png_user_read_data(png_structp png_ptr, png_bytep data, png_size_t length)
+static void png_user_info_fn(png_structp png_ptr, png_infop info_ptr)
 {
   PngDecoder* decoder = reinterpret_cast<PngDecoder*>(
     pngProvider->_pngLibrary.get_io_ptr(png_ptr));
 
-  if (decoder->getStream().read(data, length) != length)
-  {
-    PngLibrary& png = reinterpret_cast<PngCodecProvider*>(decoder->getProvider())->_pngLibrary;
-    png.error(png_ptr, "Read Error");
-  }
+  FOG_UNUSED(info_ptr);
+  decoder->_onInfo();
+}
+
+static void png_user_row_fn(png_structp png_ptr, png_bytep new_row, png_uint_32 row_num, int pass)
+{
+  PngDecoder* decoder = reinterpret_cast<PngDecoder*>(
+    pngProvider->_pngLibrary.get_io_ptr(png_ptr));
+
+  decoder->_onRow(new_row, row_num, pass);
+}
+
+static void png_user_end_fn(png_structp png_ptr, png_infop info_ptr)
+{
+  PngDecoder* decoder = reinterpret_cast<PngDecoder*>(
+    pngProvider->_pngLibrary.get_io_ptr(png_ptr));
+
+  FOG_UNUSED(info_ptr);
+  decoder->_onEnd();
 }
 
 static void png_user_write_data(png_structp png_ptr, png_bytep data, png_size_t length)
@@ -241,13 +330,27 @@ static void png_user_flush_data(png_structp png_ptr)
 PngDecoder::PngDecoder(ImageCodecProvider* provider) :
   ImageDecoder(provider),
   _png_ptr(NULL),
-  _info_ptr(NULL)
+  _info_ptr(NULL),
+  _passesCount(1),
+  _rowsFirst(0),
+  _rowsLast(0),
+  _rowsPass(0),
+  _callbackError(ERR_OK),
+  _interlaceStride(0),
+  _queueStreaming(false),
+  _queue(NULL),
+  _queueStride(0),
+  _queueCount(0),
+  _queueCapacity(0)
 {
 }
 
 PngDecoder::~PngDecoder()
 {
   _deletePngStream();
+
+  if (_queue != NULL)
+    MemMgr::free(_queue);
 }
 
 // ============================================================================
@@ -258,6 +361,26 @@ void PngDecoder::reset()
 {
   _deletePngStream();
   ImageDecoder::reset();
+
+  _passesCount = 1;
+  _rowsFirst = 0;
+  _rowsLast = 0;
+  _rowsPass = 0;
+  _callbackError = ERR_OK;
+
+  _image.reset();
+  _converter.reset();
+  _interlaceBuffer.reset();
+  _interlaceStride = 0;
+
+  if (_queue != NULL)
+    MemMgr::free(_queue);
+
+  _queueStreaming = false;
+  _queue = NULL;
+  _queueStride = 0;
+  _queueCount = 0;
+  _queueCapacity = 0;
 }
 
 // ============================================================================
@@ -266,60 +389,27 @@ void PngDecoder::reset()
 
 err_t PngDecoder::readHeader()
 {
-  // Png library pointer.
-  PngLibrary& png = reinterpret_cast<PngCodecProvider*>(_provider)->_pngLibrary;
-  FOG_ASSERT(png.err == ERR_OK);
-
   // Don't read header more than once.
   if (isHeaderDone()) return _headerResult;
 
-  // Mark header as done.
-  _headerDone = true;
-
-  png_uint_32 w32, h32;
-
-  if ((_headerResult = _createPngStream()) != ERR_OK)
-  {
-    return _headerResult;
-  }
-
-  if (setjmp(*png.set_longjmp_fn(_png_ptr, longjmp, sizeof(jmp_buf))))
+  err_t err = _createPngStream();
+  if (FOG_IS_ERROR(err))
   {
-    return (_headerResult = ERR_IMAGE_LIBPNG_ERROR);
+    _headerDone = true;
+    return (_headerResult = err);
   }
 
-  png.read_info(_png_ptr, _info_ptr);
-  png.get_IHDR(_png_ptr, _info_ptr,
-    (png_uint_32 *)(&w32),
-    (png_uint_32 *)(&h32),
-    &_png_bit_depth,
-    &_png_color_type,
-    &_png_interlace_type, NULL, NULL);
-
-  _size.w = w32;
-  _size.h = h32;
-  _depth = _png_bit_depth;
-  _planes = 1;
+  // The header is read by libpng's progressive reader, which is paused by
+  // _onInfo() so the image data are not decoded before readImage() is called.
+  err = _processStream(true);
 
-  // Check whether the image size is valid.
-  if (!checkImageSize())
+  if (!isHeaderDone())
   {
-    return (_headerResult = ERR_IMAGE_INVALID_SIZE);
+    _headerDone = true;
+    _headerResult = FOG_IS_ERROR(err) ? err : (err_t)ERR_IMAGE_TRUNCATED;
   }
 
-  // Png contains only one image.
-  _actualFrame = 0;
-  _framesCount = 1;
-
-  if (_png_color_type == PNG_COLOR_TYPE_PALETTE)
-    _format = IMAGE_FORMAT_I8;
-  else if (_png_color_type == PNG_COLOR_TYPE_RGB_ALPHA || _png_color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
-    _format = IMAGE_FORMAT_PRGB32;
-  else
-    _format = IMAGE_FORMAT_XRGB32;
-
-  // Success.
-  return (_headerResult = ERR_OK);
+  return _headerResult;
 }
 
 // ============================================================================
@@ -328,111 +418,139 @@ err_t PngDecoder::readHeader()
 
 err_t PngDecoder::readImage(Image& image)
 {
-  // Png library pointer.
-  PngLibrary& png = reinterpret_cast<PngCodecProvider*>(_provider)->_pngLibrary;
-  FOG_ASSERT(png.err == ERR_OK);
-
   // Read png header.
   if (readHeader() != ERR_OK) return _headerResult;
 
   // Don't read image more than once.
   if (isReaderDone()) return (_readerResult = ERR_IMAGE_NO_FRAMES);
 
-  // Error code (default is success).
-  uint32_t err = ERR_OK;
+  err_t err = _beginImage();
+  if (err == ERR_OK) err = _decodeData(NULL, 0);
+  if (err == ERR_OK) err = _processStream(false);
 
-  // Image converter (to convert non-premultiplied to premultiplied).
-  ImageConverter converter;
-
-  // Variables.
-  bool hasAlpha = false;
-  bool hasGrey = false;
-
-  if (setjmp(*png.set_longjmp_fn((png_structp)_png_ptr, longjmp, sizeof(jmp_buf))))
+  if (!_image.isEmpty())
   {
-    return ERR_IMAGE_LIBPNG_ERROR;
+    image = _image;
+    _image.reset();
   }
 
-  // Change the order of packed pixels to least significant bit first.
-  png.set_packswap(_png_ptr);
+  return err;
+}
 
-  // Tell libpng to strip 16 bits/color files down to 8 bits/color.
-  png.set_strip_16(_png_ptr);
+// ============================================================================
+// [Fog::PngDecoder - Incremental]
+// ============================================================================
 
-  if (_png_color_type == PNG_COLOR_TYPE_RGB_ALPHA ) hasAlpha = true;
-  if (_png_color_type == PNG_COLOR_TYPE_GRAY_ALPHA) hasAlpha = true;
-  if (_png_color_type == PNG_COLOR_TYPE_GRAY_ALPHA) hasGrey  = true;
-  if (_png_color_type == PNG_COLOR_TYPE_GRAY      ) hasGrey  = true;
+bool PngDecoder::isIncremental() const
+{
+  return true;
+}
 
-  if (hasAlpha) png.set_expand(_png_ptr);
+err_t PngDecoder::feed(const void* data, size_t size)
+{
+  // Trailing data (or an error which already happened).
+  if (isReaderDone()) return _readerResult;
 
-  // Extract multiple pixels with bit depths of 1, 2, and 4 from a single
-  // byte into separate bytes (useful for paletted and grayscale images).
-  png.set_packing(_png_ptr);
+  if (size == 0)
+    return ERR_OK;
 
-  if (_png_color_type != PNG_COLOR_TYPE_PALETTE)
-  {
-    // We want ARGB.
-#if FOG_BYTE_ORDER == FOG_LITTLE_ENDIAN
-    png.set_bgr(_png_ptr);
-    png.set_filler(_png_ptr, 0xFF, PNG_FILLER_AFTER);
-#else
-    png.set_swap_alpha(_png_ptr);
-    png.set_filler(_png_ptr, 0xFF, PNG_FILLER_BEFORE);
-#endif // FOG_BYTE_ORDER
+  if (FOG_IS_NULL(data))
+    return ERR_RT_INVALID_ARGUMENT;
 
-    if (png.get_valid(_png_ptr, _info_ptr, PNG_INFO_tRNS)) png.set_expand(_png_ptr);
+  err_t err = _createPngStream();
+  if (FOG_IS_ERROR(err)) return err;
 
-    if (hasGrey)
-    {
-      png.set_gray_to_rgb(_png_ptr);
-      if (png.get_bit_depth(_png_ptr, _info_ptr) < 8) png.set_expand_gray_1_2_4_to_8(_png_ptr);
-    }
-  }
+  return _decodeData(data, size);
+}
 
-  if ((err = image.create(_size, _format))) goto _End;
+err_t PngDecoder::finish(Image& image)
+{
+  err_t err = ERR_IMAGE_TRUNCATED;
 
-  if (_format == IMAGE_FORMAT_PRGB32)
+  if (isReaderDone())
   {
-    err = converter.create(
-      ImageFormatDescription::getByFormat(_format),
-      ImageFormatDescription::fromArgb(32, IMAGE_FD_NONE, PIXEL_ARGB32_MASK_A, PIXEL_ARGB32_MASK_R, PIXEL_ARGB32_MASK_G, PIXEL_ARGB32_MASK_B));
-    if (FOG_IS_ERROR(err)) goto _End;
+    err = _readerResult;
+  }
+  else
+  {
+    _readerDone = true;
+    _readerResult = err;
   }
 
+  if (!_image.isEmpty())
   {
-    int passesCount = png.set_interlace_handling(_png_ptr);
+    _image._modified();
+    image = _image;
+    _image.reset();
+  }
 
-    int pass;
-    int y = 0;
-    int yi = 0;
-    int ytotal = passesCount * _size.h;
+  return err;
+}
 
-    for (pass = 0; pass < passesCount; pass++)
-    {
-      uint8_t* dstPixels = image.getFirstX();
-      ssize_t dstStride = image.getStride();
+// ============================================================================
+// [Fog::PngDecoder - Rows]
+// ============================================================================
 
-      for (y = 0; y < _size.h; y++, yi++, dstPixels += dstStride)
-      {
-        png.read_rows(_png_ptr, &dstPixels, NULL, 1);
-        if (converter.isValid()) converter.blitLine(dstPixels, dstPixels, _size.w);
-        if ((yi & 15) == 0) updateProgress(yi, ytotal);
-      }
+err_t PngDecoder::readRows(uint8_t* dst, ssize_t dstStride, int count)
+{
+  if (readHeader() != ERR_OK) return _headerResult;
+
+  // Interlaced image can't be streamed, the rows are complete after the last
+  // pass. Use the generic implementation, which decodes the whole image.
+  if (!_queueStreaming && (_passesCount > 1 || !_image.isEmpty() || isReaderDone()))
+    return Base::readRows(dst, dstStride, count);
+
+  if (count < 0 || count > _size.h - _rowsPosition)
+    return ERR_RT_INVALID_ARGUMENT;
+
+  if (!_queueStreaming)
+  {
+    FOG_RETURN_ON_ERROR(_createConverter());
+
+    _queueStreaming = true;
+    _queueStride = (size_t)_size.w * ImageFormatDescription::getByFormat(_format).getBytesPerPixel();
+
+    // Resume the reader paused by _onInfo().
+    FOG_RETURN_ON_ERROR(_processData(NULL, 0));
+  }
+
+  // Feed libpng by small chunks so the queue doesn't grow too much.
+  uint8_t buffer[4096];
+
+  while (_queueCount < count)
+  {
+    if (isReaderDone())
+      return _readerResult != ERR_OK ? (err_t)_readerResult : (err_t)ERR_IMAGE_TRUNCATED;
+
+    size_t n = _stream.read(buffer, FOG_ARRAY_SIZE(buffer));
+    if (n == 0)
+    {
+      _readerDone = true;
+      _readerResult = ERR_IMAGE_TRUNCATED;
+      return ERR_IMAGE_TRUNCATED;
     }
+
+    FOG_RETURN_ON_ERROR(_processData(buffer, n));
   }
 
-  // TODO: PNG - Read palette.
+  const uint8_t* queue = _queue;
+  for (int i = 0; i < count; i++, dst += dstStride, queue += _queueStride)
+    MemOps::copy(dst, queue, _queueStride);
 
-_End:
-  png.read_end(_png_ptr, _info_ptr);
+  _queueCount -= count;
+  if (_queueCount > 0)
+    memmove(_queue, queue, (size_t)_queueCount * _queueStride);
 
-  image._modified();
-  updateProgress(1.0f);
+  _rowsPosition += count;
+  updateProgress((uint32_t)_rowsPosition, (uint32_t)_size.h);
 
-  return err;
+  return ERR_OK;
 }
 
+// ============================================================================
+// [Fog::PngDecoder - Helpers]
+// ============================================================================
+
 uint32_t PngDecoder::_createPngStream()
 {
   // Already created?
@@ -456,8 +574,11 @@ uint32_t PngDecoder::_createPngStream()
     goto _Fail;
   }
 
-  // Custom IO.
-  png.set_read_fn((png_structp)_png_ptr, this, (png_rw_ptr)png_user_read_data);
+  // Progressive reader, the data are pushed by _processData().
+  png.set_progressive_read_fn((png_structp)_png_ptr, this,
+    (png_progressive_info_ptr)png_user_info_fn,
+    (png_progressive_row_ptr)png_user_row_fn,
+    (png_progressive_end_ptr)png_user_end_fn);
 
   // Success.
   return ERR_OK;
@@ -480,114 +601,1151 @@ void PngDecoder::_deletePngStream()
   }
 }
 
-// ============================================================================
-// [Fog::PngEncoder - Construction / Destruction]
-// ============================================================================
-
-PngEncoder::PngEncoder(ImageCodecProvider* provider) :
-  ImageEncoder(provider),
-  _compression(9)
-{
-}
-
-PngEncoder::~PngEncoder()
-{
-}
-
-// ===========================================================================
-// [Fog::PngEncoder - WriteImage]
-// ===========================================================================
-
-err_t PngEncoder::writeImage(const Image& image)
+err_t PngDecoder::_processData(const void* data, size_t size)
 {
   // Png library pointer.
   PngLibrary& png = reinterpret_cast<PngCodecProvider*>(_provider)->_pngLibrary;
   FOG_ASSERT(png.err == ERR_OK);
 
-  err_t err = ERR_OK;
+  if (setjmp(*png.set_longjmp_fn(_png_ptr, longjmp, sizeof(jmp_buf))))
+  {
+    err_t err = _callbackError;
+    if (err == ERR_OK) err = ERR_IMAGE_LIBPNG_ERROR;
 
-  const uint8_t* pixels = image.getFirst();
-  ssize_t stride = image.getStride();
-  uint32_t format = image.getFormat();
-  int w = image.getWidth();
-  int h = image.getHeight();
+    if (!isHeaderDone())
+    {
+      _headerDone = true;
+      _headerResult = err;
+    }
 
-  png_structp png_ptr;
-  png_infop info_ptr;
-  png_bytep row_ptr;
-  int y;
+    _readerDone = true;
+    _readerResult = err;
+    return err;
+  }
 
-  ImageConverter converter;
-  MemBufferTmp<2048> buffer;
+  // Passing no data is valid, it resumes processing of data saved by
+  // png_process_data_pause().
+  png.process_data(_png_ptr, _info_ptr, (png_bytep)data, size);
+  return ERR_OK;
+}
 
-  // Step 0: Simple reject.
-  if (!w || !h)
-  {
-    err = ERR_IMAGE_INVALID_SIZE;
-    goto _End;
-  }
+err_t PngDecoder::_processStream(bool headerOnly)
+{
+  uint8_t buffer[16384];
 
-  if ((png_ptr = png.create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL)) == NULL)
+  for (;;)
   {
-    err = ERR_IMAGE_LIBPNG_ERROR;
-    goto _End;
+    if (headerOnly ? isHeaderDone() : isReaderDone())
+      break;
+
+    size_t n = _stream.read(buffer, FOG_ARRAY_SIZE(buffer));
+    if (n == 0)
+    {
+      if (headerOnly) return ERR_IMAGE_TRUNCATED;
+
+      _readerDone = true;
+      _readerResult = ERR_IMAGE_TRUNCATED;
+      return ERR_IMAGE_TRUNCATED;
+    }
+
+    err_t err = headerOnly ? _processData(buffer, n) : _decodeData(buffer, n);
+    if (FOG_IS_ERROR(err)) return err;
   }
 
-  if ((info_ptr = png.create_info_struct(png_ptr)) == NULL)
+  return headerOnly ? (err_t)_headerResult : (err_t)_readerResult;
+}
+
+err_t PngDecoder::_decodeData(const void* data, size_t size)
+{
+  err_t err = _processData(data, size);
+
+  // The progressive reader was paused after the header was read, create the
+  // image and continue.
+  if (err == ERR_OK && isHeaderDone() && _image.isEmpty() && !isReaderDone())
   {
-    err = ERR_IMAGE_LIBPNG_ERROR;
-    goto _EndDestroyWriteStruct;
+    err = _beginImage();
+    if (err == ERR_OK) err = _processData(NULL, 0);
   }
 
-  if (setjmp(*png.set_longjmp_fn((png_structp)png_ptr, longjmp, sizeof(jmp_buf))))
+  // Report all rows decoded from this chunk.
+  if (err == ERR_OK && !isReaderDone())
+    err = _flushRows();
+
+  if (FOG_IS_ERROR(err) && !isReaderDone())
   {
-    err = ERR_IMAGE_LIBPNG_ERROR;
-    goto _EndDestroyWriteStruct;
+    _readerDone = true;
+    _readerResult = err;
   }
 
-  // Use custom I/O functions.
-  png.set_write_fn(png_ptr, this, (png_rw_ptr)png_user_write_data, (png_flush_ptr)png_user_flush_data);
+  return err;
+}
 
-  png_color_8 sig_bit;
-  memset(&sig_bit, 0, sizeof(sig_bit));
+err_t PngDecoder::_createConverter()
+{
+  if (_format != IMAGE_FORMAT_PRGB32 || _converter.isValid())
+    return ERR_OK;
 
-  switch (format)
-  {
-    case IMAGE_FORMAT_PRGB32:
-    case IMAGE_FORMAT_PRGB64:
-    case IMAGE_FORMAT_A8:
-    case IMAGE_FORMAT_A16:
-    {
-      png.set_IHDR(png_ptr, info_ptr, w, h, 8,
-        PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE,
-        PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+  return _converter.create(
+    ImageFormatDescription::getByFormat(_format),
+    ImageFormatDescription::fromArgb(32, IMAGE_FD_NONE, PIXEL_ARGB32_MASK_A, PIXEL_ARGB32_MASK_R, PIXEL_ARGB32_MASK_G, PIXEL_ARGB32_MASK_B));
+}
 
-#if FOG_BYTE_ORDER == FOG_LITTLE_ENDIAN
-      png.set_bgr(png_ptr);
-#else
-      png.set_swap_alpha(png_ptr);
-#endif
+err_t PngDecoder::_beginImage()
+{
+  if (!_image.isEmpty())
+    return ERR_OK;
 
-      sig_bit.red = 8;
-      sig_bit.green = 8;
-      sig_bit.blue = 8;
-      sig_bit.alpha = 8;
-      sig_bit.gray = 0;
-      png.set_sBIT(png_ptr, info_ptr, &sig_bit);
+  FOG_RETURN_ON_ERROR(_image.create(_size, _format));
 
-      err = converter.create(
-        ImageFormatDescription::fromArgb(32, IMAGE_FD_NONE,
+  // Clear the image so the rows which were not decoded yet are transparent,
+  // the handler can display a partially decoded image.
+  uint8_t* dstPixels = _image.getFirstX();
+  ssize_t dstStride = _image.getStride();
+  size_t dstBpl = (size_t)_size.w * _image.getBytesPerPixel();
+
+  for (int y = 0; y < _size.h; y++, dstPixels += dstStride)
+    MemOps::zero(dstPixels, dstBpl);
+
+  FOG_RETURN_ON_ERROR(_createConverter());
+
+  // Interlaced image needs to keep non-premultiplied pixels, because libpng
+  // combines rows of each pass with the rows decoded by the previous pass.
+  if (_converter.isValid() && _passesCount > 1)
+  {
+    _interlaceStride = (size_t)_size.w * 4;
+    if (FOG_IS_NULL(_interlaceBuffer.alloc(_interlaceStride * (size_t)_size.h)))
+      return ERR_RT_OUT_OF_MEMORY;
+    MemOps::zero(_interlaceBuffer.getMem(), _interlaceStride * (size_t)_size.h);
+  }
+
+  _rowsFirst = 0;
+  _rowsLast = 0;
+  _rowsPass = 0;
+
+  return _notifyHeader();
+}
+
+err_t PngDecoder::_flushRows()
+{
+  if (_rowsFirst >= _rowsLast)
+    return ERR_OK;
+
+  int y = _rowsFirst;
+  int height = _rowsLast - _rowsFirst;
+
+  _rowsFirst = _rowsLast;
+  _image._modified();
+
+  updateProgress((uint32_t)(_rowsPass * _size.h + _rowsLast), (uint32_t)(_passesCount * _size.h));
+  return _notifyRows(_image, y, height, (uint32_t)_rowsPass);
+}
+
+err_t PngDecoder::_queueRow(png_bytep newRow)
+{
+  // Png library pointer.
+  PngLibrary& png = reinterpret_cast<PngCodecProvider*>(_provider)->_pngLibrary;
+
+  if (_queueCount == _queueCapacity)
+  {
+    int capacity = Math::max<int>(_queueCapacity * 2, 16);
+    uint8_t* queue = reinterpret_cast<uint8_t*>(MemMgr::realloc(_queue, (size_t)capacity * _queueStride));
+
+    if (FOG_IS_NULL(queue))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    _queue = queue;
+    _queueCapacity = capacity;
+  }
+
+  uint8_t* rowPixels = _queue + (size_t)_queueCount * _queueStride;
+  _queueCount++;
+
+  png.progressive_combine_row(_png_ptr, rowPixels, newRow);
+  if (_converter.isValid()) _converter.blitLine(rowPixels, rowPixels, _size.w);
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::PngDecoder - Callbacks]
+// ============================================================================
+
+void PngDecoder::_onInfo()
+{
+  // Png library pointer.
+  PngLibrary& png = reinterpret_cast<PngCodecProvider*>(_provider)->_pngLibrary;
+
+  png_uint_32 w32, h32;
+
+  png.get_IHDR(_png_ptr, _info_ptr,
+    (png_uint_32 *)(&w32),
+    (png_uint_32 *)(&h32),
+    &_png_bit_depth,
+    &_png_color_type,
+    &_png_interlace_type, NULL, NULL);
+
+  _size.w = w32;
+  _size.h = h32;
+  _depth = _png_bit_depth;
+  _planes = 1;
+
+  // Check whether the image size is valid.
+  if (!checkImageSize())
+  {
+    _onError(ERR_IMAGE_INVALID_SIZE);
+    return;
+  }
+
+  // Png contains only one image.
+  _actualFrame = 0;
+  _framesCount = 1;
+
+  bool hasAlpha = false;
+  bool hasGrey = false;
+
+  if (_png_color_type == PNG_COLOR_TYPE_PALETTE)
+    _format = IMAGE_FORMAT_I8;
+  else if (_png_color_type == PNG_COLOR_TYPE_RGB_ALPHA || _png_color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
+    _format = IMAGE_FORMAT_PRGB32;
+  else
+    _format = IMAGE_FORMAT_XRGB32;
+
+  // Change the order of packed pixels to least significant bit first.
+  png.set_packswap(_png_ptr);
+
+  // Tell libpng to strip 16 bits/color files down to 8 bits/color.
+  png.set_strip_16(_png_ptr);
+
+  if (_png_color_type == PNG_COLOR_TYPE_RGB_ALPHA ) hasAlpha = true;
+  if (_png_color_type == PNG_COLOR_TYPE_GRAY_ALPHA) hasAlpha = true;
+  if (_png_color_type == PNG_COLOR_TYPE_GRAY_ALPHA) hasGrey  = true;
+  if (_png_color_type == PNG_COLOR_TYPE_GRAY      ) hasGrey  = true;
+
+  if (hasAlpha) png.set_expand(_png_ptr);
+
+  // Extract multiple pixels with bit depths of 1, 2, and 4 from a single
+  // byte into separate bytes (useful for paletted and grayscale images).
+  png.set_packing(_png_ptr);
+
+  if (_png_color_type != PNG_COLOR_TYPE_PALETTE)
+  {
+    // We want ARGB.
+#if FOG_BYTE_ORDER == FOG_LITTLE_ENDIAN
+    png.set_bgr(_png_ptr);
+    png.set_filler(_png_ptr, 0xFF, PNG_FILLER_AFTER);
+#else
+    png.set_swap_alpha(_png_ptr);
+    png.set_filler(_png_ptr, 0xFF, PNG_FILLER_BEFORE);
+#endif // FOG_BYTE_ORDER
+
+    if (png.get_valid(_png_ptr, _info_ptr, PNG_INFO_tRNS)) png.set_expand(_png_ptr);
+
+    if (hasGrey)
+    {
+      png.set_gray_to_rgb(_png_ptr);
+      if (png.get_bit_depth(_png_ptr, _info_ptr) < 8) png.set_expand_gray_1_2_4_to_8(_png_ptr);
+    }
+  }
+
+  _passesCount = png.set_interlace_handling(_png_ptr);
+  png.start_read_image(_png_ptr);
+
+  // Success.
+  _headerDone = true;
+  _headerResult = ERR_OK;
+
+  // Pause, the image is created by _beginImage() and the processing of the
+  // remaining data continues when the image is requested.
+  png.process_data_pause(_png_ptr, 1);
+}
+
+void PngDecoder::_onRow(png_bytep newRow, png_uint_32 y, int pass)
+{
+  // Png library pointer.
+  PngLibrary& png = reinterpret_cast<PngCodecProvider*>(_provider)->_pngLibrary;
+
+  // NULL means that the row was not changed by this pass.
+  if (newRow == NULL || y >= (png_uint_32)_size.h)
+    return;
+
+  // Rows requested by readRows() aren't stored into the image.
+  if (_queueStreaming)
+  {
+    err_t err = _queueRow(newRow);
+    if (FOG_IS_ERROR(err))
+      _onError(err);
+    return;
+  }
+
+  // Report the rows of the previous pass or the rows which are not adjacent.
+  if (pass != _rowsPass || (int)y < _rowsLast)
+  {
+    err_t err = _flushRows();
+
+    if (err == ERR_OK && pass != _rowsPass)
+      err = _notifyPass(_image, (uint32_t)_rowsPass, (uint32_t)_passesCount);
+
+    if (FOG_IS_ERROR(err))
+    {
+      _onError(err);
+      return;
+    }
+
+    _rowsFirst = (int)y;
+    _rowsPass = pass;
+  }
+
+  // The handler may keep a reference to the image, don't modify it.
+  err_t err = _image.detach();
+  if (FOG_IS_ERROR(err))
+  {
+    _onError(err);
+    return;
+  }
+
+  uint8_t* dstPixels = _image.getScanlineX((int)y);
+
+  if (_interlaceStride != 0)
+  {
+    uint8_t* rowPixels = reinterpret_cast<uint8_t*>(_interlaceBuffer.getMem()) + (size_t)y * _interlaceStride;
+
+    png.progressive_combine_row(_png_ptr, rowPixels, newRow);
+    _converter.blitLine(dstPixels, rowPixels, _size.w);
+  }
+  else
+  {
+    png.progressive_combine_row(_png_ptr, dstPixels, newRow);
+    if (_converter.isValid()) _converter.blitLine(dstPixels, dstPixels, _size.w);
+  }
+
+  if (_rowsFirst == _rowsLast)
+    _rowsFirst = (int)y;
+  _rowsLast = (int)y + 1;
+}
+
+void PngDecoder::_onEnd()
+{
+  if (_queueStreaming)
+  {
+    _readerDone = true;
+    _readerResult = ERR_OK;
+    return;
+  }
+
+  err_t err = _flushRows();
+
+  if (err == ERR_OK) err = _notifyPass(_image, (uint32_t)_rowsPass, (uint32_t)_passesCount);
+  if (err == ERR_OK) err = _notifyFrame(_image);
+
+  if (FOG_IS_ERROR(err))
+  {
+    _onError(err);
+    return;
+  }
+
+  _readerDone = true;
+  _readerResult = ERR_OK;
+
+  _interlaceBuffer.reset();
+  _interlaceStride = 0;
+
+  updateProgress(1.0f);
+}
+
+void PngDecoder::_onError(err_t err)
+{
+  // Png library pointer.
+  PngLibrary& png = reinterpret_cast<PngCodecProvider*>(_provider)->_pngLibrary;
+
+  // Doesn't return, jumps back to _processData().
+  _callbackError = err;
+  png.error(_png_ptr, "Aborted");
+}
+
+// ============================================================================
+// [Fog::PngEncoder - Helpers]
+// ============================================================================
+
+enum
+{
+  //! @brief Maximum count of threads used to compress a single image.
+  PNG_ENCODER_MAX_THREADS = 32,
+  //! @brief Minimum size of the filtered data compressed by one thread.
+  PNG_ENCODER_MIN_GROUP_SIZE = 262144,
+  //! @brief Size of deflate window (and the maximum size of dictionary).
+  PNG_ENCODER_WINDOW_SIZE = 32768
+};
+
+//! @internal
+//!
+//! @brief Get the count of bytes per pixel written by the PNG encoder.
+static uint32_t PngEncoder_getBytesPerPixel(uint32_t format)
+{
+  switch (format)
+  {
+    case IMAGE_FORMAT_PRGB32:
+    case IMAGE_FORMAT_PRGB64:
+    case IMAGE_FORMAT_A8:
+    case IMAGE_FORMAT_A16:
+      return 4;
+
+    case IMAGE_FORMAT_XRGB32:
+    case IMAGE_FORMAT_RGB24:
+    case IMAGE_FORMAT_RGB48:
+      return 3;
+
+    default:
+      return 1;
+  }
+}
+
+//! @internal
+//!
+//! @brief Translate @c IMAGE_PNG_FILTER to the filter used to encode an image
+//! of @a format (adaptive filtering is not used by indexed images).
+static uint32_t PngEncoder_getFilter(uint32_t filter, uint32_t format)
+{
+  if (filter == IMAGE_PNG_FILTER_ADAPTIVE && format == IMAGE_FORMAT_I8)
+    return IMAGE_PNG_FILTER_NONE;
+  else
+    return filter;
+}
+
+//! @internal
+//!
+//! @brief Translate @c IMAGE_PNG_FILTER to the libpng filter mask.
+static int PngEncoder_getLibPngFilter(uint32_t filter)
+{
+  switch (filter)
+  {
+    case IMAGE_PNG_FILTER_NONE   : return PNG_FILTER_NONE;
+    case IMAGE_PNG_FILTER_SUB    : return PNG_FILTER_SUB;
+    case IMAGE_PNG_FILTER_UP     : return PNG_FILTER_UP;
+    case IMAGE_PNG_FILTER_AVERAGE: return PNG_FILTER_AVG;
+    case IMAGE_PNG_FILTER_PAETH  : return PNG_FILTER_PAETH;
+    default                      : return PNG_ALL_FILTERS;
+  }
+}
+
+//! @internal
+//!
+//! @brief Convert ARGB32 pixels to RGBA byte order (libpng does the same using
+//! @c png_set_bgr() or @c png_set_swap_alpha() transformation).
+static void PngEncoder_swizzleArgb32(uint8_t* row, int w)
+{
+  for (int i = 0; i < w; i++, row += 4)
+  {
+#if FOG_BYTE_ORDER == FOG_LITTLE_ENDIAN
+    uint8_t t = row[0];
+    row[0] = row[2];
+    row[2] = t;
+#else
+    uint8_t a = row[0];
+    row[0] = row[1];
+    row[1] = row[2];
+    row[2] = row[3];
+    row[3] = a;
+#endif // FOG_BYTE_ORDER
+  }
+}
+
+static FOG_INLINE uint32_t PngFilter_paeth(uint32_t a, uint32_t b, uint32_t c)
+{
+  int p = (int)b - (int)c;
+  int q = (int)a - (int)c;
+
+  int pa = Math::abs(p);
+  int pb = Math::abs(q);
+  int pc = Math::abs(p + q);
+
+  if (pa <= pb && pa <= pc)
+    return a;
+  else if (pb <= pc)
+    return b;
+  else
+    return c;
+}
+
+//! @internal
+//!
+//! @brief Filter @a row (@a prev is the previous row, zeroed for the first
+//! row) and store the filter type followed by the filtered bytes to @a dst.
+static void PngFilter_apply(uint8_t* dst, const uint8_t* row, const uint8_t* prev,
+  size_t length, size_t bpp, uint32_t filter)
+{
+  size_t i;
+  *dst++ = (uint8_t)filter;
+
+  switch (filter)
+  {
+    case IMAGE_PNG_FILTER_NONE:
+      MemOps::copy(dst, row, length);
+      break;
+
+    case IMAGE_PNG_FILTER_SUB:
+      for (i = 0; i < bpp; i++)
+        dst[i] = row[i];
+      for (; i < length; i++)
+        dst[i] = (uint8_t)(row[i] - row[i - bpp]);
+      break;
+
+    case IMAGE_PNG_FILTER_UP:
+      for (i = 0; i < length; i++)
+        dst[i] = (uint8_t)(row[i] - prev[i]);
+      break;
+
+    case IMAGE_PNG_FILTER_AVERAGE:
+      for (i = 0; i < bpp; i++)
+        dst[i] = (uint8_t)(row[i] - (prev[i] >> 1));
+      for (; i < length; i++)
+        dst[i] = (uint8_t)(row[i] - (((uint32_t)row[i - bpp] + (uint32_t)prev[i]) >> 1));
+      break;
+
+    case IMAGE_PNG_FILTER_PAETH:
+      for (i = 0; i < bpp; i++)
+        dst[i] = (uint8_t)(row[i] - prev[i]);
+      for (; i < length; i++)
+        dst[i] = (uint8_t)(row[i] - PngFilter_paeth(row[i - bpp], prev[i], prev[i - bpp]));
+      break;
+
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+}
+
+//! @internal
+//!
+//! @brief Get the sum of absolute values of filtered bytes (as signed), used
+//! by the adaptive filter heuristic (the same one as used by libpng).
+static size_t PngFilter_getCost(const uint8_t* data, size_t length)
+{
+  size_t cost = 0;
+
+  for (size_t i = 0; i < length; i++)
+  {
+    uint32_t v = data[i];
+    cost += (v < 128) ? v : 256 - v;
+  }
+
+  return cost;
+}
+
+//! @internal
+//!
+//! @brief Filter @a row using @a filter, @a scratch must be large enough to
+//! hold 5 filtered rows in case that the filter is adaptive. Returns the
+//! filtered row (filter type followed by the filtered bytes).
+static const uint8_t* PngFilter_row(uint8_t* scratch, const uint8_t* row, const uint8_t* prev,
+  size_t length, size_t bpp, uint32_t filter)
+{
+  if (filter != IMAGE_PNG_FILTER_ADAPTIVE)
+  {
+    PngFilter_apply(scratch, row, prev, length, bpp, filter);
+    return scratch;
+  }
+
+  const uint8_t* best = NULL;
+  size_t bestCost = 0;
+
+  for (uint32_t i = IMAGE_PNG_FILTER_NONE; i <= IMAGE_PNG_FILTER_PAETH; i++)
+  {
+    uint8_t* dst = scratch + i * (length + 1);
+    PngFilter_apply(dst, row, prev, length, bpp, i);
+
+    size_t cost = PngFilter_getCost(dst + 1, length);
+    if (best == NULL || cost < bestCost)
+    {
+      best = dst;
+      bestCost = cost;
+    }
+  }
+
+  return best;
+}
+
+//! @internal
+//!
+//! @brief Combine the adler32 checksums of two adjacent blocks, @a length2 is
+//! the length of the second block.
+static uint32_t PngZ_combineAdler32(uint32_t adler1, uint32_t adler2, size_t length2)
+{
+  const uint32_t BASE = 65521;
+
+  uint32_t rem = (uint32_t)(length2 % BASE);
+  uint32_t sum1 = adler1 & 0xFFFF;
+  uint32_t sum2 = (uint32_t)(((uint64_t)rem * sum1) % BASE);
+
+  sum1 += (adler2 & 0xFFFF) + BASE - 1;
+  sum2 += (adler1 >> 16) + (adler2 >> 16) + BASE - rem;
+
+  if (sum1 >= BASE) sum1 -= BASE;
+  if (sum1 >= BASE) sum1 -= BASE;
+  if (sum2 >= (BASE << 1)) sum2 -= (BASE << 1);
+  if (sum2 >= BASE) sum2 -= BASE;
+
+  return sum1 | (sum2 << 16);
+}
+
+// ============================================================================
+// [Fog::PngEncoder - Parallel Deflate]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Row group compressed by a single thread.
+//!
+//! Each group is compressed as a raw deflate stream, which ends with a sync
+//! flush (the last group is finished instead). The streams can be simply
+//! concatenated, the zlib header and the adler32 checksum are added by the
+//! encoder.
+struct FOG_NO_EXPORT PngDeflateGroup
+{
+  //! @brief First row.
+  int y0;
+  //! @brief Last row (exclusive).
+  int y1;
+
+  //! @brief Compressed data.
+  uint8_t* data;
+  //! @brief Compressed data length.
+  size_t length;
+  //! @brief Compressed data capacity.
+  size_t capacity;
+
+  //! @brief Adler32 of the filtered data.
+  uint32_t adler;
+  //! @brief Length of the filtered data.
+  size_t adlerLength;
+
+  //! @brief Error code.
+  err_t err;
+};
+
+//! @internal
+//!
+//! @brief Shared data of all row groups.
+struct FOG_NO_EXPORT PngDeflateContext
+{
+  PngZLibrary* z;
+  const ImageConverter* converter;
+
+  const uint8_t* data;
+  ssize_t stride;
+
+  int w;
+  size_t rowBytes;
+  size_t bpp;
+
+  uint32_t filter;
+  int level;
+
+  PngDeflateGroup* groups;
+  int count;
+
+  //! @brief Count of groups being processed by other threads.
+  int remaining;
+  //! @brief Signaled when the last group processed by other thread finishes.
+  ThreadEvent done;
+};
+
+static err_t PngDeflate_write(PngDeflateContext* ctx, PngDeflateGroup* group, z_stream* strm, int flush)
+{
+  for (;;)
+  {
+    if (group->length == group->capacity)
+    {
+      size_t capacity = group->capacity * 2;
+      uint8_t* data = reinterpret_cast<uint8_t*>(MemMgr::realloc(group->data, capacity));
+
+      if (FOG_IS_NULL(data))
+        return ERR_RT_OUT_OF_MEMORY;
+
+      group->data = data;
+      group->capacity = capacity;
+    }
+
+    uInt avail = (uInt)Math::min<size_t>(group->capacity - group->length, 0x40000000);
+
+    strm->next_out = group->data + group->length;
+    strm->avail_out = avail;
+
+    int result = ctx->z->deflate(strm, flush);
+    group->length += avail - strm->avail_out;
+
+    if (result == Z_STREAM_ERROR)
+      return ERR_IMAGE_LIBPNG_ERROR;
+
+    if (flush == Z_FINISH)
+    {
+      if (result == Z_STREAM_END)
+        return ERR_OK;
+    }
+    else if (strm->avail_in == 0 && strm->avail_out != 0)
+    {
+      return ERR_OK;
+    }
+  }
+}
+
+static err_t PngDeflate_processGroup(PngDeflateContext* ctx, PngDeflateGroup* group)
+{
+  PngZLibrary& z = *ctx->z;
+
+  size_t rowBytes = ctx->rowBytes;
+  size_t filteredBytes = rowBytes + 1;
+
+  bool isFirst = (group == ctx->groups);
+  bool isLast = (group == ctx->groups + ctx->count - 1);
+
+  // Rows at the end of the previous group are filtered again, the result is
+  // used as a dictionary, so the compression ratio stays nearly the same as
+  // if the image was compressed by a single stream.
+  int dictRows = 0;
+  if (!isFirst)
+  {
+    dictRows = (int)((PNG_ENCODER_WINDOW_SIZE + filteredBytes - 1) / filteredBytes);
+    dictRows = Math::min<int>(dictRows, group->y0);
+  }
+
+  size_t scratchSize = filteredBytes * (ctx->filter == IMAGE_PNG_FILTER_ADAPTIVE ? 5 : 1);
+  size_t dictSize = filteredBytes * (size_t)dictRows;
+
+  MemBufferTmp<1024> buffer;
+  uint8_t* mem = reinterpret_cast<uint8_t*>(buffer.alloc(rowBytes * 3 + scratchSize + dictSize));
+
+  if (FOG_IS_NULL(mem))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  uint8_t* zeroRow = mem;
+  uint8_t* rowBuffer[2] = { mem + rowBytes, mem + rowBytes * 2 };
+  uint8_t* scratch = mem + rowBytes * 3;
+  uint8_t* dict = scratch + scratchSize;
+
+  MemOps::zero(zeroRow, rowBytes);
+
+  ImageConverterClosure closure;
+  ImageConverterBlitLineFunc blit = NULL;
+
+  if (ctx->converter->isValid())
+  {
+    ctx->converter->setupClosure(&closure);
+    blit = ctx->converter->getBlitFn();
+  }
+
+  group->length = isFirst ? 2 : 0;
+  group->capacity = Math::max<size_t>(filteredBytes * (size_t)(group->y1 - group->y0) / 2, 1024);
+  group->data = reinterpret_cast<uint8_t*>(MemMgr::alloc(group->capacity));
+  group->adler = 1;
+  group->adlerLength = 0;
+
+  if (FOG_IS_NULL(group->data))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  z_stream strm;
+  MemOps::zero(&strm, sizeof(z_stream));
+
+  if (z.deflate_init2(&strm, ctx->level, Z_DEFLATED, -15, 8,
+    ctx->filter == IMAGE_PNG_FILTER_NONE ? Z_DEFAULT_STRATEGY : Z_FILTERED,
+    ZLIB_VERSION, (int)sizeof(z_stream)) != Z_OK)
+  {
+    return ERR_RT_OUT_OF_MEMORY;
+  }
+
+  err_t err = ERR_OK;
+  const uint8_t* prev = zeroRow;
+
+  // The row before the first filtered row is only needed as a predictor.
+  int yStart = group->y0 - dictRows;
+  if (yStart > 0) yStart--;
+
+  for (int y = yStart; y < group->y1; y++)
+  {
+    const uint8_t* row = ctx->data + (ssize_t)y * ctx->stride;
+
+    if (blit != NULL)
+    {
+      uint8_t* converted = rowBuffer[y & 1];
+      blit(converted, row, ctx->w, &closure);
+
+      if (ctx->bpp == 4)
+        PngEncoder_swizzleArgb32(converted, ctx->w);
+      row = converted;
+    }
+
+    if (y < group->y0 - dictRows)
+    {
+      prev = row;
+      continue;
+    }
+
+    const uint8_t* filtered = PngFilter_row(scratch, row, prev, rowBytes, ctx->bpp, ctx->filter);
+    prev = row;
+
+    if (y < group->y0)
+    {
+      MemOps::copy(dict, filtered, filteredBytes);
+      dict += filteredBytes;
+
+      if (y == group->y0 - 1)
+      {
+        size_t dictLength = Math::min<size_t>(dictSize, PNG_ENCODER_WINDOW_SIZE);
+        z.deflate_set_dictionary(&strm, dict - dictLength, (uInt)dictLength);
+      }
+      continue;
+    }
+
+    int flush = Z_NO_FLUSH;
+    if (y == group->y1 - 1)
+      flush = isLast ? Z_FINISH : Z_SYNC_FLUSH;
+
+    group->adler = (uint32_t)z.adler32(group->adler, filtered, (uInt)filteredBytes);
+    group->adlerLength += filteredBytes;
+
+    strm.next_in = const_cast<Bytef*>(filtered);
+    strm.avail_in = (uInt)filteredBytes;
+
+    err = PngDeflate_write(ctx, group, &strm, flush);
+    if (FOG_IS_ERROR(err))
+      break;
+  }
+
+  z.deflate_end(&strm);
+  return err;
+}
+
+//! @internal
+//!
+//! @brief Task which compresses a row group on a @c ThreadPool thread.
+struct FOG_NO_EXPORT PngDeflateTask : public Task
+{
+  FOG_INLINE PngDeflateTask(PngDeflateContext* ctx, PngDeflateGroup* group) :
+    _ctx(ctx),
+    _group(group)
+  {
+  }
+
+  virtual void run()
+  {
+    _group->err = PngDeflate_processGroup(_ctx, _group);
+
+    if (AtomicCore<int>::deref(&_ctx->remaining))
+      _ctx->done.signal();
+  }
+
+  PngDeflateContext* _ctx;
+  PngDeflateGroup* _group;
+};
+
+// ============================================================================
+// [Fog::PngEncoder - Construction / Destruction]
+// ============================================================================
+
+PngEncoder::PngEncoder(ImageCodecProvider* provider) :
+  ImageEncoder(provider),
+  _compression(9),
+  _filter(IMAGE_PNG_FILTER_ADAPTIVE),
+  _threads(1),
+  _png_ptr(NULL),
+  _info_ptr(NULL)
+{
+}
+
+PngEncoder::~PngEncoder()
+{
+  _destroyPngStream();
+}
+
+// ===========================================================================
+// [Fog::PngEncoder - Reset]
+// ===========================================================================
+
+void PngEncoder::reset()
+{
+  _destroyPngStream();
+  ImageEncoder::reset();
+}
+
+// ===========================================================================
+// [Fog::PngEncoder - WriteImage]
+// ===========================================================================
+
+err_t PngEncoder::writeImage(const Image& image)
+{
+  int count = _getThreadsCount(image);
+
+  // Parallel compression needs zlib and free threads, if any of them is not
+  // available then the image is written by libpng, which is always possible.
+  if (count > 1 && reinterpret_cast<PngCodecProvider*>(_provider)->_zLibrary.prepare() == ERR_OK)
+  {
+    Thread* threads[PNG_ENCODER_MAX_THREADS];
+    ThreadPool* threadPool = ThreadPool::get();
+
+    if (threadPool->getThreads(threads, (size_t)(count - 1)) == ERR_OK)
+    {
+      err_t err = _writeImageParallel(image, threads, count);
+      threadPool->releaseThreads(threads, (size_t)(count - 1));
+      return err;
+    }
+  }
+
+  err_t err = beginImage(image.getSize(), image.getFormat(), image.getPalette());
+  if (FOG_IS_ERROR(err)) return err;
+
+  err = writeRows(image.getFirst(), image.getStride(), image.getHeight());
+
+  err_t endErr = endImage();
+  return FOG_IS_ERROR(err) ? err : endErr;
+}
+
+int PngEncoder::_getThreadsCount(const Image& image) const
+{
+  int count = _threads;
+  if (count == 0)
+    count = (int)Cpu::get()->getNumberOfProcessors();
+
+  if (image.isEmpty() || image.getFormat() >= IMAGE_FORMAT_COUNT)
+    return 1;
+
+  // Each group must be large enough so the flush marker and the dictionary
+  // setup have no noticeable effect on the compression ratio and the speed.
+  uint64_t size = (uint64_t)image.getWidth() *
+    PngEncoder_getBytesPerPixel(image.getFormat()) * (uint64_t)image.getHeight();
+
+  count = (int)Math::min<uint64_t>((uint64_t)count, size / PNG_ENCODER_MIN_GROUP_SIZE);
+  count = Math::min<int>(count, PNG_ENCODER_MAX_THREADS);
+  count = Math::min<int>(count, image.getHeight());
+
+  return Math::max<int>(count, 1);
+}
+
+err_t PngEncoder::_writeImageParallel(const Image& image, Thread** threads, int count)
+{
+  // Png library pointer.
+  PngLibrary& png = reinterpret_cast<PngCodecProvider*>(_provider)->_pngLibrary;
+  FOG_ASSERT(png.err == ERR_OK);
+
+  // Writes the signature and all chunks before IDAT, the data is then
+  // filtered and compressed here and written as IDAT chunks.
+  FOG_RETURN_ON_ERROR(beginImage(image.getSize(), image.getFormat(), image.getPalette()));
+
+  int w = image.getWidth();
+  int h = image.getHeight();
+  int i;
+
+  PngDeflateGroup groups[PNG_ENCODER_MAX_THREADS];
+  PngDeflateContext ctx;
+
+  ctx.z = &reinterpret_cast<PngCodecProvider*>(_provider)->_zLibrary;
+  ctx.converter = &_converter;
+  ctx.data = image.getFirst();
+  ctx.stride = image.getStride();
+  ctx.w = w;
+  ctx.bpp = PngEncoder_getBytesPerPixel(image.getFormat());
+  ctx.rowBytes = (size_t)w * ctx.bpp;
+  ctx.filter = PngEncoder_getFilter(_filter, image.getFormat());
+  ctx.level = _compression;
+  ctx.groups = groups;
+  ctx.count = count;
+  ctx.remaining = count - 1;
+
+  for (i = 0; i < count; i++)
+  {
+    groups[i].y0 = (int)(((int64_t)h * i) / count);
+    groups[i].y1 = (int)(((int64_t)h * (i + 1)) / count);
+    groups[i].data = NULL;
+    groups[i].length = 0;
+    groups[i].capacity = 0;
+    groups[i].err = ERR_OK;
+  }
+
+  // The first group is compressed by the current thread.
+  for (i = 1; i < count; i++)
+  {
+    PngDeflateTask* task = fog_new PngDeflateTask(&ctx, &groups[i]);
+
+    if (FOG_IS_NULL(task) || FOG_IS_ERROR(threads[i - 1]->getEventLoop().postTask(task)))
+    {
+      // Posting a task fails if there is no memory or if the thread has no
+      // running event loop, compress the group by the current thread in such
+      // case.
+      if (task != NULL)
+        fog_delete(task);
+
+      groups[i].err = PngDeflate_processGroup(&ctx, &groups[i]);
+
+      if (AtomicCore<int>::deref(&ctx.remaining))
+        ctx.done.signal();
+    }
+  }
+
+  groups[0].err = PngDeflate_processGroup(&ctx, &groups[0]);
+
+  if (count > 1)
+    ctx.done.wait();
+
+  err_t err = ERR_OK;
+  uint32_t adler = 1;
+
+  for (i = 0; i < count; i++)
+  {
+    if (FOG_IS_ERROR(groups[i].err))
+    {
+      err = groups[i].err;
+      goto _End;
+    }
+
+    adler = (i == 0) ? groups[i].adler : PngZ_combineAdler32(adler, groups[i].adler, groups[i].adlerLength);
+  }
+
+  // Zlib header (deflate with 32kB window, compression level hint).
+  {
+    uint32_t header = (Z_DEFLATED + (7 << 4)) << 8;
+
+    if (_compression >= 7)
+      header |= 3 << 6;
+    else if (_compression == 6)
+      header |= 2 << 6;
+    else if (_compression >= 2)
+      header |= 1 << 6;
+
+    header += 31 - (header % 31);
+
+    groups[0].data[0] = (uint8_t)(header >> 8);
+    groups[0].data[1] = (uint8_t)(header);
+  }
+
+  // Adler32 checksum of the uncompressed (filtered) data.
+  {
+    PngDeflateGroup& last = groups[count - 1];
+
+    if (last.capacity - last.length < 4)
+    {
+      uint8_t* data = reinterpret_cast<uint8_t*>(MemMgr::realloc(last.data, last.length + 4));
+      if (FOG_IS_NULL(data))
+      {
+        err = ERR_RT_OUT_OF_MEMORY;
+        goto _End;
+      }
+
+      last.data = data;
+      last.capacity = last.length + 4;
+    }
+
+    last.data[last.length++] = (uint8_t)(adler >> 24);
+    last.data[last.length++] = (uint8_t)(adler >> 16);
+    last.data[last.length++] = (uint8_t)(adler >>  8);
+    last.data[last.length++] = (uint8_t)(adler);
+  }
+
+  if (setjmp(*png.set_longjmp_fn(_png_ptr, longjmp, sizeof(jmp_buf))))
+  {
+    err = ERR_IMAGE_LIBPNG_ERROR;
+    goto _End;
+  }
+
+  for (i = 0; i < count; i++)
+  {
+    if (groups[i].length != 0)
+      png.write_chunk(_png_ptr, reinterpret_cast<png_const_bytep>("IDAT"), groups[i].data, groups[i].length);
+  }
+
+  png.write_chunk(_png_ptr, reinterpret_cast<png_const_bytep>("IEND"), NULL, 0);
+
+_End:
+  for (i = 0; i < count; i++)
+  {
+    if (groups[i].data != NULL)
+      MemMgr::free(groups[i].data);
+  }
+
+  _destroyPngStream();
+
+  updateProgress(1.0f);
+  return err;
+}
+
+// ===========================================================================
+// [Fog::PngEncoder - Rows]
+// ===========================================================================
+
+err_t PngEncoder::beginImage(const SizeI& size, uint32_t format, const ImagePalette& palette)
+{
+  // Png library pointer.
+  PngLibrary& png = reinterpret_cast<PngCodecProvider*>(_provider)->_pngLibrary;
+  FOG_ASSERT(png.err == ERR_OK);
+
+  if (_png_ptr != NULL)
+    return ERR_RT_INVALID_STATE;
+
+  // Step 0: Simple reject.
+  if (!size.isValid())
+    return ERR_IMAGE_INVALID_SIZE;
+
+  if (format >= IMAGE_FORMAT_COUNT)
+    return ERR_IMAGE_INVALID_FORMAT;
+
+  err_t err = ERR_OK;
+  int w = size.w;
+  int h = size.h;
+
+  png_color_8 sig_bit;
+  memset(&sig_bit, 0, sizeof(sig_bit));
+
+  if ((_png_ptr = png.create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL)) == NULL)
+    return ERR_IMAGE_LIBPNG_ERROR;
+
+  if ((_info_ptr = png.create_info_struct(_png_ptr)) == NULL)
+  {
+    err = ERR_IMAGE_LIBPNG_ERROR;
+    goto _Fail;
+  }
+
+  if (setjmp(*png.set_longjmp_fn(_png_ptr, longjmp, sizeof(jmp_buf))))
+  {
+    err = ERR_IMAGE_LIBPNG_ERROR;
+    goto _Fail;
+  }
+
+  // Use custom I/O functions.
+  png.set_write_fn(_png_ptr, this, (png_rw_ptr)png_user_write_data, (png_flush_ptr)png_user_flush_data);
+
+  switch (format)
+  {
+    case IMAGE_FORMAT_PRGB32:
+    case IMAGE_FORMAT_PRGB64:
+    case IMAGE_FORMAT_A8:
+    case IMAGE_FORMAT_A16:
+    {
+      png.set_IHDR(_png_ptr, _info_ptr, w, h, 8,
+        PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE,
+        PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+
+#if FOG_BYTE_ORDER == FOG_LITTLE_ENDIAN
+      png.set_bgr(_png_ptr);
+#else
+      png.set_swap_alpha(_png_ptr);
+#endif
+
+      sig_bit.red = 8;
+      sig_bit.green = 8;
+      sig_bit.blue = 8;
+      sig_bit.alpha = 8;
+      sig_bit.gray = 0;
+      png.set_sBIT(_png_ptr, _info_ptr, &sig_bit);
+
+      err = _converter.create(
+        ImageFormatDescription::fromArgb(32, IMAGE_FD_NONE,
           PIXEL_ARGB32_MASK_A,
           PIXEL_ARGB32_MASK_R,
           PIXEL_ARGB32_MASK_G,
           PIXEL_ARGB32_MASK_B),
         ImageFormatDescription::getByFormat(format));
-      if (FOG_IS_ERROR(err)) goto _End;
+      if (FOG_IS_ERROR(err)) goto _Fail;
 
-      if (FOG_IS_NULL(buffer.alloc(w * 4)))
+      if (FOG_IS_NULL(_buffer.alloc((size_t)w * 4)))
       {
         err = ERR_RT_OUT_OF_MEMORY;
-        goto _End;
+        goto _Fail;
       }
       break;
     }
@@ -596,7 +1754,7 @@ err_t PngEncoder::writeImage(const Image& image)
     case IMAGE_FORMAT_RGB24:
     case IMAGE_FORMAT_RGB48:
     {
-      png.set_IHDR(png_ptr, info_ptr, w, h, 8,
+      png.set_IHDR(_png_ptr, _info_ptr, w, h, 8,
         PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE,
         PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
 
@@ -605,31 +1763,31 @@ err_t PngEncoder::writeImage(const Image& image)
       sig_bit.blue = 8;
       sig_bit.alpha = 0;
       sig_bit.gray = 0;
-      png.set_sBIT(png_ptr, info_ptr, &sig_bit);
+      png.set_sBIT(_png_ptr, _info_ptr, &sig_bit);
 
-      err = converter.create(
+      err = _converter.create(
         ImageFormatDescription::fromArgb(24, IMAGE_FD_NONE,
           0,
           FOG_BYTE_ORDER == FOG_LITTLE_ENDIAN ? 0x000000FF : 0x00FF0000,
           FOG_BYTE_ORDER == FOG_LITTLE_ENDIAN ? 0x0000FF00 : 0x0000FF00,
           FOG_BYTE_ORDER == FOG_LITTLE_ENDIAN ? 0x00FF0000 : 0x000000FF),
         ImageFormatDescription::getByFormat(format));
-      if (FOG_IS_ERROR(err)) goto _End;
+      if (FOG_IS_ERROR(err)) goto _Fail;
 
-      if (FOG_IS_NULL(buffer.alloc(w * 3)))
+      if (FOG_IS_NULL(_buffer.alloc((size_t)w * 3)))
       {
         err = ERR_RT_OUT_OF_MEMORY;
-        goto _End;
+        goto _Fail;
       }
       break;
     }
 
     case IMAGE_FORMAT_I8:
     {
-      const Argb32* pal = image.getPalette().getData();
-      uint32_t palLength = image.getPalette().getLength();
+      const Argb32* pal = palette.getData();
+      uint32_t palLength = (uint32_t)Math::min<size_t>(palette.getLength(), 256);
 
-      png.set_IHDR(png_ptr, info_ptr, w, h, 8,
+      png.set_IHDR(_png_ptr, _info_ptr, w, h, 8,
         PNG_COLOR_TYPE_PALETTE, PNG_INTERLACE_NONE,
         PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
 
@@ -641,7 +1799,7 @@ err_t PngEncoder::writeImage(const Image& image)
         entries[i].blue  = pal[i].getBlue();
       }
 
-      png.set_PLTE(png_ptr, info_ptr, entries, palLength);
+      png.set_PLTE(_png_ptr, _info_ptr, entries, palLength);
       break;
     }
 
@@ -649,49 +1807,123 @@ err_t PngEncoder::writeImage(const Image& image)
       FOG_ASSERT_NOT_REACHED();
   }
 
-  png.set_compression_level(png_ptr, _compression);
-  png.write_info(png_ptr, info_ptr);
-  png.set_shift(png_ptr, &sig_bit);
-  png.set_packing(png_ptr);
-  row_ptr = (png_bytep)buffer.getMem();
+  png.set_compression_level(_png_ptr, _compression);
+  png.set_filter(_png_ptr, PNG_FILTER_TYPE_BASE,
+    PngEncoder_getLibPngFilter(PngEncoder_getFilter(_filter, format)));
+  png.write_info(_png_ptr, _info_ptr);
+  png.set_shift(_png_ptr, &sig_bit);
+  png.set_packing(_png_ptr);
+
+  _rowsPosition = 0;
+  _rowsSize = size;
+  _rowsFormat = format;
+  return ERR_OK;
+
+_Fail:
+  _destroyPngStream();
+  return err;
+}
+
+err_t PngEncoder::writeRows(const uint8_t* data, ssize_t stride, int count)
+{
+  // Png library pointer.
+  PngLibrary& png = reinterpret_cast<PngCodecProvider*>(_provider)->_pngLibrary;
+  FOG_ASSERT(png.err == ERR_OK);
+
+  if (_png_ptr == NULL)
+    return ERR_RT_INVALID_STATE;
+
+  if (count < 0 || count > _rowsSize.h - _rowsPosition)
+    return ERR_RT_INVALID_ARGUMENT;
+
+  if (setjmp(*png.set_longjmp_fn(_png_ptr, longjmp, sizeof(jmp_buf))))
+  {
+    _destroyPngStream();
+    return ERR_IMAGE_LIBPNG_ERROR;
+  }
+
+  png_bytep row_ptr;
+  int w = _rowsSize.w;
 
-  if (converter.isValid())
+  if (_converter.isValid())
   {
     ImageConverterClosure closure;
     ImageConverterBlitLineFunc blit;
 
-    converter.setupClosure(&closure);
-    blit = converter.getBlitFn();
+    _converter.setupClosure(&closure);
+    blit = _converter.getBlitFn();
 
-    for (y = 0; y < h; y++, pixels += stride)
-    {
-      blit((uint8_t*)row_ptr, pixels, w, &closure);
-      png.write_rows(png_ptr, &row_ptr, 1);
+    row_ptr = (png_bytep)_buffer.getMem();
 
-      if ((y & 15) == 0) updateProgress(y, h);
+    for (int i = 0; i < count; i++, data += stride)
+    {
+      blit((uint8_t*)row_ptr, data, w, &closure);
+      png.write_rows(_png_ptr, &row_ptr, 1);
     }
   }
   else
   {
-    for (y = 0; y < h; y++, pixels += stride)
+    for (int i = 0; i < count; i++, data += stride)
     {
-      row_ptr = (png_bytep)pixels;
-      png.write_rows(png_ptr, &row_ptr, 1);
-
-      if ((y & 15) == 0) updateProgress(y, h);
+      row_ptr = (png_bytep)data;
+      png.write_rows(_png_ptr, &row_ptr, 1);
     }
   }
 
-  png.write_end(png_ptr, info_ptr);
+  _rowsPosition += count;
+  updateProgress((uint32_t)_rowsPosition, (uint32_t)_rowsSize.h);
+
+  return ERR_OK;
+}
+
+err_t PngEncoder::endImage()
+{
+  // Png library pointer.
+  PngLibrary& png = reinterpret_cast<PngCodecProvider*>(_provider)->_pngLibrary;
+  FOG_ASSERT(png.err == ERR_OK);
+
+  if (_png_ptr == NULL)
+    return ERR_RT_INVALID_STATE;
 
-_EndDestroyWriteStruct:
-  png.destroy_write_struct(&png_ptr, (png_infopp)&info_ptr);
+  err_t err;
+
+  if (setjmp(*png.set_longjmp_fn(_png_ptr, longjmp, sizeof(jmp_buf))))
+  {
+    err = ERR_IMAGE_LIBPNG_ERROR;
+  }
+  else if (_rowsPosition != _rowsSize.h)
+  {
+    err = ERR_IMAGE_TRUNCATED;
+  }
+  else
+  {
+    png.write_end(_png_ptr, _info_ptr);
+    err = ERR_OK;
+  }
+
+  _destroyPngStream();
 
-_End:
   updateProgress(1.0f);
   return err;
 }
 
+void PngEncoder::_destroyPngStream()
+{
+  // Png library pointer.
+  PngLibrary& png = reinterpret_cast<PngCodecProvider*>(_provider)->_pngLibrary;
+
+  if (_png_ptr != NULL)
+    png.destroy_write_struct(&_png_ptr, &_info_ptr);
+
+  _png_ptr = NULL;
+  _info_ptr = NULL;
+
+  _converter.reset();
+  _buffer.reset();
+
+  _rowsPosition = -1;
+}
+
 // ===========================================================================
 // [Fog::PngEncoder - Properties]
 // ===========================================================================
@@ -701,6 +1933,12 @@ err_t PngEncoder::_getProperty(const InternedStringW& name, Var& dst) const
   if (name == FOG_S(compression))
     return dst.setInt(_compression);
 
+  if (name == FOG_S(filter))
+    return dst.setInt(_filter);
+
+  if (name == FOG_S(threads))
+    return dst.setInt(_threads);
+
   return Base::_getProperty(name, dst);
 }
 
@@ -709,6 +1947,12 @@ err_t PngEncoder::_setProperty(const InternedStringW& name, const Var& src)
   if (name == FOG_S(compression))
     return src.getInt(_compression, 0, 9);
 
+  if (name == FOG_S(filter))
+    return src.getInt(_filter, 0, IMAGE_PNG_FILTER_COUNT - 1);
+
+  if (name == FOG_S(threads))
+    return src.getInt(_threads, 0, PNG_ENCODER_MAX_THREADS);
+
   return Base::_setProperty(name, src);
 }
 
@@ -12,15 +12,18 @@
 
 // [Dependencies]
 #include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Memory/MemBuffer.h>
 #include <Fog/Core/OS/Library.h>
 #include <Fog/Core/Tools/String.h>
 #include <Fog/G2d/Imaging/Image.h>
 #include <Fog/G2d/Imaging/ImageCodec.h>
 #include <Fog/G2d/Imaging/ImageCodecProvider.h>
+#include <Fog/G2d/Imaging/ImageConverter.h>
 #include <Fog/G2d/Imaging/ImageDecoder.h>
 #include <Fog/G2d/Imaging/ImageEncoder.h>
 
 #include <png.h>
+#include <zlib.h>
 
 namespace Fog {
 
@@ -41,7 +44,7 @@ struct FOG_NO_EXPORT PngLibrary
   err_t init();
   void close();
 
-  enum { NUM_SYMBOLS = 36 };
+  enum { NUM_SYMBOLS = 43 };
   union
   {
     struct
@@ -53,11 +56,16 @@ struct FOG_NO_EXPORT PngLibrary
       void (FOG_CDECL *read_rows)(png_structp png_ptr, png_bytepp row, png_bytepp display_row, png_uint_32 num_rows);
       void (FOG_CDECL *read_image)(png_structp png_ptr, png_bytepp image);
       void (FOG_CDECL *read_end)(png_structp png_ptr, png_infop info_ptr);
+      void (FOG_CDECL *start_read_image)(png_structp png_ptr);
+      void (FOG_CDECL *process_data)(png_structp png_ptr, png_infop info_ptr, png_bytep buffer, png_size_t buffer_size);
+      png_size_t (FOG_CDECL *process_data_pause)(png_structp png_ptr, int save);
+      void (FOG_CDECL *progressive_combine_row)(png_structp png_ptr, png_bytep old_row, png_const_bytep new_row);
       png_structp (FOG_CDECL *create_write_struct)(png_const_charp user_ver, png_voidp error_ptr, png_error_ptr error_fn, png_error_ptr warn_fn);
       void (FOG_CDECL *destroy_write_struct)(png_structpp ptr_ptr, png_infopp info_ptr_ptr);
       void (FOG_CDECL *write_info)(png_structp png_ptr, png_infop info_ptr);
       void (FOG_CDECL *write_rows)(png_structp png_ptr, png_bytepp row, png_uint_32 num_rows);
       void (FOG_CDECL *write_end)(png_structp png_ptr, png_infop info_ptr);
+      void (FOG_CDECL *write_chunk)(png_structp png_ptr, png_const_bytep chunk_name, png_const_bytep data, png_size_t length);
 
       void (FOG_CDECL *set_expand_gray_1_2_4_to_8)(png_structp png_ptr);
       void (FOG_CDECL *set_gray_to_rgb)(png_structp png_ptr);
@@ -69,11 +77,13 @@ struct FOG_NO_EXPORT PngLibrary
       void (FOG_CDECL *set_shift)(png_structp png_ptr, png_color_8p true_bits);
       void (FOG_CDECL *set_error_fn)(png_structp png_ptr, png_voidp error_ptr, png_error_ptr error_fn, png_error_ptr warning_fn);
       void (FOG_CDECL *set_read_fn)(png_structp png_ptr, png_voidp io_ptr, png_rw_ptr read_data_fn);
+      void (FOG_CDECL *set_progressive_read_fn)(png_structp png_ptr, png_voidp progressive_ptr, png_progressive_info_ptr info_fn, png_progressive_row_ptr row_fn, png_progressive_end_ptr end_fn);
       void (FOG_CDECL *set_write_fn)(png_structp png_ptr, png_voidp io_ptr, png_rw_ptr write_data_fn, png_flush_ptr output_flush_fn);
       void (FOG_CDECL *set_bgr)(png_structp png_ptr);
       void (FOG_CDECL *set_expand)(png_structp png_ptr);
       int (FOG_CDECL *set_interlace_handling)(png_structp png_ptr);
       void (FOG_CDECL *set_compression_level)(png_structp png_ptr, int level);
+      void (FOG_CDECL *set_filter)(png_structp png_ptr, int method, int filters);
       jmp_buf* (FOG_CDECL *set_longjmp_fn)(png_structp png_ptr, png_longjmp_ptr fn, size_t jmp_buf_size);
       void (FOG_CDECL *set_IHDR)(png_structp png_ptr,
         png_infop info_ptr, png_uint_32 width, png_uint_32 height, int bit_depth,
@@ -101,6 +111,44 @@ private:
   FOG_NO_COPY(PngLibrary)
 };
 
+// ============================================================================
+// [Fog::PngZLibrary]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Zlib library, used by the parallel PNG encoder to compress the IDAT
+//! stream (libpng doesn't expose its zlib stream).
+struct FOG_NO_EXPORT PngZLibrary
+{
+  PngZLibrary();
+  ~PngZLibrary();
+
+  err_t prepare();
+  err_t init();
+  void close();
+
+  enum { NUM_SYMBOLS = 5 };
+  union
+  {
+    struct
+    {
+      int (FOG_CDECL *deflate_init2)(z_streamp strm, int level, int method, int windowBits, int memLevel, int strategy, const char* version, int stream_size);
+      int (FOG_CDECL *deflate)(z_streamp strm, int flush);
+      int (FOG_CDECL *deflate_end)(z_streamp strm);
+      int (FOG_CDECL *deflate_set_dictionary)(z_streamp strm, const Bytef* dictionary, uInt dictLength);
+      uLong (FOG_CDECL *adler32)(uLong adler, const Bytef* buf, uInt len);
+    };
+    void* addr[NUM_SYMBOLS];
+  };
+
+  Library dll;
+  err_t err;
+
+private:
+  FOG_NO_COPY(PngZLibrary)
+};
+
 // ============================================================================
 // [Fog::PngCodecProvider]
 // ============================================================================
@@ -127,6 +175,7 @@ struct FOG_NO_EXPORT PngCodecProvider : public ImageCodecProvider
   // --------------------------------------------------------------------------
 
   PngLibrary _pngLibrary;
+  PngZLibrary _zLibrary;
 };
 
 // ============================================================================
@@ -153,6 +202,20 @@ struct FOG_NO_EXPORT PngDecoder : public ImageDecoder
   virtual err_t readHeader();
   virtual err_t readImage(Image& image);
 
+  // --------------------------------------------------------------------------
+  // [Incremental]
+  // --------------------------------------------------------------------------
+
+  virtual bool isIncremental() const;
+  virtual err_t feed(const void* data, size_t size);
+  virtual err_t finish(Image& image);
+
+  // --------------------------------------------------------------------------
+  // [Rows]
+  // --------------------------------------------------------------------------
+
+  virtual err_t readRows(uint8_t* dst, ssize_t dstStride, int count);
+
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
@@ -163,8 +226,59 @@ struct FOG_NO_EXPORT PngDecoder : public ImageDecoder
   int _png_color_type;
   int _png_interlace_type;
 
+  //! @brief Count of passes (7 if the image is interlaced, otherwise 1).
+  int _passesCount;
+  //! @brief The first row of the rows not reported to the handler yet.
+  int _rowsFirst;
+  //! @brief The end of the rows not reported to the handler yet.
+  int _rowsLast;
+  //! @brief The pass of the rows not reported to the handler yet.
+  int _rowsPass;
+
+  //! @brief Error returned by the handler or by the decoder itself, which
+  //! interrupted libpng.
+  err_t _callbackError;
+
+  //! @brief The image being decoded.
+  Image _image;
+  //! @brief Converter used to premultiply the decoded rows (if needed).
+  ImageConverter _converter;
+  //! @brief Non-premultiplied copy of the image, needed to combine rows of
+  //! interlaced images with alpha channel.
+  MemBuffer _interlaceBuffer;
+  //! @brief Stride of @c _interlaceBuffer.
+  size_t _interlaceStride;
+
+  //! @brief Whether the rows are decoded by @c readRows().
+  bool _queueStreaming;
+  //! @brief Rows decoded by libpng, but not returned by @c readRows() yet.
+  //!
+  //! libpng can't be paused in the middle of the compressed data, so a single
+  //! chunk of data can produce more rows than requested.
+  uint8_t* _queue;
+  //! @brief Stride of @c _queue.
+  size_t _queueStride;
+  //! @brief Count of rows in @c _queue.
+  int _queueCount;
+  //! @brief Capacity of @c _queue (in rows).
+  int _queueCapacity;
+
   uint32_t _createPngStream();
   void _deletePngStream();
+
+  err_t _processData(const void* data, size_t size);
+  err_t _processStream(bool headerOnly);
+  err_t _decodeData(const void* data, size_t size);
+
+  err_t _createConverter();
+  err_t _beginImage();
+  err_t _flushRows();
+  err_t _queueRow(png_bytep newRow);
+
+  void _onInfo();
+  void _onRow(png_bytep newRow, png_uint_32 y, int pass);
+  void _onEnd();
+  void _onError(err_t err);
 };
 
 // ============================================================================
@@ -187,8 +301,25 @@ struct FOG_NO_EXPORT PngEncoder : public ImageEncoder
   // [Implementation]
   // --------------------------------------------------------------------------
 
+  virtual void reset();
   virtual err_t writeImage(const Image& image);
 
+  //! @brief Get the count of threads used to compress @a image (1 means
+  //! that the image is compressed by libpng on the current thread).
+  int _getThreadsCount(const Image& image) const;
+  //! @brief Write @a image splitting it into @a count row groups, which
+  //! are compressed in parallel by the current thread and @a threads.
+  err_t _writeImageParallel(const Image& image, Thread** threads, int count);
+
+  // --------------------------------------------------------------------------
+  // [Rows]
+  // --------------------------------------------------------------------------
+
+  virtual err_t beginImage(const SizeI& size, uint32_t format,
+    const ImagePalette& palette = ImagePalette::getEmptyInstance());
+  virtual err_t writeRows(const uint8_t* data, ssize_t stride, int count);
+  virtual err_t endImage();
+
   // --------------------------------------------------------------------------
   // [Properties]
   // --------------------------------------------------------------------------
@@ -200,7 +331,25 @@ struct FOG_NO_EXPORT PngEncoder : public ImageEncoder
   // [Members]
   // --------------------------------------------------------------------------
 
+  //! @brief Compression level (0-9).
   int _compression;
+  //! @brief Row filter, see @c IMAGE_PNG_FILTER.
+  int _filter;
+  //! @brief Count of threads used to compress the image (0 means the count
+  //! of processors).
+  int _threads;
+
+  //! @brief Png write structure, valid between @c beginImage() and
+  //! @c endImage().
+  png_structp _png_ptr;
+  png_infop _info_ptr;
+
+  //! @brief Converter to the format written by libpng (if needed).
+  ImageConverter _converter;
+  //! @brief Converted row.
+  MemBuffer _buffer;
+
+  void _destroyPngStream();
 };
 
 //! @}
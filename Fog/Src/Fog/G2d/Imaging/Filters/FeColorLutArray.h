@@ -126,9 +126,9 @@ struct FOG_NO_EXPORT FeColorLutArray
     return _d->data;
   }
 
-  FOG_INLINE err_t setFromFunction(FeColorLutArray* self, const FeComponentFunction& func)
+  FOG_INLINE err_t setFromFunction(const FeComponentFunction& func)
   {
-    return fog_api.fecolorlutarray_setFromComponentFunction(self, &func);
+    return fog_api.fecolorlutarray_setFromComponentFunction(this, &func);
   }
 
   FOG_INLINE bool isIdentity() const
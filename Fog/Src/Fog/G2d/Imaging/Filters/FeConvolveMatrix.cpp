@@ -37,6 +37,8 @@ static void FOG_CDECL FeConvolveMatrix_ctorCopy(FeConvolveMatrix* self, const Fe
   self->_extendType = other->_extendType;
   self->_extendColor.init(other->_extendColor);
   self->_matrix.initCustom1(other->_matrix());
+  self->_scale = other->_scale;
+  self->_bias = other->_bias;
 }
 
 static void FOG_CDECL FeConvolveMatrix_dtor(FeConvolveMatrix* self)
@@ -63,8 +65,8 @@ static void FOG_CDECL FeConvolveMatrix_reset(FeConvolveMatrix* self)
 
 static err_t FOG_CDECL FeConvolveMatrix_copy(FeConvolveMatrix* self, const FeConvolveMatrix* other)
 {
-  self->_extendType = FE_EXTEND_COLOR;
-  self->_extendColor.init();
+  self->_extendType = other->_extendType;
+  self->_extendColor() = other->_extendColor();
   self->_matrix() = other->_matrix();
   self->_scale = other->_scale;
   self->_bias = other->_bias;
@@ -82,7 +84,7 @@ static bool FOG_CDECL FeConvolveMatrix_eq(const FeConvolveMatrix* a, const FeCon
          a->_extendColor() == b->_extendColor() &&
          a->_matrix() == b->_matrix() &&
          a->_scale == b->_scale &&
-         b->_bias == b->_bias;
+         a->_bias == b->_bias;
 }
 
 // ============================================================================
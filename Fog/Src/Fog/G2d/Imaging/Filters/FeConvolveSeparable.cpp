@@ -23,7 +23,7 @@ namespace Fog {
 
 static void FOG_CDECL FeConvolveSeparable_ctor(FeConvolveSeparable* self)
 {
-  self->_feType = FE_TYPE_CONVOLVE_MATRIX;
+  self->_feType = FE_TYPE_CONVOLVE_SEPARABLE;
   self->_extendType = FE_EXTEND_COLOR;
   self->_extendColor.init();
   self->_hVector.init();
@@ -36,7 +36,7 @@ static void FOG_CDECL FeConvolveSeparable_ctor(FeConvolveSeparable* self)
 
 static void FOG_CDECL FeConvolveSeparable_ctorCopy(FeConvolveSeparable* self, const FeConvolveSeparable* other)
 {
-  self->_feType = FE_TYPE_CONVOLVE_MATRIX;
+  self->_feType = FE_TYPE_CONVOLVE_SEPARABLE;
   self->_extendType = other->_extendType;
   self->_extendColor.init(other->_extendColor);
   self->_hVector.initCustom1(other->_hVector());
@@ -75,8 +75,8 @@ static void FOG_CDECL FeConvolveSeparable_reset(FeConvolveSeparable* self)
 
 static err_t FOG_CDECL FeConvolveSeparable_copy(FeConvolveSeparable* self, const FeConvolveSeparable* other)
 {
-  self->_extendType = FE_EXTEND_COLOR;
-  self->_extendColor.init();
+  self->_extendType = other->_extendType;
+  self->_extendColor() = other->_extendColor();
   self->_hVector() = other->_hVector();
   self->_vVector() = other->_vVector();
   self->_hScale = other->_hScale;
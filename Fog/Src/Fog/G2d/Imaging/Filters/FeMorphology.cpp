@@ -21,7 +21,7 @@ namespace Fog {
 
 static void FOG_CDECL FeMorphology_ctor(FeMorphology* self)
 {
-  self->_feType = FE_TYPE_BLUR;
+  self->_feType = FE_TYPE_MORPHOLOGY;
   self->_extendType = FE_EXTEND_COLOR;
   self->_extendColor.init();
 
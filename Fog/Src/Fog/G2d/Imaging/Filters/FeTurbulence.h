@@ -66,11 +66,11 @@ struct FOG_NO_EXPORT FeTurbulence : public FeBase
       ? turbulenceType
       : FE_TURBULENCE_TYPE_DEFAULT;
     _numOctaves = numOctaves;
-    _stitchTitles = stitchTitles;
+    _stitchTitles = !!stitchTitles;
     _seed = seed;
 
-    _hBaseFrequency = vBaseFrequency;
-    _vBaseFrequency = hBaseFrequency;
+    _hBaseFrequency = hBaseFrequency;
+    _vBaseFrequency = vBaseFrequency;
   }
 
   // --------------------------------------------------------------------------
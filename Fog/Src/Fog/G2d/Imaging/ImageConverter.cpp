@@ -180,6 +180,14 @@ static err_t FOG_CDECL ImageConverter_create(ImageConverter* self,
   FOG_ASSERT(d->dstPalette->_d == NULL);
   FOG_ASSERT(d->srcPalette->_d == NULL);
 
+  // Keep the palettes, the source palette is passed to the blit function by
+  // the closure (I8 source formats).
+  if (dstPalette != NULL)
+    d->dstPalette.initCustom1(*dstPalette);
+
+  if (srcPalette != NULL)
+    d->srcPalette.initCustom1(*srcPalette);
+
   // Use the direct converter if available.
   if (df->getFormat() < IMAGE_FORMAT_COUNT && !df->isIndexed() &&
       sf->getFormat() < IMAGE_FORMAT_COUNT && !dither)
@@ -9,6 +9,8 @@
 #endif // FOG_PRECOMP
 
 // [Dependencies]
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Tools/Stream.h>
 #include <Fog/G2d/Imaging/Image.h>
 #include <Fog/G2d/Imaging/ImageCodecProvider.h>
 #include <Fog/G2d/Imaging/ImageDecoder.h>
@@ -17,6 +19,49 @@ FOG_IMPLEMENT_OBJECT(Fog::ImageDecoder)
 
 namespace Fog {
 
+// ============================================================================
+// [Fog::ImageDecoderHandler - Construction / Destruction]
+// ============================================================================
+
+ImageDecoderHandler::ImageDecoderHandler() {}
+ImageDecoderHandler::~ImageDecoderHandler() {}
+
+// ============================================================================
+// [Fog::ImageDecoderHandler - Interface]
+// ============================================================================
+
+err_t ImageDecoderHandler::onHeader(ImageDecoder* decoder)
+{
+  FOG_UNUSED(decoder);
+  return ERR_OK;
+}
+
+err_t ImageDecoderHandler::onRows(ImageDecoder* decoder, const Image& image, int y, int height, uint32_t pass)
+{
+  FOG_UNUSED(decoder);
+  FOG_UNUSED(image);
+  FOG_UNUSED(y);
+  FOG_UNUSED(height);
+  FOG_UNUSED(pass);
+  return ERR_OK;
+}
+
+err_t ImageDecoderHandler::onPass(ImageDecoder* decoder, const Image& image, uint32_t pass, uint32_t passesCount)
+{
+  FOG_UNUSED(decoder);
+  FOG_UNUSED(image);
+  FOG_UNUSED(pass);
+  FOG_UNUSED(passesCount);
+  return ERR_OK;
+}
+
+err_t ImageDecoderHandler::onFrame(ImageDecoder* decoder, const Image& image)
+{
+  FOG_UNUSED(decoder);
+  FOG_UNUSED(image);
+  return ERR_OK;
+}
+
 // ============================================================================
 // [Fog::ImageDecoder - Construction / Destruction]
 // ============================================================================
@@ -26,7 +71,9 @@ ImageDecoder::ImageDecoder(ImageCodecProvider* provider) :
   _headerDone(false),
   _readerDone(false),
   _headerResult(ERR_OK),
-  _readerResult(ERR_OK)
+  _readerResult(ERR_OK),
+  _handler(NULL),
+  _rowsPosition(0)
 {
   _codecType = IMAGE_CODEC_DECODER;
 }
@@ -35,6 +82,83 @@ ImageDecoder::~ImageDecoder()
 {
 }
 
+// ============================================================================
+// [Fog::ImageDecoder - Incremental]
+// ============================================================================
+
+bool ImageDecoder::isIncremental() const
+{
+  return false;
+}
+
+err_t ImageDecoder::feed(const void* data, size_t size)
+{
+  if (size == 0)
+    return ERR_OK;
+
+  if (FOG_IS_NULL(data))
+    return ERR_RT_INVALID_ARGUMENT;
+
+  // The generic implementation only buffers the data, the image is decoded
+  // by finish() using the blocking decoder.
+  return _feedBuffer.append(reinterpret_cast<const char*>(data), size);
+}
+
+err_t ImageDecoder::finish(Image& image)
+{
+  Stream stream;
+  FOG_RETURN_ON_ERROR(stream.openBuffer(_feedBuffer));
+
+  attachStream(stream);
+  _feedBuffer.reset();
+
+  return readImage(image);
+}
+
+// ============================================================================
+// [Fog::ImageDecoder - Rows]
+// ============================================================================
+
+err_t ImageDecoder::readRows(uint8_t* dst, ssize_t dstStride, int count)
+{
+  if (readHeader() != ERR_OK) return _headerResult;
+
+  if (count < 0 || count > _size.h - _rowsPosition)
+    return ERR_RT_INVALID_ARGUMENT;
+
+  // The generic implementation decodes the whole image on the first call.
+  if (_rowsImage.isEmpty())
+  {
+    if (_rowsPosition != 0)
+      return ERR_RT_INVALID_STATE;
+
+    FOG_RETURN_ON_ERROR(readImage(_rowsImage));
+
+    // Some decoders know the final format only after the image was decoded.
+    _size = _rowsImage.getSize();
+    _format = _rowsImage.getFormat();
+    _palette = _rowsImage.getPalette();
+
+    if (count > _size.h)
+      return ERR_RT_INVALID_ARGUMENT;
+  }
+
+  const uint8_t* srcPixels = _rowsImage.getFirst() + (ssize_t)_rowsPosition * _rowsImage.getStride();
+  ssize_t srcStride = _rowsImage.getStride();
+  size_t bpl = (size_t)_size.w * _rowsImage.getBytesPerPixel();
+
+  for (int i = 0; i < count; i++, dst += dstStride, srcPixels += srcStride)
+    MemOps::copy(dst, srcPixels, bpl);
+
+  _rowsPosition += count;
+
+  // Release the image after the last row was returned.
+  if (_rowsPosition == _size.h)
+    _rowsImage.reset();
+
+  return ERR_OK;
+}
+
 // ============================================================================
 // [Fog::ImageDecoder - Reset]
 // ============================================================================
@@ -48,6 +172,9 @@ void ImageDecoder::reset()
 
   _headerResult = ERR_OK;
   _readerResult = ERR_OK;
+
+  _rowsPosition = 0;
+  _rowsImage.reset();
 }
 
 } // Fog namespace
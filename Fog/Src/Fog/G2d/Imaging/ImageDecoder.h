@@ -9,6 +9,7 @@
 
 // [Dependencies]
 #include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Tools/String.h>
 #include <Fog/G2d/Imaging/ImageCodec.h>
 
 namespace Fog {
@@ -16,11 +17,77 @@ namespace Fog {
 //! @addtogroup Fog_G2d_Imaging
 //! @{
 
+// ============================================================================
+// [Fog::ImageDecoderHandler]
+// ============================================================================
+
+//! @brief Image decoder handler.
+//!
+//! The handler receives notifications about image data as they are decoded,
+//! which makes it possible to display or process partially decoded images
+//! (progressive JPEG, interlaced PNG / GIF, or simply images which are still
+//! being downloaded).
+//!
+//! The @c Image passed to the callbacks is the decoder's target image. Rows
+//! which weren't decoded yet are fully transparent (or black in case that the
+//! image has no alpha channel). The image can be painted by the handler, but
+//! its content is only valid during the callback.
+//!
+//! Each callback can return an error code, which aborts decoding. The error
+//! is then returned by @c ImageDecoder::readImage(), @c ImageDecoder::feed()
+//! or @c ImageDecoder::finish().
+struct FOG_API ImageDecoderHandler
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  ImageDecoderHandler();
+  virtual ~ImageDecoderHandler();
+
+  // --------------------------------------------------------------------------
+  // [Interface]
+  // --------------------------------------------------------------------------
+
+  //! @brief Called when the image header was read, the size, depth and format
+  //! of the image are known.
+  virtual err_t onHeader(ImageDecoder* decoder);
+
+  //! @brief Called when the rows [y, y + height) of @a image were decoded or
+  //! refined by the pass @a pass.
+  virtual err_t onRows(ImageDecoder* decoder, const Image& image, int y, int height, uint32_t pass);
+
+  //! @brief Called when the pass @a pass (of @a passesCount) was completed.
+  //!
+  //! Non-interlaced images have only one pass. The @a passesCount is zero if
+  //! the count of passes is not known in advance (progressive JPEG).
+  virtual err_t onPass(ImageDecoder* decoder, const Image& image, uint32_t pass, uint32_t passesCount);
+
+  //! @brief Called when the whole frame was decoded.
+  virtual err_t onFrame(ImageDecoder* decoder, const Image& image);
+
+private:
+  FOG_NO_COPY(ImageDecoderHandler)
+};
+
 // ============================================================================
 // [Fog::ImageDecoder]
 // ============================================================================
 
 //! @brief Image decoder.
+//!
+//! The image can be decoded using two ways:
+//!
+//!   - Blocking - The stream is attached by @c attachStream() and the image
+//!     is decoded by @c readImage().
+//!
+//!   - Incremental - The encoded data are passed to the decoder through
+//!     @c feed() as they arrive and the decoding is completed by @c finish().
+//!
+//! In both cases @c ImageDecoderHandler (if set) is notified about decoded
+//! rows and completed passes (PNG, JPEG and GIF decoders). Decoders which are
+//! not able to suspend when the input data is exhausted buffer the data passed
+//! to @c feed() and decode the image in @c finish(), see @c isIncremental().
 struct FOG_API ImageDecoder : public ImageCodec
 {
   FOG_DECLARE_OBJECT(ImageDecoder, ImageCodec)
@@ -41,6 +108,11 @@ struct FOG_API ImageDecoder : public ImageCodec
   FOG_INLINE uint32_t getHeaderResult() const { return _headerResult; }
   FOG_INLINE uint32_t getReaderResult() const { return _readerResult; }
 
+  //! @brief Get the decoder handler.
+  FOG_INLINE ImageDecoderHandler* getHandler() const { return _handler; }
+  //! @brief Set the decoder handler, which will receive decoder events.
+  FOG_INLINE void setHandler(ImageDecoderHandler* handler) { _handler = handler; }
+
   // --------------------------------------------------------------------------
   // [Virtuals]
   // --------------------------------------------------------------------------
@@ -48,6 +120,49 @@ struct FOG_API ImageDecoder : public ImageCodec
   virtual err_t readHeader() = 0;
   virtual err_t readImage(Image& image) = 0;
 
+  // --------------------------------------------------------------------------
+  // [Incremental]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get whether the decoder decodes data passed to @c feed()
+  //! immediately (without buffering the whole image).
+  virtual bool isIncremental() const;
+
+  //! @brief Feed the decoder by @a size bytes of encoded data.
+  //!
+  //! The decoder doesn't need the data after @c feed() returns.
+  virtual err_t feed(const void* data, size_t size);
+
+  //! @brief Finish incremental decoding, storing the decoded image into
+  //! @a image.
+  //!
+  //! If the data passed to @c feed() were truncated, the partially decoded
+  //! image is stored into @a image and @c ERR_IMAGE_TRUNCATED is returned.
+  virtual err_t finish(Image& image);
+
+  // --------------------------------------------------------------------------
+  // [Rows]
+  // --------------------------------------------------------------------------
+
+  //! @brief Decode the next @a count rows of the image into @a dst.
+  //!
+  //! The rows are stored in the format returned by @c getFormat() (the
+  //! palette is returned by @c getPalette() in case that the format is
+  //! @c IMAGE_FORMAT_I8), the header must be read by @c readHeader() first.
+  //! Rows are returned from top to bottom, the position of the next row is
+  //! returned by @c getRowsPosition().
+  //!
+  //! Decoders which are able to stream (PNG without interlacing and JPEG)
+  //! keep only a few rows in memory, the other decoders decode the whole
+  //! image on the first call. Since some decoders know the final size and
+  //! format only after decoding, call @c readRows() with zero @a count to get
+  //! them before the buffers are allocated. This method can't be combined with
+  //! @c readImage() or @c feed().
+  virtual err_t readRows(uint8_t* dst, ssize_t dstStride, int count);
+
+  //! @brief Get the index of the next row returned by @c readRows().
+  FOG_INLINE int getRowsPosition() const { return _rowsPosition; }
+
   // --------------------------------------------------------------------------
   // [Internal]
   // --------------------------------------------------------------------------
@@ -55,6 +170,26 @@ struct FOG_API ImageDecoder : public ImageCodec
 protected:
   virtual void reset();
 
+  FOG_INLINE err_t _notifyHeader()
+  {
+    return _handler ? _handler->onHeader(this) : (err_t)ERR_OK;
+  }
+
+  FOG_INLINE err_t _notifyRows(const Image& image, int y, int height, uint32_t pass = 0)
+  {
+    return _handler ? _handler->onRows(this, image, y, height, pass) : (err_t)ERR_OK;
+  }
+
+  FOG_INLINE err_t _notifyPass(const Image& image, uint32_t pass, uint32_t passesCount)
+  {
+    return _handler ? _handler->onPass(this, image, pass, passesCount) : (err_t)ERR_OK;
+  }
+
+  FOG_INLINE err_t _notifyFrame(const Image& image)
+  {
+    return _handler ? _handler->onFrame(this, image) : (err_t)ERR_OK;
+  }
+
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
@@ -68,6 +203,18 @@ protected:
   uint32_t _headerResult;
   //! @brief Image decoder result code (returned by @c readImage()).
   uint32_t _readerResult;
+
+  //! @brief Decoder handler (can be @c NULL).
+  ImageDecoderHandler* _handler;
+  //! @brief Data passed to @c feed(), used by decoders which are not able to
+  //! decode incrementally.
+  StringA _feedBuffer;
+
+  //! @brief Index of the next row returned by @c readRows().
+  int _rowsPosition;
+  //! @brief The whole image, used by @c readRows() if the decoder is not able
+  //! to stream.
+  Image _rowsImage;
 };
 
 //! @}
@@ -9,6 +9,7 @@
 #endif // FOG_PRECOMP
 
 // [Dependencies]
+#include <Fog/Core/Memory/MemOps.h>
 #include <Fog/G2d/Imaging/Image.h>
 #include <Fog/G2d/Imaging/ImageCodecProvider.h>
 #include <Fog/G2d/Imaging/ImageEncoder.h>
@@ -24,7 +25,10 @@ namespace Fog {
 ImageEncoder::ImageEncoder(ImageCodecProvider* provider) :
   ImageCodec(provider),
   _headerDone(false),
-  _writerDone(false)
+  _writerDone(false),
+  _rowsPosition(-1),
+  _rowsSize(0, 0),
+  _rowsFormat(IMAGE_FORMAT_NULL)
 {
   _codecType = IMAGE_CODEC_ENCODER;
 }
@@ -44,6 +48,75 @@ void ImageEncoder::detachStream()
   ImageCodec::detachStream();
 }
 
+// ============================================================================
+// [Fog::ImageEncoder - Rows]
+// ============================================================================
+
+err_t ImageEncoder::beginImage(const SizeI& size, uint32_t format, const ImagePalette& palette)
+{
+  if (_rowsPosition != -1)
+    return ERR_RT_INVALID_STATE;
+
+  if (!size.isValid())
+    return ERR_IMAGE_INVALID_SIZE;
+
+  if (format >= IMAGE_FORMAT_COUNT)
+    return ERR_IMAGE_INVALID_FORMAT;
+
+  // The generic implementation collects the rows into a temporary image.
+  FOG_RETURN_ON_ERROR(_rowsImage.create(size, format));
+
+  if (format == IMAGE_FORMAT_I8)
+    FOG_RETURN_ON_ERROR(_rowsImage.setPalette(palette));
+
+  _rowsPosition = 0;
+  _rowsSize = size;
+  _rowsFormat = format;
+
+  return ERR_OK;
+}
+
+err_t ImageEncoder::writeRows(const uint8_t* data, ssize_t stride, int count)
+{
+  if (_rowsPosition == -1)
+    return ERR_RT_INVALID_STATE;
+
+  if (count < 0 || count > _rowsSize.h - _rowsPosition)
+    return ERR_RT_INVALID_ARGUMENT;
+
+  if (count == 0)
+    return ERR_OK;
+
+  uint8_t* dstPixels = _rowsImage.getScanlineX(_rowsPosition);
+  ssize_t dstStride = _rowsImage.getStride();
+  size_t bpl = (size_t)_rowsSize.w * _rowsImage.getBytesPerPixel();
+
+  for (int i = 0; i < count; i++, dstPixels += dstStride, data += stride)
+    MemOps::copy(dstPixels, data, bpl);
+
+  _rowsPosition += count;
+  return ERR_OK;
+}
+
+err_t ImageEncoder::endImage()
+{
+  if (_rowsPosition == -1)
+    return ERR_RT_INVALID_STATE;
+
+  err_t err = ERR_IMAGE_TRUNCATED;
+
+  if (_rowsPosition == _rowsSize.h)
+  {
+    _rowsImage._modified();
+    err = writeImage(_rowsImage);
+  }
+
+  _rowsPosition = -1;
+  _rowsImage.reset();
+
+  return err;
+}
+
 // ============================================================================
 // [Fog::ImageEncoder - Reset]
 // ============================================================================
@@ -54,6 +127,9 @@ void ImageEncoder::reset()
 
   _headerDone = false;
   _writerDone = false;
+
+  _rowsPosition = -1;
+  _rowsImage.reset();
 }
 
 // ============================================================================
@@ -48,6 +48,28 @@ struct FOG_API ImageEncoder : public ImageCodec
   virtual void detachStream();
   virtual err_t writeImage(const Image& image) = 0;
 
+  // --------------------------------------------------------------------------
+  // [Rows]
+  // --------------------------------------------------------------------------
+
+  //! @brief Begin writing an image of @a size and @a format row by row.
+  //!
+  //! The rows are passed to @c writeRows() from top to bottom and the image
+  //! is completed by @c endImage(). Encoders which are able to stream (PNG
+  //! and JPEG) keep only a single row in memory, the other encoders collect
+  //! the rows into a temporary image, which is written by @c endImage().
+  virtual err_t beginImage(const SizeI& size, uint32_t format,
+    const ImagePalette& palette = ImagePalette::getEmptyInstance());
+
+  //! @brief Write @a count rows in the format passed to @c beginImage().
+  virtual err_t writeRows(const uint8_t* data, ssize_t stride, int count);
+
+  //! @brief Complete the image started by @c beginImage().
+  virtual err_t endImage();
+
+  //! @brief Get the index of the next row written by @c writeRows().
+  FOG_INLINE int getRowsPosition() const { return _rowsPosition; }
+
   // --------------------------------------------------------------------------
   // [Internal]
   // --------------------------------------------------------------------------
@@ -63,6 +85,16 @@ protected:
 protected:
   uint32_t _headerDone : 1;
   uint32_t _writerDone : 1;
+
+  //! @brief Index of the next row written by @c writeRows(), or -1 if
+  //! @c beginImage() wasn't called.
+  int _rowsPosition;
+  //! @brief Size of the image started by @c beginImage().
+  SizeI _rowsSize;
+  //! @brief Format of the image started by @c beginImage().
+  uint32_t _rowsFormat;
+  //! @brief Image collected by the generic @c writeRows() implementation.
+  Image _rowsImage;
 };
 
 //! @}
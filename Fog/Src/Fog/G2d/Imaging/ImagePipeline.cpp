@@ -0,0 +1,263 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Memory/MemBuffer.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/G2d/Imaging/Image.h>
+#include <Fog/G2d/Imaging/ImageConverter.h>
+#include <Fog/G2d/Imaging/ImageDecoder.h>
+#include <Fog/G2d/Imaging/ImageEncoder.h>
+#include <Fog/G2d/Imaging/ImageFormatDescription.h>
+#include <Fog/G2d/Imaging/ImagePipeline.h>
+#include <Fog/G2d/Imaging/ImageResize_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::ImagePipeline - Helpers]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Get the format used to resize the image of @a format.
+static uint32_t ImagePipeline_getResizeFormat(uint32_t format)
+{
+  switch (format)
+  {
+    case IMAGE_FORMAT_PRGB32:
+    case IMAGE_FORMAT_XRGB32:
+    case IMAGE_FORMAT_RGB24:
+    case IMAGE_FORMAT_A8:
+      return format;
+
+    case IMAGE_FORMAT_RGB48:
+      return IMAGE_FORMAT_XRGB32;
+
+    case IMAGE_FORMAT_A16:
+      return IMAGE_FORMAT_A8;
+
+    // I8 palette can contain alpha.
+    default:
+      return IMAGE_FORMAT_PRGB32;
+  }
+}
+
+// ============================================================================
+// [Fog::ImagePipeline - Construction / Destruction]
+// ============================================================================
+
+ImagePipeline::ImagePipeline() :
+  _size(0, 0),
+  _resizeFunc(IMAGE_RESIZE_BILINEAR),
+  _bandHeight(32)
+{
+}
+
+ImagePipeline::~ImagePipeline()
+{
+}
+
+// ============================================================================
+// [Fog::ImagePipeline - Accessors]
+// ============================================================================
+
+err_t ImagePipeline::setResizeFunc(uint32_t resizeFunc, const Hash<StringW, Var>* params)
+{
+  if (resizeFunc >= IMAGE_RESIZE_COUNT)
+    return ERR_RT_INVALID_ARGUMENT;
+
+  _resizeFunc = resizeFunc;
+
+  if (params != NULL)
+    _resizeParams = *params;
+  else
+    _resizeParams.clear();
+
+  return ERR_OK;
+}
+
+err_t ImagePipeline::setBandHeight(int bandHeight)
+{
+  if (bandHeight <= 0)
+    return ERR_RT_INVALID_ARGUMENT;
+
+  _bandHeight = bandHeight;
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::ImagePipeline - Reset]
+// ============================================================================
+
+void ImagePipeline::reset()
+{
+  _size.reset();
+  _resizeFunc = IMAGE_RESIZE_BILINEAR;
+  _resizeParams.reset();
+  _bandHeight = 32;
+}
+
+// ============================================================================
+// [Fog::ImagePipeline - Run]
+// ============================================================================
+
+err_t ImagePipeline::run(ImageDecoder* decoder, ImageEncoder* encoder)
+{
+  if (FOG_IS_NULL(decoder) || FOG_IS_NULL(encoder))
+    return ERR_RT_INVALID_ARGUMENT;
+
+  FOG_RETURN_ON_ERROR(decoder->readHeader());
+
+  // Decoders which aren't able to stream know the final size and format
+  // after the image was decoded.
+  FOG_RETURN_ON_ERROR(decoder->readRows(NULL, 0, 0));
+
+  SizeI sSize = decoder->getSize();
+  uint32_t sFormat = decoder->getFormat();
+
+  if (!sSize.isValid())
+    return ERR_IMAGE_INVALID_SIZE;
+
+  if (sFormat >= IMAGE_FORMAT_COUNT)
+    return ERR_IMAGE_INVALID_FORMAT;
+
+  SizeI dSize = _size.isValid() ? _size : sSize;
+  bool isResized = (dSize != sSize);
+
+  uint32_t dFormat = isResized ? ImagePipeline_getResizeFormat(sFormat) : sFormat;
+  uint32_t sBpp = ImageFormatDescription::getByFormat(sFormat).getBytesPerPixel();
+  uint32_t dBpp = ImageFormatDescription::getByFormat(dFormat).getBytesPerPixel();
+
+  int bandHeight = Math::min<int>(_bandHeight, sSize.h);
+
+  size_t sBpl = (size_t)sSize.w * sBpp;
+  size_t cBpl = (size_t)sSize.w * dBpp;
+  size_t dBpl = (size_t)dSize.w * dBpp;
+
+  ImageConverter converter;
+  ImageResizeStream resize;
+
+  MemBuffer sBuffer;
+  MemBuffer cBuffer;
+  MemBuffer dBuffer;
+
+  uint8_t* sBand;
+  uint8_t* cRow = NULL;
+  uint8_t* dBand = NULL;
+  int dCount = 0;
+
+  err_t err = ERR_OK;
+  bool isStreamCreated = false;
+  bool isImageStarted = false;
+
+  if (FOG_IS_NULL(sBand = reinterpret_cast<uint8_t*>(sBuffer.alloc(sBpl * (size_t)bandHeight))))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  if (isResized)
+  {
+    if (dFormat != sFormat)
+    {
+      err = converter.create(
+        ImageFormatDescription::getByFormat(dFormat),
+        ImageFormatDescription::getByFormat(sFormat),
+        0, NULL, &decoder->getPalette());
+      if (FOG_IS_ERROR(err)) goto _End;
+
+      if (FOG_IS_NULL(cRow = reinterpret_cast<uint8_t*>(cBuffer.alloc(cBpl))))
+      {
+        err = ERR_RT_OUT_OF_MEMORY;
+        goto _End;
+      }
+    }
+
+    if (FOG_IS_NULL(dBand = reinterpret_cast<uint8_t*>(dBuffer.alloc(dBpl * (size_t)bandHeight))))
+    {
+      err = ERR_RT_OUT_OF_MEMORY;
+      goto _End;
+    }
+
+    err = ImageResize_api.streamInit(&resize,
+      dSize.w, dSize.h,
+      sSize.w, sSize.h,
+      dFormat,
+      _resizeFunc, &_resizeParams);
+    if (FOG_IS_ERROR(err)) goto _End;
+
+    isStreamCreated = true;
+  }
+
+  err = encoder->beginImage(dSize, dFormat, decoder->getPalette());
+  if (FOG_IS_ERROR(err)) goto _End;
+
+  isImageStarted = true;
+
+  for (int y = 0; y < sSize.h; y += bandHeight)
+  {
+    int count = Math::min<int>(bandHeight, sSize.h - y);
+
+    err = decoder->readRows(sBand, (ssize_t)sBpl, count);
+    if (FOG_IS_ERROR(err)) goto _End;
+
+    if (!isResized)
+    {
+      err = encoder->writeRows(sBand, (ssize_t)sBpl, count);
+      if (FOG_IS_ERROR(err)) goto _End;
+      continue;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+      const uint8_t* sRow = sBand + (size_t)i * sBpl;
+
+      if (cRow != NULL)
+      {
+        converter.blitLine(cRow, sRow, sSize.w, PointI(0, y + i));
+        sRow = cRow;
+      }
+
+      err = ImageResize_api.streamPush(&resize, sRow);
+      if (FOG_IS_ERROR(err)) goto _End;
+
+      // Write the destination rows as soon as they are complete.
+      while (ImageResize_api.streamPull(&resize, dBand + (size_t)dCount * dBpl))
+      {
+        if (++dCount == bandHeight)
+        {
+          err = encoder->writeRows(dBand, (ssize_t)dBpl, dCount);
+          if (FOG_IS_ERROR(err)) goto _End;
+
+          dCount = 0;
+        }
+      }
+    }
+  }
+
+  if (dCount != 0)
+  {
+    err = encoder->writeRows(dBand, (ssize_t)dBpl, dCount);
+    if (FOG_IS_ERROR(err)) goto _End;
+  }
+
+_End:
+  if (isImageStarted)
+  {
+    err_t endErr = encoder->endImage();
+    if (err == ERR_OK) err = endErr;
+  }
+
+  if (isStreamCreated)
+    ImageResize_api.streamDestroy(&resize);
+
+  return err;
+}
+
+} // Fog namespace
@@ -0,0 +1,104 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_IMAGING_IMAGEPIPELINE_H
+#define _FOG_G2D_IMAGING_IMAGEPIPELINE_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Tools/Hash.h>
+#include <Fog/Core/Tools/String.h>
+#include <Fog/Core/Tools/Var.h>
+#include <Fog/G2d/Geometry/Size.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Imaging
+//! @{
+
+// ============================================================================
+// [Fog::ImagePipeline]
+// ============================================================================
+
+//! @brief Image pipeline, which transcodes (and optionally resizes) an image
+//! band by band.
+//!
+//! The pipeline reads rows from @c ImageDecoder::readRows(), converts them to
+//! the format supported by the resize, resizes them using a streaming
+//! resampler and passes the result to @c ImageEncoder::writeRows(). The
+//! full-size image is never created (as long as the decoder and the encoder
+//! are able to stream), the memory used is proportional to the image width,
+//! band height and the radius of the resize filter.
+struct FOG_API ImagePipeline
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  ImagePipeline();
+  ~ImagePipeline();
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the size of the output image (zero size means the size of
+  //! the input image).
+  FOG_INLINE const SizeI& getSize() const { return _size; }
+  //! @brief Set the size of the output image.
+  FOG_INLINE void setSize(const SizeI& size) { _size = size; }
+
+  //! @brief Get the resize function, see @c IMAGE_RESIZE.
+  FOG_INLINE uint32_t getResizeFunc() const { return _resizeFunc; }
+  //! @brief Get the resize function parameters.
+  FOG_INLINE const Hash<StringW, Var>& getResizeParams() const { return _resizeParams; }
+
+  //! @brief Set the resize function and its parameters, see @c Image::resize().
+  err_t setResizeFunc(uint32_t resizeFunc, const Hash<StringW, Var>* params = NULL);
+
+  //! @brief Get the count of rows read from the decoder at once.
+  FOG_INLINE int getBandHeight() const { return _bandHeight; }
+  //! @brief Set the count of rows read from the decoder at once.
+  err_t setBandHeight(int bandHeight);
+
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  void reset();
+
+  // --------------------------------------------------------------------------
+  // [Run]
+  // --------------------------------------------------------------------------
+
+  //! @brief Read the image by @a decoder and write it by @a encoder.
+  //!
+  //! Both, the decoder and the encoder must have attached stream.
+  err_t run(ImageDecoder* decoder, ImageEncoder* encoder);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Size of the output image.
+  SizeI _size;
+  //! @brief Resize function.
+  uint32_t _resizeFunc;
+  //! @brief Resize function parameters.
+  Hash<StringW, Var> _resizeParams;
+  //! @brief Count of rows read from the decoder at once.
+  int _bandHeight;
+
+private:
+  FOG_NO_COPY(ImagePipeline)
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_IMAGING_IMAGEPIPELINE_H
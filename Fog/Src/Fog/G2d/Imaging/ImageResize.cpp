@@ -29,7 +29,7 @@ namespace Fog {
 // [Fog::ImageResize - Api]
 // ============================================================================
 
-static ImageResizeApi ImageResize_api;
+ImageResizeApi ImageResize_api;
 
 // ============================================================================
 // [Fog::ImageResize - Function - Nearest]
@@ -439,7 +439,7 @@ struct FOG_NO_EXPORT ImageResize_BlackmanFunction : public MathFunctionF
 // [Fog::ImageResize - Context - Init / Destroy]
 // ============================================================================
 
-static err_t FOG_CDECL ImageResizeContext_init(ImageResizeContext* ctx,
+static void ImageResizeContext_setup(ImageResizeContext* ctx,
   uint8_t* dData, size_t dStride, int dw, int dh,
   uint8_t* sData, size_t sStride, int sw, int sh,
   uint32_t format,
@@ -482,6 +482,18 @@ static err_t FOG_CDECL ImageResizeContext_init(ImageResizeContext* ctx,
   ctx->isBound[1] = false;
 
   ctx->func = func;
+}
+
+static err_t FOG_CDECL ImageResizeContext_init(ImageResizeContext* ctx,
+  uint8_t* dData, size_t dStride, int dw, int dh,
+  uint8_t* sData, size_t sStride, int sw, int sh,
+  uint32_t format,
+  const MathFunctionF* func, float radius)
+{
+  ImageResizeContext_setup(ctx,
+    dData, dStride, dw, dh,
+    sData, sStride, sw, sh,
+    format, func, radius);
 
   {
     size_t hWeightSize = dw * ctx->kernelSize[0] * sizeof(int32_t);
@@ -1095,7 +1107,7 @@ static void FOG_CDECL ImageResizeContext_doHorizontal_A8(ImageResizeContext* ctx
 
 static void FOG_CDECL ImageResizeContext_doVertical_PRGB32(ImageResizeContext* ctx)
 {
-  uint kernelSize = ctx->kernelSize[0];
+  uint kernelSize = ctx->kernelSize[1];
 
   uint dw = ctx->dSize[0];
   uint dh = ctx->dSize[1];
@@ -1204,7 +1216,7 @@ static void FOG_CDECL ImageResizeContext_doVertical_PRGB32(ImageResizeContext* c
 
 static void FOG_CDECL ImageResizeContext_doVertical_XRGB32(ImageResizeContext* ctx)
 {
-  uint kernelSize = ctx->kernelSize[0];
+  uint kernelSize = ctx->kernelSize[1];
 
   uint dw = ctx->dSize[0];
   uint dh = ctx->dSize[1];
@@ -1310,7 +1322,7 @@ static void FOG_CDECL ImageResizeContext_doVertical_XRGB32(ImageResizeContext* c
 
 static void FOG_CDECL ImageResizeContext_doVertical_Bytes(ImageResizeContext* ctx, uint wScale)
 {
-  uint kernelSize = ctx->kernelSize[0];
+  uint kernelSize = ctx->kernelSize[1];
 
   uint dw = ctx->dSize[0] * wScale;
   uint dh = ctx->dSize[1];
@@ -1511,126 +1523,102 @@ static void FOG_CDECL ImageResizeContext_doVertical_A8(ImageResizeContext* ctx)
 // [Fog::ImageResize - Resize]
 // ============================================================================
 
-static err_t FOG_CDECL ImageResize_resize(Image* dst, const SizeI* dSize, const Image* src, const RectI* sFragment, uint32_t resizeFunc, const Hash<StringW, Var>* params)
+static err_t ImageResize_getRadius(const Hash<StringW, Var>* params, float& radius)
 {
-  switch (resizeFunc)
+  if (params)
   {
-    case IMAGE_RESIZE_NEAREST:
-    {
-      ImageResize_NearestFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 1.0f);
-    }
-
-    case IMAGE_RESIZE_BILINEAR:
-    {
-      ImageResize_BilinearFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 1.0f);
-    }
-
-    case IMAGE_RESIZE_BICUBIC:
-    {
-      ImageResize_BicubicFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 2.0f);
-    }
-
-    case IMAGE_RESIZE_BELL:
-    {
-      ImageResize_BellFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 1.5f);
-    }
-
-    case IMAGE_RESIZE_GAUSS:
-    {
-      ImageResize_GaussFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 2.0f);
-    }
+    const Var* r = params->getPtr(Ascii8("radius"));
+    if (r != NULL)
+      FOG_RETURN_ON_ERROR(r->getFloat(radius, 1.0f, 16.0f));
+  }
 
-    case IMAGE_RESIZE_HERMITE:
-    {
-      ImageResize_HermiteFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 1.0f);
-    }
+  return ERR_OK;
+}
 
-    case IMAGE_RESIZE_HANNING:
-    {
-      ImageResize_HanningFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 1.0f);
-    }
+static err_t ImageResize_createFunction(MathFunctionF** dst, float* radius, uint32_t resizeFunc, const Hash<StringW, Var>* params)
+{
+  MathFunctionF* f = NULL;
+  float r = 1.0f;
 
-    case IMAGE_RESIZE_CATROM:
-    {
-      ImageResize_CatromFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 2.0f);
-    }
+  switch (resizeFunc)
+  {
+    case IMAGE_RESIZE_NEAREST : f = fog_new ImageResize_NearestFunction (); r = 1.0f   ; break;
+    case IMAGE_RESIZE_BILINEAR: f = fog_new ImageResize_BilinearFunction(); r = 1.0f   ; break;
+    case IMAGE_RESIZE_BICUBIC : f = fog_new ImageResize_BicubicFunction (); r = 2.0f   ; break;
+    case IMAGE_RESIZE_BELL    : f = fog_new ImageResize_BellFunction    (); r = 1.5f   ; break;
+    case IMAGE_RESIZE_GAUSS   : f = fog_new ImageResize_GaussFunction   (); r = 2.0f   ; break;
+    case IMAGE_RESIZE_HERMITE : f = fog_new ImageResize_HermiteFunction (); r = 1.0f   ; break;
+    case IMAGE_RESIZE_HANNING : f = fog_new ImageResize_HanningFunction (); r = 1.0f   ; break;
+    case IMAGE_RESIZE_CATROM  : f = fog_new ImageResize_CatromFunction  (); r = 2.0f   ; break;
+    case IMAGE_RESIZE_BESSEL  : f = fog_new ImageResize_BesselFunction  (); r = 3.2383f; break;
 
     case IMAGE_RESIZE_MITCHELL:
     {
-      ImageResize_MitchellFunction f;
+      float b = float(MATH_1_DIV_3);
+      float c = float(MATH_1_DIV_3);
 
       if (params)
       {
-        const Var* b = params->getPtr(Ascii8("b"));
-        const Var* c = params->getPtr(Ascii8("c"));
-
-        if (b != NULL)
-          FOG_RETURN_ON_ERROR(b->getFloat(f.b));
+        const Var* bVar = params->getPtr(Ascii8("b"));
+        const Var* cVar = params->getPtr(Ascii8("c"));
 
-        if (c != NULL)
-          FOG_RETURN_ON_ERROR(b->getFloat(f.c));
+        if (bVar != NULL)
+          FOG_RETURN_ON_ERROR(bVar->getFloat(b));
 
-        if (b != NULL || c != NULL)
-          f.init();
+        if (cVar != NULL)
+          FOG_RETURN_ON_ERROR(cVar->getFloat(c));
       }
 
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 2.0f);
-    }
+      ImageResize_MitchellFunction* mf = fog_new ImageResize_MitchellFunction();
+      if (mf != NULL)
+      {
+        mf->b = b;
+        mf->c = c;
+        mf->init();
+      }
 
-    case IMAGE_RESIZE_BESSEL:
-    {
-      ImageResize_BesselFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 3.2383f);
+      f = mf;
+      r = 2.0f;
+      break;
     }
 
     case IMAGE_RESIZE_SINC:
     {
-      ImageResize_SincFunction f;
+      r = 2.0f;
+      FOG_RETURN_ON_ERROR(ImageResize_getRadius(params, r));
 
-      if (params)
-      {
-        const Var* r = params->getPtr(Ascii8("radius"));
-        if (r != NULL)
-          FOG_RETURN_ON_ERROR(r->getFloat(f.radius, 1.0f, 16.0f));
-      }
+      ImageResize_SincFunction* sf = fog_new ImageResize_SincFunction();
+      if (sf != NULL)
+        sf->radius = r;
 
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, f.radius);
+      f = sf;
+      break;
     }
 
     case IMAGE_RESIZE_LANCZOS:
     {
-      ImageResize_LanczosFunction f;
+      r = 2.0f;
+      FOG_RETURN_ON_ERROR(ImageResize_getRadius(params, r));
 
-      if (params)
-      {
-        const Var* r = params->getPtr(Ascii8("radius"));
-        if (r != NULL)
-          FOG_RETURN_ON_ERROR(r->getFloat(f.radius, 1.0f, 16.0f));
-      }
+      ImageResize_LanczosFunction* lf = fog_new ImageResize_LanczosFunction();
+      if (lf != NULL)
+        lf->radius = r;
 
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, f.radius);
+      f = lf;
+      break;
     }
 
     case IMAGE_RESIZE_BLACKMAN:
     {
-      ImageResize_BlackmanFunction f;
+      r = 2.0f;
+      FOG_RETURN_ON_ERROR(ImageResize_getRadius(params, r));
 
-      if (params)
-      {
-        const Var* r = params->getPtr(Ascii8("radius"));
-        if (r != NULL)
-          FOG_RETURN_ON_ERROR(r->getFloat(f.radius, 1.0f, 16.0f));
-      }
+      ImageResize_BlackmanFunction* bf = fog_new ImageResize_BlackmanFunction();
+      if (bf != NULL)
+        bf->radius = r;
 
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, f.radius);
+      f = bf;
+      break;
     }
 
     default:
@@ -1638,6 +1626,26 @@ static err_t FOG_CDECL ImageResize_resize(Image* dst, const SizeI* dSize, const
       return ERR_RT_INVALID_ARGUMENT;
     }
   }
+
+  if (FOG_IS_NULL(f))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  *dst = f;
+  *radius = r;
+  return ERR_OK;
+}
+
+static err_t FOG_CDECL ImageResize_resize(Image* dst, const SizeI* dSize, const Image* src, const RectI* sFragment, uint32_t resizeFunc, const Hash<StringW, Var>* params)
+{
+  MathFunctionF* f;
+  float radius;
+
+  FOG_RETURN_ON_ERROR(ImageResize_createFunction(&f, &radius, resizeFunc, params));
+
+  err_t err = fog_api.image_resizeCustom(dst, dSize, src, sFragment, f, radius);
+  fog_delete(f);
+
+  return err;
 }
 
 static err_t FOG_CDECL ImageResize_resizeCustom(Image* dst, const SizeI* dSize, const Image* src, const RectI* sFragment, const MathFunctionF* resizeFunc, float radius)
@@ -1683,6 +1691,189 @@ static err_t FOG_CDECL ImageResize_resizeCustom(Image* dst, const SizeI* dSize,
   return ERR_OK;
 }
 
+// ============================================================================
+// [Fog::ImageResize - Stream]
+// ============================================================================
+
+static err_t FOG_CDECL ImageResizeStream_init(ImageResizeStream* stream,
+  int dw, int dh,
+  int sw, int sh,
+  uint32_t format,
+  uint32_t resizeFunc, const Hash<StringW, Var>* params)
+{
+  MemOps::zero(stream, sizeof(ImageResizeStream));
+
+  if (format >= IMAGE_FORMAT_COUNT || ImageResize_api.doHorizontal[format] == NULL)
+    return ERR_IMAGE_INVALID_FORMAT;
+
+  if (dw <= 0 || dh <= 0 || sw <= 0 || sh <= 0)
+    return ERR_IMAGE_INVALID_SIZE;
+
+  float radius;
+  FOG_RETURN_ON_ERROR(ImageResize_createFunction(&stream->func, &radius, resizeFunc, params));
+
+  ImageResizeContext* ctx = &stream->ctx;
+  ImageResizeContext_setup(ctx, NULL, 0, dw, dh, NULL, 0, sw, sh, format, stream->func, radius);
+
+  stream->format = format;
+  stream->hWeightList = reinterpret_cast<int32_t          *>(MemMgr::alloc((size_t)dw * ctx->kernelSize[0] * sizeof(int32_t)));
+  stream->hRecordList = reinterpret_cast<ImageResizeRecord*>(MemMgr::alloc((size_t)dw * sizeof(ImageResizeRecord)));
+  stream->vWeightList = reinterpret_cast<int32_t          *>(MemMgr::alloc((size_t)dh * ctx->kernelSize[1] * sizeof(int32_t)));
+  stream->vRecordList = reinterpret_cast<ImageResizeRecord*>(MemMgr::alloc((size_t)dh * sizeof(ImageResizeRecord)));
+  stream->vMinList    = reinterpret_cast<int              *>(MemMgr::alloc((size_t)dh * sizeof(int)));
+
+  if (stream->hWeightList == NULL || stream->hRecordList == NULL ||
+      stream->vWeightList == NULL || stream->vRecordList == NULL ||
+      stream->vMinList    == NULL)
+  {
+    goto _OutOfMemory;
+  }
+
+  ctx->weightList = stream->hWeightList;
+  ctx->recordList = stream->hRecordList;
+  ImageResize_api.doWeights(ctx, 0);
+
+  ctx->weightList = stream->vWeightList;
+  ctx->recordList = stream->vRecordList;
+  ImageResize_api.doWeights(ctx, 1);
+
+  {
+    // Source rows which are not needed by the remaining destination rows can
+    // be dropped from the window. The window must be large enough to hold all
+    // rows between the lowest row needed and the last row of any destination
+    // row.
+    int minPos = INT_MAX;
+    int needed = 1;
+
+    for (int y = dh - 1; y >= 0; y--)
+    {
+      const ImageResizeRecord& record = stream->vRecordList[y];
+
+      if (record.count != 0)
+        minPos = Math::min<int>(minPos, (int)record.pos);
+      stream->vMinList[y] = minPos;
+
+      if (record.count != 0)
+        needed = Math::max<int>(needed, (int)(record.pos + record.count) - minPos);
+    }
+
+    // Twice the size needed, so the window is compacted only once per
+    // 'needed' rows.
+    stream->windowCapacity = needed * 2;
+    stream->window = reinterpret_cast<uint8_t*>(MemMgr::alloc((size_t)stream->windowCapacity * ctx->tStride));
+
+    if (stream->window == NULL)
+      goto _OutOfMemory;
+  }
+
+  ctx->tData = stream->window;
+  return ERR_OK;
+
+_OutOfMemory:
+  ImageResize_api.streamDestroy(stream);
+  return ERR_RT_OUT_OF_MEMORY;
+}
+
+static void FOG_CDECL ImageResizeStream_destroy(ImageResizeStream* stream)
+{
+  if (stream->window     ) MemMgr::free(stream->window     );
+  if (stream->vMinList   ) MemMgr::free(stream->vMinList   );
+  if (stream->vRecordList) MemMgr::free(stream->vRecordList);
+  if (stream->vWeightList) MemMgr::free(stream->vWeightList);
+  if (stream->hRecordList) MemMgr::free(stream->hRecordList);
+  if (stream->hWeightList) MemMgr::free(stream->hWeightList);
+
+  if (stream->func) fog_delete(stream->func);
+
+  MemOps::zero(stream, sizeof(ImageResizeStream));
+}
+
+static err_t FOG_CDECL ImageResizeStream_push(ImageResizeStream* stream, const uint8_t* sRow)
+{
+  ImageResizeContext* ctx = &stream->ctx;
+
+  int sy = stream->sy;
+  int sh = ctx->sSize[1];
+
+  if (sy >= sh)
+    return ERR_RT_INVALID_STATE;
+
+  // Rows after the last row needed by the destination are ignored.
+  if (stream->dy >= ctx->dSize[1])
+  {
+    stream->sy++;
+    return ERR_OK;
+  }
+
+  ssize_t tStride = ctx->tStride;
+  int slot = sy - stream->windowY;
+
+  if (slot >= stream->windowCapacity)
+  {
+    // Drop the rows which are not needed anymore and move the remaining rows
+    // to the beginning of the window.
+    int first = Math::min<int>(stream->vMinList[stream->dy], sy);
+    int keep = sy - first;
+
+    // All completed rows have to be pulled before the next row is pushed.
+    if (keep >= stream->windowCapacity)
+      return ERR_RT_INVALID_STATE;
+
+    if (keep > 0)
+      memmove(stream->window, stream->window + (ssize_t)(first - stream->windowY) * tStride, (size_t)keep * tStride);
+
+    stream->windowY = first;
+    slot = keep;
+  }
+
+  ctx->sData = const_cast<uint8_t*>(sRow);
+  ctx->sSize[1] = 1;
+  ctx->tData = stream->window + (ssize_t)slot * tStride;
+  ctx->weightList = stream->hWeightList;
+  ctx->recordList = stream->hRecordList;
+
+  ImageResize_api.doHorizontal[stream->format](ctx);
+
+  ctx->sSize[1] = sh;
+  stream->sy++;
+
+  return ERR_OK;
+}
+
+static bool FOG_CDECL ImageResizeStream_pull(ImageResizeStream* stream, uint8_t* dRow)
+{
+  ImageResizeContext* ctx = &stream->ctx;
+
+  int dy = stream->dy;
+  int dh = ctx->dSize[1];
+
+  if (dy >= dh)
+    return false;
+
+  // Not all source rows needed by the destination row were pushed yet.
+  const ImageResizeRecord& vRecord = stream->vRecordList[dy];
+  if (vRecord.count != 0 && stream->sy < (int)(vRecord.pos + vRecord.count))
+    return false;
+
+  // The record is relative to the window.
+  ImageResizeRecord record;
+  record.pos = vRecord.count != 0 ? vRecord.pos - (uint32_t)stream->windowY : 0;
+  record.count = vRecord.count;
+
+  ctx->dData = dRow;
+  ctx->dSize[1] = 1;
+  ctx->tData = stream->window;
+  ctx->weightList = stream->vWeightList + (size_t)dy * ctx->kernelSize[1];
+  ctx->recordList = &record;
+
+  ImageResize_api.doVertical[stream->format](ctx);
+
+  ctx->dSize[1] = dh;
+  stream->dy++;
+
+  return true;
+}
+
 // ============================================================================
 // [Init / Fini]
 // ============================================================================
@@ -1702,6 +1893,11 @@ FOG_NO_EXPORT void ImageResize_init(void)
   ImageResize_api.destroy = ImageResizeContext_destroy;
   ImageResize_api.doWeights = ImageResizeContext_doWeights;
 
+  ImageResize_api.streamInit = ImageResizeStream_init;
+  ImageResize_api.streamDestroy = ImageResizeStream_destroy;
+  ImageResize_api.streamPush = ImageResizeStream_push;
+  ImageResize_api.streamPull = ImageResizeStream_pull;
+
   ImageResize_api.doHorizontal[IMAGE_FORMAT_PRGB32] = ImageResizeContext_doHorizontal_PRGB32;
   ImageResize_api.doHorizontal[IMAGE_FORMAT_XRGB32] = ImageResizeContext_doHorizontal_XRGB32;
   ImageResize_api.doHorizontal[IMAGE_FORMAT_RGB24 ] = ImageResizeContext_doHorizontal_RGB24;
@@ -775,7 +775,7 @@ static void FOG_CDECL ImageResizeContext_doHorizontal_XRGB32_SSE2(ImageResizeCon
 
 static void FOG_CDECL ImageResizeContext_doVertical_PRGB32_SSE2(ImageResizeContext* ctx)
 {
-  uint kernelSize = ctx->kernelSize[0];
+  uint kernelSize = ctx->kernelSize[1];
 
   uint dw = ctx->dSize[0];
   uint dh = ctx->dSize[1];
@@ -1061,7 +1061,7 @@ _UnboundLarge:
 
 static void FOG_CDECL ImageResizeContext_doVertical_XRGB32_SSE2(ImageResizeContext* ctx)
 {
-  uint kernelSize = ctx->kernelSize[0];
+  uint kernelSize = ctx->kernelSize[1];
 
   uint dw = ctx->dSize[0];
   uint dh = ctx->dSize[1];
@@ -1345,7 +1345,7 @@ _UnboundLarge:
 
 static void FOG_CDECL ImageResizeContext_doVertical_Bytes_SSE2(ImageResizeContext* ctx, uint wScale)
 {
-  uint kernelSize = ctx->kernelSize[0];
+  uint kernelSize = ctx->kernelSize[1];
 
   uint dw = ctx->dSize[0] * wScale;
   uint dh = ctx->dSize[1];
@@ -8,6 +8,10 @@
 #define _FOG_G2D_IMAGING_IMAGERESIZE_P_H
 
 // [Dependencies]
+#include <Fog/Core/Math/Function.h>
+#include <Fog/Core/Tools/Hash.h>
+#include <Fog/Core/Tools/String.h>
+#include <Fog/Core/Tools/Var.h>
 #include <Fog/G2d/Geometry/Size.h>
 #include <Fog/G2d/Imaging/Image.h>
 
@@ -22,6 +26,7 @@ namespace Fog {
 
 struct ImageResizeApi;
 struct ImageResizeContext;
+struct ImageResizeStream;
 
 // ============================================================================
 // [Fog::ImageResizeApi]
@@ -40,14 +45,30 @@ struct FOG_NO_EXPORT ImageResizeApi
   typedef void (FOG_CDECL* DoHorizontalFunc)(ImageResizeContext* ctx);
   typedef void (FOG_CDECL* DoVerticalFunc)(ImageResizeContext* ctx);
 
+  typedef err_t (FOG_CDECL* StreamInitFunc)(ImageResizeStream* stream,
+    int dw, int dh,
+    int sw, int sh,
+    uint32_t format,
+    uint32_t resizeFunc, const Hash<StringW, Var>* params);
+  typedef void (FOG_CDECL* StreamDestroyFunc)(ImageResizeStream* stream);
+  typedef err_t (FOG_CDECL* StreamPushFunc)(ImageResizeStream* stream, const uint8_t* sRow);
+  typedef bool (FOG_CDECL* StreamPullFunc)(ImageResizeStream* stream, uint8_t* dRow);
+
   InitFunc init;
   DestroyFunc destroy;
 
   DoWeightsFunc doWeights;
   DoHorizontalFunc doHorizontal[IMAGE_FORMAT_COUNT];
   DoVerticalFunc doVertical[IMAGE_FORMAT_COUNT];
+
+  StreamInitFunc streamInit;
+  StreamDestroyFunc streamDestroy;
+  StreamPushFunc streamPush;
+  StreamPullFunc streamPull;
 };
 
+extern FOG_NO_EXPORT ImageResizeApi ImageResize_api;
+
 // ============================================================================
 // [Fog::ImageResizeOffset]
 // ============================================================================
@@ -88,6 +109,55 @@ struct FOG_NO_EXPORT ImageResizeContext
   const MathFunctionF* func;
 };
 
+// ============================================================================
+// [Fog::ImageResizeStream]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Resize context, which resizes the image row by row.
+//!
+//! Source rows are resized horizontally by @c ImageResizeApi::streamPush()
+//! and stored into a window, which contains only the rows needed by the
+//! vertical filter. Destination rows are produced by
+//! @c ImageResizeApi::streamPull() as soon as all rows they depend on were
+//! pushed, so the memory used is proportional to the destination width and
+//! the filter radius, not to the image height.
+struct FOG_NO_EXPORT ImageResizeStream
+{
+  //! @brief Resize context (tData points to the window).
+  ImageResizeContext ctx;
+
+  //! @brief Resize function (owned).
+  MathFunctionF* func;
+  //! @brief Image format.
+  uint32_t format;
+
+  //! @brief Horizontal weights and records.
+  int32_t* hWeightList;
+  ImageResizeRecord* hRecordList;
+
+  //! @brief Vertical weights and records.
+  int32_t* vWeightList;
+  ImageResizeRecord* vRecordList;
+
+  //! @brief The lowest source row needed by each destination row and all
+  //! the rows after it.
+  int* vMinList;
+
+  //! @brief Window of horizontally resized source rows.
+  uint8_t* window;
+  //! @brief Source row stored at the first row of the window.
+  int windowY;
+  //! @brief Capacity of the window (in rows).
+  int windowCapacity;
+
+  //! @brief Count of source rows pushed.
+  int sy;
+  //! @brief Count of destination rows pulled.
+  int dy;
+};
+
 //! @}
 
 } // Fog namespace
@@ -57,6 +57,8 @@ struct RasterPatternFetcher;
 struct RasterFilter;
 struct RasterFilterBlur;
 struct RasterFilterImage;
+struct RasterTurbulenceLattice;
+struct RasterTurbulenceTile;
 
 // Raster paint-engine.
 struct RasterPaintContext;
@@ -236,6 +238,69 @@ typedef err_t (FOG_FASTCALL *RasterFilterDoRectFunc)(
 typedef void (FOG_FASTCALL *RasterFilterDoBlurFunc)(
   RasterFilterBlur* ctx);
 
+// ============================================================================
+// [Fog::Raster - TypeDefs - Filter - Convolve]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Horizontal pass of the separable convolution, 8-bit components of
+//! @a src are convolved to 16-bit fixed-point components of @a dst.
+typedef void (FOG_FASTCALL *RasterFilterConvolveHFunc)(
+  int16_t* dst, const uint8_t* src, int w,
+  const int16_t* weights, int count, int shift);
+
+//! @internal
+//!
+//! @brief Vertical pass of the separable convolution, @a count 16-bit rows
+//! are convolved to the 8-bit components of @a dst.
+typedef void (FOG_FASTCALL *RasterFilterConvolveVFunc)(
+  uint8_t* dst, const int16_t* const* src, int w,
+  const int16_t* weights, int count, int bias, int shift);
+
+//! @internal
+//!
+//! @brief General matrix convolution, @a count 8-bit rows are convolved by
+//! @a count rows of @a weightStride weights to the 8-bit components of
+//! @a dst.
+typedef void (FOG_FASTCALL *RasterFilterConvolveMFunc)(
+  uint8_t* dst, const uint8_t* const* src, int w,
+  const int16_t* weights, int weightStride, int count, int bias, int shift);
+
+// ============================================================================
+// [Fog::Raster - TypeDefs - Filter - Morphology]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Horizontal pass of the morphology, computes minimum or maximum of
+//! @a size pixels of @a src for each pixel of @a dst (@a src contains
+//! @a w + @a size - 1 pixels). The @a g and @a h buffers are used to store
+//! the van Herk/Gil-Werman prefix and suffix runs, each must hold the same
+//! count of pixels as @a src.
+typedef void (FOG_FASTCALL *RasterFilterMorphologyHFunc)(
+  uint8_t* dst, const uint8_t* src, int w, int size,
+  uint8_t* g, uint8_t* h);
+
+//! @internal
+//!
+//! @brief Minimum or maximum of @a size bytes of @a a and @a b, stored to
+//! @a dst (which can be the same buffer as @a a or @a b).
+typedef void (FOG_FASTCALL *RasterFilterMorphologyVFunc)(
+  uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t size);
+
+// ============================================================================
+// [Fog::Raster - TypeDefs - Filter - Turbulence]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Generate @a w premultiplied ARGB32 pixels of the turbulence at
+//! the position [@a x, @a y] (both must be positive).
+typedef void (FOG_FASTCALL *RasterFilterTurbulenceFunc)(
+  uint8_t* dst, const RasterFilter* ctx, const RasterTurbulenceTile* tile,
+  int x, int y, int w);
+
 // ============================================================================
 // [Fog::RasterConvertFuncs]
 // ============================================================================
@@ -327,6 +392,11 @@ struct FOG_NO_EXPORT RasterTextureFuncs
     RasterPatternFetchFunc fetch_affine_nearest[IMAGE_FORMAT_COUNT][TEXTURE_TILE_COUNT];
     RasterPatternFetchFunc fetch_affine_bilinear[IMAGE_FORMAT_COUNT][TEXTURE_TILE_COUNT];
 
+    RasterPatternFetchFunc fetch_ortho_copy[IMAGE_FORMAT_COUNT][TEXTURE_TILE_COUNT];
+    RasterPatternFetchFunc fetch_upscale_nearest[IMAGE_FORMAT_COUNT][TEXTURE_TILE_COUNT];
+    RasterPatternFetchFunc fetch_upscale_bilinear[IMAGE_FORMAT_COUNT][TEXTURE_TILE_COUNT];
+    RasterPatternFetchFunc fetch_downscale_box[IMAGE_FORMAT_COUNT][TEXTURE_TILE_COUNT];
+
     RasterPatternFetchFunc fetch_proj_nearest[IMAGE_FORMAT_COUNT][TEXTURE_TILE_COUNT];
     RasterPatternFetchFunc fetch_proj_bilinear[IMAGE_FORMAT_COUNT][TEXTURE_TILE_COUNT];
   };
@@ -391,6 +461,28 @@ struct FOG_NO_EXPORT RasterFilterFuncs
 {
   RasterFilterCreateFunc create[FE_TYPE_COUNT];
 
+  //! @brief Copy line, used by color filters which result in identity.
+  RasterFilterDoLineFunc copy[IMAGE_FORMAT_COUNT];
+
+  struct _ColorLut
+  {
+    //! @brief Lookup of all components.
+    RasterFilterDoLineFunc argb[IMAGE_FORMAT_COUNT];
+    //! @brief Lookup of alpha only (RGB tables are identity).
+    RasterFilterDoLineFunc alpha[IMAGE_FORMAT_COUNT];
+  } colorLut;
+
+  struct _ColorMatrix
+  {
+    //! @brief Generic matrix.
+    RasterFilterDoLineFunc argb[IMAGE_FORMAT_COUNT];
+    //! @brief Greyscale matrix (R, G and B results are equal).
+    RasterFilterDoLineFunc grey[IMAGE_FORMAT_COUNT];
+    //! @brief Alpha-only matrix (RGB part is identity and alpha depends only
+    //! on alpha), uses the alpha lookup table.
+    RasterFilterDoLineFunc alpha[IMAGE_FORMAT_COUNT];
+  } colorMatrix;
+
   struct _Blur
   {
     struct _Box
@@ -411,6 +503,25 @@ struct FOG_NO_EXPORT RasterFilterFuncs
       RasterFilterDoBlurFunc v[IMAGE_FORMAT_COUNT];
     } exponential;
   } blur;
+
+  //! @brief Convolution kernels, the 32-bit formats (including RGB24, which
+  //! is converted to XRGB32 before the convolution) share the same kernels.
+  struct _Convolve
+  {
+    RasterFilterConvolveHFunc h[IMAGE_FORMAT_COUNT];
+    RasterFilterConvolveVFunc v[IMAGE_FORMAT_COUNT];
+    RasterFilterConvolveMFunc matrix[IMAGE_FORMAT_COUNT];
+  } convolve;
+
+  //! @brief Morphology kernels, indexed by @c FE_MORPHOLOGY_TYPE.
+  struct _Morphology
+  {
+    RasterFilterMorphologyHFunc h[FE_MORPHOLOGY_TYPE_COUNT][IMAGE_FORMAT_COUNT];
+    RasterFilterMorphologyVFunc v[FE_MORPHOLOGY_TYPE_COUNT];
+  } morphology;
+
+  //! @brief Turbulence generators, indexed by @c FE_TURBULENCE_TYPE.
+  RasterFilterTurbulenceFunc turbulence[FE_TURBULENCE_TYPE_COUNT];
 };
 
 // ============================================================================
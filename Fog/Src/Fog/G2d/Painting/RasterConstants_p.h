@@ -36,6 +36,18 @@ enum RASTER_CORE
   //! @brief Internal buffer-size used for multi-pass image conversion.
   RASTER_CONVERT_BUFFER_SIZE = 2048,
 
+  // --------------------------------------------------------------------------
+  // [Group Layers]
+  // --------------------------------------------------------------------------
+
+  //! @brief Count of layer buffers cached by one paint engine.
+  RASTER_LAYER_POOL_SIZE = 8,
+  //! @brief Maximum size (in bytes) of all layer buffers cached by one paint
+  //! engine.
+  RASTER_LAYER_POOL_LIMIT = 32 * 1024 * 1024,
+  //! @brief Size of cached layer buffers is aligned to this value.
+  RASTER_LAYER_GRANULARITY = 64,
+
   // --------------------------------------------------------------------------
   // [Multithreaded Paint Engine]
   // --------------------------------------------------------------------------
@@ -558,7 +570,11 @@ enum RASTER_GROUP
   RASTER_GROUP_HAS_GROUP = 0x08000000,
 
   //! @brief Filter used within the group.
-  RASTER_GROUP_HAS_FILTER = 0x10000000
+  RASTER_GROUP_HAS_FILTER = 0x10000000,
+
+  //! @brief Compositing operator other than @c COMPOSITE_SRC_OVER used within
+  //! the group.
+  RASTER_GROUP_HAS_COMPOSITING = 0x20000000
 };
 
 // ============================================================================
@@ -809,6 +825,27 @@ enum
   RASTER_SPAN_C_THRESHOLD = 4
 };
 
+// ============================================================================
+// [Fog::RASTER_TURBULENCE]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Constants of the SVG turbulence (Perlin noise) reference algorithm.
+enum RASTER_TURBULENCE
+{
+  //! @brief Count of lattice points.
+  RASTER_TURBULENCE_BSIZE = 0x100,
+  //! @brief Lattice mask.
+  RASTER_TURBULENCE_BMASK = 0xFF,
+  //! @brief Offset added to the noise position (keeps the position positive).
+  RASTER_TURBULENCE_PERLIN_N = 0x1000,
+
+  //! @brief Size of the lattice tables (duplicated so that the lattice
+  //! selector can be indexed by the sum of two lattice indexes).
+  RASTER_TURBULENCE_TABLE_SIZE = RASTER_TURBULENCE_BSIZE * 2 + 2
+};
+
 // ============================================================================
 // [RASTER_COMBINE_STATIC]
 // ============================================================================
@@ -0,0 +1,269 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Tools/HashUtil.h>
+#include <Fog/G2d/Imaging/ImageFormatDescription.h>
+#include <Fog/G2d/Painting/RasterFilterCache_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::RasterFilterCache - Entry]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Cached image, the key and the pixels follow the entry.
+struct FOG_NO_EXPORT RasterFilterCacheEntry
+{
+  FOG_INLINE uint8_t* getKey() { return reinterpret_cast<uint8_t*>(this + 1); }
+  FOG_INLINE uint8_t* getData() { return getKey() + keySize; }
+
+  RasterFilterCacheEntry* prev;
+  RasterFilterCacheEntry* next;
+
+  uint32_t hashCode;
+  uint32_t format;
+
+  int w;
+  int h;
+
+  size_t keySize;
+  size_t dataSize;
+};
+
+// ============================================================================
+// [Fog::RasterFilterCache - Global]
+// ============================================================================
+
+static Static<Lock> RasterFilterCache_lock;
+
+//! @brief The most recently used entry.
+static RasterFilterCacheEntry* RasterFilterCache_first;
+//! @brief The least recently used entry.
+static RasterFilterCacheEntry* RasterFilterCache_last;
+//! @brief Size of all cached images.
+static size_t RasterFilterCache_size;
+
+// ============================================================================
+// [Fog::RasterFilterCache - Helpers]
+// ============================================================================
+
+static FOG_INLINE void RasterFilterCache_unlink(RasterFilterCacheEntry* entry)
+{
+  if (entry->prev)
+    entry->prev->next = entry->next;
+  else
+    RasterFilterCache_first = entry->next;
+
+  if (entry->next)
+    entry->next->prev = entry->prev;
+  else
+    RasterFilterCache_last = entry->prev;
+
+  RasterFilterCache_size -= entry->dataSize;
+}
+
+static FOG_INLINE void RasterFilterCache_prepend(RasterFilterCacheEntry* entry)
+{
+  entry->prev = NULL;
+  entry->next = RasterFilterCache_first;
+
+  if (RasterFilterCache_first)
+    RasterFilterCache_first->prev = entry;
+  else
+    RasterFilterCache_last = entry;
+
+  RasterFilterCache_first = entry;
+  RasterFilterCache_size += entry->dataSize;
+}
+
+static RasterFilterCacheEntry* RasterFilterCache_find(
+  const void* key, size_t keySize, uint32_t hashCode)
+{
+  RasterFilterCacheEntry* entry = RasterFilterCache_first;
+
+  while (entry)
+  {
+    if (entry->hashCode == hashCode &&
+        entry->keySize == keySize &&
+        MemOps::eq(entry->getKey(), key, keySize))
+    {
+      return entry;
+    }
+
+    entry = entry->next;
+  }
+
+  return NULL;
+}
+
+// Must be called outside of the synchronized section.
+static void RasterFilterCache_freeList(RasterFilterCacheEntry* entry)
+{
+  while (entry)
+  {
+    RasterFilterCacheEntry* next = entry->next;
+    MemMgr::free(entry);
+    entry = next;
+  }
+}
+
+// ============================================================================
+// [Fog::RasterFilterCache - Get / Put]
+// ============================================================================
+
+bool RasterFilterCache::get(const void* key, size_t keySize,
+  uint8_t* dst, ssize_t dstStride, int w, int h, uint32_t format)
+{
+  uint32_t hashCode = HashUtil::hashBinary(key, keySize);
+  AutoLock locked(RasterFilterCache_lock);
+
+  RasterFilterCacheEntry* entry = RasterFilterCache_find(key, keySize, hashCode);
+  if (entry == NULL || entry->w != w || entry->h != h || entry->format != format)
+    return false;
+
+  // Move the entry to the front, it's the most recently used one.
+  if (entry != RasterFilterCache_first)
+  {
+    RasterFilterCache_unlink(entry);
+    RasterFilterCache_prepend(entry);
+  }
+
+  size_t bpl = entry->dataSize / (uint)h;
+  const uint8_t* src = entry->getData();
+
+  for (int y = 0; y < h; y++, dst += dstStride, src += bpl)
+    MemOps::copy(dst, src, bpl);
+
+  return true;
+}
+
+void RasterFilterCache::put(const void* key, size_t keySize,
+  const uint8_t* src, ssize_t srcStride, int w, int h, uint32_t format)
+{
+  if (w <= 0 || h <= 0)
+    return;
+
+  size_t bpl = (size_t)(uint)w * ImageFormatDescription::getByFormat(format).getBytesPerPixel();
+  size_t dataSize = bpl * (uint)h;
+
+  if (dataSize > RASTER_FILTER_CACHE_ENTRY_LIMIT)
+    return;
+
+  // Allocate and fill the entry outside of the synchronized section, the
+  // memory manager can call the cleanup handler if it runs out of memory.
+  RasterFilterCacheEntry* entry = reinterpret_cast<RasterFilterCacheEntry*>(
+    MemMgr::alloc(sizeof(RasterFilterCacheEntry) + keySize + dataSize));
+
+  if (FOG_IS_NULL(entry))
+    return;
+
+  entry->hashCode = HashUtil::hashBinary(key, keySize);
+  entry->format = format;
+  entry->w = w;
+  entry->h = h;
+  entry->keySize = keySize;
+  entry->dataSize = dataSize;
+
+  MemOps::copy(entry->getKey(), key, keySize);
+
+  uint8_t* dst = entry->getData();
+  for (int y = 0; y < h; y++, dst += bpl, src += srcStride)
+    MemOps::copy(dst, src, bpl);
+
+  RasterFilterCacheEntry* unused = NULL;
+
+  { AutoLock locked(RasterFilterCache_lock);
+
+    // Replace the entry if it already exists (another thread could be
+    // faster).
+    RasterFilterCacheEntry* old = RasterFilterCache_find(key, keySize, entry->hashCode);
+    if (old != NULL)
+    {
+      RasterFilterCache_unlink(old);
+      old->next = unused;
+      unused = old;
+    }
+
+    // Release the least recently used entries to fit into the limit.
+    while (RasterFilterCache_last != NULL &&
+           RasterFilterCache_size + dataSize > RASTER_FILTER_CACHE_LIMIT)
+    {
+      old = RasterFilterCache_last;
+      RasterFilterCache_unlink(old);
+      old->next = unused;
+      unused = old;
+    }
+
+    RasterFilterCache_prepend(entry);
+  }
+
+  RasterFilterCache_freeList(unused);
+}
+
+// ============================================================================
+// [Fog::RasterFilterCache - Reset]
+// ============================================================================
+
+void RasterFilterCache::reset()
+{
+  RasterFilterCacheEntry* unused;
+
+  { AutoLock locked(RasterFilterCache_lock);
+
+    unused = RasterFilterCache_first;
+
+    RasterFilterCache_first = NULL;
+    RasterFilterCache_last = NULL;
+    RasterFilterCache_size = 0;
+  }
+
+  RasterFilterCache_freeList(unused);
+}
+
+// ============================================================================
+// [Fog::RasterFilterCache - Cleanup]
+// ============================================================================
+
+static void FOG_CDECL RasterFilterCache_cleanupFunc(void* closure, uint32_t reason)
+{
+  RasterFilterCache::reset();
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void RasterFilterCache_init(void)
+{
+  RasterFilterCache_lock.init();
+
+  RasterFilterCache_first = NULL;
+  RasterFilterCache_last = NULL;
+  RasterFilterCache_size = 0;
+
+  MemMgr::registerCleanupFunc(RasterFilterCache_cleanupFunc, NULL);
+}
+
+FOG_NO_EXPORT void RasterFilterCache_fini(void)
+{
+  MemMgr::unregisterCleanupFunc(RasterFilterCache_cleanupFunc, NULL);
+
+  RasterFilterCache::reset();
+  RasterFilterCache_lock.destroy();
+}
+
+} // Fog namespace
@@ -0,0 +1,67 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTERFILTERCACHE_P_H
+#define _FOG_G2D_PAINTING_RASTERFILTERCACHE_P_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Fog::RASTER_FILTER_CACHE]
+// ============================================================================
+
+enum RASTER_FILTER_CACHE
+{
+  //! @brief Maximum size of all cached images (in bytes).
+  RASTER_FILTER_CACHE_LIMIT = 4 * 1024 * 1024,
+
+  //! @brief Maximum size of one cached image (in bytes), larger images are
+  //! not cached.
+  RASTER_FILTER_CACHE_ENTRY_LIMIT = 1024 * 1024
+};
+
+// ============================================================================
+// [Fog::RasterFilterCache]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Cache of filter results which don't depend on the source pixels.
+//!
+//! Generators like the turbulence produce the same pixels for the same
+//! parameters, which is typical for backgrounds repainted in each frame. The
+//! results are stored in a small LRU cache identified by a binary key, which
+//! must contain all parameters of the filter, the filtered rectangle and the
+//! pixel format. The cache is thread-safe and it's purged when the memory
+//! manager runs out of memory.
+struct FOG_NO_EXPORT RasterFilterCache
+{
+  //! @brief Copy the cached image identified by @a key to @a dst.
+  //!
+  //! Returns @c true on success, @c false if the image is not in the cache.
+  static bool get(const void* key, size_t keySize,
+    uint8_t* dst, ssize_t dstStride, int w, int h, uint32_t format);
+
+  //! @brief Store the image @a src to the cache under @a key.
+  static void put(const void* key, size_t keySize,
+    const uint8_t* src, ssize_t srcStride, int w, int h, uint32_t format);
+
+  //! @brief Remove all images from the cache.
+  static void reset();
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTERFILTERCACHE_P_H
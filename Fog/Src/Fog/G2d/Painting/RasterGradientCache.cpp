@@ -0,0 +1,322 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Tools/HashUtil.h>
+#include <Fog/G2d/Painting/RasterApi_p.h>
+#include <Fog/G2d/Painting/RasterGradientCache_p.h>
+#include <Fog/G2d/Source/ColorStop.h>
+#include <Fog/G2d/Source/ColorStopCache.h>
+#include <Fog/G2d/Source/ColorStopList.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::RasterGradientCache - Entry]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Cached color table, the color-stops (key) follow the entry.
+struct FOG_NO_EXPORT RasterGradientCacheEntry
+{
+  FOG_INLINE ColorStop* getStops() { return reinterpret_cast<ColorStop*>(this + 1); }
+
+  //! @brief Previous entry in the LRU list (more recently used).
+  RasterGradientCacheEntry* prev;
+  //! @brief Next entry in the LRU list (less recently used).
+  RasterGradientCacheEntry* next;
+  //! @brief Next entry in the hash bucket.
+  RasterGradientCacheEntry* hashNext;
+
+  //! @brief The color table (the cache holds one reference).
+  ColorStopCache* cache;
+
+  uint32_t hashCode;
+  uint32_t format;
+  uint32_t length;
+  uint32_t stopCount;
+
+  //! @brief Size of the entry and the color table (in bytes).
+  size_t memSize;
+};
+
+// ============================================================================
+// [Fog::RasterGradientCache - Global]
+// ============================================================================
+
+static Static<Lock> RasterGradientCache_lock;
+
+static RasterGradientCacheEntry* RasterGradientCache_buckets[RASTER_GRADIENT_CACHE_BUCKETS];
+
+//! @brief The most recently used entry.
+static RasterGradientCacheEntry* RasterGradientCache_first;
+//! @brief The least recently used entry.
+static RasterGradientCacheEntry* RasterGradientCache_last;
+//! @brief Size of all cached entries.
+static size_t RasterGradientCache_size;
+
+// ============================================================================
+// [Fog::RasterGradientCache - Helpers]
+// ============================================================================
+
+static FOG_INLINE uint32_t RasterGradientCache_hash(
+  const ColorStop* stops, size_t stopCount, uint32_t format, uint32_t length)
+{
+  uint32_t hashCode = HashUtil::hashBinary(stops, stopCount * sizeof(ColorStop));
+  return hashCode ^ (format << 24) ^ (length * 33);
+}
+
+static FOG_INLINE void RasterGradientCache_unlink(RasterGradientCacheEntry* entry)
+{
+  if (entry->prev)
+    entry->prev->next = entry->next;
+  else
+    RasterGradientCache_first = entry->next;
+
+  if (entry->next)
+    entry->next->prev = entry->prev;
+  else
+    RasterGradientCache_last = entry->prev;
+
+  RasterGradientCache_size -= entry->memSize;
+}
+
+static FOG_INLINE void RasterGradientCache_prepend(RasterGradientCacheEntry* entry)
+{
+  entry->prev = NULL;
+  entry->next = RasterGradientCache_first;
+
+  if (RasterGradientCache_first)
+    RasterGradientCache_first->prev = entry;
+  else
+    RasterGradientCache_last = entry;
+
+  RasterGradientCache_first = entry;
+  RasterGradientCache_size += entry->memSize;
+}
+
+static void RasterGradientCache_removeFromBucket(RasterGradientCacheEntry* entry)
+{
+  RasterGradientCacheEntry** pPrev =
+    &RasterGradientCache_buckets[entry->hashCode % RASTER_GRADIENT_CACHE_BUCKETS];
+
+  while (*pPrev != entry)
+    pPrev = &(*pPrev)->hashNext;
+
+  *pPrev = entry->hashNext;
+}
+
+static RasterGradientCacheEntry* RasterGradientCache_find(
+  const ColorStop* stops, size_t stopCount, uint32_t format, uint32_t length, uint32_t hashCode)
+{
+  RasterGradientCacheEntry* entry =
+    RasterGradientCache_buckets[hashCode % RASTER_GRADIENT_CACHE_BUCKETS];
+
+  while (entry)
+  {
+    if (entry->hashCode == hashCode &&
+        entry->format == format &&
+        entry->length == length &&
+        entry->stopCount == stopCount &&
+        MemOps::eq(entry->getStops(), stops, stopCount * sizeof(ColorStop)))
+    {
+      return entry;
+    }
+
+    entry = entry->hashNext;
+  }
+
+  return NULL;
+}
+
+// Must be called outside of the synchronized section.
+static void RasterGradientCache_freeList(RasterGradientCacheEntry* entry)
+{
+  while (entry)
+  {
+    RasterGradientCacheEntry* next = entry->next;
+
+    entry->cache->release();
+    MemMgr::free(entry);
+
+    entry = next;
+  }
+}
+
+// ============================================================================
+// [Fog::RasterGradientCache - GetOrCreate]
+// ============================================================================
+
+ColorStopCache* RasterGradientCache::getOrCreate(const ColorStopList* stops, uint32_t format, uint32_t length)
+{
+  const ColorStop* stopData = stops->getList();
+  size_t stopCount = stops->getLength();
+
+  FOG_ASSERT(stopCount > 0);
+  uint32_t hashCode = RasterGradientCache_hash(stopData, stopCount, format, length);
+
+  { AutoLock locked(RasterGradientCache_lock);
+
+    RasterGradientCacheEntry* entry = RasterGradientCache_find(stopData, stopCount, format, length, hashCode);
+    if (entry != NULL)
+    {
+      // Move the entry to the front, it's the most recently used one.
+      if (entry != RasterGradientCache_first)
+      {
+        RasterGradientCache_unlink(entry);
+        RasterGradientCache_prepend(entry);
+      }
+
+      return entry->cache->addRef();
+    }
+  }
+
+  // Create and interpolate the table outside of the synchronized section, the
+  // memory manager can call the cleanup handler if it runs out of memory.
+  ColorStopCache* cache = ColorStopCache::create32(format, length);
+  if (FOG_IS_NULL(cache))
+    return NULL;
+
+  _api_raster.gradient.interpolate[format](cache->getData(), length, stopData, stopCount);
+
+  // Assign also the end point.
+  uint32_t* table = reinterpret_cast<uint32_t*>(cache->getData());
+  table[length] = table[length - 1];
+
+  size_t stopSize = stopCount * sizeof(ColorStop);
+  size_t memSize = sizeof(RasterGradientCacheEntry) + stopSize +
+                   sizeof(ColorStopCache) + (length + 1) * 4;
+
+  // Don't cache tables which can't fit into the cache, the table is still
+  // returned to the caller.
+  if (memSize > RASTER_GRADIENT_CACHE_LIMIT)
+    return cache;
+
+  RasterGradientCacheEntry* entry = reinterpret_cast<RasterGradientCacheEntry*>(
+    MemMgr::alloc(sizeof(RasterGradientCacheEntry) + stopSize));
+
+  if (FOG_IS_NULL(entry))
+    return cache;
+
+  entry->cache = cache->addRef();
+  entry->hashCode = hashCode;
+  entry->format = format;
+  entry->length = length;
+  entry->stopCount = (uint32_t)stopCount;
+  entry->memSize = memSize;
+
+  MemOps::copy(entry->getStops(), stopData, stopSize);
+
+  RasterGradientCacheEntry* unused = NULL;
+
+  { AutoLock locked(RasterGradientCache_lock);
+
+    // Another thread could be faster, use its table and drop ours.
+    RasterGradientCacheEntry* old = RasterGradientCache_find(stopData, stopCount, format, length, hashCode);
+    if (old != NULL)
+    {
+      ColorStopCache* oldCache = old->cache->addRef();
+
+      entry->next = NULL;
+      unused = entry;
+
+      cache->release();
+      cache = oldCache;
+    }
+    else
+    {
+      // Release the least recently used entries to fit into the limit.
+      while (RasterGradientCache_last != NULL &&
+             RasterGradientCache_size + memSize > RASTER_GRADIENT_CACHE_LIMIT)
+      {
+        old = RasterGradientCache_last;
+
+        RasterGradientCache_unlink(old);
+        RasterGradientCache_removeFromBucket(old);
+
+        old->next = unused;
+        unused = old;
+      }
+
+      RasterGradientCacheEntry** bucket =
+        &RasterGradientCache_buckets[hashCode % RASTER_GRADIENT_CACHE_BUCKETS];
+
+      entry->hashNext = *bucket;
+      *bucket = entry;
+
+      RasterGradientCache_prepend(entry);
+    }
+  }
+
+  RasterGradientCache_freeList(unused);
+  return cache;
+}
+
+// ============================================================================
+// [Fog::RasterGradientCache - Reset]
+// ============================================================================
+
+void RasterGradientCache::reset()
+{
+  RasterGradientCacheEntry* unused;
+
+  { AutoLock locked(RasterGradientCache_lock);
+
+    unused = RasterGradientCache_first;
+
+    RasterGradientCache_first = NULL;
+    RasterGradientCache_last = NULL;
+    RasterGradientCache_size = 0;
+
+    MemOps::zero(RasterGradientCache_buckets, sizeof(RasterGradientCache_buckets));
+  }
+
+  RasterGradientCache_freeList(unused);
+}
+
+// ============================================================================
+// [Fog::RasterGradientCache - Cleanup]
+// ============================================================================
+
+static void FOG_CDECL RasterGradientCache_cleanupFunc(void* closure, uint32_t reason)
+{
+  RasterGradientCache::reset();
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void RasterGradientCache_init(void)
+{
+  RasterGradientCache_lock.init();
+
+  RasterGradientCache_first = NULL;
+  RasterGradientCache_last = NULL;
+  RasterGradientCache_size = 0;
+
+  MemOps::zero(RasterGradientCache_buckets, sizeof(RasterGradientCache_buckets));
+  MemMgr::registerCleanupFunc(RasterGradientCache_cleanupFunc, NULL);
+}
+
+FOG_NO_EXPORT void RasterGradientCache_fini(void)
+{
+  MemMgr::unregisterCleanupFunc(RasterGradientCache_cleanupFunc, NULL);
+
+  RasterGradientCache::reset();
+  RasterGradientCache_lock.destroy();
+}
+
+} // Fog namespace
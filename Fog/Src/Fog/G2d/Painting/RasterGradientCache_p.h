@@ -0,0 +1,69 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTERGRADIENTCACHE_P_H
+#define _FOG_G2D_PAINTING_RASTERGRADIENTCACHE_P_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Fog::RASTER_GRADIENT_CACHE]
+// ============================================================================
+
+enum RASTER_GRADIENT_CACHE
+{
+  //! @brief Maximum size of all cached color tables (in bytes).
+  RASTER_GRADIENT_CACHE_LIMIT = 256 * 1024,
+
+  //! @brief Count of hash buckets.
+  RASTER_GRADIENT_CACHE_BUCKETS = 64,
+
+  //! @brief Minimum length of the color table.
+  RASTER_GRADIENT_CACHE_MIN_LENGTH = 32,
+  //! @brief Maximum length of the color table.
+  RASTER_GRADIENT_CACHE_MAX_LENGTH = 1024
+};
+
+// ============================================================================
+// [Fog::RasterGradientCache]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Cache of interpolated gradient color tables shared by all color-stop
+//! lists.
+//!
+//! Each @c ColorStopList keeps only one table (@c stopCachePrgb32), so the
+//! identical lists created by different documents or elements would build
+//! their own tables. This cache is keyed by the content of color-stops, the
+//! format and the length of the table, so equal lists share one table. The
+//! least recently used tables are released when the cache exceeds
+//! @c RASTER_GRADIENT_CACHE_LIMIT. The cache is thread-safe and it's purged
+//! when the memory manager runs out of memory.
+struct FOG_NO_EXPORT RasterGradientCache
+{
+  //! @brief Get the color table of @a stops, creating it if it's not cached.
+  //!
+  //! The returned table has increased reference count, NULL is returned if
+  //! out of memory.
+  static ColorStopCache* getOrCreate(const ColorStopList* stops, uint32_t format, uint32_t length);
+
+  //! @brief Release all color tables held by the cache.
+  static void reset();
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTERGRADIENTCACHE_P_H
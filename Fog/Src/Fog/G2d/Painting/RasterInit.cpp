@@ -26,6 +26,7 @@ FOG_NO_EXPORT void RasterOps_init_C(void);
 FOG_NO_EXPORT void RasterOps_init_skipped(void);
 
 FOG_CPU_DECLARE_INITIALIZER_SSE2( RasterOps_init_SSE2(void) )
+FOG_CPU_DECLARE_INITIALIZER_SSSE3( RasterOps_init_SSSE3(void) )
 
 // ============================================================================
 // [Fog::G2d - Initialization / Finalization]
@@ -41,6 +42,7 @@ FOG_NO_EXPORT void RasterOps_init(void)
   // --------------------------------------------------------------------------
 
   FOG_CPU_USE_INITIALIZER_SSE2( RasterOps_init_SSE2() )
+  FOG_CPU_USE_INITIALIZER_SSSE3( RasterOps_init_SSSE3() )
 
   // --------------------------------------------------------------------------
   // [Init-Skipped]
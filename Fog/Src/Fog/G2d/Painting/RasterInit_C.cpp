@@ -40,9 +40,11 @@
 #include <Fog/G2d/Painting/RasterOps_C/FilterConvolveMatrix_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/FilterConvolveSeparable_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/FilterMorphology_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/FilterTurbulence_p.h>
 
 #include <Fog/G2d/Painting/RasterOps_C/TextureBase_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/TextureAffine_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/TextureOrtho_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/TextureProjection_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/TextureScale_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/TextureSimple_p.h>
@@ -502,7 +504,19 @@ FOG_NO_EXPORT void RasterOps_init_C(void)
   // [RasterOps - Composite - SrcOver - A8]
   // --------------------------------------------------------------------------
 
-  // TODO: Image compositing.
+#if defined(FOG_RASTER_INIT_C)
+  {
+    RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_A8][RASTER_COMPOSITE_CORE_SRC_OVER];
+
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB     ], RasterOps_C::CompositeSrcOver::a8_cblit_prgb32_line);
+    FOG_RASTER_SKIP(cblit_line[RASTER_CBLIT_XRGB     ]);
+
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], RasterOps_C::CompositeSrcOver::a8_cblit_prgb32_span);
+    FOG_RASTER_SKIP(cblit_span[RASTER_CBLIT_XRGB     ]);
+
+    // TODO: Image compositing.
+  }
+#endif // FOG_RASTER_INIT_C
 
   // --------------------------------------------------------------------------
   // [RasterOps - Composite - Clear - PRGB32]
@@ -1872,6 +1886,34 @@ FOG_NO_EXPORT void RasterOps_init_C(void)
   texture.prgb32.fetch_affine_bilinear[IMAGE_FORMAT_A8    ][TEXTURE_TILE_CLAMP  ] = RasterOps_C::PTextureAffine::fetch_affine_bilinear_clamp<RasterOps_C::PTextureAccessor_PRGB32_From_A8    >;
   texture.prgb32.fetch_affine_bilinear[IMAGE_FORMAT_I8    ][TEXTURE_TILE_CLAMP  ] = RasterOps_C::PTextureAffine::fetch_affine_bilinear_clamp<RasterOps_C::PTextureAccessor_PRGB32_From_I8    >;
 
+  // --------------------------------------------------------------------------
+  // [RasterOps - Pattern - Texture - Ortho]
+  // --------------------------------------------------------------------------
+
+  texture.prgb32.fetch_ortho_copy      [IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_ortho_copy_pad<RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_ortho_copy      [IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_ortho_copy_pad<RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  texture.prgb32.fetch_ortho_copy      [IMAGE_FORMAT_RGB24 ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_ortho_copy_pad<RasterOps_C::PTextureAccessor_PRGB32_From_RGB24 >;
+  texture.prgb32.fetch_ortho_copy      [IMAGE_FORMAT_A8    ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_ortho_copy_pad<RasterOps_C::PTextureAccessor_PRGB32_From_A8    >;
+  texture.prgb32.fetch_ortho_copy      [IMAGE_FORMAT_I8    ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_ortho_copy_pad<RasterOps_C::PTextureAccessor_PRGB32_From_I8    >;
+
+  texture.prgb32.fetch_upscale_nearest [IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_upscale_nearest_pad<RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_upscale_nearest [IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_upscale_nearest_pad<RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  texture.prgb32.fetch_upscale_nearest [IMAGE_FORMAT_RGB24 ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_upscale_nearest_pad<RasterOps_C::PTextureAccessor_PRGB32_From_RGB24 >;
+  texture.prgb32.fetch_upscale_nearest [IMAGE_FORMAT_A8    ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_upscale_nearest_pad<RasterOps_C::PTextureAccessor_PRGB32_From_A8    >;
+  texture.prgb32.fetch_upscale_nearest [IMAGE_FORMAT_I8    ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_upscale_nearest_pad<RasterOps_C::PTextureAccessor_PRGB32_From_I8    >;
+
+  texture.prgb32.fetch_upscale_bilinear[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_upscale_bilinear_pad<RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_upscale_bilinear[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_upscale_bilinear_pad<RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  texture.prgb32.fetch_upscale_bilinear[IMAGE_FORMAT_RGB24 ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_upscale_bilinear_pad<RasterOps_C::PTextureAccessor_PRGB32_From_RGB24 >;
+  texture.prgb32.fetch_upscale_bilinear[IMAGE_FORMAT_A8    ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_upscale_bilinear_pad<RasterOps_C::PTextureAccessor_PRGB32_From_A8    >;
+  texture.prgb32.fetch_upscale_bilinear[IMAGE_FORMAT_I8    ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_upscale_bilinear_pad<RasterOps_C::PTextureAccessor_PRGB32_From_I8    >;
+
+  texture.prgb32.fetch_downscale_box   [IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_downscale_box_pad<RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  texture.prgb32.fetch_downscale_box   [IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_downscale_box_pad<RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  texture.prgb32.fetch_downscale_box   [IMAGE_FORMAT_RGB24 ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_downscale_box_pad<RasterOps_C::PTextureAccessor_PRGB32_From_RGB24 >;
+  texture.prgb32.fetch_downscale_box   [IMAGE_FORMAT_A8    ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_downscale_box_pad<RasterOps_C::PTextureAccessor_PRGB32_From_A8    >;
+  texture.prgb32.fetch_downscale_box   [IMAGE_FORMAT_I8    ][TEXTURE_TILE_PAD    ] = RasterOps_C::PTextureOrtho::fetch_downscale_box_pad<RasterOps_C::PTextureAccessor_PRGB32_From_I8    >;
+
   // --------------------------------------------------------------------------
   // [RasterOps - Pattern - Texture - Projection]
   // --------------------------------------------------------------------------
@@ -1886,6 +1928,42 @@ FOG_NO_EXPORT void RasterOps_init_C(void)
 
   RasterFilterFuncs& filter = api.filter;
 
+  filter.copy[IMAGE_FORMAT_PRGB32] = RasterOps_C::FColorBase::copy<RasterOps_C::FBaseAccessor_PRGB32>;
+  filter.copy[IMAGE_FORMAT_XRGB32] = RasterOps_C::FColorBase::copy<RasterOps_C::FBaseAccessor_XRGB32>;
+  filter.copy[IMAGE_FORMAT_RGB24 ] = RasterOps_C::FColorBase::copy<RasterOps_C::FBaseAccessor_RGB24 >;
+  filter.copy[IMAGE_FORMAT_A8    ] = RasterOps_C::FColorBase::copy<RasterOps_C::FBaseAccessor_A8    >;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - ColorLut / ComponentTransfer]
+  // --------------------------------------------------------------------------
+
+  filter.create[FE_TYPE_COLOR_LUT] = RasterOps_C::FColorLut::create;
+  filter.create[FE_TYPE_COMPONENT_TRANSFER] = RasterOps_C::FComponentTransfer::create;
+
+  filter.colorLut.argb[IMAGE_FORMAT_PRGB32] = RasterOps_C::FColorLut::doArgb_PRGB32;
+  filter.colorLut.argb[IMAGE_FORMAT_XRGB32] = RasterOps_C::FColorLut::doRgb<RasterOps_C::FBaseAccessor_XRGB32>;
+  filter.colorLut.argb[IMAGE_FORMAT_RGB24 ] = RasterOps_C::FColorLut::doRgb<RasterOps_C::FBaseAccessor_RGB24 >;
+
+  filter.colorLut.alpha[IMAGE_FORMAT_PRGB32] = RasterOps_C::FColorLut::doAlpha_PRGB32;
+  filter.colorLut.alpha[IMAGE_FORMAT_A8    ] = RasterOps_C::FColorLut::doAlpha_A8;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - ColorMatrix]
+  // --------------------------------------------------------------------------
+
+  filter.create[FE_TYPE_COLOR_MATRIX] = RasterOps_C::FColorMatrix::create;
+
+  filter.colorMatrix.argb[IMAGE_FORMAT_PRGB32] = RasterOps_C::FColorMatrix::doArgb_PRGB32;
+  filter.colorMatrix.argb[IMAGE_FORMAT_XRGB32] = RasterOps_C::FColorMatrix::doArgb<RasterOps_C::FBaseAccessor_XRGB32>;
+  filter.colorMatrix.argb[IMAGE_FORMAT_RGB24 ] = RasterOps_C::FColorMatrix::doArgb<RasterOps_C::FBaseAccessor_RGB24 >;
+
+  filter.colorMatrix.grey[IMAGE_FORMAT_PRGB32] = RasterOps_C::FColorMatrix::doGrey_PRGB32;
+  filter.colorMatrix.grey[IMAGE_FORMAT_XRGB32] = RasterOps_C::FColorMatrix::doGrey<RasterOps_C::FBaseAccessor_XRGB32>;
+  filter.colorMatrix.grey[IMAGE_FORMAT_RGB24 ] = RasterOps_C::FColorMatrix::doGrey<RasterOps_C::FBaseAccessor_RGB24 >;
+
+  filter.colorMatrix.alpha[IMAGE_FORMAT_PRGB32] = RasterOps_C::FColorMatrix::doAlpha_PRGB32;
+  filter.colorMatrix.alpha[IMAGE_FORMAT_A8    ] = RasterOps_C::FColorMatrix::doAlpha_A8;
+
   // --------------------------------------------------------------------------
   // [RasterOps - Filter - Blur]
   // --------------------------------------------------------------------------
@@ -1921,6 +1999,56 @@ FOG_NO_EXPORT void RasterOps_init_C(void)
   filter.blur.exponential.v[IMAGE_FORMAT_XRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doExpV<RasterOps_C::FBlurExpAccessor_XRGB32>;
   filter.blur.exponential.v[IMAGE_FORMAT_RGB24 ] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doExpV<RasterOps_C::FBlurExpAccessor_RGB24 >;
   filter.blur.exponential.v[IMAGE_FORMAT_A8    ] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doExpV<RasterOps_C::FBlurExpAccessor_A8    >;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - Convolve]
+  // --------------------------------------------------------------------------
+
+  filter.create[FE_TYPE_CONVOLVE_MATRIX] = RasterOps_C::FConvolveMatrix::create;
+  filter.create[FE_TYPE_CONVOLVE_SEPARABLE] = RasterOps_C::FConvolveSeparable::create;
+
+  filter.convolve.h[IMAGE_FORMAT_PRGB32] = RasterOps_C::FConvolveSeparable::doH<4>;
+  filter.convolve.h[IMAGE_FORMAT_XRGB32] = RasterOps_C::FConvolveSeparable::doH<4>;
+  filter.convolve.h[IMAGE_FORMAT_RGB24 ] = RasterOps_C::FConvolveSeparable::doH<4>;
+  filter.convolve.h[IMAGE_FORMAT_A8    ] = RasterOps_C::FConvolveSeparable::doH<1>;
+
+  filter.convolve.v[IMAGE_FORMAT_PRGB32] = RasterOps_C::FConvolveSeparable::doV<4>;
+  filter.convolve.v[IMAGE_FORMAT_XRGB32] = RasterOps_C::FConvolveSeparable::doV<4>;
+  filter.convolve.v[IMAGE_FORMAT_RGB24 ] = RasterOps_C::FConvolveSeparable::doV<4>;
+  filter.convolve.v[IMAGE_FORMAT_A8    ] = RasterOps_C::FConvolveSeparable::doV<1>;
+
+  filter.convolve.matrix[IMAGE_FORMAT_PRGB32] = RasterOps_C::FConvolveMatrix::doMatrix<4>;
+  filter.convolve.matrix[IMAGE_FORMAT_XRGB32] = RasterOps_C::FConvolveMatrix::doMatrix<4>;
+  filter.convolve.matrix[IMAGE_FORMAT_RGB24 ] = RasterOps_C::FConvolveMatrix::doMatrix<4>;
+  filter.convolve.matrix[IMAGE_FORMAT_A8    ] = RasterOps_C::FConvolveMatrix::doMatrix<1>;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - Morphology]
+  // --------------------------------------------------------------------------
+
+  filter.create[FE_TYPE_MORPHOLOGY] = RasterOps_C::FMorphology::create;
+
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_ERODE ][IMAGE_FORMAT_PRGB32] = RasterOps_C::FMorphology::doH<4, RasterOps_C::FMorphologyErode>;
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_ERODE ][IMAGE_FORMAT_XRGB32] = RasterOps_C::FMorphology::doH<4, RasterOps_C::FMorphologyErode>;
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_ERODE ][IMAGE_FORMAT_RGB24 ] = RasterOps_C::FMorphology::doH<4, RasterOps_C::FMorphologyErode>;
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_ERODE ][IMAGE_FORMAT_A8    ] = RasterOps_C::FMorphology::doH<1, RasterOps_C::FMorphologyErode>;
+
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_DILATE][IMAGE_FORMAT_PRGB32] = RasterOps_C::FMorphology::doH<4, RasterOps_C::FMorphologyDilate>;
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_DILATE][IMAGE_FORMAT_XRGB32] = RasterOps_C::FMorphology::doH<4, RasterOps_C::FMorphologyDilate>;
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_DILATE][IMAGE_FORMAT_RGB24 ] = RasterOps_C::FMorphology::doH<4, RasterOps_C::FMorphologyDilate>;
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_DILATE][IMAGE_FORMAT_A8    ] = RasterOps_C::FMorphology::doH<1, RasterOps_C::FMorphologyDilate>;
+
+  filter.morphology.v[FE_MORPHOLOGY_TYPE_ERODE ] = RasterOps_C::FMorphology::doV<RasterOps_C::FMorphologyErode>;
+  filter.morphology.v[FE_MORPHOLOGY_TYPE_DILATE] = RasterOps_C::FMorphology::doV<RasterOps_C::FMorphologyDilate>;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - Turbulence]
+  // --------------------------------------------------------------------------
+
+  filter.create[FE_TYPE_TURBULENCE] = RasterOps_C::FTurbulence::create;
+
+  filter.turbulence[FE_TURBULENCE_TYPE_TURBULENCE   ] = RasterOps_C::FTurbulence::doTurbulence<FE_TURBULENCE_TYPE_TURBULENCE>;
+  filter.turbulence[FE_TURBULENCE_TYPE_FRACTAL_NOISE] = RasterOps_C::FTurbulence::doTurbulence<FE_TURBULENCE_TYPE_FRACTAL_NOISE>;
 }
 
 } // Fog namespace
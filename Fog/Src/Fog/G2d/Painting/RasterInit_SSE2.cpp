@@ -26,6 +26,12 @@
 #include <Fog/G2d/Painting/RasterOps_SSE2/CompositeSrc_p.h>
 #include <Fog/G2d/Painting/RasterOps_SSE2/CompositeSrcOver_p.h>
 
+#include <Fog/G2d/Painting/RasterOps_SSE2/FilterBlur_p.h>
+#include <Fog/G2d/Painting/RasterOps_SSE2/FilterColorMatrix_p.h>
+#include <Fog/G2d/Painting/RasterOps_SSE2/FilterConvolve_p.h>
+#include <Fog/G2d/Painting/RasterOps_SSE2/FilterMorphology_p.h>
+#include <Fog/G2d/Painting/RasterOps_SSE2/FilterTurbulence_p.h>
+
 #include <Fog/G2d/Painting/RasterOps_SSE2/GradientBase_p.h>
 #include <Fog/G2d/Painting/RasterOps_SSE2/GradientConical_p.h>
 #include <Fog/G2d/Painting/RasterOps_SSE2/GradientLinear_p.h>
@@ -72,45 +78,58 @@ FOG_NO_EXPORT void RasterOps_init_SSE2(void)
   */
   convert.fill[RASTER_FILL_8] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::fill_8;
   convert.fill[RASTER_FILL_16] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::fill_16;
-  /*
+
   // --------------------------------------------------------------------------
   // [RasterOps - Convert - BSwap]
   // --------------------------------------------------------------------------
 
   convert.bswap[RASTER_BSWAP_16] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::bswap_16;
-  convert.bswap[RASTER_BSWAP_24] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::bswap_24;
   convert.bswap[RASTER_BSWAP_32] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::bswap_32;
+  /*
   convert.bswap[RASTER_BSWAP_48] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::bswap_48;
   convert.bswap[RASTER_BSWAP_64] = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::bswap_64;
+  */
 
   // --------------------------------------------------------------------------
   // [RasterOps - Convert - Premultiply / Demultiply]
   // --------------------------------------------------------------------------
 
   convert.prgb32_from_argb32 = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::prgb32_from_argb32;
+  convert.argb32_from_prgb32 = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::argb32_from_prgb32;
+  /*
   convert.prgb64_from_argb64 = (ImageConverterBlitLineFunc)RasterOps_SSE2::Convert::prgb64_from_argb64;
   */
+
   // --------------------------------------------------------------------------
   // [RasterOps - Convert - ARGB32]
   // --------------------------------------------------------------------------
 
-  /*
   convert.argb32_from[RASTER_FORMAT_RGB16_555          ] = RasterOps_SSE2::Convert::argb32_from_rgb16_555;
   convert.argb32_from[RASTER_FORMAT_RGB16_555_BS       ] = RasterOps_SSE2::Convert::argb32_from_rgb16_555_bs;
   convert.argb32_from[RASTER_FORMAT_RGB16_565          ] = RasterOps_SSE2::Convert::argb32_from_rgb16_565;
   convert.argb32_from[RASTER_FORMAT_RGB16_565_BS       ] = RasterOps_SSE2::Convert::argb32_from_rgb16_565_bs;
+//convert.argb32_from[RASTER_FORMAT_RGB32_888          ] = SKIP;
+  convert.argb32_from[RASTER_FORMAT_RGB32_888_BS       ] = RasterOps_SSE2::Convert::argb32_from_rgb32_888_bs;
+//convert.argb32_from[RASTER_FORMAT_ARGB32_8888        ] = SKIP;
+  convert.argb32_from[RASTER_FORMAT_ARGB32_8888_BS     ] = RasterOps_SSE2::Convert::argb32_from_argb32_8888_bs;
+
+  convert.from_argb32[RASTER_FORMAT_RGB16_555          ] = RasterOps_SSE2::Convert::rgb16_555_from_argb32;
+  convert.from_argb32[RASTER_FORMAT_RGB16_555_BS       ] = RasterOps_SSE2::Convert::rgb16_555_bs_from_argb32;
+  convert.from_argb32[RASTER_FORMAT_RGB16_565          ] = RasterOps_SSE2::Convert::rgb16_565_from_argb32;
+  convert.from_argb32[RASTER_FORMAT_RGB16_565_BS       ] = RasterOps_SSE2::Convert::rgb16_565_bs_from_argb32;
+//convert.from_argb32[RASTER_FORMAT_RGB32_888          ] = SKIP;
+  convert.from_argb32[RASTER_FORMAT_RGB32_888_BS       ] = RasterOps_SSE2::Convert::rgb32_888_bs_from_argb32;
+//convert.from_argb32[RASTER_FORMAT_ARGB32_8888        ] = SKIP;
+  convert.from_argb32[RASTER_FORMAT_ARGB32_8888_BS     ] = RasterOps_SSE2::Convert::argb32_8888_bs_from_argb32;
+
+  // RGB24_888_BS conversion needs byte shuffle, see RasterInit_SSSE3.cpp.
+  /*
   convert.argb32_from[RASTER_FORMAT_ARGB16_4444        ] = RasterOps_SSE2::Convert::argb32_from_argb16_4444;
   convert.argb32_from[RASTER_FORMAT_ARGB16_4444_BS     ] = RasterOps_SSE2::Convert::argb32_from_argb16_4444_bs;
   convert.argb32_from[RASTER_FORMAT_ARGB16_CUSTOM      ] = RasterOps_SSE2::Convert::argb32_from_argb16_custom;
   convert.argb32_from[RASTER_FORMAT_ARGB16_CUSTOM_BS   ] = RasterOps_SSE2::Convert::argb32_from_argb16_custom_bs;
-//convert.argb32_from[RASTER_FORMAT_RGB24_888          ] = SKIP;
-  convert.argb32_from[RASTER_FORMAT_RGB24_888_BS       ] = RasterOps_SSE2::Convert::argb32_from_rgb24_888_bs;
   convert.argb32_from[RASTER_FORMAT_ARGB24_CUSTOM      ] = RasterOps_SSE2::Convert::argb32_from_argb24_custom;
   convert.argb32_from[RASTER_FORMAT_ARGB24_CUSTOM_BS   ] = RasterOps_SSE2::Convert::argb32_from_argb24_custom_bs;
-//convert.argb32_from[RASTER_FORMAT_RGB32_888          ] = SKIP;
-  convert.argb32_from[RASTER_FORMAT_RGB32_888_BS       ] = RasterOps_SSE2::Convert::argb32_from_rgb32_888_bs;
-//convert.argb32_from[RASTER_FORMAT_ARGB32_8888        ] = SKIP;
-  convert.argb32_from[RASTER_FORMAT_ARGB32_8888_BS     ] = RasterOps_SSE2::Convert::argb32_from_argb32_8888_bs;
   convert.argb32_from[RASTER_FORMAT_ARGB32_CUSTOM      ] = RasterOps_SSE2::Convert::argb32_from_argb32_custom;
   convert.argb32_from[RASTER_FORMAT_ARGB32_CUSTOM_BS   ] = RasterOps_SSE2::Convert::argb32_from_argb32_custom_bs;
 //convert.argb32_from[RASTER_FORMAT_RGB48_161616       ] = SKIP;
@@ -125,22 +144,12 @@ FOG_NO_EXPORT void RasterOps_init_SSE2(void)
   convert.argb32_from[RASTER_FORMAT_ARGB64_CUSTOM_BS   ] = RasterOps_SSE2::Convert::argb32_from_argb64_custom_bs;
 //convert.argb32_from[RASTER_FORMAT_I8                 ];
 
-  convert.from_argb32[RASTER_FORMAT_RGB16_555          ] = RasterOps_SSE2::Convert::rgb16_555_from_argb32;
-  convert.from_argb32[RASTER_FORMAT_RGB16_555_BS       ] = RasterOps_SSE2::Convert::rgb16_555_bs_from_argb32;
-  convert.from_argb32[RASTER_FORMAT_RGB16_565          ] = RasterOps_SSE2::Convert::rgb16_565_from_argb32;
-  convert.from_argb32[RASTER_FORMAT_RGB16_565_BS       ] = RasterOps_SSE2::Convert::rgb16_565_bs_from_argb32;
   convert.from_argb32[RASTER_FORMAT_ARGB16_4444        ] = RasterOps_SSE2::Convert::argb16_4444_from_argb32;
   convert.from_argb32[RASTER_FORMAT_ARGB16_4444_BS     ] = RasterOps_SSE2::Convert::argb16_4444_bs_from_argb32;
   convert.from_argb32[RASTER_FORMAT_ARGB16_CUSTOM      ] = RasterOps_SSE2::Convert::argb16_custom_from_argb32;
   convert.from_argb32[RASTER_FORMAT_ARGB16_CUSTOM_BS   ] = RasterOps_SSE2::Convert::argb16_custom_bs_from_argb32;
-//convert.from_argb32[RASTER_FORMAT_RGB24_888          ] = SKIP;
-  convert.from_argb32[RASTER_FORMAT_RGB24_888_BS       ] = RasterOps_SSE2::Convert::rgb24_888_bs_from_argb32;
   convert.from_argb32[RASTER_FORMAT_ARGB24_CUSTOM      ] = RasterOps_SSE2::Convert::argb24_custom_from_argb32;
   convert.from_argb32[RASTER_FORMAT_ARGB24_CUSTOM_BS   ] = RasterOps_SSE2::Convert::argb24_custom_bs_from_argb32;
-//convert.from_argb32[RASTER_FORMAT_RGB32_888          ] = SKIP;
-  convert.from_argb32[RASTER_FORMAT_RGB32_888_BS       ] = RasterOps_SSE2::Convert::rgb32_888_bs_from_argb32;
-//convert.from_argb32[RASTER_FORMAT_ARGB32_8888        ] = SKIP;
-  convert.from_argb32[RASTER_FORMAT_ARGB32_8888_BS     ] = RasterOps_SSE2::Convert::argb32_8888_bs_from_argb32;
   convert.from_argb32[RASTER_FORMAT_ARGB32_CUSTOM      ] = RasterOps_SSE2::Convert::argb32_custom_from_argb32;
   convert.from_argb32[RASTER_FORMAT_ARGB32_CUSTOM_BS   ] = RasterOps_SSE2::Convert::argb32_custom_bs_from_argb32;
 //convert.from_argb32[RASTER_FORMAT_RGB48_161616       ] = SKIP;
@@ -235,15 +244,16 @@ FOG_NO_EXPORT void RasterOps_init_SSE2(void)
 
     FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], RasterOps_SSE2::CompositeSrc::prgb32_cblit_prgb32_span);
     FOG_RASTER_SKIP(cblit_span[RASTER_CBLIT_XRGB     ]);
+
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_XRGB32   ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_xrgb32_line);
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_A8       ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_a8_line);
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB64   ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_prgb64_line);
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_A16      ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_a16_line);
 /*
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB32   ], RasterOps_SSE2::Convert::copy_32);
-    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_XRGB32   ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_xrgb32_line);
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_RGB24    ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_rgb24_line);
-    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_A8       ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_a8_line);
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_I8       ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_i8_line);
-    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB64   ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_prgb64_line);
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_RGB48    ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_rgb48_line);
-    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_A16      ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_a16_line);
 
     FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB32   ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_prgb32_span);
     FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_XRGB32   ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_xrgb32_span);
@@ -268,15 +278,16 @@ FOG_NO_EXPORT void RasterOps_init_SSE2(void)
 
     FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], RasterOps_SSE2::CompositeSrc::prgb32_cblit_prgb32_span);
     FOG_RASTER_SKIP(cblit_span[RASTER_CBLIT_XRGB     ]);
-/*
+
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB32   ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_xrgb32_line);
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_A8       ], RasterOps_SSE2::CompositeSrc::xrgb32_vblit_a8_line);
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB64   ], RasterOps_SSE2::CompositeSrc::xrgb32_vblit_prgb64_line);
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_A16      ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_a16_line);
+/*
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_XRGB32   ], RasterOps_SSE2::Convert::copy_32);
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_RGB24    ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_rgb24_line);
-    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_A8       ], RasterOps_SSE2::CompositeSrc::xrgb32_vblit_a8_line);
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_I8       ], RasterOps_SSE2::CompositeSrc::xrgb32_vblit_i8_line);
-    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB64   ], RasterOps_SSE2::CompositeSrc::xrgb32_vblit_prgb64_line);
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_RGB48    ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_rgb48_line);
-    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_A16      ], RasterOps_SSE2::CompositeSrc::prgb32_vblit_a16_line);
 
     FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB32   ], RasterOps_SSE2::CompositeSrc::xrgb32_vblit_xrgb32_span);
     FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_XRGB32   ], RasterOps_SSE2::CompositeSrc::xrgb32_vblit_xrgb32_span);
@@ -320,6 +331,7 @@ FOG_NO_EXPORT void RasterOps_init_SSE2(void)
     FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_RGB48    ], RasterOps_SSE2::CompositeSrc::rgb24_vblit_rgb48_span);
     FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_A16      ], RasterOps_SSE2::CompositeSrc::rgb24_vblit_a16_span);
   }
+*/
 
   // --------------------------------------------------------------------------
   // [RasterOps - Composite - Src - A8]
@@ -328,20 +340,21 @@ FOG_NO_EXPORT void RasterOps_init_SSE2(void)
   {
     RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_A8][RASTER_COMPOSITE_CORE_SRC];
 
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB32   ], RasterOps_SSE2::CompositeSrc::a8_vblit_prgb32_line);
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_A16      ], RasterOps_SSE2::CompositeSrc::a8_vblit_a16_line);
+/*
     FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB     ], RasterOps_SSE2::CompositeSrc::a8_cblit_prgb32_line);
     FOG_RASTER_SKIP(cblit_line[RASTER_CBLIT_XRGB     ]);
 
     FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], RasterOps_SSE2::CompositeSrc::a8_cblit_prgb32_span);
     FOG_RASTER_SKIP(cblit_span[RASTER_CBLIT_XRGB     ]);
 
-    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB32   ], RasterOps_SSE2::CompositeSrc::a8_vblit_prgb32_line);
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_XRGB32   ], RasterOps_SSE2::Convert::fill_8);
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_RGB24    ], RasterOps_SSE2::Convert::fill_8);
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_A8       ], RasterOps_SSE2::CompositeSrc::a8_vblit_a8_line);
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_I8       ], RasterOps_SSE2::CompositeSrc::a8_vblit_i8_line);
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB64   ], RasterOps_SSE2::CompositeSrc::a8_vblit_prgb64_line);
     FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_RGB48    ], RasterOps_SSE2::Convert::fill_8);
-    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_A16      ], RasterOps_SSE2::CompositeSrc::a8_vblit_a16_line);
 
     FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB32   ], RasterOps_SSE2::CompositeSrc::a8_vblit_prgb32_span);
     FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_XRGB32   ], RasterOps_SSE2::CompositeSrc::a8_vblit_white_span);
@@ -351,12 +364,13 @@ FOG_NO_EXPORT void RasterOps_init_SSE2(void)
     FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB64   ], RasterOps_SSE2::CompositeSrc::a8_vblit_prgb64_span);
     FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_RGB48    ], RasterOps_SSE2::CompositeSrc::a8_vblit_white_span);
     FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_A16      ], RasterOps_SSE2::CompositeSrc::a8_vblit_a16_span);
+*/
   }
 
   // --------------------------------------------------------------------------
   // [RasterOps - Composite - SrcOver - PRGB32]
   // --------------------------------------------------------------------------
-*/
+
   {
     RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_PRGB32][RASTER_COMPOSITE_CORE_SRC_OVER];
 
@@ -1546,6 +1560,105 @@ FOG_NO_EXPORT void RasterOps_init_SSE2(void)
 
   gradient.interpolate[IMAGE_FORMAT_PRGB32] = RasterOps_SSE2::PGradientBase::interpolate_prgb32;
   gradient.interpolate[IMAGE_FORMAT_XRGB32] = RasterOps_SSE2::PGradientBase::interpolate_prgb32;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Pattern - Gradient - Radial]
+  // --------------------------------------------------------------------------
+
+  gradient.radial.fetch_simple_nearest[IMAGE_FORMAT_PRGB32][GRADIENT_SPREAD_PAD    ] = RasterOps_SSE2::PGradientRadial::fetch_simple_nearest<RasterOps_SSE2::PGradientAccessor_PRGB32_Pad>;
+  gradient.radial.fetch_simple_nearest[IMAGE_FORMAT_XRGB32][GRADIENT_SPREAD_PAD    ] = RasterOps_SSE2::PGradientRadial::fetch_simple_nearest<RasterOps_SSE2::PGradientAccessor_PRGB32_Pad>;
+
+  gradient.radial.fetch_simple_nearest[IMAGE_FORMAT_PRGB32][GRADIENT_SPREAD_REPEAT ] = RasterOps_SSE2::PGradientRadial::fetch_simple_nearest<RasterOps_SSE2::PGradientAccessor_PRGB32_Repeat>;
+  gradient.radial.fetch_simple_nearest[IMAGE_FORMAT_XRGB32][GRADIENT_SPREAD_REPEAT ] = RasterOps_SSE2::PGradientRadial::fetch_simple_nearest<RasterOps_SSE2::PGradientAccessor_PRGB32_Repeat>;
+
+  gradient.radial.fetch_simple_nearest[IMAGE_FORMAT_PRGB32][GRADIENT_SPREAD_REFLECT] = RasterOps_SSE2::PGradientRadial::fetch_simple_nearest<RasterOps_SSE2::PGradientAccessor_PRGB32_Reflect>;
+  gradient.radial.fetch_simple_nearest[IMAGE_FORMAT_XRGB32][GRADIENT_SPREAD_REFLECT] = RasterOps_SSE2::PGradientRadial::fetch_simple_nearest<RasterOps_SSE2::PGradientAccessor_PRGB32_Reflect>;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Pattern - Gradient - Conical]
+  // --------------------------------------------------------------------------
+
+  gradient.conical.fetch_simple_nearest[IMAGE_FORMAT_PRGB32] = RasterOps_SSE2::PGradientConical::fetch_simple_nearest<RasterOps_SSE2::PGradientAccessor_PRGB32_Base>;
+  gradient.conical.fetch_simple_nearest[IMAGE_FORMAT_XRGB32] = RasterOps_SSE2::PGradientConical::fetch_simple_nearest<RasterOps_SSE2::PGradientAccessor_PRGB32_Base>;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - API]
+  // --------------------------------------------------------------------------
+
+  RasterFilterFuncs& filter = api.filter;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - Blur]
+  // --------------------------------------------------------------------------
+
+  filter.blur.box.h[IMAGE_FORMAT_PRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doBoxH<RasterOps_SSE2::FBlurBoxAccessor_PRGB32>;
+  filter.blur.box.h[IMAGE_FORMAT_XRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doBoxH<RasterOps_SSE2::FBlurBoxAccessor_XRGB32>;
+
+  filter.blur.box.v[IMAGE_FORMAT_PRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doBoxV<RasterOps_SSE2::FBlurBoxAccessor_PRGB32>;
+  filter.blur.box.v[IMAGE_FORMAT_XRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doBoxV<RasterOps_SSE2::FBlurBoxAccessor_XRGB32>;
+
+  filter.blur.stack.h[IMAGE_FORMAT_PRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doStackH<RasterOps_SSE2::FBlurStackAccessor_PRGB32>;
+  filter.blur.stack.h[IMAGE_FORMAT_XRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doStackH<RasterOps_SSE2::FBlurStackAccessor_XRGB32>;
+
+  filter.blur.stack.v[IMAGE_FORMAT_PRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doStackV<RasterOps_SSE2::FBlurStackAccessor_PRGB32>;
+  filter.blur.stack.v[IMAGE_FORMAT_XRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doStackV<RasterOps_SSE2::FBlurStackAccessor_XRGB32>;
+
+  filter.blur.exponential.h[IMAGE_FORMAT_PRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doExpH<RasterOps_SSE2::FBlurExpAccessor_PRGB32>;
+  filter.blur.exponential.h[IMAGE_FORMAT_XRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doExpH<RasterOps_SSE2::FBlurExpAccessor_XRGB32>;
+
+  filter.blur.exponential.v[IMAGE_FORMAT_PRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doExpV<RasterOps_SSE2::FBlurExpAccessor_PRGB32>;
+  filter.blur.exponential.v[IMAGE_FORMAT_XRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doExpV<RasterOps_SSE2::FBlurExpAccessor_XRGB32>;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - ColorMatrix]
+  // --------------------------------------------------------------------------
+
+  filter.colorMatrix.argb[IMAGE_FORMAT_PRGB32] = RasterOps_SSE2::FColorMatrix::doArgb_PRGB32;
+  filter.colorMatrix.argb[IMAGE_FORMAT_XRGB32] = RasterOps_SSE2::FColorMatrix::doArgb_XRGB32;
+
+  filter.colorMatrix.grey[IMAGE_FORMAT_PRGB32] = RasterOps_SSE2::FColorMatrix::doGrey_PRGB32;
+  filter.colorMatrix.grey[IMAGE_FORMAT_XRGB32] = RasterOps_SSE2::FColorMatrix::doGrey_XRGB32;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - Convolve]
+  // --------------------------------------------------------------------------
+
+  filter.convolve.h[IMAGE_FORMAT_PRGB32] = RasterOps_SSE2::FConvolve::doH_32;
+  filter.convolve.h[IMAGE_FORMAT_XRGB32] = RasterOps_SSE2::FConvolve::doH_32;
+  filter.convolve.h[IMAGE_FORMAT_RGB24 ] = RasterOps_SSE2::FConvolve::doH_32;
+
+  filter.convolve.v[IMAGE_FORMAT_PRGB32] = RasterOps_SSE2::FConvolve::doV<4>;
+  filter.convolve.v[IMAGE_FORMAT_XRGB32] = RasterOps_SSE2::FConvolve::doV<4>;
+  filter.convolve.v[IMAGE_FORMAT_RGB24 ] = RasterOps_SSE2::FConvolve::doV<4>;
+  filter.convolve.v[IMAGE_FORMAT_A8    ] = RasterOps_SSE2::FConvolve::doV<1>;
+
+  filter.convolve.matrix[IMAGE_FORMAT_PRGB32] = RasterOps_SSE2::FConvolve::doMatrix_32;
+  filter.convolve.matrix[IMAGE_FORMAT_XRGB32] = RasterOps_SSE2::FConvolve::doMatrix_32;
+  filter.convolve.matrix[IMAGE_FORMAT_RGB24 ] = RasterOps_SSE2::FConvolve::doMatrix_32;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - Morphology]
+  // --------------------------------------------------------------------------
+
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_ERODE ][IMAGE_FORMAT_PRGB32] = RasterOps_SSE2::FMorphology::doH_32<RasterOps_SSE2::FMorphologyErode>;
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_ERODE ][IMAGE_FORMAT_XRGB32] = RasterOps_SSE2::FMorphology::doH_32<RasterOps_SSE2::FMorphologyErode>;
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_ERODE ][IMAGE_FORMAT_RGB24 ] = RasterOps_SSE2::FMorphology::doH_32<RasterOps_SSE2::FMorphologyErode>;
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_ERODE ][IMAGE_FORMAT_A8    ] = RasterOps_SSE2::FMorphology::doH_8 <RasterOps_SSE2::FMorphologyErode>;
+
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_DILATE][IMAGE_FORMAT_PRGB32] = RasterOps_SSE2::FMorphology::doH_32<RasterOps_SSE2::FMorphologyDilate>;
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_DILATE][IMAGE_FORMAT_XRGB32] = RasterOps_SSE2::FMorphology::doH_32<RasterOps_SSE2::FMorphologyDilate>;
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_DILATE][IMAGE_FORMAT_RGB24 ] = RasterOps_SSE2::FMorphology::doH_32<RasterOps_SSE2::FMorphologyDilate>;
+  filter.morphology.h[FE_MORPHOLOGY_TYPE_DILATE][IMAGE_FORMAT_A8    ] = RasterOps_SSE2::FMorphology::doH_8 <RasterOps_SSE2::FMorphologyDilate>;
+
+  filter.morphology.v[FE_MORPHOLOGY_TYPE_ERODE ] = RasterOps_SSE2::FMorphology::doV<RasterOps_SSE2::FMorphologyErode>;
+  filter.morphology.v[FE_MORPHOLOGY_TYPE_DILATE] = RasterOps_SSE2::FMorphology::doV<RasterOps_SSE2::FMorphologyDilate>;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - Turbulence]
+  // --------------------------------------------------------------------------
+
+  filter.turbulence[FE_TURBULENCE_TYPE_TURBULENCE   ] = RasterOps_SSE2::FTurbulence::doTurbulence<FE_TURBULENCE_TYPE_TURBULENCE>;
+  filter.turbulence[FE_TURBULENCE_TYPE_FRACTAL_NOISE] = RasterOps_SSE2::FTurbulence::doTurbulence<FE_TURBULENCE_TYPE_FRACTAL_NOISE>;
 }
 
 } // Fog namespace
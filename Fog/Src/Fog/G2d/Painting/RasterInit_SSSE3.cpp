@@ -0,0 +1,82 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+
+#include <Fog/G2d/Painting/RasterApi_p.h>
+#include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/RasterInit_p.h>
+
+#include <Fog/G2d/Painting/RasterOps_SSSE3/BaseConvert_p.h>
+#include <Fog/G2d/Painting/RasterOps_SSSE3/CompositeSrc_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void RasterOps_init_SSSE3(void)
+{
+  ApiRaster& api = _api_raster;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Convert - API]
+  // --------------------------------------------------------------------------
+
+  RasterConvertFuncs& convert = api.convert;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Convert - BSwap]
+  // --------------------------------------------------------------------------
+
+  convert.bswap[RASTER_BSWAP_24] = (ImageConverterBlitLineFunc)RasterOps_SSSE3::Convert::bswap_24;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Convert - ARGB32]
+  // --------------------------------------------------------------------------
+
+  convert.argb32_from[RASTER_FORMAT_RGB24_888_BS       ] = RasterOps_SSSE3::Convert::argb32_from_rgb24_888_bs;
+  convert.from_argb32[RASTER_FORMAT_RGB24_888_BS       ] = RasterOps_SSSE3::Convert::rgb24_888_bs_from_argb32;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - Src - PRGB32]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_PRGB32][RASTER_COMPOSITE_CORE_SRC];
+
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_RGB24    ], RasterOps_SSSE3::CompositeSrc::prgb32_vblit_rgb24_line);
+  }
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - Src - XRGB32]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_XRGB32][RASTER_COMPOSITE_CORE_SRC];
+
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_RGB24    ], RasterOps_SSSE3::CompositeSrc::prgb32_vblit_rgb24_line);
+  }
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - Src - RGB24]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_RGB24][RASTER_COMPOSITE_CORE_SRC];
+
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB32   ], RasterOps_SSSE3::CompositeSrc::rgb24_vblit_xrgb32_line);
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_XRGB32   ], RasterOps_SSSE3::CompositeSrc::rgb24_vblit_xrgb32_line);
+  }
+}
+
+} // Fog namespace
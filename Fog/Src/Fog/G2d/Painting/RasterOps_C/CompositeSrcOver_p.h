@@ -2005,6 +2005,136 @@ _ARGB32_Glyph_Mask:
 
     FOG_VBLIT_SPAN8_END()
   }
+
+  // ==========================================================================
+  // [A8 - CBlit - PRGB32 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL a8_cblit_prgb32_line(
+    uint8_t* dst, const RasterSolid* src, int w, const RasterClosure* closure)
+  {
+    FOG_BLIT_LOOP_8x1_INIT()
+
+    uint32_t sra0p = src->prgb32.a;
+    uint32_t inv0p;
+
+    Acc::p32Negate255SBW(inv0p, sra0p);
+
+    FOG_BLIT_LOOP_8x1_BEGIN(C_Opaque)
+      uint32_t dst0p;
+
+      Acc::p32Load1b(dst0p, dst);
+      Acc::p32MulDiv255SBW(dst0p, dst0p, inv0p);
+      Acc::p32Add(dst0p, dst0p, sra0p);
+      Acc::p32Store1b(dst, dst0p);
+
+      dst += 1;
+    FOG_BLIT_LOOP_8x1_END(C_Opaque)
+  }
+
+  // ==========================================================================
+  // [A8 - CBlit - PRGB32 - Span]
+  // ==========================================================================
+
+  static void FOG_FASTCALL a8_cblit_prgb32_span(
+    uint8_t* dst, const RasterSolid* src, const RasterSpan* span, const RasterClosure* closure)
+  {
+    uint32_t sra0p = src->prgb32.a;
+    uint32_t inv0p;
+
+    Acc::p32Negate255SBW(inv0p, sra0p);
+
+    FOG_CBLIT_SPAN8_BEGIN(1)
+
+    // ------------------------------------------------------------------------
+    // [C-Any]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_C_ANY()
+    {
+      FOG_BLIT_LOOP_8x1_INIT()
+
+      uint32_t src0p;
+      uint32_t srcInv0p;
+
+      Acc::p32Copy(src0p, sra0p);
+      Acc::p32Copy(srcInv0p, inv0p);
+
+      if (msk0 != 0x100)
+      {
+        Acc::p32MulDiv256SBW(src0p, src0p, msk0);
+        Acc::p32Negate255SBW(srcInv0p, src0p);
+      }
+
+      FOG_BLIT_LOOP_8x1_BEGIN(C_Any)
+        uint32_t dst0p;
+
+        Acc::p32Load1b(dst0p, dst);
+        Acc::p32MulDiv255SBW(dst0p, dst0p, srcInv0p);
+        Acc::p32Add(dst0p, dst0p, src0p);
+        Acc::p32Store1b(dst, dst0p);
+
+        dst += 1;
+      FOG_BLIT_LOOP_8x1_END(C_Any)
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_A8_OR_ARGB32_GLYPH()
+    {
+      FOG_BLIT_LOOP_8x1_INIT()
+
+      FOG_BLIT_LOOP_8x1_BEGIN(A8_Glyph)
+        uint32_t dst0p;
+        uint32_t src0p;
+        uint32_t msk0p;
+
+        Acc::p32Load1b(msk0p, msk);
+        Acc::p32Load1b(dst0p, dst);
+
+        Acc::p32Cvt256SBWFrom255SBW(msk0p, msk0p);
+        Acc::p32MulDiv256SBW(src0p, sra0p, msk0p);
+        Acc::p32Negate255SBW(msk0p, src0p);
+        Acc::p32MulDiv255SBW(dst0p, dst0p, msk0p);
+        Acc::p32Add(dst0p, dst0p, src0p);
+        Acc::p32Store1b(dst, dst0p);
+
+        dst += 1;
+        msk += MskSize;
+      FOG_BLIT_LOOP_8x1_END(A8_Glyph)
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Extra]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_A8_EXTRA()
+    {
+      FOG_BLIT_LOOP_8x1_INIT()
+
+      FOG_BLIT_LOOP_8x1_BEGIN(A8_Extra)
+        uint32_t dst0p;
+        uint32_t src0p;
+        uint32_t msk0p;
+
+        Acc::p32Load2a(msk0p, msk);
+        Acc::p32Load1b(dst0p, dst);
+
+        Acc::p32MulDiv256SBW(src0p, sra0p, msk0p);
+        Acc::p32Negate255SBW(msk0p, src0p);
+        Acc::p32MulDiv255SBW(dst0p, dst0p, msk0p);
+        Acc::p32Add(dst0p, dst0p, src0p);
+        Acc::p32Store1b(dst, dst0p);
+
+        dst += 1;
+        msk += 2;
+      FOG_BLIT_LOOP_8x1_END(A8_Extra)
+    }
+
+    FOG_CBLIT_SPAN8_END()
+  }
 };
 
 } // RasterOps_C namespace
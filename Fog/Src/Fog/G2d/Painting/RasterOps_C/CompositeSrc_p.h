@@ -4702,7 +4702,7 @@ _ARGB32_Glyph_Skip:
 
     Acc::p32ExtendPBBFromSBB(sro0p, sra0p);
 
-    FOG_CBLIT_SPAN8_BEGIN(4)
+    FOG_CBLIT_SPAN8_BEGIN(1)
 
     // ------------------------------------------------------------------------
     // [C-Opaque]
@@ -4756,8 +4756,8 @@ _ARGB32_Glyph_Skip:
       FOG_BLIT_LOOP_8x8_MAIN_BEGIN(C_Mask)
         uint32_t dst0p, dst1p;
 
-        Acc::p32Load4a(dst0p, dst);
-        Acc::p32Load4a(dst1p, dst);
+        Acc::p32Load4a(dst0p, dst + 0);
+        Acc::p32Load4a(dst1p, dst + 4);
 
         Acc::p32MulDiv256PBB_SBW(dst0p, dst0p, msk0p);
         Acc::p32MulDiv256PBB_SBW(dst1p, dst1p, msk0p);
@@ -4781,6 +4781,7 @@ _ARGB32_Glyph_Skip:
 
       FOG_BLIT_LOOP_8x1_BEGIN(A8_Glyph)
         uint32_t dst0p;
+        uint32_t src0p;
         uint32_t msk0p;
 
         Acc::p32Load1b(msk0p, msk);
@@ -4788,10 +4789,10 @@ _ARGB32_Glyph_Skip:
 
         Acc::p32Load1b(dst0p, dst);
         Acc::p32Cvt256SBWFrom255SBW(msk0p, msk0p);
-        Acc::p32MulDiv256SBW(dst0p, dst0p, msk0p);
+        Acc::p32MulDiv256SBW(src0p, sra0p, msk0p);
         Acc::p32Negate256SBW(msk0p, msk0p);
-        Acc::p32MulDiv256SBW(msk0p, msk0p, sra0p);
-        Acc::p32Add(dst0p, dst0p, msk0p);
+        Acc::p32MulDiv256SBW(dst0p, dst0p, msk0p);
+        Acc::p32Add(dst0p, dst0p, src0p);
         Acc::p32Store1b(dst, dst0p);
 
 _A8_Glyph_Skip:
@@ -4810,15 +4811,16 @@ _A8_Glyph_Skip:
 
       FOG_BLIT_LOOP_8x1_BEGIN(A8_Extra)
         uint32_t dst0p;
+        uint32_t src0p;
         uint32_t msk0p;
 
         Acc::p32Load2a(msk0p, msk);
         Acc::p32Load1b(dst0p, dst);
 
-        Acc::p32MulDiv256SBW(dst0p, dst0p, msk0p);
+        Acc::p32MulDiv256SBW(src0p, sra0p, msk0p);
         Acc::p32Negate256SBW(msk0p, msk0p);
-        Acc::p32MulDiv256SBW(msk0p, msk0p, sra0p);
-        Acc::p32Add(dst0p, dst0p, msk0p);
+        Acc::p32MulDiv256SBW(dst0p, dst0p, msk0p);
+        Acc::p32Add(dst0p, dst0p, src0p);
         Acc::p32Store1b(dst, dst0p);
 
         dst += 1;
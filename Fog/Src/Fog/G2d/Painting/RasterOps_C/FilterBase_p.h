@@ -203,6 +203,474 @@ struct FOG_NO_EXPORT FBaseAccessor_A8
   }
 };
 
+// ============================================================================
+// [Fog::RasterOps_C - Filter - Base - Color]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Base of the color filters (color LUT, color matrix and component
+//! transfer), which don't access neighbor pixels, so the filter is applied by
+//! calling @c RasterFilter::doLine() for each scanline.
+struct FOG_NO_EXPORT FColorBase
+{
+  // ==========================================================================
+  // [Color - Destroy]
+  // ==========================================================================
+
+  static void FOG_FASTCALL destroy(
+    RasterFilter* ctx)
+  {
+    // Just be safe and detect possible NULL pointer dereference.
+    ctx->destroy = NULL;
+    ctx->doRect = NULL;
+    ctx->doLine = NULL;
+  }
+
+  // ==========================================================================
+  // [Color - DoRect]
+  // ==========================================================================
+
+  static err_t FOG_FASTCALL doRect(
+    RasterFilter* ctx,
+    RasterFilterImage* dst, const PointI* dstPos,
+    RasterFilterImage* src, const RectI* srcRect,
+    MemBuffer* intermediateBuffer)
+  {
+    FOG_ASSERT(srcRect->x >= 0);
+    FOG_ASSERT(srcRect->y >= 0);
+    FOG_ASSERT(srcRect->x + srcRect->w <= src->size.w);
+    FOG_ASSERT(srcRect->y + srcRect->h <= src->size.h);
+
+    ssize_t dstBpp = ImageFormatDescription::getByFormat(ctx->dstFormat).getBytesPerPixel();
+    ssize_t srcBpp = ImageFormatDescription::getByFormat(ctx->srcFormat).getBytesPerPixel();
+
+    uint8_t* dstPixels;
+    ssize_t dstStride;
+
+    // Create intermediate buffer in case that dst->data is NULL.
+    if (dst->data == NULL)
+    {
+      dstStride = (ssize_t)srcRect->w * dstBpp;
+      dstPixels = reinterpret_cast<uint8_t*>(intermediateBuffer->alloc((size_t)srcRect->h * (size_t)dstStride));
+
+      if (FOG_IS_NULL(dstPixels))
+        return ERR_RT_OUT_OF_MEMORY;
+
+      // And initialize the destination buffer so the caller can use the data.
+      dst->data = dstPixels;
+      dst->stride = dstStride;
+    }
+    else
+    {
+      dstStride = dst->stride;
+      dstPixels = dst->data + dstPos->y * dstStride + dstPos->x * dstBpp;
+    }
+
+    ssize_t srcStride = src->stride;
+    const uint8_t* srcPixels = src->data + srcRect->y * srcStride + srcRect->x * srcBpp;
+
+    RasterFilterDoLineFunc doLine = ctx->doLine;
+    int w = srcRect->w;
+
+    for (int i = srcRect->h; i; i--, dstPixels += dstStride, srcPixels += srcStride)
+      doLine(ctx, dstPixels, srcPixels, w);
+
+    return ERR_OK;
+  }
+
+  // ==========================================================================
+  // [Color - Copy]
+  // ==========================================================================
+
+  template<typename Accessor>
+  static void FOG_FASTCALL copy(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    // The filter is often applied in-place, there is nothing to do then.
+    if (dst != src)
+      MemOps::copy(dst, src, (size_t)(uint)w * Accessor::PIXEL_BPP);
+  }
+
+  // ==========================================================================
+  // [Color - Alpha Lookup]
+  // ==========================================================================
+
+  //! @brief Replace the alpha of PRGB32 pixels by @a lut[alpha], keeping the
+  //! non-premultiplied color.
+  static FOG_INLINE void lookupAlpha_PRGB32(
+    uint8_t* dst, const uint8_t* src, int w, const uint8_t* lut)
+  {
+    for (int i = w; i; i--, dst += 4, src += 4)
+    {
+      uint32_t c0;
+      Acc::p32Load4a(c0, src);
+
+      uint32_t a0 = c0 >> 24;
+      uint32_t b0 = lut[a0];
+
+      if (a0 != b0)
+      {
+        // Fully transparent pixel has no color, the result is black.
+        if (a0 == 0)
+        {
+          c0 = b0 << 24;
+        }
+        else
+        {
+          Acc::p32ARGB32FromPRGB32(c0, c0);
+          c0 = (c0 & 0x00FFFFFF) | (b0 << 24);
+          Acc::p32PRGB32FromARGB32(c0, c0);
+        }
+      }
+
+      Acc::p32Store4a(dst, c0);
+    }
+  }
+
+  static FOG_INLINE void lookupAlpha_A8(
+    uint8_t* dst, const uint8_t* src, int w, const uint8_t* lut)
+  {
+    for (int i = w; i; i--, dst++, src++)
+      dst[0] = lut[src[0]];
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - Base - Border]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Maximum size of rows (in bytes) held by the border filters at the
+//! same time, used to split the filtered rectangle into vertical tiles.
+enum { BORDER_CACHE_SIZE = 128 * 1024 };
+
+//! @internal
+//!
+//! @brief Base of the filters which access neighbor pixels (convolution and
+//! morphology).
+//!
+//! These filters work on rows converted to a working format, which is the
+//! 32-bit pixel layout for PRGB32, XRGB32 and RGB24 and A8 for A8. The rows
+//! are fetched including the border pixels, which are outside of the source
+//! image, extended by @c FE_EXTEND.
+struct FOG_NO_EXPORT FBorderBase
+{
+  // ==========================================================================
+  // [Border - Format]
+  // ==========================================================================
+
+  //! @brief Get bytes per pixel of the working format.
+  static FOG_INLINE int getWorkBpp(uint32_t format)
+  {
+    return format == IMAGE_FORMAT_A8 ? 1 : 4;
+  }
+
+  // ==========================================================================
+  // [Border - Extend]
+  // ==========================================================================
+
+  //! @brief Initialize the extend color of @a feBorder (premultiplied).
+  static FOG_INLINE void initExtendColor(RasterSolid& dst, const FeBorder* feBorder)
+  {
+    Argb32 argb32 = feBorder->_extendColor().getArgb32();
+
+    dst.reset();
+    Acc::p32PRGB32FromARGB32(dst.prgb32.u32, argb32.u32);
+  }
+
+  //! @brief Get the extend color in the working format of @a format.
+  static FOG_INLINE uint32_t getExtendPixel(const RasterSolid& color, uint32_t format)
+  {
+    return format == IMAGE_FORMAT_A8 ? (uint32_t)color.prgb32.a : color.prgb32.u32;
+  }
+
+  //! @brief Map the coordinate @a x to [0, size).
+  //!
+  //! Returns @c -1 if the extend color should be used instead.
+  static FOG_INLINE int extendCoord(int x, int size, uint32_t extendType)
+  {
+    if ((uint)x < (uint)size)
+      return x;
+
+    switch (extendType)
+    {
+      case FE_EXTEND_PAD:
+        return x < 0 ? 0 : size - 1;
+
+      case FE_EXTEND_REPEAT:
+        x %= size;
+        if (x < 0)
+          x += size;
+        return x;
+
+      case FE_EXTEND_REFLECT:
+      {
+        int period = size * 2;
+
+        x %= period;
+        if (x < 0)
+          x += period;
+        if (x >= size)
+          x = period - 1 - x;
+        return x;
+      }
+
+      default:
+        return -1;
+    }
+  }
+
+  // ==========================================================================
+  // [Border - Fetch]
+  // ==========================================================================
+
+  //! @brief Fetch a single pixel @a x of @a srcRow to the working format.
+  static FOG_INLINE void fetchPixel(uint8_t* dst, const uint8_t* srcRow, int x, uint32_t format)
+  {
+    uint32_t c0;
+
+    switch (format)
+    {
+      case IMAGE_FORMAT_PRGB32:
+      case IMAGE_FORMAT_XRGB32:
+        Acc::p32Load4a(c0, srcRow + x * 4);
+        Acc::p32Store4a(dst, c0);
+        break;
+
+      case IMAGE_FORMAT_RGB24:
+        Acc::p32Load3b(c0, srcRow + x * 3);
+        Acc::p32Store4a(dst, c0 | 0xFF000000);
+        break;
+
+      case IMAGE_FORMAT_A8:
+        dst[0] = srcRow[x];
+        break;
+
+      default:
+        FOG_ASSERT_NOT_REACHED();
+    }
+  }
+
+  //! @brief Fill @a w pixels of the working format by @a pixel.
+  static FOG_INLINE void fillRow(uint8_t* dst, int w, uint32_t format, uint32_t pixel)
+  {
+    if (format == IMAGE_FORMAT_A8)
+    {
+      MemOps::set(dst, (uint8_t)pixel, (size_t)(uint)w);
+    }
+    else
+    {
+      for (int i = w; i; i--, dst += 4)
+        Acc::p32Store4a(dst, pixel);
+    }
+  }
+
+  //! @brief Fetch @a w pixels of @a srcRow starting at @a x to the working
+  //! format, the pixels outside of [0, srcW) are extended.
+  static void fetchRow(uint8_t* dst, const uint8_t* srcRow, int x, int w, int srcW,
+    uint32_t format, uint32_t extendType, uint32_t extendPixel)
+  {
+    int workBpp = getWorkBpp(format);
+    int i;
+
+    // Leading border.
+    while (w > 0 && x < 0)
+    {
+      i = extendCoord(x, srcW, extendType);
+      if (i < 0)
+        fillRow(dst, 1, format, extendPixel);
+      else
+        fetchPixel(dst, srcRow, i, format);
+
+      dst += workBpp;
+      x++;
+      w--;
+    }
+
+    // Inner pixels.
+    i = Math::min(w, srcW - x);
+    if (i > 0)
+    {
+      switch (format)
+      {
+        case IMAGE_FORMAT_PRGB32:
+        case IMAGE_FORMAT_XRGB32:
+          MemOps::copy(dst, srcRow + x * 4, (size_t)(uint)i * 4);
+          dst += i * 4;
+          break;
+
+        case IMAGE_FORMAT_RGB24:
+        {
+          const uint8_t* src = srcRow + x * 3;
+
+          for (int j = i; j; j--, dst += 4, src += 3)
+          {
+            uint32_t c0;
+            Acc::p32Load3b(c0, src);
+            Acc::p32Store4a(dst, c0 | 0xFF000000);
+          }
+          break;
+        }
+
+        case IMAGE_FORMAT_A8:
+          MemOps::copy(dst, srcRow + x, (size_t)(uint)i);
+          dst += i;
+          break;
+
+        default:
+          FOG_ASSERT_NOT_REACHED();
+      }
+
+      x += i;
+      w -= i;
+    }
+
+    // Trailing border.
+    while (w > 0)
+    {
+      i = extendCoord(x, srcW, extendType);
+      if (i < 0)
+        fillRow(dst, 1, format, extendPixel);
+      else
+        fetchPixel(dst, srcRow, i, format);
+
+      dst += workBpp;
+      x++;
+      w--;
+    }
+  }
+
+  // ==========================================================================
+  // [Border - Store]
+  // ==========================================================================
+
+  //! @brief Store @a w pixels of the working format to @a dst.
+  //!
+  //! The color components of PRGB32 pixels are bound to the alpha so the
+  //! result is always a valid premultiplied pixel.
+  static void storeRow(uint8_t* dst, const uint8_t* src, int w, uint32_t format)
+  {
+    int i;
+
+    switch (format)
+    {
+      case IMAGE_FORMAT_PRGB32:
+        for (i = w; i; i--, dst += 4, src += 4)
+        {
+          uint32_t c0;
+          Acc::p32Load4a(c0, src);
+
+          uint32_t a = c0 >> 24;
+          uint32_t r = Math::min<uint32_t>((c0 >> 16) & 0xFF, a);
+          uint32_t g = Math::min<uint32_t>((c0 >>  8) & 0xFF, a);
+          uint32_t b = Math::min<uint32_t>((c0      ) & 0xFF, a);
+
+          c0 = _FOG_ACC_COMBINE_4(a << 24, r << 16, g << 8, b);
+          Acc::p32Store4a(dst, c0);
+        }
+        break;
+
+      case IMAGE_FORMAT_XRGB32:
+        for (i = w; i; i--, dst += 4, src += 4)
+        {
+          uint32_t c0;
+          Acc::p32Load4a(c0, src);
+          Acc::p32Store4a(dst, c0 | 0xFF000000);
+        }
+        break;
+
+      case IMAGE_FORMAT_RGB24:
+        for (i = w; i; i--, dst += 3, src += 4)
+        {
+          uint32_t c0;
+          Acc::p32Load4a(c0, src);
+          Acc::p32Store3b(dst, c0);
+        }
+        break;
+
+      case IMAGE_FORMAT_A8:
+        MemOps::copy(dst, src, (size_t)(uint)w);
+        break;
+
+      default:
+        FOG_ASSERT_NOT_REACHED();
+    }
+  }
+
+  // ==========================================================================
+  // [Border - Destination]
+  // ==========================================================================
+
+  //! @brief Get the destination pixels of the filter.
+  //!
+  //! The intermediate buffer is used if @a dst doesn't contain data or if the
+  //! filter is applied in-place (the source pixels must be kept until they
+  //! are no longer needed), @a copyBack is set to true in the second case
+  //! and @c finishDst() must be called after the filter is done.
+  static err_t prepareDst(
+    RasterFilterImage* dst, const PointI* dstPos,
+    const RasterFilterImage* src, const RectI* srcRect,
+    uint32_t dstFormat, MemBuffer* intermediateBuffer,
+    uint8_t*& dstPixels, ssize_t& dstStride, bool& copyBack)
+  {
+    ssize_t dstBpp = ImageFormatDescription::getByFormat(dstFormat).getBytesPerPixel();
+
+    copyBack = dst->data != NULL && dst->data == src->data;
+
+    if (dst->data == NULL || copyBack)
+    {
+      dstStride = (ssize_t)srcRect->w * dstBpp;
+      dstPixels = reinterpret_cast<uint8_t*>(intermediateBuffer->alloc((size_t)srcRect->h * (size_t)dstStride));
+
+      if (FOG_IS_NULL(dstPixels))
+        return ERR_RT_OUT_OF_MEMORY;
+
+      // And initialize the destination buffer so the caller can use the data.
+      if (!copyBack)
+      {
+        dst->data = dstPixels;
+        dst->stride = dstStride;
+      }
+    }
+    else
+    {
+      dstStride = dst->stride;
+      dstPixels = dst->data + dstPos->y * dstStride + dstPos->x * dstBpp;
+    }
+
+    return ERR_OK;
+  }
+
+  //! @brief Copy the intermediate buffer to @a dst if @c prepareDst() set
+  //! @a copyBack.
+  static void finishDst(
+    RasterFilterImage* dst, const PointI* dstPos, const RectI* srcRect,
+    uint32_t dstFormat, const uint8_t* pixels, ssize_t stride, bool copyBack)
+  {
+    if (!copyBack)
+      return;
+
+    ssize_t dstBpp = ImageFormatDescription::getByFormat(dstFormat).getBytesPerPixel();
+    ssize_t dstStride = dst->stride;
+    uint8_t* dstPixels = dst->data + dstPos->y * dstStride + dstPos->x * dstBpp;
+
+    size_t size = (size_t)srcRect->w * (size_t)dstBpp;
+
+    for (int i = srcRect->h; i; i--, dstPixels += dstStride, pixels += stride)
+      MemOps::copy(dstPixels, pixels, size);
+  }
+
+  //! @brief Get the width of a vertical tile of the filtered rectangle so
+  //! that @a rows rows of @a bytesPerPixel fit to @c BORDER_CACHE_SIZE.
+  static FOG_INLINE int getTileWidth(int w, int rows, int bytesPerPixel)
+  {
+    int tileW = BORDER_CACHE_SIZE / Math::max(rows * bytesPerPixel, 1);
+    return Math::min(w, Math::max(tileW, 64));
+  }
+};
+
 } // RasterOps_C namespace
 } // Fog namespace
 
@@ -8,6 +8,9 @@
 #define _FOG_G2D_PAINTING_RASTEROPS_C_FILTERBLUR_P_H
 
 // [Dependencies]
+#include <Fog/Core/Kernel/Task.h>
+#include <Fog/Core/Threading/TaskScheduler.h>
+#include <Fog/Core/Tools/Cpu.h>
 #include <Fog/G2d/Painting/RasterOps_C/FilterBase_p.h>
 
 namespace Fog {
@@ -64,7 +67,8 @@ namespace RasterOps_C {
 // used (aBorderSize, aTableSize, ...). For final processing the prefix 'b' is
 // used (bBorderSize, bTableSize, ...).
 //
-// For SSE2 version please see RasterOps_SSE2 directory.
+// For SSE2 version please see RasterOps_SSE2 directory, it reuses these loops
+// with accessors which keep all channels of a run in one register.
 
 // How many pixels to process horizontally in BlurV. The problem here is that
 // when using the standard way (1 pixel per run) then there is unpredictable
@@ -83,6 +87,15 @@ enum { BLUR_APREC = 12 };
 // Z-Precision of state parameter in exponential blur (fixed point 8.Z).
 enum { BLUR_ZPREC = 10 };
 
+// Minimum count of pixels blurred by one thread. Rows (horizontal pass) and
+// columns (vertical pass) are independent, so large images are split into
+// parts processed by TaskScheduler workers, but the parts are worth it only
+// if each of them gets enough work.
+enum { BLUR_THREAD_MIN_PIXELS = 256 * 256 };
+
+// Maximum count of parts (threads) used to blur one image.
+enum { BLUR_THREAD_MAX_COUNT = 8 };
+
 // ============================================================================
 // [Fog::RasterOps_C - Filter - Blur - Run - PRGB32]
 // ============================================================================
@@ -767,6 +780,30 @@ struct FOG_NO_EXPORT FBlurExpAccessor_A8 : public FBlurBaseAccessor_A8<int32_t>
   }
 };
 
+// ============================================================================
+// [Fog::RasterOps_C - Filter - Blur - Parallel]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Blur pass split into more parts, processed by @c TaskScheduler.
+struct FOG_NO_EXPORT FBlurParallelContext
+{
+  //! @brief Process the parts [@a start, @a end).
+  static void FOG_CDECL run(void* closure, size_t start, size_t end)
+  {
+    FBlurParallelContext* ctx = static_cast<FBlurParallelContext*>(closure);
+
+    for (size_t i = start; i < end; i++)
+      ctx->func(&ctx->parts[i]);
+  }
+
+  //! @brief Horizontal or vertical blur function.
+  RasterFilterDoBlurFunc func;
+  //! @brief Parts, each uses its own stack.
+  RasterFilterBlur* parts;
+};
+
 // ============================================================================
 // [Fog::RasterOps_C - Filter - Blur]
 // ============================================================================
@@ -923,6 +960,10 @@ struct FOG_NO_EXPORT FBlur
     int tLeft, tRight;
     int tBegin, tEnd;
 
+    int threadLimit;
+    int threadCount;
+    size_t stackSize;
+
     // ------------------------------------------------------------------------
     // [Base]
     // ------------------------------------------------------------------------
@@ -943,6 +984,9 @@ struct FOG_NO_EXPORT FBlur
         return ERR_RT_OUT_OF_MEMORY;
     }
 
+    // Large images are blurred by more threads, see doPass().
+    threadLimit = getThreadCount(srcRect->w, srcRect->h + extendTop + extendBottom);
+
     // Move closer.
     blurCtx.extendType = ctx->blur.extendType;
     blurCtx.extendColor.prgb64.p64 = ctx->blur.extendColor.prgb64.p64;
@@ -993,7 +1037,7 @@ struct FOG_NO_EXPORT FBlur
       blurCtx.aTableSize   = kernelSize;
       blurCtx.bTableSize   = Math::min<int>(srcRect->w - blurCtx.runSize, kernelRadius);
 
-      tRight += int(blurCtx.runSize);
+      tRight += int(blurCtx.runSize) + kernelRadius;
       initRunBox(&blurCtx, tLeft, tBegin, tEnd);
 
       FOG_ASSERT(blurCtx.aTableSize + blurCtx.aBorderLeadSize + blurCtx.aBorderTailSize == kernelSize);
@@ -1018,8 +1062,11 @@ struct FOG_NO_EXPORT FBlur
     blurCtx.srcFirstOffset = 0;
     blurCtx.srcLastOffset  = (src->size.w - 1) * (int)srcDesc.getBytesPerPixel();
 
+    threadCount = Math::min<int>(threadLimit, int(blurCtx.rowSize));
+    stackSize = kernelSize * stackBpp;
+
     if (memBuffer->alloc((blurCtx.aTableSize + blurCtx.bTableSize) * sizeof(ssize_t) + 
-                         (kernelSize * stackBpp)) == NULL)
+                         stackSize * threadCount) == NULL)
     {
       return ERR_RT_OUT_OF_MEMORY;
     }
@@ -1043,7 +1090,8 @@ struct FOG_NO_EXPORT FBlur
     //   blurCtx.bBorderTailSize);
 
     initRunTables(&blurCtx, tLeft, tRight, tBegin, tEnd, srcDesc.getBytesPerPixel());
-    ctx->blur.hConvolve(&blurCtx);
+    doPass(ctx->blur.hConvolve, &blurCtx, threadCount, stackSize,
+      blurCtx.dstStride, blurCtx.srcStride, 1);
 
     // ------------------------------------------------------------------------
     // [Vertical]
@@ -1103,7 +1151,7 @@ struct FOG_NO_EXPORT FBlur
       blurCtx.aTableSize   = kernelSize;
       blurCtx.bTableSize   = Math::min<int>(srcRect->h - blurCtx.runSize, kernelRadius);
 
-      tRight += int(blurCtx.runSize);
+      tRight += int(blurCtx.runSize) + kernelRadius;
       initRunBox(&blurCtx, tLeft, tBegin, tEnd);
 
       FOG_ASSERT(blurCtx.aTableSize + blurCtx.aBorderLeadSize + blurCtx.aBorderTailSize == kernelSize);
@@ -1128,8 +1176,14 @@ struct FOG_NO_EXPORT FBlur
     blurCtx.srcFirstOffset = 0;
     blurCtx.srcLastOffset  = (srcRect->h - 1 + extendTop + extendBottom) * blurCtx.srcStride;
 
+    // Columns are processed in groups of BLUR_RECT_V_HLINE_COUNT, don't split
+    // them.
+    threadCount = Math::min<int>(threadLimit,
+      int((blurCtx.rowSize + BLUR_RECT_V_HLINE_COUNT - 1) / BLUR_RECT_V_HLINE_COUNT));
+    stackSize = kernelSize * stackBpp * BLUR_RECT_V_HLINE_COUNT;
+
     if (memBuffer->alloc((blurCtx.aTableSize + blurCtx.bTableSize) * sizeof(ssize_t) +
-                         (kernelSize * stackBpp) * BLUR_RECT_V_HLINE_COUNT) == NULL)
+                         stackSize * threadCount) == NULL)
     {
       return ERR_RT_OUT_OF_MEMORY;
     }
@@ -1153,10 +1207,76 @@ struct FOG_NO_EXPORT FBlur
     //   blurCtx.bBorderTailSize);
 
     initRunTables(&blurCtx, tLeft, tRight, tBegin, tEnd, blurCtx.srcStride);
-    ctx->blur.vConvolve(&blurCtx);
+    doPass(ctx->blur.vConvolve, &blurCtx, threadCount, stackSize,
+      (int)dstDesc.getBytesPerPixel(), (int)dstDesc.getBytesPerPixel(), BLUR_RECT_V_HLINE_COUNT);
     return ERR_OK;
   }
 
+  // ==========================================================================
+  // [Blur - Parallel]
+  // ==========================================================================
+
+  //! @brief Get count of parts which should be used to blur @a w x @a h
+  //! pixels.
+  static int FOG_FASTCALL getThreadCount(int w, int h)
+  {
+    uint64_t size = (uint64_t)(uint)w * (uint)h;
+
+    // Workers of the task scheduler and the current thread.
+    int count = TaskScheduler::get()->getMaxWorkers() + 1;
+    count = (int)Math::min<uint64_t>((uint64_t)count, size / BLUR_THREAD_MIN_PIXELS);
+    count = Math::min<int>(count, BLUR_THREAD_MAX_COUNT);
+
+    return Math::max<int>(count, 1);
+  }
+
+  //! @brief Run the blur function @a func, possibly split into @a count
+  //! parts processed in parallel.
+  //!
+  //! The rows (or columns) described by @a blurCtx are split into @a count
+  //! parts, each part uses its own stack (@a stackSize bytes after the stack
+  //! of the previous part). The @a dstAdvance and @a srcAdvance is a distance
+  //! between two rows (or columns) and @a granularity is a count of rows (or
+  //! columns) which can't be split.
+  static void FOG_FASTCALL doPass(
+    RasterFilterDoBlurFunc func, RasterFilterBlur* blurCtx, int count, size_t stackSize,
+    ssize_t dstAdvance, ssize_t srcAdvance, uint granularity)
+  {
+    if (count <= 1)
+    {
+      func(blurCtx);
+      return;
+    }
+
+    RasterFilterBlur parts[BLUR_THREAD_MAX_COUNT];
+    FBlurParallelContext parallel;
+
+    parallel.func = func;
+    parallel.parts = parts;
+
+    uint groups = (blurCtx->rowSize + granularity - 1) / granularity;
+    int i;
+
+    FOG_ASSERT(count <= BLUR_THREAD_MAX_COUNT);
+    FOG_ASSERT(uint(count) <= groups);
+
+    for (i = 0; i < count; i++)
+    {
+      uint r0 = Math::min<uint>(groups * uint(i    ) / uint(count) * granularity, blurCtx->rowSize);
+      uint r1 = Math::min<uint>(groups * uint(i + 1) / uint(count) * granularity, blurCtx->rowSize);
+
+      parts[i] = *blurCtx;
+      parts[i].dstData += (ssize_t)r0 * dstAdvance;
+      parts[i].srcData += (ssize_t)r0 * srcAdvance;
+      parts[i].rowSize = r1 - r0;
+      parts[i].stack += stackSize * (uint)i;
+    }
+
+    // The current thread processes some parts as well, the scheduler falls
+    // back to the current thread if there are no workers.
+    TaskScheduler::get()->parallelFor(0, (size_t)count, 1, FBlurParallelContext::run, &parallel);
+  }
+
   // ==========================================================================
   // [Blur - InitRun]
   // ==========================================================================
@@ -1250,9 +1370,7 @@ struct FOG_NO_EXPORT FBlur
       if (tLeft < 0)
         tLeft += tRepeat;
 
-      if (tRight >= tEnd)
-        tRight -= tRepeat;
-      FOG_ASSERT(tRight < tEnd);
+      tRight %= tRepeat;
 
       // Add tBegin back so we don't need to do in loops.
       tLeft += tBegin;
@@ -1283,21 +1401,18 @@ struct FOG_NO_EXPORT FBlur
       if (tLeft < 0)
         tLeft += tRepeat2;
 
-      tRight += blurCtx->runSize;
-      if (tRight >= tRepeat2)
-        tRight -= tRepeat2;
-      FOG_ASSERT(tRight < tRepeat2);
+      tRight %= tRepeat2;
 
       for (i = 0; i < blurCtx->aTableSize; i++)
       {
-        blurCtx->aTableData[i] = ((tLeft < tRepeat ? tLeft : tRepeat2 - tLeft) + tBegin) * tScale;
-        if (++tLeft > tRepeat2)
+        blurCtx->aTableData[i] = ((tLeft < tRepeat ? tLeft : tRepeat2 - 1 - tLeft) + tBegin) * tScale;
+        if (++tLeft >= tRepeat2)
           tLeft = 0;
       }
 
       for (i = 0; i < blurCtx->bTableSize; i++)
       {
-        blurCtx->bTableData[i] = ((tRight < tRepeat ? tRight : tRepeat2 - tRight) + tBegin) * tScale;
+        blurCtx->bTableData[i] = ((tRight < tRepeat ? tRight : tRepeat2 - 1 - tRight) + tBegin) * tScale;
         if (++tRight >= tRepeat2)
           tRight = 0;
       }
@@ -2039,6 +2154,11 @@ _First:
 
       stackA = stackBuf;
       stackB = stackBuf + (kernelRadius + 1) * Accessor::STACK_BPP;
+
+      // The stack contains only one pixel if the radius is zero.
+      if (stackB == stackEnd)
+        stackB = stackBuf;
+
       srcPtr += blurCtx->runOffset;
 
       i = runSize;
@@ -2110,7 +2230,6 @@ _First:
         runB.add(cmp0);
         runA.sub(cmp0);
 
-        srcPtr += Accessor::PIXEL_BPP;
         stackA += Accessor::STACK_BPP;
         stackB += Accessor::STACK_BPP;
 
@@ -2160,7 +2279,6 @@ _First:
           runB.add(cmp0);
           runA.sub(cmp0);
 
-          srcPtr += Accessor::PIXEL_BPP;
           stackA += Accessor::STACK_BPP;
           stackB += Accessor::STACK_BPP;
 
@@ -2287,6 +2405,7 @@ _First:
           uint8_t* srcBase = srcPtr + blurCtx->srcFirstOffset;
           uint8_t* stackBase = stackA;
 
+          pos += i;
           for (x = 0; x < xLength; x++)
           {
             FOG_ASSERT(stackA < stackEnd);
@@ -2415,6 +2534,11 @@ _First:
 
       stackA = stackBuf;
       stackB = stackBuf + (kernelRadius + 1) * xLength * Accessor::STACK_BPP;
+
+      // The stack contains only one pixel if the radius is zero.
+      if (stackB == stackEnd)
+        stackB = stackBuf;
+
       srcPtr += blurCtx->runOffset;
 
       for (x = 0; x < xLength; x++)
@@ -2489,7 +2613,6 @@ _First:
           runA[x].sub(cmp0);
 
           Accessor::storeRunM(dstPtr + x * Accessor::PIXEL_BPP, run[x], sumMul, sumShr);
-          srcPtr += Accessor::PIXEL_BPP;
           stackA += Accessor::STACK_BPP;
           stackB += Accessor::STACK_BPP;
         }
@@ -2537,7 +2660,6 @@ _First:
               runA[x].sub(cmp0);
 
               Accessor::storeRunM(dstPtr + x * Accessor::PIXEL_BPP, run[x], sumMul, sumShr);
-              srcPtr += Accessor::PIXEL_BPP;
               stackA += Accessor::STACK_BPP;
               stackB += Accessor::STACK_BPP;
             }
@@ -2576,7 +2698,6 @@ _First:
 
               Accessor::storeRunM(dstPtr + x * Accessor::PIXEL_BPP, run[x], sumMul, sumShr);
 
-              srcPtr += Accessor::PIXEL_BPP;
               stackA += Accessor::STACK_BPP;
               stackB += Accessor::STACK_BPP;
             }
@@ -0,0 +1,174 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCOLORLUT_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCOLORLUT_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_C/FilterBase_p.h>
+
+namespace Fog {
+namespace RasterOps_C {
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - ColorLut]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Color LUT filter.
+//!
+//! The lookup tables are applied to non-premultiplied components, so PRGB32
+//! pixels are demultiplied, looked-up and premultiplied again. The alpha-only
+//! case (RGB tables are identity) and the identity are detected when the
+//! filter is created.
+struct FOG_NO_EXPORT FColorLut
+{
+  // ==========================================================================
+  // [ColorLut - Create]
+  // ==========================================================================
+
+  static err_t FOG_FASTCALL create(
+    RasterFilter* ctx, const FeBase* feBase, const ImageFilterScaleD* feScale,
+    MemBuffer* memBuffer,
+    uint32_t dstFormat,
+    uint32_t srcFormat)
+  {
+    FOG_ASSERT(feBase->getFeType() == FE_TYPE_COLOR_LUT);
+    const FeColorLut* feData = static_cast<const FeColorLut*>(feBase);
+
+    for (uint32_t i = 0; i < COLOR_INDEX_COUNT; i++)
+      MemOps::copy(ctx->colorLut.table[i], feData->c[i]().getData(), 256);
+
+    return init(ctx, memBuffer, dstFormat, srcFormat);
+  }
+
+  //! @brief Initialize the filter context once the lookup tables are filled
+  //! (shared with the component transfer filter).
+  static err_t FOG_INLINE init(
+    RasterFilter* ctx,
+    MemBuffer* memBuffer,
+    uint32_t dstFormat,
+    uint32_t srcFormat)
+  {
+    // TODO: We should allow to mix some basic formats in the future.
+    if (dstFormat != srcFormat || dstFormat >= IMAGE_FORMAT_COUNT)
+      return ERR_IMAGE_INVALID_FORMAT;
+
+    const ImageFormatDescription& desc = ImageFormatDescription::getByFormat(dstFormat);
+
+    bool isAlphaIdentity = desc.getASize() == 0 ||
+      FeColorLutArray::isIdentity(ctx->colorLut.table[COLOR_INDEX_ALPHA]);
+
+    bool isRgbIdentity = desc.getRSize() == 0 || (
+      FeColorLutArray::isIdentity(ctx->colorLut.table[COLOR_INDEX_RED  ]) &&
+      FeColorLutArray::isIdentity(ctx->colorLut.table[COLOR_INDEX_GREEN]) &&
+      FeColorLutArray::isIdentity(ctx->colorLut.table[COLOR_INDEX_BLUE ]) );
+
+    RasterFilterDoLineFunc doLine;
+
+    if (isRgbIdentity && isAlphaIdentity)
+      doLine = _api_raster.filter.copy[dstFormat];
+    else if (isRgbIdentity)
+      doLine = _api_raster.filter.colorLut.alpha[dstFormat];
+    else
+      doLine = _api_raster.filter.colorLut.argb[dstFormat];
+
+    if (doLine == NULL)
+      return ERR_IMAGE_INVALID_FORMAT;
+
+    ctx->reference.init(1);
+    ctx->destroy = FColorBase::destroy;
+
+    ctx->doRect = FColorBase::doRect;
+    ctx->doLine = doLine;
+
+    ctx->memBuffer = memBuffer;
+    ctx->dstFormat = dstFormat;
+    ctx->srcFormat = srcFormat;
+
+    return ERR_OK;
+  }
+
+  // ==========================================================================
+  // [ColorLut - PRGB32]
+  // ==========================================================================
+
+  static void FOG_FASTCALL doArgb_PRGB32(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    const uint8_t* aLut = ctx->colorLut.table[COLOR_INDEX_ALPHA];
+    const uint8_t* rLut = ctx->colorLut.table[COLOR_INDEX_RED  ];
+    const uint8_t* gLut = ctx->colorLut.table[COLOR_INDEX_GREEN];
+    const uint8_t* bLut = ctx->colorLut.table[COLOR_INDEX_BLUE ];
+
+    for (int i = w; i; i--, dst += 4, src += 4)
+    {
+      uint32_t c0;
+
+      Acc::p32Load4a(c0, src);
+      Acc::p32ARGB32FromPRGB32(c0, c0);
+
+      c0 = _FOG_ACC_COMBINE_4(
+        (uint32_t)aLut[(c0 >> 24)       ] << 24,
+        (uint32_t)rLut[(c0 >> 16) & 0xFF] << 16,
+        (uint32_t)gLut[(c0 >>  8) & 0xFF] <<  8,
+        (uint32_t)bLut[(c0      ) & 0xFF]      );
+
+      Acc::p32PRGB32FromARGB32(c0, c0);
+      Acc::p32Store4a(dst, c0);
+    }
+  }
+
+  static void FOG_FASTCALL doAlpha_PRGB32(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    FColorBase::lookupAlpha_PRGB32(dst, src, w, ctx->colorLut.table[COLOR_INDEX_ALPHA]);
+  }
+
+  // ==========================================================================
+  // [ColorLut - XRGB32 / RGB24]
+  // ==========================================================================
+
+  template<typename Accessor>
+  static void FOG_FASTCALL doRgb(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    const uint8_t* rLut = ctx->colorLut.table[COLOR_INDEX_RED  ];
+    const uint8_t* gLut = ctx->colorLut.table[COLOR_INDEX_GREEN];
+    const uint8_t* bLut = ctx->colorLut.table[COLOR_INDEX_BLUE ];
+
+    for (int i = w; i; i--, dst += Accessor::PIXEL_BPP, src += Accessor::PIXEL_BPP)
+    {
+      typename Accessor::Pixel c0;
+      Accessor::fetchPixelM(c0, src);
+
+      c0 = _FOG_ACC_COMBINE_4(
+        0xFF000000,
+        (uint32_t)rLut[(c0 >> 16) & 0xFF] << 16,
+        (uint32_t)gLut[(c0 >>  8) & 0xFF] <<  8,
+        (uint32_t)bLut[(c0      ) & 0xFF]      );
+
+      Accessor::storePixelM(dst, c0);
+    }
+  }
+
+  // ==========================================================================
+  // [ColorLut - A8]
+  // ==========================================================================
+
+  static void FOG_FASTCALL doAlpha_A8(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    FColorBase::lookupAlpha_A8(dst, src, w, ctx->colorLut.table[COLOR_INDEX_ALPHA]);
+  }
+};
+
+} // RasterOps_C namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCOLORLUT_P_H
@@ -0,0 +1,271 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCOLORMATRIX_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCOLORMATRIX_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_C/FilterBase_p.h>
+
+namespace Fog {
+namespace RasterOps_C {
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - ColorMatrix]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Color matrix filter.
+//!
+//! The matrix is applied to non-premultiplied components in the same way as
+//! @c FeColorMatrix::mapArgb32() does. The matrix is classified when the
+//! filter is created and the identity, alpha-only and greyscale matrices use
+//! the specialized kernels.
+struct FOG_NO_EXPORT FColorMatrix
+{
+  // ==========================================================================
+  // [ColorMatrix - Create]
+  // ==========================================================================
+
+  static err_t FOG_FASTCALL create(
+    RasterFilter* ctx, const FeBase* feBase, const ImageFilterScaleD* feScale,
+    MemBuffer* memBuffer,
+    uint32_t dstFormat,
+    uint32_t srcFormat)
+  {
+    FOG_ASSERT(feBase->getFeType() == FE_TYPE_COLOR_MATRIX);
+    const FeColorMatrix* feData = static_cast<const FeColorMatrix*>(feBase);
+
+    // TODO: We should allow to mix some basic formats in the future.
+    if (dstFormat != srcFormat || dstFormat >= IMAGE_FORMAT_COUNT)
+      return ERR_IMAGE_INVALID_FORMAT;
+
+    const ImageFormatDescription& desc = ImageFormatDescription::getByFormat(dstFormat);
+    const float* fm = feData->m;
+    float (*cm)[4] = ctx->colorMatrix.m;
+
+    uint32_t i, j;
+
+    for (i = 0; i < 5; i++)
+    {
+      for (j = 0; j < 4; j++)
+        cm[i][j] = fm[i * 5 + j];
+    }
+
+    for (j = 0; j < 4; j++)
+      cm[4][j] *= 255.0f;
+
+    // Alpha of the formats without alpha channel is always 255, fold it into
+    // the translation.
+    if (desc.getASize() == 0)
+    {
+      for (j = 0; j < 4; j++)
+      {
+        cm[4][j] += 255.0f * cm[3][j];
+        cm[3][j] = 0.0f;
+      }
+    }
+
+    // The alpha lookup table, used by the alpha-only matrix and by A8.
+    for (i = 0; i < 256; i++)
+      ctx->colorMatrix.alphaLut[i] = Math::boundToByte(Math::iround(float(int(i)) * cm[3][3] + cm[4][3]));
+
+    // Classify the matrix.
+    bool isRgbIdentity = true;
+    bool isGrey = true;
+
+    for (i = 0; i < 5; i++)
+    {
+      for (j = 0; j < 3; j++)
+      {
+        if (cm[i][j] != (i == j ? 1.0f : 0.0f))
+          isRgbIdentity = false;
+      }
+
+      if (cm[i][0] != cm[i][1] || cm[i][0] != cm[i][2])
+        isGrey = false;
+    }
+
+    bool isAlphaOnly = cm[0][3] == 0.0f && cm[1][3] == 0.0f && cm[2][3] == 0.0f;
+    bool isAlphaIdentity = desc.getASize() == 0 || (isAlphaOnly && cm[3][3] == 1.0f && cm[4][3] == 0.0f);
+
+    RasterFilterDoLineFunc doLine;
+
+    // A8 contains only alpha, the RGB part of the matrix is not used.
+    if (desc.getRSize() == 0)
+      doLine = _api_raster.filter.colorMatrix.alpha[dstFormat];
+    else if (isRgbIdentity && isAlphaIdentity)
+      doLine = _api_raster.filter.copy[dstFormat];
+    else if (isRgbIdentity && isAlphaOnly)
+      doLine = _api_raster.filter.colorMatrix.alpha[dstFormat];
+    else if (isGrey)
+      doLine = _api_raster.filter.colorMatrix.grey[dstFormat];
+    else
+      doLine = _api_raster.filter.colorMatrix.argb[dstFormat];
+
+    if (doLine == NULL)
+      return ERR_IMAGE_INVALID_FORMAT;
+
+    ctx->reference.init(1);
+    ctx->destroy = FColorBase::destroy;
+
+    ctx->doRect = FColorBase::doRect;
+    ctx->doLine = doLine;
+
+    ctx->memBuffer = memBuffer;
+    ctx->dstFormat = dstFormat;
+    ctx->srcFormat = srcFormat;
+
+    return ERR_OK;
+  }
+
+  // ==========================================================================
+  // [ColorMatrix - PRGB32]
+  // ==========================================================================
+
+  static void FOG_FASTCALL doArgb_PRGB32(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    const float (*m)[4] = ctx->colorMatrix.m;
+
+    for (int i = w; i; i--, dst += 4, src += 4)
+    {
+      uint32_t c0;
+
+      Acc::p32Load4a(c0, src);
+      Acc::p32ARGB32FromPRGB32(c0, c0);
+
+      float fa = float(int((c0 >> 24)       ));
+      float fr = float(int((c0 >> 16) & 0xFF));
+      float fg = float(int((c0 >>  8) & 0xFF));
+      float fb = float(int((c0      ) & 0xFF));
+
+      int ta = Math::iround(fr * m[0][3] + fg * m[1][3] + fb * m[2][3] + fa * m[3][3] + m[4][3]);
+      int tr = Math::iround(fr * m[0][0] + fg * m[1][0] + fb * m[2][0] + fa * m[3][0] + m[4][0]);
+      int tg = Math::iround(fr * m[0][1] + fg * m[1][1] + fb * m[2][1] + fa * m[3][1] + m[4][1]);
+      int tb = Math::iround(fr * m[0][2] + fg * m[1][2] + fb * m[2][2] + fa * m[3][2] + m[4][2]);
+
+      c0 = _FOG_ACC_COMBINE_4(
+        (uint32_t)Math::boundToByte(ta) << 24,
+        (uint32_t)Math::boundToByte(tr) << 16,
+        (uint32_t)Math::boundToByte(tg) <<  8,
+        (uint32_t)Math::boundToByte(tb)      );
+
+      Acc::p32PRGB32FromARGB32(c0, c0);
+      Acc::p32Store4a(dst, c0);
+    }
+  }
+
+  static void FOG_FASTCALL doGrey_PRGB32(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    const float (*m)[4] = ctx->colorMatrix.m;
+
+    for (int i = w; i; i--, dst += 4, src += 4)
+    {
+      uint32_t c0;
+
+      Acc::p32Load4a(c0, src);
+      Acc::p32ARGB32FromPRGB32(c0, c0);
+
+      float fa = float(int((c0 >> 24)       ));
+      float fr = float(int((c0 >> 16) & 0xFF));
+      float fg = float(int((c0 >>  8) & 0xFF));
+      float fb = float(int((c0      ) & 0xFF));
+
+      int ta = Math::iround(fr * m[0][3] + fg * m[1][3] + fb * m[2][3] + fa * m[3][3] + m[4][3]);
+      int ty = Math::iround(fr * m[0][0] + fg * m[1][0] + fb * m[2][0] + fa * m[3][0] + m[4][0]);
+
+      c0 = (uint32_t)Math::boundToByte(ty) * 0x00010101;
+      c0 = _FOG_ACC_COMBINE_2(c0, (uint32_t)Math::boundToByte(ta) << 24);
+
+      Acc::p32PRGB32FromARGB32(c0, c0);
+      Acc::p32Store4a(dst, c0);
+    }
+  }
+
+  static void FOG_FASTCALL doAlpha_PRGB32(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    FColorBase::lookupAlpha_PRGB32(dst, src, w, ctx->colorMatrix.alphaLut);
+  }
+
+  // ==========================================================================
+  // [ColorMatrix - XRGB32 / RGB24]
+  // ==========================================================================
+
+  // The alpha row is already folded into the translation by create().
+
+  template<typename Accessor>
+  static void FOG_FASTCALL doArgb(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    const float (*m)[4] = ctx->colorMatrix.m;
+
+    for (int i = w; i; i--, dst += Accessor::PIXEL_BPP, src += Accessor::PIXEL_BPP)
+    {
+      typename Accessor::Pixel c0;
+      Accessor::fetchPixelM(c0, src);
+
+      float fr = float(int((c0 >> 16) & 0xFF));
+      float fg = float(int((c0 >>  8) & 0xFF));
+      float fb = float(int((c0      ) & 0xFF));
+
+      int tr = Math::iround(fr * m[0][0] + fg * m[1][0] + fb * m[2][0] + m[4][0]);
+      int tg = Math::iround(fr * m[0][1] + fg * m[1][1] + fb * m[2][1] + m[4][1]);
+      int tb = Math::iround(fr * m[0][2] + fg * m[1][2] + fb * m[2][2] + m[4][2]);
+
+      c0 = _FOG_ACC_COMBINE_4(
+        0xFF000000,
+        (uint32_t)Math::boundToByte(tr) << 16,
+        (uint32_t)Math::boundToByte(tg) <<  8,
+        (uint32_t)Math::boundToByte(tb)      );
+
+      Accessor::storePixelM(dst, c0);
+    }
+  }
+
+  template<typename Accessor>
+  static void FOG_FASTCALL doGrey(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    const float (*m)[4] = ctx->colorMatrix.m;
+
+    for (int i = w; i; i--, dst += Accessor::PIXEL_BPP, src += Accessor::PIXEL_BPP)
+    {
+      typename Accessor::Pixel c0;
+      Accessor::fetchPixelM(c0, src);
+
+      float fr = float(int((c0 >> 16) & 0xFF));
+      float fg = float(int((c0 >>  8) & 0xFF));
+      float fb = float(int((c0      ) & 0xFF));
+
+      int ty = Math::iround(fr * m[0][0] + fg * m[1][0] + fb * m[2][0] + m[4][0]);
+
+      c0 = (uint32_t)Math::boundToByte(ty) * 0x00010101;
+      c0 = _FOG_ACC_COMBINE_2(c0, 0xFF000000);
+
+      Accessor::storePixelM(dst, c0);
+    }
+  }
+
+  // ==========================================================================
+  // [ColorMatrix - A8]
+  // ==========================================================================
+
+  static void FOG_FASTCALL doAlpha_A8(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    FColorBase::lookupAlpha_A8(dst, src, w, ctx->colorMatrix.alphaLut);
+  }
+};
+
+} // RasterOps_C namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCOLORMATRIX_P_H
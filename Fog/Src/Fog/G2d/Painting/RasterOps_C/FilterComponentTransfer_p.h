@@ -0,0 +1,58 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCOMPONENTTRANSFER_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCOMPONENTTRANSFER_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_C/FilterBase_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/FilterColorLut_p.h>
+
+namespace Fog {
+namespace RasterOps_C {
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - ComponentTransfer]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Component transfer filter.
+//!
+//! The component functions are evaluated once into the lookup tables, the
+//! filter is then applied by the color LUT kernels.
+struct FOG_NO_EXPORT FComponentTransfer
+{
+  // ==========================================================================
+  // [ComponentTransfer - Create]
+  // ==========================================================================
+
+  static err_t FOG_FASTCALL create(
+    RasterFilter* ctx, const FeBase* feBase, const ImageFilterScaleD* feScale,
+    MemBuffer* memBuffer,
+    uint32_t dstFormat,
+    uint32_t srcFormat)
+  {
+    FOG_ASSERT(feBase->getFeType() == FE_TYPE_COMPONENT_TRANSFER);
+    const FeComponentTransfer* feData = static_cast<const FeComponentTransfer*>(feBase);
+
+    FeColorLutArray lut;
+
+    for (uint32_t i = 0; i < COLOR_INDEX_COUNT; i++)
+    {
+      FOG_RETURN_ON_ERROR(lut.setFromFunction(feData->c[i]()));
+      MemOps::copy(ctx->colorLut.table[i], lut.getData(), 256);
+    }
+
+    return FColorLut::init(ctx, memBuffer, dstFormat, srcFormat);
+  }
+};
+
+} // RasterOps_C namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCOMPONENTTRANSFER_P_H
@@ -0,0 +1,378 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCONVOLVEMATRIX_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCONVOLVEMATRIX_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_C/FilterBase_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/FilterConvolveSeparable_p.h>
+
+namespace Fog {
+namespace RasterOps_C {
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - ConvolveMatrix]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Convolution matrix filter.
+//!
+//! The convolution follows SVG feConvolveMatrix, the kernel is flipped and
+//! the target is at the center of the kernel:
+//!
+//!   dst(x, y) = sum(src(x - tx + j, y - ty + i) * k[h - 1 - i][w - 1 - j])
+//!             * scale + bias * 255
+//!
+//! It's applied on premultiplied components. The matrix is tested whether it
+//! is an outer product of two vectors when the filter is created, in that case
+//! the filter is routed to @ref FConvolveSeparable, which needs w + h instead
+//! of w * h multiplications per component.
+struct FOG_NO_EXPORT FConvolveMatrix
+{
+  // ==========================================================================
+  // [ConvolveMatrix - Create]
+  // ==========================================================================
+
+  static err_t FOG_FASTCALL create(
+    RasterFilter* ctx, const FeBase* feBase, const ImageFilterScaleD* feScale,
+    MemBuffer* memBuffer,
+    uint32_t dstFormat,
+    uint32_t srcFormat)
+  {
+    FOG_ASSERT(feBase->getFeType() == FE_TYPE_CONVOLVE_MATRIX);
+    const FeConvolveMatrix* feData = static_cast<const FeConvolveMatrix*>(feBase);
+
+    // TODO: We should allow to mix some basic formats in the future.
+    if (dstFormat != srcFormat || dstFormat >= IMAGE_FORMAT_COUNT)
+      return ERR_IMAGE_INVALID_FORMAT;
+
+    const MatrixF& matrix = feData->getMatrix();
+
+    int kw = matrix.getWidth();
+    int kh = matrix.getHeight();
+
+    static const float identity[1] = { 1.0f };
+    const float* m = matrix.getData();
+
+    // An empty matrix means no convolution (only scale and bias).
+    if (kw <= 0 || kh <= 0)
+    {
+      kw = 1;
+      kh = 1;
+      m = identity;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Flip]
+    // ------------------------------------------------------------------------
+
+    MemBufferTmp<1024> tmpBuffer;
+    float* k = reinterpret_cast<float*>(tmpBuffer.alloc((size_t)(kw * kh + kw + kh) * sizeof(float)));
+
+    if (FOG_IS_NULL(k))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    int i, j;
+    int pr = 0, pc = 0;
+    float maxAbs = 0.0f;
+
+    for (i = 0; i < kh; i++)
+    {
+      for (j = 0; j < kw; j++)
+      {
+        float v = m[(kh - 1 - i) * kw + (kw - 1 - j)];
+        k[i * kw + j] = v;
+
+        if (Math::abs(v) > maxAbs)
+        {
+          maxAbs = Math::abs(v);
+          pr = i;
+          pc = j;
+        }
+      }
+    }
+
+    // ------------------------------------------------------------------------
+    // [Separable]
+    // ------------------------------------------------------------------------
+
+    // The matrix is rank-1 if it equals the outer product of its pivot column
+    // and its pivot row (divided by the pivot).
+    if (maxAbs > 0.0f && (kw > 1 || kh > 1))
+    {
+      float* hVector = k + kw * kh;
+      float* vVector = hVector + kw;
+
+      float pivot = k[pr * kw + pc];
+      float epsilon = maxAbs * 1e-5f;
+      bool isSeparable = true;
+
+      for (j = 0; j < kw; j++)
+        hVector[j] = k[pr * kw + j] / pivot;
+
+      for (i = 0; i < kh; i++)
+        vVector[i] = k[i * kw + pc];
+
+      for (i = 0; i < kh && isSeparable; i++)
+      {
+        for (j = 0; j < kw; j++)
+        {
+          if (Math::abs(k[i * kw + j] - vVector[i] * hVector[j]) > epsilon)
+          {
+            isSeparable = false;
+            break;
+          }
+        }
+      }
+
+      if (isSeparable)
+      {
+        return FConvolveSeparable::init(ctx, feData, memBuffer, dstFormat, srcFormat,
+          hVector, kw, 1.0f, 0.0f,
+          vVector, kh, feData->getScale(), feData->getBias());
+      }
+    }
+
+    // ------------------------------------------------------------------------
+    // [General]
+    // ------------------------------------------------------------------------
+
+    RasterFilter::_ConvolveMatrix& d = ctx->convolveMatrix;
+
+    if (_api_raster.filter.convolve.matrix[dstFormat] == NULL)
+      return ERR_IMAGE_INVALID_FORMAT;
+
+    int weightStride = (kw + 1) & ~1;
+    int16_t* weights = reinterpret_cast<int16_t*>(
+      MemMgr::alloc((size_t)(weightStride * kh) * sizeof(int16_t)));
+
+    if (FOG_IS_NULL(weights))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    float scale = feData->getScale();
+    float sumAbs = 0.0f;
+
+    for (i = 0; i < kw * kh; i++)
+    {
+      k[i] *= scale;
+      sumAbs += Math::abs(k[i]);
+    }
+
+    // Keep some space for the bias.
+    int shift = FConvolveSeparable::getPrecision(maxAbs * Math::abs(scale), sumAbs, 255.0f, 1073741824.0f);
+    float bias = feData->getBias() * 255.0f * float(1 << shift);
+
+    for (i = 0; i < kh; i++)
+      FConvolveSeparable::toFixed(weights + i * weightStride, k + i * kw, kw, weightStride, shift);
+
+    d.extendType = feData->getExtendType();
+    FBorderBase::initExtendColor(d.extendColor, feData);
+
+    d.kernelWidth = kw;
+    d.kernelHeight = kh;
+    d.targetX = kw / 2;
+    d.targetY = kh / 2;
+
+    d.weightStride = weightStride;
+    d.shift = shift;
+    d.bias = Math::bound<int>(Math::iround(bias), -(1 << 30), (1 << 30)) + ((1 << shift) >> 1);
+    d.weights = weights;
+
+    ctx->reference.init(1);
+    ctx->destroy = destroy;
+
+    ctx->doRect = doRect;
+    ctx->doLine = NULL;
+
+    ctx->memBuffer = memBuffer;
+    ctx->dstFormat = dstFormat;
+    ctx->srcFormat = srcFormat;
+
+    return ERR_OK;
+  }
+
+  // ==========================================================================
+  // [ConvolveMatrix - Destroy]
+  // ==========================================================================
+
+  static void FOG_FASTCALL destroy(
+    RasterFilter* ctx)
+  {
+    MemMgr::free(ctx->convolveMatrix.weights);
+
+    // Just be safe and detect possible NULL pointer dereference.
+    ctx->destroy = NULL;
+    ctx->doRect = NULL;
+    ctx->doLine = NULL;
+  }
+
+  // ==========================================================================
+  // [ConvolveMatrix - DoRect]
+  // ==========================================================================
+
+  static err_t FOG_FASTCALL doRect(
+    RasterFilter* ctx,
+    RasterFilterImage* dst, const PointI* dstPos,
+    RasterFilterImage* src, const RectI* srcRect,
+    MemBuffer* intermediateBuffer)
+  {
+    FOG_ASSERT(srcRect->x >= 0);
+    FOG_ASSERT(srcRect->y >= 0);
+    FOG_ASSERT(srcRect->x + srcRect->w <= src->size.w);
+    FOG_ASSERT(srcRect->y + srcRect->h <= src->size.h);
+
+    const RasterFilter::_ConvolveMatrix& d = ctx->convolveMatrix;
+
+    MemBufferTmp<1024> memBufferTmp;
+    MemBuffer* memBuffer = &memBufferTmp;
+
+    if (ctx->memBuffer)
+      memBuffer = ctx->memBuffer;
+
+    if (srcRect->w <= 0 || srcRect->h <= 0)
+      return ERR_OK;
+
+    uint32_t format = ctx->srcFormat;
+    uint32_t dstFormat = ctx->dstFormat;
+
+    RasterFilterConvolveMFunc mFunc = _api_raster.filter.convolve.matrix[format];
+
+    uint8_t* dstPixels;
+    ssize_t dstStride;
+    bool copyBack;
+
+    FOG_RETURN_ON_ERROR(FBorderBase::prepareDst(dst, dstPos, src, srcRect,
+      dstFormat, intermediateBuffer, dstPixels, dstStride, copyBack));
+
+    int nc = FBorderBase::getWorkBpp(format);
+    int dstBpp = ImageFormatDescription::getByFormat(dstFormat).getBytesPerPixel();
+
+    int kh = d.kernelHeight;
+    int tileW = FBorderBase::getTileWidth(srcRect->w, kh + 1, nc);
+
+    uint32_t extendType = d.extendType;
+    uint32_t extendPixel = FBorderBase::getExtendPixel(d.extendColor, format);
+
+    // ------------------------------------------------------------------------
+    // [Buffers]
+    // ------------------------------------------------------------------------
+
+    // The ring of extended source rows (kh), the row of the extend color (used
+    // by FE_EXTEND_COLOR) and the output row. Each row contains one more pixel
+    // so the kernels can read pixels in pairs.
+    int fetchW = tileW + d.weightStride - 1;
+    size_t rowAligned = ((size_t)(fetchW + 1) * nc + 15) & ~(size_t)15;
+
+    uint8_t* buffer = reinterpret_cast<uint8_t*>(memBuffer->alloc(
+      (size_t)(kh + 2) * rowAligned + (size_t)(kh * 2) * sizeof(uint8_t*) + 16));
+
+    if (FOG_IS_NULL(buffer))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    const uint8_t** slots = reinterpret_cast<const uint8_t**>(buffer);
+    const uint8_t** rows = slots + kh;
+
+    uint8_t* ring = reinterpret_cast<uint8_t*>(((size_t)(rows + kh) + 15) & ~(size_t)15);
+    uint8_t* colorRow = ring + (size_t)kh * rowAligned;
+    uint8_t* outRow = colorRow + rowAligned;
+
+    FBorderBase::fillRow(colorRow, fetchW, format, extendPixel);
+
+    // ------------------------------------------------------------------------
+    // [Tiles]
+    // ------------------------------------------------------------------------
+
+    int srcW = src->size.w;
+    int srcH = src->size.h;
+    int yStart = srcRect->y - d.targetY;
+
+    for (int tx = 0; tx < srcRect->w; tx += tileW)
+    {
+      int tw = Math::min(tileW, srcRect->w - tx);
+      int fx = srcRect->x + tx - d.targetX;
+      int fw = tw + d.weightStride - 1;
+      int next = yStart;
+
+      for (int y = 0; y < srcRect->h; y++)
+      {
+        int top = yStart + y;
+
+        // Fetch the rows which entered the kernel.
+        while (next < top + kh)
+        {
+          int slot = (next - yStart) % kh;
+          int sy = FBorderBase::extendCoord(next, srcH, extendType);
+
+          if (sy >= 0)
+          {
+            uint8_t* ringRow = ring + (size_t)slot * rowAligned;
+
+            FBorderBase::fetchRow(ringRow, src->data + sy * src->stride,
+              fx, fw, srcW, format, extendType, extendPixel);
+            slots[slot] = ringRow;
+          }
+          else
+          {
+            slots[slot] = colorRow;
+          }
+
+          next++;
+        }
+
+        int slot = (top - yStart) % kh;
+        for (int i = 0; i < kh; i++)
+        {
+          rows[i] = slots[slot];
+          if (++slot == kh)
+            slot = 0;
+        }
+
+        mFunc(outRow, rows, tw, d.weights, d.weightStride, kh, d.bias, d.shift);
+        FBorderBase::storeRow(dstPixels + y * dstStride + tx * dstBpp, outRow, tw, dstFormat);
+      }
+    }
+
+    FBorderBase::finishDst(dst, dstPos, srcRect, dstFormat, dstPixels, dstStride, copyBack);
+    return ERR_OK;
+  }
+
+  // ==========================================================================
+  // [ConvolveMatrix - Matrix]
+  // ==========================================================================
+
+  template<int NC>
+  static void FOG_FASTCALL doMatrix(
+    uint8_t* dst, const uint8_t* const* src, int w,
+    const int16_t* weights, int weightStride, int count, int bias, int shift)
+  {
+    for (int x = 0; x < w; x++)
+    {
+      for (int c = 0; c < NC; c++, dst++)
+      {
+        const int16_t* wRow = weights;
+        int acc = bias;
+
+        for (int i = 0; i < count; i++, wRow += weightStride)
+        {
+          const uint8_t* s = src[i] + x * NC + c;
+
+          for (int j = 0; j < weightStride; j++, s += NC)
+            acc += (int)wRow[j] * (int)s[0];
+        }
+
+        dst[0] = (uint8_t)Math::boundToByte(acc >> shift);
+      }
+    }
+  }
+};
+
+} // RasterOps_C namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCONVOLVEMATRIX_P_H
@@ -0,0 +1,440 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCONVOLVESEPARABLE_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCONVOLVESEPARABLE_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_C/FilterBase_p.h>
+
+namespace Fog {
+namespace RasterOps_C {
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - ConvolveSeparable]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Separable convolution filter, also used by the convolution matrix
+//! filter when the matrix is an outer product of two vectors (rank-1).
+//!
+//! The horizontal pass converts the extended source rows to 16-bit
+//! fixed-point components, which are kept in a ring of vertical kernel size
+//! rows, so each source row is convolved horizontally only once. The vertical
+//! pass then convolves the ring to the destination row. The filtered
+//! rectangle is processed in vertical tiles to keep the ring in the cache.
+//!
+//! The result of the horizontal pass is not clamped, the bias of the
+//! horizontal pass is folded into the bias of the vertical pass.
+struct FOG_NO_EXPORT FConvolveSeparable
+{
+  // ==========================================================================
+  // [ConvolveSeparable - Helpers]
+  // ==========================================================================
+
+  //! @brief Get the maximum fixed-point precision (at most 14 bits) so that
+  //! the @a maxAbs weight fits to int16_t and @a sumAbs weights multiplied by
+  //! @a maxValue fit to @a limit.
+  static int getPrecision(float maxAbs, float sumAbs, float maxValue, float limit)
+  {
+    int prec = 14;
+
+    while (prec > 0)
+    {
+      float scale = float(1 << prec);
+      if (maxAbs * scale <= 32767.0f && sumAbs * maxValue * scale < limit)
+        break;
+      prec--;
+    }
+
+    return prec;
+  }
+
+  //! @brief Convert @a size weights of @a src to the fixed-point @a dst,
+  //! the @a dst array is padded by zero weight to @a count.
+  static void toFixed(int16_t* dst, const float* src, int size, int count, int prec)
+  {
+    float scale = float(1 << prec);
+    int i;
+
+    for (i = 0; i < size; i++)
+      dst[i] = (int16_t)Math::bound<int>(Math::iround(src[i] * scale), -32768, 32767);
+
+    for (; i < count; i++)
+      dst[i] = 0;
+  }
+
+  // ==========================================================================
+  // [ConvolveSeparable - Create]
+  // ==========================================================================
+
+  static err_t FOG_FASTCALL create(
+    RasterFilter* ctx, const FeBase* feBase, const ImageFilterScaleD* feScale,
+    MemBuffer* memBuffer,
+    uint32_t dstFormat,
+    uint32_t srcFormat)
+  {
+    FOG_ASSERT(feBase->getFeType() == FE_TYPE_CONVOLVE_SEPARABLE);
+    const FeConvolveSeparable* feData = static_cast<const FeConvolveSeparable*>(feBase);
+
+    // TODO: We should allow to mix some basic formats in the future.
+    if (dstFormat != srcFormat || dstFormat >= IMAGE_FORMAT_COUNT)
+      return ERR_IMAGE_INVALID_FORMAT;
+
+    const List<float>& hVector = feData->getHorzVector();
+    const List<float>& vVector = feData->getVertVector();
+
+    // An empty vector means no convolution in that direction.
+    static const float identity[1] = { 1.0f };
+
+    const float* hData = hVector.getLength() ? hVector.getData() : identity;
+    const float* vData = vVector.getLength() ? vVector.getData() : identity;
+
+    int hSize = hVector.getLength() ? (int)hVector.getLength() : 1;
+    int vSize = vVector.getLength() ? (int)vVector.getLength() : 1;
+
+    MemBufferTmp<1024> tmpBuffer;
+    float* kernel = reinterpret_cast<float*>(tmpBuffer.alloc((size_t)(hSize + vSize) * sizeof(float)));
+
+    if (FOG_IS_NULL(kernel))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    // The vectors are flipped, see FConvolveMatrix.
+    int i;
+    for (i = 0; i < hSize; i++) kernel[i] = hData[hSize - 1 - i];
+    for (i = 0; i < vSize; i++) kernel[hSize + i] = vData[vSize - 1 - i];
+
+    return init(ctx, feData, memBuffer, dstFormat, srcFormat,
+      kernel, hSize, feData->getHorzScale(), feData->getHorzBias(),
+      kernel + hSize, vSize, feData->getVertScale(), feData->getVertBias());
+  }
+
+  //! @brief Initialize the separable convolution from the flipped vectors.
+  static err_t init(
+    RasterFilter* ctx, const FeBorder* feBorder,
+    MemBuffer* memBuffer,
+    uint32_t dstFormat,
+    uint32_t srcFormat,
+    const float* hVector, int hSize, float hScale, float hBias,
+    const float* vVector, int vSize, float vScale, float vBias)
+  {
+    RasterFilter::_ConvolveSeparable& d = ctx->convolveSeparable;
+
+    if (_api_raster.filter.convolve.h[dstFormat] == NULL ||
+        _api_raster.filter.convolve.v[dstFormat] == NULL)
+    {
+      return ERR_IMAGE_INVALID_FORMAT;
+    }
+
+    int hCount = (hSize + 1) & ~1;
+    int vCount = (vSize + 1) & ~1;
+
+    int16_t* weights = reinterpret_cast<int16_t*>(
+      MemMgr::alloc((size_t)(hCount + vCount) * sizeof(int16_t)));
+
+    if (FOG_IS_NULL(weights))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    // Fold the scale into the weights.
+    MemBufferTmp<1024> tmpBuffer;
+    float* hWeights = reinterpret_cast<float*>(tmpBuffer.alloc((size_t)(hSize + vSize) * sizeof(float)));
+    float* vWeights = hWeights + hSize;
+
+    if (FOG_IS_NULL(hWeights))
+    {
+      MemMgr::free(weights);
+      return ERR_RT_OUT_OF_MEMORY;
+    }
+
+    float hMax = 0.0f, hSumAbs = 0.0f;
+    float vMax = 0.0f, vSumAbs = 0.0f, vSum = 0.0f;
+    int i;
+
+    for (i = 0; i < hSize; i++)
+    {
+      float w = hVector[i] * hScale;
+
+      hWeights[i] = w;
+      hMax = Math::max(hMax, Math::abs(w));
+      hSumAbs += Math::abs(w);
+    }
+
+    for (i = 0; i < vSize; i++)
+    {
+      float w = vVector[i] * vScale;
+
+      vWeights[i] = w;
+      vMax = Math::max(vMax, Math::abs(w));
+      vSumAbs += Math::abs(w);
+      vSum += w;
+    }
+
+    // The intermediate precision is the count of fractional bits stored in
+    // the 16-bit intermediate, the horizontal precision can't be lower.
+    int iPrec = 0;
+    while (iPrec < 7 && 255.0f * hSumAbs * float(2 << iPrec) <= 32767.0f)
+      iPrec++;
+
+    int hPrec = getPrecision(hMax, hSumAbs, 255.0f, 2147483648.0f);
+    int vPrec = getPrecision(vMax, vSumAbs, 32767.0f, 2147483648.0f);
+
+    if (iPrec > hPrec)
+      iPrec = hPrec;
+
+    toFixed(weights, hWeights, hSize, hCount, hPrec);
+    toFixed(weights + hCount, vWeights, vSize, vCount, vPrec);
+
+    int vShift = iPrec + vPrec;
+    float bias = (vBias + hBias * vSum) * 255.0f * float(1 << vShift);
+
+    d.extendType = feBorder->getExtendType();
+    FBorderBase::initExtendColor(d.extendColor, feBorder);
+
+    d.hSize = hSize;
+    d.vSize = vSize;
+    d.hTarget = hSize / 2;
+    d.vTarget = vSize / 2;
+
+    d.hCount = hCount;
+    d.vCount = vCount;
+
+    d.hShift = hPrec - iPrec;
+    d.vShift = vShift;
+    d.bias = Math::bound<int>(Math::iround(bias), -(1 << 30), (1 << 30)) + ((1 << vShift) >> 1);
+
+    d.hWeights = weights;
+    d.vWeights = weights + hCount;
+
+    ctx->reference.init(1);
+    ctx->destroy = destroy;
+
+    ctx->doRect = doRect;
+    ctx->doLine = NULL;
+
+    ctx->memBuffer = memBuffer;
+    ctx->dstFormat = dstFormat;
+    ctx->srcFormat = srcFormat;
+
+    return ERR_OK;
+  }
+
+  // ==========================================================================
+  // [ConvolveSeparable - Destroy]
+  // ==========================================================================
+
+  static void FOG_FASTCALL destroy(
+    RasterFilter* ctx)
+  {
+    MemMgr::free(ctx->convolveSeparable.hWeights);
+
+    // Just be safe and detect possible NULL pointer dereference.
+    ctx->destroy = NULL;
+    ctx->doRect = NULL;
+    ctx->doLine = NULL;
+  }
+
+  // ==========================================================================
+  // [ConvolveSeparable - DoRect]
+  // ==========================================================================
+
+  static err_t FOG_FASTCALL doRect(
+    RasterFilter* ctx,
+    RasterFilterImage* dst, const PointI* dstPos,
+    RasterFilterImage* src, const RectI* srcRect,
+    MemBuffer* intermediateBuffer)
+  {
+    FOG_ASSERT(srcRect->x >= 0);
+    FOG_ASSERT(srcRect->y >= 0);
+    FOG_ASSERT(srcRect->x + srcRect->w <= src->size.w);
+    FOG_ASSERT(srcRect->y + srcRect->h <= src->size.h);
+
+    const RasterFilter::_ConvolveSeparable& d = ctx->convolveSeparable;
+
+    MemBufferTmp<1024> memBufferTmp;
+    MemBuffer* memBuffer = &memBufferTmp;
+
+    if (ctx->memBuffer)
+      memBuffer = ctx->memBuffer;
+
+    if (srcRect->w <= 0 || srcRect->h <= 0)
+      return ERR_OK;
+
+    uint32_t format = ctx->srcFormat;
+    uint32_t dstFormat = ctx->dstFormat;
+
+    RasterFilterConvolveHFunc hFunc = _api_raster.filter.convolve.h[format];
+    RasterFilterConvolveVFunc vFunc = _api_raster.filter.convolve.v[format];
+
+    uint8_t* dstPixels;
+    ssize_t dstStride;
+    bool copyBack;
+
+    FOG_RETURN_ON_ERROR(FBorderBase::prepareDst(dst, dstPos, src, srcRect,
+      dstFormat, intermediateBuffer, dstPixels, dstStride, copyBack));
+
+    int nc = FBorderBase::getWorkBpp(format);
+    int dstBpp = ImageFormatDescription::getByFormat(dstFormat).getBytesPerPixel();
+
+    int vSize = d.vSize;
+    int vCount = d.vCount;
+    int tileW = FBorderBase::getTileWidth(srcRect->w, vSize + 1, nc * 2);
+
+    uint32_t extendType = d.extendType;
+    uint32_t extendPixel = FBorderBase::getExtendPixel(d.extendColor, format);
+
+    // ------------------------------------------------------------------------
+    // [Buffers]
+    // ------------------------------------------------------------------------
+
+    // The ring of horizontally convolved rows (vSize), the row of the extend
+    // color (used by FE_EXTEND_COLOR), the fetched row and the output row.
+    size_t fetchSize = (size_t)(tileW + d.hCount) * nc;
+    size_t rowSize = (size_t)tileW * nc;
+    size_t rowAligned = (rowSize * sizeof(int16_t) + 15) & ~(size_t)15;
+
+    uint8_t* buffer = reinterpret_cast<uint8_t*>(memBuffer->alloc(
+      (size_t)(vSize + 1) * rowAligned + fetchSize + rowSize +
+      (size_t)(vSize + vCount) * sizeof(int16_t*) + 16));
+
+    if (FOG_IS_NULL(buffer))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    const int16_t** slots = reinterpret_cast<const int16_t**>(buffer);
+    const int16_t** rows = slots + vSize;
+
+    int16_t* ring = reinterpret_cast<int16_t*>(
+      ((size_t)(rows + vCount) + 15) & ~(size_t)15);
+    int16_t* colorRow = reinterpret_cast<int16_t*>((uint8_t*)ring + (size_t)vSize * rowAligned);
+
+    uint8_t* fetchRow = (uint8_t*)colorRow + rowAligned;
+    uint8_t* outRow = fetchRow + fetchSize;
+
+    // ------------------------------------------------------------------------
+    // [Tiles]
+    // ------------------------------------------------------------------------
+
+    int srcW = src->size.w;
+    int srcH = src->size.h;
+    int yStart = srcRect->y - d.vTarget;
+
+    for (int tx = 0; tx < srcRect->w; tx += tileW)
+    {
+      int tw = Math::min(tileW, srcRect->w - tx);
+      int fx = srcRect->x + tx - d.hTarget;
+      int fw = tw + d.hCount - 1;
+
+      if (extendType == FE_EXTEND_COLOR)
+      {
+        FBorderBase::fillRow(fetchRow, fw, format, extendPixel);
+        hFunc(colorRow, fetchRow, tw, d.hWeights, d.hCount, d.hShift);
+      }
+
+      int next = yStart;
+
+      for (int y = 0; y < srcRect->h; y++)
+      {
+        int top = yStart + y;
+
+        // Convolve the rows which entered the kernel horizontally.
+        while (next < top + vSize)
+        {
+          int slot = (next - yStart) % vSize;
+          int sy = FBorderBase::extendCoord(next, srcH, extendType);
+
+          if (sy >= 0)
+          {
+            int16_t* ringRow = reinterpret_cast<int16_t*>((uint8_t*)ring + (size_t)slot * rowAligned);
+
+            FBorderBase::fetchRow(fetchRow, src->data + sy * src->stride,
+              fx, fw, srcW, format, extendType, extendPixel);
+            hFunc(ringRow, fetchRow, tw, d.hWeights, d.hCount, d.hShift);
+
+            slots[slot] = ringRow;
+          }
+          else
+          {
+            slots[slot] = colorRow;
+          }
+
+          next++;
+        }
+
+        int slot = (top - yStart) % vSize;
+        for (int i = 0; i < vSize; i++)
+        {
+          rows[i] = slots[slot];
+          if (++slot == vSize)
+            slot = 0;
+        }
+
+        // The padding weight is zero, use any valid row.
+        if (vCount != vSize)
+          rows[vSize] = rows[vSize - 1];
+
+        vFunc(outRow, rows, tw, d.vWeights, vCount, d.bias, d.vShift);
+        FBorderBase::storeRow(dstPixels + y * dstStride + tx * dstBpp, outRow, tw, dstFormat);
+      }
+    }
+
+    FBorderBase::finishDst(dst, dstPos, srcRect, dstFormat, dstPixels, dstStride, copyBack);
+    return ERR_OK;
+  }
+
+  // ==========================================================================
+  // [ConvolveSeparable - Horizontal]
+  // ==========================================================================
+
+  template<int NC>
+  static void FOG_FASTCALL doH(
+    int16_t* dst, const uint8_t* src, int w,
+    const int16_t* weights, int count, int shift)
+  {
+    int round = (1 << shift) >> 1;
+
+    for (int x = 0; x < w; x++, src += NC)
+    {
+      for (int c = 0; c < NC; c++, dst++)
+      {
+        const uint8_t* s = src + c;
+        int acc = round;
+
+        for (int j = 0; j < count; j++, s += NC)
+          acc += (int)weights[j] * (int)s[0];
+
+        dst[0] = (int16_t)Math::bound<int>(acc >> shift, -32768, 32767);
+      }
+    }
+  }
+
+  // ==========================================================================
+  // [ConvolveSeparable - Vertical]
+  // ==========================================================================
+
+  template<int NC>
+  static void FOG_FASTCALL doV(
+    uint8_t* dst, const int16_t* const* src, int w,
+    const int16_t* weights, int count, int bias, int shift)
+  {
+    int size = w * NC;
+
+    for (int i = 0; i < size; i++)
+    {
+      int acc = bias;
+
+      for (int k = 0; k < count; k++)
+        acc += (int)weights[k] * (int)src[k][i];
+
+      dst[i] = (uint8_t)Math::boundToByte(acc >> shift);
+    }
+  }
+};
+
+} // RasterOps_C namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_C_FILTERCONVOLVESEPARABLE_P_H
@@ -0,0 +1,351 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_C_FILTERMORPHOLOGY_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_C_FILTERMORPHOLOGY_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_C/FilterBase_p.h>
+
+namespace Fog {
+namespace RasterOps_C {
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - Morphology - Ops]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT FMorphologyErode
+{
+  static FOG_INLINE uint8_t op(uint8_t a, uint8_t b) { return a < b ? a : b; }
+};
+
+//! @internal
+struct FOG_NO_EXPORT FMorphologyDilate
+{
+  static FOG_INLINE uint8_t op(uint8_t a, uint8_t b) { return a > b ? a : b; }
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - Morphology]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Morphology filter (erode/dilate).
+//!
+//! Uses the van Herk/Gil-Werman algorithm, the row (or column) is split into
+//! blocks of the window size and the running minimum (maximum) is computed
+//! from the start (prefix run @c g) and from the end (suffix run @c h) of each
+//! block. Each window then spans at most two blocks, so its result is
+//! op(h[i], g[i + size - 1]), which needs three operations per pixel for any
+//! radius.
+//!
+//! The horizontal pass works on single rows. The vertical pass works on whole
+//! rows at once, the prefix run is a single running row and the suffix runs
+//! are computed in-place when a block of rows is complete. The operation is
+//! applied on premultiplied components, which keeps the result premultiplied.
+struct FOG_NO_EXPORT FMorphology
+{
+  // ==========================================================================
+  // [Morphology - Create]
+  // ==========================================================================
+
+  static err_t FOG_FASTCALL create(
+    RasterFilter* ctx, const FeBase* feBase, const ImageFilterScaleD* feScale,
+    MemBuffer* memBuffer,
+    uint32_t dstFormat,
+    uint32_t srcFormat)
+  {
+    FOG_ASSERT(feBase->getFeType() == FE_TYPE_MORPHOLOGY);
+    const FeMorphology* feData = static_cast<const FeMorphology*>(feBase);
+
+    // TODO: We should allow to mix some basic formats in the future.
+    if (dstFormat != srcFormat || dstFormat >= IMAGE_FORMAT_COUNT)
+      return ERR_IMAGE_INVALID_FORMAT;
+
+    uint32_t morphologyType = feData->getMorphologyType();
+    if (morphologyType >= FE_MORPHOLOGY_TYPE_COUNT)
+      return ERR_RT_INVALID_ARGUMENT;
+
+    RasterFilter::_Morphology& d = ctx->morphology;
+
+    d.hFunc = _api_raster.filter.morphology.h[morphologyType][dstFormat];
+    d.vFunc = _api_raster.filter.morphology.v[morphologyType];
+
+    if (d.hFunc == NULL || d.vFunc == NULL)
+      return ERR_IMAGE_INVALID_FORMAT;
+
+    d.morphologyType = morphologyType;
+    d.extendType = feData->getExtendType();
+    FBorderBase::initExtendColor(d.extendColor, feData);
+
+    d.hRadius = Math::max(Math::iround(feData->getHorizontalRadius()), 0);
+    d.vRadius = Math::max(Math::iround(feData->getVerticalRadius()), 0);
+
+    ctx->reference.init(1);
+    ctx->destroy = destroy;
+
+    ctx->doRect = doRect;
+    ctx->doLine = NULL;
+
+    ctx->memBuffer = memBuffer;
+    ctx->dstFormat = dstFormat;
+    ctx->srcFormat = srcFormat;
+
+    return ERR_OK;
+  }
+
+  // ==========================================================================
+  // [Morphology - Destroy]
+  // ==========================================================================
+
+  static void FOG_FASTCALL destroy(
+    RasterFilter* ctx)
+  {
+    // Just be safe and detect possible NULL pointer dereference.
+    ctx->destroy = NULL;
+    ctx->doRect = NULL;
+    ctx->doLine = NULL;
+  }
+
+  // ==========================================================================
+  // [Morphology - DoRect]
+  // ==========================================================================
+
+  static err_t FOG_FASTCALL doRect(
+    RasterFilter* ctx,
+    RasterFilterImage* dst, const PointI* dstPos,
+    RasterFilterImage* src, const RectI* srcRect,
+    MemBuffer* intermediateBuffer)
+  {
+    FOG_ASSERT(srcRect->x >= 0);
+    FOG_ASSERT(srcRect->y >= 0);
+    FOG_ASSERT(srcRect->x + srcRect->w <= src->size.w);
+    FOG_ASSERT(srcRect->y + srcRect->h <= src->size.h);
+
+    const RasterFilter::_Morphology& d = ctx->morphology;
+
+    MemBufferTmp<1024> memBufferTmp;
+    MemBuffer* memBuffer = &memBufferTmp;
+
+    if (ctx->memBuffer)
+      memBuffer = ctx->memBuffer;
+
+    if (srcRect->w <= 0 || srcRect->h <= 0)
+      return ERR_OK;
+
+    uint32_t format = ctx->srcFormat;
+    uint32_t dstFormat = ctx->dstFormat;
+
+    RasterFilterMorphologyHFunc hFunc = d.hFunc;
+    RasterFilterMorphologyVFunc vFunc = d.vFunc;
+
+    uint8_t* dstPixels;
+    ssize_t dstStride;
+    bool copyBack;
+
+    FOG_RETURN_ON_ERROR(FBorderBase::prepareDst(dst, dstPos, src, srcRect,
+      dstFormat, intermediateBuffer, dstPixels, dstStride, copyBack));
+
+    int nc = FBorderBase::getWorkBpp(format);
+    int dstBpp = ImageFormatDescription::getByFormat(dstFormat).getBytesPerPixel();
+
+    int hSize = d.hRadius * 2 + 1;
+    int vSize = d.vRadius * 2 + 1;
+
+    int tileW = FBorderBase::getTileWidth(srcRect->w, vSize * 2 + 2, nc);
+
+    uint32_t extendType = d.extendType;
+    uint32_t extendPixel = FBorderBase::getExtendPixel(d.extendColor, format);
+
+    // ------------------------------------------------------------------------
+    // [Buffers]
+    // ------------------------------------------------------------------------
+
+    // Two blocks of rows (the suffix runs of the previous block and the rows
+    // of the current block), the prefix run, the row of the extend color, and
+    // the fetched row with its prefix and suffix runs.
+    size_t rowSize = (size_t)tileW * nc;
+    size_t rowAligned = (rowSize + 15) & ~(size_t)15;
+    size_t fetchAligned = ((size_t)(tileW + hSize - 1) * nc + 15) & ~(size_t)15;
+
+    uint8_t* buffer = reinterpret_cast<uint8_t*>(memBuffer->alloc(
+      (size_t)(vSize * 2 + 2) * rowAligned + fetchAligned * 3 +
+      (size_t)(vSize * 2) * sizeof(uint8_t*) + 16));
+
+    if (FOG_IS_NULL(buffer))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    uint8_t** hPrev = reinterpret_cast<uint8_t**>(buffer);
+    uint8_t** cur = hPrev + vSize;
+
+    uint8_t* p = reinterpret_cast<uint8_t*>(((size_t)(cur + vSize) + 15) & ~(size_t)15);
+    int i;
+
+    for (i = 0; i < vSize; i++, p += rowAligned) hPrev[i] = p;
+    for (i = 0; i < vSize; i++, p += rowAligned) cur[i] = p;
+
+    uint8_t* gRow = p; p += rowAligned;
+    uint8_t* colorRow = p; p += rowAligned;
+
+    uint8_t* fetchRow = p; p += fetchAligned;
+    uint8_t* gRun = p; p += fetchAligned;
+    uint8_t* hRun = p;
+
+    FBorderBase::fillRow(colorRow, tileW, format, extendPixel);
+
+    // ------------------------------------------------------------------------
+    // [Tiles]
+    // ------------------------------------------------------------------------
+
+    int srcW = src->size.w;
+    int srcH = src->size.h;
+
+    int yStart = srcRect->y - d.vRadius;
+    int yCount = srcRect->h + vSize - 1;
+
+    for (int tx = 0; tx < srcRect->w; tx += tileW)
+    {
+      int tw = Math::min(tileW, srcRect->w - tx);
+      int fx = srcRect->x + tx - d.hRadius;
+      int fw = tw + hSize - 1;
+
+      size_t size = (size_t)tw * nc;
+      uint8_t* dstTile = dstPixels + tx * dstBpp;
+
+      int block = 0;
+      int offset = 0;
+
+      for (int t = 0; t < yCount; t++)
+      {
+        uint8_t* row = cur[offset];
+        int sy = FBorderBase::extendCoord(yStart + t, srcH, extendType);
+
+        // Horizontal pass.
+        if (sy >= 0)
+        {
+          FBorderBase::fetchRow(fetchRow, src->data + sy * src->stride,
+            fx, fw, srcW, format, extendType, extendPixel);
+          hFunc(row, fetchRow, tw, hSize, gRun, hRun);
+        }
+        else
+        {
+          MemOps::copy(row, colorRow, size);
+        }
+
+        // Prefix run of the current block.
+        if (offset == 0)
+          MemOps::copy(gRow, row, size);
+        else
+          vFunc(gRow, gRow, row, size);
+
+        // The window starting at (offset + 1) of the previous block ends here.
+        if (block > 0 && offset + 1 < vSize)
+        {
+          int y = (block - 1) * vSize + offset + 1;
+          if (y < srcRect->h)
+          {
+            vFunc(fetchRow, hPrev[offset + 1], gRow, size);
+            FBorderBase::storeRow(dstTile + y * dstStride, fetchRow, tw, dstFormat);
+          }
+        }
+
+        if (++offset == vSize)
+        {
+          // The block is complete, compute its suffix runs in-place, the first
+          // one is the window which starts at the beginning of the block.
+          for (i = vSize - 2; i >= 0; i--)
+            vFunc(cur[i], cur[i], cur[i + 1], size);
+
+          int y = block * vSize;
+          if (y < srcRect->h)
+            FBorderBase::storeRow(dstTile + y * dstStride, cur[0], tw, dstFormat);
+
+          uint8_t** tmp = hPrev;
+          hPrev = cur;
+          cur = tmp;
+
+          block++;
+          offset = 0;
+        }
+      }
+    }
+
+    FBorderBase::finishDst(dst, dstPos, srcRect, dstFormat, dstPixels, dstStride, copyBack);
+    return ERR_OK;
+  }
+
+  // ==========================================================================
+  // [Morphology - Horizontal]
+  // ==========================================================================
+
+  template<int NC, typename Op>
+  static void FOG_FASTCALL doH(
+    uint8_t* dst, const uint8_t* src, int w, int size,
+    uint8_t* g, uint8_t* h)
+  {
+    int n = w + size - 1;
+    int i, c, k;
+
+    // Prefix runs.
+    for (i = 0, k = 0; i < n; i++)
+    {
+      const uint8_t* s = src + i * NC;
+      uint8_t* gp = g + i * NC;
+
+      if (k == 0)
+      {
+        for (c = 0; c < NC; c++) gp[c] = s[c];
+      }
+      else
+      {
+        for (c = 0; c < NC; c++) gp[c] = Op::op(gp[c - NC], s[c]);
+      }
+
+      if (++k == size)
+        k = 0;
+    }
+
+    // Suffix runs, the blocks are aligned to the start of the row.
+    for (i = n - 1; i >= 0; i--)
+    {
+      const uint8_t* s = src + i * NC;
+      uint8_t* hp = h + i * NC;
+
+      if (i == n - 1 || (i + 1) % size == 0)
+      {
+        for (c = 0; c < NC; c++) hp[c] = s[c];
+      }
+      else
+      {
+        for (c = 0; c < NC; c++) hp[c] = Op::op(hp[c + NC], s[c]);
+      }
+    }
+
+    // Each window spans the suffix run of one block and the prefix run of
+    // the next one (the prefix run ending at the block end is the block).
+    doV<Op>(dst, h, g + (size - 1) * NC, (size_t)(uint)w * NC);
+  }
+
+  // ==========================================================================
+  // [Morphology - Vertical]
+  // ==========================================================================
+
+  template<typename Op>
+  static void FOG_FASTCALL doV(
+    uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t size)
+  {
+    for (size_t i = 0; i < size; i++)
+      dst[i] = Op::op(a[i], b[i]);
+  }
+};
+
+} // RasterOps_C namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_C_FILTERMORPHOLOGY_P_H
@@ -0,0 +1,589 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_C_FILTERTURBULENCE_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_C_FILTERTURBULENCE_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterFilterCache_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/FilterBase_p.h>
+
+namespace Fog {
+namespace RasterOps_C {
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - Turbulence - Cell]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Lattice cell of the noise position.
+struct FOG_NO_EXPORT FTurbulenceCell
+{
+  //! @brief Gradients of the cell corners (see @c RasterTurbulenceLattice).
+  const float* g00;
+  const float* g10;
+  const float* g01;
+  const float* g11;
+
+  //! @brief Position in the cell.
+  float rx0;
+  float ry0;
+
+  //! @brief Interpolation weights (s-curve of the position in the cell).
+  float sx;
+  float sy;
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - Turbulence - Key]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Key of the turbulence in @c RasterFilterCache.
+struct FOG_NO_EXPORT FTurbulenceKey
+{
+  uint32_t turbulenceType;
+  uint32_t numOctaves;
+  uint32_t stitchTiles;
+  int32_t seed;
+
+  float hBaseFrequency;
+  float vBaseFrequency;
+
+  uint32_t format;
+  int tileW;
+  int tileH;
+
+  RectI rect;
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - Filter - Turbulence]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Turbulence filter (SVG feTurbulence).
+//!
+//! Implements the reference algorithm of the SVG specification. The lattice
+//! is generated by create() from the seed, the noise of all four channels
+//! shares the lattice cell and differs only in gradients, which are stored
+//! interleaved so the channels can be computed at once.
+//!
+//! The turbulence doesn't depend on the source pixels, so the result is
+//! stored to @c RasterFilterCache and reused when the same filter is applied
+//! to the same rectangle again.
+struct FOG_NO_EXPORT FTurbulence
+{
+  enum
+  {
+    //! @brief Maximum number of octaves, the contribution of the next octaves
+    //! is less than the precision of 8-bit components.
+    MAX_OCTAVES = 16
+  };
+
+  // ==========================================================================
+  // [Turbulence - Random]
+  // ==========================================================================
+
+  // Park and Miller minimal standard random number generator (the constants
+  // are m = 2^31 - 1, a = 16807, q = m / a and r = m % a).
+  enum
+  {
+    RANDOM_M = 2147483647,
+    RANDOM_A = 16807,
+    RANDOM_Q = 127773,
+    RANDOM_R = 2836
+  };
+
+  static FOG_INLINE int32_t setupSeed(int32_t seed)
+  {
+    if (seed <= 0)
+      seed = -(seed % (RANDOM_M - 1)) + 1;
+    if (seed > RANDOM_M - 1)
+      seed = RANDOM_M - 1;
+    return seed;
+  }
+
+  static FOG_INLINE int32_t random(int32_t seed)
+  {
+    int32_t result = RANDOM_A * (seed % RANDOM_Q) - RANDOM_R * (seed / RANDOM_Q);
+    if (result <= 0)
+      result += RANDOM_M;
+    return result;
+  }
+
+  // ==========================================================================
+  // [Turbulence - Lattice]
+  // ==========================================================================
+
+  //! @brief Generate the lattice from @a seed.
+  //!
+  //! The random numbers are consumed in the order of the reference algorithm
+  //! (R, G, B and A channel gradients and then the lattice selector), only
+  //! the gradients are stored in the B, G, R, A order.
+  static void initLattice(RasterTurbulenceLattice* lattice, int32_t seed)
+  {
+    static const int channelIndex[4] = { 2, 1, 0, 3 };
+
+    int i, j, k;
+    seed = setupSeed(seed);
+
+    for (k = 0; k < 4; k++)
+    {
+      int c = channelIndex[k];
+
+      for (i = 0; i < RASTER_TURBULENCE_BSIZE; i++)
+      {
+        double g[2];
+
+        for (j = 0; j < 2; j++)
+        {
+          seed = random(seed);
+          g[j] = double((seed % (RASTER_TURBULENCE_BSIZE * 2)) - RASTER_TURBULENCE_BSIZE) /
+                 double(RASTER_TURBULENCE_BSIZE);
+        }
+
+        double s = Math::sqrt(g[0] * g[0] + g[1] * g[1]);
+        if (s > 0.0)
+        {
+          g[0] /= s;
+          g[1] /= s;
+        }
+
+        lattice->gradient[i][0][c] = float(g[0]);
+        lattice->gradient[i][1][c] = float(g[1]);
+      }
+    }
+
+    for (i = 0; i < RASTER_TURBULENCE_BSIZE; i++)
+      lattice->selector[i] = i;
+
+    while (--i)
+    {
+      seed = random(seed);
+      j = seed % RASTER_TURBULENCE_BSIZE;
+
+      k = lattice->selector[i];
+      lattice->selector[i] = lattice->selector[j];
+      lattice->selector[j] = k;
+    }
+
+    for (i = 0; i < RASTER_TURBULENCE_BSIZE + 2; i++)
+    {
+      lattice->selector[RASTER_TURBULENCE_BSIZE + i] = lattice->selector[i];
+      MemOps::copy(lattice->gradient[RASTER_TURBULENCE_BSIZE + i], lattice->gradient[i], sizeof(lattice->gradient[i]));
+    }
+  }
+
+  // ==========================================================================
+  // [Turbulence - Tile]
+  // ==========================================================================
+
+  //! @brief Adjust the base frequency @a freq so the tile of @a size pixels
+  //! contains an integral number of lattice cells.
+  static FOG_INLINE double stitchFrequency(double freq, int size)
+  {
+    if (freq == 0.0)
+      return freq;
+
+    double lo = Math::floor(double(size) * freq) / double(size);
+    double hi = Math::ceil(double(size) * freq) / double(size);
+
+    return (lo > 0.0 && freq / lo < hi / freq) ? lo : hi;
+  }
+
+  //! @brief Initialize the turbulence tile of @a tileW x @a tileH pixels.
+  static void initTile(RasterTurbulenceTile& tile,
+    const RasterFilter::_Turbulence& d, int tileW, int tileH)
+  {
+    double hFreq = d.hBaseFrequency;
+    double vFreq = d.vBaseFrequency;
+
+    tile.stitchTiles = d.stitchTiles;
+    tile.width = 0;
+    tile.height = 0;
+    tile.wrapX = 0;
+    tile.wrapY = 0;
+
+    if (d.stitchTiles)
+    {
+      hFreq = stitchFrequency(hFreq, tileW);
+      vFreq = stitchFrequency(vFreq, tileH);
+
+      tile.width = int(double(tileW) * hFreq + 0.5);
+      tile.height = int(double(tileH) * vFreq + 0.5);
+      tile.wrapX = RASTER_TURBULENCE_PERLIN_N + tile.width;
+      tile.wrapY = RASTER_TURBULENCE_PERLIN_N + tile.height;
+    }
+
+    tile.hBaseFrequency = float(hFreq);
+    tile.vBaseFrequency = float(vFreq);
+  }
+
+  //! @brief Advance the stitching information of @a tile to the next octave.
+  static FOG_INLINE void nextOctave(RasterTurbulenceTile& tile)
+  {
+    tile.width *= 2;
+    tile.height *= 2;
+    tile.wrapX = 2 * tile.wrapX - RASTER_TURBULENCE_PERLIN_N;
+    tile.wrapY = 2 * tile.wrapY - RASTER_TURBULENCE_PERLIN_N;
+  }
+
+  // ==========================================================================
+  // [Turbulence - Cell]
+  // ==========================================================================
+
+  //! @brief Get the lattice cell of the noise position [@a vx, @a vy], both
+  //! coordinates must be positive.
+  static FOG_INLINE void getCell(FTurbulenceCell& cell,
+    const RasterTurbulenceLattice* lattice, const RasterTurbulenceTile& tile,
+    float vx, float vy)
+  {
+    int ix = (int)vx;
+    int iy = (int)vy;
+
+    float rx0 = vx - (float)ix;
+    float ry0 = vy - (float)iy;
+
+    int bx0 = ix + RASTER_TURBULENCE_PERLIN_N;
+    int by0 = iy + RASTER_TURBULENCE_PERLIN_N;
+    int bx1 = bx0 + 1;
+    int by1 = by0 + 1;
+
+    if (tile.stitchTiles)
+    {
+      if (bx0 >= tile.wrapX) bx0 -= tile.width;
+      if (bx1 >= tile.wrapX) bx1 -= tile.width;
+      if (by0 >= tile.wrapY) by0 -= tile.height;
+      if (by1 >= tile.wrapY) by1 -= tile.height;
+    }
+
+    int i = lattice->selector[bx0 & RASTER_TURBULENCE_BMASK];
+    int j = lattice->selector[bx1 & RASTER_TURBULENCE_BMASK];
+
+    by0 &= RASTER_TURBULENCE_BMASK;
+    by1 &= RASTER_TURBULENCE_BMASK;
+
+    cell.g00 = lattice->gradient[lattice->selector[i + by0]][0];
+    cell.g10 = lattice->gradient[lattice->selector[j + by0]][0];
+    cell.g01 = lattice->gradient[lattice->selector[i + by1]][0];
+    cell.g11 = lattice->gradient[lattice->selector[j + by1]][0];
+
+    cell.rx0 = rx0;
+    cell.ry0 = ry0;
+    cell.sx = rx0 * rx0 * (3.0f - 2.0f * rx0);
+    cell.sy = ry0 * ry0 * (3.0f - 2.0f * ry0);
+  }
+
+  // ==========================================================================
+  // [Turbulence - Create]
+  // ==========================================================================
+
+  static err_t FOG_FASTCALL create(
+    RasterFilter* ctx, const FeBase* feBase, const ImageFilterScaleD* feScale,
+    MemBuffer* memBuffer,
+    uint32_t dstFormat,
+    uint32_t srcFormat)
+  {
+    FOG_ASSERT(feBase->getFeType() == FE_TYPE_TURBULENCE);
+    const FeTurbulence* feData = static_cast<const FeTurbulence*>(feBase);
+
+    // TODO: We should allow to mix some basic formats in the future.
+    if (dstFormat != srcFormat || dstFormat >= IMAGE_FORMAT_COUNT)
+      return ERR_IMAGE_INVALID_FORMAT;
+
+    uint32_t turbulenceType = feData->getTurbulenceType();
+    if (turbulenceType >= FE_TURBULENCE_TYPE_COUNT)
+      return ERR_RT_INVALID_ARGUMENT;
+
+    float hBaseFrequency = feData->getHorizontalBaseFrequency();
+    float vBaseFrequency = feData->getVerticalBaseFrequency();
+
+    // Negative (or NaN) base frequency is an error.
+    if (!(hBaseFrequency >= 0.0f) || !(vBaseFrequency >= 0.0f))
+      return ERR_RT_INVALID_ARGUMENT;
+
+    // The base frequency is in user units, convert it to pixels.
+    if (feScale != NULL)
+    {
+      float hScale = Math::abs(float(feScale->_pt.x));
+      float vScale = Math::abs(float(feScale->_pt.y));
+
+      if (hScale > 0.0f) hBaseFrequency /= hScale;
+      if (vScale > 0.0f) vBaseFrequency /= vScale;
+
+      if (feScale->isSwapped())
+        swap(hBaseFrequency, vBaseFrequency);
+    }
+
+    RasterFilter::_Turbulence& d = ctx->turbulence;
+
+    d.func = _api_raster.filter.turbulence[turbulenceType];
+    if (d.func == NULL)
+      return ERR_RT_NOT_IMPLEMENTED;
+
+    d.lattice = reinterpret_cast<RasterTurbulenceLattice*>(
+      MemMgr::alloc(sizeof(RasterTurbulenceLattice)));
+
+    if (FOG_IS_NULL(d.lattice))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    d.turbulenceType = turbulenceType;
+    d.numOctaves = Math::min<uint32_t>(feData->getNumOctaves(), MAX_OCTAVES);
+    d.stitchTiles = feData->getStitchTitles();
+    d.seed = feData->getSeed();
+
+    d.hBaseFrequency = hBaseFrequency;
+    d.vBaseFrequency = vBaseFrequency;
+
+    initLattice(d.lattice, d.seed);
+
+    ctx->reference.init(1);
+    ctx->destroy = destroy;
+
+    ctx->doRect = doRect;
+    ctx->doLine = NULL;
+
+    ctx->memBuffer = memBuffer;
+    ctx->dstFormat = dstFormat;
+    ctx->srcFormat = srcFormat;
+
+    return ERR_OK;
+  }
+
+  // ==========================================================================
+  // [Turbulence - Destroy]
+  // ==========================================================================
+
+  static void FOG_FASTCALL destroy(
+    RasterFilter* ctx)
+  {
+    MemMgr::free(ctx->turbulence.lattice);
+
+    // Just be safe and detect possible NULL pointer dereference.
+    ctx->destroy = NULL;
+    ctx->doRect = NULL;
+    ctx->doLine = NULL;
+  }
+
+  // ==========================================================================
+  // [Turbulence - DoRect]
+  // ==========================================================================
+
+  static err_t FOG_FASTCALL doRect(
+    RasterFilter* ctx,
+    RasterFilterImage* dst, const PointI* dstPos,
+    RasterFilterImage* src, const RectI* srcRect,
+    MemBuffer* intermediateBuffer)
+  {
+    FOG_ASSERT(srcRect->x >= 0);
+    FOG_ASSERT(srcRect->y >= 0);
+    FOG_ASSERT(srcRect->x + srcRect->w <= src->size.w);
+    FOG_ASSERT(srcRect->y + srcRect->h <= src->size.h);
+
+    const RasterFilter::_Turbulence& d = ctx->turbulence;
+
+    MemBufferTmp<1024> memBufferTmp;
+    MemBuffer* memBuffer = &memBufferTmp;
+
+    if (ctx->memBuffer)
+      memBuffer = ctx->memBuffer;
+
+    if (srcRect->w <= 0 || srcRect->h <= 0)
+      return ERR_OK;
+
+    uint32_t dstFormat = ctx->dstFormat;
+
+    int w = srcRect->w;
+    int h = srcRect->h;
+
+    // The source pixels are not used, so the turbulence can be always stored
+    // directly to the destination.
+    uint8_t* dstPixels;
+    ssize_t dstStride;
+
+    if (dst->data == NULL)
+    {
+      bool copyBack;
+      FOG_RETURN_ON_ERROR(FBorderBase::prepareDst(dst, dstPos, src, srcRect,
+        dstFormat, intermediateBuffer, dstPixels, dstStride, copyBack));
+    }
+    else
+    {
+      dstStride = dst->stride;
+      dstPixels = dst->data + dstPos->y * dstStride +
+        dstPos->x * ImageFormatDescription::getByFormat(dstFormat).getBytesPerPixel();
+    }
+
+    // ------------------------------------------------------------------------
+    // [Cache]
+    // ------------------------------------------------------------------------
+
+    FTurbulenceKey key;
+    MemOps::zero(&key, sizeof(FTurbulenceKey));
+
+    key.turbulenceType = d.turbulenceType;
+    key.numOctaves = d.numOctaves;
+    key.stitchTiles = d.stitchTiles;
+    key.seed = d.seed;
+    key.hBaseFrequency = d.hBaseFrequency;
+    key.vBaseFrequency = d.vBaseFrequency;
+    key.format = dstFormat;
+    key.tileW = src->size.w;
+    key.tileH = src->size.h;
+    key.rect = *srcRect;
+
+    if (RasterFilterCache::get(&key, sizeof(FTurbulenceKey), dstPixels, dstStride, w, h, dstFormat))
+      return ERR_OK;
+
+    // ------------------------------------------------------------------------
+    // [Generate]
+    // ------------------------------------------------------------------------
+
+    uint8_t* row = NULL;
+
+    if (dstFormat != IMAGE_FORMAT_PRGB32)
+    {
+      row = reinterpret_cast<uint8_t*>(memBuffer->alloc((size_t)(uint)w * 4));
+      if (FOG_IS_NULL(row))
+        return ERR_RT_OUT_OF_MEMORY;
+    }
+
+    RasterTurbulenceTile tile;
+    initTile(tile, d, src->size.w, src->size.h);
+
+    RasterFilterTurbulenceFunc func = d.func;
+    uint8_t* dstRow = dstPixels;
+
+    for (int y = 0; y < h; y++, dstRow += dstStride)
+    {
+      if (row == NULL)
+      {
+        func(dstRow, ctx, &tile, srcRect->x, srcRect->y + y, w);
+        continue;
+      }
+
+      func(row, ctx, &tile, srcRect->x, srcRect->y + y, w);
+
+      if (dstFormat == IMAGE_FORMAT_A8)
+      {
+        for (int i = 0; i < w; i++)
+        {
+          uint32_t c0;
+          Acc::p32Load4a(c0, row + i * 4);
+          row[i] = (uint8_t)(c0 >> 24);
+        }
+      }
+
+      FBorderBase::storeRow(dstRow, row, w, dstFormat);
+    }
+
+    RasterFilterCache::put(&key, sizeof(FTurbulenceKey), dstPixels, dstStride, w, h, dstFormat);
+    return ERR_OK;
+  }
+
+  // ==========================================================================
+  // [Turbulence - Generate]
+  // ==========================================================================
+
+  //! @brief Generate the turbulence, see @c RasterFilterTurbulenceFunc.
+  template<uint32_t TurbulenceType>
+  static void FOG_FASTCALL doTurbulence(
+    uint8_t* dst, const RasterFilter* ctx, const RasterTurbulenceTile* tile,
+    int x, int y, int w)
+  {
+    const RasterFilter::_Turbulence& d = ctx->turbulence;
+    const RasterTurbulenceLattice* lattice = d.lattice;
+
+    uint32_t numOctaves = d.numOctaves;
+    float py = (float)y * tile->vBaseFrequency;
+
+    for (int i = 0; i < w; i++, dst += 4)
+    {
+      RasterTurbulenceTile t = *tile;
+
+      float vx = (float)(x + i) * tile->hBaseFrequency;
+      float vy = py;
+      float ratio = 1.0f;
+
+      float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+      FTurbulenceCell cell;
+
+      for (uint32_t octave = 0; octave < numOctaves; octave++)
+      {
+        getCell(cell, lattice, t, vx, vy);
+
+        float rx1 = cell.rx0 - 1.0f;
+        float ry1 = cell.ry0 - 1.0f;
+
+        for (int c = 0; c < 4; c++)
+        {
+          float u, v, a, b, n;
+
+          u = cell.rx0 * cell.g00[c] + cell.ry0 * cell.g00[4 + c];
+          v = rx1      * cell.g10[c] + cell.ry0 * cell.g10[4 + c];
+          a = u + cell.sx * (v - u);
+
+          u = cell.rx0 * cell.g01[c] + ry1      * cell.g01[4 + c];
+          v = rx1      * cell.g11[c] + ry1      * cell.g11[4 + c];
+          b = u + cell.sx * (v - u);
+
+          n = a + cell.sy * (b - a);
+
+          if (TurbulenceType == FE_TURBULENCE_TYPE_FRACTAL_NOISE)
+            sum[c] += n * ratio;
+          else
+            sum[c] += Math::abs(n) * ratio;
+        }
+
+        vx *= 2.0f;
+        vy *= 2.0f;
+        ratio *= 0.5f;
+
+        if (t.stitchTiles)
+          nextOctave(t);
+      }
+
+      storePixel<TurbulenceType>(dst, sum);
+    }
+  }
+
+  //! @brief Convert the turbulence sums of B, G, R, A channels to a
+  //! premultiplied pixel.
+  template<uint32_t TurbulenceType>
+  static FOG_INLINE void storePixel(uint8_t* dst, const float* sum)
+  {
+    float c[4];
+
+    for (int i = 0; i < 4; i++)
+    {
+      if (TurbulenceType == FE_TURBULENCE_TYPE_FRACTAL_NOISE)
+        c[i] = (sum[i] * 255.0f + 255.0f) * 0.5f;
+      else
+        c[i] = sum[i] * 255.0f;
+
+      c[i] = Math::bound<float>(c[i], 0.0f, 255.0f);
+    }
+
+    float am = c[3] * (1.0f / 255.0f);
+
+    uint32_t b = (uint32_t)(c[0] * am + 0.5f);
+    uint32_t g = (uint32_t)(c[1] * am + 0.5f);
+    uint32_t r = (uint32_t)(c[2] * am + 0.5f);
+    uint32_t a = (uint32_t)(c[3] + 0.5f);
+
+    Acc::p32Store4a(dst, _FOG_ACC_COMBINE_4(a << 24, r << 16, g << 8, b));
+  }
+};
+
+} // RasterOps_C namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_C_FILTERTURBULENCE_P_H
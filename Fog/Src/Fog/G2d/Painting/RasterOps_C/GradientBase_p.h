@@ -9,6 +9,7 @@
 
 // [Dependencies]
 #include <Fog/G2d/Geometry/Math2d.h>
+#include <Fog/G2d/Painting/RasterGradientCache_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/BaseDefs_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/BaseHelpers_p.h>
 
@@ -184,7 +185,7 @@ struct FOG_NO_EXPORT PGradientBase
 
   static err_t FOG_FASTCALL create(
     RasterPattern* ctx, uint32_t dstFormat, const BoxI* boundingBox,
-    uint32_t spread, const ColorStopList* stops)
+    uint32_t spread, const ColorStopList* stops, double extent)
   {
     FOG_ASSERT(spread < GRADIENT_SPREAD_COUNT);
 
@@ -198,33 +199,31 @@ struct FOG_NO_EXPORT PGradientBase
         bool isOpaque = stops->isOpaqueARGB32();
         // Decide which pixel format to use.
         uint32_t srcFormat = isOpaque ? IMAGE_FORMAT_XRGB32 : IMAGE_FORMAT_PRGB32;
+        // Decide the length of the color-table.
+        uint32_t length = get_optimal_cache_length(stops, extent);
 
-        // Get or create the color-table (ColorStopCache instance).
+        // Get or create the color-table (ColorStopCache instance). The table
+        // held by the ColorStopList instance is used only if its length
+        // matches, otherwise the table is taken from the shared cache.
         ColorStopCache* cache = AtomicCore<ColorStopCache*>::get(&stops->_d->stopCachePrgb32);
-        if (cache != NULL)
+        if (cache != NULL && cache->getLength() == length)
         {
           cache->reference.inc();
         }
         else
         {
-          // Try to create the color-stop cache.
-          cache = ColorStopCache::create32(srcFormat, get_optimal_cache_length(stops));
+          cache = RasterGradientCache::getOrCreate(stops, srcFormat, length);
           if (FOG_IS_NULL(cache)) return ERR_RT_OUT_OF_MEMORY;
 
-          cache->reference.init(2);
-
-          _api_raster.gradient.interpolate[srcFormat](
-            reinterpret_cast<uint8_t*>(cache->getData()), cache->getLength(), stops->getList(), stops->getLength());
-
-          // Assign also the end point.
-          uint32_t* table = reinterpret_cast<uint32_t*>(cache->getData());
-          table[cache->getLength()] = table[cache->getLength() - 1];
-
-          // Try to add it back to the ColorStopList instance. If we failed then
-          // some other thread was faster than us, in this case it's needed to
-          // decrease the reference count of the instance we created.
-          if (!AtomicCore<ColorStopCache*>::cmpXchg(&stops->_d->stopCachePrgb32, (ColorStopCache*)NULL, cache))
-            cache->reference.dec();
+          // Try to add it back to the ColorStopList instance (only if there
+          // is no table yet). If we failed then some other thread was faster
+          // than us, in this case it's needed to decrease the reference count.
+          if (stops->_d->stopCachePrgb32 == NULL)
+          {
+            cache->reference.inc();
+            if (!AtomicCore<ColorStopCache*>::cmpXchg(&stops->_d->stopCachePrgb32, (ColorStopCache*)NULL, cache))
+              cache->reference.dec();
+          }
         }
 
         // Setup the context.
@@ -262,35 +261,53 @@ struct FOG_NO_EXPORT PGradientBase
   // [Helpers - Cache]
   // ==========================================================================
 
-  static int FOG_FASTCALL get_optimal_cache_length(const ColorStopList* stops)
+  //! @brief Get the optimal length of the color-table.
+  //!
+  //! The length is based on the distances between the color-stops and then
+  //! limited by @a extent, which is the length of the gradient vector (in
+  //! device pixels). The table never needs to be longer than the count of
+  //! pixels it's stretched over, so small gradients use small tables. The
+  //! result is a power of two, so the tables can be shared by gradients of
+  //! a similar size.
+  static uint32_t FOG_FASTCALL get_optimal_cache_length(const ColorStopList* stops, double extent)
   {
+    uint32_t length;
     size_t len = stops->getLength();
+
     if (len == 2)
     {
       float diff = stops->getAt(1).getOffset() - stops->getAt(0).getOffset();
-      return (diff == 1.0f) ? 128 : (diff >= 0.5f) ? 256 : 512;
+      length = (diff == 1.0f) ? 128 : (diff >= 0.5f) ? 256 : 512;
     }
     else if (len == 3)
     {
-      return (stops->getAt(0).getOffset() == 0.0f &&
-              stops->getAt(1).getOffset() == 0.5f &&
-              stops->getAt(2).getOffset() == 1.0f) ? 256 : 512;
+      length = (stops->getAt(0).getOffset() == 0.0f &&
+                stops->getAt(1).getOffset() == 0.5f &&
+                stops->getAt(2).getOffset() == 1.0f) ? 256 : 512;
     }
     else
     {
-      float oPrev = 0.0f;
+      float oPrev = stops->getAt(0).getOffset();
       float maxDiff = 1.0f;
 
       // First get the minimal difference between stops.
-      for (size_t i = 0; i < len; i++)
+      for (size_t i = 1; i < len; i++)
       {
         float oStop = stops->getAt(i).getOffset();
         float oDiff = oStop - oPrev;
         if (maxDiff > oDiff) maxDiff = oDiff;
+        oPrev = oStop;
       }
 
-      return (maxDiff < 0.02f) ? 1024 : 512;
+      length = (maxDiff < 0.02f) ? RASTER_GRADIENT_CACHE_MAX_LENGTH : 512;
     }
+
+    // Limit the length by the extent.
+    uint32_t limit = RASTER_GRADIENT_CACHE_MIN_LENGTH;
+    while (limit < length && (double)limit < extent)
+      limit <<= 1;
+
+    return Math::min(length, limit);
   }
 };
 
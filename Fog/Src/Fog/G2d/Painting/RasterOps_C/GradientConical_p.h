@@ -69,7 +69,16 @@ struct FOG_NO_EXPORT PGradientConical
     // [Prepare]
     // ------------------------------------------------------------------------
 
-    FOG_RETURN_ON_ERROR(PGradientBase::create(ctx, dstFormat, clipBox, spread, &stops));
+    // The color-table is mapped to the full angle, the extent is the length
+    // of the circle going through the farthest corner of the clip-box.
+    PointD center;
+    tr->mapPoint(center, gradient->_pts[0]);
+
+    double extent = MATH_TWO_PI * Math::hypot(
+      Math::max(Math::abs(center.x - (double)clipBox->x0), Math::abs(center.x - (double)clipBox->x1)),
+      Math::max(Math::abs(center.y - (double)clipBox->y0), Math::abs(center.y - (double)clipBox->y1)));
+
+    FOG_RETURN_ON_ERROR(PGradientBase::create(ctx, dstFormat, clipBox, spread, &stops, extent));
     int tableLength = ctx->_d.gradient.base.len;
 
     // TODO:
@@ -74,7 +74,9 @@ struct FOG_NO_EXPORT PGradientLinear
       return Helpers::p_solid_create_color(ctx, dstFormat, &stop._color);
     }
 
-    FOG_RETURN_ON_ERROR(PGradientBase::create(ctx, dstFormat, clipBox, spread, &stops));
+    double extent = pd_dist * tr->getAverageScaling();
+
+    FOG_RETURN_ON_ERROR(PGradientBase::create(ctx, dstFormat, clipBox, spread, &stops, extent));
     int tableLength = ctx->_d.gradient.base.len;
 
     // TODO:
@@ -85,7 +85,11 @@ struct FOG_NO_EXPORT PGradientRadial
     // [Prepare]
     // ------------------------------------------------------------------------
 
-    FOG_RETURN_ON_ERROR(PGradientBase::create(ctx, dstFormat, clipBox, spread, &stops));
+    // The longest gradient vector goes from the focal point to the opposite
+    // side of the circle.
+    double extent = (r + Math::hypot(fx - cx, fy - cy)) * t.getAverageScaling();
+
+    FOG_RETURN_ON_ERROR(PGradientBase::create(ctx, dstFormat, clipBox, spread, &stops, extent));
     int tableLength = ctx->_d.gradient.base.len;
 
     // TODO:
@@ -69,7 +69,11 @@ struct FOG_NO_EXPORT PGradientRectangular
     // [Prepare]
     // ------------------------------------------------------------------------
 
-    FOG_RETURN_ON_ERROR(PGradientBase::create(ctx, dstFormat, clipBox, spread, &stops));
+    double extent = Math::max(
+      Math::max(Math::abs(gradient->_pts[0].x - fx), Math::abs(gradient->_pts[0].y - fy)),
+      Math::max(Math::abs(gradient->_pts[1].x - fx), Math::abs(gradient->_pts[1].y - fy))) * tr->getAverageScaling();
+
+    FOG_RETURN_ON_ERROR(PGradientBase::create(ctx, dstFormat, clipBox, spread, &stops, extent));
     int tableLength = ctx->_d.gradient.base.len;
 
     // TODO:
@@ -318,6 +318,7 @@ _Has16BPC:
 
       // TODO: Not always true.
       ctx->_d.texture.affine.safeFixedPoint = true;
+      ctx->_d.texture.affine.scale = 0;
 
       // Setup functions.
       if (tileMode == TEXTURE_TILE_PAD || tileMode == TEXTURE_TILE_CLAMP)
@@ -331,6 +332,18 @@ _Has16BPC:
         ctx->_skip = skip_affine_repeat_reflect;
       }
 
+      // Axis-aligned transforms (integer scaling and rotation by a multiple of
+      // 90 degrees) have faster fetchers, see PTextureOrtho.
+      if (tileMode == TEXTURE_TILE_PAD)
+      {
+        RasterPatternFetchFunc fetch = _setupOrtho(ctx, fetchFuncs, srcFormat, inv, imageQuality);
+        if (fetch != NULL)
+        {
+          ctx->_fetch = fetch;
+          return ERR_OK;
+        }
+      }
+
       if (imageQuality == IMAGE_QUALITY_NEAREST)
         ctx->_fetch = fetchFuncs->fetch_affine_nearest[srcFormat][tileMode];
       else
@@ -349,6 +362,113 @@ _Has16BPC:
     }
   }
 
+  // ==========================================================================
+  // [Ortho]
+  // ==========================================================================
+
+  //! @brief Get the axis-aligned fetcher for the inverted transform @a inv and
+  //! adjust the affine context for it, NULL is returned if there is no such
+  //! fetcher (the generic affine fetcher should be used).
+  //!
+  //! The copy and box fetchers sample pixel centers (the affine offset is not
+  //! translated back for bilinear filter).
+  static RasterPatternFetchFunc _setupOrtho(
+    RasterPattern* ctx, const RasterTextureFuncs::_Fetch* fetchFuncs, uint32_t srcFormat,
+    const TransformD& inv, uint32_t imageQuality)
+  {
+    RasterPatternFetchFunc fetch;
+
+    int t20, t21;
+    bool isIntTranslation = Math::isFuzzyToInt(inv._20, t20) &&
+                            Math::isFuzzyToInt(inv._21, t21);
+
+    // ------------------------------------------------------------------------
+    // [Rotation by a Multiple of 90 Degrees / Flip]
+    // ------------------------------------------------------------------------
+
+    int m00, m01, m10, m11;
+
+    if (isIntTranslation &&
+        Math::isFuzzyToInt(inv._00, m00) && Math::isFuzzyToInt(inv._01, m01) &&
+        Math::isFuzzyToInt(inv._10, m10) && Math::isFuzzyToInt(inv._11, m11) &&
+        Math::abs(m00) + Math::abs(m01) == 1 &&
+        Math::abs(m10) + Math::abs(m11) == 1 &&
+        Math::abs(m00) + Math::abs(m10) == 1)
+    {
+      fetch = fetchFuncs->fetch_ortho_copy[srcFormat][TEXTURE_TILE_PAD];
+      if (fetch == NULL)
+        return NULL;
+
+      _setupOrthoAffine(ctx, m00, m01, m10, m11, t20, t21);
+      return fetch;
+    }
+
+    if (!ctx->_d.texture.affine.xyZero)
+      return NULL;
+
+    double xx = inv._00;
+    int scale;
+
+    // ------------------------------------------------------------------------
+    // [Upscale]
+    // ------------------------------------------------------------------------
+
+    if (xx > 0.0 && xx < 1.0)
+    {
+      if (imageQuality != IMAGE_QUALITY_NEAREST)
+        return fetchFuncs->fetch_upscale_bilinear[srcFormat][TEXTURE_TILE_PAD];
+
+      // Only the integer upscale can replicate pixels.
+      if (!Math::isFuzzyToInt(1.0 / xx, scale) || scale > 16)
+        return NULL;
+
+      fetch = fetchFuncs->fetch_upscale_nearest[srcFormat][TEXTURE_TILE_PAD];
+      if (fetch == NULL)
+        return NULL;
+
+      ctx->_d.texture.affine.scale = scale;
+      return fetch;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Downscale]
+    // ------------------------------------------------------------------------
+
+    if (imageQuality != IMAGE_QUALITY_NEAREST && isIntTranslation &&
+        Math::isFuzzyZero(inv._10) &&
+        Math::isFuzzyToInt(xx, scale) && (scale == 2 || scale == 4) &&
+        Math::isFuzzyEq(inv._11, (double)scale))
+    {
+      fetch = fetchFuncs->fetch_downscale_box[srcFormat][TEXTURE_TILE_PAD];
+      if (fetch == NULL)
+        return NULL;
+
+      _setupOrthoAffine(ctx, scale, 0, 0, scale, t20, t21);
+      ctx->_d.texture.affine.scale = scale;
+      return fetch;
+    }
+
+    return NULL;
+  }
+
+  static void _setupOrthoAffine(
+    RasterPattern* ctx, int xx, int xy, int yx, int yy, int tx, int ty)
+  {
+    ctx->_d.texture.affine.tx = 0.5 * (double)(xx + yx) + (double)tx;
+    ctx->_d.texture.affine.ty = 0.5 * (double)(xy + yy) + (double)ty;
+
+    ctx->_d.texture.affine.xx = (double)xx;
+    ctx->_d.texture.affine.xy = (double)xy;
+    ctx->_d.texture.affine.yx = (double)yx;
+    ctx->_d.texture.affine.yy = (double)yy;
+
+    ctx->_d.texture.affine.xx16x16 = xx << 16;
+    ctx->_d.texture.affine.xy16x16 = xy << 16;
+
+    ctx->_d.texture.affine.xxZero = (xx == 0);
+    ctx->_d.texture.affine.xyZero = (xy == 0);
+  }
+
   // ==========================================================================
   // [Destroy]
   // ==========================================================================
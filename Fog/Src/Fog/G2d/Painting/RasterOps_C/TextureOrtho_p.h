@@ -0,0 +1,521 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_C_TEXTUREORTHO_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_C_TEXTUREORTHO_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_C/TextureBase_p.h>
+
+namespace Fog {
+namespace RasterOps_C {
+
+// ============================================================================
+// [Fog::RasterOps_C - PTextureOrtho]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Texture fetchers for axis-aligned affine transforms.
+//!
+//! These fetchers are selected by @c PTextureBase::create() instead of the
+//! generic affine fetchers if the inverted transform is:
+//!
+//!   - rotation by a multiple of 90 degrees or flip with integer translation
+//!     (@c fetch_ortho_copy_pad), pixels are copied,
+//!   - horizontal upscale by an integer factor (@c fetch_upscale_nearest_pad),
+//!     pixels are replicated,
+//!   - horizontal upscale without skew (@c fetch_upscale_bilinear_pad), the
+//!     vertically interpolated source columns are reused by neighbor pixels,
+//!   - exact 1/2 or 1/4 downscale with integer translation
+//!     (@c fetch_downscale_box_pad), pixels are box-averaged.
+//!
+//! All fetchers use the affine context and the affine prepare/skip functions,
+//! only @c TEXTURE_TILE_PAD is supported.
+struct FOG_NO_EXPORT PTextureOrtho
+{
+  // --------------------------------------------------------------------------
+  // [Constants]
+  // --------------------------------------------------------------------------
+
+  enum { MAX_FIXED_STEP = 128 };
+
+  // --------------------------------------------------------------------------
+  // [Fetch - Ortho (Copy) - Pad]
+  // --------------------------------------------------------------------------
+
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_ortho_copy_pad(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+    Accessor accessor(ctx);
+
+    // ------------------------------------------------------------------------
+    // [Prepare]
+    // ------------------------------------------------------------------------
+
+    int tw = ctx->_d.texture.base.w - 1;
+    int th = ctx->_d.texture.base.h - 1;
+
+    const uint8_t* srcLine = ctx->_d.texture.base.pixels;
+    ssize_t srcStride = ctx->_d.texture.base.stride;
+
+    // Transform contains only -1, 0 or 1, the source coordinates are centered
+    // to (0.5, 0.5), so the floor is safe.
+    int offx = (int)Math::floor(fetcher->_d.texture.affine.px);
+    int offy = (int)Math::floor(fetcher->_d.texture.affine.py);
+
+    // All pixels fetched from the scanline are in one source row or column,
+    // 'u' is position in that row or column and 'du' is its increment (-1/1).
+    int u0;
+    int du;
+    int uMax;
+    ssize_t uStride;
+
+    if (ctx->_d.texture.affine.xy16x16 == 0)
+    {
+      srcLine += Math::bound<int>(offy, 0, th) * srcStride;
+
+      u0 = offx;
+      du = ctx->_d.texture.affine.xx16x16 >> 16;
+      uMax = tw;
+      uStride = Accessor::SRC_BPP;
+    }
+    else
+    {
+      srcLine += Math::bound<int>(offx, 0, tw) * Accessor::SRC_BPP;
+
+      u0 = offy;
+      du = ctx->_d.texture.affine.xy16x16 >> 16;
+      uMax = th;
+      uStride = srcStride;
+    }
+
+    P_FETCH_SPAN8_INIT()
+
+    // ------------------------------------------------------------------------
+    // [Loop]
+    // ------------------------------------------------------------------------
+
+    P_FETCH_SPAN8_BEGIN()
+      P_FETCH_SPAN8_SET_CURRENT()
+
+      int u = u0 + x * du;
+      int uLast = u + (w - 1) * du;
+
+      // ----------------------------------------------------------------------
+      // [Reference]
+      // ----------------------------------------------------------------------
+
+      if (((uint)u <= (uint)uMax) & ((uint)uLast <= (uint)uMax))
+      {
+        const uint8_t* src = srcLine + (ssize_t)u * uStride;
+
+        if (Accessor::FETCH_REFERENCE && fetcher->_mode == RASTER_FETCH_REFERENCE && uStride == Accessor::SRC_BPP && du == 1)
+        {
+          P_FETCH_SPAN8_SET_CUSTOM(src);
+          goto _FetchSkip;
+        }
+
+        // --------------------------------------------------------------------
+        // [Fetch]
+        // --------------------------------------------------------------------
+
+        ssize_t srcInc = uStride * du;
+
+        do {
+          typename Accessor::Pixel pix;
+          accessor.fetchNorm(pix, src);
+          accessor.store(dst, pix);
+
+          dst += Accessor::DST_BPP;
+          src += srcInc;
+        } while (--w);
+      }
+
+      // ----------------------------------------------------------------------
+      // [Pad]
+      // ----------------------------------------------------------------------
+
+      else
+      {
+        do {
+          int uc = Math::bound<int>(u, 0, uMax);
+
+          typename Accessor::Pixel pix;
+          accessor.fetchNorm(pix, srcLine + (ssize_t)uc * uStride);
+          accessor.store(dst, pix);
+
+          dst += Accessor::DST_BPP;
+          u += du;
+        } while (--w);
+      }
+
+_FetchSkip:
+      P_FETCH_SPAN8_NEXT()
+    P_FETCH_SPAN8_END()
+
+    // ------------------------------------------------------------------------
+    // [Advance]
+    // ------------------------------------------------------------------------
+
+    fetcher->_d.texture.affine.px += fetcher->_d.texture.affine.dx;
+    fetcher->_d.texture.affine.py += fetcher->_d.texture.affine.dy;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Fetch - Upscale (Nearest) - Pad]
+  // --------------------------------------------------------------------------
+
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_upscale_nearest_pad(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+    Accessor accessor(ctx);
+
+    // ------------------------------------------------------------------------
+    // [Prepare]
+    // ------------------------------------------------------------------------
+
+    int tw = ctx->_d.texture.base.w - 1;
+    int th = ctx->_d.texture.base.h - 1;
+    int scale = ctx->_d.texture.affine.scale;
+
+    const uint8_t* srcLine = ctx->_d.texture.base.pixels +
+      Math::bound<int>((int)Math::floor(fetcher->_d.texture.affine.py), 0, th) * ctx->_d.texture.base.stride;
+
+    // Position of the first pixel in 1/scale units, each source pixel covers
+    // exactly 'scale' destination pixels.
+    int n0 = (int)Math::floor(fetcher->_d.texture.affine.px * (double)scale);
+    typename Accessor::Pixel pix;
+
+    P_FETCH_SPAN8_INIT()
+
+    // ------------------------------------------------------------------------
+    // [Loop]
+    // ------------------------------------------------------------------------
+
+    P_FETCH_SPAN8_BEGIN()
+      P_FETCH_SPAN8_SET_CURRENT()
+
+      int n = n0 + x;
+      int px = (n >= 0) ? n / scale : -((scale - 1 - n) / scale);
+      int i = (px + 1) * scale - n;
+
+      // ----------------------------------------------------------------------
+      // [Pad]
+      // ----------------------------------------------------------------------
+
+      if (px < 0)
+      {
+        i = Math::min<int>(-n, w);
+        w -= i;
+
+        accessor.fetchNorm(pix, srcLine);
+        dst = accessor.fill(dst, pix, i);
+        if (w == 0) goto _FetchSkip;
+
+        px = 0;
+        i = scale;
+      }
+
+      // ----------------------------------------------------------------------
+      // [Replicate]
+      // ----------------------------------------------------------------------
+
+      while (px <= tw)
+      {
+        i = Math::min<int>(i, w);
+        w -= i;
+
+        accessor.fetchNorm(pix, srcLine + (uint)px * Accessor::SRC_BPP);
+        do {
+          accessor.store(dst, pix);
+          dst += Accessor::DST_BPP;
+        } while (--i);
+        if (w == 0) goto _FetchSkip;
+
+        px++;
+        i = scale;
+      }
+
+      // ----------------------------------------------------------------------
+      // [Pad]
+      // ----------------------------------------------------------------------
+
+      accessor.fetchNorm(pix, srcLine + (uint)tw * Accessor::SRC_BPP);
+      dst = accessor.fill(dst, pix, w);
+
+_FetchSkip:
+      P_FETCH_SPAN8_NEXT()
+    P_FETCH_SPAN8_END()
+
+    // ------------------------------------------------------------------------
+    // [Advance]
+    // ------------------------------------------------------------------------
+
+    fetcher->_d.texture.affine.px += fetcher->_d.texture.affine.dx;
+    fetcher->_d.texture.affine.py += fetcher->_d.texture.affine.dy;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Fetch - Upscale (Bilinear) - Pad]
+  // --------------------------------------------------------------------------
+
+  template<typename Accessor>
+  static FOG_INLINE void _fetch_column(Accessor& accessor,
+    typename Accessor::Pixel& dst, const uint8_t* srcLine0, const uint8_t* srcLine1, int px, uint32_t wy, uint32_t inv_wy)
+  {
+    typename Accessor::Pixel pix_y0;
+    typename Accessor::Pixel pix_y1;
+
+    accessor.fetchRaw(pix_y0, srcLine0 + (uint)px * Accessor::SRC_BPP);
+    accessor.fetchRaw(pix_y1, srcLine1 + (uint)px * Accessor::SRC_BPP);
+    accessor.interpolateRaw_2(dst, pix_y0, inv_wy, pix_y1, wy);
+  }
+
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_upscale_bilinear_pad(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+    Accessor accessor(ctx);
+
+    // ------------------------------------------------------------------------
+    // [Prepare]
+    // ------------------------------------------------------------------------
+
+    int tw = ctx->_d.texture.base.w - 1;
+    int th = ctx->_d.texture.base.h - 1;
+
+    double xx = ctx->_d.texture.affine.xx;
+    int xx16x16 = ctx->_d.texture.affine.xx16x16;
+
+    double offx = fetcher->_d.texture.affine.px;
+    double offy = fetcher->_d.texture.affine.py;
+
+    int py = Math::fixed16x16FromFloat(offy);
+    int py0 = py >> 16;
+
+    uint32_t wy = (uint)(py >> 8) & 0xFF;
+    uint32_t inv_wy = 0x100 - wy;
+
+    const uint8_t* srcLine0 = ctx->_d.texture.base.pixels;
+    const uint8_t* srcLine1 = ctx->_d.texture.base.pixels;
+
+    if (py0 >= 0)
+    {
+      srcLine0 += Math::min<int>(py0    , th) * ctx->_d.texture.base.stride;
+      srcLine1 += Math::min<int>(py0 + 1, th) * ctx->_d.texture.base.stride;
+    }
+
+    P_FETCH_SPAN8_INIT()
+
+    // ------------------------------------------------------------------------
+    // [Loop]
+    // ------------------------------------------------------------------------
+
+    P_FETCH_SPAN8_BEGIN()
+      P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(Accessor::DST_BPP)
+      double _x = (double)x;
+
+      // Vertically interpolated columns at 'cx' and 'cx + 1'. The scale is
+      // less than 1.0 so each column is used by at least one pixel and the
+      // right column becomes the left one when advancing.
+      typename Accessor::Pixel col0;
+      typename Accessor::Pixel col1;
+
+      int px = Math::fixed16x16FromFloat(offx + _x * xx);
+      int cx = px >> 16;
+
+      _fetch_column<Accessor>(accessor, col0, srcLine0, srcLine1, Math::bound<int>(cx    , 0, tw), wy, inv_wy);
+      _fetch_column<Accessor>(accessor, col1, srcLine0, srcLine1, Math::bound<int>(cx + 1, 0, tw), wy, inv_wy);
+
+      for (;;)
+      {
+        int i = Math::min<int>(w, MAX_FIXED_STEP);
+        w -= i;
+
+        do {
+          int px0 = px >> 16;
+
+          if (px0 != cx)
+          {
+            if (px0 == cx + 1)
+              col0 = col1;
+            else
+              _fetch_column<Accessor>(accessor, col0, srcLine0, srcLine1, Math::bound<int>(px0, 0, tw), wy, inv_wy);
+
+            _fetch_column<Accessor>(accessor, col1, srcLine0, srcLine1, Math::bound<int>(px0 + 1, 0, tw), wy, inv_wy);
+            cx = px0;
+          }
+
+          uint32_t wx = (uint)(px >> 8) & 0xFF;
+
+          typename Accessor::Pixel pix;
+          accessor.interpolateRaw_2(pix, col0, 0x100 - wx, col1, wx);
+          accessor.normalize(pix, pix);
+          accessor.store(dst, pix);
+
+          dst += Accessor::DST_BPP;
+          px += xx16x16;
+        } while (--i);
+
+        if (w == 0) break;
+        _x += (double)MAX_FIXED_STEP;
+        px = Math::fixed16x16FromFloat(offx + _x * xx);
+      }
+
+      P_FETCH_SPAN8_NEXT()
+    P_FETCH_SPAN8_END()
+
+    // ------------------------------------------------------------------------
+    // [Advance]
+    // ------------------------------------------------------------------------
+
+    fetcher->_d.texture.affine.px += fetcher->_d.texture.affine.dx;
+    fetcher->_d.texture.affine.py += fetcher->_d.texture.affine.dy;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Fetch - Downscale (Box) - Pad]
+  // --------------------------------------------------------------------------
+
+  template<typename Accessor>
+  static FOG_INLINE void _fetch_box2(Accessor& accessor,
+    typename Accessor::Pixel& dst, const uint8_t* srcLine0, const uint8_t* srcLine1, int px0, int px1)
+  {
+    typename Accessor::Pixel pix_x0y0;
+    typename Accessor::Pixel pix_x1y0;
+    typename Accessor::Pixel pix_x0y1;
+    typename Accessor::Pixel pix_x1y1;
+
+    accessor.fetchRaw(pix_x0y0, srcLine0 + (uint)px0 * Accessor::SRC_BPP);
+    accessor.fetchRaw(pix_x1y0, srcLine0 + (uint)px1 * Accessor::SRC_BPP);
+    accessor.fetchRaw(pix_x0y1, srcLine1 + (uint)px0 * Accessor::SRC_BPP);
+    accessor.fetchRaw(pix_x1y1, srcLine1 + (uint)px1 * Accessor::SRC_BPP);
+
+    accessor.interpolateRaw_4(dst,
+      pix_x0y0, 0x40, pix_x1y0, 0x40,
+      pix_x0y1, 0x40, pix_x1y1, 0x40);
+  }
+
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_downscale_box_pad(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+    Accessor accessor(ctx);
+
+    // ------------------------------------------------------------------------
+    // [Prepare]
+    // ------------------------------------------------------------------------
+
+    int tw = ctx->_d.texture.base.w - 1;
+    int th = ctx->_d.texture.base.h - 1;
+    int scale = ctx->_d.texture.affine.scale;
+
+    const uint8_t* srcPixels = ctx->_d.texture.base.pixels;
+    ssize_t srcStride = ctx->_d.texture.base.stride;
+
+    // The source coordinates point to the center of the box, the box is
+    // aligned to the pixel grid.
+    int bx0 = Math::iround(fetcher->_d.texture.affine.px) - (scale >> 1);
+    int by0 = Math::iround(fetcher->_d.texture.affine.py) - (scale >> 1);
+
+    const uint8_t* srcLine[4];
+    for (int i = 0; i < scale; i++)
+      srcLine[i] = srcPixels + Math::bound<int>(by0 + i, 0, th) * srcStride;
+
+    P_FETCH_SPAN8_INIT()
+
+    // ------------------------------------------------------------------------
+    // [Loop - 2x2]
+    // ------------------------------------------------------------------------
+
+    if (scale == 2)
+    {
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(Accessor::DST_BPP)
+        int px = bx0 + x * 2;
+
+        do {
+          typename Accessor::Pixel pix;
+          _fetch_box2<Accessor>(accessor, pix, srcLine[0], srcLine[1],
+            Math::bound<int>(px    , 0, tw),
+            Math::bound<int>(px + 1, 0, tw));
+
+          accessor.normalize(pix, pix);
+          accessor.store(dst, pix);
+
+          dst += Accessor::DST_BPP;
+          px += 2;
+        } while (--w);
+
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
+    }
+
+    // ------------------------------------------------------------------------
+    // [Loop - 4x4]
+    // ------------------------------------------------------------------------
+
+    else
+    {
+      FOG_ASSERT(scale == 4);
+
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(Accessor::DST_BPP)
+        int px = bx0 + x * 4;
+
+        do {
+          int px0 = Math::bound<int>(px    , 0, tw);
+          int px1 = Math::bound<int>(px + 1, 0, tw);
+          int px2 = Math::bound<int>(px + 2, 0, tw);
+          int px3 = Math::bound<int>(px + 3, 0, tw);
+
+          typename Accessor::Pixel box00;
+          typename Accessor::Pixel box01;
+          typename Accessor::Pixel box10;
+          typename Accessor::Pixel box11;
+
+          _fetch_box2<Accessor>(accessor, box00, srcLine[0], srcLine[1], px0, px1);
+          _fetch_box2<Accessor>(accessor, box01, srcLine[0], srcLine[1], px2, px3);
+          _fetch_box2<Accessor>(accessor, box10, srcLine[2], srcLine[3], px0, px1);
+          _fetch_box2<Accessor>(accessor, box11, srcLine[2], srcLine[3], px2, px3);
+
+          typename Accessor::Pixel pix;
+          accessor.interpolateRaw_4(pix,
+            box00, 0x40, box01, 0x40,
+            box10, 0x40, box11, 0x40);
+
+          accessor.normalize(pix, pix);
+          accessor.store(dst, pix);
+
+          dst += Accessor::DST_BPP;
+          px += 4;
+        } while (--w);
+
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
+    }
+
+    // ------------------------------------------------------------------------
+    // [Advance]
+    // ------------------------------------------------------------------------
+
+    fetcher->_d.texture.affine.px += fetcher->_d.texture.affine.dx;
+    fetcher->_d.texture.affine.py += fetcher->_d.texture.affine.dy;
+  }
+};
+
+} // RasterOps_C namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_C_TEXTUREORTHO_P_H
@@ -122,6 +122,677 @@ struct FOG_NO_EXPORT Convert
       Acc::m128iStore16u(dst + (uint)w * 2 - 16, xmm0);
     }
   }
+
+  // ==========================================================================
+  // [Helpers]
+  // ==========================================================================
+
+  //! @internal
+  //!
+  //! @brief Swap bytes of each 16-bit word in @a x0.
+  static FOG_INLINE void _m128iBSwapPI16(__m128i& dst0, const __m128i& x0)
+  {
+    __m128i t0;
+
+    Acc::m128iLShiftPU16<8>(t0, x0);
+    Acc::m128iRShiftPU16<8>(dst0, x0);
+    Acc::m128iOr(dst0, dst0, t0);
+  }
+
+  //! @internal
+  //!
+  //! @brief Swap bytes of each 32-bit dword in @a x0.
+  static FOG_INLINE void _m128iBSwapPI32(__m128i& dst0, const __m128i& x0)
+  {
+    _m128iBSwapPI16(dst0, x0);
+    Acc::m128iShufflePI16Lo<1, 0, 3, 2>(dst0, dst0);
+    Acc::m128iShufflePI16Hi<1, 0, 3, 2>(dst0, dst0);
+  }
+
+  //! @internal
+  //!
+  //! @brief Premultiply two unpacked ARGB32 pixels, the result is bit-exact
+  //! to @c Acc::p32PRGB32FromARGB32().
+  static FOG_INLINE void _m128iPRGB32FromARGB32_PBW(__m128i& dst0, const __m128i& x0)
+  {
+    __m128i a0;
+    __m128i t0;
+
+    Acc::m128iShufflePI16Lo<3, 3, 3, 3>(a0, x0);
+    Acc::m128iShufflePI16Hi<3, 3, 3, 3>(a0, a0);
+
+    Acc::m128iOr(dst0, x0, FOG_XMM_GET_CONST_PI(00FF000000000000_00FF000000000000));
+    Acc::m128iMulLoPI16(dst0, dst0, a0);
+
+    Acc::m128iRShiftPU16<8>(t0, dst0);
+    Acc::m128iAddPI16(dst0, dst0, FOG_XMM_GET_CONST_PI(0080008000800080_0080008000800080));
+    Acc::m128iAddPI16(dst0, dst0, t0);
+    Acc::m128iRShiftPU16<8>(dst0, dst0);
+  }
+
+  //! @internal
+  //!
+  //! @brief Demultiply two unpacked PRGB32 pixels using reciprocals stored
+  //! in @a r0 as [hi, lo] 16-bit pairs (see @c Acc::_u8_divide_table_d).
+  //!
+  //! The reciprocal is split to high and low 16-bit parts so the result
+  //! @c (c * recip) >> 16 can be calculated exactly using 16-bit multiplies.
+  static FOG_INLINE void _m128iARGB32FromPRGB32_PBW(__m128i& dst0, const __m128i& x0, const __m128i& r0)
+  {
+    __m128i rHi;
+    __m128i rLo;
+
+    Acc::m128iShufflePI16Lo<1, 1, 1, 1>(rHi, r0);
+    Acc::m128iShufflePI16Lo<0, 0, 0, 0>(rLo, r0);
+    Acc::m128iShufflePI16Hi<1, 1, 1, 1>(rHi, rHi);
+    Acc::m128iShufflePI16Hi<0, 0, 0, 0>(rLo, rLo);
+
+    Acc::m128iMulLoPI16(rHi, rHi, x0);
+    Acc::m128iMulHiPU16(rLo, rLo, x0);
+    Acc::m128iAddPI16(dst0, rHi, rLo);
+  }
+
+  //! @internal
+  //!
+  //! @brief Expand four RGB16_555 pixels (zero extended to 32-bits) to XRGB32.
+  static FOG_INLINE void _m128iXRGB32FromRGB16_555(__m128i& dst0, const __m128i& x0)
+  {
+    FOG_XMM_DECLARE_CONST_PI32_SET(B_Hi, 0x000000F8);
+    FOG_XMM_DECLARE_CONST_PI32_SET(B_Lo, 0x00000007);
+    FOG_XMM_DECLARE_CONST_PI32_SET(G_Hi, 0x0000F800);
+    FOG_XMM_DECLARE_CONST_PI32_SET(G_Lo, 0x00000700);
+    FOG_XMM_DECLARE_CONST_PI32_SET(R_Hi, 0x00F80000);
+    FOG_XMM_DECLARE_CONST_PI32_SET(R_Lo, 0x00070000);
+
+    __m128i t0, t1, t2;
+
+    Acc::m128iLShiftPU32<3>(t0, x0);
+    Acc::m128iRShiftPU32<2>(t1, x0);
+    Acc::m128iAnd(t0, t0, FOG_XMM_GET_CONST_PI(B_Hi));
+    Acc::m128iAnd(t1, t1, FOG_XMM_GET_CONST_PI(B_Lo));
+    Acc::m128iOr(t0, t0, t1);
+
+    Acc::m128iLShiftPU32<6>(t1, x0);
+    Acc::m128iLShiftPU32<1>(t2, x0);
+    Acc::m128iAnd(t1, t1, FOG_XMM_GET_CONST_PI(G_Hi));
+    Acc::m128iAnd(t2, t2, FOG_XMM_GET_CONST_PI(G_Lo));
+    Acc::m128iOr(t0, t0, t1);
+    Acc::m128iOr(t0, t0, t2);
+
+    Acc::m128iLShiftPU32<9>(t1, x0);
+    Acc::m128iLShiftPU32<4>(t2, x0);
+    Acc::m128iAnd(t1, t1, FOG_XMM_GET_CONST_PI(R_Hi));
+    Acc::m128iAnd(t2, t2, FOG_XMM_GET_CONST_PI(R_Lo));
+    Acc::m128iOr(t0, t0, t1);
+    Acc::m128iOr(t0, t0, t2);
+
+    Acc::m128iOr(dst0, t0, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+  }
+
+  //! @internal
+  //!
+  //! @brief Expand four RGB16_565 pixels (zero extended to 32-bits) to XRGB32.
+  static FOG_INLINE void _m128iXRGB32FromRGB16_565(__m128i& dst0, const __m128i& x0)
+  {
+    FOG_XMM_DECLARE_CONST_PI32_SET(B_Hi, 0x000000F8);
+    FOG_XMM_DECLARE_CONST_PI32_SET(B_Lo, 0x00000007);
+    FOG_XMM_DECLARE_CONST_PI32_SET(G_Hi, 0x0000FC00);
+    FOG_XMM_DECLARE_CONST_PI32_SET(G_Lo, 0x00000300);
+    FOG_XMM_DECLARE_CONST_PI32_SET(R_Hi, 0x00F80000);
+    FOG_XMM_DECLARE_CONST_PI32_SET(R_Lo, 0x00070000);
+
+    __m128i t0, t1, t2;
+
+    Acc::m128iLShiftPU32<3>(t0, x0);
+    Acc::m128iRShiftPU32<2>(t1, x0);
+    Acc::m128iAnd(t0, t0, FOG_XMM_GET_CONST_PI(B_Hi));
+    Acc::m128iAnd(t1, t1, FOG_XMM_GET_CONST_PI(B_Lo));
+    Acc::m128iOr(t0, t0, t1);
+
+    Acc::m128iLShiftPU32<5>(t1, x0);
+    Acc::m128iRShiftPU32<1>(t2, x0);
+    Acc::m128iAnd(t1, t1, FOG_XMM_GET_CONST_PI(G_Hi));
+    Acc::m128iAnd(t2, t2, FOG_XMM_GET_CONST_PI(G_Lo));
+    Acc::m128iOr(t0, t0, t1);
+    Acc::m128iOr(t0, t0, t2);
+
+    Acc::m128iLShiftPU32<8>(t1, x0);
+    Acc::m128iLShiftPU32<3>(t2, x0);
+    Acc::m128iAnd(t1, t1, FOG_XMM_GET_CONST_PI(R_Hi));
+    Acc::m128iAnd(t2, t2, FOG_XMM_GET_CONST_PI(R_Lo));
+    Acc::m128iOr(t0, t0, t1);
+    Acc::m128iOr(t0, t0, t2);
+
+    Acc::m128iOr(dst0, t0, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+  }
+
+  //! @internal
+  //!
+  //! @brief Convert four XRGB32 pixels to RGB16_555, the result is stored in
+  //! 32-bit lanes and it's sign extended so it can be packed by @c packssdw.
+  static FOG_INLINE void _m128iRGB16_555FromXRGB32(__m128i& dst0, const __m128i& x0)
+  {
+    FOG_XMM_DECLARE_CONST_PI32_SET(R, 0x00007C00);
+    FOG_XMM_DECLARE_CONST_PI32_SET(G, 0x000003E0);
+    FOG_XMM_DECLARE_CONST_PI32_SET(B, 0x0000001F);
+
+    __m128i t0, t1, t2;
+
+    Acc::m128iRShiftPU32<9>(t0, x0);
+    Acc::m128iRShiftPU32<6>(t1, x0);
+    Acc::m128iRShiftPU32<3>(t2, x0);
+
+    Acc::m128iAnd(t0, t0, FOG_XMM_GET_CONST_PI(R));
+    Acc::m128iAnd(t1, t1, FOG_XMM_GET_CONST_PI(G));
+    Acc::m128iAnd(t2, t2, FOG_XMM_GET_CONST_PI(B));
+
+    Acc::m128iOr(t0, t0, t1);
+    Acc::m128iOr(dst0, t0, t2);
+  }
+
+  //! @internal
+  //!
+  //! @brief Convert four XRGB32 pixels to RGB16_565, the result is stored in
+  //! 32-bit lanes and it's sign extended so it can be packed by @c packssdw.
+  static FOG_INLINE void _m128iRGB16_565FromXRGB32(__m128i& dst0, const __m128i& x0)
+  {
+    FOG_XMM_DECLARE_CONST_PI32_SET(R, 0x0000F800);
+    FOG_XMM_DECLARE_CONST_PI32_SET(G, 0x000007E0);
+    FOG_XMM_DECLARE_CONST_PI32_SET(B, 0x0000001F);
+
+    __m128i t0, t1, t2;
+
+    Acc::m128iRShiftPU32<8>(t0, x0);
+    Acc::m128iRShiftPU32<5>(t1, x0);
+    Acc::m128iRShiftPU32<3>(t2, x0);
+
+    Acc::m128iAnd(t0, t0, FOG_XMM_GET_CONST_PI(R));
+    Acc::m128iAnd(t1, t1, FOG_XMM_GET_CONST_PI(G));
+    Acc::m128iAnd(t2, t2, FOG_XMM_GET_CONST_PI(B));
+
+    Acc::m128iOr(t0, t0, t1);
+    Acc::m128iOr(t0, t0, t2);
+
+    // Sign extend, the 'R' component can use the most significant bit.
+    Acc::m128iLShiftPU32<16>(t0, t0);
+    Acc::m128iRShiftPI32<16>(dst0, t0);
+  }
+
+  // ==========================================================================
+  // [BSwap - 16]
+  // ==========================================================================
+
+  static void FOG_FASTCALL bswap_16(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 8) >= 0)
+    {
+      __m128i pix0xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src);
+      _m128iBSwapPI16(pix0xmm, pix0xmm);
+      Acc::m128iStore16u(dst, pix0xmm);
+
+      dst += 16;
+      src += 16;
+    }
+
+    w += 8;
+    if (w) RasterOps_C::Convert::bswap_16(dst, src, w, closure);
+  }
+
+  // ==========================================================================
+  // [BSwap - 32]
+  // ==========================================================================
+
+  static void FOG_FASTCALL bswap_32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 4) >= 0)
+    {
+      __m128i pix0xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src);
+      _m128iBSwapPI32(pix0xmm, pix0xmm);
+      Acc::m128iStore16u(dst, pix0xmm);
+
+      dst += 16;
+      src += 16;
+    }
+
+    w += 4;
+    if (w) RasterOps_C::Convert::bswap_32(dst, src, w, closure);
+  }
+
+  // ==========================================================================
+  // [Convert - Premultiply / Demultiply]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb32_from_argb32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 4) >= 0)
+    {
+      __m128i pix0xmm;
+      __m128i pix1xmm;
+      __m128i tmp0xmm;
+      int msk0;
+
+      Acc::m128iLoad16u(pix0xmm, src);
+
+      // Skip the premultiplication if all pixels are fully opaque.
+      Acc::m128iAnd(tmp0xmm, pix0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iCmpEqPI32(tmp0xmm, tmp0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iMoveMaskPI8(msk0, tmp0xmm);
+
+      if (msk0 != 0xFFFF)
+      {
+        Acc::m128iUnpackPI16FromPI8Hi(pix1xmm, pix0xmm);
+        Acc::m128iUnpackPI16FromPI8Lo(pix0xmm, pix0xmm);
+
+        _m128iPRGB32FromARGB32_PBW(pix0xmm, pix0xmm);
+        _m128iPRGB32FromARGB32_PBW(pix1xmm, pix1xmm);
+
+        Acc::m128iPackPU8FromPU16(pix0xmm, pix0xmm, pix1xmm);
+      }
+
+      Acc::m128iStore16u(dst, pix0xmm);
+
+      dst += 16;
+      src += 16;
+    }
+
+    w += 4;
+    if (w) RasterOps_C::Convert::prgb32_from_argb32(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL argb32_from_prgb32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 4) >= 0)
+    {
+      __m128i pix0xmm;
+      __m128i pix1xmm;
+      __m128i tmp0xmm;
+      int msk0;
+
+      Acc::m128iLoad16u(pix0xmm, src);
+
+      Acc::m128iAnd(tmp0xmm, pix0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iCmpEqPI32(tmp0xmm, tmp0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iMoveMaskPI8(msk0, tmp0xmm);
+
+      // Skip the demultiplication if all pixels are fully opaque.
+      if (msk0 != 0xFFFF)
+      {
+        __m128i rcp0xmm;
+        __m128i rcp1xmm;
+        __m128i rcp2xmm;
+        __m128i rcp3xmm;
+
+        int a0, a1, a2, a3;
+
+        Acc::m128iExtractPI16<1>(a0, pix0xmm);
+        Acc::m128iExtractPI16<3>(a1, pix0xmm);
+        Acc::m128iExtractPI16<5>(a2, pix0xmm);
+        Acc::m128iExtractPI16<7>(a3, pix0xmm);
+
+        Acc::m128iCvtSI128FromSI(rcp0xmm, (int)Acc::_u8_divide_table_d[(uint)a0 >> 8]);
+        Acc::m128iCvtSI128FromSI(rcp1xmm, (int)Acc::_u8_divide_table_d[(uint)a1 >> 8]);
+        Acc::m128iCvtSI128FromSI(rcp2xmm, (int)Acc::_u8_divide_table_d[(uint)a2 >> 8]);
+        Acc::m128iCvtSI128FromSI(rcp3xmm, (int)Acc::_u8_divide_table_d[(uint)a3 >> 8]);
+
+        // [R1 R1 R0 R0] and [R3 R3 R2 R2].
+        Acc::m128iUnpackPI64FromPI32Lo(rcp0xmm, rcp0xmm, rcp1xmm);
+        Acc::m128iUnpackPI64FromPI32Lo(rcp2xmm, rcp2xmm, rcp3xmm);
+        Acc::m128iShufflePI32<1, 1, 0, 0>(rcp0xmm, rcp0xmm);
+        Acc::m128iShufflePI32<1, 1, 0, 0>(rcp2xmm, rcp2xmm);
+
+        Acc::m128iUnpackPI16FromPI8Hi(pix1xmm, pix0xmm);
+        Acc::m128iUnpackPI16FromPI8Lo(tmp0xmm, pix0xmm);
+
+        _m128iARGB32FromPRGB32_PBW(tmp0xmm, tmp0xmm, rcp0xmm);
+        _m128iARGB32FromPRGB32_PBW(pix1xmm, pix1xmm, rcp2xmm);
+
+        Acc::m128iPackPU8FromPU16(tmp0xmm, tmp0xmm, pix1xmm);
+        Acc::m128iAnd(pix0xmm, pix0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+        Acc::m128iAnd(tmp0xmm, tmp0xmm, FOG_XMM_GET_CONST_PI(00FFFFFF00FFFFFF_00FFFFFF00FFFFFF));
+        Acc::m128iOr(pix0xmm, pix0xmm, tmp0xmm);
+      }
+
+      Acc::m128iStore16u(dst, pix0xmm);
+
+      dst += 16;
+      src += 16;
+    }
+
+    w += 4;
+    if (w) RasterOps_C::Convert::argb32_from_prgb32(dst, src, w, closure);
+  }
+
+  // ==========================================================================
+  // [Convert - ARGB32 <- Custom]
+  // ==========================================================================
+
+  static void FOG_FASTCALL argb32_from_rgb16_555(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 8) >= 0)
+    {
+      __m128i pix0xmm;
+      __m128i pix1xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src);
+      Acc::m128iUnpackPI32FromPI16Hi(pix1xmm, pix0xmm);
+      Acc::m128iUnpackPI32FromPI16Lo(pix0xmm, pix0xmm);
+
+      _m128iXRGB32FromRGB16_555(pix0xmm, pix0xmm);
+      _m128iXRGB32FromRGB16_555(pix1xmm, pix1xmm);
+
+      Acc::m128iStore16u(dst +  0, pix0xmm);
+      Acc::m128iStore16u(dst + 16, pix1xmm);
+
+      dst += 32;
+      src += 16;
+    }
+
+    w += 8;
+    if (w) RasterOps_C::Convert::argb32_from_rgb16_555(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL argb32_from_rgb16_555_bs(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 8) >= 0)
+    {
+      __m128i pix0xmm;
+      __m128i pix1xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src);
+      _m128iBSwapPI16(pix0xmm, pix0xmm);
+      Acc::m128iUnpackPI32FromPI16Hi(pix1xmm, pix0xmm);
+      Acc::m128iUnpackPI32FromPI16Lo(pix0xmm, pix0xmm);
+
+      _m128iXRGB32FromRGB16_555(pix0xmm, pix0xmm);
+      _m128iXRGB32FromRGB16_555(pix1xmm, pix1xmm);
+
+      Acc::m128iStore16u(dst +  0, pix0xmm);
+      Acc::m128iStore16u(dst + 16, pix1xmm);
+
+      dst += 32;
+      src += 16;
+    }
+
+    w += 8;
+    if (w) RasterOps_C::Convert::argb32_from_rgb16_555_bs(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL argb32_from_rgb16_565(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 8) >= 0)
+    {
+      __m128i pix0xmm;
+      __m128i pix1xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src);
+      Acc::m128iUnpackPI32FromPI16Hi(pix1xmm, pix0xmm);
+      Acc::m128iUnpackPI32FromPI16Lo(pix0xmm, pix0xmm);
+
+      _m128iXRGB32FromRGB16_565(pix0xmm, pix0xmm);
+      _m128iXRGB32FromRGB16_565(pix1xmm, pix1xmm);
+
+      Acc::m128iStore16u(dst +  0, pix0xmm);
+      Acc::m128iStore16u(dst + 16, pix1xmm);
+
+      dst += 32;
+      src += 16;
+    }
+
+    w += 8;
+    if (w) RasterOps_C::Convert::argb32_from_rgb16_565(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL argb32_from_rgb16_565_bs(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 8) >= 0)
+    {
+      __m128i pix0xmm;
+      __m128i pix1xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src);
+      _m128iBSwapPI16(pix0xmm, pix0xmm);
+      Acc::m128iUnpackPI32FromPI16Hi(pix1xmm, pix0xmm);
+      Acc::m128iUnpackPI32FromPI16Lo(pix0xmm, pix0xmm);
+
+      _m128iXRGB32FromRGB16_565(pix0xmm, pix0xmm);
+      _m128iXRGB32FromRGB16_565(pix1xmm, pix1xmm);
+
+      Acc::m128iStore16u(dst +  0, pix0xmm);
+      Acc::m128iStore16u(dst + 16, pix1xmm);
+
+      dst += 32;
+      src += 16;
+    }
+
+    w += 8;
+    if (w) RasterOps_C::Convert::argb32_from_rgb16_565_bs(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL argb32_from_rgb32_888_bs(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 4) >= 0)
+    {
+      __m128i pix0xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src);
+      _m128iBSwapPI32(pix0xmm, pix0xmm);
+      Acc::m128iOr(pix0xmm, pix0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iStore16u(dst, pix0xmm);
+
+      dst += 16;
+      src += 16;
+    }
+
+    w += 4;
+    if (w) RasterOps_C::Convert::argb32_from_rgb32_888_bs(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL argb32_from_argb32_8888_bs(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    const RasterConvertPass* d = reinterpret_cast<const RasterConvertPass*>(closure->data);
+    __m128i fillxmm;
+
+    Acc::m128iCvtSI128FromSI(fillxmm, (int)(uint32_t)d->fill);
+    Acc::m128iShufflePI32<0, 0, 0, 0>(fillxmm, fillxmm);
+
+    while ((w -= 4) >= 0)
+    {
+      __m128i pix0xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src);
+      _m128iBSwapPI32(pix0xmm, pix0xmm);
+      Acc::m128iOr(pix0xmm, pix0xmm, fillxmm);
+      Acc::m128iStore16u(dst, pix0xmm);
+
+      dst += 16;
+      src += 16;
+    }
+
+    w += 4;
+    if (w) RasterOps_C::Convert::argb32_from_argb32_8888_bs(dst, src, w, closure);
+  }
+
+  // ==========================================================================
+  // [Convert - Custom <- ARGB32]
+  // ==========================================================================
+
+  static void FOG_FASTCALL rgb16_555_from_argb32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 8) >= 0)
+    {
+      __m128i pix0xmm;
+      __m128i pix1xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src +  0);
+      Acc::m128iLoad16u(pix1xmm, src + 16);
+
+      _m128iRGB16_555FromXRGB32(pix0xmm, pix0xmm);
+      _m128iRGB16_555FromXRGB32(pix1xmm, pix1xmm);
+
+      Acc::m128iPackPI16FromPI32(pix0xmm, pix0xmm, pix1xmm);
+      Acc::m128iStore16u(dst, pix0xmm);
+
+      dst += 16;
+      src += 32;
+    }
+
+    w += 8;
+    if (w) RasterOps_C::Convert::rgb16_555_from_argb32(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL rgb16_555_bs_from_argb32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 8) >= 0)
+    {
+      __m128i pix0xmm;
+      __m128i pix1xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src +  0);
+      Acc::m128iLoad16u(pix1xmm, src + 16);
+
+      _m128iRGB16_555FromXRGB32(pix0xmm, pix0xmm);
+      _m128iRGB16_555FromXRGB32(pix1xmm, pix1xmm);
+
+      Acc::m128iPackPI16FromPI32(pix0xmm, pix0xmm, pix1xmm);
+      _m128iBSwapPI16(pix0xmm, pix0xmm);
+      Acc::m128iStore16u(dst, pix0xmm);
+
+      dst += 16;
+      src += 32;
+    }
+
+    w += 8;
+    if (w) RasterOps_C::Convert::rgb16_555_bs_from_argb32(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL rgb16_565_from_argb32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 8) >= 0)
+    {
+      __m128i pix0xmm;
+      __m128i pix1xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src +  0);
+      Acc::m128iLoad16u(pix1xmm, src + 16);
+
+      _m128iRGB16_565FromXRGB32(pix0xmm, pix0xmm);
+      _m128iRGB16_565FromXRGB32(pix1xmm, pix1xmm);
+
+      Acc::m128iPackPI16FromPI32(pix0xmm, pix0xmm, pix1xmm);
+      Acc::m128iStore16u(dst, pix0xmm);
+
+      dst += 16;
+      src += 32;
+    }
+
+    w += 8;
+    if (w) RasterOps_C::Convert::rgb16_565_from_argb32(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL rgb16_565_bs_from_argb32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 8) >= 0)
+    {
+      __m128i pix0xmm;
+      __m128i pix1xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src +  0);
+      Acc::m128iLoad16u(pix1xmm, src + 16);
+
+      _m128iRGB16_565FromXRGB32(pix0xmm, pix0xmm);
+      _m128iRGB16_565FromXRGB32(pix1xmm, pix1xmm);
+
+      Acc::m128iPackPI16FromPI32(pix0xmm, pix0xmm, pix1xmm);
+      _m128iBSwapPI16(pix0xmm, pix0xmm);
+      Acc::m128iStore16u(dst, pix0xmm);
+
+      dst += 16;
+      src += 32;
+    }
+
+    w += 8;
+    if (w) RasterOps_C::Convert::rgb16_565_bs_from_argb32(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL rgb32_888_bs_from_argb32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    const RasterConvertPass* d = reinterpret_cast<const RasterConvertPass*>(closure->data);
+    __m128i fillxmm;
+
+    Acc::m128iCvtSI128FromSI(fillxmm, (int)(uint32_t)d->fill);
+    Acc::m128iShufflePI32<0, 0, 0, 0>(fillxmm, fillxmm);
+
+    while ((w -= 4) >= 0)
+    {
+      __m128i pix0xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src);
+      Acc::m128iOr(pix0xmm, pix0xmm, fillxmm);
+      _m128iBSwapPI32(pix0xmm, pix0xmm);
+      Acc::m128iStore16u(dst, pix0xmm);
+
+      dst += 16;
+      src += 16;
+    }
+
+    w += 4;
+    if (w) RasterOps_C::Convert::rgb32_888_bs_from_argb32(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL argb32_8888_bs_from_argb32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    bswap_32(dst, src, w, closure);
+  }
 };
 
 } // RasterOps_SSE2 namespace
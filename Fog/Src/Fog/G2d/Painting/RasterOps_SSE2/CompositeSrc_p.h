@@ -605,6 +605,309 @@ _ARGB32_Glyph_Skip:
     FOG_VBLIT_SPAN8_END()
   }
 */
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - XRGB32 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb32_vblit_xrgb32_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_BLIT_LOOP_32x8_SSE2_INIT()
+
+    FOG_BLIT_LOOP_32x8_SSE2_ONE_BEGIN(C_Opaque)
+      __m128i src0xmm;
+
+      Acc::m128iLoad4(src0xmm, src);
+      Acc::m128iOr(src0xmm, src0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iStore4(dst, src0xmm);
+
+      dst += 4;
+      src += 4;
+    FOG_BLIT_LOOP_32x8_SSE2_ONE_END(C_Opaque)
+
+    FOG_BLIT_LOOP_32x8_SSE2_TWO_BEGIN(C_Opaque)
+      __m128i src0xmm;
+
+      Acc::m128iLoad8(src0xmm, src);
+      Acc::m128iOr(src0xmm, src0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iStore8(dst, src0xmm);
+
+      dst += 8;
+      src += 8;
+    FOG_BLIT_LOOP_32x8_SSE2_TWO_END(C_Opaque)
+
+    FOG_BLIT_LOOP_32x8_SSE2_MAIN_BEGIN(C_Opaque)
+      __m128i src0xmm;
+      __m128i src1xmm;
+
+      Acc::m128iLoad16u(src0xmm, src +  0);
+      Acc::m128iLoad16u(src1xmm, src + 16);
+      Acc::m128iOr(src0xmm, src0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iOr(src1xmm, src1xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iStore16a(dst +  0, src0xmm);
+      Acc::m128iStore16a(dst + 16, src1xmm);
+
+      dst += 32;
+      src += 32;
+    FOG_BLIT_LOOP_32x8_SSE2_MAIN_END(C_Opaque)
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - A8 / A16 - Line]
+  // ==========================================================================
+
+  //! @internal
+  //!
+  //! @brief Extend alpha values (8-bit or the high byte of 16-bit) to PRGB32,
+  //! optionally forcing the alpha of each pixel to 0xFF (XRGB32 destination).
+  template<uint SrcSize, uint SrcOffset, bool FillAlpha>
+  static FOG_INLINE void _prgb32_vblit_a8_or_a16_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_BLIT_LOOP_32x8_SSE2_INIT()
+
+    FOG_BLIT_LOOP_32x8_SSE2_ONE_BEGIN(C_Opaque)
+      uint32_t src0p;
+
+      Acc::p32Load1b(src0p, src + SrcOffset);
+      Acc::p32ExtendPBBFromSBB(src0p, src0p);
+      if (FillAlpha) Acc::p32FillPBB3(src0p, src0p);
+      Acc::p32Store4a(dst, src0p);
+
+      dst += 4;
+      src += SrcSize;
+    FOG_BLIT_LOOP_32x8_SSE2_ONE_END(C_Opaque)
+
+    FOG_BLIT_LOOP_32x8_SSE2_TWO_BEGIN(C_Opaque)
+      uint32_t src0p;
+      uint32_t src1p;
+
+      Acc::p32Load1b(src0p, src + SrcOffset);
+      Acc::p32Load1b(src1p, src + SrcOffset + SrcSize);
+      Acc::p32ExtendPBBFromSBB(src0p, src0p);
+      Acc::p32ExtendPBBFromSBB(src1p, src1p);
+      if (FillAlpha) Acc::p32FillPBB3(src0p, src0p);
+      if (FillAlpha) Acc::p32FillPBB3(src1p, src1p);
+      Acc::p32Store4a(dst + 0, src0p);
+      Acc::p32Store4a(dst + 4, src1p);
+
+      dst += 8;
+      src += SrcSize * 2;
+    FOG_BLIT_LOOP_32x8_SSE2_TWO_END(C_Opaque)
+
+    FOG_BLIT_LOOP_32x8_SSE2_MAIN_BEGIN(C_Opaque)
+      __m128i src0xmm;
+      __m128i src1xmm;
+
+      if (SrcSize == 1)
+      {
+        Acc::m128iLoad8(src0xmm, src);
+      }
+      else
+      {
+        Acc::m128iLoad16u(src0xmm, src);
+        Acc::m128iRShiftPU16<8>(src0xmm, src0xmm);
+        Acc::m128iPackPU8FromPU16(src0xmm, src0xmm);
+      }
+
+      Acc::m128iUnpackPI16FromPI8Lo(src0xmm, src0xmm, src0xmm);
+      Acc::m128iUnpackPI32FromPI16Hi(src1xmm, src0xmm, src0xmm);
+      Acc::m128iUnpackPI32FromPI16Lo(src0xmm, src0xmm, src0xmm);
+
+      if (FillAlpha)
+      {
+        Acc::m128iOr(src0xmm, src0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+        Acc::m128iOr(src1xmm, src1xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      }
+
+      Acc::m128iStore16a(dst +  0, src0xmm);
+      Acc::m128iStore16a(dst + 16, src1xmm);
+
+      dst += 32;
+      src += SrcSize * 8;
+    FOG_BLIT_LOOP_32x8_SSE2_MAIN_END(C_Opaque)
+  }
+
+  static void FOG_FASTCALL prgb32_vblit_a8_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    _prgb32_vblit_a8_or_a16_line<1, 0, false>(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL prgb32_vblit_a16_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    _prgb32_vblit_a8_or_a16_line<2, PIXEL_A16_BYTE_HI, false>(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL xrgb32_vblit_a8_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    _prgb32_vblit_a8_or_a16_line<1, 0, true>(dst, src, w, closure);
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - PRGB64 - Line]
+  // ==========================================================================
+
+  //! @internal
+  //!
+  //! @brief Take the high byte of each 16-bit component, optionally forcing
+  //! the alpha of each pixel to 0xFF (XRGB32 destination).
+  template<bool FillAlpha>
+  static FOG_INLINE void _prgb32_vblit_prgb64_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_BLIT_LOOP_32x8_SSE2_INIT()
+
+    FOG_BLIT_LOOP_32x8_SSE2_ONE_BEGIN(C_Opaque)
+      __m128i src0xmm;
+
+      Acc::m128iLoad8(src0xmm, src);
+      Acc::m128iRShiftPU16<8>(src0xmm, src0xmm);
+      Acc::m128iPackPU8FromPU16(src0xmm, src0xmm);
+      if (FillAlpha) Acc::m128iOr(src0xmm, src0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iStore4(dst, src0xmm);
+
+      dst += 4;
+      src += 8;
+    FOG_BLIT_LOOP_32x8_SSE2_ONE_END(C_Opaque)
+
+    FOG_BLIT_LOOP_32x8_SSE2_TWO_BEGIN(C_Opaque)
+      __m128i src0xmm;
+
+      Acc::m128iLoad16u(src0xmm, src);
+      Acc::m128iRShiftPU16<8>(src0xmm, src0xmm);
+      Acc::m128iPackPU8FromPU16(src0xmm, src0xmm);
+      if (FillAlpha) Acc::m128iOr(src0xmm, src0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iStore8(dst, src0xmm);
+
+      dst += 8;
+      src += 16;
+    FOG_BLIT_LOOP_32x8_SSE2_TWO_END(C_Opaque)
+
+    FOG_BLIT_LOOP_32x8_SSE2_MAIN_BEGIN(C_Opaque)
+      __m128i src0xmm, src1xmm;
+      __m128i src2xmm, src3xmm;
+
+      Acc::m128iLoad16u(src0xmm, src +  0);
+      Acc::m128iLoad16u(src1xmm, src + 16);
+      Acc::m128iLoad16u(src2xmm, src + 32);
+      Acc::m128iLoad16u(src3xmm, src + 48);
+
+      Acc::m128iRShiftPU16<8>(src0xmm, src0xmm);
+      Acc::m128iRShiftPU16<8>(src1xmm, src1xmm);
+      Acc::m128iRShiftPU16<8>(src2xmm, src2xmm);
+      Acc::m128iRShiftPU16<8>(src3xmm, src3xmm);
+
+      Acc::m128iPackPU8FromPU16(src0xmm, src0xmm, src1xmm);
+      Acc::m128iPackPU8FromPU16(src2xmm, src2xmm, src3xmm);
+
+      if (FillAlpha)
+      {
+        Acc::m128iOr(src0xmm, src0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+        Acc::m128iOr(src2xmm, src2xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      }
+
+      Acc::m128iStore16a(dst +  0, src0xmm);
+      Acc::m128iStore16a(dst + 16, src2xmm);
+
+      dst += 32;
+      src += 64;
+    FOG_BLIT_LOOP_32x8_SSE2_MAIN_END(C_Opaque)
+  }
+
+  static void FOG_FASTCALL prgb32_vblit_prgb64_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    _prgb32_vblit_prgb64_line<false>(dst, src, w, closure);
+  }
+
+  static void FOG_FASTCALL xrgb32_vblit_prgb64_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    _prgb32_vblit_prgb64_line<true>(dst, src, w, closure);
+  }
+
+  // ==========================================================================
+  // [A8 - VBlit - PRGB32 / A16 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL a8_vblit_prgb32_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 16) >= 0)
+    {
+      __m128i src0xmm, src1xmm;
+      __m128i src2xmm, src3xmm;
+
+      Acc::m128iLoad16u(src0xmm, src +  0);
+      Acc::m128iLoad16u(src1xmm, src + 16);
+      Acc::m128iLoad16u(src2xmm, src + 32);
+      Acc::m128iLoad16u(src3xmm, src + 48);
+
+      Acc::m128iRShiftPU32<24>(src0xmm, src0xmm);
+      Acc::m128iRShiftPU32<24>(src1xmm, src1xmm);
+      Acc::m128iRShiftPU32<24>(src2xmm, src2xmm);
+      Acc::m128iRShiftPU32<24>(src3xmm, src3xmm);
+
+      Acc::m128iPackPI16FromPI32(src0xmm, src0xmm, src1xmm);
+      Acc::m128iPackPI16FromPI32(src2xmm, src2xmm, src3xmm);
+      Acc::m128iPackPU8FromPU16(src0xmm, src0xmm, src2xmm);
+
+      Acc::m128iStore16u(dst, src0xmm);
+
+      dst += 16;
+      src += 64;
+    }
+
+    w += 16;
+    while (w)
+    {
+      dst[0] = src[PIXEL_ARGB32_POS_A];
+
+      dst += 1;
+      src += 4;
+      w--;
+    }
+  }
+
+  static void FOG_FASTCALL a8_vblit_a16_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    while ((w -= 16) >= 0)
+    {
+      __m128i src0xmm;
+      __m128i src1xmm;
+
+      Acc::m128iLoad16u(src0xmm, src +  0);
+      Acc::m128iLoad16u(src1xmm, src + 16);
+
+      Acc::m128iRShiftPU16<8>(src0xmm, src0xmm);
+      Acc::m128iRShiftPU16<8>(src1xmm, src1xmm);
+      Acc::m128iPackPU8FromPU16(src0xmm, src0xmm, src1xmm);
+
+      Acc::m128iStore16u(dst, src0xmm);
+
+      dst += 16;
+      src += 32;
+    }
+
+    w += 16;
+    while (w)
+    {
+      dst[0] = src[PIXEL_A16_BYTE_HI];
+
+      dst += 1;
+      src += 2;
+      w--;
+    }
+  }
 };
 
 } // RasterOps_SSE2 namespace
@@ -0,0 +1,392 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERBLUR_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERBLUR_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_SSE2/BaseDefs_p.h>
+
+// [Dependencies - RasterOps_C]
+#include <Fog/G2d/Painting/RasterOps_C/FilterBlur_p.h>
+
+namespace Fog {
+namespace RasterOps_SSE2 {
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Helpers]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Blur helpers (SSE2).
+//!
+//! The blur loops are shared with @c RasterOps_C::FBlur, only the accessors
+//! differ. The SSE2 run keeps B, G, R, A sums in four 32-bit lanes of one
+//! register, so all channels of a pixel are accumulated, scaled and stored
+//! at once.
+struct FOG_NO_EXPORT FBlurHelpers
+{
+  //! @brief Broadcast the scalar @a value.
+  static FOG_INLINE void broadcast(__m128i& dst, uint32_t value)
+  {
+    Acc::m128iCvtSI128FromSI(dst, (int)value);
+    Acc::m128iExtendPI32FromSI32(dst, dst);
+  }
+
+  //! @brief Unpack the 32-bit pixel @a pix into four 32-bit lanes.
+  static FOG_INLINE void unpack(__m128i& dst, uint32_t pix)
+  {
+    Acc::m128iCvtSI128FromSI(dst, (int)pix);
+    Acc::m128iUnpackPI32FromPI8Lo(dst, dst);
+  }
+
+  //! @brief Multiply four 32-bit lanes of @a x by the broadcasted @a scale,
+  //! keeping the low 32 bits of each product (like the C code does).
+  static FOG_INLINE void mul(__m128i& dst, const __m128i& x, const __m128i& scale)
+  {
+    __m128i lo, hi;
+
+    Acc::m128iRShiftPU64<32>(hi, x);
+    Acc::m128iEMulPU32(lo, x, scale);
+    Acc::m128iEMulPU32(hi, hi, scale);
+
+    Acc::m128iShufflePI32<3, 3, 2, 0>(lo, lo);
+    Acc::m128iShufflePI32<3, 3, 2, 0>(hi, hi);
+    Acc::m128iUnpackPI64FromPI32Lo(dst, lo, hi);
+  }
+
+  static FOG_INLINE void mul(__m128i& dst, const __m128i& x, uint32_t scale)
+  {
+    __m128i s;
+
+    broadcast(s, scale);
+    mul(dst, x, s);
+  }
+
+  //! @brief Pack four 32-bit lanes of @a x (all in [0, 255]) to a pixel.
+  static FOG_INLINE void store(uint8_t* dst, __m128i x)
+  {
+    Acc::m128iPackPU8FromPI32(x, x);
+    Acc::m128iStore4(dst, x);
+  }
+
+  //! @brief Pack four 32-bit lanes of @a x to a pixel, setting alpha to 0xFF.
+  static FOG_INLINE void storeX(uint8_t* dst, __m128i x)
+  {
+    uint32_t pix;
+
+    Acc::m128iPackPU8FromPI32(x, x);
+    Acc::m128iCvtSIFromSI128(reinterpret_cast<int&>(pix), x);
+    Acc::p32Store4a(dst, pix | 0xFF000000);
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Run - 32]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Blur run (SSE2), compatible with @c RasterOps_C::FBlurRun_PRGB32.
+struct FOG_NO_EXPORT FBlurRun_32
+{
+  typedef FBlurRun_32 Run;
+  typedef uint32_t Pixel;
+
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void reset()
+  {
+    Acc::m128iZero(v);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Set]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void set(const Run& run)
+  {
+    v = run.v;
+  }
+
+  FOG_INLINE void set(const Run& run, uint32_t scale)
+  {
+    FBlurHelpers::mul(v, run.v, scale);
+  }
+
+  FOG_INLINE void set(const Pixel& pix)
+  {
+    FBlurHelpers::unpack(v, pix);
+  }
+
+  FOG_INLINE void set(const Pixel& pix, uint32_t scale)
+  {
+    FBlurHelpers::unpack(v, pix);
+    FBlurHelpers::mul(v, v, scale);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Ops]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void add(const Pixel& pix)
+  {
+    __m128i t;
+
+    FBlurHelpers::unpack(t, pix);
+    Acc::m128iAddPI32(v, v, t);
+  }
+
+  FOG_INLINE void add(const Pixel& pix, uint32_t scale)
+  {
+    __m128i t;
+
+    FBlurHelpers::unpack(t, pix);
+    FBlurHelpers::mul(t, t, scale);
+    Acc::m128iAddPI32(v, v, t);
+  }
+
+  FOG_INLINE void add(const Run& run)
+  {
+    Acc::m128iAddPI32(v, v, run.v);
+  }
+
+  FOG_INLINE void add(const Run& run, uint32_t scale)
+  {
+    __m128i t;
+
+    FBlurHelpers::mul(t, run.v, scale);
+    Acc::m128iAddPI32(v, v, t);
+  }
+
+  FOG_INLINE void sub(const Pixel& pix)
+  {
+    __m128i t;
+
+    FBlurHelpers::unpack(t, pix);
+    Acc::m128iSubPI32(v, v, t);
+  }
+
+  FOG_INLINE void sub(const Pixel& pix, uint32_t scale)
+  {
+    __m128i t;
+
+    FBlurHelpers::unpack(t, pix);
+    FBlurHelpers::mul(t, t, scale);
+    Acc::m128iSubPI32(v, v, t);
+  }
+
+  FOG_INLINE void sub(const Run& run)
+  {
+    Acc::m128iSubPI32(v, v, run.v);
+  }
+
+  FOG_INLINE void sub(const Run& run, uint32_t scale)
+  {
+    __m128i t;
+
+    FBlurHelpers::mul(t, run.v, scale);
+    Acc::m128iSubPI32(v, v, t);
+  }
+
+  FOG_INLINE void shl(int by)
+  {
+    __m128i count;
+
+    Acc::m128iCvtSI128FromSI(count, by);
+    Acc::m128iLShiftPU32(v, v, count);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  __m128i v;
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Simple - Accessor - PRGB32]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Box and stack blur accessor (SSE2), see
+//! @c RasterOps_C::FBlurBaseAccessor_PRGB32.
+struct FOG_NO_EXPORT FBlurBaseAccessor_PRGB32 : public RasterOps_C::FBaseAccessor_PRGB32
+{
+  typedef FBlurRun_32 Run;
+
+  // --------------------------------------------------------------------------
+  // [Methods]
+  // --------------------------------------------------------------------------
+
+  static FOG_INLINE void fetchRunM(Run& run, const uint8_t* src)
+  {
+    __m128i t;
+
+    Acc::m128iLoad4(t, src);
+    Acc::m128iUnpackPI32FromPI8Lo(run.v, t);
+  }
+
+  static FOG_INLINE void fetchRunT(Run& run, const uint8_t* src)
+  {
+    fetchRunM(run, src);
+  }
+
+  static FOG_INLINE void storeRunM(uint8_t* dst, const Run& run, uint32_t scale, uint32_t shift)
+  {
+    __m128i t;
+    __m128i count;
+
+    Acc::m128iCvtSI128FromSI(count, (int)shift);
+    FBlurHelpers::mul(t, run.v, scale);
+    Acc::m128iRShiftPU32(t, t, count);
+    FBlurHelpers::store(dst, t);
+  }
+
+  static FOG_INLINE void storeRunT(uint8_t* dst, const Run& run, uint32_t scale, uint32_t shift)
+  {
+    storeRunM(dst, run, scale, shift);
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Simple - Accessor - XRGB32]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Box and stack blur accessor (SSE2), see
+//! @c RasterOps_C::FBlurBaseAccessor_XRGB32.
+//!
+//! The alpha lane is accumulated too (it's free), but never stored.
+struct FOG_NO_EXPORT FBlurBaseAccessor_XRGB32 : public RasterOps_C::FBaseAccessor_XRGB32
+{
+  typedef FBlurRun_32 Run;
+
+  // --------------------------------------------------------------------------
+  // [Methods]
+  // --------------------------------------------------------------------------
+
+  static FOG_INLINE void fetchRunM(Run& run, const uint8_t* src)
+  {
+    FBlurBaseAccessor_PRGB32::fetchRunM(run, src);
+  }
+
+  static FOG_INLINE void fetchRunT(Run& run, const uint8_t* src)
+  {
+    fetchRunM(run, src);
+  }
+
+  static FOG_INLINE void storeRunM(uint8_t* dst, const Run& run, uint32_t scale, uint32_t shift)
+  {
+    __m128i t;
+    __m128i count;
+
+    Acc::m128iCvtSI128FromSI(count, (int)shift);
+    FBlurHelpers::mul(t, run.v, scale);
+    Acc::m128iRShiftPU32(t, t, count);
+    FBlurHelpers::storeX(dst, t);
+  }
+
+  static FOG_INLINE void storeRunT(uint8_t* dst, const Run& run, uint32_t scale, uint32_t shift)
+  {
+    storeRunM(dst, run, scale, shift);
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Box - Accessors]
+// ============================================================================
+
+typedef FBlurBaseAccessor_PRGB32 FBlurBoxAccessor_PRGB32;
+typedef FBlurBaseAccessor_XRGB32 FBlurBoxAccessor_XRGB32;
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Stack - Accessors]
+// ============================================================================
+
+typedef FBlurBaseAccessor_PRGB32 FBlurStackAccessor_PRGB32;
+typedef FBlurBaseAccessor_XRGB32 FBlurStackAccessor_XRGB32;
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Exponential - Accessors]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Exponential blur accessor (SSE2), see
+//! @c RasterOps_C::FBlurExpAccessor_PRGB32.
+//!
+//! The state is signed, but the low 32 bits of the product computed by
+//! @c FBlurHelpers::mul() are the same as the signed product.
+template<uint32_t Format>
+struct FOG_NO_EXPORT FBlurExpAccessor_32 : public FBlurBaseAccessor_PRGB32
+{
+  static FOG_INLINE void blurRun(Run& run, __m128i x, int32_t aValue)
+  {
+    Acc::m128iLShiftPU32<RasterOps_C::BLUR_ZPREC>(x, x);
+    Acc::m128iSubPI32(x, x, run.v);
+    FBlurHelpers::mul(x, x, (uint32_t)aValue);
+    Acc::m128iRShiftPI32<RasterOps_C::BLUR_APREC>(x, x);
+    Acc::m128iAddPI32(run.v, run.v, x);
+  }
+
+  static FOG_INLINE void blurPixel(Run& run, const Pixel& pix, int32_t aValue)
+  {
+    __m128i x;
+
+    FBlurHelpers::unpack(x, pix);
+    blurRun(run, x, aValue);
+  }
+
+  static FOG_INLINE void blurPixel(Run& run, const Run& src, int32_t aValue)
+  {
+    blurRun(run, src.v, aValue);
+  }
+
+  static FOG_INLINE void blurRunM(Run& run, const uint8_t* src, int32_t aValue)
+  {
+    __m128i x;
+
+    Acc::m128iLoad4(x, src);
+    Acc::m128iUnpackPI32FromPI8Lo(x, x);
+    blurRun(run, x, aValue);
+  }
+
+  static FOG_INLINE void blurRunT(Run& run, const uint8_t* src, int32_t aValue)
+  {
+    blurRunM(run, src, aValue);
+  }
+
+  static FOG_INLINE void storeRunM(uint8_t* dst, const Run& run)
+  {
+    __m128i x;
+
+    Acc::m128iRShiftPI32<RasterOps_C::BLUR_ZPREC>(x, run.v);
+    if (Format == IMAGE_FORMAT_XRGB32)
+      FBlurHelpers::storeX(dst, x);
+    else
+      FBlurHelpers::store(dst, x);
+  }
+
+  static FOG_INLINE void storeRunT(uint8_t* dst, const Run& run)
+  {
+    storeRunM(dst, run);
+  }
+};
+
+typedef FBlurExpAccessor_32<IMAGE_FORMAT_PRGB32> FBlurExpAccessor_PRGB32;
+typedef FBlurExpAccessor_32<IMAGE_FORMAT_XRGB32> FBlurExpAccessor_XRGB32;
+
+} // RasterOps_SSE2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERBLUR_P_H
@@ -0,0 +1,284 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERCOLORMATRIX_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERCOLORMATRIX_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_SSE2/BaseDefs_p.h>
+
+namespace Fog {
+namespace RasterOps_SSE2 {
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - ColorMatrix]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Color matrix filter (SSE2).
+//!
+//! Four pixels are processed at a time. The components are unpacked into four
+//! float registers (one per component), so each matrix element is a single
+//! broadcasted multiply-add for four pixels. The remaining pixels are copied
+//! to a temporary buffer and processed the same way.
+struct FOG_NO_EXPORT FColorMatrix
+{
+  // ==========================================================================
+  // [ColorMatrix - Helpers]
+  // ==========================================================================
+
+  //! @brief Broadcast the matrix stored in @a ctx to @a mv.
+  static FOG_INLINE void loadMatrix(__m128f mv[5][4], const RasterFilter* ctx)
+  {
+    for (uint i = 0; i < 5; i++)
+    {
+      for (uint j = 0; j < 4; j++)
+      {
+        Acc::m128fLoad4(mv[i][j], &ctx->colorMatrix.m[i][j]);
+        Acc::m128fExtendSS(mv[i][j], mv[i][j]);
+      }
+    }
+  }
+
+  //! @brief Unpack four 32-bit pixels to float components.
+  static FOG_INLINE void unpack(__m128f& fa, __m128f& fr, __m128f& fg, __m128f& fb, const __m128i& pix)
+  {
+    __m128i t0;
+
+    Acc::m128iRShiftPU32<24>(t0, pix);
+    Acc::m128fCvtPSFromPI32(fa, t0);
+
+    Acc::m128iRShiftPU32<16>(t0, pix);
+    Acc::m128iAnd(t0, t0, FOG_XMM_GET_CONST_PI(000000FF000000FF_000000FF000000FF));
+    Acc::m128fCvtPSFromPI32(fr, t0);
+
+    Acc::m128iRShiftPU32<8>(t0, pix);
+    Acc::m128iAnd(t0, t0, FOG_XMM_GET_CONST_PI(000000FF000000FF_000000FF000000FF));
+    Acc::m128fCvtPSFromPI32(fg, t0);
+
+    Acc::m128iAnd(t0, pix, FOG_XMM_GET_CONST_PI(000000FF000000FF_000000FF000000FF));
+    Acc::m128fCvtPSFromPI32(fb, t0);
+  }
+
+  //! @brief Clamp @a x to [0, 255].
+  static FOG_INLINE void bound(__m128f& x)
+  {
+    __m128f zero;
+    Acc::m128fZero(zero);
+
+    Acc::m128fMaxPS(x, x, zero);
+    Acc::m128fMinPS(x, x, FOG_XMM_GET_CONST_PS(m128f_4x_255));
+  }
+
+  //! @brief Pack four float components (already bound) to 32-bit pixels.
+  static FOG_INLINE void pack(__m128i& pix, const __m128f& fa, const __m128f& fr, const __m128f& fg, const __m128f& fb)
+  {
+    __m128i t0;
+
+    Acc::m128iCvtPI32FromPS(pix, fa);
+    Acc::m128iLShiftPU32<24>(pix, pix);
+
+    Acc::m128iCvtPI32FromPS(t0, fr);
+    Acc::m128iLShiftPU32<16>(t0, t0);
+    Acc::m128iOr(pix, pix, t0);
+
+    Acc::m128iCvtPI32FromPS(t0, fg);
+    Acc::m128iLShiftPU32<8>(t0, t0);
+    Acc::m128iOr(pix, pix, t0);
+
+    Acc::m128iCvtPI32FromPS(t0, fb);
+    Acc::m128iOr(pix, pix, t0);
+  }
+
+  //! @brief Compute a single output component (column @a j) of the matrix.
+  static FOG_INLINE void mulColumn(__m128f& dst, const __m128f mv[5][4], uint j,
+    const __m128f& fr, const __m128f& fg, const __m128f& fb)
+  {
+    __m128f t0;
+
+    Acc::m128fMulPS(dst, fr, mv[0][j]);
+    Acc::m128fMulPS(t0, fg, mv[1][j]);
+    Acc::m128fAddPS(dst, dst, t0);
+    Acc::m128fMulPS(t0, fb, mv[2][j]);
+    Acc::m128fAddPS(dst, dst, t0);
+    Acc::m128fAddPS(dst, dst, mv[4][j]);
+  }
+
+  static FOG_INLINE void mulColumn(__m128f& dst, const __m128f mv[5][4], uint j,
+    const __m128f& fa, const __m128f& fr, const __m128f& fg, const __m128f& fb)
+  {
+    __m128f t0;
+
+    mulColumn(dst, mv, j, fr, fg, fb);
+    Acc::m128fMulPS(t0, fa, mv[3][j]);
+    Acc::m128fAddPS(dst, dst, t0);
+  }
+
+  // ==========================================================================
+  // [ColorMatrix - Pixels]
+  // ==========================================================================
+
+  //! @brief Process four PRGB32 pixels, demultiplying the input and
+  //! premultiplying the output.
+  template<bool IsGrey>
+  static FOG_INLINE void doPixels_PRGB32(__m128i& pix, const __m128f mv[5][4])
+  {
+    __m128f fa, fr, fg, fb;
+    __m128f ta, tr, tg, tb;
+    __m128f t0;
+
+    unpack(fa, fr, fg, fb, pix);
+
+    // Demultiply, transparent pixels result in zero color (RGB is zero too).
+    Acc::m128fMaxPS(t0, fa, FOG_XMM_GET_CONST_PS(m128f_p1_p1_p1_p1));
+    Acc::m128fDivPS(t0, FOG_XMM_GET_CONST_PS(m128f_4x_255), t0);
+
+    Acc::m128fMulPS(fr, fr, t0);
+    Acc::m128fMulPS(fg, fg, t0);
+    Acc::m128fMulPS(fb, fb, t0);
+
+    mulColumn(ta, mv, 3, fa, fr, fg, fb);
+    bound(ta);
+
+    // Premultiply.
+    Acc::m128fMulPS(t0, ta, FOG_XMM_GET_CONST_PS(m128f_4x_1_div_255));
+
+    if (IsGrey)
+    {
+      mulColumn(tr, mv, 0, fa, fr, fg, fb);
+      bound(tr);
+      Acc::m128fMulPS(tr, tr, t0);
+      tg = tr;
+      tb = tr;
+    }
+    else
+    {
+      mulColumn(tr, mv, 0, fa, fr, fg, fb);
+      mulColumn(tg, mv, 1, fa, fr, fg, fb);
+      mulColumn(tb, mv, 2, fa, fr, fg, fb);
+
+      bound(tr);
+      bound(tg);
+      bound(tb);
+
+      Acc::m128fMulPS(tr, tr, t0);
+      Acc::m128fMulPS(tg, tg, t0);
+      Acc::m128fMulPS(tb, tb, t0);
+    }
+
+    pack(pix, ta, tr, tg, tb);
+  }
+
+  //! @brief Process four XRGB32 pixels, the alpha row of the matrix is
+  //! already folded into the translation.
+  template<bool IsGrey>
+  static FOG_INLINE void doPixels_XRGB32(__m128i& pix, const __m128f mv[5][4])
+  {
+    __m128f fa, fr, fg, fb;
+    __m128f tr, tg, tb;
+
+    unpack(fa, fr, fg, fb, pix);
+
+    if (IsGrey)
+    {
+      mulColumn(tr, mv, 0, fr, fg, fb);
+      bound(tr);
+      tg = tr;
+      tb = tr;
+    }
+    else
+    {
+      mulColumn(tr, mv, 0, fr, fg, fb);
+      mulColumn(tg, mv, 1, fr, fg, fb);
+      mulColumn(tb, mv, 2, fr, fg, fb);
+
+      bound(tr);
+      bound(tg);
+      bound(tb);
+    }
+
+    Acc::m128fZero(fa);
+    pack(pix, fa, tr, tg, tb);
+    Acc::m128iOr(pix, pix, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+  }
+
+  // ==========================================================================
+  // [ColorMatrix - DoLine]
+  // ==========================================================================
+
+  template<bool IsPRGB, bool IsGrey>
+  static FOG_INLINE void doLine(RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    __m128f mv[5][4];
+    loadMatrix(mv, ctx);
+
+    __m128i pix;
+
+    while (w >= 4)
+    {
+      Acc::m128iLoad16u(pix, src);
+
+      if (IsPRGB)
+        doPixels_PRGB32<IsGrey>(pix, mv);
+      else
+        doPixels_XRGB32<IsGrey>(pix, mv);
+
+      Acc::m128iStore16u(dst, pix);
+
+      dst += 16;
+      src += 16;
+      w -= 4;
+    }
+
+    if (w > 0)
+    {
+      uint32_t tmp[4] = { 0, 0, 0, 0 };
+      size_t tail = (size_t)(uint)w * 4;
+
+      MemOps::copy(tmp, src, tail);
+      Acc::m128iLoad16u(pix, tmp);
+
+      if (IsPRGB)
+        doPixels_PRGB32<IsGrey>(pix, mv);
+      else
+        doPixels_XRGB32<IsGrey>(pix, mv);
+
+      Acc::m128iStore16u(tmp, pix);
+      MemOps::copy(dst, tmp, tail);
+    }
+  }
+
+  static void FOG_FASTCALL doArgb_PRGB32(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    doLine<true, false>(ctx, dst, src, w);
+  }
+
+  static void FOG_FASTCALL doGrey_PRGB32(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    doLine<true, true>(ctx, dst, src, w);
+  }
+
+  static void FOG_FASTCALL doArgb_XRGB32(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    doLine<false, false>(ctx, dst, src, w);
+  }
+
+  static void FOG_FASTCALL doGrey_XRGB32(
+    RasterFilter* ctx, uint8_t* dst, const uint8_t* src, int w)
+  {
+    doLine<false, true>(ctx, dst, src, w);
+  }
+};
+
+} // RasterOps_SSE2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERCOLORMATRIX_P_H
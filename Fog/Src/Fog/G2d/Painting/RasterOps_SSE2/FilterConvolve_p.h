@@ -0,0 +1,277 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERCONVOLVE_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERCONVOLVE_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_SSE2/BaseDefs_p.h>
+
+namespace Fog {
+namespace RasterOps_SSE2 {
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Convolve]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Convolution kernels (SSE2).
+//!
+//! The weights are 16-bit fixed-point numbers and the count of weights is
+//! always even (padded by zero weight), so the components of two neighbor
+//! pixels (or rows) are interleaved and multiplied by a pair of weights using
+//! a single @c pmaddwd instruction.
+struct FOG_NO_EXPORT FConvolve
+{
+  // ==========================================================================
+  // [Convolve - Helpers]
+  // ==========================================================================
+
+  //! @brief Broadcast the pair of weights @a weights[0] and @a weights[1].
+  static FOG_INLINE void loadWeights(__m128i& dst, const int16_t* weights)
+  {
+    Acc::m128iLoad4(dst, weights);
+    Acc::m128iExtendPI32FromSI32(dst, dst);
+  }
+
+  //! @brief Broadcast the 32-bit @a value.
+  static FOG_INLINE void loadConstant(__m128i& dst, int value)
+  {
+    Acc::m128iCvtSI128FromSI(dst, value);
+    Acc::m128iExtendPI32FromSI32(dst, dst);
+  }
+
+  //! @brief Multiply the components of the pixels @a p0 and @a p1 (unpacked
+  //! to 16-bit, stored in the low quadword) by a pair of weights and add the
+  //! result to @a acc.
+  static FOG_INLINE void mulPair(__m128i& acc, const __m128i& p0, const __m128i& p1, const __m128i& wv)
+  {
+    __m128i t0;
+
+    Acc::m128iUnpackPI32FromPI16Lo(t0, p0, p1);
+    Acc::m128iMAddPI16(t0, t0, wv);
+    Acc::m128iAddPI32(acc, acc, t0);
+  }
+
+  // ==========================================================================
+  // [Convolve - Horizontal]
+  // ==========================================================================
+
+  //! @brief Horizontal pass of the separable convolution (32-bit pixels).
+  //!
+  //! Two destination pixels are processed at a time, they share the loaded
+  //! source pixels.
+  static void FOG_FASTCALL doH_32(
+    int16_t* dst, const uint8_t* src, int w,
+    const int16_t* weights, int count, int shift)
+  {
+    __m128i xmmShift, xmmRound;
+    __m128i acc0, acc1;
+    __m128i pix, p0, p1, p2;
+    __m128i wv;
+
+    Acc::m128iCvtSI128FromSI(xmmShift, shift);
+    loadConstant(xmmRound, (1 << shift) >> 1);
+
+    while (w >= 2)
+    {
+      const uint8_t* s = src;
+
+      acc0 = xmmRound;
+      acc1 = xmmRound;
+
+      for (int j = 0; j < count; j += 2, s += 8)
+      {
+        loadWeights(wv, weights + j);
+
+        // Pixels [j, j + 3] unpacked to 16-bit.
+        Acc::m128iLoad16u(pix, s);
+        Acc::m128iUnpackPI16FromPI8Lo(p0, pix);
+        Acc::m128iUnpackPI16FromPI8Hi(p2, pix);
+        Acc::m128iRShiftSU128<64>(p1, p0);
+
+        mulPair(acc0, p0, p1, wv);
+        mulPair(acc1, p1, p2, wv);
+      }
+
+      Acc::m128iRShiftPI32(acc0, acc0, xmmShift);
+      Acc::m128iRShiftPI32(acc1, acc1, xmmShift);
+      Acc::m128iPackPI16FromPI32(acc0, acc0, acc1);
+      Acc::m128iStore16u(dst, acc0);
+
+      dst += 8;
+      src += 8;
+      w -= 2;
+    }
+
+    if (w > 0)
+    {
+      const uint8_t* s = src;
+      acc0 = xmmRound;
+
+      for (int j = 0; j < count; j += 2, s += 8)
+      {
+        loadWeights(wv, weights + j);
+
+        Acc::m128iLoad8(pix, s);
+        Acc::m128iUnpackPI16FromPI8Lo(p0, pix);
+        Acc::m128iRShiftSU128<64>(p1, p0);
+
+        mulPair(acc0, p0, p1, wv);
+      }
+
+      Acc::m128iRShiftPI32(acc0, acc0, xmmShift);
+      Acc::m128iPackPI16FromPI32(acc0, acc0);
+      Acc::m128iStore8(dst, acc0);
+    }
+  }
+
+  // ==========================================================================
+  // [Convolve - Vertical]
+  // ==========================================================================
+
+  //! @brief Vertical pass of the separable convolution.
+  //!
+  //! The rows contain the 16-bit components only, so the same kernel is used
+  //! by all formats.
+  template<int NC>
+  static void FOG_FASTCALL doV(
+    uint8_t* dst, const int16_t* const* src, int w,
+    const int16_t* weights, int count, int bias, int shift)
+  {
+    __m128i xmmShift, xmmBias;
+    __m128i acc0, acc1;
+    __m128i a, b, t0;
+    __m128i wv;
+
+    Acc::m128iCvtSI128FromSI(xmmShift, shift);
+    loadConstant(xmmBias, bias);
+
+    int size = w * NC;
+    int i = 0;
+
+    for (; i + 8 <= size; i += 8)
+    {
+      acc0 = xmmBias;
+      acc1 = xmmBias;
+
+      for (int k = 0; k < count; k += 2)
+      {
+        loadWeights(wv, weights + k);
+
+        Acc::m128iLoad16u(a, src[k    ] + i);
+        Acc::m128iLoad16u(b, src[k + 1] + i);
+
+        Acc::m128iUnpackPI32FromPI16Lo(t0, a, b);
+        Acc::m128iMAddPI16(t0, t0, wv);
+        Acc::m128iAddPI32(acc0, acc0, t0);
+
+        Acc::m128iUnpackPI32FromPI16Hi(t0, a, b);
+        Acc::m128iMAddPI16(t0, t0, wv);
+        Acc::m128iAddPI32(acc1, acc1, t0);
+      }
+
+      Acc::m128iRShiftPI32(acc0, acc0, xmmShift);
+      Acc::m128iRShiftPI32(acc1, acc1, xmmShift);
+      Acc::m128iPackPU8FromPI32(acc0, acc0, acc1);
+      Acc::m128iStore8(dst + i, acc0);
+    }
+
+    for (; i < size; i++)
+    {
+      int acc = bias;
+
+      for (int k = 0; k < count; k++)
+        acc += (int)weights[k] * (int)src[k][i];
+
+      dst[i] = (uint8_t)Math::boundToByte(acc >> shift);
+    }
+  }
+
+  // ==========================================================================
+  // [Convolve - Matrix]
+  // ==========================================================================
+
+  //! @brief General matrix convolution (32-bit pixels).
+  static void FOG_FASTCALL doMatrix_32(
+    uint8_t* dst, const uint8_t* const* src, int w,
+    const int16_t* weights, int weightStride, int count, int bias, int shift)
+  {
+    __m128i xmmShift, xmmBias;
+    __m128i acc0, acc1;
+    __m128i pix, p0, p1, p2;
+    __m128i wv;
+
+    Acc::m128iCvtSI128FromSI(xmmShift, shift);
+    loadConstant(xmmBias, bias);
+
+    int x = 0;
+
+    for (; x + 2 <= w; x += 2)
+    {
+      const int16_t* wRow = weights;
+
+      acc0 = xmmBias;
+      acc1 = xmmBias;
+
+      for (int i = 0; i < count; i++, wRow += weightStride)
+      {
+        const uint8_t* s = src[i] + x * 4;
+
+        for (int j = 0; j < weightStride; j += 2, s += 8)
+        {
+          loadWeights(wv, wRow + j);
+
+          Acc::m128iLoad16u(pix, s);
+          Acc::m128iUnpackPI16FromPI8Lo(p0, pix);
+          Acc::m128iUnpackPI16FromPI8Hi(p2, pix);
+          Acc::m128iRShiftSU128<64>(p1, p0);
+
+          mulPair(acc0, p0, p1, wv);
+          mulPair(acc1, p1, p2, wv);
+        }
+      }
+
+      Acc::m128iRShiftPI32(acc0, acc0, xmmShift);
+      Acc::m128iRShiftPI32(acc1, acc1, xmmShift);
+      Acc::m128iPackPU8FromPI32(acc0, acc0, acc1);
+      Acc::m128iStore8(dst + x * 4, acc0);
+    }
+
+    if (x < w)
+    {
+      const int16_t* wRow = weights;
+      acc0 = xmmBias;
+
+      for (int i = 0; i < count; i++, wRow += weightStride)
+      {
+        const uint8_t* s = src[i] + x * 4;
+
+        for (int j = 0; j < weightStride; j += 2, s += 8)
+        {
+          loadWeights(wv, wRow + j);
+
+          Acc::m128iLoad8(pix, s);
+          Acc::m128iUnpackPI16FromPI8Lo(p0, pix);
+          Acc::m128iRShiftSU128<64>(p1, p0);
+
+          mulPair(acc0, p0, p1, wv);
+        }
+      }
+
+      Acc::m128iRShiftPI32(acc0, acc0, xmmShift);
+      Acc::m128iPackPU8FromPI32(acc0, acc0);
+      Acc::m128iStore4(dst + x * 4, acc0);
+    }
+  }
+};
+
+} // RasterOps_SSE2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERCONVOLVE_P_H
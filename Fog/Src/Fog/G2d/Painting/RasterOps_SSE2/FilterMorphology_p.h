@@ -0,0 +1,182 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERMORPHOLOGY_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERMORPHOLOGY_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_SSE2/BaseDefs_p.h>
+
+namespace Fog {
+namespace RasterOps_SSE2 {
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Morphology - Ops]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT FMorphologyErode
+{
+  static FOG_INLINE uint8_t op(uint8_t a, uint8_t b) { return a < b ? a : b; }
+  static FOG_INLINE void op(__m128i& dst, const __m128i& a, const __m128i& b) { Acc::m128iMinPU8(dst, a, b); }
+};
+
+//! @internal
+struct FOG_NO_EXPORT FMorphologyDilate
+{
+  static FOG_INLINE uint8_t op(uint8_t a, uint8_t b) { return a > b ? a : b; }
+  static FOG_INLINE void op(__m128i& dst, const __m128i& a, const __m128i& b) { Acc::m128iMaxPU8(dst, a, b); }
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Morphology]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Morphology kernels (SSE2), see @c RasterOps_C::FMorphology.
+//!
+//! The vertical pass (and the final step of the horizontal pass) is a minimum
+//! or maximum of two rows, which is done by @c pminub / @c pmaxub on 16 bytes
+//! at a time. The prefix and suffix runs of the horizontal pass are serial,
+//! but all components of a 32-bit pixel are processed by one instruction.
+struct FOG_NO_EXPORT FMorphology
+{
+  // ==========================================================================
+  // [Morphology - Horizontal]
+  // ==========================================================================
+
+  template<typename Op>
+  static void FOG_FASTCALL doH_32(
+    uint8_t* dst, const uint8_t* src, int w, int size,
+    uint8_t* g, uint8_t* h)
+  {
+    int n = w + size - 1;
+    int i, k;
+
+    __m128i run, pix;
+
+    // Prefix runs.
+    for (i = 0, k = 0; i < n; i++)
+    {
+      Acc::m128iLoad4(pix, src + i * 4);
+
+      if (k == 0)
+        run = pix;
+      else
+        Op::op(run, run, pix);
+
+      Acc::m128iStore4(g + i * 4, run);
+
+      if (++k == size)
+        k = 0;
+    }
+
+    // Suffix runs, the blocks are aligned to the start of the row.
+    k = (n - 1) % size;
+    for (i = n - 1; i >= 0; i--)
+    {
+      Acc::m128iLoad4(pix, src + i * 4);
+
+      if (i == n - 1 || k == size - 1)
+        run = pix;
+      else
+        Op::op(run, run, pix);
+
+      Acc::m128iStore4(h + i * 4, run);
+
+      if (--k < 0)
+        k = size - 1;
+    }
+
+    doV<Op>(dst, h, g + (size - 1) * 4, (size_t)(uint)w * 4);
+  }
+
+  template<typename Op>
+  static void FOG_FASTCALL doH_8(
+    uint8_t* dst, const uint8_t* src, int w, int size,
+    uint8_t* g, uint8_t* h)
+  {
+    int n = w + size - 1;
+    int i, k;
+
+    uint8_t run = 0;
+
+    for (i = 0, k = 0; i < n; i++)
+    {
+      run = (k == 0) ? src[i] : Op::op(run, src[i]);
+      g[i] = run;
+
+      if (++k == size)
+        k = 0;
+    }
+
+    k = (n - 1) % size;
+    for (i = n - 1; i >= 0; i--)
+    {
+      run = (i == n - 1 || k == size - 1) ? src[i] : Op::op(run, src[i]);
+      h[i] = run;
+
+      if (--k < 0)
+        k = size - 1;
+    }
+
+    doV<Op>(dst, h, g + (size - 1), (size_t)(uint)w);
+  }
+
+  // ==========================================================================
+  // [Morphology - Vertical]
+  // ==========================================================================
+
+  template<typename Op>
+  static void FOG_FASTCALL doV(
+    uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t size)
+  {
+    __m128i x0, y0;
+    __m128i x1, y1;
+
+    while (size >= 32)
+    {
+      Acc::m128iLoad16u(x0, a);
+      Acc::m128iLoad16u(y0, b);
+      Acc::m128iLoad16u(x1, a + 16);
+      Acc::m128iLoad16u(y1, b + 16);
+
+      Op::op(x0, x0, y0);
+      Op::op(x1, x1, y1);
+
+      Acc::m128iStore16u(dst, x0);
+      Acc::m128iStore16u(dst + 16, x1);
+
+      dst += 32;
+      a += 32;
+      b += 32;
+      size -= 32;
+    }
+
+    while (size >= 4)
+    {
+      Acc::m128iLoad4(x0, a);
+      Acc::m128iLoad4(y0, b);
+      Op::op(x0, x0, y0);
+      Acc::m128iStore4(dst, x0);
+
+      dst += 4;
+      a += 4;
+      b += 4;
+      size -= 4;
+    }
+
+    for (size_t i = 0; i < size; i++)
+      dst[i] = Op::op(a[i], b[i]);
+  }
+};
+
+} // RasterOps_SSE2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERMORPHOLOGY_P_H
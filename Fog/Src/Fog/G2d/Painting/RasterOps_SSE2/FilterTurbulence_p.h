@@ -0,0 +1,173 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERTURBULENCE_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERTURBULENCE_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_SSE2/BaseDefs_p.h>
+
+// [Dependencies - RasterOps_C]
+#include <Fog/G2d/Painting/RasterOps_C/FilterTurbulence_p.h>
+
+namespace Fog {
+namespace RasterOps_SSE2 {
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Turbulence]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Turbulence generator (SSE2), see @c RasterOps_C::FTurbulence.
+//!
+//! The lattice cell is computed once per pixel and octave, the four color
+//! channels are then evaluated at once, each one in a single SIMD lane (the
+//! gradients of one lattice point are two @c __m128 registers).
+struct FOG_NO_EXPORT FTurbulence
+{
+  //! @brief Broadcast the scalar @a value.
+  static FOG_INLINE void broadcast(__m128f& dst, float value)
+  {
+    Acc::m128fLoad4(dst, &value);
+    Acc::m128fExtendSS(dst, dst);
+  }
+
+  //! @brief Dot product of the distance [@a rx, @a ry] and the gradient @a g.
+  static FOG_INLINE void dot(__m128f& dst, const __m128f& rx, const __m128f& ry, const float* g)
+  {
+    __m128f gx, gy;
+
+    Acc::m128fLoad16u(gx, g);
+    Acc::m128fLoad16u(gy, g + 4);
+
+    Acc::m128fMulPS(gx, gx, rx);
+    Acc::m128fMulPS(gy, gy, ry);
+    Acc::m128fAddPS(dst, gx, gy);
+  }
+
+  //! @brief Linear interpolation, @a a + @a t * (@a b - @a a).
+  static FOG_INLINE void lerp(__m128f& dst, const __m128f& t, const __m128f& a, const __m128f& b)
+  {
+    __m128f d;
+
+    Acc::m128fSubPS(d, b, a);
+    Acc::m128fMulPS(d, d, t);
+    Acc::m128fAddPS(dst, a, d);
+  }
+
+  //! @brief Generate the turbulence, see @c RasterFilterTurbulenceFunc.
+  template<uint32_t TurbulenceType>
+  static void FOG_FASTCALL doTurbulence(
+    uint8_t* dst, const RasterFilter* ctx, const RasterTurbulenceTile* tile,
+    int x, int y, int w)
+  {
+    const RasterFilter::_Turbulence& d = ctx->turbulence;
+    const RasterTurbulenceLattice* lattice = d.lattice;
+
+    uint32_t numOctaves = d.numOctaves;
+    float py = (float)y * tile->vBaseFrequency;
+
+    __m128f xmmHalf;
+    __m128f xmmZero;
+
+    broadcast(xmmHalf, 0.5f);
+    Acc::m128fZero(xmmZero);
+
+    for (int i = 0; i < w; i++, dst += 4)
+    {
+      RasterTurbulenceTile t = *tile;
+
+      float vx = (float)(x + i) * tile->hBaseFrequency;
+      float vy = py;
+      float ratio = 1.0f;
+
+      __m128f sum = xmmZero;
+      RasterOps_C::FTurbulenceCell cell;
+
+      for (uint32_t octave = 0; octave < numOctaves; octave++)
+      {
+        RasterOps_C::FTurbulence::getCell(cell, lattice, t, vx, vy);
+
+        __m128f rx0, ry0, rx1, ry1, sx, sy;
+        __m128f u, v, a, b;
+
+        broadcast(rx0, cell.rx0);
+        broadcast(ry0, cell.ry0);
+        broadcast(rx1, cell.rx0 - 1.0f);
+        broadcast(ry1, cell.ry0 - 1.0f);
+        broadcast(sx, cell.sx);
+        broadcast(sy, cell.sy);
+
+        dot(u, rx0, ry0, cell.g00);
+        dot(v, rx1, ry0, cell.g10);
+        lerp(a, sx, u, v);
+
+        dot(u, rx0, ry1, cell.g01);
+        dot(v, rx1, ry1, cell.g11);
+        lerp(b, sx, u, v);
+
+        lerp(a, sy, a, b);
+
+        if (TurbulenceType != FE_TURBULENCE_TYPE_FRACTAL_NOISE)
+          Acc::m128fAnd(a, a, FOG_XMM_GET_CONST_PS(m128f_nm_nm_nm_nm));
+
+        broadcast(b, ratio);
+        Acc::m128fMulPS(a, a, b);
+        Acc::m128fAddPS(sum, sum, a);
+
+        vx *= 2.0f;
+        vy *= 2.0f;
+        ratio *= 0.5f;
+
+        if (t.stitchTiles)
+          RasterOps_C::FTurbulence::nextOctave(t);
+      }
+
+      storePixel<TurbulenceType>(dst, sum, xmmZero, xmmHalf);
+    }
+  }
+
+  //! @brief Convert the turbulence sums of B, G, R, A channels to a
+  //! premultiplied pixel.
+  template<uint32_t TurbulenceType>
+  static FOG_INLINE void storePixel(uint8_t* dst, __m128f c,
+    const __m128f& xmmZero, const __m128f& xmmHalf)
+  {
+    __m128f am, t;
+    __m128i pix;
+
+    Acc::m128fMulPS(c, c, FOG_XMM_GET_CONST_PS(m128f_4x_255));
+
+    if (TurbulenceType == FE_TURBULENCE_TYPE_FRACTAL_NOISE)
+    {
+      Acc::m128fAddPS(c, c, FOG_XMM_GET_CONST_PS(m128f_4x_255));
+      Acc::m128fMulPS(c, c, xmmHalf);
+    }
+
+    Acc::m128fMaxPS(c, c, xmmZero);
+    Acc::m128fMinPS(c, c, FOG_XMM_GET_CONST_PS(m128f_4x_255));
+
+    // Premultiply, keep the alpha (the last lane) unchanged.
+    Acc::m128fShuffle<3, 3, 3, 3>(am, c);
+    Acc::m128fMulPS(am, am, FOG_XMM_GET_CONST_PS(m128f_4x_1_div_255));
+    Acc::m128fMulPS(am, am, c);
+
+    Acc::m128fShuffle<3, 3, 2, 2>(t, am, c);
+    Acc::m128fShuffle<2, 0, 1, 0>(c, am, t);
+
+    Acc::m128fAddPS(c, c, xmmHalf);
+    Acc::m128iTruncPI32FromPS(pix, c);
+    Acc::m128iPackPU8FromPI32(pix, pix);
+    Acc::m128iStore4(dst, pix);
+  }
+};
+
+} // RasterOps_SSE2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERTURBULENCE_P_H
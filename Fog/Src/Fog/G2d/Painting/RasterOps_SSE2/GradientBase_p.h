@@ -264,6 +264,161 @@ struct FOG_NO_EXPORT PGradientBase
   }
 };
 
+// ============================================================================
+// [Fog::RasterOps_SSE2 - PGradientAccessor_PRGB32_Base]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Base of the SSE2 gradient accessors, which work with four table
+//! positions at a time.
+//!
+//! The positions are calculated as two pairs of DP-FP values (the lanes
+//! [0, 1] in @c p0 and [2, 3] in @c p1), converted to integers by the spread
+//! specific @c index() and then fetched from the table by @c store().
+struct FOG_NO_EXPORT PGradientAccessor_PRGB32_Base
+{
+  enum { DST_BPP = 4 };
+
+  FOG_INLINE PGradientAccessor_PRGB32_Base(const RasterPattern* ctx) :
+    _table(reinterpret_cast<const uint32_t*>(ctx->_d.gradient.base.table)) {}
+
+  //! @brief Broadcast the integer @a value.
+  static FOG_INLINE void broadcast(__m128i& dst, int value)
+  {
+    Acc::m128iCvtSI128FromSI(dst, value);
+    Acc::m128iExtendPI32FromSI32(dst, dst);
+  }
+
+  //! @brief Broadcast the DP-FP @a value.
+  static FOG_INLINE void broadcast(__m128d& dst, double value)
+  {
+    Acc::m128dExtendLo(dst, &value);
+  }
+
+  //! @brief Truncate the DP-FP pairs @a p0 and @a p1 to four integers.
+  static FOG_INLINE void truncate(__m128i& dst, const __m128d& p0, const __m128d& p1)
+  {
+    __m128i i1;
+
+    Acc::m128iTruncPI32FromPD(dst, p0);
+    Acc::m128iTruncPI32FromPD(i1, p1);
+    Acc::m128iUnpackSI128FromPI64Lo(dst, dst, i1);
+  }
+
+  //! @brief Store @a n (1 to 4) pixels at the table positions @a idx.
+  FOG_INLINE void store(uint8_t* dst, const __m128i& idx, int n)
+  {
+    FOG_ALIGNED_VAR(int, pos[4], 16);
+    Acc::m128iStore16a(pos, idx);
+
+    Acc::p32Store4a(dst + 0, _table[pos[0]]);
+    if (n < 2) return;
+    Acc::p32Store4a(dst + 4, _table[pos[1]]);
+    if (n < 3) return;
+    Acc::p32Store4a(dst + 8, _table[pos[2]]);
+    if (n < 4) return;
+    Acc::p32Store4a(dst + 12, _table[pos[3]]);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  const uint32_t* _table;
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - PGradientAccessor_PRGB32_Pad]
+// ============================================================================
+
+struct FOG_NO_EXPORT PGradientAccessor_PRGB32_Pad : public PGradientAccessor_PRGB32_Base
+{
+  FOG_INLINE PGradientAccessor_PRGB32_Pad(const RasterPattern* ctx) :
+    PGradientAccessor_PRGB32_Base(ctx)
+  {
+    broadcast(_len, (double)ctx->_d.gradient.base.len);
+    broadcast(_zero, 0.0);
+  }
+
+  FOG_INLINE void index(__m128i& dst, __m128d p0, __m128d p1)
+  {
+    // Clamp before the conversion, positions out of the integer range would
+    // be converted to 0x80000000.
+    Acc::m128dMaxPD(p0, p0, _zero);
+    Acc::m128dMaxPD(p1, p1, _zero);
+    Acc::m128dMinPD(p0, p0, _len);
+    Acc::m128dMinPD(p1, p1, _len);
+
+    truncate(dst, p0, p1);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  __m128d _len;
+  __m128d _zero;
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - PGradientAccessor_PRGB32_Repeat]
+// ============================================================================
+
+struct FOG_NO_EXPORT PGradientAccessor_PRGB32_Repeat : public PGradientAccessor_PRGB32_Base
+{
+  FOG_INLINE PGradientAccessor_PRGB32_Repeat(const RasterPattern* ctx) :
+    PGradientAccessor_PRGB32_Base(ctx)
+  {
+    broadcast(_lenMask, ctx->_d.gradient.base.len - 1);
+  }
+
+  FOG_INLINE void index(__m128i& dst, const __m128d& p0, const __m128d& p1)
+  {
+    truncate(dst, p0, p1);
+    Acc::m128iAnd(dst, dst, _lenMask);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  __m128i _lenMask;
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - PGradientAccessor_PRGB32_Reflect]
+// ============================================================================
+
+struct FOG_NO_EXPORT PGradientAccessor_PRGB32_Reflect : public PGradientAccessor_PRGB32_Base
+{
+  FOG_INLINE PGradientAccessor_PRGB32_Reflect(const RasterPattern* ctx) :
+    PGradientAccessor_PRGB32_Base(ctx)
+  {
+    broadcast(_len, ctx->_d.gradient.base.len);
+    broadcast(_lenMask2, ctx->_d.gradient.base.len * 2 - 1);
+  }
+
+  FOG_INLINE void index(__m128i& dst, const __m128d& p0, const __m128d& p1)
+  {
+    __m128i msk;
+
+    truncate(dst, p0, p1);
+    Acc::m128iAnd(dst, dst, _lenMask2);
+
+    Acc::m128iCmpGtPI32(msk, dst, _len);
+    Acc::m128iAnd(msk, msk, _lenMask2);
+    Acc::m128iXor(dst, dst, msk);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  __m128i _len;
+  __m128i _lenMask2;
+};
+
 } // RasterOps_SSE2 namespace
 } // Fog namespace
 
@@ -14,9 +14,182 @@ namespace Fog {
 namespace RasterOps_SSE2 {
 
 // ============================================================================
-// [Fog::RasterOps_SSE2]
+// [Fog::RasterOps_SSE2 - PGradientConical]
 // ============================================================================
 
+//! @internal
+struct FOG_NO_EXPORT PGradientConical
+{
+  //! @brief Broadcast the scalar @a value.
+  static FOG_INLINE void broadcast(__m128f& dst, float value)
+  {
+    Acc::m128fLoad4(dst, &value);
+    Acc::m128fExtendSS(dst, dst);
+  }
+
+  //! @brief Convert two DP-FP pairs to four SP-FP values.
+  static FOG_INLINE void packPS(__m128f& dst, const __m128d& p0, const __m128d& p1)
+  {
+    __m128f t;
+
+    Acc::m128fCvtPSFromPD(dst, p0);
+    Acc::m128fCvtPSFromPD(t, p1);
+    Acc::m128fMoveLH(dst, dst, t);
+  }
+
+  //! @brief Select @a b where the @a msk is set, otherwise @a a.
+  static FOG_INLINE void select(__m128f& dst, const __m128f& a, const __m128f& b, const __m128f& msk)
+  {
+    __m128f t;
+
+    Acc::m128fXor(t, a, b);
+    Acc::m128fAnd(t, t, msk);
+    Acc::m128fXor(dst, a, t);
+  }
+
+  // ==========================================================================
+  // [Fetch - Simple]
+  // ==========================================================================
+
+  //! @brief Conical gradient fetcher, see
+  //! @c RasterOps_C::PGradientConical::fetch_simple_nearest().
+  //!
+  //! Four pixels are processed at a time, the @c atan2() is replaced by the
+  //! polynomial approximation of @c atan() in the [0, 1] range, which is then
+  //! mirrored to the full circle. The maximum error of the approximation is
+  //! about 2e-6 radians, which is less than 0.001 of a table entry for the
+  //! longest (1024 entries) table.
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_simple_nearest(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+    Accessor accessor(ctx);
+
+    P_FETCH_SPAN8_INIT()
+
+    double dx = ctx->_d.gradient.conical.simple.xx;
+    double dy = ctx->_d.gradient.conical.simple.xy;
+
+    __m128d xmmDx4, xmmDy4;
+    __m128f xmmOffset, xmmScale;
+    __m128f xmmC[6];
+    __m128f xmmPi, xmmPiDiv2, xmmZero;
+    __m128i xmmLenMask;
+
+    Accessor::broadcast(xmmDx4, dx * 4.0);
+    Accessor::broadcast(xmmDy4, dy * 4.0);
+    Accessor::broadcast(xmmLenMask, ctx->_d.gradient.base.len - 1);
+
+    broadcast(xmmOffset, (float)ctx->_d.gradient.conical.simple.offset);
+    broadcast(xmmScale, (float)ctx->_d.gradient.conical.simple.scale);
+
+    broadcast(xmmC[0],  0.99997726f);
+    broadcast(xmmC[1], -0.33262347f);
+    broadcast(xmmC[2],  0.19354346f);
+    broadcast(xmmC[3], -0.11643287f);
+    broadcast(xmmC[4],  0.05265332f);
+    broadcast(xmmC[5], -0.01172120f);
+
+    broadcast(xmmPi, float(MATH_PI));
+    broadcast(xmmPiDiv2, float(MATH_HALF_PI));
+    Acc::m128fZero(xmmZero);
+
+    P_FETCH_SPAN8_BEGIN()
+      P_FETCH_SPAN8_SET_CURRENT()
+
+      double _x = (double)x;
+      double px = _x * dx + fetcher->_d.gradient.conical.simple.px;
+      double py = _x * dy + fetcher->_d.gradient.conical.simple.py;
+
+      double t[8] =
+      {
+        px, px + dx, px + dx * 2.0, px + dx * 3.0,
+        py, py + dy, py + dy * 2.0, py + dy * 3.0
+      };
+
+      __m128d xmmPx0, xmmPx1;
+      __m128d xmmPy0, xmmPy1;
+
+      Acc::m128dLoad16u(xmmPx0, t + 0);
+      Acc::m128dLoad16u(xmmPx1, t + 2);
+      Acc::m128dLoad16u(xmmPy0, t + 4);
+      Acc::m128dLoad16u(xmmPy1, t + 6);
+
+      for (;;)
+      {
+        __m128f fx, fy, ax, ay;
+        __m128f a, s, r, msk;
+        __m128i idx;
+
+        packPS(fx, xmmPx0, xmmPx1);
+        packPS(fy, xmmPy0, xmmPy1);
+
+        Acc::m128fAnd(ax, fx, FOG_XMM_GET_CONST_PS(m128f_nm_nm_nm_nm));
+        Acc::m128fAnd(ay, fy, FOG_XMM_GET_CONST_PS(m128f_nm_nm_nm_nm));
+
+        // a = min(|x|, |y|) / max(|x|, |y|), in [0, 1].
+        Acc::m128fMinPS(a, ax, ay);
+        Acc::m128fMaxPS(s, ax, ay);
+        Acc::m128fMaxPS(s, s, FOG_XMM_GET_CONST_PS(m128f_eps_eps_eps_eps));
+        Acc::m128fDivPS(a, a, s);
+
+        // r = atan(a) ~ a * (C0 + C1 * a^2 + C2 * a^4 + ... + C5 * a^10).
+        Acc::m128fMulPS(s, a, a);
+        Acc::m128fMulPS(r, s, xmmC[5]);
+
+        for (uint i = 4; i > 0; i--)
+        {
+          Acc::m128fAddPS(r, r, xmmC[i]);
+          Acc::m128fMulPS(r, r, s);
+        }
+
+        Acc::m128fAddPS(r, r, xmmC[0]);
+        Acc::m128fMulPS(r, r, a);
+
+        // Mirror to the full circle.
+        Acc::m128fCmpGtPS(msk, ay, ax);
+        Acc::m128fSubPS(s, xmmPiDiv2, r);
+        select(r, r, s, msk);
+
+        Acc::m128fCmpLtPS(msk, fx, xmmZero);
+        Acc::m128fSubPS(s, xmmPi, r);
+        select(r, r, s, msk);
+
+        Acc::m128fAnd(msk, fy, FOG_XMM_GET_CONST_PS(m128f_sn_sn_sn_sn));
+        Acc::m128fXor(r, r, msk);
+
+        // Table position (the conical gradient always repeats).
+        Acc::m128fMulPS(r, r, xmmScale);
+        Acc::m128fSubPS(r, xmmOffset, r);
+        Acc::m128iTruncPI32FromPS(idx, r);
+        Acc::m128iAnd(idx, idx, xmmLenMask);
+
+        if (w <= 4)
+        {
+          accessor.store(dst, idx, w);
+          dst += (uint)w * Accessor::DST_BPP;
+          break;
+        }
+
+        accessor.store(dst, idx, 4);
+        dst += 4 * Accessor::DST_BPP;
+        w -= 4;
+
+        Acc::m128dAddPD(xmmPx0, xmmPx0, xmmDx4);
+        Acc::m128dAddPD(xmmPx1, xmmPx1, xmmDx4);
+        Acc::m128dAddPD(xmmPy0, xmmPy0, xmmDy4);
+        Acc::m128dAddPD(xmmPy1, xmmPy1, xmmDy4);
+      }
+
+      P_FETCH_SPAN8_NEXT()
+    P_FETCH_SPAN8_END()
+
+    fetcher->_d.gradient.conical.simple.px += fetcher->_d.gradient.conical.simple.dx;
+    fetcher->_d.gradient.conical.simple.py += fetcher->_d.gradient.conical.simple.dy;
+  }
+};
+
 } // RasterOps_SSE2 namespace
 } // Fog namespace
 
@@ -14,9 +14,132 @@ namespace Fog {
 namespace RasterOps_SSE2 {
 
 // ============================================================================
-// [Fog::RasterOps_SSE2]
+// [Fog::RasterOps_SSE2 - PGradientRadial]
 // ============================================================================
 
+//! @internal
+struct FOG_NO_EXPORT PGradientRadial
+{
+  // ==========================================================================
+  // [Fetch - Simple]
+  // ==========================================================================
+
+  //! @brief Radial gradient fetcher (affine transform), see
+  //! @c RasterOps_C::PGradientRadial::fetch_simple_nearest().
+  //!
+  //! Four pixels are processed at a time. Each lane steps its own copy of the
+  //! quadratic 'd' by four pixels, the first difference of the four pixel step
+  //! is 'E = 4 * d_d + 6 * d_d_d' and it grows by '16 * d_d_d' per step, so
+  //! there are only additions, one square root and one multiplication per
+  //! position.
+  template<typename Accessor>
+  static void FOG_FASTCALL fetch_simple_nearest(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+    Accessor accessor(ctx);
+
+    P_FETCH_SPAN8_INIT()
+
+    double b_d   = ctx->_d.gradient.radial.simple.b_d;
+    double d_d_d = ctx->_d.gradient.radial.simple.d_d_d;
+
+    __m128d xmmScale;
+    __m128d xmmB4;
+    __m128d xmmE4;
+
+    Accessor::broadcast(xmmScale, ctx->_d.gradient.radial.simple.scale);
+    Accessor::broadcast(xmmB4, b_d * 4.0);
+    Accessor::broadcast(xmmE4, d_d_d * 16.0);
+
+    P_FETCH_SPAN8_BEGIN()
+      P_FETCH_SPAN8_SET_CURRENT()
+
+      double _x    = (double)x;
+      double px    = _x * ctx->_d.gradient.radial.simple.xx + fetcher->_d.gradient.radial.simple.px;
+      double py    = _x * ctx->_d.gradient.radial.simple.xy + fetcher->_d.gradient.radial.simple.py;
+
+      double b     = ctx->_d.gradient.radial.simple.fx * px +
+                     ctx->_d.gradient.radial.simple.fy * py;
+      double d     = ctx->_d.gradient.radial.simple.r2mfyfy * px * px +
+                     ctx->_d.gradient.radial.simple.r2mfxfx * py * py +
+                     ctx->_d.gradient.radial.simple._2_fxfy * px * py;
+      double d_d   = ctx->_d.gradient.radial.simple.d_d +
+                     ctx->_d.gradient.radial.simple.d_d_x * px +
+                     ctx->_d.gradient.radial.simple.d_d_y * py;
+
+      // Setup the lanes (b, d and the four pixel difference of d).
+      double t[12];
+      for (uint i = 0; i < 4; i++)
+      {
+        t[i    ] = b;
+        t[i + 4] = d;
+        t[i + 8] = 4.0 * d_d + 6.0 * d_d_d;
+
+        b   += b_d;
+        d   += d_d;
+        d_d += d_d_d;
+      }
+
+      __m128d xmmB0, xmmB1;
+      __m128d xmmD0, xmmD1;
+      __m128d xmmE0, xmmE1;
+
+      Acc::m128dLoad16u(xmmB0, t + 0);
+      Acc::m128dLoad16u(xmmB1, t + 2);
+      Acc::m128dLoad16u(xmmD0, t + 4);
+      Acc::m128dLoad16u(xmmD1, t + 6);
+      Acc::m128dLoad16u(xmmE0, t + 8);
+      Acc::m128dLoad16u(xmmE1, t + 10);
+
+      for (;;)
+      {
+        __m128d p0, p1;
+        __m128i idx;
+
+        Acc::m128dAnd(p0, xmmD0, FOG_XMM_GET_CONST_PD(m128d_nm_nm));
+        Acc::m128dAnd(p1, xmmD1, FOG_XMM_GET_CONST_PD(m128d_nm_nm));
+
+        Acc::m128dSqrtPD(p0, p0);
+        Acc::m128dSqrtPD(p1, p1);
+
+        Acc::m128dAddPD(p0, p0, xmmB0);
+        Acc::m128dAddPD(p1, p1, xmmB1);
+
+        Acc::m128dMulPD(p0, p0, xmmScale);
+        Acc::m128dMulPD(p1, p1, xmmScale);
+
+        accessor.index(idx, p0, p1);
+
+        if (w <= 4)
+        {
+          accessor.store(dst, idx, w);
+          dst += (uint)w * Accessor::DST_BPP;
+          break;
+        }
+
+        accessor.store(dst, idx, 4);
+        dst += 4 * Accessor::DST_BPP;
+        w -= 4;
+
+        Acc::m128dAddPD(xmmB0, xmmB0, xmmB4);
+        Acc::m128dAddPD(xmmB1, xmmB1, xmmB4);
+
+        Acc::m128dAddPD(xmmD0, xmmD0, xmmE0);
+        Acc::m128dAddPD(xmmD1, xmmD1, xmmE1);
+
+        Acc::m128dAddPD(xmmE0, xmmE0, xmmE4);
+        Acc::m128dAddPD(xmmE1, xmmE1, xmmE4);
+      }
+
+      P_FETCH_SPAN8_NEXT()
+    P_FETCH_SPAN8_END()
+
+    fetcher->_d.gradient.radial.simple.px += fetcher->_d.gradient.radial.simple.dx;
+    fetcher->_d.gradient.radial.simple.py += fetcher->_d.gradient.radial.simple.dy;
+  }
+};
+
 } // RasterOps_SSE2 namespace
 } // Fog namespace
 
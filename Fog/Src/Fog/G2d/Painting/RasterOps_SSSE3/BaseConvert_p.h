@@ -0,0 +1,195 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_SSSE3_BASECONVERT_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_SSSE3_BASECONVERT_P_H
+
+// [Dependencies - RasterOps_C]
+#include <Fog/G2d/Painting/RasterOps_C/BaseConvert_p.h>
+
+// [Dependencies - RasterOps_SSE2]
+#include <Fog/G2d/Painting/RasterOps_SSE2/BaseDefs_p.h>
+
+// [Dependencies - Acc]
+#include <Fog/G2d/Acc/AccSsse3.h>
+
+namespace Fog {
+namespace RasterOps_SSSE3 {
+
+// ============================================================================
+// [Fog::RasterOps_SSSE3 - Convert]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Pixel format conversion which needs byte shuffle (24-bit formats).
+struct FOG_NO_EXPORT Convert
+{
+  // ==========================================================================
+  // [BSwap - 24]
+  // ==========================================================================
+
+  static void FOG_FASTCALL bswap_24(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    // Four pixels are processed by each 16-byte load/store, the last four
+    // bytes are kept as is and overwritten by the next store. Because of
+    // this the loop needs two extra pixels to stay inside the buffers, and
+    // it's safe also for in-place conversion.
+    FOG_XMM_DECLARE_CONST_PI8_VAR(BSwap24,
+      15, 14, 13, 12,  9, 10, 11,  6,
+       7,  8,  3,  4,  5,  0,  1,  2);
+
+    if (w >= 18)
+    {
+      __m128i mskxmm = FOG_XMM_GET_CONST_PI(BSwap24);
+
+      do {
+        __m128i pix0xmm, pix1xmm;
+        __m128i pix2xmm, pix3xmm;
+
+        Acc::m128iLoad16u(pix0xmm, src +  0);
+        Acc::m128iShufflePI8(pix0xmm, pix0xmm, mskxmm);
+        Acc::m128iStore16u(dst +  0, pix0xmm);
+
+        Acc::m128iLoad16u(pix1xmm, src + 12);
+        Acc::m128iShufflePI8(pix1xmm, pix1xmm, mskxmm);
+        Acc::m128iStore16u(dst + 12, pix1xmm);
+
+        Acc::m128iLoad16u(pix2xmm, src + 24);
+        Acc::m128iShufflePI8(pix2xmm, pix2xmm, mskxmm);
+        Acc::m128iStore16u(dst + 24, pix2xmm);
+
+        Acc::m128iLoad16u(pix3xmm, src + 36);
+        Acc::m128iShufflePI8(pix3xmm, pix3xmm, mskxmm);
+        Acc::m128iStore16u(dst + 36, pix3xmm);
+
+        dst += 48;
+        src += 48;
+        w -= 16;
+      } while (w >= 18);
+
+      if (w == 0)
+        return;
+    }
+
+    RasterOps_C::Convert::bswap_24(dst, src, w, closure);
+  }
+
+  // ==========================================================================
+  // [Convert - ARGB32 <- Custom]
+  // ==========================================================================
+
+  static void FOG_FASTCALL argb32_from_rgb24_888_bs(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    FOG_XMM_DECLARE_CONST_PI8_VAR(ARGB32_From_RGB24_BS,
+      0x80,    9,   10,   11, 0x80,    6,    7,    8,
+      0x80,    3,    4,    5, 0x80,    0,    1,    2);
+
+    __m128i mskxmm = FOG_XMM_GET_CONST_PI(ARGB32_From_RGB24_BS);
+
+    while ((w -= 16) >= 0)
+    {
+      __m128i pix0xmm, pix1xmm;
+      __m128i pix2xmm, pix3xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src +  0);
+      Acc::m128iLoad16u(pix1xmm, src + 16);
+      Acc::m128iLoad16u(pix3xmm, src + 32);
+
+      Acc::m128iAlignrPI8<8>(pix2xmm, pix3xmm, pix1xmm);
+      Acc::m128iAlignrPI8<12>(pix1xmm, pix1xmm, pix0xmm);
+      Acc::m128iRShiftSU128<32>(pix3xmm, pix3xmm);
+
+      Acc::m128iShufflePI8(pix0xmm, pix0xmm, mskxmm);
+      Acc::m128iShufflePI8(pix1xmm, pix1xmm, mskxmm);
+      Acc::m128iShufflePI8(pix2xmm, pix2xmm, mskxmm);
+      Acc::m128iShufflePI8(pix3xmm, pix3xmm, mskxmm);
+
+      Acc::m128iOr(pix0xmm, pix0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iOr(pix1xmm, pix1xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iOr(pix2xmm, pix2xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iOr(pix3xmm, pix3xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+
+      Acc::m128iStore16u(dst +  0, pix0xmm);
+      Acc::m128iStore16u(dst + 16, pix1xmm);
+      Acc::m128iStore16u(dst + 32, pix2xmm);
+      Acc::m128iStore16u(dst + 48, pix3xmm);
+
+      dst += 64;
+      src += 48;
+    }
+
+    w += 16;
+    if (w) RasterOps_C::Convert::argb32_from_rgb24_888_bs(dst, src, w, closure);
+  }
+
+  // ==========================================================================
+  // [Convert - Custom <- ARGB32]
+  // ==========================================================================
+
+  static void FOG_FASTCALL rgb24_888_bs_from_argb32(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    FOG_XMM_DECLARE_CONST_PI8_VAR(RGB24_BS_From_ARGB32,
+      0x80, 0x80, 0x80, 0x80,   12,   13,   14,    8,
+         9,   10,    4,    5,    6,    0,    1,    2);
+
+    __m128i mskxmm = FOG_XMM_GET_CONST_PI(RGB24_BS_From_ARGB32);
+
+    while ((w -= 16) >= 0)
+    {
+      __m128i pix0xmm, pix1xmm;
+      __m128i pix2xmm, pix3xmm;
+      __m128i tmp0xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src +  0);
+      Acc::m128iLoad16u(pix1xmm, src + 16);
+      Acc::m128iLoad16u(pix2xmm, src + 32);
+      Acc::m128iLoad16u(pix3xmm, src + 48);
+
+      Acc::m128iShufflePI8(pix0xmm, pix0xmm, mskxmm);
+      Acc::m128iShufflePI8(pix1xmm, pix1xmm, mskxmm);
+      Acc::m128iShufflePI8(pix2xmm, pix2xmm, mskxmm);
+      Acc::m128iShufflePI8(pix3xmm, pix3xmm, mskxmm);
+
+      // Join the 12-byte groups into three 16-byte vectors.
+      Acc::m128iLShiftSU128<96>(tmp0xmm, pix1xmm);
+      Acc::m128iRShiftSU128<32>(pix1xmm, pix1xmm);
+      Acc::m128iOr(pix0xmm, pix0xmm, tmp0xmm);
+
+      Acc::m128iLShiftSU128<64>(tmp0xmm, pix2xmm);
+      Acc::m128iRShiftSU128<64>(pix2xmm, pix2xmm);
+      Acc::m128iOr(pix1xmm, pix1xmm, tmp0xmm);
+
+      Acc::m128iLShiftSU128<32>(pix3xmm, pix3xmm);
+      Acc::m128iOr(pix2xmm, pix2xmm, pix3xmm);
+
+      Acc::m128iStore16u(dst +  0, pix0xmm);
+      Acc::m128iStore16u(dst + 16, pix1xmm);
+      Acc::m128iStore16u(dst + 32, pix2xmm);
+
+      dst += 48;
+      src += 64;
+    }
+
+    w += 16;
+    if (w) RasterOps_C::Convert::rgb24_888_bs_from_argb32(dst, src, w, closure);
+  }
+};
+
+} // RasterOps_SSSE3 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_SSSE3_BASECONVERT_P_H
@@ -0,0 +1,160 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_SSSE3_COMPOSITESRC_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_SSSE3_COMPOSITESRC_P_H
+
+// [Dependencies - RasterOps_SSE2]
+#include <Fog/G2d/Painting/RasterOps_SSE2/BaseDefs_p.h>
+
+// [Dependencies - Acc]
+#include <Fog/G2d/Acc/AccSsse3.h>
+
+namespace Fog {
+namespace RasterOps_SSSE3 {
+
+// ============================================================================
+// [Fog::RasterOps_SSSE3 - CompositeSrc]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT CompositeSrc
+{
+  enum { COMBINE_FLAGS = RASTER_COMBINE_OP_SRC };
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - RGB24 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb32_vblit_rgb24_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    FOG_XMM_DECLARE_CONST_PI8_VAR(PRGB32_From_RGB24,
+      0x80,   11,   10,    9, 0x80,    8,    7,    6,
+      0x80,    5,    4,    3, 0x80,    2,    1,    0);
+
+    __m128i mskxmm = FOG_XMM_GET_CONST_PI(PRGB32_From_RGB24);
+
+    while ((w -= 16) >= 0)
+    {
+      __m128i pix0xmm, pix1xmm;
+      __m128i pix2xmm, pix3xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src +  0);
+      Acc::m128iLoad16u(pix1xmm, src + 16);
+      Acc::m128iLoad16u(pix3xmm, src + 32);
+
+      Acc::m128iAlignrPI8<8>(pix2xmm, pix3xmm, pix1xmm);
+      Acc::m128iAlignrPI8<12>(pix1xmm, pix1xmm, pix0xmm);
+      Acc::m128iRShiftSU128<32>(pix3xmm, pix3xmm);
+
+      Acc::m128iShufflePI8(pix0xmm, pix0xmm, mskxmm);
+      Acc::m128iShufflePI8(pix1xmm, pix1xmm, mskxmm);
+      Acc::m128iShufflePI8(pix2xmm, pix2xmm, mskxmm);
+      Acc::m128iShufflePI8(pix3xmm, pix3xmm, mskxmm);
+
+      Acc::m128iOr(pix0xmm, pix0xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iOr(pix1xmm, pix1xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iOr(pix2xmm, pix2xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m128iOr(pix3xmm, pix3xmm, FOG_XMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+
+      Acc::m128iStore16u(dst +  0, pix0xmm);
+      Acc::m128iStore16u(dst + 16, pix1xmm);
+      Acc::m128iStore16u(dst + 32, pix2xmm);
+      Acc::m128iStore16u(dst + 48, pix3xmm);
+
+      dst += 64;
+      src += 48;
+    }
+
+    w += 16;
+    while (w)
+    {
+      uint32_t src0p;
+
+      Acc::p32Load3b(src0p, src);
+      Acc::p32FillPBB3(src0p, src0p);
+      Acc::p32Store4a(dst, src0p);
+
+      dst += 4;
+      src += 3;
+      w--;
+    }
+  }
+
+  // ==========================================================================
+  // [RGB24 - VBlit - XRGB32 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL rgb24_vblit_xrgb32_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_ASSUME(w > 0);
+
+    FOG_XMM_DECLARE_CONST_PI8_VAR(RGB24_From_XRGB32,
+      0x80, 0x80, 0x80, 0x80,   14,   13,   12,   10,
+         9,    8,    6,    5,    4,    2,    1,    0);
+
+    __m128i mskxmm = FOG_XMM_GET_CONST_PI(RGB24_From_XRGB32);
+
+    while ((w -= 16) >= 0)
+    {
+      __m128i pix0xmm, pix1xmm;
+      __m128i pix2xmm, pix3xmm;
+      __m128i tmp0xmm;
+
+      Acc::m128iLoad16u(pix0xmm, src +  0);
+      Acc::m128iLoad16u(pix1xmm, src + 16);
+      Acc::m128iLoad16u(pix2xmm, src + 32);
+      Acc::m128iLoad16u(pix3xmm, src + 48);
+
+      Acc::m128iShufflePI8(pix0xmm, pix0xmm, mskxmm);
+      Acc::m128iShufflePI8(pix1xmm, pix1xmm, mskxmm);
+      Acc::m128iShufflePI8(pix2xmm, pix2xmm, mskxmm);
+      Acc::m128iShufflePI8(pix3xmm, pix3xmm, mskxmm);
+
+      // Join the 12-byte groups into three 16-byte vectors.
+      Acc::m128iLShiftSU128<96>(tmp0xmm, pix1xmm);
+      Acc::m128iRShiftSU128<32>(pix1xmm, pix1xmm);
+      Acc::m128iOr(pix0xmm, pix0xmm, tmp0xmm);
+
+      Acc::m128iLShiftSU128<64>(tmp0xmm, pix2xmm);
+      Acc::m128iRShiftSU128<64>(pix2xmm, pix2xmm);
+      Acc::m128iOr(pix1xmm, pix1xmm, tmp0xmm);
+
+      Acc::m128iLShiftSU128<32>(pix3xmm, pix3xmm);
+      Acc::m128iOr(pix2xmm, pix2xmm, pix3xmm);
+
+      Acc::m128iStore16u(dst +  0, pix0xmm);
+      Acc::m128iStore16u(dst + 16, pix1xmm);
+      Acc::m128iStore16u(dst + 32, pix2xmm);
+
+      dst += 48;
+      src += 64;
+    }
+
+    w += 16;
+    while (w)
+    {
+      uint32_t src0p;
+
+      Acc::p32Load4a(src0p, src);
+      Acc::p32Store3b(dst, src0p);
+
+      dst += 3;
+      src += 4;
+      w--;
+    }
+  }
+};
+
+} // RasterOps_SSSE3 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_SSSE3_COMPOSITESRC_P_H
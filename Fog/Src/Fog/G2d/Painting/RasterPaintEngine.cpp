@@ -4889,8 +4889,20 @@ static err_t FOG_CDECL RasterPaintEngine_resetClip(Painter* self)
 // [Fog::RasterPaintEngine - Group]
 // ============================================================================
 
+//! @internal
+//!
+//! @brief Multiply the command @a opacity by the group @a opacity.
+static FOG_INLINE uint32_t RasterPaintEngine_mulOpacity(RasterPaintEngine* engine, uint32_t opacity, uint32_t groupOpacity)
+{
+  return (uint32_t)(((uint64_t)opacity * groupOpacity) / engine->ctx.fullOpacity.u);
+}
+
+//! @internal
+//!
+//! @brief Evaluate and/or destroy the group commands, the opacity of commands
+//! is multiplied by @a groupOpacity.
 template<bool Evaluate, bool Destroy>
-static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEnd)
+static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEnd, uint32_t groupOpacity)
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
   const RasterPaintDoCmd* doCmd = engine->doCmd;
@@ -4920,7 +4932,7 @@ static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEn
         p += sizeof(RasterPaintCmd_SetOpacity);
 
         if (Evaluate)
-          engine->ctx.rasterHints.opacity = cmd->getOpacity();
+          engine->ctx.rasterHints.opacity = RasterPaintEngine_mulOpacity(engine, cmd->getOpacity(), groupOpacity);
         
         if (Destroy)
           cmd->destroy(engine);
@@ -4940,7 +4952,7 @@ static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEn
 
           engine->ctx.pc = (RasterPattern*)(size_t)0x1;
           engine->ctx.solid.prgb32.u32 = cmd->getPrgb32();
-          engine->ctx.rasterHints.opacity = cmd->getOpacity();
+          engine->ctx.rasterHints.opacity = RasterPaintEngine_mulOpacity(engine, cmd->getOpacity(), groupOpacity);
         }
 
         if (Destroy)
@@ -4962,7 +4974,7 @@ static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEn
           engine->ctx.pc = cmd->getPatternContext();
           if (!Destroy)
             engine->ctx.pc->_reference.inc();
-          engine->ctx.rasterHints.opacity = cmd->getOpacity();
+          engine->ctx.rasterHints.opacity = RasterPaintEngine_mulOpacity(engine, cmd->getOpacity(), groupOpacity);
         }
 
         if (!Evaluate && Destroy)
@@ -5197,6 +5209,240 @@ static err_t FOG_CDECL RasterPaintEngine_beginGroup(Painter* self, uint32_t flag
   return ERR_OK;
 }
 
+// ============================================================================
+// [Fog::RasterPaintEngine - Group - Layers]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Get a cached layer which can hold @a w x @a h pixels of @a format.
+//!
+//! The layer is created (or recreated) if there is no usable one. NULL is
+//! returned if all layers are in use or the pool is full, the caller should
+//! create a temporary image in such case.
+static RasterPaintLayer* RasterPaintEngine_acquireLayer(RasterPaintEngine* engine, uint32_t format, int w, int h)
+{
+  RasterPaintLayer* best = NULL;
+  RasterPaintLayer* unused = NULL;
+
+  uint64_t bestArea = 0;
+  uint i;
+
+  for (i = 0; i < RASTER_LAYER_POOL_SIZE; i++)
+  {
+    RasterPaintLayer* layer = &engine->layerPool[i];
+
+    if (layer->isUsable(format, w, h))
+    {
+      // Prefer the smallest layer, larger ones are kept for larger groups.
+      uint64_t area = (uint64_t)(uint)layer->image.getWidth() * (uint)layer->image.getHeight();
+
+      if (best == NULL || area < bestArea)
+      {
+        best = layer;
+        bestArea = area;
+      }
+    }
+    else if (unused == NULL && (layer->image.isEmpty() || layer->image.isDetached()))
+    {
+      unused = layer;
+    }
+  }
+
+  if (best != NULL)
+    return best;
+
+  if (unused == NULL)
+    return NULL;
+
+  // Align the size so the layer can be reused by groups of similar size.
+  int lw = (w + RASTER_LAYER_GRANULARITY - 1) & ~(RASTER_LAYER_GRANULARITY - 1);
+  int lh = (h + RASTER_LAYER_GRANULARITY - 1) & ~(RASTER_LAYER_GRANULARITY - 1);
+
+  size_t oldSize = unused->image.isEmpty() ? size_t(0) : (size_t)unused->image.getStride() * (uint)unused->image.getHeight();
+  size_t newSize = (size_t)Image::getStrideFromWidth(lw, ImageFormatDescription::getByFormat(format).getDepth()) * (uint)lh;
+
+  if (engine->layerPoolSize - oldSize + newSize > RASTER_LAYER_POOL_LIMIT)
+    return NULL;
+
+  engine->layerPoolSize -= oldSize;
+  unused->image.reset();
+
+  if (unused->image.create(SizeI(lw, lh), format) != ERR_OK)
+    return NULL;
+
+  engine->layerPoolSize += newSize;
+
+  // The content of the new image is undefined.
+  unused->dirty.setBox(0, 0, lw, lh);
+  return unused;
+}
+
+//! @internal
+//!
+//! @brief Clear the @a w x @a h pixels of @a image, which can contain
+//! non-transparent pixels only in @a dirty box.
+//!
+//! The @a dirty box is updated to contain the area which will be painted.
+static void RasterPaintEngine_clearLayer(Image& image, BoxI& dirty, int w, int h)
+{
+  BoxI area(0, 0, w, h);
+  BoxI clear;
+
+  if (BoxI::intersect(clear, dirty, area))
+  {
+    ssize_t stride = image.getStride();
+    size_t bpl = (size_t)(uint)clear.getWidth() * image.getBytesPerPixel();
+
+    uint8_t* p = image.getFirstX() + (ssize_t)clear.y0 * stride + (ssize_t)clear.x0 * image.getBytesPerPixel();
+
+    for (int y = clear.y0; y < clear.y1; y++, p += stride)
+      MemOps::zero(p, bpl);
+  }
+
+  BoxI::bound(dirty, dirty, area);
+}
+
+// ============================================================================
+// [Fog::RasterPaintEngine - Group - Paint]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Whether the group @a g can be painted directly to the target.
+//!
+//! The layer is not needed if the group contains only one paint command using
+//! SRC_OVER compositing and the group is composited by SRC_OVER, the group
+//! opacity is folded to the command opacity in such case. The clip-box of the
+//! command is intersected with the clip-box of the group.
+static bool RasterPaintEngine_canPaintGroupDirect(RasterPaintEngine* engine, const RasterPaintGroup* g)
+{
+  const RasterPaintState* savedState = g->savedState;
+
+  return g->numPaints == 1 &&
+         (g->flags & (RASTER_GROUP_HAS_CLIP | RASTER_GROUP_HAS_COMPOSITING)) == 0 &&
+         engine->curGroup == &engine->topGroup &&
+         engine->ctx.clipType == RASTER_CLIP_BOX &&
+         savedState->clipType == RASTER_CLIP_BOX &&
+         savedState->paintHints.compositingOperator == COMPOSITE_SRC_OVER;
+}
+
+//! @internal
+//!
+//! @brief Whether the group @a g can be rendered to a coverage-only (A8) layer.
+//!
+//! This is possible if all paint commands of the group are SRC_OVER fills using
+//! the same solid color (so the color of the layer is known) and the group is
+//! composited by SRC_OVER. The layer is then composited as a mask of the solid
+//! fill, see @c RasterPaintEngine_fillGroupCoverage().
+static bool RasterPaintEngine_canPaintGroupCoverage(RasterPaintEngine* engine, const RasterPaintGroup* g)
+{
+  const RasterPaintState* savedState = g->savedState;
+
+  return (g->flags & (RASTER_GROUP_RGB | RASTER_GROUP_HAS_CLIP | RASTER_GROUP_HAS_COMPOSITING)) == 0 &&
+         (g->flags & RASTER_GROUP_HAS_FILL) != 0 &&
+         engine->curGroup == &engine->topGroup &&
+         engine->ctx.precision == IMAGE_PRECISION_BYTE &&
+         engine->ctx.clipType == RASTER_CLIP_BOX &&
+         savedState->clipType == RASTER_CLIP_BOX &&
+         savedState->paintHints.compositingOperator == COMPOSITE_SRC_OVER;
+}
+
+//! @internal
+//!
+//! @brief Fill the @a argb32 color masked by the coverage-only @a layer, which
+//! is positioned at @a bBox, using the current opacity and clip-box.
+static void RasterPaintEngine_fillGroupCoverage(RasterPaintEngine* engine, const BoxI& bBox, const Image& layer, uint32_t argb32)
+{
+  BoxI box;
+  if (!BoxI::intersect(box, bBox, engine->ctx.clipBoxI))
+    return;
+
+  uint32_t opacity = engine->ctx.rasterHints.opacity;
+  if (opacity == 0)
+    return;
+
+  // The coverage already contains the alpha of the color, so the color is
+  // used as opaque.
+  RasterSolid solid;
+  solid.prgb32.u32 = argb32 | 0xFF000000;
+
+  if (opacity != 0x100)
+    Acc::p32MulDiv256PBB_SBW(solid.prgb32.u32, solid.prgb32.u32, opacity);
+
+  bool isSrcOpaque = Acc::p32PRGB32IsAlphaFF(solid.prgb32.u32);
+  RasterCBlitSpanFunc blitSpan = _api_raster.getCBlitSpan(engine->ctx.target.format, COMPOSITE_SRC_OVER, isSrcOpaque);
+
+  ssize_t dstStride = engine->ctx.target.stride;
+  ssize_t mskStride = layer.getStride();
+
+  uint8_t* dstPixels = engine->ctx.target.pixels + (ssize_t)box.y0 * dstStride;
+  const uint8_t* mskPixels = layer.getFirst() + (ssize_t)(box.y0 - bBox.y0) * mskStride + (box.x0 - bBox.x0);
+
+  RasterSpan8 span[1];
+  span[0].setNext(NULL);
+
+  int w = box.x1 - box.x0;
+
+  for (int i = box.y1 - box.y0; i; i--)
+  {
+    // Split the scanline to runs, transparent runs are skipped and fully
+    // covered runs are filled using const-mask spans.
+    int x = 0;
+
+    while (x < w)
+    {
+      uint32_t m0;
+
+      while (x + 4 <= w)
+      {
+        Acc::p32Load4u(m0, mskPixels + x);
+        if (m0 != 0x00000000)
+          break;
+        x += 4;
+      }
+
+      while (x < w && mskPixels[x] == 0x00)
+        x++;
+
+      if (x == w)
+        break;
+
+      int xStart = x;
+
+      if (mskPixels[x] == 0xFF)
+      {
+        while (x + 4 <= w)
+        {
+          Acc::p32Load4u(m0, mskPixels + x);
+          if (m0 != 0xFFFFFFFF)
+            break;
+          x += 4;
+        }
+
+        while (x < w && mskPixels[x] == 0xFF)
+          x++;
+
+        span[0].setPositionAndType(box.x0 + xStart, box.x0 + x, RASTER_SPAN_C);
+        span[0].setConstMask(0x100);
+      }
+      else
+      {
+        while (++x < w && mskPixels[x] != 0x00 && mskPixels[x] != 0xFF)
+          continue;
+
+        span[0].setPositionAndType(box.x0 + xStart, box.x0 + x, RASTER_SPAN_A8_GLYPH);
+        span[0].setA8Glyph(const_cast<uint8_t*>(mskPixels + xStart));
+      }
+
+      blitSpan(dstPixels, &solid, span, &engine->ctx.closure);
+    }
+
+    dstPixels += dstStride;
+    mskPixels += mskStride;
+  }
+}
+
 static err_t FOG_CDECL RasterPaintEngine_paintGroup(Painter* self)
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
@@ -5214,22 +5460,65 @@ static err_t FOG_CDECL RasterPaintEngine_paintGroup(Painter* self)
   Static<Image> image;
   BoxI targetBBox = g->boundingBox;
 
+  uint32_t layerFormat = IMAGE_FORMAT_PRGB32;
+  uint32_t layerArgb32 = 0;
+
   image->_d = NULL;
   engine->curGroup = g->top;
 
-  if (targetBBox.isValid())
+  if (targetBBox.isValid() && RasterPaintEngine_canPaintGroupDirect(engine, g))
+  {
+    uint32_t groupOpacity = g->savedState->rasterHints.opacity;
+    BoxI::intersect(engine->ctx.clipBoxI, engine->ctx.clipBoxI, g->savedState->clipBoxI);
+
+    RasterPaintEngine_resetGroupStates(engine);
+    engine->ctx.rasterHints.opacity = groupOpacity;
+    engine->ctx.pc = NULL;
+
+    // The group is not nested (checked by canPaintGroupDirect()), so render
+    // directly.
+    engine->doCmd = &RasterPaintDoRender_vtable[RASTER_MODE_ST];
+
+    if (groupOpacity != 0 && engine->ctx.clipBoxI.isValid())
+      RasterPaintEngine_doCommands<true, true>(self, g->cmdStart, engine->cmdAllocator._pos, groupOpacity);
+    else
+      RasterPaintEngine_doCommands<false, true>(self, g->cmdStart, engine->cmdAllocator._pos, groupOpacity);
+  }
+  else if (targetBBox.isValid())
   {
     RasterPaintTarget savedTarget = engine->ctx.target;
     SizeI targetSize(targetBBox.getWidth(), targetBBox.getHeight());
 
-    image.init();
-    if (image->create(targetSize, IMAGE_FORMAT_PRGB32) != ERR_OK)
-      goto _DiscardCommands;
+    if (RasterPaintEngine_canPaintGroupCoverage(engine, g))
+    {
+      layerFormat = IMAGE_FORMAT_A8;
+      layerArgb32 = g->argb32;
+    }
+
+    RasterPaintLayer* layer = RasterPaintEngine_acquireLayer(engine, layerFormat, targetSize.w, targetSize.h);
+
+    if (layer != NULL)
+    {
+      // Clear and reference the layer so it's not reused until the group is
+      // blitted. The layer must be cleared first, otherwise it's detached.
+      RasterPaintEngine_clearLayer(layer->image, layer->dirty, targetSize.w, targetSize.h);
+      image.initCustom1(layer->image);
+    }
+    else
+    {
+      BoxI dirty(0, 0, targetSize.w, targetSize.h);
+
+      image.init();
+      if (image->create(targetSize, layerFormat) != ERR_OK)
+        goto _DiscardCommands;
+
+      RasterPaintEngine_clearLayer(image, dirty, targetSize.w, targetSize.h);
+    }
 
     // We don't change target size.
     engine->ctx.target.stride = image->getStride();
-    engine->ctx.target.pixels = image->getFirstX();
-    engine->ctx.target.format = IMAGE_FORMAT_PRGB32;
+    engine->ctx.target.pixels = const_cast<uint8_t*>(image->getFirst());
+    engine->ctx.target.format = layerFormat;
     engine->ctx.target.setup();
 
     // Offset target buffer.
@@ -5237,19 +5526,6 @@ static err_t FOG_CDECL RasterPaintEngine_paintGroup(Painter* self)
     engine->ctx.target.pixels -= targetBBox.y0 * engine->ctx.target.stride;
 
     engine->doCmd = &RasterPaintDoRender_vtable[RASTER_MODE_ST];
-
-    // Clear the temporary image.
-    uint32_t oldPaintHints = engine->ctx.paintHints.packed;
-    uint32_t oldPrgb32 = engine->ctx.solid.prgb32.u32;
-
-    engine->ctx.paintHints.compositingOperator = COMPOSITE_SRC;
-    engine->ctx.solid.prgb32.u32 = 0x00000000;
-    engine->ctx.pc = (RasterPattern*)(size_t)0x1;
-
-    engine->doCmd->fillNormalizedBoxI(engine, &targetBBox);
-
-    engine->ctx.paintHints.packed = oldPaintHints;
-    engine->ctx.solid.prgb32.u32 = oldPrgb32;
     engine->ctx.pc = NULL;
 
     // Reset core states which are always set to default values when new group
@@ -5257,7 +5533,8 @@ static err_t FOG_CDECL RasterPaintEngine_paintGroup(Painter* self)
     RasterPaintEngine_resetGroupStates(engine);
 
     // Run commands.
-    RasterPaintEngine_doCommands<true, true>(self, g->cmdStart, engine->cmdAllocator._pos);
+    RasterPaintEngine_doCommands<true, true>(self, g->cmdStart, engine->cmdAllocator._pos, engine->ctx.fullOpacity.u);
+    image->_modified();
 
     // Switch 'doCmd' interface to the previous group or keep direct rendering
     // in case that there is no previous group.
@@ -5270,7 +5547,7 @@ static err_t FOG_CDECL RasterPaintEngine_paintGroup(Painter* self)
   else
   {
 _DiscardCommands:
-    RasterPaintEngine_doCommands<false, true>(self, g->cmdStart, engine->cmdAllocator._pos);
+    RasterPaintEngine_doCommands<false, true>(self, g->cmdStart, engine->cmdAllocator._pos, engine->ctx.fullOpacity.u);
 
     // Switch 'doCmd' interface to the previous group or to the direct rendering.
     if (engine->curGroup != &engine->topGroup)
@@ -5290,12 +5567,27 @@ _DiscardCommands:
   engine->cmdAllocator.revert(g->cmdRecord);
   engine->groupAllocator.revert(g->groupRecord);
 
-  // Destroy image buffer, if created.
+  // Blit the layer (or record the blit if the group is nested) and release
+  // the reference, the layer can be reused when the blit is done.
   if (image->_d != NULL)
   {
-    PointI dPos(targetBBox.x0, targetBBox.y0);
-    RectI sRect(0, 0, image->getWidth(), image->getHeight());
-    engine->doCmd->blitNormalizedImageA(engine, &dPos, &image, &sRect);
+    if (engine->curGroup != &engine->topGroup)
+    {
+      engine->curGroup->flags |= RASTER_GROUP_HAS_GROUP;
+      engine->curGroup->numGroups++;
+    }
+
+    if (layerFormat == IMAGE_FORMAT_A8)
+    {
+      RasterPaintEngine_fillGroupCoverage(engine, targetBBox, image, layerArgb32);
+    }
+    else
+    {
+      PointI dPos(targetBBox.x0, targetBBox.y0);
+      RectI sRect(0, 0, targetBBox.getWidth(), targetBBox.getHeight());
+      engine->doCmd->blitNormalizedImageA(engine, &dPos, &image, &sRect);
+    }
+
     image.destroy();
   }
 
@@ -5339,6 +5631,7 @@ RasterPaintEngine::RasterPaintEngine() :
   pcPool(NULL),
   groupAllocator(500),
   curGroup(&topGroup),
+  layerPoolSize(0),
   cmdAllocator(16300),
   maxThreads(0),
   finalizing(0)
@@ -5366,6 +5659,9 @@ RasterPaintEngine::RasterPaintEngine() :
 
   topGroup.reset();
 
+  for (uint i = 0; i < RASTER_LAYER_POOL_SIZE; i++)
+    layerPool[i].dirty.reset();
+
   maxThreads = detectMaxThreads();
 }
 
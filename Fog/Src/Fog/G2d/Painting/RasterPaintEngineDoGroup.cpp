@@ -43,6 +43,43 @@ namespace Fog {
 
 FOG_NO_EXPORT RasterPaintDoCmd RasterPaintDoGroup_vtable[RASTER_MODE_COUNT];
 
+// ============================================================================
+// [Fog::RasterPaintDoGroup - Helpers]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Record that a paint command (@a flag is fill or blit) has been
+//! added to the current group.
+//!
+//! The group doesn't need RGB channels (@ref RASTER_GROUP_RGB flag is not set)
+//! while all its paint commands are fills using the same solid color.
+static FOG_INLINE void RasterPaintDoGroup_addPaint(RasterPaintEngine* engine, uint32_t flag)
+{
+  RasterPaintGroup* g = engine->curGroup;
+
+  if (engine->ctx.paintHints.compositingOperator != COMPOSITE_SRC_OVER)
+    flag |= RASTER_GROUP_HAS_COMPOSITING;
+
+  if ((flag & RASTER_GROUP_HAS_FILL) != 0 &&
+      (engine->sourceType == RASTER_SOURCE_ARGB32 || engine->sourceType == RASTER_SOURCE_COLOR))
+  {
+    uint32_t argb32 = engine->source.color->_argb32.u32;
+
+    if (g->numPaints == 0)
+      g->argb32 = argb32;
+    else if (g->argb32 != argb32)
+      flag |= RASTER_GROUP_RGB;
+  }
+  else
+  {
+    flag |= RASTER_GROUP_RGB;
+  }
+
+  g->flags |= flag;
+  g->numPaints++;
+}
+
 // ============================================================================
 // [Fog::RasterPaintDoGroup - Pending]
 // ============================================================================
@@ -94,6 +131,7 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_processPendingFlags(RasterPaintEngi
   if (pending & RASTER_PENDING_CLIP)
   {
     uint32_t clipType = engine->ctx.clipType;
+    engine->curGroup->flags |= RASTER_GROUP_HAS_CLIP;
     
     if (clipType == RASTER_CLIP_BOX)
     {
@@ -184,6 +222,7 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_fillAll(
     return ERR_RT_OUT_OF_MEMORY;
   cmd->init(engine, RASTER_PAINT_CMD_FILL_ALL);
 
+  RasterPaintDoGroup_addPaint(engine, RASTER_GROUP_HAS_FILL);
   engine->curGroup->mergeBoundingBox(engine->ctx.clipBoxI);
   return ERR_OK;
 }
@@ -203,6 +242,7 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedBoxI(
     return ERR_RT_OUT_OF_MEMORY;
   cmd->init(engine, RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_I, *box);
 
+  RasterPaintDoGroup_addPaint(engine, RASTER_GROUP_HAS_FILL);
   engine->curGroup->mergeBoundingBox(*box);
   return ERR_OK;
 }
@@ -217,6 +257,7 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedBoxF(
     return ERR_RT_OUT_OF_MEMORY;
   cmd->init(engine, RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_F, *box);
 
+  RasterPaintDoGroup_addPaint(engine, RASTER_GROUP_HAS_FILL);
   engine->curGroup->mergeBoundingBox(
     Math::ifloor(box->x0),
     Math::ifloor(box->y0),
@@ -235,6 +276,7 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedBoxD(
     return ERR_RT_OUT_OF_MEMORY;
   cmd->init(engine, RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_D, *box);
 
+  RasterPaintDoGroup_addPaint(engine, RASTER_GROUP_HAS_FILL);
   engine->curGroup->mergeBoundingBox(
     Math::ifloor(box->x0),
     Math::ifloor(box->y0),
@@ -261,6 +303,7 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedPathF(
   cmd->init(engine, RASTER_PAINT_CMD_FILL_NORMALIZED_PATH_F,
     *path, *pt, engine->ctx.paintHints.fillRule);
 
+  RasterPaintDoGroup_addPaint(engine, RASTER_GROUP_HAS_FILL);
   engine->curGroup->mergeBoundingBox(
     Math::ifloor(boundingBox.x0),
     Math::ifloor(boundingBox.y0),
@@ -283,6 +326,7 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedPathD(
   cmd->init(engine, RASTER_PAINT_CMD_FILL_NORMALIZED_PATH_D,
     *path, *pt, engine->ctx.paintHints.fillRule);
 
+  RasterPaintDoGroup_addPaint(engine, RASTER_GROUP_HAS_FILL);
   engine->curGroup->mergeBoundingBox(
     Math::ifloor(boundingBox.x0),
     Math::ifloor(boundingBox.y0),
@@ -341,6 +385,7 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_blitNormalizedImageA(
       *pt, *srcImage, *srcFragment);
   }
 
+  RasterPaintDoGroup_addPaint(engine, RASTER_GROUP_HAS_BLIT);
   engine->curGroup->mergeBoundingBox(
     pt->x,
     pt->y,
@@ -367,6 +412,7 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_blitNormalizedImageI(
   cmd->init(engine, RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_I,
     *box, *srcImage, *srcFragment, *srcTransform, imageQuality);
 
+  RasterPaintDoGroup_addPaint(engine, RASTER_GROUP_HAS_BLIT);
   engine->curGroup->mergeBoundingBox(*box);
   return ERR_OK;
 }
@@ -385,6 +431,7 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_blitNormalizedImageD(
   cmd->init(engine, RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_D,
     *box, *srcImage, *srcFragment, *srcTransform, imageQuality);
 
+  RasterPaintDoGroup_addPaint(engine, RASTER_GROUP_HAS_BLIT);
   engine->curGroup->mergeBoundingBox(
     Math::ifloor(box->x0),
     Math::ifloor(box->y0),
@@ -433,6 +433,11 @@ _DiscardContinue:
   //! @brief Current group.
   RasterPaintGroup* curGroup;
 
+  //! @brief Cached layer buffers.
+  RasterPaintLayer layerPool[RASTER_LAYER_POOL_SIZE];
+  //! @brief Size (in bytes) of all cached layer buffers.
+  size_t layerPoolSize;
+
   // --------------------------------------------------------------------------
   // [Members - Commands]
   // --------------------------------------------------------------------------
@@ -209,6 +209,8 @@ struct FOG_NO_EXPORT RasterPaintGroup
     flags = NO_FLAGS;
 
     numGroups = 0;
+    numPaints = 0;
+    argb32 = 0;
     opacityF = 1.0f;
     boundingBox.setBox(INT_MIN, INT_MIN, INT_MIN, INT_MIN);
 
@@ -260,6 +262,11 @@ struct FOG_NO_EXPORT RasterPaintGroup
   uint32_t flags;
   //! @brief How many groups are inside of this group.
   uint32_t numGroups;
+  //! @brief How many fill and blit commands are inside of this group.
+  uint32_t numPaints;
+  //! @brief Color of all fills inside of this group (only valid if the
+  //! @ref RASTER_GROUP_RGB flag is not set).
+  uint32_t argb32;
 
 #if FOG_ARCH_BITS >= 64
   //! @brief The group bounding box (it can only grow).
@@ -283,6 +290,44 @@ struct FOG_NO_EXPORT RasterPaintGroup
   uint8_t* cmdStart;
 };
 
+// ============================================================================
+// [Fog::RasterPaintLayer]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Layer buffer cached by the paint engine, used to render groups.
+//!
+//! The layer is in use while its image is referenced by something else than
+//! the paint engine (the group being rendered or a blit command recorded by
+//! the parent group).
+struct FOG_NO_EXPORT RasterPaintLayer
+{
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE bool isUsable(uint32_t format, int w, int h) const
+  {
+    return !image.isEmpty() &&
+            image.isDetached() &&
+            image.getFormat() == format &&
+            image.getWidth() >= w &&
+            image.getHeight() >= h;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Layer image, it can be larger than the group bounding box.
+  Image image;
+  //! @brief Box which can contain non-transparent pixels (in image
+  //! coordinates), only this area needs to be cleared before the layer is
+  //! reused.
+  BoxI dirty;
+};
+
 // ============================================================================
 // [Fog::RasterPaintState]
 // ============================================================================
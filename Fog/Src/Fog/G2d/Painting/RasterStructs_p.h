@@ -394,6 +394,10 @@ struct FOG_NO_EXPORT RasterPattern
     //! @brief Whether the fixed-point is safe for context bounding box.
     int safeFixedPoint;
 
+    //! @brief Integer scale used by the upscale-nearest and downscale-box
+    //! fetchers (see @c RasterOps_C::PTextureOrtho).
+    int scale;
+
     // Used for affine transformation, in 16.16 fp.
     //int fxmax;
     //int fymax;
@@ -753,6 +757,53 @@ struct FOG_NO_EXPORT RasterFilterImage
   uint8_t* data;
 };
 
+// ============================================================================
+// [Fog::RasterTurbulenceLattice]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Lattice of the turbulence (Perlin noise) generated from the seed.
+//!
+//! The gradients of all four color channels are interleaved, each lattice
+//! point contains the X gradients of the B, G, R and A channels followed by
+//! the Y gradients, so one lattice point is loaded to two SIMD registers.
+struct FOG_NO_EXPORT RasterTurbulenceLattice
+{
+  //! @brief Gradients, indexed by [lattice][X/Y][B/G/R/A].
+  float gradient[RASTER_TURBULENCE_TABLE_SIZE][2][4];
+  //! @brief Lattice selector (permutation).
+  int selector[RASTER_TURBULENCE_TABLE_SIZE];
+};
+
+// ============================================================================
+// [Fog::RasterTurbulenceTile]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Turbulence tile, contains the base frequency adjusted to the tile
+//! and the stitching information (used only if @c stitchTiles is set).
+struct FOG_NO_EXPORT RasterTurbulenceTile
+{
+  //! @brief Horizontal base frequency.
+  float hBaseFrequency;
+  //! @brief Vertical base frequency.
+  float vBaseFrequency;
+
+  //! @brief Whether to stitch the tiles.
+  uint32_t stitchTiles;
+
+  //! @brief Width of the tile in lattice units.
+  int width;
+  //! @brief Height of the tile in lattice units.
+  int height;
+  //! @brief Horizontal lattice position where to wrap.
+  int wrapX;
+  //! @brief Vertical lattice position where to wrap.
+  int wrapY;
+};
+
 // ============================================================================
 // [Fog::RasterFilterBlur]
 // ============================================================================
@@ -837,8 +888,13 @@ struct FOG_NO_EXPORT RasterFilter
   // [Members - ColorLut]
   // --------------------------------------------------------------------------
 
+  //! @brief Color LUT, also used by the component transfer, which is
+  //! converted to the lookup tables when the filter is created.
   struct FOG_NO_EXPORT _ColorLut
   {
+    //! @brief Lookup tables of non-premultiplied components, indexed by
+    //! @c COLOR_INDEX.
+    uint8_t table[COLOR_INDEX_COUNT][256];
   };
 
   // --------------------------------------------------------------------------
@@ -847,14 +903,13 @@ struct FOG_NO_EXPORT RasterFilter
 
   struct FOG_NO_EXPORT _ColorMatrix
   {
-  };
-
-  // --------------------------------------------------------------------------
-  // [Members - ComponentTransfer]
-  // --------------------------------------------------------------------------
+    //! @brief Matrix rows (R, G, B, A and the translation, which is already
+    //! multiplied by 255), each row contains the R, G, B and A columns.
+    float m[5][4];
 
-  struct FOG_NO_EXPORT _ComponentTransfer
-  {
+    //! @brief Alpha lookup table, used by the alpha-only matrices and by the
+    //! A8 format.
+    uint8_t alphaLut[256];
   };
 
   // --------------------------------------------------------------------------
@@ -881,6 +936,31 @@ struct FOG_NO_EXPORT RasterFilter
 
   struct FOG_NO_EXPORT _ConvolveMatrix
   {
+    //! @brief Border extend type, see @c FE_EXTEND.
+    uint32_t extendType;
+    //! @brief Border extend color (premultiplied).
+    RasterSolid extendColor;
+
+    //! @brief Kernel width.
+    int kernelWidth;
+    //! @brief Kernel height.
+    int kernelHeight;
+    //! @brief Kernel target (count of pixels at the left of the output pixel).
+    int targetX;
+    //! @brief Kernel target (count of pixels above the output pixel).
+    int targetY;
+
+    //! @brief Count of weights per kernel row (kernel width rounded up to
+    //! even number, the padding weight is zero).
+    int weightStride;
+    //! @brief Fixed-point precision of the weights.
+    int shift;
+    //! @brief Fixed-point bias (including rounding).
+    int bias;
+
+    //! @brief Fixed-point weights (flipped kernel, @c kernelHeight rows of
+    //! @c weightStride weights), allocated by create().
+    int16_t* weights;
   };
 
   // --------------------------------------------------------------------------
@@ -889,6 +969,38 @@ struct FOG_NO_EXPORT RasterFilter
 
   struct FOG_NO_EXPORT _ConvolveSeparable
   {
+    //! @brief Border extend type, see @c FE_EXTEND.
+    uint32_t extendType;
+    //! @brief Border extend color (premultiplied).
+    RasterSolid extendColor;
+
+    //! @brief Horizontal kernel size.
+    int hSize;
+    //! @brief Vertical kernel size.
+    int vSize;
+    //! @brief Horizontal kernel target.
+    int hTarget;
+    //! @brief Vertical kernel target.
+    int vTarget;
+
+    //! @brief Count of horizontal weights (@c hSize rounded up to even).
+    int hCount;
+    //! @brief Count of vertical weights (@c vSize rounded up to even).
+    int vCount;
+
+    //! @brief Shift of the horizontal pass (weights to intermediate
+    //! precision).
+    int hShift;
+    //! @brief Shift of the vertical pass (intermediate and weights to 8-bit).
+    int vShift;
+    //! @brief Fixed-point bias of both passes (including rounding).
+    int bias;
+
+    //! @brief Fixed-point horizontal weights, allocated by create() together
+    //! with @c vWeights.
+    int16_t* hWeights;
+    //! @brief Fixed-point vertical weights.
+    int16_t* vWeights;
   };
 
   // --------------------------------------------------------------------------
@@ -897,6 +1009,49 @@ struct FOG_NO_EXPORT RasterFilter
 
   struct FOG_NO_EXPORT _Morphology
   {
+    //! @brief Morphology type, see @c FE_MORPHOLOGY_TYPE.
+    uint32_t morphologyType;
+
+    //! @brief Border extend type, see @c FE_EXTEND.
+    uint32_t extendType;
+    //! @brief Border extend color (premultiplied).
+    RasterSolid extendColor;
+
+    //! @brief Horizontal radius (window is hRadius * 2 + 1 pixels).
+    int hRadius;
+    //! @brief Vertical radius (window is vRadius * 2 + 1 pixels).
+    int vRadius;
+
+    //! @brief Horizontal pass.
+    RasterFilterMorphologyHFunc hFunc;
+    //! @brief Vertical pass (min/max of two rows).
+    RasterFilterMorphologyVFunc vFunc;
+  };
+
+  // --------------------------------------------------------------------------
+  // [Members - Turbulence]
+  // --------------------------------------------------------------------------
+
+  struct FOG_NO_EXPORT _Turbulence
+  {
+    //! @brief Turbulence type, see @c FE_TURBULENCE_TYPE.
+    uint32_t turbulenceType;
+    //! @brief Number of octaves.
+    uint32_t numOctaves;
+    //! @brief Whether to stitch the tiles.
+    uint32_t stitchTiles;
+    //! @brief Seed of the pseudo random number generator.
+    int32_t seed;
+
+    //! @brief Horizontal base frequency.
+    float hBaseFrequency;
+    //! @brief Vertical base frequency.
+    float vBaseFrequency;
+
+    //! @brief Generator.
+    RasterFilterTurbulenceFunc func;
+    //! @brief Lattice, allocated by create().
+    RasterTurbulenceLattice* lattice;
   };
 
   // --------------------------------------------------------------------------
@@ -932,13 +1087,13 @@ struct FOG_NO_EXPORT RasterFilter
   {
     _ColorLut colorLut;
     _ColorMatrix colorMatrix;
-    _ComponentTransfer componentTransfer;
 
     _Blur blur;
     _ConvolveMatrix convolveMatrix;
     _ConvolveSeparable convolveSeparable;
 
     _Morphology morphology;
+    _Turbulence turbulence;
   };
 };
 
@@ -243,7 +243,7 @@ static void FOG_CDECL ColorStopList_clear(ColorStopList* self)
 
     ColorStopCache* cache = atomicPtrXchg(&d->stopCachePrgb32, (ColorStopCache*)NULL);
     if (cache)
-      ColorStopCache::destroy(cache);
+      cache->release();
   }
 }
 
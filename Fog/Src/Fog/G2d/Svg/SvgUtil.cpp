@@ -922,15 +922,61 @@ err_t serializeColor(StringW& dst, const Argb32& argb32)
   return dst.appendInt(argb32.getPacked32() & 0x00FFFFFF, FormatInt(16, NO_FLAGS, 6));
 }
 
+// ============================================================================
+// [Fog::SvgUtil - Serialize - Helpers]
+// ============================================================================
+
+// SVG coordinates are floats, the shortest form which parses back to the same
+// float is both exact and compact ("%g" loses digits above 6 significant ones).
+static const FormatReal SvgUtil_realFormat(DF_SHORTEST_FLOAT);
+
+static FOG_INLINE err_t SvgUtil_appendReal(StringW& dst, float val)
+{
+  return dst.appendReal(double(val), SvgUtil_realFormat);
+}
+
+static err_t SvgUtil_appendRealList(StringW& dst, const float* values, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    if (i != 0)
+      FOG_RETURN_ON_ERROR(dst.append(CharW(' ')));
+    FOG_RETURN_ON_ERROR(SvgUtil_appendReal(dst, values[i]));
+  }
+
+  return ERR_OK;
+}
+
+static err_t SvgUtil_appendPoints(StringW& dst, const PointF* pts, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    if (i != 0)
+      FOG_RETURN_ON_ERROR(dst.append(CharW(' ')));
+
+    FOG_RETURN_ON_ERROR(SvgUtil_appendReal(dst, pts[i].x));
+    FOG_RETURN_ON_ERROR(dst.append(CharW(',')));
+    FOG_RETURN_ON_ERROR(SvgUtil_appendReal(dst, pts[i].y));
+  }
+
+  return ERR_OK;
+}
+
+static err_t SvgUtil_appendFunction(StringW& dst, const char* name, const float* values, size_t count)
+{
+  FOG_RETURN_ON_ERROR(dst.append(Ascii8(name)));
+  FOG_RETURN_ON_ERROR(dst.append(CharW('(')));
+  FOG_RETURN_ON_ERROR(SvgUtil_appendRealList(dst, values, count));
+  return dst.append(CharW(')'));
+}
+
 // ============================================================================
 // [Fog::SvgUtil - Serialize - Offset]
 // ============================================================================
 
 err_t serializeOffset(StringW& dst, float src)
 {
-  FOG_RETURN_ON_ERROR(dst.appendFormat("%g", src));
-  
-  return ERR_OK;
+  return SvgUtil_appendReal(dst, src);
 }
 
 // ============================================================================
@@ -951,7 +997,7 @@ err_t serializeCoord(StringW& dst, const CoordF& src)
   float val = src.value;
 
   if (src.unit == UNIT_PERCENTAGE) val *= 100.0f;
-  FOG_RETURN_ON_ERROR(dst.appendReal(src.value));
+  FOG_RETURN_ON_ERROR(SvgUtil_appendReal(dst, val));
 
   if (src.unit < UNIT_COUNT && svgUnitNames[src.unit * 2] != '\0')
     FOG_RETURN_ON_ERROR(dst.append(Ascii8(&svgUnitNames[src.unit * 2], 2)));
@@ -969,7 +1015,9 @@ err_t serializeViewBox(StringW& dst, const BoxF& src)
 {
   if (src.isValid())
   {
-    FOG_RETURN_ON_ERROR(dst.appendFormat("%g %g %g %g", src.x0, src.y0, src.x1, src.y1));
+    // The viewBox attribute is "x y width height", see parseViewBox().
+    float values[4] = { src.x0, src.y0, src.getWidth(), src.getHeight() };
+    FOG_RETURN_ON_ERROR(SvgUtil_appendRealList(dst, values, 4));
   }
 
   return ERR_OK;
@@ -982,23 +1030,23 @@ err_t serializeViewBox(StringW& dst, const BoxF& src)
 err_t serializePoints(StringW& dst, const PathF& src)
 {
   size_t pathLength = src.getLength();
-  size_t i = 0;
+  size_t i;
   
   const uint8_t* cmd = src.getCommands();
   const PointF* pts = src.getVertices();
 
   bool isFirst = true;
 
-  while (i < pathLength)
+  for (i = 0; i < pathLength; i++)
   {
-    if (cmd[0] != PATH_CMD_CLOSE)
+    if (cmd[i] != PATH_CMD_CLOSE)
     {
       if (!isFirst)
         FOG_RETURN_ON_ERROR(dst.append(CharW(' ')));
       else
         isFirst = false;
 
-      FOG_RETURN_ON_ERROR(dst.appendFormat("%g,%g", pts[0].x, pts[0].y));
+      FOG_RETURN_ON_ERROR(SvgUtil_appendPoints(dst, &pts[i], 1));
     }
   }
   
@@ -1029,8 +1077,8 @@ err_t serializePath(StringW& dst, const PathF& src)
     switch (cmd[0])
     {
       case PATH_CMD_MOVE_TO:
-        FOG_RETURN_ON_ERROR(dst.appendFormat("M%g,%g", 
-          pts[0].x, pts[0].y));
+        FOG_RETURN_ON_ERROR(dst.append(CharW('M')));
+        FOG_RETURN_ON_ERROR(SvgUtil_appendPoints(dst, pts, 1));
 
         i++;
         cmd++;
@@ -1038,8 +1086,8 @@ err_t serializePath(StringW& dst, const PathF& src)
         break;
       
       case PATH_CMD_LINE_TO:
-        FOG_RETURN_ON_ERROR(dst.appendFormat("L%g,%g",
-          pts[0].x, pts[0].y));
+        FOG_RETURN_ON_ERROR(dst.append(CharW('L')));
+        FOG_RETURN_ON_ERROR(SvgUtil_appendPoints(dst, pts, 1));
 
         i++;
         cmd++;
@@ -1050,9 +1098,8 @@ err_t serializePath(StringW& dst, const PathF& src)
         if (i + 2 > pathLength)
           return ERR_RT_INVALID_STATE;
 
-        FOG_RETURN_ON_ERROR(dst.appendFormat("Q%g,%g %g,%g",
-          pts[0].x, pts[0].y,
-          pts[1].x, pts[1].y));
+        FOG_RETURN_ON_ERROR(dst.append(CharW('Q')));
+        FOG_RETURN_ON_ERROR(SvgUtil_appendPoints(dst, pts, 2));
 
         i += 2;
         cmd += 2;
@@ -1063,10 +1110,8 @@ err_t serializePath(StringW& dst, const PathF& src)
         if (i + 3 > pathLength)
           return ERR_RT_INVALID_STATE;
 
-        FOG_RETURN_ON_ERROR(dst.appendFormat("C%g,%g %g,%g %g,%g",
-          pts[0].x, pts[0].y,
-          pts[1].x, pts[1].y,
-          pts[2].x, pts[2].y));
+        FOG_RETURN_ON_ERROR(dst.append(CharW('C')));
+        FOG_RETURN_ON_ERROR(SvgUtil_appendPoints(dst, pts, 3));
 
         i += 3;
         cmd += 3;
@@ -1094,32 +1139,35 @@ err_t serializePath(StringW& dst, const PathF& src)
 
 err_t serializeTransform(StringW& dst, const TransformF& src)
 {
+  float values[6];
+
   switch (src.getType())
   {
     case TRANSFORM_TYPE_IDENTITY:
       return ERR_OK;
 
     case TRANSFORM_TYPE_TRANSLATION:
-      if (Math::isFuzzyZero(src._21))
-        return dst.appendFormat("translate(%g)", src._20);
-      else
-        return dst.appendFormat("translate(%g %g)", src._20, src._21);
+      values[0] = src._20;
+      values[1] = src._21;
+      return SvgUtil_appendFunction(dst, "translate", values, Math::isFuzzyZero(src._21) ? 1 : 2);
 
     case TRANSFORM_TYPE_SCALING:
       if (Math::isFuzzyZero(src._20) && Math::isFuzzyZero(src._21))
       {
-        if (Math::isFuzzyEq(src._00, src._11))
-          return dst.appendFormat("scale(%g)", src._00);
-        else
-          return dst.appendFormat("scale(%g %g)", src._00, src._11);
+        values[0] = src._00;
+        values[1] = src._11;
+        return SvgUtil_appendFunction(dst, "scale", values, Math::isFuzzyEq(src._00, src._11) ? 1 : 2);
       }
       // ... Fall through ...
 
     default:
-      return dst.appendFormat("matrix(%g %g %g %g %g %g)",
-        src._00, src._01,
-        src._10, src._11,
-        src._20, src._21);
+      values[0] = src._00;
+      values[1] = src._01;
+      values[2] = src._10;
+      values[3] = src._11;
+      values[4] = src._20;
+      values[5] = src._21;
+      return SvgUtil_appendFunction(dst, "matrix", values, 6);
   }
 }
 
@@ -643,10 +643,10 @@ static void FOG_CDECL FaceCache_dtor(FaceCache* self)
 
 static void FOG_CDECL FaceCache_reset(FaceCache* self)
 {
-  Hash< StringW, List<Face*> > copy;
-  swap(copy, self->data());
+  FlatHash< StringW, List<Face*> > copy;
+  copy.swap(self->data());
 
-  HashIterator< StringW, List<Face*> > cacheIterator(copy);
+  FlatHashIterator< StringW, List<Face*> > cacheIterator(copy);
   while (cacheIterator.isValid())
   {
     const List<Face*>& faceList = cacheIterator.getItem();
@@ -701,7 +701,7 @@ static err_t FOG_CDECL FaceCache_getAllFaces(const FaceCache* self, const String
 
 static err_t FOG_CDECL FaceCache_put(FaceCache* self, const StringW* family, const FaceFeatures* features, Face* face)
 {
-  Hash< StringW, List<Face*> >& data = self->data();
+  FlatHash< StringW, List<Face*> >& data = self->data();
   List<Face*>* list = data.usePtr(*family, NULL);
 
   if (list != NULL)
@@ -721,7 +721,7 @@ static err_t FOG_CDECL FaceCache_put(FaceCache* self, const StringW* family, con
 
 static err_t FOG_CDECL FaceCache_remove(FaceCache* self, const StringW* family, const FaceFeatures* features, Face* face)
 {
-  Hash< StringW, List<Face*> >& data = self->data();
+  FlatHash< StringW, List<Face*> >& data = self->data();
   List<Face*>* list = data.usePtr(*family, NULL);
 
   if (list != NULL)
@@ -10,6 +10,7 @@
 // [Dependencies]
 #include <Fog/Core/Global/Global.h>
 #include <Fog/Core/Tools/Char.h>
+#include <Fog/Core/Tools/FlatHash.h>
 #include <Fog/Core/Tools/Hash.h>
 #include <Fog/Core/Tools/List.h>
 #include <Fog/Core/Tools/String.h>
@@ -1252,7 +1253,7 @@ struct FOG_NO_EXPORT FaceCache
   // [Members]
   // --------------------------------------------------------------------------
 
-  Static< Hash< StringW, List<Face*> > > data;
+  Static< FlatHash< StringW, List<Face*> > > data;
 
 private:
   FOG_NO_COPY(FaceCache)